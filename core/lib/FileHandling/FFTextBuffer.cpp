@@ -0,0 +1,377 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/**
+ * @file FFTextBuffer.cpp
+ * A read-only stream buffer for FFTextStream.
+ */
+
+#include <algorithm>
+#include <cstring>
+#include "FFTextBuffer.hpp"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+   /// Seek to an absolute offset in a large file.
+static int seekFile(std::FILE *fp, std::streamoff off, int whence)
+{
+#ifdef _WIN32
+   return _fseeki64(fp, off, whence);
+#else
+   return fseeko(fp, off, whence);
+#endif
+}
+
+   /// Get the current offset in a large file.
+static std::streamoff tellFile(std::FILE *fp)
+{
+#ifdef _WIN32
+   return _ftelli64(fp);
+#else
+   return ftello(fp);
+#endif
+}
+
+namespace gnsstk
+{
+   const std::size_t FFTextBuffer::blockSize = 1 << 20;
+
+
+   FFTextBuffer ::
+   FFTextBuffer()
+         : mapAddr(nullptr),
+           mapSize(0),
+           fp(nullptr),
+           blockStart(0),
+           fileSize(-1),
+           owner(nullptr)
+   {
+   }
+
+
+   FFTextBuffer ::
+   ~FFTextBuffer()
+   {
+      close();
+   }
+
+
+   bool FFTextBuffer ::
+   open(const char* fn, bool mapped)
+   {
+      close();
+#ifndef _WIN32
+      if (mapped)
+      {
+         int fd = ::open(fn, O_RDONLY);
+         if (fd < 0)
+            return false;
+         struct stat st;
+            // Empty files can't be mapped, and there's no point
+            // trying anything but regular files.
+         if ((fstat(fd, &st) == 0) && S_ISREG(st.st_mode) && (st.st_size > 0))
+         {
+            void *addr = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE,
+                              fd, 0);
+            if (addr != MAP_FAILED)
+            {
+               madvise(addr, st.st_size, MADV_SEQUENTIAL);
+               mapAddr = static_cast<char*>(addr);
+               mapSize = st.st_size;
+               fileSize = st.st_size;
+               setg(mapAddr, mapAddr,
+                    mapAddr + std::min(mapSize, blockSize));
+            }
+         }
+         ::close(fd);
+         if (mapAddr != nullptr)
+            return true;
+      }
+#endif
+      fp = std::fopen(fn, "rb");
+      if (fp == nullptr)
+         return false;
+      if (seekFile(fp, 0, SEEK_END) == 0)
+      {
+         fileSize = tellFile(fp);
+         seekFile(fp, 0, SEEK_SET);
+      }
+      block.resize(blockSize);
+      setg(block.data(), block.data(), block.data());
+      return true;
+   }
+
+
+   bool FFTextBuffer ::
+   openDecoded(const char* fn)
+   {
+      close();
+      pipe.reset(new FFTextPipeline);
+      if (!pipe->open(fn))
+      {
+         pipe.reset();
+         return false;
+      }
+      pipeFile = fn;
+      block.resize(blockSize);
+      setg(block.data(), block.data(), block.data());
+      return true;
+   }
+
+
+   void FFTextBuffer ::
+   close()
+   {
+#ifndef _WIN32
+      if (mapAddr != nullptr)
+      {
+         munmap(mapAddr, mapSize);
+      }
+#endif
+      if (fp != nullptr)
+      {
+         std::fclose(fp);
+      }
+      mapAddr = nullptr;
+      mapSize = 0;
+      fp = nullptr;
+      pipe.reset();
+      pipeFile.clear();
+      block.clear();
+      blockStart = 0;
+      fileSize = -1;
+      setg(nullptr, nullptr, nullptr);
+   }
+
+
+   bool FFTextBuffer ::
+   getLine(const char*& line, std::size_t& len, bool& newline)
+   {
+      if (ownerClosed())
+         return false;
+      std::size_t searched = 0;
+      while (true)
+      {
+         char *nl = static_cast<char*>(
+            std::memchr(gptr() + searched, '\n',
+                        egptr() - gptr() - searched));
+         if (nl != nullptr)
+         {
+            line = gptr();
+            len = nl - gptr();
+            newline = true;
+            gbump(static_cast<int>(len + 1));
+            return true;
+         }
+         searched = egptr() - gptr();
+            // There's no more data to read, so whatever is left is
+            // the last line.
+         if (!fill())
+         {
+            if (gptr() == egptr())
+               return false;
+            line = gptr();
+            len = egptr() - gptr();
+            newline = false;
+            setg(eback(), egptr(), egptr());
+            return true;
+         }
+      }
+   }
+
+
+   FFTextBuffer::int_type FFTextBuffer ::
+   underflow()
+   {
+      if (gptr() < egptr())
+         return traits_type::to_int_type(*gptr());
+      if (fill())
+         return traits_type::to_int_type(*gptr());
+      return traits_type::eof();
+   }
+
+
+   std::streamsize FFTextBuffer ::
+   showmanyc()
+   {
+      if (ownerClosed())
+         return -1;
+      std::streamsize avail = egptr() - gptr();
+      if (avail == 0)
+      {
+            // unknown for decoded files
+         if (fileSize < 0)
+            return 0;
+         std::streamoff pos = blockStart + (gptr() - eback());
+         if (pos >= fileSize)
+            return -1;
+         avail = fileSize - pos;
+      }
+      return avail;
+   }
+
+
+   FFTextBuffer::pos_type FFTextBuffer ::
+   seekoff(off_type off, std::ios::seekdir dir, std::ios::openmode which)
+   {
+      if (ownerClosed() || !isOpen() || !(which & std::ios::in))
+         return pos_type(off_type(-1));
+      switch (dir)
+      {
+         case std::ios::beg:
+            break;
+         case std::ios::cur:
+            off += blockStart + (gptr() - eback());
+            break;
+         case std::ios::end:
+            if (fileSize < 0)
+               return pos_type(off_type(-1));
+            off += fileSize;
+            break;
+         default:
+            return pos_type(off_type(-1));
+      }
+      return seekpos(pos_type(off), which);
+   }
+
+
+   FFTextBuffer::pos_type FFTextBuffer ::
+   seekpos(pos_type pos, std::ios::openmode which)
+   {
+      std::streamoff off = pos;
+      if (ownerClosed() || !isOpen() || !(which & std::ios::in) || (off < 0) ||
+          ((fileSize >= 0) && (off > fileSize)))
+      {
+         return pos_type(off_type(-1));
+      }
+      if ((off >= blockStart) && (off <= blockStart + (egptr() - eback())))
+      {
+            // already in the get area
+         setg(eback(), eback() + (off - blockStart), egptr());
+         return pos;
+      }
+      if (mapAddr != nullptr)
+      {
+         setg(mapAddr, mapAddr + off,
+              mapAddr + std::min(mapSize, std::size_t(off) + blockSize));
+         return pos;
+      }
+      if (pipe)
+      {
+            // The decoded text can only be read forwards, so going
+            // back means decoding from the start again.
+         if (off < blockStart)
+         {
+            if (!pipe->open(pipeFile.c_str()))
+               return pos_type(off_type(-1));
+            blockStart = 0;
+            setg(block.data(), block.data(), block.data());
+         }
+         while (off > blockStart + (egptr() - eback()))
+         {
+            setg(eback(), egptr(), egptr());
+            if (!fill())
+               return pos_type(off_type(-1));
+         }
+         setg(eback(), eback() + (off - blockStart), egptr());
+         return pos;
+      }
+      if (seekFile(fp, off, SEEK_SET) != 0)
+         return pos_type(off_type(-1));
+      blockStart = off;
+      setg(block.data(), block.data(), block.data());
+      return pos;
+   }
+
+
+   bool FFTextBuffer ::
+   fill()
+   {
+      if (ownerClosed())
+         return false;
+      if (mapAddr != nullptr)
+      {
+            // Expose the next block of the mapping, keeping what's
+            // left of the get area.
+         std::size_t left = (mapAddr + mapSize) - egptr();
+         if (left == 0)
+            return false;
+         setg(eback(), gptr(), egptr() + std::min(left, blockSize));
+         return true;
+      }
+      if ((fp == nullptr) && !pipe)
+         return false;
+      std::size_t start = gptr() - eback();
+      std::size_t keep = egptr() - gptr();
+         // Lines must be contiguous, so grow the block if a single
+         // line doesn't fit.
+      if (keep == block.size())
+         block.resize(block.size() * 2);
+      std::memmove(block.data(), block.data() + start, keep);
+      blockStart += start;
+      std::size_t got = readSource(block.data() + keep, block.size() - keep);
+      setg(block.data(), block.data(), block.data() + keep + got);
+      return got > 0;
+   }
+
+
+   bool FFTextBuffer ::
+   ownerClosed()
+   {
+      if ((owner == nullptr) || owner->is_open())
+         return false;
+      if (isOpen())
+         close();
+      return true;
+   }
+
+
+   std::size_t FFTextBuffer ::
+   readSource(char* buf, std::size_t len)
+   {
+      if (pipe)
+         return pipe->read(buf, len);
+      return std::fread(buf, 1, len, fp);
+   }
+
+}  // End of namespace gnsstk
@@ -0,0 +1,201 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/**
+ * @file FFTextBuffer.hpp
+ * A read-only stream buffer for FFTextStream.
+ */
+
+#ifndef GNSSTK_FFTEXTBUFFER_HPP
+#define GNSSTK_FFTEXTBUFFER_HPP
+
+#include <cstdio>
+#include <fstream>
+#include <ios>
+#include <memory>
+#include <streambuf>
+#include <string>
+#include <vector>
+#include "FFTextPipeline.hpp"
+
+namespace gnsstk
+{
+      /// @ingroup FileHandling
+      //@{
+
+      /**
+       * A read-only std::streambuf used by FFTextStream in place of
+       * std::filebuf when reading.  The file is either memory-mapped
+       * in its entirety or read in large blocks, and getLine() hands
+       * out lines as pointers into the buffer rather than copying
+       * them.  All of the std::istream interface, including tellg()
+       * and seekg(), continues to work through this buffer.
+       *
+       * A mapped file is exposed to std::streambuf one block at a
+       * time, so that the owner set with setOwner() is checked at
+       * least once per block.  Once the owner is closed the file is
+       * released and no more data is read.
+       *
+       * Compressed files may instead be opened with openDecoded(),
+       * in which case the buffer holds the decoded text and offsets
+       * are offsets into the decoded text.  Seeking backwards
+       * further than the current block restarts decoding from the
+       * start of the file, and seeking relative to the end of the
+       * file is not possible.
+       *
+       * @warning A memory-mapped file that is truncated by another
+       *   process while it is being read will cause the reading
+       *   process to receive SIGBUS.
+       */
+   class FFTextBuffer : public std::streambuf
+   {
+   public:
+         /// Size of the blocks read when the file is not mapped.
+      static const std::size_t blockSize;
+
+         /// Initialize to a closed state.
+      FFTextBuffer();
+
+         /// Unmap or close the file.
+      virtual ~FFTextBuffer();
+
+         /** Open a file for reading.
+          * @param[in] fn The path of the file to read.
+          * @param[in] mapped If true, memory-map the file if
+          *   possible.  Files that can't be mapped (e.g. pipes, or
+          *   any file on systems without mmap) are read in blocks.
+          * @return true if the file was opened successfully. */
+      bool open(const char* fn, bool mapped);
+
+         /** Open a gzip and/or Compact RINEX file for reading,
+          * decoding it with an FFTextPipeline.
+          * @param[in] fn The path of the file to read.
+          * @return true if the file was opened successfully. */
+      bool openDecoded(const char* fn);
+
+         /// Release the file.
+      void close();
+
+         /** Tie this buffer to the std::filebuf of the stream using
+          * it.  The file is released as soon as fb is found to be
+          * closed, e.g. by std::fstream::close() being called
+          * through a base class reference, rather than staying
+          * mapped or buffered until the stream is destroyed.
+          * @param[in] fb The owning stream's std::filebuf, or
+          *   nullptr to stop checking. */
+      void setOwner(const std::filebuf* fb)
+      { owner = fb; }
+
+         /// Return true if a file is open.
+      bool isOpen() const
+      { return (mapAddr != nullptr) || (fp != nullptr) || pipe; }
+
+         /// Return true if the open file is memory-mapped.
+      bool isMapped() const
+      { return mapAddr != nullptr; }
+
+         /// Return true if the open file is being decoded.
+      bool isDecoded() const
+      { return pipe != nullptr; }
+
+         /** Get a description of the error that stopped decoding,
+          * if any.
+          * @return An empty string if the file is not being decoded
+          *   or no error has occurred. */
+      std::string getDecodeError() const
+      { return pipe ? pipe->getError() : std::string(); }
+
+         /** Get the next line in the file.
+          * @param[out] line Set to the first character of the
+          *   line.  The line is not NUL-terminated and remains valid
+          *   until the next operation on this buffer.
+          * @param[out] len Set to the number of characters in the
+          *   line, excluding the newline.
+          * @param[out] newline Set to true if the line was terminated
+          *   by a newline, false if it was terminated by the end of
+          *   the file.
+          * @return false if there was no data left to read. */
+      bool getLine(const char*& line, std::size_t& len, bool& newline);
+
+   protected:
+         /// Refill the get area, if possible.
+      int_type underflow() override;
+         /// Return the number of characters left in the file.
+      std::streamsize showmanyc() override;
+         /// Reposition relative to the start, end or current position.
+      pos_type seekoff(off_type off, std::ios::seekdir dir,
+                       std::ios::openmode which) override;
+         /// Reposition to an absolute offset in the file.
+      pos_type seekpos(pos_type pos, std::ios::openmode which) override;
+
+   private:
+         /** Move any unread data to the start of block and read as
+          * much of the file as will fit after it.
+          * @return false if nothing more could be read. */
+      bool fill();
+         /** Release the file if the owner has been closed.
+          * @return true if the owner is closed. */
+      bool ownerClosed();
+         /// Get up to len characters from fp or pipe.
+      std::size_t readSource(char* buf, std::size_t len);
+
+         /// The address of the mapped file, or nullptr when not mapped.
+      char *mapAddr;
+         /// The size of the mapped file.
+      std::size_t mapSize;
+         /// The file being read in blocks, or nullptr when not open.
+      std::FILE *fp;
+         /// Storage for the data read from fp.
+      std::vector<char> block;
+         /// The file offset of eback().
+      std::streamoff blockStart;
+         /// The size of the file, used for seeking from the end.
+      std::streamoff fileSize;
+         /// The decoder for files opened with openDecoded().
+      std::unique_ptr<FFTextPipeline> pipe;
+         /// The path of the decoded file, for restarting it.
+      std::string pipeFile;
+         /// The std::filebuf of the stream using this buffer, if any.
+      const std::filebuf *owner;
+   }; // End of class 'FFTextBuffer'
+
+      //@}
+
+}  // End of namespace gnsstk
+
+#endif   // GNSSTK_FFTEXTBUFFER_HPP
@@ -0,0 +1,427 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/**
+ * @file FFTextPipeline.cpp
+ * Decompress text files on background threads for FFTextBuffer.
+ */
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <system_error>
+#include "FFTextPipeline.hpp"
+#include "CompactRinexDecoder.hpp"
+
+#ifdef GNSSTK_HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+namespace gnsstk
+{
+      /// Number of chunks each ChunkQueue will hold.
+   static const std::size_t queueDepth = 4;
+
+   const std::size_t FFTextPipeline::chunkSize = 1 << 18;
+
+
+      /** The file being decoded.  zlib reads files that aren't
+       * compressed as they are, so when it's available it is used
+       * for everything. */
+   struct FFTextPipeline::Source
+   {
+      Source()
+            : fp(nullptr)
+#ifdef GNSSTK_HAVE_ZLIB
+            , gz(nullptr)
+#endif
+      {}
+
+      ~Source()
+      {
+         if (fp != nullptr)
+            std::fclose(fp);
+#ifdef GNSSTK_HAVE_ZLIB
+         if (gz != nullptr)
+            gzclose(gz);
+#endif
+      }
+
+      bool open(const char* fn)
+      {
+#ifdef GNSSTK_HAVE_ZLIB
+         gz = gzopen(fn, "rb");
+         if (gz == nullptr)
+            return false;
+         gzbuffer(gz, chunkSize);
+         return true;
+#else
+         fp = std::fopen(fn, "rb");
+         return (fp != nullptr);
+#endif
+      }
+
+         /** Read up to len characters.
+          * @return The number read, 0 at the end of the file, -1
+          *   on error. */
+      long read(char* buf, std::size_t len)
+      {
+#ifdef GNSSTK_HAVE_ZLIB
+         if (gz != nullptr)
+         {
+            int got = gzread(gz, buf, static_cast<unsigned>(len));
+            int errnum = Z_OK;
+            gzerror(gz, &errnum);
+               // a truncated stream is only reported at the end
+            if ((got < 0) || ((got == 0) && (errnum != Z_OK)))
+               return -1;
+            return got;
+         }
+#endif
+         std::size_t got = std::fread(buf, 1, len, fp);
+         if ((got == 0) && std::ferror(fp))
+            return -1;
+         return static_cast<long>(got);
+      }
+
+      bool rewind()
+      {
+#ifdef GNSSTK_HAVE_ZLIB
+         if (gz != nullptr)
+            return (gzrewind(gz) == 0);
+#endif
+         return (std::fseek(fp, 0, SEEK_SET) == 0);
+      }
+
+      std::string errorText()
+      {
+#ifdef GNSSTK_HAVE_ZLIB
+         if (gz != nullptr)
+         {
+            int errnum;
+            const char *msg = gzerror(gz, &errnum);
+            if (errnum == Z_BUF_ERROR)
+               return "Unexpected end of compressed data";
+            if (errnum == Z_ERRNO)
+               return std::strerror(errno);
+            return msg;
+         }
+#endif
+         return std::strerror(errno);
+      }
+
+      std::FILE *fp;
+#ifdef GNSSTK_HAVE_ZLIB
+      gzFile gz;
+#endif
+   };
+
+
+   FFTextPipeline::ChunkQueue ::
+   ChunkQueue()
+         : finished(false),
+           cancelled(false)
+   {
+   }
+
+
+   bool FFTextPipeline::ChunkQueue ::
+   push(std::string& chunk)
+   {
+      std::unique_lock<std::mutex> lock(mutex);
+      changed.wait(lock, [this]{ return cancelled ||
+                                        (queue.size() < queueDepth); });
+      if (cancelled)
+         return false;
+      queue.push_back(std::string());
+      queue.back().swap(chunk);
+      if (!spares.empty())
+      {
+         chunk.swap(spares.back());
+         spares.pop_back();
+      }
+      chunk.clear();
+      changed.notify_all();
+      return true;
+   }
+
+
+   bool FFTextPipeline::ChunkQueue ::
+   pop(std::string& chunk)
+   {
+      std::unique_lock<std::mutex> lock(mutex);
+      changed.wait(lock, [this]{ return cancelled || finished ||
+                                        !queue.empty(); });
+      if (cancelled || queue.empty())
+         return false;
+      if ((chunk.capacity() > 0) && (spares.size() < queueDepth))
+      {
+         spares.push_back(std::string());
+         spares.back().swap(chunk);
+      }
+      chunk.swap(queue.front());
+      queue.pop_front();
+      changed.notify_all();
+      return true;
+   }
+
+
+   void FFTextPipeline::ChunkQueue ::
+   finish()
+   {
+      std::lock_guard<std::mutex> lock(mutex);
+      finished = true;
+      changed.notify_all();
+   }
+
+
+   void FFTextPipeline::ChunkQueue ::
+   cancel()
+   {
+      std::lock_guard<std::mutex> lock(mutex);
+      cancelled = true;
+      changed.notify_all();
+   }
+
+
+   void FFTextPipeline::ChunkQueue ::
+   reset()
+   {
+      std::lock_guard<std::mutex> lock(mutex);
+      queue.clear();
+      spares.clear();
+      finished = false;
+      cancelled = false;
+   }
+
+
+   bool FFTextPipeline ::
+   isEncoded(const char* fn)
+   {
+      std::FILE *fp = std::fopen(fn, "rb");
+      if (fp == nullptr)
+         return false;
+      char buf[128];
+      std::size_t got = std::fread(buf, 1, sizeof(buf), fp);
+      std::fclose(fp);
+#ifdef GNSSTK_HAVE_ZLIB
+      if ((got >= 2) && (buf[0] == '\x1f') && (buf[1] == '\x8b'))
+         return true;
+#endif
+      const char *nl = static_cast<const char*>(std::memchr(buf, '\n', got));
+      return CompactRinexDecoder::isCompactRinex(buf,
+                                                 nl ? nl - buf : got);
+   }
+
+
+   FFTextPipeline ::
+   FFTextPipeline()
+         : compact(false),
+           currentPos(0)
+   {
+   }
+
+
+   FFTextPipeline ::
+   ~FFTextPipeline()
+   {
+      close();
+   }
+
+
+   bool FFTextPipeline ::
+   open(const char* fn)
+   {
+      close();
+      source.reset(new Source);
+      if (!source->open(fn))
+      {
+         source.reset();
+         return false;
+      }
+         // Check the first line for Compact RINEX, then start over.
+      char buf[128];
+      long got = source->read(buf, sizeof(buf));
+      if ((got < 0) || !source->rewind())
+      {
+         source.reset();
+         return false;
+      }
+      const char *nl = static_cast<const char*>(std::memchr(buf, '\n', got));
+      compact = CompactRinexDecoder::isCompactRinex(buf, nl ? nl - buf : got);
+      try
+      {
+         inflater = std::thread(&FFTextPipeline::inflateFile, this);
+         if (compact)
+            expander = std::thread(&FFTextPipeline::expandCompact, this);
+      }
+      catch (std::system_error&)
+      {
+         close();
+         return false;
+      }
+      return true;
+   }
+
+
+   void FFTextPipeline ::
+   close()
+   {
+      rawQueue.cancel();
+      textQueue.cancel();
+      if (inflater.joinable())
+         inflater.join();
+      if (expander.joinable())
+         expander.join();
+      source.reset();
+      rawQueue.reset();
+      textQueue.reset();
+      compact = false;
+      current.clear();
+      currentPos = 0;
+      error.clear();
+   }
+
+
+   std::size_t FFTextPipeline ::
+   read(char* buf, std::size_t len)
+   {
+      ChunkQueue& queue(compact ? textQueue : rawQueue);
+      std::size_t total = 0;
+      while (total < len)
+      {
+         if (currentPos == current.size())
+         {
+            if (!queue.pop(current))
+               break;
+            currentPos = 0;
+            continue;
+         }
+         std::size_t count = std::min(len - total, current.size() - currentPos);
+         std::memcpy(buf + total, current.data() + currentPos, count);
+         total += count;
+         currentPos += count;
+      }
+      return total;
+   }
+
+
+   void FFTextPipeline ::
+   inflateFile()
+   {
+      std::string chunk;
+      while (true)
+      {
+         chunk.resize(chunkSize);
+         long got = source->read(&chunk[0], chunkSize);
+         if (got < 0)
+         {
+            fail(source->errorText());
+            break;
+         }
+         if (got == 0)
+            break;
+         chunk.resize(got);
+         if (!rawQueue.push(chunk))
+            return;
+      }
+      rawQueue.finish();
+   }
+
+
+   void FFTextPipeline ::
+   expandCompact()
+   {
+      CompactRinexDecoder decoder;
+      std::string raw, text, partial;
+      try
+      {
+         while (rawQueue.pop(raw))
+         {
+            const char *pos = raw.data(), *end = pos + raw.size();
+            while (pos < end)
+            {
+               const char *nl = static_cast<const char*>(
+                  std::memchr(pos, '\n', end - pos));
+               if (nl == nullptr)
+               {
+                  partial.append(pos, end);
+                  break;
+               }
+               if (partial.empty())
+               {
+                  decoder.decodeLine(pos, nl - pos, text);
+               }
+               else
+               {
+                  partial.append(pos, nl);
+                  decoder.decodeLine(partial.data(), partial.size(), text);
+                  partial.clear();
+               }
+               pos = nl + 1;
+               if ((text.size() >= chunkSize) && !textQueue.push(text))
+                  return;
+            }
+         }
+         if (!partial.empty())
+            decoder.decodeLine(partial.data(), partial.size(), text);
+         if (!text.empty())
+            textQueue.push(text);
+      }
+      catch (Exception& exc)
+      {
+         fail(exc.getText());
+         rawQueue.cancel();
+            // pass on everything up to the error
+         if (!text.empty())
+            textQueue.push(text);
+      }
+      textQueue.finish();
+   }
+
+
+   void FFTextPipeline ::
+   fail(const std::string& text)
+   {
+      std::lock_guard<std::mutex> lock(errorMutex);
+      if (error.empty())
+         error = text;
+   }
+
+}  // End of namespace gnsstk
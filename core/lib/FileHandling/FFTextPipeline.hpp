@@ -0,0 +1,189 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/**
+ * @file FFTextPipeline.hpp
+ * Decompress text files on background threads for FFTextBuffer.
+ */
+
+#ifndef GNSSTK_FFTEXTPIPELINE_HPP
+#define GNSSTK_FFTEXTPIPELINE_HPP
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace gnsstk
+{
+      /// @ingroup FileHandling
+      //@{
+
+      /**
+       * Decode gzip-compressed and/or Compact RINEX (Hatanaka) files
+       * on background threads, so that the text can be read while
+       * the next part of the file is being decoded.
+       *
+       * One thread reads and inflates the file, a second (only for
+       * Compact RINEX) expands it using CompactRinexDecoder, and the
+       * reading thread collects the text with read().  The threads
+       * are connected by short queues of large chunks, so the
+       * memory used is bounded no matter how large the file.
+       *
+       * gzip support requires that GNSSTk be built with zlib.
+       */
+   class FFTextPipeline
+   {
+   public:
+         /// Size of the chunks passed between threads.
+      static const std::size_t chunkSize;
+
+         /** Determine if a file needs to be read through a pipeline.
+          * @param[in] fn The path of the file to check.
+          * @return true if fn is gzip-compressed (and zlib is
+          *   available) or is a Compact RINEX file. */
+      static bool isEncoded(const char* fn);
+
+         /// Initialize to a closed state.
+      FFTextPipeline();
+
+         /// Stop the threads and close the file.
+      ~FFTextPipeline();
+
+         /** Open a file and start decoding it.
+          * @param[in] fn The path of the file to read.
+          * @return true if the file was opened successfully. */
+      bool open(const char* fn);
+
+         /// Stop decoding and close the file.
+      void close();
+
+         /// Return true if a file is open.
+      bool isOpen() const
+      { return inflater.joinable(); }
+
+         /** Get the next decoded text, waiting for it if necessary.
+          * @param[out] buf Where to store the text.
+          * @param[in] len The size of buf.
+          * @return The number of characters stored in buf, which is
+          *   less than len only at the end of the file or if an
+          *   error occurred. */
+      std::size_t read(char* buf, std::size_t len);
+
+         /** Get a description of any error encountered while
+          * decoding, valid once read() has returned less than was
+          * asked for.
+          * @return An empty string if the file was read
+          *   successfully. */
+      const std::string& getError() const
+      { return error; }
+
+   private:
+         /** A bounded queue of text chunks, passed from a producer
+          * to a consumer thread.  Emptied chunks are handed back to
+          * the producer for reuse. */
+      class ChunkQueue
+      {
+      public:
+         ChunkQueue();
+            /** Pass a chunk to the consumer, waiting while the queue
+             * is full.
+             * @param[in,out] chunk The chunk to queue, replaced with
+             *   a spare (empty) chunk.
+             * @return false if the consumer has gone away. */
+         bool push(std::string& chunk);
+            /** Get the next chunk, waiting while the queue is empty.
+             * @param[in,out] chunk Set to the next chunk.  Its
+             *   previous contents are kept for reuse by push().
+             * @return false if the producer has finished and the
+             *   queue is empty, or the queue was cancelled. */
+         bool pop(std::string& chunk);
+            /// Called by the producer when there is no more data.
+         void finish();
+            /// Stop both threads using the queue.
+         void cancel();
+            /// Reset to the initial empty state.
+         void reset();
+      private:
+         std::mutex mutex;
+         std::condition_variable changed;
+         std::deque<std::string> queue;
+         std::deque<std::string> spares;
+         bool finished;
+         bool cancelled;
+      };
+
+      struct Source;
+
+         /// Body of the thread that reads and inflates the file.
+      void inflateFile();
+         /// Body of the thread that expands Compact RINEX.
+      void expandCompact();
+         /** Record an error and stop all threads, keeping only the
+          * first error reported. */
+      void fail(const std::string& text);
+
+         /// The open file.
+      std::unique_ptr<Source> source;
+         /// Raw (possibly inflated) file contents.
+      ChunkQueue rawQueue;
+         /// Expanded Compact RINEX, when the file is Compact RINEX.
+      ChunkQueue textQueue;
+         /// Set when the file is Compact RINEX.
+      bool compact;
+         /// Thread running inflateFile().
+      std::thread inflater;
+         /// Thread running expandCompact(), if any.
+      std::thread expander;
+         /// The chunk being consumed by read().
+      std::string current;
+         /// The next character of current to be returned by read().
+      std::size_t currentPos;
+         /// Protects error.
+      std::mutex errorMutex;
+         /// Description of the first error encountered.
+      std::string error;
+   }; // End of class 'FFTextPipeline'
+
+      //@}
+
+}  // End of namespace gnsstk
+
+#endif   // GNSSTK_FFTEXTPIPELINE_HPP
@@ -45,34 +45,50 @@
 
 namespace gnsstk
 {
+   FFTextStream::ReadBackend FFTextStream::defaultReadBackend =
+      FFTextStream::ReadBackend::Stream;
+
+
    FFTextStream ::
    FFTextStream()
+         : readBackend(defaultReadBackend),
+           openMode(std::ios::in),
+           encoded(false)
    {
-      init();
+      init(std::ios::in);
    }
 
 
    FFTextStream ::
    ~FFTextStream()
    {
+         // don't leave the stream pointing at a destroyed buffer
+      if (textBuf)
+         std::basic_ios<char>::rdbuf(std::fstream::rdbuf());
    }
 
 
    FFTextStream ::
    FFTextStream( const char* fn,
                  std::ios::openmode mode )
-         : FFStream(fn, mode)
+         : FFStream(fn, mode),
+           readBackend(defaultReadBackend),
+           openMode(mode),
+           encoded(false)
    {
-      init();
+      init(mode);
    }
 
 
    FFTextStream ::
    FFTextStream( const std::string& fn,
                  std::ios::openmode mode )
-         : FFStream( fn.c_str(), mode )
+         : FFStream( fn.c_str(), mode ),
+           readBackend(defaultReadBackend),
+           openMode(mode),
+           encoded(false)
    {
-      init();
+      init(mode);
    }
 
 
@@ -81,7 +97,30 @@ namespace gnsstk
          std::ios::openmode mode )
    {
       FFStream::open(fn, mode);
-      init();
+      init(mode);
+   }
+
+
+   void FFTextStream ::
+   close()
+   {
+      if (textBuf)
+      {
+         std::ios::iostate state = rdstate();
+         std::basic_ios<char>::rdbuf(std::fstream::rdbuf());
+         textBuf.reset();
+         clear(state);
+      }
+      encoded = false;
+      std::fstream::close();
+   }
+
+
+   bool FFTextStream ::
+   setReadBackend(ReadBackend rb)
+   {
+      readBackend = rb;
+      return attachBackend();
    }
 
 
@@ -94,9 +133,82 @@ namespace gnsstk
 
 
    void FFTextStream ::
-   init()
+   init(std::ios::openmode mode)
    {
       lineNumber = 0;
+      openMode = mode;
+         // FFStream::open has already closed the previous file, so
+         // any FFTextBuffer still attached is stale.
+      if (textBuf)
+      {
+         std::basic_ios<char>::rdbuf(std::fstream::rdbuf());
+         textBuf.reset();
+      }
+      encoded = (is_open() && !(mode & std::ios::out) &&
+                 FFTextPipeline::isEncoded(filename.c_str()));
+      attachBackend();
+   }
+
+
+   bool FFTextStream ::
+   attachBackend()
+   {
+      if (encoded)
+      {
+            // Decoded files are always read through textBuf, which
+            // is attached when the file is opened.
+         if (!textBuf)
+         {
+            std::ios::iostate state = rdstate();
+            std::unique_ptr<FFTextBuffer> newBuf(new FFTextBuffer);
+            newBuf->setOwner(std::fstream::rdbuf());
+            if (newBuf->openDecoded(filename.c_str()))
+            {
+               std::basic_ios<char>::rdbuf(newBuf.get());
+               textBuf.swap(newBuf);
+            }
+            clear(state);
+         }
+         return false;
+      }
+      bool wantBuf = ((readBackend != ReadBackend::Stream) && is_open() &&
+                      !(openMode & std::ios::out));
+      bool mapped = (readBackend == ReadBackend::Mapped);
+      if (wantBuf && textBuf && (textBuf->isMapped() == mapped))
+         return true;
+      if (!wantBuf && !textBuf)
+         return (readBackend == ReadBackend::Stream);
+         // Switching buffers clears the stream state, which should
+         // be unaffected by the change.
+      std::ios::iostate state = rdstate();
+      std::streambuf *current = std::basic_ios<char>::rdbuf();
+      std::streampos pos = current->pubseekoff(0, std::ios::cur,
+                                               std::ios::in);
+      std::unique_ptr<FFTextBuffer> newBuf;
+      if (wantBuf)
+      {
+         newBuf.reset(new FFTextBuffer);
+         newBuf->setOwner(std::fstream::rdbuf());
+         if (!newBuf->open(filename.c_str(), mapped) ||
+             (newBuf->pubseekpos(pos, std::ios::in) != pos))
+         {
+            newBuf.reset();
+         }
+      }
+      if (newBuf)
+      {
+         std::basic_ios<char>::rdbuf(newBuf.get());
+      }
+      else
+      {
+         std::fstream::rdbuf()->pubseekpos(pos, std::ios::in);
+         std::basic_ios<char>::rdbuf(std::fstream::rdbuf());
+      }
+      textBuf.swap(newBuf);
+      clear(state);
+      if (readBackend == ReadBackend::Stream)
+         return !textBuf;
+      return (textBuf.get() != nullptr);
    }
 
 
@@ -149,6 +261,15 @@ namespace gnsstk
    formattedGetLine( std::string& line,
                      const bool expectEOF )
    {
+      if (textBuf)
+      {
+         const char *buf;
+         std::string::size_type len;
+         line.clear();
+         formattedGetLine(buf, len, expectEOF);
+         line.assign(buf, len);
+         return;
+      }
       try
       {
          std::getline(*this, line);
@@ -211,4 +332,103 @@ namespace gnsstk
       }
    }  // End of method 'FFTextStream::formattedGetLine()'
 
+
+      // This follows formattedGetLine(std::string&,bool) exactly,
+      // setting the stream state the same way std::getline would.
+   void FFTextStream ::
+   formattedGetLine( const char*& line,
+                     std::string::size_type& len,
+                     const bool expectEOF )
+   {
+      if (!textBuf)
+      {
+            // std::getline leaves the string alone if the stream is
+            // already at EOF, which would hide the EOF.
+         lineBuf.clear();
+         formattedGetLine(lineBuf, expectEOF);
+         line = lineBuf.data();
+         len = lineBuf.length();
+         return;
+      }
+      line = "";
+      len = 0;
+      try
+      {
+         bool newline = false;
+         if (!good())
+            setstate(std::ios::failbit);
+         else if (!textBuf->getLine(line, len, newline))
+            setstate(std::ios::eofbit | std::ios::failbit);
+         else if (!newline)
+            setstate(std::ios::eofbit);
+         if (eof())
+         {
+               // A decoding error looks like the end of the file.
+            std::string decodeError(textBuf->getDecodeError());
+            if (!decodeError.empty())
+            {
+               FFStreamError err("Unable to decode " + filename + ": " +
+                                 decodeError);
+               GNSSTK_THROW(err);
+            }
+         }
+            // Remove CR characters left over in the buffer from windows files
+         while ((len > 0) && (line[len-1] == '\r'))
+            len--;
+            // Same as isprint in the C locale, but cheaper.
+         for (std::string::size_type i = 0; i < len; i++)
+         {
+            if (static_cast<unsigned char>(line[i] - 0x20) > 0x5e)
+            {
+               FFStreamError err("Non-text data in file.");
+               GNSSTK_THROW(err);
+            }
+         }
+
+         lineNumber++;
+         if(fail() && !eof())
+         {
+            FFStreamError err("Line too long");
+            GNSSTK_THROW(err);
+         }
+            // catch EOF when stream exceptions are disabled
+         if ((len == 0) && eof())
+         {
+            if (expectEOF)
+            {
+               EndOfFile err("EOF encountered");
+               GNSSTK_THROW(err);
+            }
+            else
+            {
+               FFStreamError err("Unexpected EOF encountered");
+               GNSSTK_THROW(err);
+            }
+         }
+      }
+      catch(std::exception &e)
+      {
+            // catch EOF when exceptions are enabled
+         if ((len == 0) && eof())
+         {
+            if (expectEOF)
+            {
+               EndOfFile err("EOF encountered");
+               GNSSTK_THROW(err);
+            }
+            else
+            {
+               FFStreamError err("Unexpected EOF");
+               GNSSTK_THROW(err);
+            }
+         }
+         else
+         {
+            FFStreamError err("Critical file error: " +
+                              std::string(e.what()));
+            GNSSTK_THROW(err);
+         }
+      }
+   }  // End of method 'FFTextStream::formattedGetLine()'
+
 }  // End of namespace gnsstk
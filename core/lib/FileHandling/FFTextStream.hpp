@@ -44,7 +44,9 @@
 #ifndef GNSSTK_FFTEXTSTREAM_HPP
 #define GNSSTK_FFTEXTSTREAM_HPP
 
+#include <memory>
 #include "FFStream.hpp"
+#include "FFTextBuffer.hpp"
 
 namespace gnsstk
 {
@@ -59,10 +61,30 @@ namespace gnsstk
        * update the line number - the derived class or programmer
        * needs to make sure that the reader or writer increments
        * lineNumber in these cases.
+       *
+       * Files opened for input only that are gzip-compressed (when
+       * GNSSTk is built with zlib) or in Compact RINEX format are
+       * decoded on the fly by an FFTextPipeline, regardless of the
+       * read backend, so derived classes read them as if they had
+       * been decompressed first.
        */
    class FFTextStream : public FFStream
    {
    public:
+         /** The methods available for reading files.  Only files
+          * opened for input alone use anything other than Stream. */
+      enum class ReadBackend
+      {
+         Stream, ///< Read through std::filebuf.
+         Block,  ///< Read through FFTextBuffer in large blocks.
+         Mapped  ///< Memory-map the file, falling back to Block.
+      };
+
+         /** The backend used by FFTextStream objects when they are
+          * constructed, including those constructed internally by
+          * other classes.  Defaults to Stream. */
+      static ReadBackend defaultReadBackend;
+
          /// Default constructor
       FFTextStream();
 
@@ -93,6 +115,31 @@ namespace gnsstk
       virtual void open( const std::string& fn,
                          std::ios::openmode mode );
 
+         /** Close the file, including any FFTextBuffer in use.
+          * std::fstream::close() is not virtual, so this is skipped
+          * when closing through a std::fstream& or FFStream&.  In
+          * that case the FFTextBuffer releases the file itself the
+          * next time it is read or repositioned, and is discarded
+          * on the next open() or when the stream is destroyed. */
+      void close();
+
+         /** Change the method used to read the file.  May be called
+          * at any time, reading continues from the current position.
+          * @param[in] rb The backend to use for this stream.
+          * @return true if the requested backend is in use, false if
+          *   the file is not open for input only or could not be
+          *   opened by FFTextBuffer, in which case std::filebuf is
+          *   used, or if the file is being decoded. */
+      bool setReadBackend(ReadBackend rb);
+
+         /// Get the backend requested for this stream.
+      ReadBackend getReadBackend() const
+      { return readBackend; }
+
+         /// Return true if the file is being decompressed as it is read.
+      bool isDecoded() const
+      { return textBuf && textBuf->isDecoded(); }
+
          /// The internal line count. When writing, make sure
          /// to increment this.
       unsigned int lineNumber;
@@ -118,6 +165,25 @@ namespace gnsstk
       void formattedGetLine( std::string& line,
                              const bool expectEOF = false );
 
+         /**
+          * Like formattedGetLine(std::string&,bool), but with a Block
+          * or Mapped backend the line is not copied.  With a Stream
+          * backend, the line is stored in a buffer owned by this
+          * stream.
+          * @param[out] line is set to the first character of the line
+          *   read, which is not NUL-terminated, and remains valid
+          *   only until the next read from this stream.
+          * @param[out] len is set to the length of the line.
+          * @param[in] expectEOF set true if finding EOF on this read
+          *   is acceptable.
+          * @throw EndOfFile if \a expectEOF is true and an EOF is encountered.
+          * @throw FFStreamError if EOF is found and \a expectEOF is false,
+          *   or if a compressed file could not be decoded.
+          */
+      void formattedGetLine( const char*& line,
+                             std::string::size_type& len,
+                             const bool expectEOF = false );
+
 
    protected:
 
@@ -134,8 +200,24 @@ namespace gnsstk
       virtual void tryFFStreamPut(const FFData& rec);
 
    private:
-         /// Initialize internal data structures
-      void init();
+         /** Initialize internal data structures
+          * @param[in] mode The mode the file was opened with. */
+      void init(std::ios::openmode mode);
+
+         /** Switch reading between std::filebuf and textBuf as
+          * required by readBackend, keeping the current position. */
+      bool attachBackend();
+
+         /// The backend requested for this stream.
+      ReadBackend readBackend;
+         /// The mode the file was opened with.
+      std::ios::openmode openMode;
+         /// Set when the open file needs to be decoded.
+      bool encoded;
+         /// The buffer used for Block, Mapped and decoding, if in use.
+      std::unique_ptr<FFTextBuffer> textBuf;
+         /// Storage for lines read by formattedGetLine(const char*&,...).
+      std::string lineBuf;
 
    }; // End of class 'FFTextStream'
 
@@ -427,25 +427,37 @@ namespace gnsstk
    int IonexData::getIndex( const Triple& in,
                             int igp,
                             Triple& ABC ) const
+   {
+      return getIndex( dim, lat, lon, hgt, in, igp, ABC );
+   }  // End of method 'IonexData::getIndex()'
+
+
+   int IonexData::getIndex( const int gdim[3],
+                            const double glat[3],
+                            const double glon[3],
+                            const double ghgt[3],
+                            const Triple& in,
+                            int igp,
+                            Triple& ABC )
    {
          // grid dimensions
-      int nlat = dim[0];
-      int nlon = dim[1];
-      int nhgt = dim[2];
+      int nlat = gdim[0];
+      int nlon = gdim[1];
+      int nhgt = gdim[2];
 
          // useful variables
       int ilat, ilon, ihgt, ncyc;
       double xlat, xlon, xhgt;
 
          // latitude
-      xlat = (in[0] - lat[0]) / lat[2] + 1.0;
+      xlat = (in[0] - glat[0]) / glat[2] + 1.0;
 
       ilat = (igp == 1) ?
          static_cast<int>(xlat+0.5) : static_cast<int>(xlat);
 
       if (ilat >= 1 && ilat <= nlat)
       {
-         ABC[0] = lat[0] + (ilat-1)*lat[2];
+         ABC[0] = glat[0] + (ilat-1)*glat[2];
       }
       else
       {
@@ -455,13 +467,13 @@ namespace gnsstk
       }
 
          // longitude
-      xlon = (in[1] - lon[0]) / lon[2] + 1.0;
+      xlon = (in[1] - glon[0]) / glon[2] + 1.0;
 
       ilon = (igp == 1) ?
          static_cast<int>(xlon + 0.5) : static_cast<int>(xlon);
 
          // Round to neareast integer
-      ncyc = static_cast<int>( ( 360.0 / std::abs(lon[2]) ) + 0.5 );
+      ncyc = static_cast<int>( ( 360.0 / std::abs(glon[2]) ) + 0.5 );
 
       if (ilon < 1)
       {
@@ -475,7 +487,7 @@ namespace gnsstk
 
       if ( (ilon >= 1) && (ilon <= nlon) )
       {
-         ABC[1] = lon[0] + (ilon-1) * lon[2];
+         ABC[1] = glon[0] + (ilon-1) * glon[2];
       }
       else
       {
@@ -485,21 +497,21 @@ namespace gnsstk
       }
 
          // height
-      if (hgt[2] == 0)
+      if (ghgt[2] == 0)
       {
          ihgt = 1;
-         ABC[2] = hgt[0];
+         ABC[2] = ghgt[0];
       }
       else
       {
-         xhgt = (in[2]/1000.0 - hgt[0]) / hgt[2] + 1.0;
+         xhgt = (in[2]/1000.0 - ghgt[0]) / ghgt[2] + 1.0;
 
          ihgt = (igp == 1) ?
             static_cast<int>(xhgt + 0.5) : static_cast<int>(xhgt);
 
          if ( (ihgt >= 1) && (ihgt <= nhgt) )
          {
-            ABC[2] = ( hgt[0] + (ihgt-1) * hgt[2] ) * 1000.0;  //meters
+            ABC[2] = ( ghgt[0] + (ihgt-1) * ghgt[2] ) * 1000.0;  //meters
          }
          else
          {
@@ -508,7 +520,7 @@ namespace gnsstk
             GNSSTK_THROW(e);
          }  // End of 'if ( (ihgt >= 1) && (ihgt <= nhgt) )...'
 
-      }  // End of 'if (hgt[2] == 0)...'
+      }  // End of 'if (ghgt[2] == 0)...'
 
 
       return ( (ilon-1) + (ilat-1)*nlon + (ihgt-1)*nlon*nlat );
@@ -181,6 +181,32 @@ namespace gnsstk
       int getIndex( const Triple& in, int igp, Triple& out ) const;
 
 
+         /** Get the position of a grid point based on input position,
+          *  in a grid given by its definition rather than by an
+          *  IonexData object.  This is shared with IonexStore.
+          *
+          * @param[in] gdim number of values along latitude, longitude
+          *               and height, as in dim
+          * @param[in] glat latitude grid definition, as in lat
+          * @param[in] glon longitude grid definition, as in lon
+          * @param[in] ghgt height grid definition, as in hgt
+          * @param[in] in input lat, lon and height
+          * @param[in] igp grid point to be returned
+          *               (1) neareast grid point
+          *               (2) lower left hand grid point
+          * @param[out] out lat, lon and height
+          * @return       the index within the data
+          * @throw InvalidRequest if the point is outside the grid
+          */
+      static int getIndex( const int gdim[3],
+                           const double glat[3],
+                           const double glon[3],
+                           const double ghgt[3],
+                           const Triple& in,
+                           int igp,
+                           Triple& out );
+
+
          /** Get IONEX TEC or RMS value as a function of the position
           *  and nominal height.
           *
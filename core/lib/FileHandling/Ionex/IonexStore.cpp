@@ -44,7 +44,10 @@
  */
 
 
+#include <cmath>
+
 #include "IonexStore.hpp"
+#include "StringUtils.hpp"
 
 using namespace gnsstk::StringUtils;
 using namespace gnsstk;
@@ -59,7 +62,10 @@ namespace gnsstk
    IonexStore ::
    IonexStore()
          : initialTime(CommonTime::END_OF_TIME),
-           finalTime(CommonTime::BEGINNING_OF_TIME)
+           finalTime(CommonTime::BEGINNING_OF_TIME),
+           gridValid(false),
+           gridHasTEC(false),
+           gridHasRMS(false)
    {
    }
 
@@ -110,6 +116,9 @@ namespace gnsstk
          {
             addMap(iod);
          }
+
+            // copy the maps into the grid, if they fit one
+         buildGrid();
       }
       catch (gnsstk::Exception& e)
       {
@@ -129,6 +138,7 @@ namespace gnsstk
       if (type != IonexData::UN)
       {
          inxMaps[t][type] = iod;
+         gridValid = false;
       }
 
       if (t < initialTime)
@@ -142,6 +152,94 @@ namespace gnsstk
    }  // End of method 'IonexStore::addMap()'
 
 
+   bool IonexStore ::
+   buildGrid()
+   {
+      gridValid = false;
+      gridTimes.clear();
+      gridTEC.clear();
+      gridRMS.clear();
+
+         // interpolation in time needs two maps
+      if (inxMaps.size() < 2)
+      {
+         return false;
+      }
+
+         // the first map defines the grid and value types
+      const IonexValTypeMap& first(inxMaps.begin()->second);
+      IonexValTypeMap::const_iterator ivt(first.find(IonexData::TEC));
+      gridHasTEC = (ivt != first.end());
+      gridHasRMS = (first.find(IonexData::RMS) != first.end());
+      if (!gridHasTEC)
+      {
+         ivt = first.find(IonexData::RMS);
+         if (ivt == first.end())
+         {
+            return false;
+         }
+      }
+      const IonexData& ref(ivt->second);
+      for (int i = 0; i < 3; i++)
+      {
+         gridDim[i] = ref.dim[i];
+         gridLat[i] = ref.lat[i];
+         gridLon[i] = ref.lon[i];
+         gridHgt[i] = ref.hgt[i];
+      }
+      size_t mapSize = gridDim[0] * gridDim[1];
+
+         // same grid as the first map, at a single height
+      auto fits = [&](const IonexData& iod)
+      {
+         return ( iod.dim[0] == gridDim[0] && iod.dim[1] == gridDim[1] &&
+                  iod.dim[2] == 1 && iod.hgt[2] == 0 &&
+                  iod.lat[0] == gridLat[0] && iod.lat[2] == gridLat[2] &&
+                  iod.lon[0] == gridLon[0] && iod.lon[2] == gridLon[2] &&
+                  iod.data.size() == mapSize );
+      };
+
+      bool ok = true;
+      for (IonexMap::const_iterator itm = inxMaps.begin();
+           itm != inxMaps.end(); itm++)
+      {
+         const IonexValTypeMap& ivtm(itm->second);
+         IonexValTypeMap::const_iterator tec(ivtm.find(IonexData::TEC));
+         IonexValTypeMap::const_iterator rms(ivtm.find(IonexData::RMS));
+         if ( ((tec != ivtm.end()) != gridHasTEC) ||
+              ((rms != ivtm.end()) != gridHasRMS) ||
+              (gridHasTEC && !fits(tec->second)) ||
+              (gridHasRMS && !fits(rms->second)) )
+         {
+            ok = false;
+            break;
+         }
+         if (gridHasTEC)
+         {
+            gridTEC.insert( gridTEC.end(), tec->second.data.begin(),
+                            tec->second.data.end() );
+         }
+         if (gridHasRMS)
+         {
+            gridRMS.insert( gridRMS.end(), rms->second.data.begin(),
+                            rms->second.data.end() );
+         }
+         gridTimes.push_back(itm->first);
+      }
+
+      if (!ok)
+      {
+         gridTimes.clear();
+         gridTEC.clear();
+         gridRMS.clear();
+         return false;
+      }
+
+      gridValid = true;
+      return true;
+   }  // End of method 'IonexStore::buildGrid()'
+
+
    void IonexStore ::
    dump( std::ostream& s,
          short detail ) const
@@ -225,6 +323,10 @@ namespace gnsstk
    clear()
    {
       inxMaps.clear();
+      gridValid = false;
+      gridTimes.clear();
+      gridTEC.clear();
+      gridRMS.clear();
 
       initialTime = CommonTime::END_OF_TIME;
       finalTime = CommonTime::BEGINNING_OF_TIME;
@@ -241,6 +343,65 @@ namespace gnsstk
          // (i.e, TEC, RMS, ionosphere height)
       Triple tecval(0.0,0.0,0.0);
 
+         // look for valid Ionex maps and their interpolation factors
+      CommonTime T[2];
+      size_t index[2];
+      double f[2];
+      int nmap = findMaps(t, strategy, T, index, f);
+
+         // this never should happen but just in case
+      if ( RX.getCoordinateSystem() != Position::Geocentric )
+      {
+         InvalidRequest e("Position object is not in GEOCENTRIC coordinates");
+         GNSSTK_THROW(e);
+      }
+
+      addValues(t, RX, strategy, nmap, T, index, f, tecval);
+
+         // ionosphere height in meters
+      tecval[2] = RX.theArray[2];
+
+      return tecval;
+   }  // End of method 'IonexStore::getIonexValue()'
+
+
+   void IonexStore ::
+   getIonexValues( const CommonTime& t,
+                   const std::vector<Position>& RX,
+                   std::vector<Triple>& values,
+                   IonexStoreStrategy strategy ) const
+   {
+         // the maps and factors are the same for all positions
+      CommonTime T[2];
+      size_t index[2];
+      double f[2];
+      int nmap = findMaps(t, strategy, T, index, f);
+
+      values.resize(RX.size());
+      for (size_t i = 0; i < RX.size(); i++)
+      {
+         if ( RX[i].getCoordinateSystem() != Position::Geocentric )
+         {
+            InvalidRequest e("Position object is not in GEOCENTRIC "
+                             "coordinates");
+            GNSSTK_THROW(e);
+         }
+
+         Triple tecval(0.0,0.0,0.0);
+         addValues(t, RX[i], strategy, nmap, T, index, f, tecval);
+         tecval[2] = RX[i].theArray[2];
+         values[i] = tecval;
+      }
+   }  // End of method 'IonexStore::getIonexValues()'
+
+
+   int IonexStore ::
+   findMaps( const CommonTime& t,
+             IonexStoreStrategy strategy,
+             CommonTime T[2],
+             size_t index[2],
+             double f[2] ) const
+   {
          // current time check
       if (t < getInitialTime())
       {
@@ -254,14 +415,6 @@ namespace gnsstk
          GNSSTK_THROW(e);
       }
 
-         // this never should happen but just in case
-      Position pos(RX);
-      if ( pos.getSystemName() != "Geocentric" )
-      {
-         InvalidRequest e("Position object is not in GEOCENTRIC coordinates");
-         GNSSTK_THROW(e);
-      }
-
          //let's define the number of maps to be considered
       int nmap;
       switch (strategy)
@@ -282,37 +435,60 @@ namespace gnsstk
          }
       }
 
-         // let's look for valid Ionex maps
-      CommonTime T[2];
-         // iterator
-      IonexMap::const_iterator itm = inxMaps.find(t);
-      try
+      if (gridValid)
       {
-         if( itm != inxMaps.end() )              // exact match of t
+            // estimate the index of the last map at or before t from
+            // the mean spacing of the maps, then correct it. At the
+            // last map, interpolate between it and the one before.
+         size_t last = gridTimes.size() - 1;
+         double x = (t - gridTimes[0]) * last /
+            (gridTimes[last] - gridTimes[0]);
+         size_t k = (x > 0.0) ? static_cast<size_t>(x) : 0;
+         if (k > last-1)
+         {
+            k = last-1;
+         }
+         while (k > 0 && t < gridTimes[k])
+         {
+            k--;
+         }
+         while (k < last-1 && gridTimes[k+1] <= t)
+         {
+            k++;
+         }
+         index[0] = k;
+         index[1] = k+1;
+         T[0] = gridTimes[k];
+         T[1] = gridTimes[k+1];
+      }
+      else
+      {
+            // the first map at or after t
+         IonexMap::const_iterator itm = inxMaps.lower_bound(t);
+         if ( inxMaps.size() < 2 || itm == inxMaps.end() ||
+              (itm == inxMaps.begin() && itm->first != t) )
+         {
+            InvalidRequest e("IonexStore::getIonexValue() ... Invalid time!");
+            GNSSTK_THROW(e);
+         }
+
+         IonexMap::const_iterator next(itm);
+         if( itm->first == t && ++next != inxMaps.end() )   // exact match
          {
-               // get the current map
-            itm = inxMaps.lower_bound(t);
                // store current and next epoch
             T[0] = itm->first;
-            T[1] = (++itm)->first;
+            T[1] = next->first;
          }
-         else                                   // t is between two maps
+         else      // t is between two maps, or at the last map
          {
-               // get the next valid map
-            itm = inxMaps.lower_bound(t);
-               // store the next and previous epoch
+               // store the next (or last) and previous epoch
             T[1] = itm->first;
             T[0] = (--itm)->first;
-         }  // end of 'if( itm != inxMaps.end() ) ... else ... ''
-      }
-      catch (...)
-      {
-         InvalidRequest e("IonexStore::getIonexValue() ... Invalid time!");
-         GNSSTK_THROW(e);
+         }
+         index[0] = index[1] = 0;
       }
 
          // factors (As in Eq.(3), pag.2 of the manual)
-      double f[2];
       f[0] = (T[1]-t   ) / (T[1]-T[0]);
       f[1] = (t   -T[0]) / (T[1]-T[0]);
 
@@ -323,63 +499,162 @@ namespace gnsstk
          if( f[1] > f[0] )
          {
             T[0] = T[1];
+            index[0] = index[1];
          }
 
             // than the factor is unit
          f[0] = 1.0;
       }  // if( nmap == 1 )
 
+      return nmap;
+   }  // End of method 'IonexStore::findMaps()'
+
+
+   void IonexStore ::
+   addValues( const CommonTime& t,
+              const Position& RX,
+              IonexStoreStrategy strategy,
+              int nmap,
+              const CommonTime T[2],
+              const size_t index[2],
+              const double f[2],
+              Triple& tecval ) const
+   {
+         // seconds of time to degree (360.0 / 86400.0)
+      static const double sec2deg( 4.16666666666667e-3 );
+
+         // take into account the rotation around the Sun?
+      bool rotate = ( (strategy != IonexStoreStrategy::Nearest) &&
+                      (strategy != IonexStoreStrategy::Consecutive) );
+
          // loop over the number of maps considered
       for(int imap = 0; imap < nmap; imap++)
       {
-            // now let's determine if we keep fixed position or
-            // take into account the rotation around the Sun
-         Position pos;
-         if ((strategy == IonexStoreStrategy::Nearest) ||
-             (strategy == IonexStoreStrategy::Consecutive))    // fixed position
+         if (gridValid)
          {
-            pos = RX;
+            double beta = RX.theArray[0];
+            double lambda = RX.theArray[1];
+            if (rotate)
+            {
+               lambda = lambda + ( t - T[imap] ) * sec2deg;
+            }
+
+               // TEC and RMS share the grid, so find the cell once
+            int e[4];
+            double xp, xq;
+            gridCell(beta, lambda, e, xp, xq);
+            size_t offset = index[imap] * gridDim[0] * gridDim[1];
+            if (gridHasTEC)
+            {
+               tecval[0] = tecval[0] +
+                  f[imap]*gridValue(&gridTEC[offset], e, xp, xq);
+            }
+            if (gridHasRMS)
+            {
+               tecval[1] = tecval[1] +
+                  f[imap]*gridValue(&gridRMS[offset], e, xp, xq);
+            }
+            continue;
          }
-         else                                   // rotate the position
-         {
-               // seconds of time to degree (360.0 / 86400.0)
-            double sec2deg( 4.16666666666667e-3 );
 
+            // now let's determine if we keep fixed position or
+            // take into account the rotation around the Sun
+         Position pos(RX);
+         if (rotate)
+         {
                // count the rotation
-            pos = RX;
             pos.theArray[1] = pos.theArray[1] + ( t - T[imap] ) * sec2deg;
-         }  // End of 'if (strategy == Nearest || strategy == Consecutive)...'
-
-
-            // iterator to the current map
-         itm = inxMaps.find(T[imap]);
-
-            // map to hold the IONEX types for the current map
-         IonexValTypeMap ivtm = (*itm).second;
+         }
 
-            // object to hold the corresponding data to the current map
-         IonexData iod;
+            // the IONEX types for the current map
+         const IonexValTypeMap& ivtm(inxMaps.find(T[imap])->second);
+         IonexValTypeMap::const_iterator ivt;
 
             // Compute TEC value
-         if ( ivtm.find(IonexData::TEC) != ivtm.end() )
+         ivt = ivtm.find(IonexData::TEC);
+         if ( ivt != ivtm.end() )
          {
-            iod = ivtm[IonexData::TEC];
-            tecval[0] = tecval[0] + f[imap]*iod.getValue(pos);
+            tecval[0] = tecval[0] + f[imap]*ivt->second.getValue(pos);
          }
 
             // Compute RMS value
-         if ( ivtm.find(IonexData::RMS) != ivtm.end() )
+         ivt = ivtm.find(IonexData::RMS);
+         if ( ivt != ivtm.end() )
          {
-            iod = ivtm[IonexData::RMS];
-            tecval[1] = tecval[1] + f[imap]*iod.getValue(pos);
+            tecval[1] = tecval[1] + f[imap]*ivt->second.getValue(pos);
          }
       }  // End of 'for(int imap = 0; imap < nmap; imap++)...'
+   }  // End of method 'IonexStore::addValues()'
 
-         // ionosphere height in meters
-      tecval[2] = RX.theArray[2];
 
-      return tecval;
-   }  // End of method 'IonexStore::getIonexValue()'
+   void IonexStore ::
+   gridCell( double beta,
+             double lambda,
+             int e[4],
+             double& xp,
+             double& xq ) const
+   {
+         // IONEX longitudes are within [-180 180] (see IONEX manual)
+      if (lambda > 180.0)
+      {
+         lambda = lambda - 360.0;
+      }
+
+         // get position of lower left hand grid point E00, the
+         // grid is at a single height so the height is ignored
+      Triple ABC[4];
+      e[0] = IonexData::getIndex( gridDim, gridLat, gridLon, gridHgt,
+                                  Triple(beta, lambda, 0.0), 2, ABC[0] );
+
+         // compute factors P and Q
+      xp = (lambda - ABC[0][1]) / gridLon[2];
+      xq = (beta - ABC[0][0]) / gridLat[2];
+
+         // this never should happen but just in case
+      if ( (xp < 0) || (xp > 1) || (xq < 0) || (xq > 1) )
+      {
+         Exception exc("IonexStore::gridCell(): Wrong xp and xq factors!");
+         GNSSTK_THROW(exc);
+      }
+
+         // get E10's, E01's and E11's position index
+      e[1] = IonexData::getIndex( gridDim, gridLat, gridLon, gridHgt,
+                                  Triple( ABC[0][0], ABC[0][1]+gridLon[2],
+                                          ABC[0][2] ), 1, ABC[1] );
+      e[2] = IonexData::getIndex( gridDim, gridLat, gridLon, gridHgt,
+                                  Triple( ABC[0][0]+gridLat[2], ABC[0][1],
+                                          ABC[0][2] ), 1, ABC[2] );
+      e[3] = IonexData::getIndex( gridDim, gridLat, gridLon, gridHgt,
+                                  Triple( ABC[0][0]+gridLat[2],
+                                          ABC[0][1]+gridLon[2],
+                                          ABC[0][2] ), 1, ABC[3] );
+   }  // End of method 'IonexStore::gridCell()'
+
+
+   double IonexStore ::
+   gridValue( const double *values,
+              const int e[4],
+              double xp,
+              double xq ) const
+   {
+         // let's fetch the values
+      double pntval[4];
+      for (int i = 0; i < 4; i++)
+      {
+         pntval[i] = values[e[i]];
+         if (pntval[i] == 999.9)
+         {
+            FFStreamError e("Undefined TEC/RMS value(s).");
+            GNSSTK_THROW(e);
+         }
+      }
+
+         // bivariate interpolation (pag.3, IONEX manual)
+      return ( (1.0-xp) * (1.0-xq) * pntval[0] +
+               xp  * (1.0-xq) * pntval[1] +
+               (1.0-xp) *      xq  * pntval[2] +
+               xp  *      xq  * pntval[3] );
+   }  // End of method 'IonexStore::gridValue()'
 
 
    double IonexStore ::
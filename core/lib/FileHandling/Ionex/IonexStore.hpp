@@ -47,6 +47,7 @@
 #define GNSSTK_IONEXSTORE_HPP
 
 #include <map>
+#include <vector>
 
 #include "FileStore.hpp"
 #include "IonexData.hpp"
@@ -71,6 +72,14 @@ namespace gnsstk
        * @sa test ionex store.cpp for an example
        *
        *
+       * When all the maps share one latitude/longitude grid at a
+       * single height and carry the same value types, loadFile() also
+       * copies them into one contiguous time x latitude x longitude
+       * array per value type. getIonexValue() and getIonexValues()
+       * then find the maps and grid points by index arithmetic instead
+       * of map lookups, with the same results. Otherwise they use the
+       * maps as loaded.
+       *
        * @warning The first IONEX map refers to 00:00 UT, the last map
        *          to 24:00 UT. The time spacing of the maps (snapshots) is 2
        *          hours. When two consecutive files are loaded the previuous
@@ -91,9 +100,23 @@ namespace gnsstk
           */
       virtual void loadFile(const std::string& filename);
 
-         /// Insert a new IonexData object into the store
+         /** Insert a new IonexData object into the store. The maps are
+          * then looked up one by one until buildGrid() is called. */
       void addMap(const IonexData& iod);
 
+         /** Copy the maps into the contiguous grid used by
+          * getIonexValue() and getIonexValues(). loadFile() calls
+          * this; call it after adding maps with addMap().
+          * @return true if the maps fit a single grid, false if they
+          *   don't (e.g. the grids differ, the maps have more than
+          *   one height, or only some epochs have RMS maps), in which
+          *   case the maps are looked up one by one. */
+      bool buildGrid();
+
+         /// Return true if the contiguous grid is in use.
+      bool hasGrid() const
+      { return gridValid; }
+
          /** Dump the store to the provided std::ostream (std::cout by default).
           *
           * @param[in,out] s   std::ostream object to dump the data to.
@@ -133,6 +156,26 @@ namespace gnsstk
                             IonexStoreStrategy strategy =
                             IonexStoreStrategy::ConsRot ) const;
 
+         /** Get IONEX TEC, RMS and ionosphere height values at one
+          * epoch for many positions, e.g. the ionospheric pierce
+          * points of all the satellites seen by a network of
+          * receivers. Each value is the one getIonexValue() returns,
+          * but the maps and interpolation factors for the epoch are
+          * found once.
+          *
+          * @param[in] t          Time tag of signal (CommonTime object)
+          * @param[in] RX         Positions in ECEF geocentric coordinates.
+          * @param[out] values    TEC, RMS and ionosphere height values of
+          *                       each position, as from getIonexValue().
+          * @param[in] strategy   Interpolation strategy.
+          * @throw InvalidRequest
+          */
+      void getIonexValues( const CommonTime& t,
+                           const std::vector<Position>& RX,
+                           std::vector<Triple>& values,
+                           IonexStoreStrategy strategy =
+                           IonexStoreStrategy::ConsRot ) const;
+
          /** Get slant total electron content (STEC) in TECU
           *
           * @param[in] elevation    Time tag of signal (CommonTime object)
@@ -322,6 +365,77 @@ namespace gnsstk
 
          /// Map of DCB values (IonexHeader.firstEpoch, IonexHeader.svsmap)
       IonexDCBMap inxDCBMap;
+
+         /// true if the grid below holds the maps in inxMaps
+      bool gridValid;
+
+         /// Epochs of the maps in the grid, in increasing order
+      std::vector<CommonTime> gridTimes;
+
+         /// Number of latitudes, longitudes and heights (always 1)
+         /// of each map in the grid
+      int gridDim[3];
+
+         /// Latitude, longitude and height grid definition, as in IonexData
+      double gridLat[3], gridLon[3], gridHgt[3];
+
+         /// TEC values, indexed by time, latitude and longitude
+      std::vector<double> gridTEC;
+
+         /// RMS values, indexed by time, latitude and longitude
+      std::vector<double> gridRMS;
+
+         /// true if the maps have TEC and RMS values, respectively
+      bool gridHasTEC, gridHasRMS;
+
+         /** Find the maps and interpolation factors for time t.
+          * @param[in] t the time of interest
+          * @param[in] strategy the interpolation strategy
+          * @param[out] T the epochs of the maps to use
+          * @param[out] index the index in gridTimes of the maps
+          *   to use, if the grid is in use
+          * @param[out] f the interpolation factors of the maps
+          * @return the number of maps to use, 1 or 2
+          * @throw InvalidRequest */
+      int findMaps( const CommonTime& t,
+                    IonexStoreStrategy strategy,
+                    CommonTime T[2],
+                    size_t index[2],
+                    double f[2] ) const;
+
+         /** Add the values of the maps at T, weighted by f, at the
+          * position RX to tecval, as getIonexValue() does.
+          * @throw InvalidRequest
+          * @throw FFStreamError */
+      void addValues( const CommonTime& t,
+                      const Position& RX,
+                      IonexStoreStrategy strategy,
+                      int nmap,
+                      const CommonTime T[2],
+                      const size_t index[2],
+                      const double f[2],
+                      Triple& tecval ) const;
+
+         /** Find the grid cell of latitude beta and longitude lambda
+          * (degrees) as IonexData::getValue() does.
+          * @param[out] e the indices of the cell corners in a map
+          * @param[out] xp,xq the position in the cell, as fractions
+          *   of the longitude and latitude spacing
+          * @throw InvalidRequest
+          * @throw Exception */
+      void gridCell( double beta,
+                     double lambda,
+                     int e[4],
+                     double& xp,
+                     double& xq ) const;
+
+         /** Interpolate the values of a map in the grid in the cell
+          * found by gridCell().
+          * @throw FFStreamError */
+      double gridValue( const double *values,
+                        const int e[4],
+                        double xp,
+                        double xq ) const;
    }; // End of class 'IonexStore'
 
       //@}
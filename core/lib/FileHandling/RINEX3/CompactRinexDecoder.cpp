@@ -0,0 +1,467 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/**
+ * @file CompactRinexDecoder.cpp
+ * Expand Compact RINEX (Hatanaka) observation data into RINEX.
+ */
+
+#include <algorithm>
+#include <cstring>
+#include "CompactRinexDecoder.hpp"
+#include "StringUtils.hpp"
+
+   /** Return true if the header label of line, which starts at
+    * column 60, begins with label. */
+static bool hasLabel(const char* line, std::size_t len, const char* label)
+{
+   std::size_t labelLen = std::strlen(label);
+   return ((len >= 60 + labelLen) &&
+           (std::memcmp(line + 60, label, labelLen) == 0));
+}
+
+
+   /** Restore text from a Compact RINEX text difference, in which a
+    * blank means unchanged, '&' means blank and anything else
+    * replaces the character. */
+static void repair(std::string& text, const char* diff, std::size_t len)
+{
+   if (text.size() < len)
+      text.resize(len, ' ');
+   for (std::size_t i = 0; i < len; i++)
+   {
+      if (diff[i] != ' ')
+         text[i] = (diff[i] == '&' ? ' ' : diff[i]);
+   }
+}
+
+
+   /** Parse a signed decimal integer.
+    * @return false if str is not an integer. */
+static bool parseInteger(const char* str, std::size_t len, long long& value)
+{
+   bool neg = ((len > 0) && (str[0] == '-'));
+   std::size_t i = (neg ? 1 : 0);
+   if ((i == len) || (len - i > 18))
+      return false;
+   long long v = 0;
+   for (; i < len; i++)
+   {
+      unsigned digit = static_cast<unsigned char>(str[i]) - '0';
+      if (digit > 9)
+         return false;
+      v = v * 10 + digit;
+   }
+   value = (neg ? -v : v);
+   return true;
+}
+
+
+   /** Write value, an integer count of 10^-decimals, as a
+    * right-justified fixed point number (i.e. Fortran F format)
+    * filling the width characters starting at field.  As in Fortran,
+    * a number that doesn't fit is written as asterisks. */
+static void putFixed(char* field, long long value, int width, int decimals)
+{
+   char buf[32];
+   char *p = buf + sizeof(buf);
+   unsigned long long mag = (value < 0 ? -static_cast<unsigned long long>(value)
+                             : value);
+   for (int i = 0; i < decimals; i++, mag /= 10)
+      *--p = '0' + (mag % 10);
+   *--p = '.';
+   do
+   {
+      *--p = '0' + (mag % 10);
+      mag /= 10;
+   } while (mag > 0);
+   if (value < 0)
+      *--p = '-';
+   int len = buf + sizeof(buf) - p;
+   if (len > width)
+   {
+      std::memset(field, '*', width);
+      return;
+   }
+   std::memset(field, ' ', width - len);
+   std::memcpy(field + width - len, p, len);
+}
+
+
+   /// Remove trailing blanks from out after position start.
+static void trimLine(std::string& out, std::size_t start)
+{
+   std::size_t end = out.size();
+   while ((end > start) && (out[end-1] == ' '))
+      end--;
+   out.resize(end);
+}
+
+
+namespace gnsstk
+{
+   CompactRinexDecoder ::
+   CompactRinexDecoder()
+   {
+      reset();
+   }
+
+
+   bool CompactRinexDecoder ::
+   isCompactRinex(const char* line, std::size_t len)
+   {
+      return hasLabel(line, len, "CRINEX VERS   / TYPE");
+   }
+
+
+   void CompactRinexDecoder ::
+   reset()
+   {
+      expect = Expect::Version;
+      version = 0;
+      linesLeft = 0;
+      epochCount = 0;
+      epochFlag = ' ';
+      epochLine.clear();
+      clock = Arc();
+      epochSats.clear();
+      satIndex = 0;
+      sats.clear();
+      obsTypeCount.clear();
+   }
+
+
+   void CompactRinexDecoder ::
+   decodeLine(const char* line, std::size_t len, std::string& out)
+   {
+      while ((len > 0) && (line[len-1] == '\r'))
+         len--;
+      switch (expect)
+      {
+         case Expect::Version:
+            if (!isCompactRinex(line, len))
+            {
+               FFStreamError err("Not a Compact RINEX file");
+               GNSSTK_THROW(err);
+            }
+            version = StringUtils::asInt(line, 20);
+            if ((version != 1) && (version != 3))
+            {
+               FFStreamError err("Unsupported Compact RINEX version " +
+                                 std::string(line, 20));
+               GNSSTK_THROW(err);
+            }
+            expect = Expect::Program;
+            break;
+         case Expect::Program:
+            if (!hasLabel(line, len, "CRINEX PROG / DATE"))
+            {
+               FFStreamError err("Missing CRINEX PROG / DATE");
+               GNSSTK_THROW(err);
+            }
+            expect = Expect::Header;
+            break;
+         case Expect::Header:
+            scanHeader(line, len);
+            out.append(line, len);
+            out += '\n';
+            if (hasLabel(line, len, "END OF HEADER"))
+               expect = Expect::Epoch;
+            break;
+         case Expect::Epoch:
+               // Trailing blanks never carry information in the
+               // differenced lines.
+            while ((len > 0) && (line[len-1] == ' '))
+               len--;
+            if (len > 0)
+               decodeEpoch(line, len, out);
+            break;
+         case Expect::Clock:
+            while ((len > 0) && (line[len-1] == ' '))
+               len--;
+            decodeClock(line, len, out);
+            break;
+         case Expect::Data:
+            while ((len > 0) && (line[len-1] == ' '))
+               len--;
+            decodeData(line, len, out);
+            break;
+         case Expect::Event:
+            scanHeader(line, len);
+            out.append(line, len);
+            out += '\n';
+            if (--linesLeft == 0)
+               expect = Expect::Epoch;
+            break;
+      }
+   }
+
+
+   bool CompactRinexDecoder ::
+   decodeField(Arc& arc, const char* field, std::size_t len)
+   {
+      if (len == 0)
+      {
+         arc.order = -1;
+         return false;
+      }
+      if ((len > 1) && (field[1] == '&'))
+      {
+            // start of a new arc, "order&value"
+         arc.arcOrder = static_cast<unsigned char>(field[0]) - '0';
+         arc.order = 0;
+         if ((arc.arcOrder < 0) || (arc.arcOrder > maxOrder) ||
+             !parseInteger(field + 2, len - 2, arc.diff[0]))
+         {
+            FFStreamError err("Invalid Compact RINEX field: " +
+                              std::string(field, len));
+            GNSSTK_THROW(err);
+         }
+         return true;
+      }
+      if (arc.order < 0)
+      {
+         FFStreamError err("Compact RINEX difference without an initial"
+                           " value: " + std::string(field, len));
+         GNSSTK_THROW(err);
+      }
+      if (arc.order < arc.arcOrder)
+         arc.order++;
+      if (!parseInteger(field, len, arc.diff[arc.order]))
+      {
+         FFStreamError err("Invalid Compact RINEX field: " +
+                           std::string(field, len));
+         GNSSTK_THROW(err);
+      }
+      for (int i = arc.order; i > 0; i--)
+         arc.diff[i-1] += arc.diff[i];
+      return true;
+   }
+
+
+   void CompactRinexDecoder ::
+   decodeEpoch(const char* line, std::size_t len, std::string& out)
+   {
+      std::size_t flagCol = (version == 1 ? 28 : 31);
+      std::size_t satCol = (version == 1 ? 32 : 41);
+      if (line[0] == (version == 1 ? '&' : '>'))
+      {
+         epochLine.assign(line, len);
+         if (version == 1)
+            epochLine[0] = ' ';
+            // An initialized epoch starts every satellite afresh.
+         epochCount++;
+      }
+      else if (epochLine.empty())
+      {
+         FFStreamError err("Compact RINEX epoch without an initial epoch");
+         GNSSTK_THROW(err);
+      }
+      else
+      {
+         repair(epochLine, line, len);
+      }
+      epochCount++;
+      if (epochLine.size() < satCol)
+         epochLine.resize(satCol, ' ');
+      epochFlag = epochLine[flagCol];
+      long numSats = StringUtils::asInt(epochLine.data() + flagCol + 1, 3);
+      if (numSats < 0)
+      {
+         FFStreamError err("Invalid Compact RINEX epoch: " + epochLine);
+         GNSSTK_THROW(err);
+      }
+      if ((epochFlag >= '2') && (epochFlag <= '5'))
+      {
+            // Special event, followed by numSats lines of header
+            // records that are copied as they are.
+         std::size_t start = out.size();
+         out += epochLine;
+         trimLine(out, start);
+         out += '\n';
+         linesLeft = numSats;
+         expect = (linesLeft > 0 ? Expect::Event : Expect::Epoch);
+         return;
+      }
+      if (epochLine.size() < satCol + 3 * numSats)
+         epochLine.resize(satCol + 3 * numSats, ' ');
+      epochSats.clear();
+      for (long i = 0; i < numSats; i++)
+      {
+         SatState& sat(sats[epochLine.substr(satCol + 3 * i, 3)]);
+         if (sat.epoch + 1 != epochCount)
+         {
+               // not in the previous epoch
+            sat.arcs.clear();
+            sat.flags.clear();
+         }
+         sat.epoch = epochCount;
+         epochSats.push_back(&sat);
+      }
+      satIndex = 0;
+      expect = Expect::Clock;
+   }
+
+
+   void CompactRinexDecoder ::
+   decodeClock(const char* line, std::size_t len, std::string& out)
+   {
+      bool haveClock = decodeField(clock, line, len);
+      std::size_t numSats = epochSats.size();
+      if (version == 1)
+      {
+            // RINEX 2 lists 12 satellites per line, clock on the first
+         std::size_t start = out.size();
+         out.append(epochLine, 0, 32);
+         for (std::size_t i = 0; (i < numSats) && (i < 12); i++)
+            out.append(epochLine, 32 + 3 * i, 3);
+         if (haveClock)
+         {
+            out.resize(start + 80, ' ');
+            putFixed(&out[start + 68], clock.diff[0], 12, 9);
+         }
+         out += '\n';
+         for (std::size_t i = 12; i < numSats; i++)
+         {
+            if (i % 12 == 0)
+               out.append(32, ' ');
+            out.append(epochLine, 32 + 3 * i, 3);
+            if ((i % 12 == 11) || (i + 1 == numSats))
+               out += '\n';
+         }
+      }
+      else
+      {
+         out.append(epochLine, 0, 35);
+         if (haveClock)
+         {
+            out.append(21, ' ');
+            putFixed(&out[out.size() - 15], clock.diff[0], 15, 12);
+         }
+         out += '\n';
+      }
+      expect = (numSats > 0 ? Expect::Data : Expect::Epoch);
+   }
+
+
+   void CompactRinexDecoder ::
+   decodeData(const char* line, std::size_t len, std::string& out)
+   {
+      SatState& sat(*epochSats[satIndex]);
+      const char *satID = epochLine.data() + (version == 1 ? 32 : 41) +
+         3 * satIndex;
+      std::size_t numObs = numObsTypes(version == 1 ? '\0' : satID[0]);
+      if (sat.arcs.size() != numObs)
+         sat.arcs.assign(numObs, Arc());
+         // One space-separated field per observation type, then the
+         // differenced LLI/SSI flags.
+      const char *pos = line, *end = line + len;
+      for (std::size_t i = 0; i < numObs; i++)
+      {
+         const char *sep = nullptr;
+         if (pos < end)
+            sep = static_cast<const char*>(std::memchr(pos, ' ', end - pos));
+         if (sep == nullptr)
+            sep = end;
+         decodeField(sat.arcs[i], pos, sep - pos);
+         pos = (sep < end ? sep + 1 : end);
+      }
+      repair(sat.flags, pos, end - pos);
+      if (sat.flags.size() < 2 * numObs)
+         sat.flags.resize(2 * numObs, ' ');
+      std::size_t start = out.size();
+      if (version != 1)
+         out.append(satID, 3);
+      for (std::size_t i = 0; i < numObs; i++)
+      {
+         out.append(16, ' ');
+         char *field = &out[out.size() - 16];
+         if (sat.arcs[i].order >= 0)
+            putFixed(field, sat.arcs[i].diff[0], 14, 3);
+         field[14] = sat.flags[2 * i];
+         field[15] = sat.flags[2 * i + 1];
+            // RINEX 2 has five observations per line
+         if ((version == 1) && ((i % 5 == 4) || (i + 1 == numObs)))
+         {
+            trimLine(out, start);
+            out += '\n';
+            start = out.size();
+         }
+      }
+      if (version != 1)
+      {
+         trimLine(out, start);
+         out += '\n';
+      }
+      if (++satIndex == epochSats.size())
+         expect = Expect::Epoch;
+   }
+
+
+   void CompactRinexDecoder ::
+   scanHeader(const char* line, std::size_t len)
+   {
+      if ((version == 1) && hasLabel(line, len, "# / TYPES OF OBSERV"))
+      {
+            // continuation lines leave the count blank
+         long count = StringUtils::asInt(line, 6);
+         if (count > 0)
+            obsTypeCount['\0'] = count;
+      }
+      else if ((version != 1) && hasLabel(line, len, "SYS / # / OBS TYPES") &&
+               (line[0] != ' '))
+      {
+         obsTypeCount[line[0]] = StringUtils::asInt(line + 3, 3);
+      }
+   }
+
+
+   int CompactRinexDecoder ::
+   numObsTypes(char sys) const
+   {
+      std::map<char, int>::const_iterator i = obsTypeCount.find(sys);
+      if (i == obsTypeCount.end())
+      {
+         FFStreamError err("No observation types for system " +
+                           std::string(1, sys));
+         GNSSTK_THROW(err);
+      }
+      return i->second;
+   }
+
+}  // End of namespace gnsstk
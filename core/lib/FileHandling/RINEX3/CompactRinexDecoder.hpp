@@ -0,0 +1,179 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/**
+ * @file CompactRinexDecoder.hpp
+ * Expand Compact RINEX (Hatanaka) observation data into RINEX.
+ */
+
+#ifndef GNSSTK_COMPACTRINEXDECODER_HPP
+#define GNSSTK_COMPACTRINEXDECODER_HPP
+
+#include <map>
+#include <string>
+#include <vector>
+#include "FFStreamError.hpp"
+
+namespace gnsstk
+{
+      /// @ingroup FileHandling
+      //@{
+
+      /**
+       * Expand Compact RINEX, as written by Hatanaka's RNX2CRX, back
+       * into the RINEX observation file it was made from.  Both
+       * CRINEX 1.0 (RINEX 2 observation files) and CRINEX 3.0 (RINEX
+       * 3 observation files) are supported.
+       *
+       * The decoder is fed the Compact RINEX file one line at a time
+       * and appends the corresponding RINEX text to a string.  It is
+       * used by FFTextPipeline so that FFTextStream, and therefore
+       * Rinex3ObsStream, can read Compact RINEX files directly.
+       */
+   class CompactRinexDecoder
+   {
+   public:
+         /// Highest order of differencing that can be decoded.
+      static const int maxOrder = 9;
+
+         /// Initialize to expect the start of a Compact RINEX file.
+      CompactRinexDecoder();
+
+         /** Determine if a line is the first line of a Compact
+          * RINEX file.
+          * @param[in] line The first line of the file.
+          * @param[in] len The length of line, excluding any newline.
+          * @return true if line is a CRINEX VERS / TYPE record. */
+      static bool isCompactRinex(const char* line, std::size_t len);
+
+         /// Discard all state and expect the start of a new file.
+      void reset();
+
+         /** Decode a line of Compact RINEX.
+          * @param[in] line The line to decode, without its newline.
+          * @param[in] len The length of line.
+          * @param[in,out] out The RINEX lines (zero or more) that
+          *   line decodes to are appended to this string, each
+          *   terminated by a newline.
+          * @throw FFStreamError if line is not valid Compact RINEX. */
+      void decodeLine(const char* line, std::size_t len, std::string& out);
+
+         /// Return the CRINEX major version (1 or 3), or 0 if unknown.
+      int getVersion() const
+      { return version; }
+
+   private:
+         /// What the next line of the file is expected to hold.
+      enum class Expect
+      {
+         Version, ///< CRINEX VERS / TYPE
+         Program, ///< CRINEX PROG / DATE
+         Header,  ///< RINEX header records
+         Epoch,   ///< Differenced epoch line
+         Clock,   ///< Differenced receiver clock offset
+         Data,    ///< Differenced observations for one satellite
+         Event    ///< Special event records, copied verbatim
+      };
+
+         /** One differenced quantity.  diff[0] holds the most recent
+          * value and diff[i] the most recent i-th order difference. */
+      struct Arc
+      {
+         Arc() : order(-1), arcOrder(0) {}
+            /// The order of diff currently held, -1 if no arc is active.
+         int order;
+            /// The order of differencing used by this arc.
+         int arcOrder;
+         long long diff[maxOrder+1];
+      };
+
+         /// Differencing state for a single satellite.
+      struct SatState
+      {
+         SatState() : epoch(0) {}
+            /// The value of epochCount when last seen.
+         unsigned long epoch;
+            /// Observation arcs, in the header's order.
+         std::vector<Arc> arcs;
+            /// LLI and SSI flags, two characters per observation.
+         std::string flags;
+      };
+
+         /** Update an arc from a Compact RINEX field.
+          * @return false if the field is empty (no data). */
+      bool decodeField(Arc& arc, const char* field, std::size_t len);
+         /// Decode a differenced epoch line.
+      void decodeEpoch(const char* line, std::size_t len, std::string& out);
+         /// Decode the clock line and output the RINEX epoch record.
+      void decodeClock(const char* line, std::size_t len, std::string& out);
+         /// Decode the data line for the next satellite.
+      void decodeData(const char* line, std::size_t len, std::string& out);
+         /// Pick up observation type counts from a RINEX header line.
+      void scanHeader(const char* line, std::size_t len);
+         /// Get the number of observation types for a satellite system.
+      int numObsTypes(char sys) const;
+
+         /// The type of the next line.
+      Expect expect;
+         /// CRINEX major version number.
+      int version;
+         /// Number of lines left in the current epoch or event.
+      int linesLeft;
+         /// Incremented for each epoch to track satellite continuity.
+      unsigned long epochCount;
+         /// Event flag of the current epoch.
+      char epochFlag;
+         /// The current, fully-restored, epoch line.
+      std::string epochLine;
+         /// Receiver clock offset differencing state.
+      Arc clock;
+         /// Satellites in the current epoch.
+      std::vector<SatState*> epochSats;
+         /// Index into epochSats of the next data line.
+      std::size_t satIndex;
+         /// Differencing state for every satellite seen, keyed by ID.
+      std::map<std::string, SatState> sats;
+         /// Number of observation types by system ('\0' for RINEX 2).
+      std::map<char, int> obsTypeCount;
+   }; // End of class 'CompactRinexDecoder'
+
+      //@}
+
+}  // End of namespace gnsstk
+
+#endif   // GNSSTK_COMPACTRINEXDECODER_HPP
@@ -0,0 +1,388 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/**
+ * @file Rinex3ObsChunkReader.cpp
+ * Parse RINEX 3 observation files in chunks on a thread pool.
+ */
+
+#include <cctype>
+#include "Rinex3ObsChunkReader.hpp"
+
+namespace gnsstk
+{
+   const std::size_t Rinex3ObsChunkReader::defaultChunkSize = 1 << 20;
+
+
+   Rinex3ObsChunkReader ::
+   Rinex3ObsChunkReader(unsigned threads, std::size_t size)
+         : numThreads(threads),
+           chunkSize(size),
+           nextJob(0),
+           readJob(0),
+           readRecord(0),
+           stopping(false)
+   {
+      if (numThreads == 0)
+      {
+         numThreads = std::thread::hardware_concurrency();
+      }
+      if (chunkSize == 0)
+      {
+         chunkSize = defaultChunkSize;
+      }
+   }
+
+
+   Rinex3ObsChunkReader ::
+   ~Rinex3ObsChunkReader()
+   {
+      close();
+   }
+
+
+   std::size_t Rinex3ObsChunkReader ::
+   addFile(const std::string& fn)
+   {
+      std::unique_ptr<File> file(new File);
+      file->name = fn;
+      std::unique_ptr<Rinex3ObsStream> strm(new Rinex3ObsStream(fn));
+      if (!strm->is_open())
+      {
+         FileMissingException exc("Unable to open " + fn);
+         GNSSTK_THROW(exc);
+      }
+      strm->exceptions(std::fstream::failbit);
+      *strm >> file->header;
+      file->timesystem = strm->timesystem;
+      std::lock_guard<std::mutex> lock(mutex);
+      file->firstJob = file->endJob = jobs.size();
+         // RINEX 2 epoch lines can't be found reliably, and files
+         // being decoded can't be read out of order.
+      if ((numThreads > 1) && (file->header.version >= 3) &&
+          !strm->isDecoded())
+      {
+         std::streamoff body = strm->tellg();
+         strm->seekg(0, std::ios::end);
+         std::streamoff size = strm->tellg();
+         strm.reset();
+         for (std::streamoff pos = body; pos < size; pos += chunkSize)
+         {
+            std::unique_ptr<Job> job(new Job);
+            job->file = files.size();
+            job->begin = pos;
+            job->end = pos + chunkSize;
+            job->first = (pos == body);
+            job->last = (job->end >= size);
+            job->done = false;
+            jobs.push_back(std::move(job));
+         }
+         file->endJob = jobs.size();
+         if (pool.empty())
+         {
+            for (unsigned t = 0; t < numThreads; t++)
+            {
+               pool.push_back(std::thread(&Rinex3ObsChunkReader::worker,
+                                          this));
+            }
+         }
+         jobReady.notify_all();
+      }
+      else
+      {
+         file->strm = std::move(strm);
+      }
+      files.push_back(std::move(file));
+      return files.size() - 1;
+   }
+
+
+   bool Rinex3ObsChunkReader ::
+   read(std::size_t file, Rinex3ObsData& rod)
+   {
+         // addFile() may be growing files on another thread
+      std::unique_lock<std::mutex> lock(mutex);
+      File& f(*files[file]);
+      if (readJob < f.firstJob)
+      {
+            // Skip the rest of the earlier files.  Their threads
+            // discard what they've parsed when they see this.
+         for (std::size_t j = readJob; j < f.firstJob; j++)
+         {
+            if (jobs[j]->done)
+            {
+               jobs[j]->records.clear();
+            }
+         }
+         readJob = f.firstJob;
+         readRecord = 0;
+         if (nextJob < readJob)
+         {
+            nextJob = readJob;
+         }
+         jobReady.notify_all();
+      }
+      if (f.strm)
+      {
+         lock.unlock();
+            // Stop after an error, as there would be after one in
+            // a chunked file.
+         if (!f.strm->good())
+         {
+            return false;
+         }
+         *f.strm >> rod;
+         if (f.strm->eof())
+         {
+            f.strm->close();
+            return false;
+         }
+         return true;
+      }
+      while (readJob < f.endJob)
+      {
+         Job& job(*jobs[readJob]);
+         jobDone.wait(lock, [&job] { return job.done; });
+         if (readRecord < job.records.size())
+         {
+            takeRecord(job.records[readRecord++], rod);
+            return true;
+         }
+         std::exception_ptr error = job.error;
+         job.records.clear();
+         job.error = nullptr;
+         readJob = (error ? f.endJob : readJob + 1);
+         readRecord = 0;
+         if (nextJob < readJob)
+         {
+            nextJob = readJob;
+         }
+         jobReady.notify_all();
+         if (error)
+         {
+            std::rethrow_exception(error);
+         }
+      }
+      return false;
+   }
+
+
+   void Rinex3ObsChunkReader ::
+   close()
+   {
+      {
+         std::lock_guard<std::mutex> lock(mutex);
+         stopping = true;
+      }
+      jobReady.notify_all();
+      for (auto& th : pool)
+      {
+         th.join();
+      }
+      pool.clear();
+      jobs.clear();
+      files.clear();
+      nextJob = readJob = readRecord = 0;
+      stopping = false;
+   }
+
+
+   void Rinex3ObsChunkReader ::
+   worker()
+   {
+         // Each thread keeps its own stream open on the file it is
+         // working on.
+      std::unique_ptr<Rinex3ObsStream> strm;
+      std::size_t strmFile = 0;
+      std::unique_lock<std::mutex> lock(mutex);
+      while (true)
+      {
+            // Limit how far ahead of read() the threads get, so
+            // that the parsed records don't use unbounded memory.
+         jobReady.wait(lock, [this] {
+            return (stopping ||
+                    ((nextJob < jobs.size()) &&
+                     (nextJob < readJob + 2 * numThreads))); });
+         if (stopping)
+         {
+            return;
+         }
+         std::size_t j = nextJob++;
+         Job& job(*jobs[j]);
+         const File& file(*files[job.file]);
+         lock.unlock();
+         try
+         {
+            if (!strm || (strmFile != job.file))
+            {
+               strm.reset(new Rinex3ObsStream(file.name));
+               if (!strm->is_open())
+               {
+                  FileMissingException exc("Unable to open " + file.name);
+                  GNSSTK_THROW(exc);
+               }
+               strm->setReadBackend(FFTextStream::ReadBackend::Mapped);
+               strm->exceptions(std::fstream::failbit);
+               strm->header = file.header;
+               strm->headerRead = true;
+               strm->timesystem = file.timesystem;
+               strmFile = job.file;
+            }
+            parse(job, *strm);
+         }
+         catch (...)
+         {
+            job.error = std::current_exception();
+         }
+         lock.lock();
+         if (j < readJob)
+         {
+               // read() has moved on to a later file.
+            job.records.clear();
+            job.error = nullptr;
+         }
+         job.done = true;
+         jobDone.notify_all();
+      }
+   }
+
+
+   void Rinex3ObsChunkReader ::
+   parse(Job& job, Rinex3ObsStream& strm)
+   {
+      std::streamoff begin = (job.first ? job.begin
+                              : findEpoch(strm, job.begin));
+      if (begin < 0)
+      {
+         return;
+      }
+      std::streamoff end = (job.last ? -1 : findEpoch(strm, job.end));
+      if ((end >= 0) && (end <= begin))
+      {
+            // An epoch larger than the chunk, parsed by the chunk
+            // that it starts in.
+         return;
+      }
+      strm.clear();
+      strm.seekg(begin);
+      while ((end < 0) || (strm.tellg() < end))
+      {
+         job.records.emplace_back();
+         try
+         {
+            strm >> job.records.back();
+         }
+         catch (...)
+         {
+            job.records.pop_back();
+            throw;
+         }
+         if (strm.eof())
+         {
+            job.records.pop_back();
+            break;
+         }
+      }
+   }
+
+
+   std::streamoff Rinex3ObsChunkReader ::
+   findEpoch(Rinex3ObsStream& strm, std::streamoff pos)
+   {
+         // Read the stream buffer directly, as the stream throws
+         // at the end of the file.
+      std::streambuf *sb = strm.rdbuf();
+      std::streamoff off = pos - 1;
+      if (sb->pubseekpos(off, std::ios::in) == std::streampos(-1))
+      {
+         return -1;
+      }
+      int c;
+         // Skip to the start of the next line.
+      while ((c = sb->sbumpc()) != EOF)
+      {
+         off++;
+         if (c == '\n')
+            break;
+      }
+      while (c != EOF)
+      {
+         std::streamoff lineStart = off;
+         char buf[6];
+         std::size_t len = 0;
+         while ((c = sb->sbumpc()) != EOF)
+         {
+            off++;
+            if (c == '\n')
+               break;
+            if (len < sizeof(buf))
+               buf[len++] = c;
+         }
+            // An epoch line starts with "> " and a 4-digit year.
+         if ((len == sizeof(buf)) && (buf[0] == '>') && (buf[1] == ' ') &&
+             std::isdigit(buf[2]) && std::isdigit(buf[3]) &&
+             std::isdigit(buf[4]) && std::isdigit(buf[5]))
+         {
+            return lineStart;
+         }
+      }
+      return -1;
+   }
+
+
+   void Rinex3ObsChunkReader ::
+   takeRecord(Rinex3ObsData& from, Rinex3ObsData& to)
+   {
+      bool hadAux = (to.epochFlag >= 2) && (to.epochFlag <= 5);
+      to.time = from.time;
+      to.epochFlag = from.epochFlag;
+      to.numSVs = from.numSVs;
+      to.clockOffset = from.clockOffset;
+      to.obs.swap(from.obs);
+      if ((from.epochFlag >= 2) && (from.epochFlag <= 5))
+      {
+         to.auxHeader = from.auxHeader;
+      }
+      else if (hadAux)
+      {
+         to.auxHeader.clear();
+      }
+      to.xmitAnt = from.xmitAnt;
+   }
+
+}  // End of namespace gnsstk
@@ -0,0 +1,247 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/**
+ * @file Rinex3ObsChunkReader.hpp
+ * Parse RINEX 3 observation files in chunks on a thread pool.
+ */
+
+#ifndef GNSSTK_RINEX3OBSCHUNKREADER_HPP
+#define GNSSTK_RINEX3OBSCHUNKREADER_HPP
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Rinex3ObsStream.hpp"
+#include "Rinex3ObsData.hpp"
+
+namespace gnsstk
+{
+      /// @ingroup FileHandling
+      //@{
+
+      /**
+       * Read the data records of one or more RINEX observation files
+       * using a pool of threads.
+       *
+       * The header of each file is read by addFile().  The body of
+       * the file is then divided into chunks of roughly equal size,
+       * each starting at an epoch line (a line beginning with '>'),
+       * and the chunks are parsed by the threads into Rinex3ObsData
+       * records.  read() returns the records in the order they
+       * appear in the file, exactly as Rinex3ObsStream would.
+       * Chunks of all the files added are handed to the threads in
+       * order, so the next file is being parsed while the end of
+       * the previous one is being read.  Only a few chunks are
+       * parsed ahead of read(), so the memory used does not depend
+       * on the size of the files.
+       *
+       * Files that can't be divided, i.e. RINEX 2 files and files
+       * that are decompressed as they are read, are read by read()
+       * with a Rinex3ObsStream, as are all files when only one
+       * thread is used.
+       *
+       * @code
+       * Rinex3ObsChunkReader reader;
+       * size_t file = reader.addFile("site0010.24o");
+       * Rinex3ObsData rod;
+       * while (reader.read(file, rod))
+       * {
+       *    ...
+       * }
+       * @endcode
+       *
+       * @note Exceptions thrown for errors in the data records of a
+       *   file that is divided into chunks do not have correct line
+       *   or record numbers.
+       */
+   class Rinex3ObsChunkReader
+   {
+   public:
+         /// The default size of the chunks of a file, in bytes.
+      static const std::size_t defaultChunkSize;
+
+         /** Initialize the reader.  Threads are not started until a
+          * file is added that can be divided into chunks.
+          * @param[in] threads The number of threads to use for
+          *   parsing.  0 uses the number of hardware threads.
+          * @param[in] size The approximate number of bytes of the
+          *   file to be parsed by a thread at once. */
+      Rinex3ObsChunkReader(unsigned threads = 0,
+                           std::size_t size = defaultChunkSize);
+
+         /// Stop the threads and close all files.
+      ~Rinex3ObsChunkReader();
+
+         /** Open a file, read its header and queue its data records
+          * to be parsed.
+          * @param[in] fn The path of the RINEX observation file.
+          * @return The index of the file, for read() and getHeader().
+          * @throw FileMissingException if the file can't be opened.
+          * @throw FFStreamError if the header is invalid. */
+      std::size_t addFile(const std::string& fn);
+
+         /// Get the number of files added.
+      std::size_t getNumFiles() const
+      { return files.size(); }
+
+         /** Get the header of a file.
+          * @param[in] file The index of the file returned by addFile().
+          * @return The header read from the file. */
+      const Rinex3ObsHeader& getHeader(std::size_t file) const
+      { return files[file]->header; }
+
+         /** Determine if a file is being parsed by the threads.
+          * @param[in] file The index of the file returned by addFile().
+          * @return false if the file is read by read(). */
+      bool isChunked(std::size_t file) const
+      { return !files[file]->strm; }
+
+         /** Get the next data record of a file.  Files must be read
+          * in the order they were added.  Reading a file discards
+          * any records of the files before it that have not been
+          * read.
+          * @param[in] file The index of the file returned by addFile().
+          * @param[out] rod The record read.
+          * @return false at the end of the file.
+          * @throw FFStreamError or other Exception if a record
+          *   could not be parsed.  The records before it are
+          *   returned first, and there are no more records after
+          *   it. */
+      bool read(std::size_t file, Rinex3ObsData& rod);
+
+         /// Stop the threads and forget all the files added.
+      void close();
+
+         /// Get the number of threads used for parsing.
+      unsigned getThreads() const
+      { return numThreads; }
+
+   private:
+         /// A file added with addFile().
+      struct File
+      {
+            /// The path of the file.
+         std::string name;
+            /// The header read from the file.
+         Rinex3ObsHeader header;
+            /// The time system of the file's epochs.
+         TimeSystem timesystem;
+            /// The stream used by read() for files that aren't chunked.
+         std::unique_ptr<Rinex3ObsStream> strm;
+            /// The index of the file's first chunk in jobs.
+         std::size_t firstJob;
+            /// The index after the file's last chunk in jobs.
+         std::size_t endJob;
+      };
+
+         /// A chunk of a file to be parsed.
+      struct Job
+      {
+            /// The index of the file in files.
+         std::size_t file;
+            /** The offsets in the file that the chunk starts and
+             * ends at or after; the actual bounds are moved to the
+             * next epoch line. */
+         std::streamoff begin, end;
+            /// Set when the chunk is at the start of the body.
+         bool first;
+            /// Set when the chunk runs to the end of the file.
+         bool last;
+            /// Set by the thread when it is finished with the chunk.
+         bool done;
+            /// The records parsed.
+         std::deque<Rinex3ObsData> records;
+            /// The exception that stopped the parsing, if any.
+         std::exception_ptr error;
+      };
+
+         /// Body of the parsing threads.
+      void worker();
+
+         /** Parse the records of a chunk.
+          * @param[in] job The chunk to parse.
+          * @param[in,out] strm A stream open on the chunk's file. */
+      void parse(Job& job, Rinex3ObsStream& strm);
+
+         /** Find the first epoch line that begins at or after pos.
+          * @return The offset of the epoch line or the end of the
+          *   file. */
+      static std::streamoff findEpoch(Rinex3ObsStream& strm,
+                                      std::streamoff pos);
+
+         /** Move the contents of a parsed record into the caller's
+          * record without copying the observations. */
+      static void takeRecord(Rinex3ObsData& from, Rinex3ObsData& to);
+
+         /// The number of threads to use.
+      unsigned numThreads;
+         /// The size of the chunks.
+      std::size_t chunkSize;
+         /// The files added.
+      std::vector<std::unique_ptr<File> > files;
+         /// The chunks of all the files, in order.
+      std::vector<std::unique_ptr<Job> > jobs;
+         /// Protects files, jobs, nextJob, readJob and stopping.
+      std::mutex mutex;
+         /// Signalled when a thread may start another chunk.
+      std::condition_variable jobReady;
+         /// Signalled when a thread has finished a chunk.
+      std::condition_variable jobDone;
+         /// The next chunk to be started by a thread.
+      std::size_t nextJob;
+         /// The chunk whose records are being returned by read().
+      std::size_t readJob;
+         /// The next record of jobs[readJob] to return.
+      std::size_t readRecord;
+         /// Set to stop the threads.
+      bool stopping;
+         /// The parsing threads.
+      std::vector<std::thread> pool;
+   }; // End of class 'Rinex3ObsChunkReader'
+
+      //@}
+
+}  // End of namespace gnsstk
+
+#endif   // GNSSTK_RINEX3OBSCHUNKREADER_HPP
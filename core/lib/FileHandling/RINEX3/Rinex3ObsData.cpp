@@ -608,14 +608,11 @@ namespace gnsstk
          // If the header hasn't been read, read it.
       if(!strm.headerRead) strm >> strm.header;
 
-      Rinex3ObsData rod;
-
-         // clear out this ObsData
-      *this = rod;
-
          // call the version for RINEX ver 2
       if(strm.header.version < 3)
       {
+            // clear out this ObsData
+         *this = Rinex3ObsData();
          try
          {
             reallyGetRecordVer2(strm, *this);
@@ -627,7 +624,17 @@ namespace gnsstk
          return;
       }
 
-      string line;
+         // Clear out this ObsData, except that the contents of obs
+         // are kept until the satellites in this epoch are known, so
+         // that their map nodes and vectors can be reused.
+      time = CommonTime::BEGINNING_OF_TIME;
+      epochFlag = -1;
+      numSVs = -1;
+      clockOffset = 0.;
+      auxHeader.clear();
+      xmitAnt = XmitAnt::Standard;
+
+      string& line(strm.recLine);
 
          // read the first (epoch) line
       strm.formattedGetLine(line, true);
@@ -660,56 +667,87 @@ namespace gnsstk
          // Read the observations: SV ID and data ----------------------------
       if(epochFlag == 0 || epochFlag == 1 || epochFlag == 6)
       {
-         vector<RinexSatID> satIndex(numSVs);
-         map<RinexSatID, vector<RinexDatum> > tempDataMap;
-
+         vector<RinexSatID>& sats(strm.recSats);
+         sats.clear();
          for(int isv = 0; isv < numSVs; isv++)
          {
-            strm.formattedGetLine(line);
-            StringUtils::stripTrailing(line, " ");
-
-               // get the SV ID
-            try
-            {
-               satIndex[isv] = RinexSatID(line.substr(0,3));
-            }
-            catch (Exception& e)
+            const char *buf;
+            size_t len;
+            strm.formattedGetLine(buf, len);
+               // Trailing blanks are not needed, fields past the end
+               // of the line are parsed as blank.
+            while(len > 0 && buf[len-1] == ' ')
+               len--;
+
+               // get the SV ID, parsing each distinct one only once
+            unsigned long key = 0;
+            for(size_t i = 0; i < 3; i++)
+               key = (key << 8) | (unsigned char)(i < len ? buf[i] : ' ');
+            map<unsigned long, RinexSatID>::iterator sidi =
+               strm.recSatIDs.find(key);
+            if(sidi == strm.recSatIDs.end())
             {
-               FFStreamError ffse(e);
-               GNSSTK_THROW(ffse);
+               try
+               {
+                  RinexSatID sat(string(buf, std::min(len,size_t(3))));
+                  sidi = strm.recSatIDs.insert(
+                     map<unsigned long, RinexSatID>::value_type(key,sat)).first;
+               }
+               catch (Exception& e)
+               {
+                  FFStreamError ffse(e);
+                  GNSSTK_THROW(ffse);
+               }
             }
+            const RinexSatID& sat(sidi->second);
+            sats.push_back(sat);
 
                // get the # data items (# entries in ObsType map of
                // maps from header)
-            string gnss = asString(satIndex[isv].systemChar());
-            int size = strm.header.mapObsTypes[gnss].size();
+            int size = strm.header.mapObsTypes[string(1,sat.systemChar())]
+               .size();
 
                // Some receivers leave blanks for missing Obs (which
                // is OK by RINEX 3).  If the last Obs are the ones
                // missing, it won't necessarily be padded with spaces,
-               // so the parser will break.  This adds the padding to
-               // let the parser do its job and interpret spaces as
-               // zeroes.
-            size_t minSize = 3 + 16*size;
-            if(line.size() < minSize)
-               line += string(minSize-line.size(), ' ');
-
-               // get the data (# entries in ObsType map of maps from header)
-            vector<RinexDatum> data;
+               // so fromString treats the missing characters as blanks.
+            DataMap::iterator obsi = obs.lower_bound(sat);
+            if(obsi == obs.end() || obs.key_comp()(sat, obsi->first))
+            {
+               obsi = obs.insert(obsi,
+                                 DataMap::value_type(sat,
+                                                     vector<RinexDatum>()));
+            }
+            vector<RinexDatum>& data(obsi->second);
+            data.resize(size);
             for(int i = 0; i < size; i++)
             {
                size_t pos = 3 + 16*i;
-               RinexDatum tempData(line.substr(pos,16));
-               data.push_back(tempData);
+               data[i].fromString(buf + pos, pos < len ? len - pos : 0);
+            }
+         }
+
+            // Remove satellites left over from the previous epoch.
+         if(obs.size() != sats.size())
+         {
+            std::sort(sats.begin(), sats.end());
+            vector<RinexSatID>::const_iterator si = sats.begin();
+            for(DataMap::iterator obsi = obs.begin(); obsi != obs.end(); )
+            {
+               while(si != sats.end() && *si < obsi->first)
+                  si++;
+               if(si != sats.end() && !(obsi->first < *si))
+                  obsi++;
+               else
+                  obs.erase(obsi++);
             }
-            obs[satIndex[isv]] = data;
          }
       }
 
          // ... or the auxiliary header information
-      else if(numSVs > 0)
+      else
       {
-         auxHeader.clear();
+         obs.clear();
          for(int i = 0; i < numSVs; i++)
          {
             strm.formattedGetLine(line);
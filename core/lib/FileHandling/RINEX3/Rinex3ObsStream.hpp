@@ -116,8 +116,25 @@ namespace gnsstk
       static bool isRinex3ObsStream(std::istream& i);
 
    private:
+      friend class Rinex3ObsData;
+
          /// Initialize internal data structures.
       void init();
+
+         /** @name Record parsing buffers
+          * Reused by Rinex3ObsData::reallyGetRecord from one record
+          * to the next so that reading data records does not need
+          * to allocate memory once the buffers have grown to the
+          * size of the largest epoch. */
+         //@{
+         /// The epoch line currently being parsed.
+      std::string recLine;
+         /// Satellites seen in the epoch currently being parsed.
+      std::vector<RinexSatID> recSats;
+         /** Satellite IDs already parsed from this stream, keyed by
+          * the three characters of the SV field. */
+      std::map<unsigned long, RinexSatID> recSatIDs;
+         //@}
    }; // class 'Rinex3ObsStream'
 
       //@}
@@ -40,6 +40,7 @@
  * Defines class methods for a single RINEX datum.
  */
 
+#include <algorithm>
 #include "RinexDatum.hpp"
 #include "Exception.hpp"
 #include "StringUtils.hpp"
@@ -65,39 +66,44 @@ namespace gnsstk
    void RinexDatum ::
    fromString(const std::string& str)
    {
-      std::string tmpStr;
       GNSSTK_ASSERT(str.length() == 16);
-      tmpStr = str.substr(0, 14);
-      if (tmpStr.find_last_not_of(" ") == std::string::npos)
+      fromString(str.data(), str.length());
+   }
+
+
+   void RinexDatum ::
+   fromString(const char* str, std::string::size_type len)
+   {
+      std::string::size_type dataLen = std::min(len, std::string::size_type(14));
+      const char *end = str + dataLen;
+      if (std::find_if(str, end, [](char c) { return c != ' '; }) == end)
       {
          data = 0.;
          dataBlank = true;
       }
       else
       {
-         data = StringUtils::asDouble(tmpStr);
+         data = StringUtils::asDouble(str, dataLen);
          dataBlank = false;
       }
-      tmpStr = str.substr(14, 1);
-      if (tmpStr == " ")
+      if ((len < 15) || (str[14] == ' '))
       {
          lli = 0.;
          lliBlank = true;
       }
       else
       {
-         lli = StringUtils::asInt(tmpStr);
+         lli = StringUtils::asInt(str+14, 1);
          lliBlank = false;
       }
-      tmpStr = str.substr(15, 1);
-      if (tmpStr == " ")
+      if ((len < 16) || (str[15] == ' '))
       {
          ssi = 0.;
          ssiBlank = true;
       }
       else
       {
-         ssi = StringUtils::asInt(tmpStr);
+         ssi = StringUtils::asInt(str+15, 1);
          ssiBlank = false;
       }
    }
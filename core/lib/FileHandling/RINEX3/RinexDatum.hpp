@@ -70,6 +70,14 @@ namespace gnsstk
           * @throw AssertionFailure if str.length() != 16 */
       void fromString(const std::string& str);
 
+         /** Parse a RINEX OBS datum directly from a record buffer.
+          * @param[in] str the first character of the datum.
+          * @param[in] len the number of characters available at \a
+          *   str.  Only the first 16 are used, and if len is less
+          *   than 16, the missing characters are treated as blanks
+          *   (as is the case for trailing blank fields in RINEX 3). */
+      void fromString(const char* str, std::string::size_type len);
+
          /// Turn this datum into a RINEX OBS formatted string
       std::string asString() const;
 
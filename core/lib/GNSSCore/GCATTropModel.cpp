@@ -41,6 +41,16 @@
 
 namespace gnsstk
 {
+      // mapping function at elevation (degrees), 5 degrees or more
+   static inline double GCATMap(double elevation)
+   {
+      double d = std::sin(elevation*DEG_TO_RAD);
+      d = SQRT(0.002001+(d*d));
+
+      return (1.001/d);
+   }
+
+
    GCATTropModel::GCATTropModel(const double& ht)
    {
       setReceiverHeight(ht);
@@ -59,20 +69,28 @@ namespace gnsstk
    }
 
 
-   double GCATTropModel::correction( const Position& RX,
-                                     const Position& SV )
+   void GCATTropModel::corrections(const std::vector<double>& elevations,
+                                   std::vector<double>& delays) const
    {
+      THROW_IF_INVALID();
 
-      try
-      {
-         setReceiverHeight( RX.getAltitude() );
-      }
-      catch(GeometryException& e)
+      double zenith = dry_zenith_delay() + wet_zenith_delay();
+
+      delays.resize(elevations.size());
+      for(size_t i=0; i<elevations.size(); i++)
       {
-         valid = false;
+         if(elevations[i] < 5.0)
+            delays[i] = 0.0;
+         else
+            delays[i] = zenith * GCATMap(elevations[i]);
       }
+   }
 
-      if(!valid) throw InvalidTropModel("Invalid model");
+
+   double GCATTropModel::correction( const Position& RX,
+                                     const Position& SV )
+   {
+      setReceiver(RX);
 
       double c;
       try
@@ -89,6 +107,37 @@ namespace gnsstk
    }
 
 
+   void GCATTropModel::corrections( const Position& RX,
+                                    const std::vector<Position>& SV,
+                                    const CommonTime& tt,
+                                    std::vector<double>& delays )
+   {
+      setReceiver(RX);
+
+      std::vector<double> elevations(SV.size());
+      for (size_t i = 0; i < SV.size(); i++)
+      {
+         elevations[i] = RX.elevationGeodetic(SV[i]);
+      }
+      corrections(elevations, delays);
+   }
+
+
+   void GCATTropModel::setReceiver( const Position& RX )
+   {
+      try
+      {
+         setReceiverHeight( RX.getAltitude() );
+      }
+      catch(GeometryException& e)
+      {
+         valid = false;
+      }
+
+      if(!valid) throw InvalidTropModel("Invalid model");
+   }
+
+
    double GCATTropModel::correction( const Xvt& RX,
                                      const Xvt& SV,
                                      const CommonTime& tt )
@@ -116,10 +165,7 @@ namespace gnsstk
 
       if(elevation < 5.0) return 0.0;
 
-      double d = std::sin(elevation*DEG_TO_RAD);
-      d = SQRT(0.002001+(d*d));
-
-      return (1.001/d);
+      return GCATMap(elevation);
    }
 
 
@@ -113,6 +113,16 @@ namespace gnsstk
       virtual double correction(double elevation) const;
 
 
+         /** @copydoc TropModel::corrections(const std::vector<double>&,std::vector<double>&) const
+          *
+          * @note The receiver height must have been provided before, whether
+          *   using the appropriate constructor or with the setReceiverHeight()
+          *   method.
+          */
+      virtual void corrections(const std::vector<double>& elevations,
+                               std::vector<double>& delays) const;
+
+
          /** Compute and return the full tropospheric delay, given the
           * positions of receiver and satellite. This version is most useful
           * within positioning algorithms, where the receiver position may
@@ -140,6 +150,17 @@ namespace gnsstk
       { return correction(RX, SV); };
 
 
+         /** @copydoc TropModel::corrections(const Position&,const std::vector<Position>&,const CommonTime&,std::vector<double>&)
+          *
+          * @note This model does not use time. The \a tt parameter is a
+          *   dummy parameter kept just for consistency
+          */
+      virtual void corrections( const Position& RX,
+                                const std::vector<Position>& SV,
+                                const CommonTime& tt,
+                                std::vector<double>& delays );
+
+
           /** @copydoc TropModel::correction(const Xvt& RX,const Xvt&,const CommonTime&)
           *
           * @note This model does not use time. The \a tt parameter is a
@@ -203,6 +224,11 @@ namespace gnsstk
 
    private:
 
+         /** Set the receiver height from RX, then check the model is
+          * valid.
+          * @throw InvalidTropModel */
+      void setReceiver( const Position& RX );
+
          /// Receiver height
       double gcatHeight;
    };
@@ -277,22 +277,57 @@ namespace gnsstk
       +0.0000e+00,+3.1404e-02,+1.5580e-02,-1.1428e-03,+3.3529e-05,
       +1.0387e-05,-1.9378e-06,-2.7327e-07,+7.5833e-09,-9.2323e-09 };
 
-   const double GlobalTropModel::Factorial[19] = {
-      1, 1, 2, 6, 24, 120, 720, 5040, 40320, 362880, 3628800, 39916800,
-      479001600, 6227020800, 87178291200, 1307674368000, 20922789888000,
-      355687428096000, 6402373705728000 };
-
    const double GlobalTropModel::HEIGHT_LIMIT = 44243.;
+   const unsigned GlobalTropModel::MAX_CACHED_SITES;
+
+   namespace
+   {
+      // the continued fraction of the mapping functions
+      inline double gmfFraction(double x, double a, double b, double c)
+      {
+         return x + a/(x + b/(x + c));
+      }
+
+      // GMF hydrostatic mapping function at sin(elevation) sine
+      double gmfDry(double ah, double ch, double ht, double sine)
+      {
+         static const double bh = 0.0029;
+         double map = gmfFraction(1.0, ah, bh, ch) / gmfFraction(sine, ah, bh, ch);
+
+         // height correction
+         static const double a_ht = 2.53e-5;
+         static const double b_ht = 5.49e-3;
+         static const double c_ht = 1.14e-3;
+
+         map += ( (1.0/sine) - gmfFraction(1.0, a_ht, b_ht, c_ht)
+                             / gmfFraction(sine, a_ht, b_ht, c_ht)
+                ) * (ht/1000.0);
+
+         return map;
+      }
+
+      // GMF wet mapping function at sin(elevation) sine
+      double gmfWet(double aw, double sine)
+      {
+         static const double bw = 0.00146;
+         static const double cw = 0.04391;
+         return gmfFraction(1.0, aw, bw, cw) / gmfFraction(sine, aw, bw, cw);
+      }
+
+      // wet zenith delay for temperature T (deg C), humidity rh (percent)
+      double gptWetDelay(double T, double rh)
+      {
+         T += TropModel::CELSIUS_TO_KELVIN;
+         double pwv = 0.01 * rh * ::exp(-37.2465 + (0.213166-0.000256908*T)*T);
+         return (0.0122 + 0.00943 * pwv);
+      }
+   }
 
    GlobalTropModel :: GlobalTropModel()
          : validCoeff(false), validHeight(false), validLat(false),
            validLon(false), validDay(false), height(0.0), latitude(0.0),
-           longitude(0.0), dayfactor(0.0), undul(0.0)
+           longitude(0.0), dayfactor(0.0), undul(0.0), validSite(false)
    {
-         // yes setting everything to 0 is the same as IEEE 0.0
-      memset(P, 0, sizeof(P));
-      memset(aP, 0, sizeof(aP));
-      memset(bP, 0, sizeof(bP));
       TropModel::humid = 50.0;
       valid = false;
    }
@@ -318,7 +353,64 @@ namespace gnsstk
    }  // end GlobalTropModel::correction(elevation)
 
 
+   void GlobalTropModel::corrections(const std::vector<double>& elevations,
+                                     std::vector<double>& delays) const
+   {
+      try { testValidity(); }
+      catch(InvalidTropModel& e) { GNSSTK_RETHROW(e); }
+
+      double dryZen(GlobalTropModel::dry_zenith_delay());
+      double wetZen(GlobalTropModel::wet_zenith_delay());
+
+      delays.resize(elevations.size());
+      for(size_t i=0; i<elevations.size(); i++) {
+         // Global mapping functions good down to 3 degrees of elevation
+         if(elevations[i] < 3.0) {
+            delays[i] = 0.0;
+            continue;
+         }
+         double sine = ::sin(elevations[i]*DEG_TO_RAD);
+         delays[i] = (dryZen * gmfDry(ah, ch, height, sine)) +
+                     (wetZen * gmfWet(aw, sine));
+      }
+   }
+
+
    double GlobalTropModel::correction(const Position& RX, const Position& SV)
+   {
+      setReceiver(RX);
+
+      double c;
+      try {
+         c = GlobalTropModel::correction(RX.elevationGeodetic(SV));
+      }
+      catch(InvalidTropModel& e) { GNSSTK_RETHROW(e); }
+
+      return c;
+
+   }  // end GlobalTropModel::correction(RX,SV)
+
+
+   void GlobalTropModel::corrections(const Position& RX,
+                                     const std::vector<Position>& SV,
+                                     const CommonTime& tt,
+                                     std::vector<double>& delays)
+   {
+      setTime(tt);
+      setReceiver(RX);
+
+      std::vector<double> elevations(SV.size());
+      for(size_t i=0; i<SV.size(); i++)
+         elevations[i] = RX.elevationGeodetic(SV[i]);
+      try {
+         GlobalTropModel::corrections(elevations, delays);
+      }
+      catch(InvalidTropModel& e) { GNSSTK_RETHROW(e); }
+
+   }  // end GlobalTropModel::corrections(RX,SV,TT)
+
+
+   void GlobalTropModel::setReceiver(const Position& RX)
    {
       try {
          double p;
@@ -334,15 +426,7 @@ namespace gnsstk
       try { testValidity(); }
       catch(InvalidTropModel& e) { GNSSTK_RETHROW(e); }
 
-      double c;
-      try {
-         c = GlobalTropModel::correction(RX.elevationGeodetic(SV));
-      }
-      catch(InvalidTropModel& e) { GNSSTK_RETHROW(e); }
-
-      return c;
-
-   }  // end GlobalTropModel::correction(RX,SV)
+   }  // end GlobalTropModel::setReceiver(RX)
 
 
    double GlobalTropModel::dry_zenith_delay() const
@@ -355,9 +439,7 @@ namespace gnsstk
 
    double GlobalTropModel::wet_zenith_delay() const
    {
-      double T = temp + CELSIUS_TO_KELVIN;
-      double pwv = 0.01 * humid * ::exp(-37.2465 + (0.213166-0.000256908*T)*T);
-      return (0.0122 + 0.00943 * pwv);
+      return gptWetDelay(temp, humid);
    }
 
 
@@ -366,50 +448,7 @@ namespace gnsstk
       try { testValidity(); } catch(InvalidTropModel& e) { GNSSTK_RETHROW(e); }
       if(elevation < 3.0) { return 0.0; }
 
-      double clat = ::cos(latitude*DEG_TO_RAD);
-      double phh, c11h, c10h;
-
-      static const double bh = 0.0029;
-      static const double c0h = 0.062;
-      if(latitude < 0) {
-         phh = PI;
-         c11h = 0.007;
-         c10h = 0.002;
-      }
-      else {
-         phh = 0.0;
-         c11h = 0.005;
-         c10h = 0.001;
-      }
-      double ch = c0h + ((::cos(dayfactor + phh)+1.0)*c11h/2.0 + c10h)*(1.0-clat);
-
-      double am(0.0), aa(0.0);
-      for(int i=0; i<55; i++) {
-         am += (ADryMean[i]*aP[i] + BDryMean[i]*bP[i]) * 1.0e-5;
-         aa += (ADryAmp[i]*aP[i] + BDryAmp[i]*bP[i]) * 1.0e-5;
-      }
-      double ah = am + aa*::cos(dayfactor);
-
-      double sine = ::sin(elevation*DEG_TO_RAD);
-      //std::cout << "sine " << std::fixed << std::setprecision(16) << sine
-      // << std::endl;
-      //std::cout << "ah bh ch " << std::fixed << std::setprecision(16)
-      // << ah << " " << bh << " " << ch << std::endl;
-      double map = (1.0 + ah/(1.0 + bh/(1.0 + ch)))
-                 / (sine + ah/(sine + bh/(sine + ch)));
-      //std::cout << "map0 " << std::fixed << std::setprecision(16) << map
-      // << std::endl;
-
-      // height correction
-      static const double a_ht = 2.53e-5;
-      static const double b_ht = 5.49e-3;
-      static const double c_ht = 1.14e-3;
-
-      map += ( (1.0/sine) - (1.0  + a_ht/(1.0  + b_ht/(1.0  + c_ht)))
-                          / (sine + a_ht/(sine + b_ht/(sine + c_ht)))
-             ) * (height/1000.0);
-
-      return map;
+      return gmfDry(ah, ch, height, ::sin(elevation*DEG_TO_RAD));
 
    }  // end GlobalTropModel::dry_mapping_function()
 
@@ -454,25 +493,6 @@ namespace gnsstk
 
       if(elevation < 3.0) { return 0.0; }
 
-      static const double bw = 0.00146;
-      static const double cw = 0.04391;
-
-      double am(0.0), aa(0.0);
-      for(int i=0; i<55; i++) {
-         am += (AWetMean[i]*aP[i] + BWetMean[i]*bP[i]) * 1.0e-5;
-         aa += (AWetAmp[i]*aP[i] + BWetAmp[i]*bP[i]) * 1.0e-5;
-      }
-      double aw = am + aa*::cos(dayfactor);
-
-      double sine = ::sin(elevation*DEG_TO_RAD);
-      //std::cout << "sine " << std::fixed << std::setprecision(16) << sine
-      // << std::endl;
-      //std::cout << "aw bw cw " << std::fixed << std::setprecision(16)
-      // << aw << " " << bw << " " << cw << std::endl;
-      double f1(1.0 + aw/(1.0 + bw/(1.0 + cw)));
-      double f(sine + aw/(sine + bw/(sine + cw)));
-      double map = f1/f;
-
       /** @note might be easier numerically... map' = map(elev+eps)-map(elev-eps)/2eps
        *if(doDeriv) {
        *   double apb(aw+bw);
@@ -485,7 +505,7 @@ namespace gnsstk
        *}
       */
 
-      return map;
+      return gmfWet(aw, ::sin(elevation*DEG_TO_RAD));
 
    }  // end GlobalTropModel::wet_mapping_function()
 
@@ -495,12 +515,18 @@ namespace gnsstk
       try { testValidity(); }
       catch(InvalidTropModel& e) { GNSSTK_RETHROW(e); }
 
-      int i;
+      try { computeGPT(site, height, ::cos(dayfactor), P, T, U); }
+      catch(InvalidTropModel& e) { GNSSTK_RETHROW(e); }
+   }
+
 
+   void GlobalTropModel::computeGPT(const SiteCoeff& sc, double ht,
+                                    double cosday, double& P, double& T,
+                                    double& U)
+   {
       // undulation and orthometric height
-      U = 0.0;
-      for(i=0; i<55; i++) U += (Ageoid[i]*aP[i] + Bgeoid[i]*bP[i]);
-      double orthoht(height - U);
+      U = sc.undul;
+      double orthoht(ht - U);
       if(orthoht > HEIGHT_LIMIT)
       {
          InvalidTropModel exc("Invalid Global trop model: Rx Height exceeds limit");
@@ -508,33 +534,47 @@ namespace gnsstk
       }
 
       // press at geoid
-      double am(0.0),aa(0.0),v0;
-      for(i=0; i<55; i++) {
-         am += (APressMean[i]*aP[i] + BPressMean[i]*bP[i]);
-         aa += (APressAmp[i]*aP[i] + BPressAmp[i]*bP[i]);
-      }
-      v0 = am + aa * ::cos(dayfactor);
+      double v0 = sc.pressMean + sc.pressAmp * cosday;
 
       // pressure at height
       // @note this implies any orthoht > 1/2.26e-5 == 44247.78m is invalid!
       P = v0 * ::pow(1.0-2.26e-5*orthoht,5.225);
 
       // temper on geoid
-      am = aa = 0.0;
-      for(i=0; i<55; i++) {
-         am += (ATempMean[i]*aP[i] + BTempMean[i]*bP[i]);
-         aa += (ATempAmp[i]*aP[i] + BTempAmp[i]*bP[i]);
-      }
-      v0 = am + aa * ::cos(dayfactor);
+      v0 = sc.tempMean + sc.tempAmp * cosday;
 
       // temp at height
       T = v0 - 6.5e-3 * orthoht;
    }
 
 
+   void GlobalTropModel::computeGMF(const SiteCoeff& sc, double lat,
+                                    double df, double cosday, double& ah,
+                                    double& ch, double& aw)
+   {
+      double clat = ::cos(lat*DEG_TO_RAD);
+      double phh, c11h, c10h;
+
+      static const double c0h = 0.062;
+      if(lat < 0) {
+         phh = PI;
+         c11h = 0.007;
+         c10h = 0.002;
+      }
+      else {
+         phh = 0.0;
+         c11h = 0.005;
+         c10h = 0.001;
+      }
+      ch = c0h + ((::cos(df + phh)+1.0)*c11h/2.0 + c10h)*(1.0-clat);
+      ah = sc.dryMean + sc.dryAmp*cosday;
+      aw = sc.wetMean + sc.wetAmp*cosday;
+   }
+
+
    void GlobalTropModel::setReceiverHeight(const double& ht)
    {
-      if(height != ht) {
+      if(!validHeight || height != ht) {
          height = ht;
          validHeight = true;
          validCoeff = false;
@@ -545,7 +585,7 @@ namespace gnsstk
 
    void GlobalTropModel::setReceiverLatitude(const double& lat)
    {
-      if(latitude != lat) {
+      if(!validLat || latitude != lat) {
          latitude = lat;
          validLat = true;
          validCoeff = false;
@@ -556,7 +596,7 @@ namespace gnsstk
 
    void GlobalTropModel::setReceiverLongitude(const double& lon)
    {
-      if(longitude != lon) {
+      if(!validLon || longitude != lon) {
          longitude = lon;
          validLon = true;
          validCoeff = false;
@@ -568,7 +608,7 @@ namespace gnsstk
    void GlobalTropModel::setTime(const double& mjd)
    {
       double df(TWO_PI*(mjd - 44266.0)/365.25);       // -44239 + 1 - 28
-      if(df != dayfactor) {
+      if(!validDay || df != dayfactor) {
          dayfactor = df;
          validDay = true;
          validCoeff = false;
@@ -607,35 +647,126 @@ namespace gnsstk
    {
       if(!validLon || !validLat) return;
 
-      // compute Legendre functions and spherical harmonics
-      int i,j,k;
-      double sinlat(::sin(latitude*DEG_TO_RAD));
-      for(i=0; i<=9; i++) {
-         for(j=0; j<=i; j++) {
-            int ir((i-j)/2);
-            double sum(0.0),term;
-            int sign(1);
-            for(k=0; k<=ir; k++) {
-               term = sign*(((Factorial[2*i-2*k] / Factorial[k]) / Factorial[i-k])
-                        / Factorial[i-j-2*k]) * ::pow(sinlat,i-j-2*k);
-               sum += term;
-               sign = -sign;
-            }
-            P[i][j] = (1.0/(::pow(2.0,i)) * ::sqrt(::pow(1.0-sinlat*sinlat,j)) * sum);
-         }
+      // spherical harmonic sums, unless the site is unchanged
+      if(!validSite || siteLat != latitude || siteLon != longitude)
+      {
+         site = siteCoefficients(latitude, longitude);
+         siteLat = latitude;
+         siteLon = longitude;
+         validSite = true;
+      }
+
+      computeGMF(site, latitude, dayfactor, ::cos(dayfactor), ah, ch, aw);
+   }
+
+
+   const GlobalTropModel::SiteCoeff&
+   GlobalTropModel::siteCoefficients(double lat, double lon)
+   {
+      std::pair<double,double> key(lat, lon);
+      auto it = siteCache.find(key);
+      if(it == siteCache.end()) {
+         if(siteCache.size() >= MAX_CACHED_SITES)
+            siteCache.clear();
+         it = siteCache.insert(std::make_pair(key, computeSiteCoeff(lat, lon)))
+            .first;
+      }
+      return it->second;
+   }
+
+
+   GlobalTropModel::SiteCoeff
+   GlobalTropModel::computeSiteCoeff(double lat, double lon)
+   {
+      // compute Legendre functions P[n][m] of sin(lat), unnormalized and
+      // without the Condon-Shortley phase, by the standard recurrences
+      int n,m,i;
+      double P[10][10];
+      double t(::sin(lat*DEG_TO_RAD)), u(::sqrt(1.0-t*t));
+      P[0][0] = 1.0;
+      for(m=1; m<=9; m++)
+         P[m][m] = (2*m-1) * u * P[m-1][m-1];
+      for(m=0; m<9; m++) {
+         P[m+1][m] = (2*m+1) * t * P[m][m];
+         for(n=m+2; n<=9; n++)
+            P[n][m] = ((2*n-1) * t * P[n-1][m] - (n+m-1) * P[n-2][m]) / (n-m);
       }
 
-      // spherical harmonics
-      double rlon(longitude*DEG_TO_RAD);
+      // spherical harmonics, with cos(m*rlon) and sin(m*rlon) by recurrence
+      double rlon(lon*DEG_TO_RAD), cosm[10], sinm[10];
+      cosm[0] = 1.0;
+      sinm[0] = 0.0;
+      cosm[1] = ::cos(rlon);
+      sinm[1] = ::sin(rlon);
+      for(m=2; m<=9; m++) {
+         cosm[m] = cosm[m-1]*cosm[1] - sinm[m-1]*sinm[1];
+         sinm[m] = sinm[m-1]*cosm[1] + cosm[m-1]*sinm[1];
+      }
+      double aP[55], bP[55];
       i = 0;
-      for(j=0; j<=9; j++) {
-         for(k=0; k<=j; k++) {
-            aP[i] = P[j][k] * ::cos(k*rlon);
-            bP[i] = P[j][k] * ::sin(k*rlon);
+      for(n=0; n<=9; n++) {
+         for(m=0; m<=n; m++) {
+            aP[i] = P[n][m] * cosm[m];
+            bP[i] = P[n][m] * sinm[m];
             i++;
          }
       }
 
+      // the sums of the GPT and GMF coefficients
+      SiteCoeff sc = { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 };
+      for(i=0; i<55; i++) {
+         sc.undul += (Ageoid[i]*aP[i] + Bgeoid[i]*bP[i]);
+         sc.pressMean += (APressMean[i]*aP[i] + BPressMean[i]*bP[i]);
+         sc.pressAmp += (APressAmp[i]*aP[i] + BPressAmp[i]*bP[i]);
+         sc.tempMean += (ATempMean[i]*aP[i] + BTempMean[i]*bP[i]);
+         sc.tempAmp += (ATempAmp[i]*aP[i] + BTempAmp[i]*bP[i]);
+         sc.dryMean += (ADryMean[i]*aP[i] + BDryMean[i]*bP[i]) * 1.0e-5;
+         sc.dryAmp += (ADryAmp[i]*aP[i] + BDryAmp[i]*bP[i]) * 1.0e-5;
+         sc.wetMean += (AWetMean[i]*aP[i] + BWetMean[i]*bP[i]) * 1.0e-5;
+         sc.wetAmp += (AWetAmp[i]*aP[i] + BWetAmp[i]*bP[i]) * 1.0e-5;
+      }
+      return sc;
+   }
+
+
+   void GlobalTropModel::corrections(const std::vector<Query>& queries,
+                                     std::vector<double>& delays)
+   {
+      delays.resize(queries.size());
+      const Query *last(nullptr);
+      const SiteCoeff *sc(nullptr);
+      double df(0.0), cosday(0.0), ahq(0.0), chq(0.0), awq(0.0);
+      double dryZen(0.0), wetZen(0.0);
+      for(size_t i=0; i<queries.size(); i++) {
+         const Query& q(queries[i]);
+         bool newSite = (last == nullptr || q.latitude != last->latitude ||
+                         q.longitude != last->longitude);
+         bool newTime = (last == nullptr || q.mjd != last->mjd);
+         if(newSite)
+            sc = &siteCoefficients(q.latitude, q.longitude);
+         if(newTime) {
+            df = TWO_PI*(q.mjd - 44266.0)/365.25;
+            cosday = ::cos(df);
+         }
+         if(newSite || newTime || q.height != last->height) {
+            double P, T, U;
+            try { computeGPT(*sc, q.height, cosday, P, T, U); }
+            catch(InvalidTropModel& e) { GNSSTK_RETHROW(e); }
+            computeGMF(*sc, q.latitude, df, cosday, ahq, chq, awq);
+            dryZen = SaasDryDelay(P, q.latitude, q.height);
+            wetZen = gptWetDelay(T, humid);
+         }
+         last = &q;
+
+         // Global mapping functions good down to 3 degrees of elevation
+         if(q.elevation < 3.0) {
+            delays[i] = 0.0;
+            continue;
+         }
+         double sine = ::sin(q.elevation*DEG_TO_RAD);
+         delays[i] = dryZen * gmfDry(ahq, chq, q.height, sine) +
+                     wetZen * gmfWet(awq, sine);
+      }
    }
 
 
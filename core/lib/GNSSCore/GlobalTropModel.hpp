@@ -45,6 +45,9 @@
 #ifndef GLOBAL_TROP_MODEL_HPP
 #define GLOBAL_TROP_MODEL_HPP
 
+#include <map>
+#include <utility>
+#include <vector>
 #include "CommonTime.hpp"
 #include "TropModel.hpp"
 
@@ -73,6 +76,7 @@ namespace gnsstk
        * <pre>
        *  depedency cheat sheet:
        *   User provides:    Model computes/stores:           Output of model:
+       *     lat,lon    ---> site sums [siteCoefficients(), cached]
        *     lat,lon,ht ---> coeffs  [in updateGTMCoeff()]
        *     time (doy) ---> dayfactor [ setTime(mjd) ]
        *     humidity%  ---> humid
@@ -112,12 +116,46 @@ namespace gnsstk
        *   trop = globalTM.correction(elevation);
        * @endcode
        *
+       * The spherical harmonic sums of the model depend only on the
+       * latitude and longitude, so they are computed once for each site and
+       * kept in a cache; changing the time, the height or the humidity, or
+       * returning to a site seen before, does not recompute them. To compute
+       * the delays of many (site, time, elevation) tuples, as in a network
+       * solution, use corrections(const std::vector<Query>&,
+       * std::vector<double>&), which does not change the receiver and time
+       * set in the model.
+       *
        * @warning The Global mapping functions are defined for elevation
        *   angles down to 3 degrees, below that the correction is set to zero.
        */
    class GlobalTropModel : public TropModel
    {
    public:
+         /** The parts of the GPT and GMF models that depend only on the
+          * latitude and longitude of the receiver: the spherical harmonic
+          * sums of the model coefficients. */
+      struct SiteCoeff
+      {
+         double undul;                 ///< geoid undulation, m
+         double pressMean, pressAmp;   ///< pressure at the geoid, hPa
+         double tempMean, tempAmp;     ///< temperature at the geoid, deg C
+         double dryMean, dryAmp;       ///< GMF hydrostatic coefficient a
+         double wetMean, wetAmp;       ///< GMF wet coefficient a
+      };
+
+         /// One (site, time, elevation) tuple for corrections().
+      struct Query
+      {
+         double latitude;     ///< geodetic latitude of receiver, degrees
+         double longitude;    ///< longitude of receiver, degrees
+         double height;       ///< height of receiver, meters
+         double mjd;          ///< time of interest, MJD
+         double elevation;    ///< elevation of satellite, degrees
+      };
+
+         /// The largest number of sites kept by siteCoefficients()
+      static const unsigned MAX_CACHED_SITES = 10000;
+
          /// Default constructor
       GlobalTropModel();
 
@@ -131,9 +169,12 @@ namespace gnsstk
           */
       GlobalTropModel(const double& ht, const double& lat, const double& lon,
                       const double& mjd)
+            : height(0.0), latitude(0.0), longitude(0.0), dayfactor(0.0),
+              undul(0.0)
       {
+         TropModel::humid = 50.0;
          validCoeff = validHeight = validLat = validLon = validDay = valid =
-            false;
+            validSite = false;
          setReceiverHeight(ht);
          setReceiverLatitude(lat);
          setReceiverLongitude(lon);
@@ -146,8 +187,12 @@ namespace gnsstk
           * @param time Time.
           */
       GlobalTropModel(const Position& RX, const CommonTime& time)
+            : height(0.0), latitude(0.0), longitude(0.0), dayfactor(0.0),
+              undul(0.0)
       {
-         validCoeff = validHeight = validLat = validLon = validDay = valid = false;
+         TropModel::humid = 50.0;
+         validCoeff = validHeight = validLat = validLon = validDay = valid =
+            validSite = false;
          setReceiverHeight(RX.getAltitude());
          setReceiverLatitude(RX.getGeodeticLatitude());
          setReceiverLongitude(RX.getLongitude());
@@ -188,6 +233,48 @@ namespace gnsstk
          return correction(RX,SV);
       }
 
+         /// @copydoc TropModel::corrections(const std::vector<double>&,std::vector<double>&) const
+      virtual void corrections(const std::vector<double>& elevations,
+                               std::vector<double>& delays) const;
+
+         /// @copydoc TropModel::corrections(const Position&,const std::vector<Position>&,const CommonTime&,std::vector<double>&)
+      virtual void corrections(const Position& RX,
+                               const std::vector<Position>& SV,
+                               const CommonTime& tt,
+                               std::vector<double>& delays);
+
+         /** Compute the total tropospheric delay, in meters, for each of
+          * many (site, time, elevation) tuples. Each delay is the one
+          * correction(elevation) returns after setting the latitude,
+          * longitude, height and time of the tuple, but the receiver and
+          * time set in this model are not changed, and quantities that do
+          * not depend on the elevation are computed once for each run of
+          * tuples with the same site and time. The humidity of the model
+          * is used for all tuples.
+          * @param[in] queries the (site, time, elevation) tuples
+          * @param[out] delays the delay of each tuple, in meters
+          * @throw InvalidTropModel if a height exceeds the model limit
+          */
+      void corrections(const std::vector<Query>& queries,
+                       std::vector<double>& delays);
+
+         /** Return the spherical harmonic sums of the model for a site,
+          * from the cache of this model or, for a new site, computed and
+          * added to the cache. The cache is emptied when it holds
+          * MAX_CACHED_SITES sites.
+          * @param lat Latitude of receiver, in degrees.
+          * @param lon Longitude of receiver, in degrees.
+          */
+      const SiteCoeff& siteCoefficients(double lat, double lon);
+
+         /// Forget the sites kept by siteCoefficients().
+      void clearSiteCache()
+      { siteCache.clear(); }
+
+         /// Return the number of sites kept by siteCoefficients().
+      size_t siteCacheSize() const
+      { return siteCache.size(); }
+
          /** Compute and return the zenith delay for hydrostatic (dry)
           * component of the troposphere. Use the Saastamoinen value.
           * Ref. Davis etal 1985 and Leick, 3rd ed, pg 197.
@@ -269,6 +356,12 @@ namespace gnsstk
       { return HEIGHT_LIMIT; }
 
    private:
+      /** Set the receiver height, latitude and longitude from RX,
+       * then check the model is valid.
+       * @throw InvalidTropModel
+       */
+      void setReceiver(const Position& RX);
+
       /** Define the time of interest; this is required before calling
        * correction() or any of the zenith_delay routines.
        * @param mjd  MJD (double)
@@ -302,19 +395,50 @@ namespace gnsstk
       static const double ATempAmp[55];
       static const double BTempAmp[55];
 
-      static const double Factorial[19];
-
       /// Model is limited in height, at this value, in m
       GNSSTK_EXPORT
       static const double HEIGHT_LIMIT;
 
       double height, latitude, longitude, dayfactor, undul;
-      double P[10][10], aP[55], bP[55];
       bool validHeight, validLat, validLon, validDay, validCoeff;
 
-      /// Update coefficients when latitude and/or longitude changes
+      /// Sums for the site siteLat, siteLon, if validSite
+      SiteCoeff site;
+      double siteLat, siteLon;
+      bool validSite;
+
+      /// GMF coefficients a (hydrostatic ah, wet aw) and c (ch) at the
+      /// site and time
+      double ah, ch, aw;
+
+      /// Sums kept by siteCoefficients(), by latitude and longitude
+      std::map<std::pair<double,double>, SiteCoeff> siteCache;
+
+      /** Update coefficients when latitude, longitude and/or time changes
+       * @note uses the cached sums when the site is unchanged or was
+       *   seen before */
       void updateGTMCoeff();
 
+      /** Compute the spherical harmonic sums for a site, using recurrences
+       * for the associated Legendre functions of sin(latitude) and for the
+       * multiples of the longitude. The results agree with those of the
+       * explicit formulas to 1e-12 hPa in pressure, 1e-13 deg C and m in
+       * temperature and undulation, and 1e-14 m in the delays.
+       * @param lat Latitude of receiver, in degrees.
+       * @param lon Longitude of receiver, in degrees.
+       */
+      static SiteCoeff computeSiteCoeff(double lat, double lon);
+
+      /** Compute the pressure and temperature at height, and the
+       * undulation, from the sums for the site.
+       * @throw InvalidTropModel if the height is beyond the model. */
+      static void computeGPT(const SiteCoeff& sc, double ht, double cosday,
+                             double& P, double& T, double& U);
+
+      /// Compute the GMF coefficients ah, ch and aw from the sums for the site
+      static void computeGMF(const SiteCoeff& sc, double lat, double df,
+                             double cosday, double& ah, double& ch, double& aw);
+
          /** Utility to test valid flags
           * @throw InvalidTropModel
           */
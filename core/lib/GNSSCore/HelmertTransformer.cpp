@@ -86,7 +86,7 @@ namespace gnsstk
          /** @note small angle approximation is used. */
          /** @note by construction, transpose(rotation) == inverse(rotation)
           * (given small angle approximation). */
-      rotation = Matrix<double>(3,3,0.0);
+      rotation = SMatrix<double,3,3>();
       rotation(0,0) = 1.0;
       rotation(0,1) = -rz;
       rotation(0,2) = ry;
@@ -100,10 +100,7 @@ namespace gnsstk
       rotation(2,2) = 1.0;
 
          // translation vector
-      translation = Vector<double>(3);
-      translation(0) = itx;
-      translation(1) = ity;
-      translation(2) = itz;
+      translation = SVector<double,3>(itx, ity, itz);
    }
 
 
@@ -117,11 +114,8 @@ namespace gnsstk
             // transform
          toPos = fromPos;
          toPos.transformTo(Position::Cartesian);
-         Vector<double> vec(3),res(3);
-         vec(0) = toPos[0];
-         vec(1) = toPos[1];
-         vec(2) = toPos[2];
-         res = rotation*vec + scale*vec + translation;
+         SVector<double,3> vec(toPos[0], toPos[1], toPos[2]);
+         SVector<double,3> res(rotation*vec + scale*vec + translation);
          toPos[0] = res(0);
          toPos[1] = res(1);
          toPos[2] = res(2);
@@ -134,11 +128,9 @@ namespace gnsstk
             // inverse transform
          toPos = fromPos;
          toPos.transformTo(Position::Cartesian);
-         Vector<double> vec(3),res(3);
-         vec(0) = toPos[0];
-         vec(1) = toPos[1];
-         vec(2) = toPos[2];
-         res = transpose(rotation) * (vec - scale*vec - translation);
+         SVector<double,3> vec(toPos[0], toPos[1], toPos[2]);
+         SVector<double,3> res(transposeTimes(rotation,
+                                              vec - scale*vec - translation));
          toPos[0] = res(0);
          toPos[1] = res(1);
          toPos[2] = res(2);
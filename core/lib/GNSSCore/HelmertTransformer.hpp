@@ -40,7 +40,7 @@
 #define GNSSTK_HELMERTTRANSFORMER_HPP
 
 #include "Transformer.hpp"
-#include "Matrix.hpp"
+#include "SMatrix.hpp"
 
 namespace gnsstk
 {
@@ -161,10 +161,10 @@ namespace gnsstk
    protected:
          /** The matrix that applies a rotation to move from fromFrame
           * to toFrame. */
-      Matrix<double> rotation;
+      SMatrix<double,3,3> rotation;
          /** The matrix that applies a translation to move from
           * fromFrame to toFrame. */
-      Vector<double> translation;
+      SVector<double,3> translation;
          /// Scale factor. Dimensionless.  0 = no scale.
       double scale;
    }; // class HelmertTransformer
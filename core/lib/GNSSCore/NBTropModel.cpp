@@ -145,6 +145,26 @@ namespace gnsstk
    }  // end double NB_Interpolate(lat,doy,entry)
 
 
+   // continued fraction of the mapping functions, normalized to one at
+   // zenith, for se = sin(elevation)
+   static inline double NB_Map(double se, double a, double b, double c)
+   {
+      return ( (1.0+a/(1.0+b/(1.0+c))) / (se+a/(se+b/(se+c))) );
+   }
+
+
+   // dry mapping function at elevation (degrees), with se = sin(elevation),
+   // coefficients a, b, c and height ht in meters
+   static inline double NB_DryMap(double elevation, double se,
+                                  double a, double b, double c, double ht)
+   {
+      double map = NB_Map(se, a, b, c);
+      if(ABS(elevation)<=0.001) se=0.001;
+      map += ((1.0/se)-NB_Map(se, 2.53e-5, 5.49e-3, 1.14e-3))*ht/1000.0;
+      return map;
+   }
+
+
    NBTropModel::NBTropModel():
       validWeather(false), validRxLatitude(false),
       validDOY(false), validRxHeight(false)
@@ -213,9 +233,61 @@ namespace gnsstk
    }
 
 
+   void NBTropModel::corrections(const std::vector<double>& elevations,
+                                 std::vector<double>& delays) const
+   {
+      THROW_IF_INVALID_DETAILED();
+
+      double dryZenith = dry_zenith_delay();
+      double wetZenith = wet_zenith_delay();
+      double ad = NB_Interpolate(latitude,doy,Mad);
+      double bd = NB_Interpolate(latitude,doy,Mbd);
+      double cd = NB_Interpolate(latitude,doy,Mcd);
+      double aw = NB_Interpolate(latitude,doy,Maw);
+      double bw = NB_Interpolate(latitude,doy,Mbw);
+      double cw = NB_Interpolate(latitude,doy,Mcw);
+
+      delays.resize(elevations.size());
+      for(size_t i=0; i<elevations.size(); i++)
+      {
+         double el = elevations[i];
+         if(el < 0.0)
+         {
+            delays[i] = 0.0;
+            continue;
+         }
+         double se = std::sin(el*DEG_TO_RAD);
+         delays[i] = (dryZenith * NB_DryMap(el, se, ad, bd, cd, height)
+                      + wetZenith * NB_Map(se, aw, bw, cw));
+      }
+   }
+
+
    double NBTropModel::correction(const Position& RX,
                                   const Position& SV,
                                   const CommonTime& tt)
+   {
+      setReceiver(RX, tt);
+
+      return TropModel::correction(RX.elevation(SV));
+   }
+
+
+   void NBTropModel::corrections(const Position& RX,
+                                 const std::vector<Position>& SV,
+                                 const CommonTime& tt,
+                                 std::vector<double>& delays)
+   {
+      setReceiver(RX, tt);
+
+      std::vector<double> elevations(SV.size());
+      for(size_t i=0; i<SV.size(); i++)
+         elevations[i] = RX.elevation(SV[i]);
+      NBTropModel::corrections(elevations, delays);
+   }
+
+
+   void NBTropModel::setReceiver(const Position& RX, const CommonTime& tt)
    {
       THROW_IF_INVALID_DETAILED();
 
@@ -225,8 +297,6 @@ namespace gnsstk
 
          // compute day of year from tt
       setDayOfYear(int((static_cast<YDSTime>(tt)).doy));
-
-      return TropModel::correction(RX.elevation(SV));
    }
 
 
@@ -286,21 +356,13 @@ namespace gnsstk
 
       if(elevation < 0.0) return 0.0;
 
-      double a,b,c,se,map;
+      double a,b,c,se;
       se = std::sin(elevation*DEG_TO_RAD);
-
       a = NB_Interpolate(latitude,doy,Mad);
       b = NB_Interpolate(latitude,doy,Mbd);
       c = NB_Interpolate(latitude,doy,Mcd);
-      map = (1.0+a/(1.0+b/(1.0+c))) / (se+a/(se+b/(se+c)));
 
-      a = 2.53e-5;
-      b = 5.49e-3;
-      c = 1.14e-3;
-      if(ABS(elevation)<=0.001) se=0.001;
-      map += ((1.0/se)-(1.0+a/(1.0+b/(1.0+c)))/(se+a/(se+b/(se+c))))*height/1000.0;
-
-      return map;
+      return NB_DryMap(elevation, se, a, b, c, height);
 
    }  // end NBTropModel::dry_mapping_function()
 
@@ -317,7 +379,7 @@ namespace gnsstk
       b = NB_Interpolate(latitude,doy,Mbw);
       c = NB_Interpolate(latitude,doy,Mcw);
 
-      return ( (1.0+a/(1.0+b/(1.0+c))) / (se+a/(se+b/(se+c))) );
+      return NB_Map(se, a, b, c);
 
    }  // end NBTropModel::wet_mapping_function()
 
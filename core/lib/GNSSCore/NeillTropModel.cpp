@@ -52,6 +52,8 @@ namespace gnsstk
    NeillTropModel::NeillTropModel( const Position& RX,
                                    const CommonTime& time )
    {
+      validLat = false;
+      validDOY = false;
       setReceiverHeight(RX.getAltitude());
       setReceiverLatitude(RX.getGeodeticLatitude( ));
       setDayOfYear(time);
@@ -94,6 +96,103 @@ namespace gnsstk
      0.00084795348, 0.0017037206 };
 
 
+      /* Continued fraction of the mapping functions, normalized to one
+       * at zenith, for se = sin(elevation).
+       */
+   static inline double NeillMap(double se, double a, double b, double c)
+   {
+      return (1.+a/(1.+b/(1.+c)))/(se+a/(se+b/(se+c)));
+   }
+
+
+      /* Coefficients of the dry mapping function, which depend on
+       * latitude (degrees) and day of year but not on elevation.
+       */
+   static void NeillDryCoefficients(double latitude, int doy,
+                                    double& a, double& b, double& c)
+   {
+      double lat, t, ct;
+      lat = fabs(latitude);         // degrees
+      t = static_cast<double>(doy) - 28.0;  // mid-winter
+
+      if(latitude < 0.0)              // southern hemisphere
+      {
+         t += 365.25/2.;
+      }
+
+      t *= 360.0/365.25;            // convert to degrees
+      ct = ::cos(t*DEG_TO_RAD);
+
+      if(lat < 15.0)
+      {
+         a = NeillDryA[0];
+         b = NeillDryB[0];
+         c = NeillDryC[0];
+      }
+      else if(lat < 75.)      // coefficients are for 15,30,45,60,75 deg
+      {
+         int i=int(lat/15.0)-1;
+         double frac=(lat-15.*(i+1))/15.;
+         a = NeillDryA[i] + frac*(NeillDryA[i+1]-NeillDryA[i]);
+         b = NeillDryB[i] + frac*(NeillDryB[i+1]-NeillDryB[i]);
+         c = NeillDryC[i] + frac*(NeillDryC[i+1]-NeillDryC[i]);
+
+         a -= ct * (NeillDryA1[i] + frac*(NeillDryA1[i+1]-NeillDryA1[i]));
+         b -= ct * (NeillDryB1[i] + frac*(NeillDryB1[i+1]-NeillDryB1[i]));
+         c -= ct * (NeillDryC1[i] + frac*(NeillDryC1[i+1]-NeillDryC1[i]));
+      }
+      else
+      {
+         a = NeillDryA[4] - ct * NeillDryA1[4];
+         b = NeillDryB[4] - ct * NeillDryB1[4];
+         c = NeillDryC[4] - ct * NeillDryC1[4];
+      }
+   }
+
+
+      /* Coefficients of the wet mapping function, which depend on
+       * latitude (degrees) only.
+       */
+   static void NeillWetCoefficients(double latitude,
+                                    double& a, double& b, double& c)
+   {
+      double lat = fabs(latitude);         // degrees
+      if(lat < 15.0)
+      {
+         a = NeillWetA[0];
+         b = NeillWetB[0];
+         c = NeillWetC[0];
+      }
+      else if(lat < 75.)          // coefficients are for 15,30,45,60,75 deg
+      {
+         int i=int(lat/15.0)-1;
+         double frac=(lat-15.*(i+1))/15.;
+         a = NeillWetA[i] + frac*(NeillWetA[i+1]-NeillWetA[i]);
+         b = NeillWetB[i] + frac*(NeillWetB[i+1]-NeillWetB[i]);
+         c = NeillWetC[i] + frac*(NeillWetC[i+1]-NeillWetC[i]);
+      }
+      else
+      {
+         a = NeillWetA[4];
+         b = NeillWetB[4];
+         c = NeillWetC[4];
+      }
+   }
+
+
+      /* Dry mapping function for se = sin(elevation), coefficients
+       * a, b, c, and height ht in meters.
+       */
+   static inline double NeillDryMap(double se, double a, double b, double c,
+                                    double ht)
+   {
+      double map = NeillMap(se, a, b, c);
+      map += ( ht/1000.0 ) *
+         ( 1./se - NeillMap(se, 0.0000253, 0.00549, 0.00114) );
+      return map;
+   }
+
+
    double NeillTropModel::correction(double elevation) const
    {
       THROW_IF_INVALID_DETAILED();
@@ -116,25 +215,38 @@ namespace gnsstk
    }
 
 
-   double NeillTropModel::correction( const Position& RX,
-                                      const Position& SV )
+   void NeillTropModel::corrections(const std::vector<double>& elevations,
+                                    std::vector<double>& delays) const
    {
+      THROW_IF_INVALID_DETAILED();
 
-      try
-      {
-         setReceiverHeight( RX.getAltitude() );
-         setReceiverLatitude(RX.getGeodeticLatitude());
-         setWeather();
-      }
-      catch(GeometryException& e)
-      {
-         valid = false;
-      }
+      double da, db, dc, wa, wb, wc;
+      NeillDryCoefficients(NeillLat, NeillDOY, da, db, dc);
+      NeillWetCoefficients(NeillLat, wa, wb, wc);
+      double dryZenith(NeillTropModel::dry_zenith_delay());
+      double wetZenith(NeillTropModel::wet_zenith_delay());
 
-      if(!valid)
+      delays.resize(elevations.size());
+      for(size_t i=0; i<elevations.size(); i++)
       {
-         throw InvalidTropModel("Invalid model");
+            // Neill mapping functions work down to 3 degrees of elevation
+         if(elevations[i] < 3.0)
+         {
+            delays[i] = 0.0;
+            continue;
+         }
+
+         double se = ::sin(elevations[i]*DEG_TO_RAD);
+         delays[i] = (dryZenith * NeillDryMap(se, da, db, dc, NeillHeight)) +
+                     (wetZenith * NeillMap(se, wa, wb, wc));
       }
+   }
+
+
+   double NeillTropModel::correction( const Position& RX,
+                                      const Position& SV )
+   {
+      setReceiver(RX);
 
       double c;
       try
@@ -160,6 +272,43 @@ namespace gnsstk
    }
 
 
+   void NeillTropModel::corrections( const Position& RX,
+                                     const std::vector<Position>& SV,
+                                     const CommonTime& tt,
+                                     std::vector<double>& delays )
+   {
+      setDayOfYear(tt);
+      setReceiver(RX);
+
+      std::vector<double> elevations(SV.size());
+      for (size_t i = 0; i < SV.size(); i++)
+      {
+         elevations[i] = RX.elevationGeodetic(SV[i]);
+      }
+      NeillTropModel::corrections(elevations, delays);
+   }
+
+
+   void NeillTropModel::setReceiver( const Position& RX )
+   {
+      try
+      {
+         setReceiverHeight( RX.getAltitude() );
+         setReceiverLatitude(RX.getGeodeticLatitude());
+         setWeather();
+      }
+      catch(GeometryException& e)
+      {
+         valid = false;
+      }
+
+      if(!valid)
+      {
+         throw InvalidTropModel("Invalid model");
+      }
+   }
+
+
    double NeillTropModel::correction( const Position& RX,
                                       const Position& SV,
                                       const int& doy )
@@ -225,54 +374,12 @@ namespace gnsstk
          return 0.0;
       }
 
-      double lat, t, ct;
-      lat = fabs(NeillLat);         // degrees
-      t = static_cast<double>(NeillDOY) - 28.0;  // mid-winter
-
-      if(NeillLat < 0.0)              // southern hemisphere
-      {
-         t += 365.25/2.;
-      }
-
-      t *= 360.0/365.25;            // convert to degrees
-      ct = ::cos(t*DEG_TO_RAD);
-
       double a, b, c;
-      if(lat < 15.0)
-      {
-         a = NeillDryA[0];
-         b = NeillDryB[0];
-         c = NeillDryC[0];
-      }
-      else if(lat < 75.)      // coefficients are for 15,30,45,60,75 deg
-      {
-         int i=int(lat/15.0)-1;
-         double frac=(lat-15.*(i+1))/15.;
-         a = NeillDryA[i] + frac*(NeillDryA[i+1]-NeillDryA[i]);
-         b = NeillDryB[i] + frac*(NeillDryB[i+1]-NeillDryB[i]);
-         c = NeillDryC[i] + frac*(NeillDryC[i+1]-NeillDryC[i]);
-
-         a -= ct * (NeillDryA1[i] + frac*(NeillDryA1[i+1]-NeillDryA1[i]));
-         b -= ct * (NeillDryB1[i] + frac*(NeillDryB1[i+1]-NeillDryB1[i]));
-         c -= ct * (NeillDryC1[i] + frac*(NeillDryC1[i+1]-NeillDryC1[i]));
-      }
-      else
-      {
-         a = NeillDryA[4] - ct * NeillDryA1[4];
-         b = NeillDryB[4] - ct * NeillDryB1[4];
-         c = NeillDryC[4] - ct * NeillDryC1[4];
-      }
+      NeillDryCoefficients(NeillLat, NeillDOY, a, b, c);
 
       double se = ::sin(elevation*DEG_TO_RAD);
-      double map = (1.+a/(1.+b/(1.+c)))/(se+a/(se+b/(se+c)));
 
-      a = 0.0000253;
-      b = 0.00549;
-      c = 0.00114;
-      map += ( NeillHeight/1000.0 ) *
-         ( 1./se - ( (1.+a/(1.+b/(1.+c))) / (se+a/(se+b/(se+c))) ) );
-
-      return map;
+      return NeillDryMap(se, a, b, c, NeillHeight);
    }
 
 
@@ -285,33 +392,12 @@ namespace gnsstk
          return 0.0;
       }
 
-      double a,b,c,lat;
-      lat = fabs(NeillLat);         // degrees
-      if(lat < 15.0)
-      {
-         a = NeillWetA[0];
-         b = NeillWetB[0];
-         c = NeillWetC[0];
-      }
-      else if(lat < 75.)          // coefficients are for 15,30,45,60,75 deg
-      {
-         int i=int(lat/15.0)-1;
-         double frac=(lat-15.*(i+1))/15.;
-         a = NeillWetA[i] + frac*(NeillWetA[i+1]-NeillWetA[i]);
-         b = NeillWetB[i] + frac*(NeillWetB[i+1]-NeillWetB[i]);
-         c = NeillWetC[i] + frac*(NeillWetC[i+1]-NeillWetC[i]);
-      }
-      else
-      {
-         a = NeillWetA[4];
-         b = NeillWetB[4];
-         c = NeillWetC[4];
-      }
+      double a, b, c;
+      NeillWetCoefficients(NeillLat, a, b, c);
 
       double se = ::sin(elevation*DEG_TO_RAD);
-      double map = ( 1.+ a/ (1.+ b/(1.+c) ) ) / (se + a/(se + b/(se+c) ) );
 
-      return map;
+      return NeillMap(se, a, b, c);
 
    }  // end NeillTropModel::wet_mapping_function()
 
@@ -100,7 +100,7 @@ namespace gnsstk
           *   meters.
           */
       NeillTropModel(const double& ht)
-      { setReceiverHeight(ht); };
+      { validLat=false; validDOY=false; setReceiverHeight(ht); };
 
 
          /** Constructor to create a Neill trop model providing the height of
@@ -115,7 +115,10 @@ namespace gnsstk
       NeillTropModel( const double& ht,
                       const double& lat,
                       const int& doy )
-      { setReceiverHeight(ht); setReceiverLatitude(lat); setDayOfYear(doy); };
+      {
+         validLat=false; validDOY=false;
+         setReceiverHeight(ht); setReceiverLatitude(lat); setDayOfYear(doy);
+      };
 
 
          /** Constructor to create a Neill trop model providing the position
@@ -136,6 +139,11 @@ namespace gnsstk
       virtual double correction(double elevation) const;
 
 
+         /// @copydoc TropModel::corrections(const std::vector<double>&,std::vector<double>&) const
+      virtual void corrections(const std::vector<double>& elevations,
+                               std::vector<double>& delays) const;
+
+
          /** Compute and return the full tropospheric delay, in meters,
           * given the positions of receiver and satellite.
           *
@@ -162,6 +170,13 @@ namespace gnsstk
                                  const CommonTime& tt );
 
 
+         /// @copydoc TropModel::corrections(const Position&,const std::vector<Position>&,const CommonTime&,std::vector<double>&)
+      virtual void corrections( const Position& RX,
+                                const std::vector<Position>& SV,
+                                const CommonTime& tt,
+                                std::vector<double>& delays );
+
+
          /** Compute and return the full tropospheric delay, in meters,
           * given the positions of receiver and satellite and the day of the
           * year.
@@ -299,6 +314,11 @@ namespace gnsstk
 
 
    private:
+         /** Set the receiver height and latitude from RX, then check
+          * the model is valid.
+          * @throw InvalidTropModel */
+      void setReceiver( const Position& RX );
+
       double NeillHeight;
       double NeillLat;
       int NeillDOY;
@@ -1339,7 +1339,7 @@ namespace gnsstk
       S.transformTo(Cartesian);
       Triple z;
       // Let's get the slant vector
-      z = S.theArray - R.theArray;
+      z.theArray = S.theArray - R.theArray;
 
       if (z.mag()<=1e-4) // if the positions are within .1 millimeter
       {
@@ -1398,7 +1398,7 @@ namespace gnsstk
       S.transformTo(Cartesian);
       Triple z;
       // Let's get the slant vector
-      z = S.theArray - R.theArray;
+      z.theArray = S.theArray - R.theArray;
 
       if (z.mag()<=1e-4) // if the positions are within .1 millimeter
       {
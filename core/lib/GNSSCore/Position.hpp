@@ -76,9 +76,9 @@ namespace gnsstk
        * system, and a tolerance for use in comparing Positions. Class
        * Position inherits from class Triple, which is how the
        * coordinate values are stored (Triple actually uses
-       * std::valarray<double> of length 3). It is important to note
-       * that Triple:: routines are properly used by Positions ONLY in
-       * the Cartesian coordinate system.
+       * SVector<double,3>). It is important to note that Triple::
+       * routines are properly used by Positions ONLY in the Cartesian
+       * coordinate system.
        *
        * Only geodetic coordinates depend on a ellipsoid, and then
        * only on the semi-major axis of the Earth and the square of
@@ -1056,7 +1056,7 @@ namespace gnsstk
           *                    toward y axis (same as longitude)
           *                 radius (meters?) - distance from origin
           */
-         // use std::valarray<double> theArray;  -- inherit from Triple
+         // use SVector<double,3> theArray;  -- inherit from Triple
 
          /// semi-major axis of Earth (meters)
       double AEarth;
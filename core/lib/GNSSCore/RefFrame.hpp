@@ -69,6 +69,14 @@ namespace gnsstk
           * @param[in] when The timestamp when the reference frame
           *   system was being used, maps to a realization. */
       RefFrame(RefFrameSys sys, const gnsstk::CommonTime& when);
+         /** Construct a RefFrame with an explicit system and
+          * realization, e.g. when restoring a previously stored
+          * RefFrame.  No consistency checks are made.
+          * @param[in] sys The reference frame system being used.
+          * @param[in] rlz The reference frame realization being used. */
+      RefFrame(RefFrameSys sys, RefFrameRlz rlz)
+            : system(sys), realization(rlz)
+      {}
          /** Construct from a string representation of a realization
           * (e.g. from an SP3 file header).
           * @post system and realization are set. 
@@ -74,6 +74,88 @@ namespace gnsstk
      { 0.0, 0.000090128400, 0.000043497037, 0.00084795348, 0.0017037206 };
 
 
+   // continued fraction of the mapping functions, normalized to one at
+   // zenith, for se = sin(elevation)
+   static inline double SaasMap(double se, double a, double b, double c)
+   {
+      return (1.+a/(1.+b/(1.+c)))/(se+a/(se+b/(se+c)));
+   }
+
+
+   // coefficients of the dry mapping function, which depend on latitude
+   // (degrees) and day of year but not on elevation
+   static void SaasDryCoefficients(double latitude, int doy,
+                                   double& a, double& b, double& c)
+   {
+      double lat,t,ct;
+      lat = fabs(latitude);         // degrees
+      t = doy - 28.;                // mid-winter
+      if(latitude < 0)              // southern hemisphere
+         t += 365.25/2.;
+      t *= 360.0/365.25;            // convert to degrees
+      ct = ::cos(t*DEG_TO_RAD);
+
+      if(lat < 15.) {
+         a = SaasDryA[0];
+         b = SaasDryB[0];
+         c = SaasDryC[0];
+      }
+      else if(lat < 75.) {          // coefficients are for 15,30,45,60,75 deg
+         int i=int(lat/15.0)-1;
+         double frac=(lat-15.*(i+1))/15.;
+         a = SaasDryA[i] + frac*(SaasDryA[i+1]-SaasDryA[i]);
+         b = SaasDryB[i] + frac*(SaasDryB[i+1]-SaasDryB[i]);
+         c = SaasDryC[i] + frac*(SaasDryC[i+1]-SaasDryC[i]);
+
+         a -= ct * (SaasDryA1[i] + frac*(SaasDryA1[i+1]-SaasDryA1[i]));
+         b -= ct * (SaasDryB1[i] + frac*(SaasDryB1[i+1]-SaasDryB1[i]));
+         c -= ct * (SaasDryC1[i] + frac*(SaasDryC1[i+1]-SaasDryC1[i]));
+      }
+      else {
+         a = SaasDryA[4] - ct * SaasDryA1[4];
+         b = SaasDryB[4] - ct * SaasDryB1[4];
+         c = SaasDryC[4] - ct * SaasDryC1[4];
+      }
+   }
+
+
+   // coefficients of the wet mapping function, which depend on
+   // latitude (degrees) only
+   static void SaasWetCoefficients(double latitude,
+                                   double& a, double& b, double& c)
+   {
+      double lat = fabs(latitude);         // degrees
+      if(lat < 15.) {
+         a = SaasWetA[0];
+         b = SaasWetB[0];
+         c = SaasWetC[0];
+      }
+      else if(lat < 75.) {          // coefficients are for 15,30,45,60,75 deg
+         int i=int(lat/15.0)-1;
+         double frac=(lat-15.*(i+1))/15.;
+         a = SaasWetA[i] + frac*(SaasWetA[i+1]-SaasWetA[i]);
+         b = SaasWetB[i] + frac*(SaasWetB[i+1]-SaasWetB[i]);
+         c = SaasWetC[i] + frac*(SaasWetC[i+1]-SaasWetC[i]);
+      }
+      else {
+         a = SaasWetA[4];
+         b = SaasWetB[4];
+         c = SaasWetC[4];
+      }
+   }
+
+
+   // dry mapping function for se = sin(elevation), coefficients a, b, c
+   // and height ht in meters
+   static inline double SaasDryMap(double se, double a, double b, double c,
+                                   double ht)
+   {
+      double map = SaasMap(se, a, b, c);
+      map += (ht/1000.0)*(1./se-SaasMap(se, 0.0000253, 0.00549, 0.00114));
+      return map;
+   }
+
+
    SaasTropModel::SaasTropModel()
    {
       validWeather = false;
@@ -146,9 +228,67 @@ namespace gnsstk
    }  // end SaasTropModel::correction(elevation)
 
 
+   void SaasTropModel::corrections(const std::vector<double>& elevations,
+                                   std::vector<double>& delays) const
+   {
+      THROW_IF_INVALID_DETAILED();
+
+      double da,db,dc,wa,wb,wc,dryZenith,wetZenith;
+      try {
+         SaasDryCoefficients(latitude, doy, da, db, dc);
+         SaasWetCoefficients(latitude, wa, wb, wc);
+         dryZenith = dry_zenith_delay();
+         wetZenith = wet_zenith_delay();
+      }
+      catch(Exception& e) { GNSSTK_RETHROW(e); }
+
+      delays.resize(elevations.size());
+      for(size_t i=0; i<elevations.size(); i++) {
+         if(elevations[i] < 0.0) {
+            delays[i] = 0.0;
+            continue;
+         }
+         double se = ::sin(elevations[i]*DEG_TO_RAD);
+         delays[i] = (dryZenith * SaasDryMap(se, da, db, dc, height)
+            + wetZenith * SaasMap(se, wa, wb, wc));
+      }
+
+   }  // end SaasTropModel::corrections(elevations)
+
+
    double SaasTropModel::correction(const Position& RX,
                                     const Position& SV,
                                     const CommonTime& tt)
+   {
+      setReceiver(RX, tt);
+
+      double corr=0.0;
+      try {
+         corr = SaasTropModel::correction(RX.elevation(SV));
+      }
+      catch(Exception& e) { GNSSTK_RETHROW(e); }
+
+      return corr;
+
+   }  // end SaasTropModel::correction(RX,SV,TT)
+
+
+   void SaasTropModel::corrections(const Position& RX,
+                                   const std::vector<Position>& SV,
+                                   const CommonTime& tt,
+                                   std::vector<double>& delays)
+   {
+      setReceiver(RX, tt);
+
+      std::vector<double> elevations(SV.size());
+      for(size_t i=0; i<SV.size(); i++)
+         elevations[i] = RX.elevation(SV[i]);
+      SaasTropModel::corrections(elevations, delays);
+
+   }  // end SaasTropModel::corrections(RX,SV,TT)
+
+
+   void SaasTropModel::setReceiver(const Position& RX, const CommonTime& tt)
    {
       SaasTropModel::setReceiverHeight(RX.getHeight());
       SaasTropModel::setReceiverLatitude(RX.getGeodeticLatitude());
@@ -166,15 +306,7 @@ namespace gnsstk
          valid = true;
       }
 
-      double corr=0.0;
-      try {
-         corr = SaasTropModel::correction(RX.elevation(SV));
-      }
-      catch(Exception& e) { GNSSTK_RETHROW(e); }
-
-      return corr;
-
-   }  // end SaasTropModel::correction(RX,SV,TT)
+   }  // end SaasTropModel::setReceiver(RX,TT)
 
 
    double SaasTropModel::correction(const Xvt& RX,
@@ -226,46 +358,12 @@ namespace gnsstk
       THROW_IF_INVALID_DETAILED();
       if(elevation < 0.0) return 0.0;
 
-      double lat,t,ct;
-      lat = fabs(latitude);         // degrees
-      t = doy - 28.;                // mid-winter
-      if(latitude < 0)              // southern hemisphere
-         t += 365.25/2.;
-      t *= 360.0/365.25;            // convert to degrees
-      ct = ::cos(t*DEG_TO_RAD);
-
       double a,b,c;
-      if(lat < 15.) {
-         a = SaasDryA[0];
-         b = SaasDryB[0];
-         c = SaasDryC[0];
-      }
-      else if(lat < 75.) {          // coefficients are for 15,30,45,60,75 deg
-         int i=int(lat/15.0)-1;
-         double frac=(lat-15.*(i+1))/15.;
-         a = SaasDryA[i] + frac*(SaasDryA[i+1]-SaasDryA[i]);
-         b = SaasDryB[i] + frac*(SaasDryB[i+1]-SaasDryB[i]);
-         c = SaasDryC[i] + frac*(SaasDryC[i+1]-SaasDryC[i]);
-
-         a -= ct * (SaasDryA1[i] + frac*(SaasDryA1[i+1]-SaasDryA1[i]));
-         b -= ct * (SaasDryB1[i] + frac*(SaasDryB1[i+1]-SaasDryB1[i]));
-         c -= ct * (SaasDryC1[i] + frac*(SaasDryC1[i+1]-SaasDryC1[i]));
-      }
-      else {
-         a = SaasDryA[4] - ct * SaasDryA1[4];
-         b = SaasDryB[4] - ct * SaasDryB1[4];
-         c = SaasDryC[4] - ct * SaasDryC1[4];
-      }
+      SaasDryCoefficients(latitude, doy, a, b, c);
 
       double se = ::sin(elevation*DEG_TO_RAD);
-      double map = (1.+a/(1.+b/(1.+c)))/(se+a/(se+b/(se+c)));
-
-      a = 0.0000253;
-      b = 0.00549;
-      c = 0.00114;
-      map += (height/1000.0)*(1./se-(1+a/(1.+b/(1.+c)))/(se+a/(se+b/(se+c))));
 
-      return map;
+      return SaasDryMap(se, a, b, c, height);
 
    }  // end SaasTropModel::dry_mapping_function()
 
@@ -275,30 +373,12 @@ namespace gnsstk
       THROW_IF_INVALID_DETAILED();
       if(elevation < 0.0) return 0.0;
 
-      double a,b,c,lat;
-      lat = fabs(latitude);         // degrees
-      if(lat < 15.) {
-         a = SaasWetA[0];
-         b = SaasWetB[0];
-         c = SaasWetC[0];
-      }
-      else if(lat < 75.) {          // coefficients are for 15,30,45,60,75 deg
-         int i=int(lat/15.0)-1;
-         double frac=(lat-15.*(i+1))/15.;
-         a = SaasWetA[i] + frac*(SaasWetA[i+1]-SaasWetA[i]);
-         b = SaasWetB[i] + frac*(SaasWetB[i+1]-SaasWetB[i]);
-         c = SaasWetC[i] + frac*(SaasWetC[i+1]-SaasWetC[i]);
-      }
-      else {
-         a = SaasWetA[4];
-         b = SaasWetB[4];
-         c = SaasWetC[4];
-      }
+      double a,b,c;
+      SaasWetCoefficients(latitude, a, b, c);
 
       double se = ::sin(elevation*DEG_TO_RAD);
-      double map = (1.+a/(1.+b/(1.+c)))/(se+a/(se+b/(se+c)));
 
-      return map;
+      return SaasMap(se, a, b, c);
 
    }
 
@@ -122,11 +122,21 @@ namespace gnsstk
          /// @copydoc TropModel::correction(double) const
       virtual double correction(double elevation) const;
 
+         /// @copydoc TropModel::corrections(const std::vector<double>&,std::vector<double>&) const
+      virtual void corrections(const std::vector<double>& elevations,
+                               std::vector<double>& delays) const;
+
          /// @copydoc TropModel::correction(const Position&,const Position&,const CommonTime&)
       virtual double correction(const Position& RX,
                                 const Position& SV,
                                 const CommonTime& tt);
 
+         /// @copydoc TropModel::corrections(const Position&,const std::vector<Position>&,const CommonTime&,std::vector<double>&)
+      virtual void corrections(const Position& RX,
+                               const std::vector<Position>& SV,
+                               const CommonTime& tt,
+                               std::vector<double>& delays);
+
          /// @copydoc TropModel::correction(const Xvt&,const Xvt&,const CommonTime&)
       virtual double correction(const Xvt& RX,
                                 const Xvt& SV,
@@ -162,6 +172,11 @@ namespace gnsstk
       void setDayOfYear(const int& d);
 
    private:
+         /** Set the receiver height, latitude and day of year from RX
+          * and tt, then check the model is valid.
+          * @throw InvalidTropModel */
+      void setReceiver(const Position& RX, const CommonTime& tt);
+
       double height;             ///< height (m) of the receiver above the geoid
       double latitude;           ///< latitude (deg) of receiver
       int doy;                   ///< day of year
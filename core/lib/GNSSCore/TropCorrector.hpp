@@ -102,6 +102,23 @@ namespace gnsstk
                    const SatID& sat, const ObsID& obs,
                    const CommonTime& when, NavType nav,
                    double& corrOut) override;
+         /** Get the tropospheric delays of all the satellites seen
+          * by a receiver at one time.  The model and its weather are
+          * set up once, and the delays are computed together using
+          * TropModel::corrections(), rather than calling getCorr()
+          * for each satellite.
+          * @param[in] rxPos The position of the receiver.
+          * @param[in] svPos The positions of the satellites.
+          * @param[in] when The time of the GNSS observations.
+          * @param[out] corrOut The delay in meters of each satellite,
+          *   resized to the number of satellites.  All of the delays
+          *   are NaN on failure.
+          * @return true if the delays were computed, false if not
+          *   (e.g. the weather data is missing or invalid). */
+      bool getCorrs(const Position& rxPos,
+                    const std::vector<Position>& svPos,
+                    const CommonTime& when,
+                    std::vector<double>& corrOut);
          /** Set default weather data if no time series is available
           * @param[in] temp The new default temperature (degrees C).
           * @param[in] pres The new default pressure (millibars).
@@ -113,6 +130,12 @@ namespace gnsstk
          /// Read and store weather data for look-up (single site)
       MetReader wxData;
    protected:
+         /** Tell the model where and when the receiver is.
+          * @param[in,out] model The model whose receiver is to be set.
+          * @param[in] rxPos The position of the receiver.
+          * @param[in] when The time of the GNSS observation. */
+      void setReceiver(Model& model, const Position& rxPos,
+                       const CommonTime& when);
          /// Set to true if setDefaultWx was called more recently than loadFile
       bool useDefault;
       double defTemp; ///< Default temperature value (degrees C).
@@ -170,10 +193,7 @@ namespace gnsstk
            double& corrOut)
    {
       Model model;
-      model.setReceiverHeight(rxPos.height());
-      model.setReceiverLatitude(rxPos.getGeodeticLatitude());
-      model.setReceiverLongitude(rxPos.getLongitude());
-      model.setDayOfYear(YDSTime(when).doy);
+      setReceiver(model, rxPos, when);
       try
       {
          setWeather(model, when);
@@ -200,6 +220,39 @@ namespace gnsstk
    }
 
 
+   template <class Model>
+   bool TropCorrector<Model> ::
+   getCorrs(const Position& rxPos, const std::vector<Position>& svPos,
+            const CommonTime& when, std::vector<double>& corrOut)
+   {
+      Model model;
+      setReceiver(model, rxPos, when);
+      try
+      {
+         setWeather(model, when);
+         model.corrections(rxPos, svPos, when, corrOut);
+         return true;
+      }
+      catch (...)
+      {
+         corrOut.assign(svPos.size(),
+                        std::numeric_limits<double>::quiet_NaN());
+         return false;
+      }
+   }
+
+
+   template <class Model>
+   void TropCorrector<Model> ::
+   setReceiver(Model& model, const Position& rxPos, const CommonTime& when)
+   {
+      model.setReceiverHeight(rxPos.height());
+      model.setReceiverLatitude(rxPos.getGeodeticLatitude());
+      model.setReceiverLongitude(rxPos.getLongitude());
+      model.setDayOfYear(YDSTime(when).doy);
+   }
+
+
    template <class Model>
    void TropCorrector<Model> ::
    setDefaultWx(double temp, double pres, double hum)
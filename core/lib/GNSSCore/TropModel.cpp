@@ -63,6 +63,30 @@ namespace gnsstk
    }  // end TropModel::correction(elevation)
 
 
+   void TropModel::corrections(const std::vector<double>& elevations,
+                               std::vector<double>& delays) const
+   {
+         // validity is left to correction(), which some models
+         // (e.g. ZeroTropModel) never check
+      delays.resize(elevations.size());
+      for(size_t i=0; i<elevations.size(); i++)
+         delays[i] = correction(elevations[i]);
+
+   }  // end TropModel::corrections(elevations)
+
+
+   void TropModel::corrections(const Position& RX,
+                               const std::vector<Position>& SV,
+                               const CommonTime& tt,
+                               std::vector<double>& delays)
+   {
+      delays.resize(SV.size());
+      for(size_t i=0; i<SV.size(); i++)
+         delays[i] = correction(RX, SV[i], tt);
+
+   }  // end TropModel::corrections(RX,SV,TT)
+
+
    double TropModel::correction(const Position& RX,
                                 const Position& SV,
                                 const CommonTime& tt)
@@ -45,6 +45,7 @@
 #ifndef TROP_MODEL_HPP
 #define TROP_MODEL_HPP
 
+#include <vector>
 #include "Exception.hpp"
 #include "ObsEpochMap.hpp"
 #include "WxObsMap.hpp"
@@ -166,6 +167,42 @@ namespace gnsstk
                                 const CommonTime& tt)
       { Position R(RX),S(SV);  return TropModel::correction(R,S,tt); }
 
+         /** Compute the full tropospheric delay, in meters, for each
+          * of many satellites seen by the receiver at the current
+          * time and weather. Each delay is the one
+          * correction(elevation) returns. This version simply calls
+          * correction(elevation) for each satellite; models override
+          * it to compute the zenith delays and the parts of the
+          * mapping functions that do not depend on elevation once
+          * for all satellites.
+          * @param[in] elevations Elevations of the satellites as seen
+          *   at the receiver, in degrees
+          * @param[out] delays The tropospheric delay (meters) of each
+          *   satellite, resized to the number of elevations
+          * @throw InvalidTropModel
+          */
+      virtual void corrections(const std::vector<double>& elevations,
+                               std::vector<double>& delays) const;
+
+         /** Compute the full tropospheric delay, in meters, for each
+          * of many satellites seen by the receiver at the same time.
+          * Each delay is the one correction(RX,SV,tt) returns. This
+          * version simply calls correction(RX,SV,tt) for each
+          * satellite; models that override corrections(elevations)
+          * override this too, to set up the receiver once and pass
+          * all the elevations to corrections(elevations).
+          * @param[in] RX Receiver position
+          * @param[in] SV Positions of the satellites
+          * @param[in] tt Time tag of the signals
+          * @param[out] delays The tropospheric delay (meters) of each
+          *   satellite, resized to the number of satellites
+          * @throw InvalidTropModel
+          */
+      virtual void corrections(const Position& RX,
+                               const std::vector<Position>& SV,
+                               const CommonTime& tt,
+                               std::vector<double>& delays);
+
          /** Compute and return the zenith delay for hydrostatic (dry)
           * component of the troposphere, in meters.
           * @throw InvalidTropModel
@@ -62,7 +62,8 @@ namespace gnsstk
    PackedNavBits::PackedNavBits()
                  : transmitTime(CommonTime::BEGINNING_OF_TIME),
                    parityStatus(psUnknown),
-                   bits(900),
+                   bits(15),
+                   bits_size(900),
                    bits_used(0),
                    rxID(""),
                    xMitCoerced(false)
@@ -72,7 +73,8 @@ namespace gnsstk
    PackedNavBits::PackedNavBits(const SatID& satSysArg,
                                 const ObsID& obsIDArg,
                                 const CommonTime& transmitTimeArg)
-                                : bits(900),
+                                : bits(15),
+                                  bits_size(900),
                                   parityStatus(psUnknown),
                                   bits_used(0),
                                   rxID(""),
@@ -88,7 +90,8 @@ namespace gnsstk
                                 const ObsID& obsIDArg,
                                 const std::string rxString,
                                 const CommonTime& transmitTimeArg)
-                                : bits(900),
+                                : bits(15),
+                                  bits_size(900),
                                   parityStatus(psUnknown),
                                   bits_used(0),
                                   rxID(""),
@@ -106,7 +109,8 @@ namespace gnsstk
                                 const NavID& navIDArg,
                                 const std::string rxString,
                                 const CommonTime& transmitTimeArg)
-                                : bits(900),
+                                : bits(15),
+                                  bits_size(900),
                                   parityStatus(psUnknown),
                                   bits_used(0),
                                   rxID(""),
@@ -134,10 +138,11 @@ namespace gnsstk
            navID(navIDArg),
            rxID(rxString),
            transmitTime(transmitTimeArg),
-           bits(numBits, fillValue),
+           bits_size(0),
            bits_used(numBits),
            xMitCoerced(false)
    {
+      resizeBits(numBits, fillValue);
    }
 
 
@@ -150,12 +155,14 @@ namespace gnsstk
       rxID   = right.rxID;
       transmitTime = right.transmitTime;
       bits_used = right.bits_used;
+      bits_size = 0;
       ensureCapacity(bits_used);
       parityStatus = right.parityStatus;
-      for (int i=0;i<bits_used;i++)
-      {
-         bits.at(i) = right.bits.at(i);
-      }
+      std::copy(right.bits.begin(),
+                right.bits.begin() + std::min(bits.size(), right.bits.size()),
+                bits.begin());
+         // clear any of right's bits beyond bits_used
+      resizeBits(bits_used);
       xMitCoerced = right.xMitCoerced;
    }
 
@@ -214,6 +221,7 @@ namespace gnsstk
    void PackedNavBits::clearBits()
    {
       bits.clear();
+      bits_size = 0;
       bits_used = 0;
    }
 
@@ -251,20 +259,30 @@ namespace gnsstk
    uint64_t PackedNavBits::asUint64_t(const int startBit,
                                       const int numBits ) const
    {
-      uint64_t temp = 0L;       // Set up a temporary variable with a known size
-                                // It needs to be AT LEAST 33 bits.
       size_t stop = startBit + numBits;
-      if (stop>bits.size())
+      if ((startBit < 0) || (stop>bits_size))
       {
          InvalidParameter exc("Requested bits not present.");
          GNSSTK_THROW(exc);
       }
-      for (size_t i=startBit; i<stop; ++i)
+      if (numBits <= 0)
+      {
+         return 0;
+      }
+         // Only the last 64 bits fit in the result.
+      size_t first = (numBits > 64 ? stop - 64 : startBit);
+      int len = (numBits > 64 ? 64 : numBits);
+         // Left-justify the field in temp, taking bits from the
+         // following word if the field crosses a word boundary, then
+         // right-justify it.
+      size_t word = first >> 6;
+      unsigned offset = first & 63;
+      uint64_t temp = bits[word] << offset;
+      if (offset + len > 64)
       {
-         temp <<= 1;
-         if (bits.at(i)) temp++;
+         temp |= bits[word+1] >> (64 - offset);
       }
-      return( temp );
+      return( temp >> (64 - len) );
    }
 
    unsigned long PackedNavBits::asUnsignedLong(const int startBit,
@@ -610,7 +628,11 @@ namespace gnsstk
 
    bool PackedNavBits::asBool( const unsigned bitNum) const
    {
-      return bits.at(bitNum);
+      if (bitNum >= bits_size)
+      {
+         throw std::out_of_range("PackedNavBits::asBool");
+      }
+      return getBit(bitNum);
    }
 
 
@@ -779,31 +801,41 @@ namespace gnsstk
       bits_used += right.bits_used;
       ensureCapacity(bits_used);
 
-      for (int i=0;i<right.bits_used;i++)
+      for (int i=0;i<right.bits_used;i+=64)
       {
-         bits.at(i+old_bits_used) = right.bits.at(i);
+         int numBits = std::min(64, right.bits_used - i);
+         setUint64_t(right.asUint64_t(i, numBits), i+old_bits_used, numBits);
       }
    }
 
    void PackedNavBits::addUint64_t( const uint64_t value, const int numBits )
    {
       ensureCapacity(bits_used + numBits);
-      size_t ndx = bits_used;
-      uint64_t mask = 0x0000000000000001L;
-      mask <<= (numBits-1);
+      setUint64_t(value, bits_used, numBits);
+      bits_used += numBits;
+   }
 
-      for (int i=0; i<numBits; ++i)
+   void PackedNavBits::setUint64_t(const uint64_t value,
+                                   const size_t startBit,
+                                   const int numBits)
+   {
+      if (numBits <= 0)
       {
-         bits.at(ndx) = false;
-         if (value & mask)
-         {
-             //set the bits to true
-            bits.at(ndx) = true;
-         }
-         mask>>= 1;
-         ndx++;
+         return;
+      }
+         // Left-justify the field, then merge it into the one or two
+         // words it occupies.
+      uint64_t field = value << (64 - numBits);
+      uint64_t mask = ~UINT64_C(0) << (64 - numBits);
+      size_t word = startBit >> 6;
+      unsigned offset = startBit & 63;
+      bits[word] = (bits[word] & ~(mask >> offset)) | (field >> offset);
+      if (offset + numBits > 64)
+      {
+         unsigned shift = 64 - offset;
+         bits[word+1] = ((bits[word+1] & ~(mask << shift)) |
+                         (field << shift));
       }
-      bits_used += numBits;
    }
 
    //--------------------------------------------------------------------------
@@ -823,22 +855,19 @@ namespace gnsstk
          // happen.  In the context of NavFilter, data SHOULD be
          // from the same system, therefore, the same length should
          // always be true.
-      if (bits.size()!=right.bits.size())
+      if (bits_size!=right.bits_size)
       {
-         if (bits.size()<right.bits.size()) return true;
+         if (bits_size<right.bits_size) return true;
          return false;
       }
 
-      for (int i=0;i<bits.size();i++)
+         // Bits are stored MSB first and unused bits are 0, so the
+         // first differing word decides.
+      for (size_t i=0;i<bits.size();i++)
       {
-         if (bits.at(i)==false && right.bits.at(i)==true)
-         //if (bits[i]<right.bits[i])
+         if (bits[i]!=right.bits[i])
          {
-            return true;
-         }
-         if (bits.at(i)==true && right.bits.at(i)==false)
-         {
-            return false;
+            return (bits[i]<right.bits[i]);
          }
       }
       return false;
@@ -846,20 +875,12 @@ namespace gnsstk
 
    void PackedNavBits::invert( )
    {
-         // Each bit is either 1 or 0.
-         // Starting with 1 and subtracting the
-         // current value will yield the inverse
-         //
-         //  Input    Equation     Result
-         //    1       1 - 1          0
-         //    0       1 - 0          1
-         //
-         // This accomplishes the purpose without incurring
-         // the cost of a conditional statement.
-      for (int i=0;i<bits.size();i++)
+      for (size_t i=0;i<bits.size();i++)
       {
-         bits.at(i) = 1 - bits.at(i);
+         bits[i] = ~bits[i];
       }
+         // clear the unused bits in the last word
+      resizeBits(bits_size);
    }
 
       /**
@@ -883,9 +904,14 @@ namespace gnsstk
       short finalBit = endBit;
       if (finalBit==-1) finalBit = bits_used - 1;
 
-      for (short i=startBit; i<=finalBit; i++)
+      if ((startBit < 0) || (finalBit >= (int)bits_size))
+      {
+         throw std::out_of_range("PackedNavBits::copyBits");
+      }
+      for (int i=startBit; i<=finalBit; i+=64)
       {
-         bits.at(i) = src.bits.at(i);
+         int numBits = std::min(64, finalBit + 1 - i);
+         setUint64_t(src.asUint64_t(i, numBits), i, numBits);
       }
    }
 
@@ -915,20 +941,7 @@ namespace gnsstk
          GNSSTK_THROW(exc);
       }
 
-      size_t ndx = startBit;
-      uint64_t mask = 0x0000000000000001L;
-
-      mask <<= (numBits-1);
-      for (int i=0; i<numBits; i++)
-      {
-         bits.at(ndx) = false;
-         if (out & mask)
-         {
-            bits.at(ndx) = true;
-         }
-         mask >>= 1;
-         ndx++;
-      }
+      setUint64_t(out, startBit, numBits);
    }
 
 
@@ -943,7 +956,7 @@ namespace gnsstk
    //--------------------------------------------------------------------------
    void PackedNavBits::trimsize()
    {
-      bits.resize(bits_used);
+      resizeBits(bits_used);
    }
 
    //--------------------------------------------------------------------------
@@ -1006,10 +1019,10 @@ namespace gnsstk
       int numBitInWord = 0;
       int word_count   = 0;
       uint32_t word    = 0;
-      for(size_t i = 0; i < bits.size(); ++i)
+      for(size_t i = 0; i < bits_size; ++i)
       {
          word <<= 1;
-         if (bits.at(i)) word++;
+         if (getBit(i)) word++;
 
          numBitInWord++;
          if (numBitInWord >= 32)
@@ -1045,10 +1058,10 @@ namespace gnsstk
       int bit_count    = 0;
       int word_count   = 0;
       uint32_t word    = 0;
-      for(size_t i = 0; i < bits.size(); ++i)
+      for(size_t i = 0; i < bits_size; ++i)
       {
          word <<= 1;
-         if (bits.at(i)) word++;
+         if (getBit(i)) word++;
 
          numBitInWord++;
          if (numBitInWord >= numBitsPerWord)
@@ -1062,7 +1075,7 @@ namespace gnsstk
             //but ONLY if there are more bits left to put on the next line.
             if (word_count>0 &&
                 word_count % rollover == 0 &&
-                (i+1) < bits.size()) s << endl;
+                (i+1) < bits_size) s << endl;
          }
       }
          // Need to check if there is a partial word in the buffer
@@ -1072,7 +1085,7 @@ namespace gnsstk
          s << delimiter << " 0x" << setw(8) << setfill('0') << hex << word << dec << setfill(' ');
       }
       s.flags(oldFlags);      // Reset whatever conditions pertained on entry
-      return(bits.size());
+      return(bits_size);
    }
 
    bool PackedNavBits::operator==(const PackedNavBits& right) const
@@ -1125,19 +1138,20 @@ namespace gnsstk
    {
          // If the two objects don't have the same number of bits,
          // don't even try to compare them.
-      if (bits.size()!=right.bits.size()) return false;
+      if (bits_size!=right.bits_size) return false;
 
       short startBit = startBitA;
       short endBit = endBitA;
          // Check for nonsense arguments
       if (endBit==-1 ||
-          endBit>=int(bits.size())) endBit = bits.size()-1;
+          endBit>=int(bits_size)) endBit = bits_size-1;
       if (startBit<0) startBit=0;
-      if (startBit>=int(bits.size())) startBit = bits.size()-1;
+      if (startBit>=int(bits_size)) startBit = bits_size-1;
 
-      for (int i=startBit;i<=endBit;i++)
+      for (int i=startBit;i<=endBit;i+=64)
       {
-         if (bits.at(i)!=right.bits.at(i))
+         int numBits = std::min(64, endBit + 1 - i);
+         if (asUint64_t(i,numBits)!=right.asUint64_t(i,numBits))
          {
             return false;
          }
@@ -1228,10 +1242,37 @@ namespace gnsstk
    
    void PackedNavBits::ensureCapacity(const size_t s)
    {
-      if (bits.size() < s)
+      if (bits_size < s)
+      {
+         resizeBits(s);
+      }
+   }
+
+   void PackedNavBits::resizeBits(const size_t s, const bool fillValue)
+   {
+      size_t oldSize = bits_size;
+      bits.resize((s + 63) >> 6, fillValue ? ~UINT64_C(0) : 0);
+      bits_size = s;
+      if (fillValue && (s > oldSize) && (oldSize & 63))
+      {
+            // fill the rest of the old last word
+         bits[oldSize >> 6] |= (~UINT64_C(0) >> (oldSize & 63));
+      }
+         // maintain 0 in the unused bits of the last word
+      if (s & 63)
+      {
+         bits.back() &= (~UINT64_C(0) << (64 - (s & 63)));
+      }
+   }
+
+   std::vector<bool> PackedNavBits::getBits() const
+   {
+      std::vector<bool> rv(bits_size);
+      for (size_t i = 0; i < bits_size; i++)
       {
-         bits.resize(s);
+         rv[i] = getBit(i);
       }
+      return rv;
    }
 
    ostream& operator<<(ostream& s, const PackedNavBits& pnb)
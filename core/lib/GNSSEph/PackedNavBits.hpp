@@ -455,37 +455,35 @@ namespace gnsstk
          const auto numBits{std::distance(begin, end)};
          ensureCapacity(bits_used + numBits);
 
-         std::transform(begin, end, bits.begin() + bits_used, [](it_datatype bit)
+         size_t ndx = bits_used;
+         for (It i = begin; i != end; ++i, ++ndx)
+         {
+            if ((*i != 1) && (*i != 0))
             {
-               if (bit == 1)
-               {
-                  return true;
-               }
-               if (bit == 0)
-               {
-                  return false;
-               }
-
                gnsstk::InvalidParameter exc("Encountered data that is not 0 or 1");
                GNSSTK_THROW(exc);
-            });
+            }
+            setBit(ndx, (*i == 1));
+         }
 
          bits_used += numBits;
       }
 
 
-         /** Pack a bitset.  This is done by converting it first to a
-          * string of 0 and 1 characters which are then treated as an
-          * array that is appended to the end of the bits vector.  Not
-          * entirely sure if this is faster than iterating.
+         /** Pack a bitset.  The bits are appended to the end of the
+          * bit storage (i.e. after any unused capacity), MSB first.
           * @param[in] newbits The bitset containing the data to
           *   append to the PackedNavBits data. */
       template <size_t N>
       void addBitset(const std::bitset<N>& newbits)
       {
-         std::string binbits(newbits.to_string((char)0,(char)1));
-         bits.insert(bits.end(), &binbits[0], &binbits[binbits.length()]);
-         bits_used += binbits.length();
+         size_t ndx = bits_size;
+         resizeBits(bits_size + N);
+         for (size_t i = N; i > 0; i--, ndx++)
+         {
+            setBit(ndx, newbits[i-1]);
+         }
+         bits_used += N;
       }
 
          /**
@@ -657,8 +655,9 @@ namespace gnsstk
       void setXmitCoerced(bool tf=true) {xMitCoerced=tf;}
       bool isXmitCoerced() const {return xMitCoerced;}
 
-      const std::vector<bool>& getBits() const
-      { return bits; }
+         /** Get a copy of the packed bits, one element per bit,
+          * including any unused capacity beyond getNumBits(). */
+      std::vector<bool> getBits() const;
 
          /** Indicate the status of parity/CRC checking.  Must be
           * explicitly set after construction, no parity checking is
@@ -671,7 +670,10 @@ namespace gnsstk
       NavID navID;             /**< Defines the navigation message tracked */
       std::string rxID;        /**< Defines the receiver that collected the data */
       CommonTime transmitTime; /**< Time nav message is transmitted */
-      std::vector<bool> bits;  /**< Holds the packed data */
+         /** Holds the packed data, 64 bits per word, starting with
+          * the MSB of bits[0].  Bits beyond bits_size are always 0. */
+      std::vector<uint64_t> bits;
+      size_t bits_size;        /**< Number of bits of storage in bits */
       int bits_used;
 
       bool xMitCoerced;        /**< Used to indicate that the transmit
@@ -697,6 +699,30 @@ namespace gnsstk
           */
       void ensureCapacity(const size_t s);
 
+         /** Change the number of bits of storage to \p s, setting
+          * any added bits to \p fillValue. */
+      void resizeBits(const size_t s, const bool fillValue = false);
+
+         /** Overwrite \p numBits bits starting at \p startBit with
+          * the \p numBits LSBs of \p value.  No range checking is
+          * done. */
+      void setUint64_t(const uint64_t value, const size_t startBit,
+                       const int numBits);
+
+         /// Return the bit at index \p i, with no range checking.
+      bool getBit(const size_t i) const
+      { return (bits[i >> 6] >> (63 - (i & 63))) & 1; }
+
+         /// Set the bit at index \p i, with no range checking.
+      void setBit(const size_t i, const bool value)
+      {
+         uint64_t mask = UINT64_C(1) << (63 - (i & 63));
+         if (value)
+            bits[i >> 6] |= mask;
+         else
+            bits[i >> 6] &= ~mask;
+      }
+
    }; // class PackedNavBits
 
       //@}
@@ -51,6 +51,7 @@
 #include <list>
 #include <sstream>
 #include <string>
+#include <utility>
 #include <vector>
 // gnsstk
 #include "GNSSconstants.hpp" // PI,C_MPS,OSC_FREQ_GPS,L1_MULT_GPS,L2_MULT_GPS
@@ -409,7 +410,8 @@ class GDCPass : public SatPass, public GDCconfiguration
    static const unsigned short GFDETECT;
    static const unsigned short GFFIX;
 
-   explicit GDCPass(SatPass& sp, const GDCconfiguration& gdc);
+   /// take over the data in sp, which is left empty
+   explicit GDCPass(SatPass&& sp, const GDCconfiguration& gdc);
 
    //~GDCPass() { };
 
@@ -779,8 +781,8 @@ int gnsstk::DiscontinuityCorrector(SatPass& svp, GDCconfiguration& gdc,
 
          // --------------------------------------------------------------------------
          // create a GDCPass from the input SatPass (modified) and GDC
-         // configuration
-      GDCPass gp(nsvp, gdc);
+         // configuration; nsvp is not used again, so hand its data over
+      GDCPass gp(std::move(nsvp), gdc);
 
          // --------------------------------------------------------------------------
          /* if the satellite is Glonass, compute the frequency channel, if
@@ -945,36 +947,9 @@ int gnsstk::DiscontinuityCorrector(SatPass& svp, GDCconfiguration& gdc,
 //---------------------------------------------------------------------------------
 // class GDCPass member functions
 //---------------------------------------------------------------------------------
-GDCPass::GDCPass(SatPass& sp, const GDCconfiguration& gdc)
-   : SatPass(sp.getSat(), sp.getDT(), sp.getObsTypes())
+GDCPass::GDCPass(SatPass&& sp, const GDCconfiguration& gdc)
+   : SatPass(std::move(sp)) // take the data as it is, rather than copying it
 {
-   int i, j;
-   Status            = sp.status();
-   dt                = sp.getDT();
-   sat               = sp.getSat();
-   vector<string> ot = sp.getObsTypes();
-   for (i = 0; i < static_cast<int>(ot.size()); i++)
-   {
-      labelForIndex[i]                = ot[i];
-      indexForLabel[labelForIndex[i]] = i;
-   }
-
-   vector<double> vdata;
-   vector<unsigned short> lli, ssi;
-   for (i = 0; i < static_cast<int>(sp.size()); i++)
-   {
-      vdata.clear();
-      lli.clear();
-      ssi.clear();
-      for (j = 0; j < static_cast<int>(ot.size()); j++)
-      {
-         vdata.push_back(sp.data(i, ot[j]));
-         lli.push_back(sp.LLI(i, ot[j]));
-         ssi.push_back(sp.SSI(i, ot[j]));
-      }
-      addData(sp.time(i), ot, vdata, lli, ssi, sp.getFlag(i));
-   }
-
    *((GDCconfiguration *)this) = gdc;
 
    learn.clear();
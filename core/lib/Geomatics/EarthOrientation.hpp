@@ -115,6 +115,9 @@ namespace gnsstk
       friend std::ostream& operator<<(std::ostream& s,
                                       const EarthOrientation& );
 
+         /// uses the private models to build its interpolation nodes
+      friend class EarthRotationService;
+
       //------------------------------------------------------------------------------
       // constants
 
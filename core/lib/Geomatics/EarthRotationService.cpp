@@ -0,0 +1,279 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+
+/** @file EarthRotationService.cpp
+    class EarthRotationService computes the ECEF-to-inertial rotation of class
+    EarthOrientation by interpolating the slowly varying precession and
+    nutation on a grid of epochs.
+*/
+
+//------------------------------------------------------------------------------------
+// system includes
+#include <cmath>
+// GNSSTk
+#include "EarthRotationService.hpp"
+
+//------------------------------------------------------------------------------------
+using namespace std;
+
+namespace gnsstk
+{
+   namespace
+   {
+         /* Rotation through angle radians about axis number (1, 2 or 3), the
+            same as rotation() in MatrixOperators.hpp. */
+      SMatrix<double,3,3> rotation3(double angle, int axis)
+      {
+         SMatrix<double,3,3> rv;
+         int i1 = axis - 1;
+         int i2 = (i1 + 1) % 3;
+         int i3 = (i2 + 1) % 3;
+         rv(i1, i1) = 1.0;
+         rv(i2, i2) = rv(i3, i3) = ::cos(angle);
+         rv(i3, i2) = -(rv(i2, i3) = ::sin(angle));
+         return rv;
+      }
+   }
+
+   //---------------------------------------------------------------------------------
+      // constants
+   //---------------------------------------------------------------------------------
+   const double EarthRotationService::defaultStep = 0.125;
+   const long EarthRotationService::noIndex = -2147483647L;
+
+   //---------------------------------------------------------------------------------
+   EarthRotationService::EarthRotationService(IERSConvention conv, double step)
+         : convention(conv), stepDays(step), stepT(step / 36525.0),
+           lastIndex(noIndex)
+   {
+      if (convention == IERSConvention::Unknown)
+      {
+         Exception e("IERS convention is not defined");
+         GNSSTK_THROW(e);
+      }
+      if (!(step > 0.0))
+      {
+         Exception e("Node spacing must be positive");
+         GNSSTK_THROW(e);
+      }
+   }
+
+   //---------------------------------------------------------------------------------
+   SMatrix<double,3,3> EarthRotationService::ECEFtoInertial(const EphTime& t,
+                                                            double xp,
+                                                            double yp,
+                                                            double UT1mUTC,
+                                                            bool reduced)
+   {
+      try
+      {
+         double T(EarthOrientation::coordTransTime(t));
+         Node q;
+         interpolate(T, q);
+
+         xp *= EarthOrientation::ARCSEC_TO_RAD;
+         yp *= EarthOrientation::ARCSEC_TO_RAD;
+         double theta;
+         SMatrix<double,3,3> W;
+         if (convention == IERSConvention::IERS1996)
+         {
+               // GAST, correcting reduced UT1mUTC for tides as
+               // EarthOrientation::ECEFtoInertial1996() does
+            if (reduced)
+            {
+               UT1mUTC = q.ut1r - UT1mUTC;
+            }
+            theta = EarthOrientation::GMST1996(t, UT1mUTC, false) + q.ee;
+            W = rotation3(-xp, 2) * rotation3(-yp, 1);
+         }
+         else
+         {
+            theta = EarthOrientation::EarthRotationAngle(t, UT1mUTC);
+            W = rotation3(-yp, 1) * rotation3(-xp, 2) *
+               rotation3(EarthOrientation::Sprime(T), 3);
+         }
+
+         SMatrix<double,3,3> Q;
+         for (size_t i = 0; i < 9; i++)
+         {
+            Q(i / 3, i % 3) = q.Q[i];
+         }
+         return transpose(W * rotation3(theta, 3) * Q);
+      }
+      catch (Exception& e)
+      {
+         GNSSTK_RETHROW(e);
+      }
+   }
+
+   //---------------------------------------------------------------------------------
+   SMatrix<double,3,3> EarthRotationService::ECEFtoInertial(
+      const EarthOrientation& eo,
+      const EphTime& t,
+      bool reduced)
+   {
+      if (eo.convention != convention)
+      {
+         Exception e("IERS convention of the EOPs does not match");
+         GNSSTK_THROW(e);
+      }
+      try
+      {
+         return ECEFtoInertial(t, eo.xp, eo.yp, eo.UT1mUTC, reduced);
+      }
+      catch (Exception& e)
+      {
+         GNSSTK_RETHROW(e);
+      }
+   }
+
+   //---------------------------------------------------------------------------------
+   SMatrix<double,3,3> EarthRotationService::celestialToIntermediate(
+      const EphTime& t)
+   {
+      try
+      {
+         Node q;
+         interpolate(EarthOrientation::coordTransTime(t), q);
+         SMatrix<double,3,3> Q;
+         for (size_t i = 0; i < 9; i++)
+         {
+            Q(i / 3, i % 3) = q.Q[i];
+         }
+         return Q;
+      }
+      catch (Exception& e)
+      {
+         GNSSTK_RETHROW(e);
+      }
+   }
+
+   //---------------------------------------------------------------------------------
+   EarthRotationService::Node EarthRotationService::computeNode(double T) const
+   {
+      Node rv;
+      rv.ee = rv.ut1r = 0.0;
+      Matrix<double> Q;
+      if (convention == IERSConvention::IERS1996)
+      {
+            // cf. ECEFtoInertial1996() and gast1996()
+         double eps, deps, dpsi, om, dlodR, domegaR;
+         eps = EarthOrientation::obliquity1996(T);
+         EarthOrientation::nutationAngles1996(T, deps, dpsi, om);
+         Q = EarthOrientation::nutationMatrix(eps, dpsi, deps) *
+             EarthOrientation::precessionMatrix1996(T);
+         rv.ee = dpsi * ::cos(eps) +
+                 (0.00264 * ::sin(om) + 0.000063 * ::sin(2.0 * om)) *
+                 EarthOrientation::ARCSEC_TO_RAD;
+         EarthOrientation::UT1mUTCTidalCorrections(T, rv.ut1r, dlodR,
+                                                   domegaR);
+      }
+      else if (convention == IERSConvention::IERS2003)
+      {
+            // cf. ECEFtoInertial2003()
+         double deps, dpsi, dpsipr, depspr;
+         EarthOrientation::nutationAngles2003(T, deps, dpsi);
+         EarthOrientation::precessionRateCorrections2003(T, dpsipr, depspr);
+         double eps(EarthOrientation::obliquity1996(T) + depspr);
+         Q = EarthOrientation::nutationMatrix(eps, dpsi, deps) *
+             EarthOrientation::precessionMatrix2003(T);
+      }
+      else
+      {
+            // cf. ECEFtoInertial2010()
+         double X, Y, s;
+         EarthOrientation::XYCIO(T, X, Y);
+         s = EarthOrientation::S(T, X, Y, IERSConvention::IERS2010);
+         double r2(X * X + Y * Y);
+         double e(r2 != 0.0 ? ::atan2(Y, X) : 0.0);
+         double d(::atan(::sqrt(r2 / (1.0 - r2))));
+         Q = rotation(-(e + s), 3) * rotation(d, 2) * rotation(e, 3);
+      }
+      for (size_t i = 0; i < 9; i++)
+      {
+         rv.Q[i] = Q(i / 3, i % 3);
+      }
+      return rv;
+   }
+
+   //---------------------------------------------------------------------------------
+   const EarthRotationService::Node& EarthRotationService::node(long k)
+   {
+      std::map<long, Node>::iterator it = nodes.find(k);
+      if (it == nodes.end())
+      {
+         it = nodes.insert(std::make_pair(k, computeNode(k * stepT))).first;
+      }
+      return it->second;
+   }
+
+   //---------------------------------------------------------------------------------
+   void EarthRotationService::interpolate(double T, Node& result)
+   {
+      double x(T / stepT);
+      long k(static_cast<long>(::floor(x)));
+      double u(x - k);
+      if (k != lastIndex)
+      {
+         for (int i = 0; i < 4; i++)
+         {
+            last[i] = &node(k - 1 + i);
+         }
+         lastIndex = k;
+      }
+
+         // four point Lagrange weights at u for nodes at -1, 0, 1, 2
+      double um1(u - 1.0), um2(u - 2.0), up1(u + 1.0);
+      double w[4] = { -u * um1 * um2 / 6.0,
+                      up1 * um1 * um2 / 2.0,
+                      -up1 * u * um2 / 2.0,
+                      up1 * u * um1 / 6.0 };
+
+      for (size_t j = 0; j < 9; j++)
+      {
+         result.Q[j] = w[0] * last[0]->Q[j] + w[1] * last[1]->Q[j] +
+                       w[2] * last[2]->Q[j] + w[3] * last[3]->Q[j];
+      }
+      result.ee = w[0] * last[0]->ee + w[1] * last[1]->ee +
+                  w[2] * last[2]->ee + w[3] * last[3]->ee;
+      result.ut1r = w[0] * last[0]->ut1r + w[1] * last[1]->ut1r +
+                    w[2] * last[2]->ut1r + w[3] * last[3]->ut1r;
+   }
+
+} // end namespace gnsstk
@@ -0,0 +1,206 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+
+/** @file EarthRotationService.hpp
+    Include file defining the EarthRotationService class, which computes the
+    ECEF-to-inertial rotation of class EarthOrientation by interpolating the
+    slowly varying precession and nutation on a grid of epochs.*/
+
+#ifndef CLASS_EARTHROTATIONSERVICE_INCLUDE
+#define CLASS_EARTHROTATIONSERVICE_INCLUDE
+
+//------------------------------------------------------------------------------------
+// system includes
+#include <map>
+// GNSSTk
+#include "Exception.hpp"
+#include "SMatrix.hpp"
+// geomatics
+#include "EphTime.hpp"
+#include "EarthOrientation.hpp"
+#include "IERSConvention.hpp"
+
+//------------------------------------------------------------------------------------
+namespace gnsstk
+{
+
+      /**
+       class EarthRotationService computes the same rotation as
+       EarthOrientation::ECEFtoInertial(), for many epochs, without summing the
+       precession and nutation series at each one.
+
+       The rotation is W * R3(theta) * Q, where W is polar motion (from the
+       EOPs xp and yp), theta is the Earth rotation angle (IERS2003 and 2010)
+       or GAST (IERS1996), and Q is the celestial-to-intermediate (precession,
+       nutation and frame bias) matrix. Q, along with the equation of the
+       equinoxes and the UT1 tidal correction used by IERS1996, depends only on
+       TT and changes slowly, the shortest significant nutation period being
+       several days. These are computed at nodes spaced \a step days apart in
+       TT, and cached, and interpolated with a four point Lagrange polynomial
+       at the epoch of interest. Only theta, which moves with UT1, and W are
+       computed at each call.
+
+       With the default step of 1/8 day the elements of the result differ from
+       EarthOrientation::ECEFtoInertial() by less than 1.e-12 (0.2 micro
+       arcseconds, or 30 micrometers at GPS altitude). The interpolation error
+       grows as the fourth power of the step; it is below 3.e-10 for a step of
+       half a day.
+
+       The nodes are kept until clear() is called, one per \a step over the
+       span of the epochs used. The object is not thread safe; use one per
+       thread.
+      */
+   class EarthRotationService
+   {
+   public:
+         /// Default spacing of the interpolation nodes, in days.
+      static const double defaultStep;
+
+         /**
+          Constructor.
+          @param conv IERS convention of the rotation (not Unknown).
+          @param step spacing of the interpolation nodes, in days.
+          @throw Exception if conv is Unknown or step is not positive
+         */
+      EarthRotationService(IERSConvention conv = IERSConvention::IERS2010,
+                           double step = defaultStep);
+
+         /**
+          Generate the full transformation matrix (3x3 rotation) relating the
+          ECEF frame to the conventional inertial frame; cf.
+          EarthOrientation::ECEFtoInertial().
+          @param t epoch of the rotation.
+          @param xp Earth wobble in arcseconds, as found in the IERS bulletin.
+          @param yp Earth wobble in arcseconds, as found in the IERS bulletin.
+          @param UT1mUTC UT1-UTC in seconds, as found in the IERS bulletin.
+          @param reduced true when UT1mUTC is 'reduced', meaning assumes
+                          'no tides', as is the case with the NGA EOPs
+                          (default=F); used only by IERS1996.
+          @return 3x3 rotation matrix
+          @throw Exception if the TimeSystem conversion fails (if TimeSystem is
+          Unknown)
+         */
+      SMatrix<double,3,3> ECEFtoInertial(const EphTime& t, double xp,
+                                         double yp, double UT1mUTC,
+                                         bool reduced = false);
+
+         /**
+          Generate the full transformation matrix (3x3 rotation) relating the
+          ECEF frame to the conventional inertial frame, using the EOPs in eo.
+          @param eo EarthOrientation object holding xp, yp and UT1-UTC.
+          @param t epoch of the rotation.
+          @param reduced see ECEFtoInertial() above.
+          @return 3x3 rotation matrix
+          @throw Exception if eo.convention is not that of this object, or if
+          the TimeSystem conversion fails
+         */
+      SMatrix<double,3,3> ECEFtoInertial(const EarthOrientation& eo,
+                                         const EphTime& t,
+                                         bool reduced = false);
+
+         /**
+          Interpolate the celestial-to-intermediate matrix Q (precession,
+          nutation and frame bias) at the given epoch; for IERS1996 and
+          IERS2003 this is the matrix N*P, for IERS2010 the GCRS-to-CIRS
+          matrix.
+          @param t epoch of interest.
+          @return 3x3 rotation matrix
+          @throw Exception if the TimeSystem conversion fails
+         */
+      SMatrix<double,3,3> celestialToIntermediate(const EphTime& t);
+
+         /// @return the IERS convention of this object.
+      IERSConvention getConvention() const
+      { return convention; }
+
+         /// @return the spacing of the nodes, in days.
+      double getStep() const
+      { return stepDays; }
+
+         /// @return the number of nodes computed and cached.
+      size_t size() const
+      { return nodes.size(); }
+
+         /// Discard the cached nodes.
+      void clear()
+      { nodes.clear(); lastIndex = noIndex; }
+
+   private:
+         /// The quantities computed at each node.
+      struct Node
+      {
+         double Q[9];   ///< celestial-to-intermediate matrix, row major
+         double ee;     ///< IERS1996 equation of the equinoxes, radians
+         double ut1r;   ///< IERS1996 UT1-UT1R tidal correction, seconds
+      };
+
+         /// Value of lastIndex when nothing has been interpolated.
+      static const long noIndex;
+
+         /** Compute the node at coordinate transformation time T,
+             following EarthOrientation::ECEFtoInertialXXXX(). */
+      Node computeNode(double T) const;
+
+         /// Return node k, computing it if necessary.
+      const Node& node(long k);
+
+         /** Interpolate the nodes at coordinate transformation time T.
+             @param[in] T coordTransTime of interest
+             @param[out] result interpolated node */
+      void interpolate(double T, Node& result);
+
+         /// IERS convention of the rotation
+      IERSConvention convention;
+
+         /// spacing of the nodes in days, and in centuries (units of T)
+      double stepDays, stepT;
+
+         /// cached nodes, node k is at T = k*stepT
+      std::map<long, Node> nodes;
+
+         /// the four nodes used by the last interpolation, starting at
+         /// lastIndex-1.
+      long lastIndex;
+      const Node *last[4];
+
+   }; // end class EarthRotationService
+
+} // end namespace gnsstk
+
+#endif // CLASS_EARTHROTATIONSERVICE_INCLUDE
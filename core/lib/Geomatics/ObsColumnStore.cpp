@@ -0,0 +1,178 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/** @file ObsColumnStore.cpp  Observation data stored in columns, per satellite
+    and observation type, as kept by Rinex3ObsFileLoader. */
+
+#include "ObsColumnStore.hpp"
+
+using namespace std;
+
+namespace gnsstk
+{
+   //---------------------------------------------------------------------------------
+   void ObsColumnStore::clear()
+   {
+      times.clear();
+      flags.clear();
+      clocks.clear();
+      sats.clear();
+      pending = false;
+   }
+
+   //---------------------------------------------------------------------------------
+   void ObsColumnStore::setNumTypes(size_t n)
+   {
+      if (n <= numTypes)
+      {
+         return;
+      }
+      numTypes = n;
+      for (SatMap::iterator it = sats.begin(); it != sats.end(); ++it)
+      {
+         SatColumns& cols(it->second);
+         size_t rows(cols.size());
+         cols.data.resize(n, vector<double>(rows, 0.0));
+         cols.lli.resize(n, vector<unsigned char>(rows, 0));
+         cols.ssi.resize(n, vector<unsigned char>(rows, 0));
+         cols.state.resize(n, vector<unsigned char>(rows, 0));
+      }
+   }
+
+   //---------------------------------------------------------------------------------
+   void ObsColumnStore::addEpoch(const CommonTime& tt, short flag, double clk)
+   {
+      pending      = true;
+      pendingTime  = tt;
+      pendingFlag  = flag;
+      pendingClock = clk;
+   }
+
+   //---------------------------------------------------------------------------------
+   ObsColumnStore::SatColumns& ObsColumnStore::addRow(const RinexSatID& sat)
+   {
+      if (pending)
+      {
+         times.push_back(pendingTime);
+         flags.push_back(pendingFlag);
+         clocks.push_back(pendingClock);
+         pending = false;
+      }
+
+      SatColumns& cols(sats[sat]);
+      if (cols.data.size() < numTypes)
+      {
+         size_t rows(cols.size());
+         cols.data.resize(numTypes, vector<double>(rows, 0.0));
+         cols.lli.resize(numTypes, vector<unsigned char>(rows, 0));
+         cols.ssi.resize(numTypes, vector<unsigned char>(rows, 0));
+         cols.state.resize(numTypes, vector<unsigned char>(rows, 0));
+      }
+      cols.epoch.push_back(times.size() - 1);
+      for (size_t i = 0; i < numTypes; i++)
+      {
+         cols.data[i].push_back(0.0);
+         cols.lli[i].push_back(0);
+         cols.ssi[i].push_back(0);
+         cols.state[i].push_back(0);
+      }
+      return cols;
+   }
+
+   //---------------------------------------------------------------------------------
+   void ObsColumnStore::shrink()
+   {
+      times.shrink_to_fit();
+      flags.shrink_to_fit();
+      clocks.shrink_to_fit();
+      for (SatMap::iterator it = sats.begin(); it != sats.end(); ++it)
+      {
+         SatColumns& cols(it->second);
+         cols.epoch.shrink_to_fit();
+         for (size_t i = 0; i < cols.data.size(); i++)
+         {
+            cols.data[i].shrink_to_fit();
+            cols.lli[i].shrink_to_fit();
+            cols.ssi[i].shrink_to_fit();
+            cols.state[i].shrink_to_fit();
+         }
+      }
+   }
+
+   //---------------------------------------------------------------------------------
+   void ObsColumnStore::getEpochs(vector<Rinex3ObsData>& store) const
+   {
+      store.clear();
+      store.resize(times.size());
+      for (size_t i = 0; i < times.size(); i++)
+      {
+         store[i].time        = times[i];
+         store[i].epochFlag   = flags[i];
+         store[i].clockOffset = clocks[i];
+         store[i].numSVs      = 0;
+      }
+
+      for (SatMap::const_iterator it = sats.begin(); it != sats.end(); ++it)
+      {
+         const SatColumns& cols(it->second);
+         for (size_t k = 0; k < cols.size(); k++)
+         {
+            Rinex3ObsData& rod(store[cols.epoch[k]]);
+            vector<RinexDatum>& v(rod.obs[it->first]);
+            v.resize(numTypes);
+            rod.numSVs++;
+            for (size_t i = 0; i < cols.data.size(); i++)
+            {
+               unsigned char state(cols.state[i][k]);
+               if ((state & SatColumns::Set) == 0)
+               {
+                  continue; // missing
+               }
+               RinexDatum& datum(v[i]);
+               datum.data      = cols.data[i][k];
+               datum.dataBlank = ((state & SatColumns::DataBlank) != 0);
+               datum.lli       = cols.lli[i][k];
+               datum.lliBlank  = ((state & SatColumns::LLIBlank) != 0);
+               datum.ssi       = cols.ssi[i][k];
+               datum.ssiBlank  = ((state & SatColumns::SSIBlank) != 0);
+            }
+         }
+      }
+   }
+
+} // end namespace gnsstk
@@ -0,0 +1,209 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/** @file ObsColumnStore.hpp  Observation data stored in columns, per satellite
+    and observation type, as kept by Rinex3ObsFileLoader. */
+
+#ifndef GNSSTK_OBS_COLUMN_STORE_INCLUDE
+#define GNSSTK_OBS_COLUMN_STORE_INCLUDE
+
+#include <map>
+#include <vector>
+
+#include "CommonTime.hpp"
+#include "Rinex3ObsData.hpp"
+#include "RinexDatum.hpp"
+#include "RinexSatID.hpp"
+
+namespace gnsstk
+{
+   /** @addtogroup rinexutils */
+   //@{
+
+      /**
+       Store of observation data in columns (structure of arrays). The time
+       tags of the stored epochs are kept once, and for each satellite there is
+       a column of epoch indexes and, for each observation type, columns of
+       values, LLI and SSI that are parallel to it. Compared to a vector of
+       Rinex3ObsData, with a map and a vector of RinexDatum per epoch, this
+       needs a fraction of the memory and the data for one satellite and
+       observation type can be read sequentially, in place.
+
+       Epochs are added with addEpoch(), then the data of each satellite with
+       data at that epoch with addRow() and SatColumns::set(). Blank LLI and
+       SSI are stored as zero in their columns, and the blank flags of each
+       datum, and whether it was set at all, in a parallel state column, so
+       that getEpochs() returns exactly the RinexDatum passed to set().
+      */
+   class ObsColumnStore
+   {
+   public:
+         /// The data for one satellite.
+      struct SatColumns
+      {
+            /// index in getTimes() of each row
+         std::vector<unsigned int> epoch;
+            /// observation values, [obs type][row], zero when missing
+         std::vector<std::vector<double>> data;
+            /// loss of lock indicators, [obs type][row]
+         std::vector<std::vector<unsigned char>> lli;
+            /// signal strength indicators, [obs type][row]
+         std::vector<std::vector<unsigned char>> ssi;
+            /// bits of state
+         enum StateBits
+         {
+            Set = 1,       ///< set() was called for this datum
+            DataBlank = 2, ///< RinexDatum::dataBlank
+            LLIBlank = 4,  ///< RinexDatum::lliBlank
+            SSIBlank = 8   ///< RinexDatum::ssiBlank
+         };
+            /// OR of StateBits for each datum, [obs type][row]; 0 if not set
+         std::vector<std::vector<unsigned char>> state;
+
+            /// @return the number of rows (epochs with data)
+         std::size_t size() const { return epoch.size(); }
+
+            /**
+             set the datum for one observation type in the last row
+             @param[in] type index of the observation type
+             @param[in] datum the observation
+            */
+         void set(std::size_t type, const RinexDatum& datum)
+         {
+            data[type].back() = datum.data;
+            lli[type].back()  = static_cast<unsigned char>(datum.lli);
+            ssi[type].back()  = static_cast<unsigned char>(datum.ssi);
+            state[type].back() = (Set | (datum.dataBlank ? DataBlank : 0) |
+                                  (datum.lliBlank ? LLIBlank : 0) |
+                                  (datum.ssiBlank ? SSIBlank : 0));
+         }
+      };
+
+         /// map of satellite to its columns
+      typedef std::map<RinexSatID, SatColumns> SatMap;
+
+         /// empty constructor
+      ObsColumnStore() : numTypes(0), pending(false) {}
+
+         /// remove all data; the number of obs types is kept
+      void clear();
+
+         /**
+          set the number of observation types; existing columns are extended
+          with zeros. The number may not be reduced.
+          @param[in] n number of observation types
+         */
+      void setNumTypes(std::size_t n);
+
+         /// @return the number of observation types
+      std::size_t getNumTypes() const { return numTypes; }
+
+         /**
+          start a new epoch; it is only stored once a row is added to it
+          @param[in] tt time tag of the epoch
+          @param[in] flag RINEX epoch flag
+          @param[in] clk receiver clock offset
+         */
+      void addEpoch(const CommonTime& tt, short flag, double clk);
+
+         /**
+          add a row for a satellite at the last epoch, with all observations
+          zero; fill it with SatColumns::set(). Call at most once per satellite
+          and epoch.
+          @param[in] sat the satellite
+          @return the satellite's columns
+         */
+      SatColumns& addRow(const RinexSatID& sat);
+
+         /// release unused capacity, e.g. once all the data has been added
+      void shrink();
+
+         /// @return the number of epochs stored
+      std::size_t size() const { return times.size(); }
+
+         /// @return time tags of the stored epochs
+      const std::vector<CommonTime>& getTimes() const { return times; }
+
+         /// @return RINEX epoch flags, parallel to getTimes()
+      const std::vector<short>& getEpochFlags() const { return flags; }
+
+         /// @return receiver clock offsets, parallel to getTimes()
+      const std::vector<double>& getClockOffsets() const { return clocks; }
+
+         /// @return the columns of all satellites
+      const SatMap& getSats() const { return sats; }
+
+         /**
+          get the columns of one satellite
+          @param[in] sat the satellite
+          @return pointer to the columns, or nullptr if there are none
+         */
+      const SatColumns *find(const RinexSatID& sat) const
+      {
+         SatMap::const_iterator it = sats.find(sat);
+         return (it == sats.end() ? nullptr : &it->second);
+      }
+
+         /**
+          convert to one Rinex3ObsData per epoch, as returned by
+          Rinex3ObsFileLoader::getStore(); each holds all the observation
+          types, default RinexDatum where not set.
+          @param[out] store vector of epochs, replaced
+         */
+      void getEpochs(std::vector<Rinex3ObsData>& store) const;
+
+   private:
+      std::size_t numTypes;          ///< number of observation types
+      std::vector<CommonTime> times; ///< time tags of stored epochs
+      std::vector<short> flags;      ///< epoch flags of stored epochs
+      std::vector<double> clocks;    ///< clock offsets of stored epochs
+      SatMap sats;                   ///< columns for each satellite
+
+         /// set when the last addEpoch() has not yet had a row added
+      bool pending;
+      CommonTime pendingTime; ///< time of the pending epoch
+      short pendingFlag;      ///< flag of the pending epoch
+      double pendingClock;    ///< clock offset of the pending epoch
+
+   }; // end class ObsColumnStore
+
+   //@}
+
+} // end namespace gnsstk
+
+#endif // GNSSTK_OBS_COLUMN_STORE_INCLUDE
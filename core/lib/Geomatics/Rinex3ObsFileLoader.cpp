@@ -48,9 +48,9 @@
 #include "Exception.hpp"
 #include "GPSWeekSecond.hpp"
 #include "MostCommonValue.hpp"
+#include "Rinex3ObsChunkReader.hpp"
 #include "Rinex3ObsData.hpp"
 #include "Rinex3ObsHeader.hpp"
-#include "Rinex3ObsStream.hpp"
 #include "StringUtils.hpp"
 #include "TimeString.hpp" // printTime
 
@@ -89,8 +89,8 @@ namespace gnsstk
                roh = rinex obs header */
          Rinex3ObsHeader roh;
             /* Rinex3ObsData from Rinex3ObsData class in GNSSTk
-               rod = rinex obs data, and outrod = output rinex obs data? */
-         Rinex3ObsData rod, outrod;
+               rod = rinex obs data */
+         Rinex3ObsData rod;
          vector<string>::const_iterator vit;
          map<RinexSatID, vector<int>>::iterator soit; // SatObsCountMap
          ostringstream oss, ossx;
@@ -99,6 +99,46 @@ namespace gnsstk
             // setTimeSystem sets the method for internal variable m_timeSystem
          prevtime.setTimeSystem(TimeSystem::Any);
 
+            /* the files are read through a Rinex3ObsChunkReader; with more
+               than one thread, all the files are added to it first, so that
+               each file is parsed while the previous one is processed.
+               fileIndex is the reader's index for each file, or -1 with the
+               reason in fileError */
+         Rinex3ObsChunkReader reader(readThreads);
+         vector<int> fileIndex(filenames.size(), -1);
+         vector<string> fileError(filenames.size());
+         vector<bool> fileAdded(filenames.size(), false);
+         auto addFile = [&](unsigned int nf) -> void
+         {
+            string filename(filenames[nf]);
+            StringUtils::stripLeading(filename);
+            StringUtils::stripTrailing(filename);
+            fileAdded[nf] = true;
+            if (filename.empty())
+            {
+               return;
+            }
+            try
+            {
+               fileIndex[nf] = reader.addFile(filename);
+            }
+            catch (FileMissingException& e)
+            {
+               fileError[nf] = "Error - could not open file " + filename + "\n";
+            }
+            catch (Exception& e)
+            {
+               fileError[nf] = "Error - failed to read header for file " +
+                               filename + " with exception " + e.getText(0) +
+                               "\n";
+            }
+         };
+         if (reader.getThreads() > 1)
+         {
+            for (unsigned int nf = 0; nf < filenames.size(); nf++)
+               addFile(nf);
+         }
+
             /* read the files
                initialize number read counter to zero */
          int nread(0);
@@ -126,22 +166,21 @@ namespace gnsstk
                // read one file
             for (;;)
             {
-                  /* open file ---------------------------------------------
-                     converts file name from a string to a vector of characters
-                     using c_str */
-               Rinex3ObsStream strm(filename.c_str());
-                  // if the obs stream is not successfully opened
-               if (!strm.is_open())
+                  /* open file and read header -----------------------------
+                     unless that was done before the loop */
+               if (!fileAdded[nf])
+               {
+                  addFile(nf);
+               }
+               if (fileIndex[nf] < 0)
                {
-                  oss << "Error - could not open file " << filename << endl;
+                  oss << fileError[nf];
                   break;
                }
-               strm.exceptions(fstream::failbit);
 
-                  // read header -------------------------------------------
                try
                {
-                  strm >> roh;
+                  roh = reader.getHeader(fileIndex[nf]);
 
                      /* update list of wanted obs types
                         create iterator for looping through roh.mapObsTypes
@@ -221,6 +260,11 @@ namespace gnsstk
                            soit->second.resize(j, 0); // extend with zeros
                      }
                   }
+                     // and the columns of the store
+                  if (saveData)
+                  {
+                     columns.setNumTypes(wantedObsTypes.size());
+                  }
 
                   headers.push_back(roh);
                }
@@ -228,7 +272,6 @@ namespace gnsstk
                {
                   oss << "Error - failed to read header for file " << filename
                       << " with exception " << e.getText(0) << endl;
-                  strm.close();
                   break;
                }
 
@@ -239,7 +282,11 @@ namespace gnsstk
                {
                   try
                   {
-                     strm >> rod;
+                        // EOF or error
+                     if (!reader.read(fileIndex[nf], rod))
+                     {
+                        break;
+                     }
                      rod.time.setTimeSystem(TimeSystem::Any);
                   }
                   catch (Exception& e)
@@ -249,12 +296,6 @@ namespace gnsstk
                      break;
                   }
 
-                     // EOF or error
-                  if (strm.eof() || !strm.good())
-                  {
-                     break;
-                  }
-
                      // skip aux header, etc
                   if (rod.epochFlag != 0 && rod.epochFlag != 1)
                   {
@@ -333,13 +374,13 @@ namespace gnsstk
                      break;
                   }
 
-                     // prepare output rod
-                  outrod.time        = rod.time;
-                  outrod.clockOffset = rod.clockOffset;
-                  outrod.epochFlag   = rod.epochFlag;
-                  //?? outrod.auxHeader.clear();
-                  outrod.numSVs = 0;
-                  outrod.obs.clear();
+                     /* prepare the output epoch; the store only keeps it if
+                        a row of data is added to it */
+                  if (saveData)
+                  {
+                     columns.addEpoch(rod.time, rod.epochFlag,
+                                      rod.clockOffset);
+                  }
 
                      // loop over satellites, counting data per ObsID
                   Rinex3ObsData::DataMap::const_iterator it;
@@ -365,6 +406,8 @@ namespace gnsstk
                            object roh corresponding to the GNSS system from the sat
                            ID, creating new RinexObsID vector types */
                      const vector<RinexObsID> types(roh.mapObsTypes[sys]);
+                        // this sat's columns, once it has a wanted obs
+                     ObsColumnStore::SatColumns *cols = nullptr;
 
                         // loop over obs
                      for (i = 0; i < it->second.size(); i++)
@@ -382,7 +425,7 @@ namespace gnsstk
                                                currVer); // 4-char RinexObsID
 
                            /* is it wanted? nint is the index into
-                              wantedObsTypes, SatObsCountMap and outrod.obs
+                              wantedObsTypes, SatObsCountMap and the columns
                               vectorindex returns the index of the value srot in
                               wantedObsTypes if it doesn't exist in that vector,
                               return -1 */
@@ -404,27 +447,19 @@ namespace gnsstk
                         SatObsCountMap[sat][nint]++;
                         countWantedObsTypes[nint]++;
 
-                           // add it to outrod
+                           // add it to the store
                         if (saveData)
                         {
-                              // if the satellite is not in outrod.obs
-                           if (outrod.obs.find(sat) == outrod.obs.end())
+                              // if the satellite has no row at this epoch
+                           if (cols == nullptr)
                            {
-                              vector<RinexDatum> v(wantedObsTypes.size());
-                              outrod.obs[sat] = v;
-                              outrod.numSVs++;
+                              cols = &columns.addRow(sat);
                            }
-                           outrod.obs[sat][nint] = it->second[i];
+                           cols->set(nint, it->second[i]);
                         }
                      }
                   }
 
-                     // if saving data, save
-                  if (saveData && outrod.obs.size() > 0)
-                  {
-                     datastore.push_back(outrod);
-                  }
-
                } // end loop over epochs
 
                   // time steps
@@ -432,8 +467,6 @@ namespace gnsstk
                nominalDT =
                   (dtdec > 0.0 ? (dtdec > rawdt ? dtdec : rawdt) : rawdt);
 
-               strm.close();
-
                break; // mandatory
             }         // end for(;;)
 
@@ -473,6 +506,8 @@ namespace gnsstk
             StringUtils::stripTrailing(msg, '\r');
          }
 
+         columns.shrink();
+
          return nread;
       }
       catch (Exception& e)
@@ -506,7 +541,7 @@ namespace gnsstk
           << "sec, obs types";
       for (i = 0; i < wantedObsTypes.size(); i++)
          oss << " " << wantedObsTypes[i];
-      oss << ", store size " << datastore.size();
+      oss << ", store size " << getStoreSize();
       oss << "\n";
       oss << " Time limits: begin  " << printTime(begDataTime, longfmt) << "\n"
           << "                end  " << printTime(endDataTime, longfmt) << "\n";
@@ -542,14 +577,14 @@ namespace gnsstk
          {
             return -3;
          }
-         if (datastore.size() == 0)
+         if (columns.size() == 0)
          {
             return -4;
          }
 
          char sys;
          int npass(0);
-         unsigned int i;
+         unsigned int i, k;
          unsigned short flag;
          GSatID sat;
          map<GSatID, unsigned int> indexForSat;
@@ -557,6 +592,22 @@ namespace gnsstk
          map<GSatID, unsigned int>::const_iterator satit;
             // observation iterator
          map<char, vector<string>>::const_iterator obsit;
+            // system iterator
+         map<char, vector<int>>::const_iterator jt;
+            // store iterator
+         ObsColumnStore::SatMap::const_iterator it;
+
+            // check that all systems in the store have obstypes
+         for (it = columns.getSats().begin(); it != columns.getSats().end();
+              ++it)
+         {
+            sys = it->first.systemChar();
+            if (indexLoadOT.find(sys) != indexLoadOT.end() &&
+                sysSPOT.find(sys) == sysSPOT.end())
+            {
+               return -5;
+            }
+         }
 
             // add to existing SPList
          if (SPList.size() > 0)
@@ -568,6 +619,7 @@ namespace gnsstk
             for (i = 0; i < SPList.size(); i++)
                indexForSat[SPList[i].getSat()] = i;
          }
+         const size_t oldSize(SPList.size());
 
             // for use in putting data into SatPass
             // initialize observation iterator
@@ -576,37 +628,26 @@ namespace gnsstk
          const int nobs(obsit->second.size());
          vector<double> data(nobs, 0.0);
          vector<unsigned short> ssi(nobs, 0), lli(nobs, 0);
+         const vector<CommonTime>& times(columns.getTimes());
 
-            // loop over the data store = vector<Rinex3ObsData>
-         for (unsigned int nds = 0; nds < datastore.size(); nds++)
+            /* loop over satellites in the store, reading each one's columns in
+               time order */
+         for (it = columns.getSats().begin(); it != columns.getSats().end();
+              ++it)
          {
-
-               // LOG(INFO) << "WriteSPL " <<
-               // printTime(datastore[nds].time,timefmt)
-            //<< " Nsats " << datastore[nds].obs.size();
-               // dumpStoreEpoch(LOGstrm,datastore[nds]);
-
-               // loop over satellites
-            Rinex3ObsData::DataMap::const_iterator it;
-            map<char, vector<int>>::const_iterator jt;
-            for (it = datastore[nds].obs.begin();
-                 it != datastore[nds].obs.end(); ++it)
+            sys = it->first.systemChar();
+            jt  = indexLoadOT.find(sys);
+            if (jt == indexLoadOT.end()) // skip unwanted system
             {
-               sys = it->first.systemChar();
-               jt  = indexLoadOT.find(sys);
-               if (jt == indexLoadOT.end()) // skip unwanted system
-               {
-                  continue;
-               }
-               sat = GSatID(it->first); // converts from RinexSatID
-
-                  // get obstypes for this sys
-               obsit = sysSPOT.find(sys);
-               if (obsit == sysSPOT.end()) // sysSPOT not found for system sys
-               {
-                  return -5;
-               }
+               continue;
+            }
+            sat   = GSatID(it->first); // converts from RinexSatID
+            obsit = sysSPOT.find(sys); // get obstypes for this sys
+            const ObsColumnStore::SatColumns& cols(it->second);
 
+               // loop over the rows (epochs) for this satellite
+            for (k = 0; k < cols.size(); k++)
+            {
                   // pull data out of store and put in arrays
                flag = SatPass::OK;
                for (i = 0; i < jt->second.size(); i++)
@@ -621,9 +662,9 @@ namespace gnsstk
                   }
                   else
                   {
-                     data[i] = it->second[ind].data;
-                     ssi[i]  = it->second[ind].ssi;
-                     lli[i]  = it->second[ind].lli;
+                     data[i] = cols.data[ind][k];
+                     ssi[i]  = cols.ssi[ind][k];
+                     lli[i]  = cols.lli[ind][k];
                         // NB so one bad obs makes the sat/epoch bad
                         // TD does loader keep epochs with no good data?
                      if (::fabs(data[i]) < 1.e-8)
@@ -631,13 +672,6 @@ namespace gnsstk
                         flag = SatPass::BAD;
                      }
                   }
-                  // LOG(INFO) << " ind " << ind << " SPOT " << obsit->second[i]
-                  //<< " R3OT " << (ind >= 0 ? wantedObsTypes[ind]:"NA")
-                  //<< " sat " << sat
-                  //<< " data " << fixed << setprecision(4)
-                  //<< (ind >= 0 ? it->second[ind].data : 0.0) << "/"
-                  //<< (ind >= 0 ? it->second[ind].ssi : 0) << "/"
-                  //<< (ind >= 0 ? it->second[ind].lli : 0) << " flag " << flag;
                }
 
                   // find the current SatPass for this sat
@@ -655,7 +689,7 @@ namespace gnsstk
                do
                {
                   i = SPList[satit->second].addData(
-                     datastore[nds].time, obsit->second, data, lli, ssi, flag);
+                     times[cols.epoch[k]], obsit->second, data, lli, ssi, flag);
 
                   if (i == -1)
                   { // there was a gap - break into two passes
@@ -668,9 +702,13 @@ namespace gnsstk
 
                } while (i == -1); // will iterate only once, if there is a gap
 
-            } // end loop over satellites
+            } // end loop over rows
+
+         } // end loop over satellites
 
-         } // end loop over data store
+            /* new passes were created satellite by satellite; put them in time
+               order, as when created epoch by epoch */
+         std::stable_sort(SPList.begin() + oldSize, SPList.end());
 
          return npass;
       }
@@ -749,10 +787,11 @@ namespace gnsstk
          param ostream s to which to write */
    void Rinex3ObsFileLoader::dumpStoreData(ostream& s) const
    {
-      s << "\nDump the ROFL data(" << datastore.size() << "):" << endl;
-      for (unsigned int i = 0; i < datastore.size(); i++)
+      const vector<Rinex3ObsData>& store(getStore());
+      s << "\nDump the ROFL data(" << store.size() << "):" << endl;
+      for (unsigned int i = 0; i < store.size(); i++)
       {
-         const Rinex3ObsData &rod(datastore[i]);
+         const Rinex3ObsData &rod(store[i]);
          dumpStoreEpoch(s, rod);
       }
    }
@@ -51,6 +51,7 @@
 #include "CommonTime.hpp"
 #include "Exception.hpp"
 #include "MostCommonValue.hpp"
+#include "ObsColumnStore.hpp"
 #include "Rinex3ObsData.hpp"
 #include "Rinex3ObsHeader.hpp"
 #include "stl_helpers.hpp" // vectorindex
@@ -91,6 +92,7 @@ namespace gnsstk
       std::vector<std::string> filenames; ///< input RINEX obs file names
       int nepochsToRead;                  ///< number of epochs to read (default:all)
       bool saveData;                      ///< if true save the data (F)
+      unsigned readThreads;               ///< threads parsing the files (1)
       std::string timefmt;                ///< format for time tags in output
       // editing
       double dtdec;                       ///< decimate to this time step
@@ -134,13 +136,19 @@ namespace gnsstk
       std::vector<std::string> obstypes;    ///< RINEX obs types found in data
       std::vector<Rinex3ObsHeader> headers; ///< headers from reading filenames
 
-         /// vector of all input data - filled only if saveData is true.
-      std::vector<Rinex3ObsData> datastore;
+         /// all input data, by satellite and obs type - filled only if
+         /// saveData is true.
+      ObsColumnStore columns;
+
+         /// the input data as a vector of epochs, built from columns by
+         /// getStore() when first called.
+      mutable std::vector<Rinex3ObsData> datastore;
 
          /// initialization used by the constructors
       void init()
       {
          saveData      = false;
+         readThreads   = 1;
          nepochsToRead = -1;
          timefmt       = std::string("%04Y/%02m/%02d %02H:%02M:%02S");
          reset();
@@ -193,6 +201,7 @@ namespace gnsstk
 
          obstypes.clear();
          mcv.reset();
+         columns.clear();
          datastore.clear();
          exSats.clear();
          headers.clear();
@@ -259,6 +268,16 @@ namespace gnsstk
          */
       inline void nEpochsToRead(int n) { nepochsToRead = n; }
 
+         /**
+          set the number of threads used to parse the files; with more than
+          one, RINEX 3 files are divided into chunks that are parsed in
+          parallel by a Rinex3ObsChunkReader, and the next file is parsed
+          while the end of the previous one is processed.
+          @param[in] n number of threads, 0 for the number of hardware
+          threads, 1 (default) to read each file serially
+         */
+      inline void setReadThreads(unsigned n) { readThreads = n; }
+
          /**
           set save data flag
           @param b if true, then save the data, otherwise just the headers
@@ -378,17 +397,30 @@ namespace gnsstk
           get the size of the data store
           @return size (number of epochs) in the store
          */
-      inline const int getStoreSize() const { return datastore.size(); }
+      inline const int getStoreSize() const { return columns.size(); }
 
          /**
-          access the data store
+          access the data store as a vector of epochs. This is built from the
+          columns on the first call, which copies all the data; prefer
+          getColumnStore().
           @return const ref to the datastore: vector<Rinex3ObsData>
          */
       inline const std::vector<Rinex3ObsData>& getStore() const
       {
+         if (datastore.size() != columns.size())
+         {
+            columns.getEpochs(datastore);
+         }
          return datastore;
       }
 
+         /**
+          access the data store, in columns per satellite and obs type; obs
+          type indexes are those of getWantedObsTypes().
+          @return const ref to the store
+         */
+      inline const ObsColumnStore& getColumnStore() const { return columns; }
+
       // Read the files ----------------------------------------------------
 
          /**
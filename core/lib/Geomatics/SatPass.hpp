@@ -279,6 +279,12 @@ namespace gnsstk
              it! */
       SatPass& operator=(const SatPass& right);
 
+         /// copy c'tor, built by the compiler
+      SatPass(const SatPass& right) = default;
+
+         /// move c'tor, built by the compiler; takes the data without copying it
+      SatPass(SatPass&& right) = default;
+
       // Add data to the arrays at timetag tt; calls must be made in time order.
       // Caller sets the flag to either BAD or OK later using flag().
 
@@ -197,28 +197,21 @@ namespace gnsstk
       int initializeWithBinaryFile(std::string filename)
       {
          int iret = SolarSystemEphemeris::initializeWithBinaryFile(filename);
+         defineConvention();
+         return iret;
+      }
 
-         // if not defined, set IERS convention to the default; otherwise test it.
-         if (iersconv == IERSConvention::Unknown)
-         {
-            if (EphNumber() == 403)
-            {
-               iersconv = IERSConvention::IERS1996;
-            }
-            else if (EphNumber() == 405)
-            {
-               iersconv = IERSConvention::IERS2010; // the default
-            }
-            else
-            {
-               LOG(ERROR) << "Unknown ephemeris number " << EphNumber();
-            }
-         }
-         else
-         {
-            testIERSvsEphemeris(iersconv, EphNumber());
-         }
-
+         /**
+          Overloaded function to map the ephemeris file, checking the ephemeris
+          number and the IERS convention as initializeWithBinaryFile() does.
+          Cf. SolarSystemEphemeris::initializeWithMappedFile(const std::string&
+          filename).
+          @throw Exception
+         */
+      int initializeWithMappedFile(const std::string& filename)
+      {
+         int iret = SolarSystemEphemeris::initializeWithMappedFile(filename);
+         defineConvention();
          return iret;
       }
 
@@ -487,6 +480,31 @@ namespace gnsstk
          */
       IERSConvention iersconv;
 
+         /** After loading an ephemeris file: if not defined, set the IERS
+             convention to the default for the ephemeris; otherwise test it. */
+      void defineConvention()
+      {
+         if (iersconv == IERSConvention::Unknown)
+         {
+            if (EphNumber() == 403)
+            {
+               iersconv = IERSConvention::IERS1996;
+            }
+            else if (EphNumber() == 405)
+            {
+               iersconv = IERSConvention::IERS2010; // the default
+            }
+            else
+            {
+               LOG(ERROR) << "Unknown ephemeris number " << EphNumber();
+            }
+         }
+         else
+         {
+            testIERSvsEphemeris(iersconv, EphNumber());
+         }
+      }
+
          /// Helper routine to keep the tests in one place
       void testIERSvsEphemeris(const IERSConvention conv,
                                const int ephno)
@@ -49,6 +49,12 @@
 
 //------------------------------------------------------------------------------------
 #include "SolarSystemEphemeris.hpp"
+// system
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#endif
 // GNSSTk
 #include "FormattedDouble.hpp"
 #include "StringUtils.hpp"
@@ -82,6 +88,68 @@ namespace gnsstk
       }
    };
 
+   namespace
+   {
+         /* Sum the Chebyshev series of ncomp components with N coefficients
+            each (at most maxN), starting at c, and of their derivatives, at
+            the M normalized times T; the position and velocity at T[k] go to
+            PV[6*k...]. The loops over the times are innermost, and the sums
+            for each time are formed in the same order for any M. */
+      template <int M, int maxN>
+      void chebyshevSums(const double *T, const double *c, int N, int ncomp,
+                         double vscale, double *PV)
+      {
+         int i, j, k;
+         double C[maxN][M]; // Chebyshev
+         double U[maxN][M]; // derivative
+         double P[M], V[M];
+
+            // generate the Chebyshevs
+         for (k = 0; k < M; k++)
+         {
+            C[0][k] = 1;
+            C[1][k] = T[k]; // C[2] = 2*T*T-1;
+            U[0][k] = 0;
+            U[1][k] = 1; // U[2] = 4*T;
+         }
+         for (j = 2; j < N; j++)
+         {
+            for (k = 0; k < M; k++)
+            {
+               C[j][k] = 2 * T[k] * C[j - 1][k] - C[j - 2][k];
+               U[j][k] = 2 * T[k] * U[j - 1][k] + 2 * C[j - 1][k] - U[j - 2][k];
+            }
+         }
+
+         for (i = 0; i < ncomp; i++)
+         { // loop over components
+            for (k = 0; k < M; k++)
+            {
+               P[k] = V[k] = 0.0;
+            }
+            for (j = N - 1; j > -1; j--) // POS
+            {
+               for (k = 0; k < M; k++)
+               {
+                  P[k] += c[j + i * N] * C[j][k];
+               }
+            }
+            for (j = N - 1; j > 0; j--) // j>0 b/c U[0]=0             // VEL
+            {
+               for (k = 0; k < M; k++)
+               {
+                  V[k] += c[j + i * N] * U[j][k];
+               }
+            }
+            for (k = 0; k < M; k++)
+            {
+               PV[6 * k + i]         = P[k];
+               PV[6 * k + i + ncomp] = V[k] * vscale;
+            }
+         }
+      }
+   }
+
    //---------------------------------------------------------------------------------
    void SolarSystemEphemeris::readASCIIheader(const string& filename)
    {
@@ -911,6 +979,89 @@ namespace gnsstk
       }
    }
 
+   //---------------------------------------------------------------------------------
+   int SolarSystemEphemeris::initializeWithMappedFile(const string& filename)
+   {
+      try
+      {
+            // read the header with the stream, which leaves it at the data
+         readBinaryHeader(filename);
+         if (EphemerisNumber == -1)
+         {
+            istrm.close();
+            istrm.clear();
+            return retEphN;
+         }
+         long dataStart = istrm.tellg();
+         istrm.seekg(0, ios_base::end);
+         long fileSize = istrm.tellg();
+         long recSize = Ncoeff * sizeof(double);
+         long n = (fileSize - dataStart) / recSize;
+         if (dataStart < 0 || n < 1)
+         {
+            istrm.close();
+            istrm.clear();
+            return retStrm;
+         }
+
+#ifndef _WIN32
+         int fd = ::open(filename.c_str(), O_RDONLY);
+         if (fd >= 0)
+         {
+            void *addr = mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, fd, 0);
+            ::close(fd);
+            if (addr != MAP_FAILED)
+            {
+               size_t mapSize = fileSize;
+               shared_ptr<char> mapping(static_cast<char *>(addr),
+                                        [mapSize](char *p)
+                                        { munmap(p, mapSize); });
+                  // both header records are a multiple of 8 bytes long, so
+                  // the records are aligned
+               recordStore = shared_ptr<const double>(
+                  mapping,
+                  reinterpret_cast<const double *>(mapping.get() + dataStart));
+            }
+         }
+#endif
+         if (!recordStore)
+         {
+               // no mmap; read all the records instead
+            shared_ptr<double> copy(new double[n * Ncoeff],
+                                    default_delete<double[]>());
+            istrm.seekg(dataStart, ios_base::beg);
+            readBinary((char *)copy.get(), n * recSize);
+            recordStore = copy;
+         }
+         records = recordStore.get();
+         istrm.close();
+         istrm.clear();
+
+         nRecords = n;
+         current  = records;
+         fileposMap.clear();
+         EphemerisNumber = int(constants["DENUM"]);
+         LOG(DEBUG) << "initializeWithMappedFile maps " << nRecords
+                    << " records, sets EphemerisNumber " << EphemerisNumber;
+
+         return 0;
+      }
+      catch (Exception& e)
+      {
+         GNSSTK_RETHROW(e);
+      }
+      catch (exception& e)
+      {
+         Exception E("std except: " + string(e.what()));
+         GNSSTK_THROW(E);
+      }
+      catch (...)
+      {
+         Exception e("Unknown exception");
+         GNSSTK_THROW(e);
+      }
+   }
+
    //---------------------------------------------------------------------------------
       // get an inertial position of one body relative to another.
    void SolarSystemEphemeris::relativeInertialPositionVelocity(
@@ -919,179 +1070,253 @@ namespace gnsstk
    {
       try
       {
-         int iret, i;
-
-            // initialize
-         for (i = 0; i < 6; i++)
-            pv[i] = 0.0;
-
             // trivial; return
          if (target == center)
          {
+            for (int i = 0; i < 6; i++)
+               pv[i] = 0.0;
             return;
          }
 
             // get the right record from the file
-         double JD(MJD + MJD_TO_JD);
-         iret = seekToJD(JD);
-            /* -1 out of range : input time is before the first time in file
-               -2 out of range : input time is after the last time in file, or in gap
-               -3 stream is not open or not good, or EOF was found prematurely
-               -4 EphemerisNumber is not defined */
-         if (iret)
-         {
-            if (iret == retEarly || iret == retLate)
-            {
-               Exception e(string("Requested time is ") +
-                           (iret == retEarly ? string("before") : string("after")) +
-                           string(" the range spanned by the ephemeris."));
-               GNSSTK_THROW(e);
-            }
-            else if (iret == retStrm)
-            {
-               Exception e(string("Stream error on ephemeris binary file"));
-               GNSSTK_THROW(e);
-            }
-            else if (iret == retEphN)
+         seekOrThrow(MJD);
+         relativeState(&MJD, 1, target, center, pv, kilometers);
+      }
+      catch (Exception& e)
+      {
+         GNSSTK_RETHROW(e);
+      }
+      catch (exception& e)
+      {
+         Exception E("std except: " + string(e.what()));
+         GNSSTK_THROW(E);
+      }
+      catch (...)
+      {
+         Exception e("Unknown exception");
+         GNSSTK_THROW(e);
+      }
+   }
+
+   //---------------------------------------------------------------------------------
+      // get inertial positions of several bodies at many times.
+   void SolarSystemEphemeris::relativeInertialPositionVelocity(
+               const vector<double>& MJD,
+               const vector<SolarSystemEphemeris::Planet>& targets,
+               SolarSystemEphemeris::Planet center, vector<double>& pv,
+               bool kilometers)
+   {
+      try
+      {
+         size_t nt = targets.size(), nm = MJD.size();
+         pv.resize(6 * nt * nm);
+         size_t i = 0;
+         while (i < nm)
+         {
+               /* find the record of MJD[i], and the run of (at most
+                  stateBlock) times after it in the same record, for which
+                  seekToJD() would not change the record */
+            seekOrThrow(MJD[i]);
+            const double *coef = currentRecord();
+            size_t n = 1;
+            while (n < stateBlock && i + n < nm &&
+                   coef[0] <= MJD[i + n] + MJD_TO_JD &&
+                   MJD[i + n] + MJD_TO_JD <= coef[1])
             {
-               Exception e(string("Ephemeris not initialized"));
-               GNSSTK_THROW(e);
+               n++;
             }
-            else
+            for (size_t j = 0; j < nt; j++)
             {
-               Exception e(string("Unknown error on ephemeris binary file"));
-               GNSSTK_THROW(e);
+               relativeState(&MJD[i], n, targets[j], center,
+                             &pv[6 * (j * nm + i)], kilometers);
             }
+            i += n;
          }
+      }
+      catch (Exception& e)
+      {
+         GNSSTK_RETHROW(e);
+      }
+      catch (exception& e)
+      {
+         Exception E("std except: " + string(e.what()));
+         GNSSTK_THROW(E);
+      }
+      catch (...)
+      {
+         Exception e("Unknown exception");
+         GNSSTK_THROW(e);
+      }
+   }
 
-            // compute Nutations or Librations
-         if (target == idNutations || target == idLibrations)
-         {
-            inertialPositionVelocity(
-               MJD, target == idNutations ? NUTATIONS : LIBRATIONS, pv);
-            return;
-         }
-
-            // define computeID's for target and center
-         computeID TARGET, CENTER;
-
-         if (target <= idSun)
-         {
-            TARGET = computeID(target - 1);
-         }
-         else if (target == idSolarSystemBarycenter)
-         {
-            TARGET = NONE;
-         }
-         else if (target == idEarthMoonBarycenter)
-         {
-            TARGET = EMBARY;
+   //---------------------------------------------------------------------------------
+      // private
+   void SolarSystemEphemeris::seekOrThrow(double MJD)
+   {
+      int iret = seekToJD(MJD + MJD_TO_JD);
+         /* -1 out of range : input time is before the first time in file
+            -2 out of range : input time is after the last time in file, or in gap
+            -3 stream is not open or not good, or EOF was found prematurely
+            -4 EphemerisNumber is not defined */
+      if (iret)
+      {
+         if (iret == retEarly || iret == retLate)
+         {
+            Exception e(string("Requested time is ") +
+                        (iret == retEarly ? string("before") : string("after")) +
+                        string(" the range spanned by the ephemeris."));
+            GNSSTK_THROW(e);
          }
-            // (Nutations and Librations are done above)
-         if (center <= idSun)
+         else if (iret == retStrm)
          {
-            CENTER = computeID(center - 1);
+            Exception e(string("Stream error on ephemeris binary file"));
+            GNSSTK_THROW(e);
          }
-         else if (center == idSolarSystemBarycenter)
+         else if (iret == retEphN)
          {
-            CENTER = NONE;
+            Exception e(string("Ephemeris not initialized"));
+            GNSSTK_THROW(e);
          }
-         else if (center == idEarthMoonBarycenter)
+         else
          {
-            CENTER = EMBARY;
+            Exception e(string("Unknown error on ephemeris binary file"));
+            GNSSTK_THROW(e);
          }
+      }
+   }
 
-            /* Earth and Moon need special treatment - get moon and Earth-moon
-               barycenter */
-         double pvmoon[6], pvembary[6], Eratio, Mratio;
+   //---------------------------------------------------------------------------------
+      // private
+   void SolarSystemEphemeris::relativeState(
+               const double *MJD, size_t n, SolarSystemEphemeris::Planet target,
+               SolarSystemEphemeris::Planet center, double *pv, bool kilometers)
+   {
+      size_t i, n6 = 6 * n;
 
-            // special cases of Earth AND Moon: Moon result is always geocentric
-         if (target == idEarth && center == idMoon)
-         {
-            TARGET = NONE;
-         }
-         if (center == idEarth && target == idMoon)
-         {
-            CENTER = NONE;
-         }
+         // initialize
+      for (i = 0; i < n6; i++)
+         pv[i] = 0.0;
 
-            // special cases of Earth OR Moon, but not both:
-         if ((target == idEarth && center != idMoon) ||
-             (center == idEarth && target != idMoon))
-         {
-            Eratio = 1.0 / (1.0 + constants["EMRAT"]);
-            inertialPositionVelocity(MJD, MOON, pvmoon);
-         }
-         if ((target == idMoon && center != idEarth) ||
-             (center == idMoon && target != idEarth))
-         {
-            Mratio = constants["EMRAT"] / (1.0 + constants["EMRAT"]);
-            inertialPositionVelocity(MJD, EMBARY, pvembary);
-         }
+         // trivial; return
+      if (target == center)
+      {
+         return;
+      }
 
-            // compute states for target and center
-         double pvtarget[6], pvcenter[6];
-         inertialPositionVelocity(MJD, TARGET, pvtarget);
-         inertialPositionVelocity(MJD, CENTER, pvcenter);
+         // compute Nutations or Librations
+      if (target == idNutations || target == idLibrations)
+      {
+         inertialPositionVelocity(
+            MJD, n, target == idNutations ? NUTATIONS : LIBRATIONS, pv);
+         return;
+      }
 
-            /* handle the Earth/Moon special cases
-               convert from E-M barycenter to Earth */
-         if (target == idEarth && center != idMoon)
-         {
-            for (i = 0; i < 6; i++)
-            {
-               pvtarget[i] -= pvmoon[i] * Eratio;
-            }
-         }
-         if (center == idEarth && target != idMoon)
-         {
-            for (i = 0; i < 6; i++)
-            {
-               pvcenter[i] -= pvmoon[i] * Eratio;
-            }
-         }
+         // define computeID's for target and center
+      computeID TARGET = NONE, CENTER = NONE;
 
-         if (target == idMoon && center != idEarth)
-         {
-            for (i = 0; i < 6; i++)
-            {
-               pvtarget[i] = pvembary[i] + pvtarget[i] * Mratio;
-            }
-         }
-         if (center == idMoon && target != idEarth)
+      if (target <= idSun)
+      {
+         TARGET = computeID(target - 1);
+      }
+      else if (target == idSolarSystemBarycenter)
+      {
+         TARGET = NONE;
+      }
+      else if (target == idEarthMoonBarycenter)
+      {
+         TARGET = EMBARY;
+      }
+         // (Nutations and Librations are done above)
+      if (center <= idSun)
+      {
+         CENTER = computeID(center - 1);
+      }
+      else if (center == idSolarSystemBarycenter)
+      {
+         CENTER = NONE;
+      }
+      else if (center == idEarthMoonBarycenter)
+      {
+         CENTER = EMBARY;
+      }
+
+         /* Earth and Moon need special treatment - get moon and Earth-moon
+            barycenter; states for all n times of each body are in stateWork */
+      stateWork.resize(4 * n6);
+      double *pvmoon = &stateWork[0], *pvembary = pvmoon + n6;
+      double *pvtarget = pvembary + n6, *pvcenter = pvtarget + n6;
+      double Eratio = 0.0, Mratio = 0.0;
+
+         // special cases of Earth AND Moon: Moon result is always geocentric
+      if (target == idEarth && center == idMoon)
+      {
+         TARGET = NONE;
+      }
+      if (center == idEarth && target == idMoon)
+      {
+         CENTER = NONE;
+      }
+
+         // special cases of Earth OR Moon, but not both:
+      if ((target == idEarth && center != idMoon) ||
+          (center == idEarth && target != idMoon))
+      {
+         Eratio = 1.0 / (1.0 + emRatio);
+         inertialPositionVelocity(MJD, n, MOON, pvmoon);
+      }
+      if ((target == idMoon && center != idEarth) ||
+          (center == idMoon && target != idEarth))
+      {
+         Mratio = emRatio / (1.0 + emRatio);
+         inertialPositionVelocity(MJD, n, EMBARY, pvembary);
+      }
+
+         // compute states for target and center
+      inertialPositionVelocity(MJD, n, TARGET, pvtarget);
+      inertialPositionVelocity(MJD, n, CENTER, pvcenter);
+
+         /* handle the Earth/Moon special cases
+            convert from E-M barycenter to Earth */
+      if (target == idEarth && center != idMoon)
+      {
+         for (i = 0; i < n6; i++)
          {
-            for (i = 0; i < 6; i++)
-            {
-               pvcenter[i] = pvembary[i] + pvcenter[i] * Mratio;
-            }
+            pvtarget[i] -= pvmoon[i] * Eratio;
          }
-
-            // final relative result
-         for (i = 0; i < 6; i++)
+      }
+      if (center == idEarth && target != idMoon)
+      {
+         for (i = 0; i < n6; i++)
          {
-            pv[i] = pvtarget[i] - pvcenter[i];
+            pvcenter[i] -= pvmoon[i] * Eratio;
          }
+      }
 
-         if (!kilometers)
+      if (target == idMoon && center != idEarth)
+      {
+         for (i = 0; i < n6; i++)
          {
-            double AU = constants["AU"];
-            for (i = 0; i < 6; i++)
-               pv[i] /= AU;
+            pvtarget[i] = pvembary[i] + pvtarget[i] * Mratio;
          }
       }
-      catch (Exception& e)
+      if (center == idMoon && target != idEarth)
       {
-         GNSSTK_RETHROW(e);
+         for (i = 0; i < n6; i++)
+         {
+            pvcenter[i] = pvembary[i] + pvcenter[i] * Mratio;
+         }
       }
-      catch (exception& e)
+
+         // final relative result
+      for (i = 0; i < n6; i++)
       {
-         Exception E("std except: " + string(e.what()));
-         GNSSTK_THROW(E);
+         pv[i] = pvtarget[i] - pvcenter[i];
       }
-      catch (...)
+
+      if (!kilometers)
       {
-         Exception e("Unknown exception");
-         GNSSTK_THROW(e);
+         for (i = 0; i < n6; i++)
+            pv[i] /= kmPerAU;
       }
    }
 
@@ -1166,6 +1391,9 @@ namespace gnsstk
          double AU, EMRAT;
          string word;
 
+            // forget any mapped file
+         unmapFile();
+
             // open the input binary file
          istrm.open(filename.c_str(), ios::in | ios::binary);
          if (!istrm.is_open())
@@ -1288,6 +1516,8 @@ namespace gnsstk
                           << d;
             }
          }
+         emRatio = constants["EMRAT"];
+         kmPerAU = constants["AU"];
             // pad
          LOG(DEBUG) << "Pad length 2 = " << (400 - Nconst) * sizeof(double);
          for (i = 0; i < (400 - Nconst) * sizeof(double); i++)
@@ -1490,6 +1720,10 @@ namespace gnsstk
    {
       try
       {
+         if (records != nullptr)
+         {
+            return seekMappedJD(JD);
+         }
          if (!istrm)
          {
             return retStrm;
@@ -1558,84 +1792,151 @@ namespace gnsstk
       }
    }
 
+   //---------------------------------------------------------------------------------
+      /* private
+         return 0 ok, or
+         -1 out of range : input time is before the first time in file
+         -2 out of range : input time is after the last time in file, or in a gap */
+   int SolarSystemEphemeris::seekMappedJD(double JD)
+   {
+      if (current[0] <= JD && JD <= current[1])
+      {
+         return 0;
+      }
+      if (!(JD >= records[0]))
+      {
+         return retEarly; // failure: JD is before the first record
+      }
+
+         /* records are normally contiguous and of equal length, so compute the
+            index; if that is wrong, search for the last record that begins at or
+            before JD, as seekToJD() does */
+      long k = static_cast<long>((JD - records[0]) / (records[1] - records[0]));
+      if (k >= nRecords)
+      {
+         k = nRecords - 1;
+      }
+      const double *rec = records + k * Ncoeff;
+      if (rec[0] > JD || (k + 1 < nRecords && rec[Ncoeff] <= JD))
+      {
+         long lo = 0, hi = nRecords;
+         while (hi - lo > 1)
+         {
+            long mid = (lo + hi) / 2;
+            if (records[mid * Ncoeff] <= JD)
+            {
+               lo = mid;
+            }
+            else
+            {
+               hi = mid;
+            }
+         }
+         rec = records + lo * Ncoeff;
+      }
+      current = rec;
+
+      if (JD > rec[1])
+      {
+         return retLate; // failure: JD is after the last record, or in a gap
+      }
+      return 0;
+   }
+
    //---------------------------------------------------------------------------------
       // private
    void SolarSystemEphemeris::inertialPositionVelocity(
-      double MJD, SolarSystemEphemeris::computeID which, double PV[6])
+      const double *MJD, size_t n, SolarSystemEphemeris::computeID which,
+      double *PV)
    {
       try
       {
-         int i, j, i0, ncomp, offset;
+         int i0, ncomp, nsets, set;
+         size_t k, k0, m;
 
-         for (i = 0; i < 6; i++)
+         for (k = 0; k < 6 * n; k++)
          {
-            PV[i] = 0.0;
+            PV[k] = 0.0;
          }
          if (which == NONE)
          {
             return;
          }
 
-            /* coefficients[0,1] give span of JD's in which coefficients[2,...] are
-               applicable coefficients[0,1] are even days JDs - 2452xxx.5 =>
+            /* coef[0,1] give span of JD's in which coef[2,...] are applicable
+               coef[0,1] are even days JDs - 2452xxx.5 =>
                secOfDay() for these == 0. */
-         double T, Tbeg, Tspan, Tspan0;
-         Tbeg   = coefficients[0];
-         Tspan0 = Tspan = coefficients[1] - coefficients[0];
+         const double *coef = currentRecord();
+         double Tbeg, Tspan, Tspan0;
+         Tspan0 = Tspan = coef[1] - coef[0];
          i0    = c_offset[which] - 1; // index of first coefficient in array
          ncomp = (which == NUTATIONS ? 2 : 3); // number of components returned
-
-            // if more than one set, find the right set
-         if (c_nsets[which] > 1)
+         nsets = c_nsets[which];
+         if (nsets > 1)
          {
-            Tspan /= double(c_nsets[which]);
-            for (j = c_nsets[which]; j > 0; j--)
+            Tspan /= double(nsets);
+         }
+         int N = c_ncoeff[which];
+         if (N < 2 || N > maxChebyshev)
+         {
+            Exception e("Unsupported number of Chebyshev coefficients " +
+                        asString(N));
+            GNSSTK_THROW(e);
+         }
+            // to convert velocity to 'per day'
+         double vscale(2 * double(nsets) / Tspan0);
+            // if more than one set, the set that contains time mjd
+         auto findSet = [&](double mjd) -> int
+         {
+            for (int js = nsets; js > 1; js--)
             {
-               Tbeg = coefficients[0] + double(j - 1) * Tspan;
-               if (MJD > Tbeg - MJD_TO_JD)
-               { // == with j==1 is the default
-                  i0 += (j - 1) * ncomp * c_ncoeff[which];
-                  break;
+               if (mjd > coef[0] + double(js - 1) * Tspan - MJD_TO_JD)
+               { // == with js==1 is the default
+                  return js - 1;
                }
             }
-         }
-
-            // normalized time
-         T = 2.0 * (MJD - (Tbeg - MJD_TO_JD)) / Tspan - 1.0;
+            return 0;
+         };
 
-            // interpolate
-         int N = c_ncoeff[which];
-         vector<double> C(N, 0.0); // Chebyshev
-         vector<double> U(N, 0.0); // derivative of Chebyshev
-         for (i = 0; i < ncomp; i++)
-         { // loop over components
+            /* normalized times T of a block of up to chebyshevBlock times
+               that use the same set of coefficients */
+         double T[chebyshevBlock];
 
-               // seed the Chebyshev recursions
-            C[0] = 1;
-            C[1] = T; // C[2] = 2*T*T-1;
-            U[0] = 0;
-            U[1] = 1; // U[2] = 4*T;
+         for (k0 = 0; k0 < n; k0 += m)
+         {
+               // if more than one set, find the right set
+            set  = findSet(MJD[k0]);
+            Tbeg = coef[0] + double(set) * Tspan;
+               // and the times after MJD[k0] that use the same set
+            for (m = 1; m < chebyshevBlock && k0 + m < n; m++)
+            {
+               if (findSet(MJD[k0 + m]) != set)
+               {
+                  break;
+               }
+            }
 
-               // generate the Chebyshevs
-            for (j = 2; j < N; j++)
+               // normalized time
+            for (k = 0; k < m; k++)
             {
-               C[j] = 2 * T * C[j - 1] - C[j - 2];
-               U[j] = 2 * T * U[j - 1] + 2 * C[j - 1] - U[j - 2];
+               T[k] = 2.0 * (MJD[k0 + k] - (Tbeg - MJD_TO_JD)) / Tspan - 1.0;
             }
 
-               // compute P and V
-               // done above PV[i] = PV[i+3] = 0.0;
-            for (j = N - 1; j > -1; j--) // POS
+               // interpolate; a full block at once, otherwise one at a time
+            const double *c = coef + i0 + set * ncomp * N;
+            if (m == chebyshevBlock)
             {
-               PV[i] += coefficients[i0 + j + i * N] * C[j];
+               chebyshevSums<chebyshevBlock, maxChebyshev>(T, c, N, ncomp,
+                                                           vscale, &PV[6 * k0]);
             }
-            for (j = N - 1; j > 0; j--) // j>0 b/c U[0]=0             // VEL
+            else
             {
-               PV[i + ncomp] += coefficients[i0 + j + i * N] * U[j];
+               for (k = 0; k < m; k++)
+               {
+                  chebyshevSums<1, maxChebyshev>(&T[k], c, N, ncomp, vscale,
+                                                 &PV[6 * (k0 + k)]);
+               }
             }
-
-               // convert velocity to 'per day'
-            PV[i + ncomp] *= 2 * double(c_nsets[which]) / Tspan0;
          }
       }
       catch (Exception& e)
@@ -1654,5 +1955,15 @@ namespace gnsstk
       }
    }
 
+   //---------------------------------------------------------------------------------
+      // private
+   void SolarSystemEphemeris::unmapFile()
+   {
+      recordStore.reset();
+      records  = nullptr;
+      nRecords = 0;
+      current  = nullptr;
+   }
+
    //---------------------------------------------------------------------------------
 } // end namespace gnsstk
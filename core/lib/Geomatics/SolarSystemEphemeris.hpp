@@ -56,6 +56,7 @@
 #include <fstream>
 #include <iostream>
 #include <map>
+#include <memory>
 #include <string>
 #include <vector>
 // GNSSTk
@@ -92,6 +93,12 @@ namespace gnsstk
        binary file, then calling relativeInertialPositionVelocity() any number
        of times, passing it the time and Planet of interest. Time for this class
        is always Barycentric Dynamic Time (TDB), always as MJD.
+
+       Alternatively call initializeWithMappedFile(file), which maps the binary
+       file into memory rather than reading it; only the header is read, and
+       records are located directly from the time. When positions are needed at
+       many times, as over a long arc, pass all the times and bodies to the
+       vector form of relativeInertialPositionVelocity().
       */
    class SolarSystemEphemeris
    {
@@ -133,7 +140,10 @@ namespace gnsstk
           Constructor. Set EphemerisNumber to -1 to indicate that nothing has
           been read yet.
          */
-      SolarSystemEphemeris() : EphemerisNumber(-1){};
+      SolarSystemEphemeris()
+            : EphemerisNumber(-1), records(nullptr), nRecords(0),
+              current(nullptr), emRatio(0.0), kmPerAU(0.0)
+      {}
 
       //------------------------------------------------------------------
       // reading and writing ASCII (JPL) files
@@ -240,6 +250,25 @@ namespace gnsstk
          */
       int initializeWithBinaryFile(const std::string& filename);
 
+         /**
+          Map the given binary file into memory, read-only, read the header and
+          prepare for computing positions and velocities with
+          relativeInertialPositionVelocity(). The data records are not read;
+          each is found directly from the time and paged in by the operating
+          system when first used, so this takes the same time whatever the
+          size of the file. On systems without mmap the data records are read
+          into memory instead. Unlike initializeWithBinaryFile(), gaps between
+          records are not looked for here; a time in a gap is reported as after
+          the end of the data.
+          @param filename  name of binary file to be mapped.
+          @return 0 success,
+                 -3 the file holds no complete data record
+                 -4 header could not be read.
+          @throw Exception if the file cannot be opened or mapped, or if a read
+          error or premature EOF is found in the header.
+         */
+      int initializeWithMappedFile(const std::string& filename);
+
       //------------------------------------------------------------------
       // utilizing the ephemeris
 
@@ -280,6 +309,30 @@ namespace gnsstk
                                             Planet center, double PV[6],
                                             bool kilometers = true);
 
+         /**
+          Compute inertial frame position and velocity of several 'target'
+          bodies, relative to the 'center' body, at many times; the result for
+          each time and target is that of the form above. The times are taken
+          in runs that lie in one record, which is located once, and the
+          Chebyshev series for each body are summed for many times of a run at
+          once; so times in order, as along an arc, are fastest.
+          @param  MJD     times (Modified Julian Date) of interest, in TDB.
+          @param  targets bodies for which position and velocity are computed.
+          @param  center  body relative to which the results apply; cf. above.
+          @param  PV      output, resized to 6*targets.size()*MJD.size(); the
+              six components for targets[j] at MJD[i] begin at
+              PV[6*(j*MJD.size()+i)], ordered and with units as above.
+          @param  kilometers  boolean: if true (default), units are km, km/day;
+              else AU, AU/day.
+          @throw Exception as the form above, for the first time at which it
+          fails.
+         */
+      void relativeInertialPositionVelocity(const std::vector<double>& MJD,
+                                            const std::vector<Planet>& targets,
+                                            Planet center,
+                                            std::vector<double>& PV,
+                                            bool kilometers = true);
+
          /**
           Return the value of 1 AU (Astronomical Unit) in km. If the file header
           has not been read, return -1.0.
@@ -402,6 +455,42 @@ namespace gnsstk
          */
       int seekToJD(double JD);
 
+         /**
+          Find the record in the mapped file whose time limits include the
+          given time, and make it current; cf. seekToJD().
+          @param JD the time (Julian Date) of interest
+          @return 0 success, or
+                 -1 given time is before the first record in the file,
+                 -2 given time is after the last record, or in a gap between
+                 records.
+         */
+      int seekMappedJD(double JD);
+
+         /**
+          Call seekToJD() for the given time, and throw if it fails.
+          @param MJD time (Modified Julian Date) of interest, in TDB.
+          @throw Exception if seekToJD() does not return 0.
+         */
+      void seekOrThrow(double MJD);
+
+         /**
+          Compute the state of target relative to center at n times, using the
+          current record; cf. relativeInertialPositionVelocity(). NB caller
+          MUST call seekToJD(time) BEFORE calling this, and all n times must lie
+          in the current record.
+          @param  PV  array of 6*n doubles, six for each time.
+         */
+      void relativeState(const double *MJD, size_t n, Planet target,
+                         Planet center, double *PV, bool kilometers);
+
+         /// @return the current record of coefficients.
+      const double *currentRecord() const
+      { return (records != nullptr ? current : &coefficients[0]); }
+
+         /// Forget the records of initializeWithMappedFile(), if any,
+         /// and unmap the file.
+      void unmapFile();
+
       //------------------------------------------------------------------
       // define here for use in next function
          /**
@@ -430,21 +519,28 @@ namespace gnsstk
       };
 
          /**
-          Compute inertial position and velocity of given body at given time,
+          Compute inertial position and velocity of given body at n times,
           relative to the solar system barycenter, using the current coefficient
-          array. NB caller MUST call seekToJD(time) BEFORE calling this. On
-          successful return, PV[0-2] contains the three position components, in
-          km, and PV[3-5] the velocity components in km/day (for regular
-          bodies), relative to the solar system barycenter, except for the moon,
-          which is relative to Earth. For nutations and librations the units are
-          radians and radians/day; nutations (components 0-3 only) are longitude
-          and obliquity, and librations are the three euler angles.
-          @param  MJD    time (Modified Julian Date) of interest (system TDB).
+          array. NB caller MUST call seekToJD(time) BEFORE calling this, and all
+          n times must lie in the current record. On successful return, PV[0-2]
+          contains the three position components, in km, and PV[3-5] the
+          velocity components in km/day (for regular bodies), relative to the
+          solar system barycenter, except for the moon, which is relative to
+          Earth. For nutations and librations the units are radians and
+          radians/day; nutations (components 0-3 only) are longitude and
+          obliquity, and librations are the three euler angles. The Chebyshev
+          series are summed for blocks of times at once, in loops over the times
+          that the compiler can vectorize; each sum is made in the same order
+          as for a single time, so the results do not depend on n.
+          @param  MJD    n times (Modified Julian Date) of interest (system TDB).
+          @param  n      number of times.
           @param  which  computeID of the body of interest.
-          @param  PV     double(6) array containing the inertial position and
-                           velocity relative to the solar system barycenter.
+          @param  PV     array of 6*n doubles, six for each time, containing the
+                           inertial position and velocity relative to the solar
+                           system barycenter.
          */
-      void inertialPositionVelocity(double MJD, computeID which, double PV[6]);
+      void inertialPositionVelocity(const double *MJD, size_t n,
+                                    computeID which, double *PV);
 
       //------------------------------------------------------------------
       // member data
@@ -533,6 +629,43 @@ namespace gnsstk
          */
       std::vector<double> coefficients;
 
+         /// The largest number of Chebyshev coefficients per component
+         /// handled by inertialPositionVelocity().
+      static const int maxChebyshev = 32;
+
+         /// The number of times for which inertialPositionVelocity() sums
+         /// the Chebyshev series at once.
+      static const int chebyshevBlock = 16;
+
+         /// The largest number of times the vector form of
+         /// relativeInertialPositionVelocity() passes to relativeState() at
+         /// once, which keeps stateWork small enough to stay in cache.
+      static const int stateBlock = 256;
+
+         /// Working storage for relativeState().
+      std::vector<double> stateWork;
+
+         /** Owner of the data records of initializeWithMappedFile(), in the
+             mapped file or, where it could not be mapped, in memory; the file
+             is unmapped when this is reset or destroyed. */
+      std::shared_ptr<const double> recordStore;
+
+         /** The first of nRecords consecutive data records, of Ncoeff doubles
+             each, in recordStore when initialized with
+             initializeWithMappedFile(); otherwise null, and the current record
+             is in coefficients. */
+      const double *records;
+
+         /// The number of data records at records.
+      long nRecords;
+
+         /// The current record, when records is not null.
+      const double *current;
+
+         /// constants["EMRAT"] and constants["AU"], saved by readBinaryHeader()
+         /// for relativeState().
+      double emRatio, kmPerAU;
+
    }; // end class SolarSystemEphemeris
 
 } // end namespace gnsstk
@@ -93,6 +93,14 @@ namespace gnsstk
       Matrix(size_t rows, size_t cols, T initialValue);
          /// copies out the contents of vec to initialize the matrix
       Matrix(size_t rows, size_t cols, const T* vec);
+         /// copy constructor
+      Matrix(const Matrix& mat)
+            : v(mat.v), r(mat.r), c(mat.c), s(mat.s)
+      {}
+         /// move constructor, leaving mat empty
+      Matrix(Matrix&& mat) noexcept
+            : v(std::move(mat.v)), r(mat.r), c(mat.c), s(mat.s)
+      { mat.r = mat.c = mat.s = 0; }
          /// copies out the contents of vec to initialize the matrix
       template <class BaseClass>
       Matrix(size_t rows, size_t cols, const ConstVectorBase<T, BaseClass>& vec)
@@ -219,6 +227,15 @@ namespace gnsstk
          /// Copies the other matrix.
       inline Matrix& operator=(const Matrix& mat)
       { v = mat.v; r = mat.r; c = mat.c; s = mat.s; return *this; }
+         /// Takes the contents of the other matrix.
+      inline Matrix& operator=(Matrix&& mat) noexcept
+      {
+         v = std::move(mat.v);
+         std::swap(r, mat.r);
+         std::swap(c, mat.c);
+         std::swap(s, mat.s);
+         return *this;
+      }
          /// Copies from any matrix.
       template <class BaseClass>
       inline Matrix& operator=(const ConstMatrixBase<T, BaseClass>& mat)
@@ -0,0 +1,197 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/**
+ * @file MatrixKernels.hpp
+ * Multiplication and transpose kernels on contiguous column major
+ * storage, as used by Matrix<T> and Vector<T>.
+ */
+
+#ifndef GNSSTK_MATRIX_KERNELS_HPP
+#define GNSSTK_MATRIX_KERNELS_HPP
+
+#include <cstddef>
+
+namespace gnsstk
+{
+      /// @ingroup MathGroup
+      //@{
+
+      /**
+       * Kernels for the Matrix<T> and Vector<T> operators, working
+       * on pointers to the column major storage of Matrix<T>.
+       *
+       * The loops are ordered so that the innermost one runs down
+       * contiguous columns, which the compiler can vectorize, and
+       * large products are done in blocks that stay in cache.  Each
+       * element of a result is still accumulated in the same order as
+       * the element-by-element operators do, so the results are
+       * identical to theirs.
+       */
+   namespace MatrixKernels
+   {
+         /// Number of rows of a product done in one block.
+      const std::size_t rowBlock = 128;
+         /// Number of terms of a product done in one block.
+      const std::size_t innerBlock = 128;
+         /// Size of the square tiles in which a transpose is done.
+      const std::size_t tileSize = 32;
+
+         /**
+          * c += a * b, where a is m by p, b is p by n and c is m by n.
+          * @param[in] m rows of a and c.
+          * @param[in] n columns of b and c.
+          * @param[in] p columns of a and rows of b.
+          * @param[in] a the left operand.
+          * @param[in] b the right operand.
+          * @param[in,out] c the result, which must not overlap a or b.
+          */
+      template <class T>
+      void multiply(std::size_t m, std::size_t n, std::size_t p,
+                    const T* a, const T* b, T* c)
+      {
+         for (std::size_t kk = 0; kk < p; kk += innerBlock)
+         {
+            std::size_t kend = (kk + innerBlock < p ? kk + innerBlock : p);
+            for (std::size_t ii = 0; ii < m; ii += rowBlock)
+            {
+               std::size_t iend = (ii + rowBlock < m ? ii + rowBlock : m);
+               for (std::size_t j = 0; j < n; j++)
+               {
+                  T *cj = c + j*m;
+                  const T *bj = b + j*p;
+                  std::size_t k = kk;
+                     // four terms at a time, added in order
+                  for (; k + 4 <= kend; k += 4)
+                  {
+                     const T *a0 = a + k*m, *a1 = a0 + m,
+                        *a2 = a1 + m, *a3 = a2 + m;
+                     T b0 = bj[k], b1 = bj[k+1], b2 = bj[k+2], b3 = bj[k+3];
+                     for (std::size_t i = ii; i < iend; i++)
+                        cj[i] = (((cj[i] + a0[i]*b0) + a1[i]*b1) + a2[i]*b2)
+                           + a3[i]*b3;
+                  }
+                  for (; k < kend; k++)
+                  {
+                     const T *ak = a + k*m;
+                     T bk = bj[k];
+                     for (std::size_t i = ii; i < iend; i++)
+                        cj[i] += ak[i]*bk;
+                  }
+               }
+            }
+         }
+      }
+
+         /**
+          * c = transpose(a) * b, where a is m by n, b is m by p and c
+          * is n by p.  Each element of c is the dot product of two
+          * contiguous columns; four are computed at once.
+          * @param[in] m rows of a and b.
+          * @param[in] n columns of a and rows of c.
+          * @param[in] p columns of b and c.
+          * @param[in] a the operand to be transposed.
+          * @param[in] b the right operand.
+          * @param[out] c the result, which must not overlap a or b.
+          */
+      template <class T>
+      void transposeMultiply(std::size_t m, std::size_t n, std::size_t p,
+                             const T* a, const T* b, T* c)
+      {
+         for (std::size_t j = 0; j < p; j++)
+         {
+            const T *bj = b + j*m;
+            std::size_t i = 0;
+            for (; i + 4 <= n; i += 4)
+            {
+               const T *a0 = a + i*m, *a1 = a0 + m, *a2 = a1 + m, *a3 = a2 + m;
+               T s0(0), s1(0), s2(0), s3(0);
+               for (std::size_t k = 0; k < m; k++)
+               {
+                  s0 += a0[k]*bj[k];
+                  s1 += a1[k]*bj[k];
+                  s2 += a2[k]*bj[k];
+                  s3 += a3[k]*bj[k];
+               }
+               c[i + j*n] = s0;
+               c[i+1 + j*n] = s1;
+               c[i+2 + j*n] = s2;
+               c[i+3 + j*n] = s3;
+            }
+            for (; i < n; i++)
+            {
+               const T *ai = a + i*m;
+               T s(0);
+               for (std::size_t k = 0; k < m; k++)
+                  s += ai[k]*bj[k];
+               c[i + j*n] = s;
+            }
+         }
+      }
+
+         /**
+          * t = transpose(a), where a is m by n, done in tiles so that
+          * both a and t are read and written a cache line at a time.
+          * @param[in] m rows of a.
+          * @param[in] n columns of a.
+          * @param[in] a the matrix to be transposed.
+          * @param[out] t the n by m result, which must not overlap a.
+          */
+      template <class T>
+      void transpose(std::size_t m, std::size_t n, const T* a, T* t)
+      {
+         for (std::size_t jj = 0; jj < n; jj += tileSize)
+         {
+            std::size_t jend = (jj + tileSize < n ? jj + tileSize : n);
+            for (std::size_t ii = 0; ii < m; ii += tileSize)
+            {
+               std::size_t iend = (ii + tileSize < m ? ii + tileSize : m);
+               for (std::size_t i = ii; i < iend; i++)
+                  for (std::size_t j = jj; j < jend; j++)
+                     t[j + i*n] = a[i + j*m];
+            }
+         }
+      }
+
+   } // namespace MatrixKernels
+
+      //@}
+
+}  // namespace
+
+#endif
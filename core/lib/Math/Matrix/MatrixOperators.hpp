@@ -47,6 +47,7 @@
 #include <limits>
 #include "MiscMath.hpp"
 #include "MatrixFunctors.hpp"
+#include "MatrixKernels.hpp"
 
 namespace gnsstk
 {
@@ -337,6 +338,18 @@ namespace gnsstk
       return temp;
    }
 
+      /**
+       * Returns a matrix that is \c m transposed, working directly on
+       * the storage of m.
+       */
+   template <class T>
+   inline Matrix<T> transpose(const Matrix<T>& m)
+   {
+      Matrix<T> temp(m.cols(), m.rows());
+      MatrixKernels::transpose(m.rows(), m.cols(), m.begin(), temp.begin());
+      return temp;
+   }
+
       /**
        * Uses an LU Decomposition to calculate the determinate of m.
        * @throw MatrixException
@@ -879,6 +892,117 @@ namespace gnsstk
       return toReturn;
    }
 
+      /**
+       *  Matrix * Matrix : row by column multiplication of two
+       *  matricies, working directly on their storage.
+       * @throw MatrixException
+       */
+   template <class T>
+   inline Matrix<T> operator* (const Matrix<T>& l, const Matrix<T>& r)
+   {
+      if (l.cols() != r.rows())
+      {
+         MatrixException e("Incompatible dimensions for Matrix * Matrix");
+         GNSSTK_THROW(e);
+      }
+
+      Matrix<T> toReturn(l.rows(), r.cols(), T(0));
+      MatrixKernels::multiply(l.rows(), r.cols(), l.cols(), l.begin(),
+                              r.begin(), toReturn.begin());
+      return toReturn;
+   }
+
+      /**
+       * Matrix times vector multiplication, returning a vector,
+       * working directly on their storage.
+       * @throw MatrixException
+       */
+   template <class T>
+   inline Vector<T> operator* (const Matrix<T>& m, const Vector<T>& v)
+   {
+      if (v.size() != m.cols())
+      {
+         gnsstk::MatrixException e("Incompatible dimensions for Vector * Matrix");
+         GNSSTK_THROW(e);
+      }
+
+      Vector<T> toReturn(m.rows(), T(0));
+      MatrixKernels::multiply(m.rows(), size_t(1), m.cols(), m.begin(),
+                              v.begin(), toReturn.begin());
+      return toReturn;
+   }
+
+      /**
+       * Vector times matrix multiplication, returning a vector,
+       * working directly on their storage.
+       * @throw MatrixException
+       */
+   template <class T>
+   inline Vector<T> operator* (const Vector<T>& v, const Matrix<T>& m)
+   {
+      if (v.size() != m.rows())
+      {
+         gnsstk::MatrixException e("Incompatible dimensions for Vector * Matrix");
+         GNSSTK_THROW(e);
+      }
+
+      Vector<T> toReturn(m.cols());
+      MatrixKernels::transposeMultiply(m.rows(), m.cols(), size_t(1),
+                                       m.begin(), v.begin(), toReturn.begin());
+      return toReturn;
+   }
+
+      /**
+       * Compute transpose(a) * b without forming transpose(a).  The
+       * result is the same as that of the expression.
+       * @throw MatrixException
+       */
+   template <class T>
+   inline Matrix<T> transposeTimes(const Matrix<T>& a, const Matrix<T>& b)
+   {
+      if (a.rows() != b.rows())
+      {
+         MatrixException e("Incompatible dimensions for transpose(Matrix) * Matrix");
+         GNSSTK_THROW(e);
+      }
+
+      Matrix<T> toReturn(a.cols(), b.cols());
+      MatrixKernels::transposeMultiply(a.rows(), a.cols(), b.cols(), a.begin(),
+                                       b.begin(), toReturn.begin());
+      return toReturn;
+   }
+
+      /**
+       * Compute transpose(a) * b for a vector b without forming
+       * transpose(a).  The result is the same as that of the
+       * expression.
+       * @throw MatrixException
+       */
+   template <class T>
+   inline Vector<T> transposeTimes(const Matrix<T>& a, const Vector<T>& b)
+   {
+      return b * a;
+   }
+
+      /**
+       * Compute transpose(a) * w * a, e.g. the information matrix of
+       * a least squares problem with partials a and weight matrix w,
+       * without forming transpose(a).  The result is the same as
+       * that of the expression.
+       * @throw MatrixException
+       */
+   template <class T>
+   inline Matrix<T> transposeWeighted(const Matrix<T>& a, const Matrix<T>& w)
+   {
+      if (w.rows() != w.cols())
+      {
+         MatrixException e("Weight matrix must be square");
+         GNSSTK_THROW(e);
+      }
+
+      return transposeTimes(a, w) * a;
+   }
+
       /**
        * Compute sum of two matricies.
        * @throw MatrixException
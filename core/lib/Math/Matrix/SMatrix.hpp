@@ -0,0 +1,580 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/**
+ * @file SMatrix.hpp
+ * Matrix whose dimensions are fixed at compile time, stored on the
+ * stack, with closed form inverses and Cholesky decomposition for
+ * the small sizes used in positioning.
+ */
+
+#ifndef GNSSTK_SMATRIX_HPP
+#define GNSSTK_SMATRIX_HPP
+
+#include "Matrix.hpp"
+#include "SVector.hpp"
+
+namespace gnsstk
+{
+      /// @ingroup MathGroup
+      //@{
+
+      /**
+       * An R by C matrix of type T held in an array member in column
+       * major order, the same order as Matrix<T>.  Like SVector, it
+       * is intended for the 3x3 rotations and the small normal
+       * equations of single point positioning, where the heap
+       * allocations made by Matrix<T> cost more than the arithmetic.
+       *
+       * SMatrix is a ConstMatrixBase, so a Matrix<T> may be
+       * constructed from one and the Matrix<T> operators accept it,
+       * while an SMatrix may be constructed from any ConstMatrixBase
+       * of the same dimensions.  The operators defined here take
+       * precedence over the Matrix<T> ones for SMatrix operands and
+       * return SMatrix and SVector objects.
+       *
+       * @code
+       * SMatrix<double,3,3> rot(ident<double,3>());
+       * SVector<double,3> x(rot * y);
+       * SMatrix<double,4,4> cov(inverse(transposeTimes(h, h)));
+       * @endcode
+       */
+   template <class T, size_t R, size_t C>
+   class SMatrix : public ConstMatrixBase<T, SMatrix<T,R,C> >
+   {
+   public:
+         /// STL value type
+      typedef T value_type;
+         /// STL iterator type
+      typedef T* iterator;
+         /// STL const iterator type
+      typedef const T* const_iterator;
+
+         /// Default constructor, all elements are zero.
+      SMatrix()
+      { for (size_t i = 0; i < R*C; i++) m[i] = T(0); }
+         /// Constructor setting every element to initialValue.
+      explicit SMatrix(const T initialValue)
+      { for (size_t i = 0; i < R*C; i++) m[i] = initialValue; }
+         /** Copy the elements of any other matrix of the same dimensions.
+          * @throw MatrixException if the dimensions differ */
+      template <class E>
+      explicit SMatrix(const ConstMatrixBase<T, E>& r)
+      {
+         if ((r.rows() != R) || (r.cols() != C))
+         {
+            MatrixException e("SMatrix dimensions do not match source matrix");
+            GNSSTK_THROW(e);
+         }
+         for (size_t j = 0; j < C; j++)
+            for (size_t i = 0; i < R; i++)
+               m[i + j*R] = r(i,j);
+      }
+
+         /// The number of rows, R.
+      static size_t rows() { return R; }
+         /// The number of columns, C.
+      static size_t cols() { return C; }
+         /// The number of elements, R*C.
+      static size_t size() { return R*C; }
+
+         /// Returns the (i,j) element.
+      T& operator() (size_t i, size_t j)
+      { return matRef(i, j); }
+         /// Returns the (i,j) element.
+      T operator() (size_t i, size_t j) const
+      { return matRef(i, j); }
+
+         /// Returns column j.
+      SVector<T,R> col(size_t j) const
+      {
+         SVector<T,R> toReturn;
+         for (size_t i = 0; i < R; i++)
+            toReturn[i] = (*this)(i,j);
+         return toReturn;
+      }
+         /// Returns row i.
+      SVector<T,C> row(size_t i) const
+      {
+         SVector<T,C> toReturn;
+         for (size_t j = 0; j < C; j++)
+            toReturn[j] = (*this)(i,j);
+         return toReturn;
+      }
+
+         /// STL begin, of the column major elements
+      iterator begin() { return m; }
+         /// STL const begin, of the column major elements
+      const_iterator begin() const { return m; }
+         /// STL end
+      iterator end() { return m + R*C; }
+         /// STL const end
+      const_iterator end() const { return m + R*C; }
+
+         /// Add r to each element.
+      SMatrix& operator+=(const SMatrix& r)
+      { for (size_t i = 0; i < R*C; i++) m[i] += r.m[i]; return *this; }
+         /// Subtract r from each element.
+      SMatrix& operator-=(const SMatrix& r)
+      { for (size_t i = 0; i < R*C; i++) m[i] -= r.m[i]; return *this; }
+         /// Multiply each element by r.
+      SMatrix& operator*=(const T r)
+      { for (size_t i = 0; i < R*C; i++) m[i] *= r; return *this; }
+         /// Divide each element by r.
+      SMatrix& operator/=(const T r)
+      { for (size_t i = 0; i < R*C; i++) m[i] /= r; return *this; }
+
+   private:
+         /** Range checked element access.
+          * @throw MatrixException */
+      inline T& matRef(size_t i, size_t j) const
+      {
+#ifdef RANGECHECK
+         if ((i >= R) || (j >= C))
+         {
+            MatrixException e("Invalid SMatrix index");
+            GNSSTK_THROW(e);
+         }
+#endif
+         return const_cast<T&>(m[i + j*R]);
+      }
+
+         /// The elements, in column major order.
+      T m[R*C];
+   };
+
+      /// Returns the N by N identity matrix.
+   template <class T, size_t N>
+   inline SMatrix<T,N,N> ident()
+   {
+      SMatrix<T,N,N> toReturn;
+      for (size_t i = 0; i < N; i++)
+         toReturn(i,i) = T(1);
+      return toReturn;
+   }
+
+      /// Returns the transpose of m.
+   template <class T, size_t R, size_t C>
+   inline SMatrix<T,C,R> transpose(const SMatrix<T,R,C>& m)
+   {
+      SMatrix<T,C,R> toReturn;
+      for (size_t j = 0; j < C; j++)
+         for (size_t i = 0; i < R; i++)
+            toReturn(j,i) = m(i,j);
+      return toReturn;
+   }
+
+      /// Element by element sum.
+   template <class T, size_t R, size_t C>
+   inline SMatrix<T,R,C> operator+(const SMatrix<T,R,C>& l,
+                                   const SMatrix<T,R,C>& r)
+   {
+      SMatrix<T,R,C> toReturn(l);
+      return toReturn += r;
+   }
+
+      /// Element by element difference.
+   template <class T, size_t R, size_t C>
+   inline SMatrix<T,R,C> operator-(const SMatrix<T,R,C>& l,
+                                   const SMatrix<T,R,C>& r)
+   {
+      SMatrix<T,R,C> toReturn(l);
+      return toReturn -= r;
+   }
+
+      /// Multiply every element by a scalar.
+   template <class T, size_t R, size_t C>
+   inline SMatrix<T,R,C> operator*(const SMatrix<T,R,C>& l, const T r)
+   {
+      SMatrix<T,R,C> toReturn(l);
+      return toReturn *= r;
+   }
+
+      /// Multiply every element by a scalar.
+   template <class T, size_t R, size_t C>
+   inline SMatrix<T,R,C> operator*(const T l, const SMatrix<T,R,C>& r)
+   {
+      SMatrix<T,R,C> toReturn(r);
+      return toReturn *= l;
+   }
+
+      /** Matrix product.  Each element is summed in the same order
+       * as the Matrix<T> product, so the results are identical. */
+   template <class T, size_t R, size_t K, size_t C>
+   inline SMatrix<T,R,C> operator*(const SMatrix<T,R,K>& l,
+                                   const SMatrix<T,K,C>& r)
+   {
+      SMatrix<T,R,C> toReturn;
+      for (size_t j = 0; j < C; j++)
+         for (size_t k = 0; k < K; k++)
+         {
+            const T rkj = r(k,j);
+            for (size_t i = 0; i < R; i++)
+               toReturn(i,j) += l(i,k) * rkj;
+         }
+      return toReturn;
+   }
+
+      /// Matrix times column vector.
+   template <class T, size_t R, size_t C>
+   inline SVector<T,R> operator*(const SMatrix<T,R,C>& l,
+                                 const SVector<T,C>& r)
+   {
+      SVector<T,R> toReturn;
+      for (size_t k = 0; k < C; k++)
+      {
+         const T rk = r[k];
+         for (size_t i = 0; i < R; i++)
+            toReturn[i] += l(i,k) * rk;
+      }
+      return toReturn;
+   }
+
+      /// Row vector times matrix.
+   template <class T, size_t R, size_t C>
+   inline SVector<T,C> operator*(const SVector<T,R>& l,
+                                 const SMatrix<T,R,C>& r)
+   {
+      SVector<T,C> toReturn;
+      for (size_t j = 0; j < C; j++)
+         for (size_t k = 0; k < R; k++)
+            toReturn[j] += l[k] * r(k,j);
+      return toReturn;
+   }
+
+      /// transpose(a) * b without forming the transpose.
+   template <class T, size_t K, size_t R, size_t C>
+   inline SMatrix<T,R,C> transposeTimes(const SMatrix<T,K,R>& a,
+                                        const SMatrix<T,K,C>& b)
+   {
+      SMatrix<T,R,C> toReturn;
+      for (size_t j = 0; j < C; j++)
+         for (size_t i = 0; i < R; i++)
+         {
+            T sum(0);
+            for (size_t k = 0; k < K; k++)
+               sum += a(k,i) * b(k,j);
+            toReturn(i,j) = sum;
+         }
+      return toReturn;
+   }
+
+      /// transpose(a) * b without forming the transpose.
+   template <class T, size_t K, size_t R>
+   inline SVector<T,R> transposeTimes(const SMatrix<T,K,R>& a,
+                                      const SVector<T,K>& b)
+   {
+      SVector<T,R> toReturn;
+      for (size_t i = 0; i < R; i++)
+         for (size_t k = 0; k < K; k++)
+            toReturn[i] += a(k,i) * b[k];
+      return toReturn;
+   }
+
+      /// Implementation of the SMatrix inverse, by size.
+   template <class T, size_t N>
+   struct SMatrixInverter
+   {
+         /** Gauss-Jordan elimination with partial pivoting, in place.
+          * @throw SingularMatrixException */
+      static void invert(SMatrix<T,N,N>& a)
+      {
+         SMatrix<T,N,N> b(ident<T,N>());
+         for (size_t c = 0; c < N; c++)
+         {
+            size_t p = c;
+            for (size_t r = c+1; r < N; r++)
+               if (ABS(a(r,c)) > ABS(a(p,c)))
+                  p = r;
+            if (a(p,c) == T(0))
+            {
+               SingularMatrixException e("Singular matrix");
+               GNSSTK_THROW(e);
+            }
+            if (p != c)
+            {
+               for (size_t j = 0; j < N; j++)
+               {
+                  std::swap(a(p,j), a(c,j));
+                  std::swap(b(p,j), b(c,j));
+               }
+            }
+            const T d = T(1) / a(c,c);
+            for (size_t j = 0; j < N; j++)
+            {
+               a(c,j) *= d;
+               b(c,j) *= d;
+            }
+            for (size_t r = 0; r < N; r++)
+            {
+               if (r == c)
+                  continue;
+               const T f = a(r,c);
+               if (f == T(0))
+                  continue;
+               for (size_t j = 0; j < N; j++)
+               {
+                  a(r,j) -= f * a(c,j);
+                  b(r,j) -= f * b(c,j);
+               }
+            }
+         }
+         a = b;
+      }
+   };
+
+   template <class T>
+   struct SMatrixInverter<T,1>
+   {
+         /// @throw SingularMatrixException
+      static void invert(SMatrix<T,1,1>& a)
+      {
+         if (a(0,0) == T(0))
+         {
+            SingularMatrixException e("Singular matrix");
+            GNSSTK_THROW(e);
+         }
+         a(0,0) = T(1) / a(0,0);
+      }
+   };
+
+   template <class T>
+   struct SMatrixInverter<T,2>
+   {
+         /// @throw SingularMatrixException
+      static void invert(SMatrix<T,2,2>& a)
+      {
+         const T det = a(0,0)*a(1,1) - a(0,1)*a(1,0);
+         if (det == T(0))
+         {
+            SingularMatrixException e("Singular matrix");
+            GNSSTK_THROW(e);
+         }
+         const T d = T(1) / det;
+         const T a00 = a(0,0);
+         a(0,0) = a(1,1) * d;
+         a(1,1) = a00 * d;
+         a(0,1) = -a(0,1) * d;
+         a(1,0) = -a(1,0) * d;
+      }
+   };
+
+   template <class T>
+   struct SMatrixInverter<T,3>
+   {
+         /// Inverse by the adjugate. @throw SingularMatrixException
+      static void invert(SMatrix<T,3,3>& a)
+      {
+         SMatrix<T,3,3> adj;
+         adj(0,0) = a(1,1)*a(2,2) - a(1,2)*a(2,1);
+         adj(0,1) = a(0,2)*a(2,1) - a(0,1)*a(2,2);
+         adj(0,2) = a(0,1)*a(1,2) - a(0,2)*a(1,1);
+         adj(1,0) = a(1,2)*a(2,0) - a(1,0)*a(2,2);
+         adj(1,1) = a(0,0)*a(2,2) - a(0,2)*a(2,0);
+         adj(1,2) = a(0,2)*a(1,0) - a(0,0)*a(1,2);
+         adj(2,0) = a(1,0)*a(2,1) - a(1,1)*a(2,0);
+         adj(2,1) = a(0,1)*a(2,0) - a(0,0)*a(2,1);
+         adj(2,2) = a(0,0)*a(1,1) - a(0,1)*a(1,0);
+         const T det = a(0,0)*adj(0,0) + a(0,1)*adj(1,0) + a(0,2)*adj(2,0);
+         if (det == T(0))
+         {
+            SingularMatrixException e("Singular matrix");
+            GNSSTK_THROW(e);
+         }
+         adj *= T(1) / det;
+         a = adj;
+      }
+   };
+
+   template <class T>
+   struct SMatrixInverter<T,4>
+   {
+         /** Inverse by the adjugate, with the cofactors built from
+          * the 2x2 minors of the top and bottom row pairs.
+          * @throw SingularMatrixException */
+      static void invert(SMatrix<T,4,4>& a)
+      {
+         const T s0 = a(0,0)*a(1,1) - a(1,0)*a(0,1);
+         const T s1 = a(0,0)*a(1,2) - a(1,0)*a(0,2);
+         const T s2 = a(0,0)*a(1,3) - a(1,0)*a(0,3);
+         const T s3 = a(0,1)*a(1,2) - a(1,1)*a(0,2);
+         const T s4 = a(0,1)*a(1,3) - a(1,1)*a(0,3);
+         const T s5 = a(0,2)*a(1,3) - a(1,2)*a(0,3);
+         const T c5 = a(2,2)*a(3,3) - a(3,2)*a(2,3);
+         const T c4 = a(2,1)*a(3,3) - a(3,1)*a(2,3);
+         const T c3 = a(2,1)*a(3,2) - a(3,1)*a(2,2);
+         const T c2 = a(2,0)*a(3,3) - a(3,0)*a(2,3);
+         const T c1 = a(2,0)*a(3,2) - a(3,0)*a(2,2);
+         const T c0 = a(2,0)*a(3,1) - a(3,0)*a(2,1);
+         const T det = s0*c5 - s1*c4 + s2*c3 + s3*c2 - s4*c1 + s5*c0;
+         if (det == T(0))
+         {
+            SingularMatrixException e("Singular matrix");
+            GNSSTK_THROW(e);
+         }
+         const T d = T(1) / det;
+         SMatrix<T,4,4> b;
+         b(0,0) = ( a(1,1)*c5 - a(1,2)*c4 + a(1,3)*c3) * d;
+         b(0,1) = (-a(0,1)*c5 + a(0,2)*c4 - a(0,3)*c3) * d;
+         b(0,2) = ( a(3,1)*s5 - a(3,2)*s4 + a(3,3)*s3) * d;
+         b(0,3) = (-a(2,1)*s5 + a(2,2)*s4 - a(2,3)*s3) * d;
+         b(1,0) = (-a(1,0)*c5 + a(1,2)*c2 - a(1,3)*c1) * d;
+         b(1,1) = ( a(0,0)*c5 - a(0,2)*c2 + a(0,3)*c1) * d;
+         b(1,2) = (-a(3,0)*s5 + a(3,2)*s2 - a(3,3)*s1) * d;
+         b(1,3) = ( a(2,0)*s5 - a(2,2)*s2 + a(2,3)*s1) * d;
+         b(2,0) = ( a(1,0)*c4 - a(1,1)*c2 + a(1,3)*c0) * d;
+         b(2,1) = (-a(0,0)*c4 + a(0,1)*c2 - a(0,3)*c0) * d;
+         b(2,2) = ( a(3,0)*s4 - a(3,1)*s2 + a(3,3)*s0) * d;
+         b(2,3) = (-a(2,0)*s4 + a(2,1)*s2 - a(2,3)*s0) * d;
+         b(3,0) = (-a(1,0)*c3 + a(1,1)*c1 - a(1,2)*c0) * d;
+         b(3,1) = ( a(0,0)*c3 - a(0,1)*c1 + a(0,2)*c0) * d;
+         b(3,2) = (-a(3,0)*s3 + a(3,1)*s1 - a(3,2)*s0) * d;
+         b(3,3) = ( a(2,0)*s3 - a(2,1)*s1 + a(2,2)*s0) * d;
+         a = b;
+      }
+   };
+
+      /**
+       * Returns the inverse of m, in closed form for N <= 4 and by
+       * Gauss-Jordan elimination with partial pivoting otherwise.
+       * @throw SingularMatrixException if m is singular
+       */
+   template <class T, size_t N>
+   inline SMatrix<T,N,N> inverse(const SMatrix<T,N,N>& m)
+   {
+      SMatrix<T,N,N> toReturn(m);
+      SMatrixInverter<T,N>::invert(toReturn);
+      return toReturn;
+   }
+
+      /**
+       * Returns the lower triangular L such that m = L*transpose(L),
+       * for symmetric positive definite m.
+       * @throw MatrixException if m is not positive definite
+       */
+   template <class T, size_t N>
+   inline SMatrix<T,N,N> cholesky(const SMatrix<T,N,N>& m)
+   {
+      SMatrix<T,N,N> L;
+      for (size_t j = 0; j < N; j++)
+      {
+         T d = m(j,j);
+         for (size_t k = 0; k < j; k++)
+            d -= L(j,k) * L(j,k);
+         if (d <= T(0))
+         {
+            MatrixException e("Cholesky fails - eigenvalue <= 0");
+            GNSSTK_THROW(e);
+         }
+         L(j,j) = SQRT(d);
+         const T inv = T(1) / L(j,j);
+         for (size_t i = j+1; i < N; i++)
+         {
+            T s = m(i,j);
+            for (size_t k = 0; k < j; k++)
+               s -= L(i,k) * L(j,k);
+            L(i,j) = s * inv;
+         }
+      }
+      return L;
+   }
+
+      /**
+       * Solve m*x = b for symmetric positive definite m, by Cholesky
+       * decomposition and forward and back substitution.
+       * @throw MatrixException if m is not positive definite
+       */
+   template <class T, size_t N>
+   inline SVector<T,N> choleskySolve(const SMatrix<T,N,N>& m,
+                                     const SVector<T,N>& b)
+   {
+      SMatrix<T,N,N> L(cholesky(m));
+      SVector<T,N> y;
+      for (size_t i = 0; i < N; i++)
+      {
+         T s = b[i];
+         for (size_t k = 0; k < i; k++)
+            s -= L(i,k) * y[k];
+         y[i] = s / L(i,i);
+      }
+      SVector<T,N> x;
+      for (size_t i = N; i-- > 0; )
+      {
+         T s = y[i];
+         for (size_t k = i+1; k < N; k++)
+            s -= L(k,i) * x[k];
+         x[i] = s / L(i,i);
+      }
+      return x;
+   }
+
+      /**
+       * Returns the inverse of symmetric positive definite m from
+       * its Cholesky decomposition; the result is exactly symmetric.
+       * @throw MatrixException if m is not positive definite
+       */
+   template <class T, size_t N>
+   inline SMatrix<T,N,N> inverseChol(const SMatrix<T,N,N>& m)
+   {
+      SMatrix<T,N,N> L(cholesky(m));
+         // invert L in place; the inverse is also lower triangular
+      SMatrix<T,N,N> Li;
+      for (size_t j = 0; j < N; j++)
+      {
+         Li(j,j) = T(1) / L(j,j);
+         for (size_t i = j+1; i < N; i++)
+         {
+            T s(0);
+            for (size_t k = j; k < i; k++)
+               s -= L(i,k) * Li(k,j);
+            Li(i,j) = s / L(i,i);
+         }
+      }
+         // m^-1 = transpose(Li) * Li
+      SMatrix<T,N,N> toReturn(transposeTimes(Li, Li));
+      for (size_t j = 0; j < N; j++)
+         for (size_t i = j+1; i < N; i++)
+            toReturn(j,i) = toReturn(i,j);
+      return toReturn;
+   }
+
+      //@}
+
+}  // namespace
+
+#endif
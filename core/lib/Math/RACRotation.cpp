@@ -128,13 +128,14 @@ gnsstk::Vector<double> RACRotation::convertToRAC( const gnsstk::Vector<double>&
 
 gnsstk::Triple RACRotation::convertToRAC( const gnsstk::Triple& inVec )
 {
-   gnsstk::Vector<double> v(3);
-   v[0] = inVec[0];
-   v[1] = inVec[1];
-   v[2] = inVec[2];
-
-   gnsstk::Vector<double> vOut = convertToRAC( v );
-   gnsstk::Triple outVec( vOut[0], vOut[1], vOut[2] );
+      // multiply in place rather than through temporary Vectors;
+      // the sums are formed in the same order as above
+   gnsstk::Triple outVec;
+   for (size_t i = 0; i < 3; i++)
+   {
+      outVec[i] = (*this)(i,0) * inVec[0] + (*this)(i,1) * inVec[1] +
+         (*this)(i,2) * inVec[2];
+   }
    return(outVec);
 }
 
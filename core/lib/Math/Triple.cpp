@@ -50,7 +50,7 @@ namespace gnsstk
    using namespace std;
 
    Triple :: Triple()
-         : theArray(0., 3)
+         : theArray(0.)
    {
    }
 
@@ -62,11 +62,8 @@ namespace gnsstk
    Triple :: Triple(double a,
                     double b,
                     double c)
-      : theArray(3)
+      : theArray(a, b, c)
    {
-      theArray[0] = a;
-      theArray[1] = b;
-      theArray[2] = c;
    }
 
    Triple& Triple :: operator=(const Triple& right)
@@ -82,7 +79,8 @@ namespace gnsstk
          GNSSTK_THROW(GeometryException("Incorrect vector size"));
       }
 
-      theArray = right;
+      for (size_t i = 0; i < 3; i++)
+         theArray[i] = right[i];
       return *this;
    }
 
@@ -107,10 +105,7 @@ namespace gnsstk
    double Triple :: dot(const Triple& right) const
       noexcept
    {
-      Triple z;
-      z = (this->theArray)*(right.theArray);
-      double a = z.theArray.sum();
-      return a;
+      return gnsstk::dot(theArray, right.theArray);
    }
 
 
@@ -174,7 +169,7 @@ namespace gnsstk
       noexcept
    {
       Triple z;
-      z = right.theArray - this->theArray;
+      z.theArray = right.theArray - this->theArray;
       double r = z.mag();
       return r;
    }
@@ -185,7 +180,7 @@ namespace gnsstk
    double Triple :: elvAngle(const Triple& right) const
    {
       Triple z;
-      z = right.theArray - this->theArray;
+      z.theArray = right.theArray - this->theArray;
       double c = z.cosVector(*this);
       return 90.0 - ::acos(c) * RAD_TO_DEG;
    }
@@ -47,7 +47,7 @@
 #include <valarray>
 #include <vector>
 #include "Exception.hpp"
-#include "Vector.hpp"
+#include "SVector.hpp"
 
 namespace gnsstk
 {
@@ -248,7 +248,9 @@ namespace gnsstk
       friend std::ostream& operator<<(std::ostream& s,
                                       const gnsstk::Triple& v);
 
-      std::valarray<double> theArray;
+         /** The coordinates, held in the object itself so that
+          * Triple and Position do not allocate. */
+      SVector<double,3> theArray;
 
    }; // class Triple
 
@@ -0,0 +1,368 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/**
+ * @file SVector.hpp
+ * Vector whose size is fixed at compile time, stored on the stack.
+ */
+
+#ifndef GNSSTK_SVECTOR_HPP
+#define GNSSTK_SVECTOR_HPP
+
+#include <valarray>
+#include "Vector.hpp"
+
+namespace gnsstk
+{
+      /// @ingroup MathGroup
+      //@{
+
+      /**
+       * A vector of N elements of type T held in an array member
+       * rather than on the heap, for the small vectors (positions,
+       * line-of-sight vectors, partials) that are created and thrown
+       * away for every satellite of every epoch.  The loops over the
+       * elements have constant trip counts, which the compiler
+       * unrolls.
+       *
+       * SVector is a ConstVectorBase, so a Vector<T> may be
+       * constructed from one, and an SVector may be constructed from
+       * any ConstVectorBase of the same size.
+       *
+       * For code written against std::valarray (Triple::theArray
+       * was one), SVector also provides the valarray members sum(),
+       * min(), max() and apply(), element by element and scalar
+       * arithmetic, read-only slices, and conversion to and from
+       * std::valarray<T>.
+       *
+       * @code
+       * SVector<double,3> los(rx - sv);
+       * los /= norm(los);
+       * Vector<double> v(los);
+       * @endcode
+       */
+   template <class T, size_t N>
+   class SVector : public ConstVectorBase<T, SVector<T,N> >
+   {
+   public:
+         /// STL value type
+      typedef T value_type;
+         /// STL iterator type
+      typedef T* iterator;
+         /// STL const iterator type
+      typedef const T* const_iterator;
+
+         /// Default constructor, all elements are zero.
+      SVector()
+      { for (size_t i = 0; i < N; i++) v[i] = T(0); }
+         /// Constructor setting every element to defaultValue.
+      explicit SVector(const T defaultValue)
+      { for (size_t i = 0; i < N; i++) v[i] = defaultValue; }
+         /// Constructor for three element vectors.
+      SVector(const T x, const T y, const T z)
+      {
+         static_assert(N == 3, "SVector(x,y,z) requires N == 3");
+         v[0] = x; v[1] = y; v[2] = z;
+      }
+         /** Copy the elements of any other vector of the same size.
+          * @throw VectorException if r.size() != N */
+      template <class E>
+      explicit SVector(const ConstVectorBase<T, E>& r)
+      {
+         if (r.size() != N)
+         {
+            VectorException e("SVector size does not match source vector");
+            GNSSTK_THROW(e);
+         }
+         for (size_t i = 0; i < N; i++)
+            v[i] = r[i];
+      }
+
+         /** Copy the elements of a std::valarray of the same size.
+          * @throw VectorException if r.size() != N */
+      explicit SVector(const std::valarray<T>& r)
+      { *this = r; }
+
+         /** Assign the elements of a std::valarray of the same size.
+          * @throw VectorException if r.size() != N */
+      SVector& operator=(const std::valarray<T>& r)
+      {
+         if (r.size() != N)
+         {
+            VectorException e("SVector size does not match source valarray");
+            GNSSTK_THROW(e);
+         }
+         for (size_t i = 0; i < N; i++)
+            v[i] = r[i];
+         return *this;
+      }
+
+         /// Copy the elements into a std::valarray.
+      operator std::valarray<T>() const
+      { return std::valarray<T>(v, N); }
+
+         /// Returns the number of elements, N.
+      static size_t size() { return N; }
+
+         /// Returns the i'th element.
+      T& operator[] (size_t i)
+      { return vecRef(i); }
+         /// Returns the i'th element.
+      T operator[] (size_t i) const
+      { return vecRef(i); }
+         /// Returns the i'th element.
+      T& operator() (size_t i)
+      { return vecRef(i); }
+         /// Returns the i'th element.
+      T operator() (size_t i) const
+      { return vecRef(i); }
+
+         /** Returns a copy of the elements selected by sl, as
+          * std::valarray::operator[](std::slice) const does.  Unlike
+          * std::valarray, assigning to a slice is not supported. */
+      std::valarray<T> operator[] (const std::slice& sl) const
+      { return std::valarray<T>(*this)[sl]; }
+
+         /// Returns the sum of the elements, as std::valarray::sum().
+      T sum() const
+      { T rv(0); for (size_t i = 0; i < N; i++) rv += v[i]; return rv; }
+         /// Returns the smallest element, as std::valarray::min().
+      T min() const
+      {
+         T rv(v[0]);
+         for (size_t i = 1; i < N; i++)
+            if (v[i] < rv) rv = v[i];
+         return rv;
+      }
+         /// Returns the largest element, as std::valarray::max().
+      T max() const
+      {
+         T rv(v[0]);
+         for (size_t i = 1; i < N; i++)
+            if (rv < v[i]) rv = v[i];
+         return rv;
+      }
+         /// Returns func applied to each element, as std::valarray::apply().
+      SVector apply(T func(T)) const
+      {
+         SVector rv;
+         for (size_t i = 0; i < N; i++)
+            rv.v[i] = func(v[i]);
+         return rv;
+      }
+         /// Returns func applied to each element, as std::valarray::apply().
+      SVector apply(T func(const T&)) const
+      {
+         SVector rv;
+         for (size_t i = 0; i < N; i++)
+            rv.v[i] = func(v[i]);
+         return rv;
+      }
+
+         /// STL begin
+      iterator begin() { return v; }
+         /// STL const begin
+      const_iterator begin() const { return v; }
+         /// STL end
+      iterator end() { return v + N; }
+         /// STL const end
+      const_iterator end() const { return v + N; }
+
+         /// Add r to each element.
+      SVector& operator+=(const SVector& r)
+      { for (size_t i = 0; i < N; i++) v[i] += r.v[i]; return *this; }
+         /// Subtract r from each element.
+      SVector& operator-=(const SVector& r)
+      { for (size_t i = 0; i < N; i++) v[i] -= r.v[i]; return *this; }
+         /// Multiply each element by the same element of r.
+      SVector& operator*=(const SVector& r)
+      { for (size_t i = 0; i < N; i++) v[i] *= r.v[i]; return *this; }
+         /// Divide each element by the same element of r.
+      SVector& operator/=(const SVector& r)
+      { for (size_t i = 0; i < N; i++) v[i] /= r.v[i]; return *this; }
+         /// Add r to each element.
+      SVector& operator+=(const T r)
+      { for (size_t i = 0; i < N; i++) v[i] += r; return *this; }
+         /// Subtract r from each element.
+      SVector& operator-=(const T r)
+      { for (size_t i = 0; i < N; i++) v[i] -= r; return *this; }
+         /// Multiply each element by r.
+      SVector& operator*=(const T r)
+      { for (size_t i = 0; i < N; i++) v[i] *= r; return *this; }
+         /// Divide each element by r.
+      SVector& operator/=(const T r)
+      { for (size_t i = 0; i < N; i++) v[i] /= r; return *this; }
+
+   private:
+         /** Range checked element access.
+          * @throw VectorException */
+      inline T& vecRef(size_t i) const
+      {
+#ifdef RANGECHECK
+         if (i >= N)
+         {
+            VectorException e("Invalid SVector index");
+            GNSSTK_THROW(e);
+         }
+#endif
+         return const_cast<T&>(v[i]);
+      }
+
+         /// The elements.
+      T v[N];
+   };
+
+      /// Element by element sum.
+   template <class T, size_t N>
+   inline SVector<T,N> operator+(const SVector<T,N>& l, const SVector<T,N>& r)
+   {
+      SVector<T,N> toReturn(l);
+      return toReturn += r;
+   }
+
+      /// Element by element difference.
+   template <class T, size_t N>
+   inline SVector<T,N> operator-(const SVector<T,N>& l, const SVector<T,N>& r)
+   {
+      SVector<T,N> toReturn(l);
+      return toReturn -= r;
+   }
+
+      /// Element by element product.
+   template <class T, size_t N>
+   inline SVector<T,N> operator*(const SVector<T,N>& l, const SVector<T,N>& r)
+   {
+      SVector<T,N> toReturn(l);
+      return toReturn *= r;
+   }
+
+      /// Element by element quotient.
+   template <class T, size_t N>
+   inline SVector<T,N> operator/(const SVector<T,N>& l, const SVector<T,N>& r)
+   {
+      SVector<T,N> toReturn(l);
+      return toReturn /= r;
+   }
+
+      /// Add a scalar to every element.
+   template <class T, size_t N>
+   inline SVector<T,N> operator+(const SVector<T,N>& l, const T r)
+   {
+      SVector<T,N> toReturn(l);
+      return toReturn += r;
+   }
+
+      /// Add a scalar to every element.
+   template <class T, size_t N>
+   inline SVector<T,N> operator+(const T l, const SVector<T,N>& r)
+   {
+      SVector<T,N> toReturn(r);
+      return toReturn += l;
+   }
+
+      /// Subtract a scalar from every element.
+   template <class T, size_t N>
+   inline SVector<T,N> operator-(const SVector<T,N>& l, const T r)
+   {
+      SVector<T,N> toReturn(l);
+      return toReturn -= r;
+   }
+
+      /// Negation.
+   template <class T, size_t N>
+   inline SVector<T,N> operator-(const SVector<T,N>& r)
+   {
+      SVector<T,N> toReturn(r);
+      return toReturn *= T(-1);
+   }
+
+      /// Multiply every element by a scalar.
+   template <class T, size_t N>
+   inline SVector<T,N> operator*(const SVector<T,N>& l, const T r)
+   {
+      SVector<T,N> toReturn(l);
+      return toReturn *= r;
+   }
+
+      /// Multiply every element by a scalar.
+   template <class T, size_t N>
+   inline SVector<T,N> operator*(const T l, const SVector<T,N>& r)
+   {
+      SVector<T,N> toReturn(r);
+      return toReturn *= l;
+   }
+
+      /// Divide every element by a scalar.
+   template <class T, size_t N>
+   inline SVector<T,N> operator/(const SVector<T,N>& l, const T r)
+   {
+      SVector<T,N> toReturn(l);
+      return toReturn /= r;
+   }
+
+      /// Dot product.
+   template <class T, size_t N>
+   inline T dot(const SVector<T,N>& l, const SVector<T,N>& r)
+   {
+      T sum(0);
+      for (size_t i = 0; i < N; i++)
+         sum += l[i] * r[i];
+      return sum;
+   }
+
+      /// Euclidean norm.
+   template <class T, size_t N>
+   inline T norm(const SVector<T,N>& v)
+   {
+      return SQRT(dot(v, v));
+   }
+
+      /// Cross product of two three element vectors.
+   template <class T>
+   inline SVector<T,3> cross(const SVector<T,3>& l, const SVector<T,3>& r)
+   {
+      return SVector<T,3>(l[1] * r[2] - l[2] * r[1],
+                          l[2] * r[0] - l[0] * r[2],
+                          l[0] * r[1] - l[1] * r[0]);
+   }
+
+      //@}
+
+}  // namespace
+
+#endif
@@ -45,6 +45,7 @@
 #define GNSSTK_VECTOR_HPP
 
 #include <limits>
+#include <utility>
 #include <vector>
 #include "VectorBase.hpp"
 
@@ -139,6 +140,15 @@ namespace gnsstk
             }
             this->assignFrom(r);
          }
+      }
+         /**
+          * Move constructor, taking the contents of r and leaving it
+          * empty.
+          */
+      Vector(Vector&& r) noexcept : v(r.v), s(r.s)
+      {
+         r.v = NULL;
+         r.s = 0;
       }
          /**
           * Valarray constructor
@@ -229,6 +239,14 @@ namespace gnsstk
       Vector& operator=(const Vector& x)
       { resize(x.s); return this->assignFrom(x); }
 
+         /// Takes the contents of x, which gets those of *this.
+      Vector& operator=(Vector&& x) noexcept
+      {
+         std::swap(v, x.v);
+         std::swap(s, x.s);
+         return *this;
+      }
+
          /// *this will be resized if it isn't as large as x.
       template <class E>
       Vector& operator=(const ConstVectorBase<T, E>& x)
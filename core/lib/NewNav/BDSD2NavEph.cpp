@@ -299,6 +299,18 @@ namespace gnsstk
    }
 
 
+   bool BDSD2NavEph ::
+   getXvt(const CommonTime* when, size_t count, Xvt* xvt, const ObsID& oid)
+   {
+      if ((signal.sat.id >= MIN_MEO_BDS) && (signal.sat.id <= MAX_MEO_BDS))
+      {
+         CGCS2000Ellipsoid ell;
+         return OrbitDataKepler::getXvt(when, count, ell, xvt);
+      }
+      return OrbitData::getXvt(when, count, xvt, oid);
+   }
+
+
    bool BDSD2NavEph ::
    validate() const
    {
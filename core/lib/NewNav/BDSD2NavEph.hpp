@@ -76,6 +76,23 @@ namespace gnsstk
       bool getXvt(const CommonTime& when, Xvt& xvt,
                   const ObsID& = ObsID()) override;
 
+         /** Compute the satellite's position and velocity at a number
+          * of times.
+          * @note GEO satellites are computed one time at a time using
+          *   the single-epoch getXvt(), MEO still use the
+          *   OrbitDataKepler implementation.
+          * @param[in] when An array of \a count times at which to
+          *   compute the xvt.
+          * @param[in] count The number of elements in \a when and \a xvt.
+          * @param[out] xvt An array of \a count Xvt objects, where
+          *   xvt[i] is set to the position and velocity at when[i].
+          * @param[in] oid Value is ignored - BeiDou does not have
+          *   distinct transmitters.
+          * @return true if successful, false if required nav data was
+          *   unavailable. */
+      bool getXvt(const CommonTime* when, size_t count, Xvt* xvt,
+                  const ObsID& oid = ObsID()) override;
+
          /** Checks the contents of this message against known
           * validity rules as defined in the appropriate ICD.
           * @todo implement some checking.
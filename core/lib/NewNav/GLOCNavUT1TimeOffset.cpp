@@ -45,7 +45,7 @@ namespace gnsstk
 {
    GLOCNavUT1TimeOffset ::
    GLOCNavUT1TimeOffset()
-         : NB(-1),
+         : NB(-1), B0(0.0), B1(0.0), B2(0.0),
            UTCTAI(std::numeric_limits<double>::quiet_NaN())
    {
       msgLenSec = 3.0;
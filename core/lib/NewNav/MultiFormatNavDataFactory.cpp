@@ -36,9 +36,15 @@
 //                            release, distribution is unlimited.
 //
 //==============================================================================
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
 #include "MultiFormatNavDataFactory.hpp"
 #include "BasicTimeSystemConverter.hpp"
 #include "NDFUniqConstIterator.hpp"
+#include "NavSnapshot.hpp"
 
 namespace gnsstk
 {
@@ -89,6 +95,34 @@ namespace gnsstk
    }
 
 
+   bool MultiFormatNavDataFactory ::
+   findUntil(const NavMessageID& nmid, const CommonTime& when,
+             NavDataPtr& navOut, CommonTime& until, SVHealth xmitHealth,
+             NavValidityType valid, NavSearchOrder order)
+   {
+         // Same search as find(), but the result is only good until
+         // any of the factories searched might yield something
+         // different.
+      std::set<NavDataFactory*> uniques;
+      CommonTime factUntil;
+      until = CommonTime::END_OF_TIME;
+      until.setTimeSystem(TimeSystem::Any);
+      for (auto& fi : *myFactories)
+      {
+         if ((fi.first == nmid) && (uniques.count(fi.second.get()) == 0))
+         {
+            bool rv = fi.second->findUntil(nmid, when, navOut, factUntil,
+                                           xmitHealth, valid, order);
+            until = std::min(until, factUntil);
+            if (rv)
+               return true;
+            uniques.insert(fi.second.get());
+         }
+      }
+      return false;
+   }
+
+
    bool MultiFormatNavDataFactory ::
    getOffset(TimeSystem fromSys, TimeSystem toSys,
              const CommonTime& when, NavDataPtr& offset,
@@ -148,6 +182,162 @@ namespace gnsstk
    }
 
 
+   void MultiFormatNavDataFactory ::
+   freeze()
+   {
+      for (auto& fi : NDFUniqIterator<NavDataFactoryMap>(*myFactories))
+      {
+         NavDataFactory *ndfp = fi.second.get();
+         NavDataFactoryWithStore *ndfs =
+            dynamic_cast<NavDataFactoryWithStore*>(ndfp);
+         if (ndfs != nullptr)
+         {
+            ndfs->freeze();
+         }
+      }
+   }
+
+
+   void MultiFormatNavDataFactory ::
+   thaw()
+   {
+      for (auto& fi : NDFUniqIterator<NavDataFactoryMap>(*myFactories))
+      {
+         NavDataFactory *ndfp = fi.second.get();
+         NavDataFactoryWithStore *ndfs =
+            dynamic_cast<NavDataFactoryWithStore*>(ndfp);
+         if (ndfs != nullptr)
+         {
+            ndfs->thaw();
+         }
+      }
+   }
+
+
+   bool MultiFormatNavDataFactory ::
+   isFrozen() const
+   {
+      for (const auto& fi : NDFUniqConstIterator<NavDataFactoryMap>(*myFactories))
+      {
+         NavDataFactory *ndfp = fi.second.get();
+         NavDataFactoryWithStore *ndfs =
+            dynamic_cast<NavDataFactoryWithStore*>(ndfp);
+         if ((ndfs != nullptr) && !ndfs->isFrozen())
+         {
+            return false;
+         }
+      }
+      return true;
+   }
+
+
+   void MultiFormatNavDataFactory ::
+   seal()
+   {
+      for (auto& fi : NDFUniqIterator<NavDataFactoryMap>(*myFactories))
+      {
+         NavDataFactory *ndfp = fi.second.get();
+         NavDataFactoryWithStore *ndfs =
+            dynamic_cast<NavDataFactoryWithStore*>(ndfp);
+         if (ndfs != nullptr)
+         {
+            ndfs->seal();
+         }
+      }
+   }
+
+
+   void MultiFormatNavDataFactory ::
+   unseal()
+   {
+      for (auto& fi : NDFUniqIterator<NavDataFactoryMap>(*myFactories))
+      {
+         NavDataFactory *ndfp = fi.second.get();
+         NavDataFactoryWithStore *ndfs =
+            dynamic_cast<NavDataFactoryWithStore*>(ndfp);
+         if (ndfs != nullptr)
+         {
+            ndfs->unseal();
+         }
+      }
+   }
+
+
+   bool MultiFormatNavDataFactory ::
+   isSealed() const
+   {
+      for (const auto& fi :
+              NDFUniqConstIterator<NavDataFactoryMap>(*myFactories))
+      {
+         NavDataFactory *ndfp = fi.second.get();
+         NavDataFactoryWithStore *ndfs =
+            dynamic_cast<NavDataFactoryWithStore*>(ndfp);
+         if ((ndfs != nullptr) && !ndfs->isSealed())
+         {
+            return false;
+         }
+      }
+      return true;
+   }
+
+
+   void MultiFormatNavDataFactory ::
+   setRetention(double horizon)
+   {
+      retention = horizon;
+      for (auto& fi : NDFUniqIterator<NavDataFactoryMap>(*myFactories))
+      {
+         NavDataFactory *ndfp = fi.second.get();
+         NavDataFactoryWithStore *ndfs =
+            dynamic_cast<NavDataFactoryWithStore*>(ndfp);
+         if (ndfs != nullptr)
+         {
+            ndfs->setRetention(horizon);
+         }
+      }
+   }
+
+
+   std::map<NavSignalID, size_t> MultiFormatNavDataFactory ::
+   getMessageCounts() const
+   {
+      std::map<NavSignalID, size_t> rv;
+      for (const auto& fi :
+              NDFUniqConstIterator<NavDataFactoryMap>(*myFactories))
+      {
+         NavDataFactory *ndfp = fi.second.get();
+         NavDataFactoryWithStore *ndfs =
+            dynamic_cast<NavDataFactoryWithStore*>(ndfp);
+         if (ndfs != nullptr)
+         {
+            for (const auto& sci : ndfs->getMessageCounts())
+            {
+               rv[sci.first] += sci.second;
+            }
+         }
+      }
+      return rv;
+   }
+
+
+   unsigned long MultiFormatNavDataFactory ::
+   getChangeCount() const
+   {
+         // See NavLibrary::getChangeCount() regarding repeats.
+      unsigned long rv = changeCount + myFactories->size();
+      NavDataFactory *prev = nullptr;
+      for (const auto& fi : *myFactories)
+      {
+         if (fi.second.get() != prev)
+         {
+            prev = fi.second.get();
+            rv += prev->getChangeCount();
+         }
+      }
+      return rv;
+   }
+
+
    CommonTime MultiFormatNavDataFactory ::
    getInitialTime() const
    {
@@ -433,6 +623,7 @@ namespace gnsstk
       {
          factories()->insert(NavDataFactoryMap::value_type(si,fact));
       }
+      bumpSharedChangeCount();
       return true;
    }
 
@@ -458,6 +649,169 @@ namespace gnsstk
    }
 
 
+   bool MultiFormatNavDataFactory ::
+   addDataSources(const std::vector<std::string>& sources, unsigned threads)
+   {
+      std::vector<NavDataFactoryWithStoreFile*> facts;
+      for (auto& fi : NDFUniqIterator<NavDataFactoryMap>(*myFactories))
+      {
+         NavDataFactoryWithStoreFile *fact =
+            dynamic_cast<NavDataFactoryWithStoreFile*>(fi.second.get());
+         if (fact != nullptr)
+         {
+            facts.push_back(fact);
+         }
+      }
+         /* The result of one factory's attempt at decoding a file.
+          * Failed attempts are kept because addDataSource() leaves
+          * whatever was stored before the failure in the store. */
+      struct Attempt
+      {
+         NavDataFactoryWithStoreFile *fact;
+         ParsedFilePtr parsed;
+         bool success;
+      };
+      std::vector<std::vector<Attempt> > attempts(sources.size());
+      std::atomic<size_t> nextFile(0);
+      std::exception_ptr error;
+      std::mutex errorMutex;
+      auto worker = [&]() -> void
+      {
+         size_t i;
+         while ((i = nextFile++) < sources.size())
+         {
+            try
+            {
+               for (auto fact : facts)
+               {
+                  Attempt att;
+                  att.fact = fact;
+                  att.success = fact->parseFile(sources[i], att.parsed);
+                  attempts[i].push_back(att);
+                  if (att.success)
+                     break;
+               }
+            }
+            catch (...)
+            {
+               std::lock_guard<std::mutex> lock(errorMutex);
+               if (!error)
+                  error = std::current_exception();
+            }
+         }
+      };
+      if (threads == 0)
+      {
+         threads = std::thread::hardware_concurrency();
+      }
+      threads = std::min<size_t>(threads, sources.size());
+      if (threads <= 1)
+      {
+         worker();
+      }
+      else
+      {
+         std::vector<std::thread> pool;
+         for (unsigned t = 0; t < threads; t++)
+         {
+            pool.push_back(std::thread(worker));
+         }
+         for (auto& th : pool)
+         {
+            th.join();
+         }
+      }
+      if (error)
+      {
+         std::rethrow_exception(error);
+      }
+         // Store serially, in order, so the result doesn't depend on
+         // which thread finished first.
+      bool rv = true;
+      for (size_t i = 0; i < sources.size(); i++)
+      {
+         bool loaded = false;
+         for (const auto& att : attempts[i])
+         {
+            if (att.fact->storeParsed(att.parsed) && att.success)
+            {
+               loaded = true;
+               break;
+            }
+         }
+            // A factory that decoded the file may still have failed to
+            // store it, in which case the remaining factories get
+            // their turn, as in addDataSource().
+         for (size_t f = attempts[i].size(); !loaded && (f < facts.size());
+              f++)
+         {
+            loaded = facts[f]->addDataSource(sources[i]);
+         }
+         if (!loaded)
+            rv = false;
+      }
+      return rv;
+   }
+
+
+   bool MultiFormatNavDataFactory ::
+   saveSnapshot(const std::string& filename) const
+   {
+      NavSnapshot::SectionList sections;
+      for (const auto& fi :
+              NDFUniqConstIterator<NavDataFactoryMap>(*myFactories))
+      {
+         NavDataFactoryWithStore *fact =
+            dynamic_cast<NavDataFactoryWithStore*>(fi.second.get());
+         if (fact != nullptr)
+         {
+            sections.push_back(NavSnapshot::Section());
+            sections.back().first = fact->getFactoryFormats();
+            if (!fact->getSnapshotData(sections.back().second))
+               return false;
+         }
+      }
+      return NavSnapshot::write(filename, sections);
+   }
+
+
+   bool MultiFormatNavDataFactory ::
+   loadSnapshot(const std::string& filename)
+   {
+      NavSnapshot::SectionList sections;
+      if (!NavSnapshot::read(filename, sections))
+         return false;
+      for (const auto& sec : sections)
+      {
+         NavDataFactoryWithStore *match = nullptr;
+         for (auto& fi : NDFUniqIterator<NavDataFactoryMap>(*myFactories))
+         {
+            NavDataFactoryWithStore *fact =
+               dynamic_cast<NavDataFactoryWithStore*>(fi.second.get());
+            if ((fact != nullptr) &&
+                (fact->getFactoryFormats() == sec.first))
+            {
+               match = fact;
+               break;
+            }
+         }
+         if ((match == nullptr) || !match->addSnapshotData(sec.second))
+            return false;
+      }
+      return true;
+   }
+
+
+   bool MultiFormatNavDataFactory ::
+   createSnapshot(const std::string& filename,
+                  const std::vector<std::string>& sources, unsigned threads)
+   {
+      if (!addDataSources(sources, threads))
+         return false;
+      return saveSnapshot(filename);
+   }
+
+
    bool MultiFormatNavDataFactory ::
    process(const std::string& filename,
            NavDataFactoryCallback& cb)
@@ -100,6 +100,12 @@ namespace gnsstk
                 NavDataPtr& navOut, SVHealth xmitHealth, NavValidityType valid,
                 NavSearchOrder order) override;
 
+         /// @copydoc NavDataFactory::findUntil()
+      bool findUntil(const NavMessageID& nmid, const CommonTime& when,
+                     NavDataPtr& navOut, CommonTime& until,
+                     SVHealth xmitHealth, NavValidityType valid,
+                     NavSearchOrder order) override;
+
          /// @copydoc NavDataFactory::getOffset()
       bool getOffset(TimeSystem fromSys, TimeSystem toSys,
                      const CommonTime& when, NavDataPtr& offset,
@@ -292,6 +298,80 @@ namespace gnsstk
           *   factories succeeded. */
       bool addDataSource(const std::string& source) override;
 
+         /** Load multiple files, decoding them concurrently.  Each
+          * thread decodes whole files, trying the available
+          * factories in the same order as addDataSource(), and the
+          * decoded data are then added to the store one file at a
+          * time in the order given.  The resulting store is the same
+          * as calling addDataSource() on each file in turn.
+          * @param[in] sources The paths of the files to load.
+          * @param[in] threads The number of threads to use for
+          *   decoding.  0 uses the number of hardware threads.
+          * @return true if every file was loaded, false if any file
+          *   could not be loaded by any of the available factories
+          *   (the remaining files are still loaded). */
+      bool addDataSources(const std::vector<std::string>& sources,
+                          unsigned threads = 0);
+
+         /// Build the compact time index in all contained factories.
+      void freeze() override;
+
+         /// Discard the compact time index in all contained factories.
+      void thaw() override;
+
+         /// Return true if all contained factories are frozen.
+      bool isFrozen() const override;
+
+         /** Seal all contained factories.
+          * @see NavDataFactoryWithStore::seal() */
+      void seal() override;
+
+         /// Unseal all contained factories.
+      void unseal() override;
+
+         /// Return true if all contained factories are sealed.
+      bool isSealed() const override;
+
+         /** Set the retention window of all contained factories.
+          * @see NavDataFactoryWithStore::setRetention() */
+      void setRetention(double horizon) override;
+
+         /// Return the sum of the message counts of all contained factories.
+      std::map<NavSignalID, size_t> getMessageCounts() const override;
+
+         /// Return the sum of the change counts of all contained factories.
+      unsigned long getChangeCount() const override;
+
+         /** Write the stores of all contained factories to a
+          * snapshot file, one section per factory.
+          * @copydetails NavDataFactoryWithStore::saveSnapshot() */
+      bool saveSnapshot(const std::string& filename) const override;
+
+         /** Load a snapshot written by saveSnapshot(), adding each
+          * section to the contained factory that wrote it, as
+          * identified by getFactoryFormats().
+          * @param[in] filename The path of the snapshot file to read.
+          * @return true on success, false if the file could not be
+          *   read, a section doesn't match any of the factories or
+          *   any message could not be added. */
+      bool loadSnapshot(const std::string& filename) override;
+
+         /** Decode a set of navigation data files and write a
+          * snapshot that loadSnapshot() can load in their place.
+          * The files are added to the store using addDataSources(),
+          * so the snapshot also contains anything already in the
+          * store.  No snapshot is written if any file fails to
+          * load, so that a snapshot is never silently missing data.
+          * @param[in] filename The path of the snapshot file to write.
+          * @param[in] sources The paths of the files to load.
+          * @param[in] threads The number of threads to use for
+          *   decoding.  0 uses the number of hardware threads.
+          * @return true if every file was loaded and the snapshot
+          *   was written. */
+      bool createSnapshot(const std::string& filename,
+                          const std::vector<std::string>& sources,
+                          unsigned threads = 0);
+
          /// @copydoc NavDataFactoryWithStoreFile::process(const std::string&,NavDataFactoryCallback&)
       bool process(const std::string& filename,
                    NavDataFactoryCallback& cb) override;
@@ -42,6 +42,7 @@
 #include <memory>
 #include <map>
 #include <list>
+#include <vector>
 #include "gnsstk_export.h"
 #include "CommonTime.hpp"
 #include "NavSignalID.hpp"
@@ -79,6 +80,17 @@ namespace gnsstk
    typedef std::map<NavSatelliteID, NavNearMap> NavNearSatMap;
       /// Map nav message type to the rest of the storage.
    typedef std::map<NavMessageType, NavNearSatMap> NavNearMessageMap;
+      /** Time key and nav message pair, the element of the
+       * contiguous time index used by frozen stores. */
+   typedef std::pair<CommonTime, NavDataPtr> NavFlatEntry;
+      /** Time-sorted array of nav messages for a single satellite,
+       * searched with a binary search.  Entries with identical time
+       * keys are adjacent and retain their insertion order. */
+   typedef std::vector<NavFlatEntry> NavFlatMap;
+      /// Map satellite to flat time index.
+   typedef std::map<NavSatelliteID, NavFlatMap> NavFlatSatMap;
+      /// Map nav message type to the rest of the flat storage.
+   typedef std::map<NavMessageType, NavFlatSatMap> NavFlatMessageMap;
 
       /** This is an abstract base class for decoded navigation
        * message data, including orbit information, health data and
@@ -46,6 +46,9 @@ static const std::string dts("%Y/%03j/%02H:%02M:%02S %P");
 
 namespace gnsstk
 {
+   std::atomic<unsigned long> NavDataFactory::sharedChangeCount(0);
+
+
    bool NavDataFactory :: isPresent(const NavMessageID& nmid,
                                     const CommonTime& fromTime,
                                     const CommonTime& toTime)
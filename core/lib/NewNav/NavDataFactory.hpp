@@ -39,6 +39,7 @@
 #ifndef GNSSTK_NAVDATAFACTORY_HPP
 #define GNSSTK_NAVDATAFACTORY_HPP
 
+#include <atomic>
 #include <memory>
 #include <map>
 #include "NavSignalID.hpp"
@@ -93,6 +94,36 @@ namespace gnsstk
                         NavDataPtr& navOut, SVHealth xmitHealth,
                         NavValidityType valid, NavSearchOrder order) = 0;
 
+         /** Search the store like find(), additionally reporting how
+          * long the result can be reused.  This allows callers
+          * evaluating many consecutive times (e.g. NavLibrary's batch
+          * getXvt()) to avoid searching the store at every time.
+          * The default implementation calls find() and sets \a until
+          * to \a when, i.e. no reuse is possible.
+          * @param[in] nmid Specify the message type, satellite and
+          *   codes to match.
+          * @param[in] when The time of interest to search for data.
+          * @param[out] navOut The resulting navigation message.
+          * @param[out] until find() with the same arguments is
+          *   guaranteed to yield the same result (including failure)
+          *   for any time t where when <= t < until, as long as the
+          *   store is not modified.
+          * @param[in] xmitHealth The desired health status of the
+          *   transmitting satellite.
+          * @param[in] valid Specify whether to search only for valid
+          *   or invalid messages, or both.
+          * @param[in] order Specify whether to search by receiver
+          *   behavior or by nearest to when in time.
+          * @return true if successful.  If false, navData will be untouched. */
+      virtual bool findUntil(const NavMessageID& nmid, const CommonTime& when,
+                             NavDataPtr& navOut, CommonTime& until,
+                             SVHealth xmitHealth, NavValidityType valid,
+                             NavSearchOrder order)
+      {
+         until = when;
+         return find(nmid, when, navOut, xmitHealth, valid, order);
+      }
+
          /** Get the offset, in seconds, to apply to times when
           * converting them from fromSys to toSys.
           * @pre If xmithHealth is set to anything other than "Any",
@@ -216,6 +247,28 @@ namespace gnsstk
       virtual void clear()
       {}
 
+         /** Return a count that changes every time the data
+          * available to find() changes, e.g. by adding, editing or
+          * clearing data.  This allows users of findUntil() results
+          * to detect when they have become stale.  Factories without
+          * a modifiable store return 0. */
+      virtual unsigned long getChangeCount() const
+      { return 0; }
+
+         /** Return a count that is shared by all factories and
+          * changes whenever any of their change counts do, or a
+          * factory is added to a NavLibrary or
+          * MultiFormatNavDataFactory.  Unlike getChangeCount() on a
+          * NavLibrary, this costs the same regardless of the number
+          * of factories, at the price of also changing when an
+          * unrelated factory does. */
+      static unsigned long getSharedChangeCount()
+      { return sharedChangeCount.load(std::memory_order_relaxed); }
+
+         /// Change the value returned by getSharedChangeCount().
+      static void bumpSharedChangeCount()
+      { sharedChangeCount.fetch_add(1, std::memory_order_relaxed); }
+
          /** Determine the earliest time for which this object can successfully
           * determine the Xvt for any object.
           * @return The initial time, or CommonTime::END_OF_TIME if no
@@ -392,6 +445,10 @@ namespace gnsstk
          /** Determines which types of navigation message data the
           * factory should be processing. */
       NavMessageTypeSet procNavTypes;
+
+   private:
+         /// Returned by getSharedChangeCount().
+      static std::atomic<unsigned long> sharedChangeCount;
    };
 
       /// Managed pointer to NavDataFactory.
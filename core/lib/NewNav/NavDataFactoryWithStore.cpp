@@ -36,8 +36,10 @@
 //                            release, distribution is unlimited.
 //
 //==============================================================================
+#include <algorithm>
 #include <iterator>
 #include "NavDataFactoryWithStore.hpp"
+#include "NavSnapshot.hpp"
 #include "TimeString.hpp"
 #include "OrbitDataKepler.hpp"
 #include "NavHealthData.hpp"
@@ -51,8 +53,50 @@ static const std::string dts("%Y/%03j/%02H:%02M:%02S %P");
 
 namespace gnsstk
 {
+      /** Get the containers in satMap whose NavSatelliteID key
+       * matches the wildcard NavMessageID nmid, in key order.  The
+       * linear search of satMap is only done the first time a given
+       * nmid is used, the result is cached for subsequent calls.
+       * @param[in] satMap The map of NavSatelliteID to per-satellite
+       *   time index to search.
+       * @param[in,out] cache The cache of previously resolved matches.
+       * @param[in] nmid The (wildcard) message ID to match.
+       * @param[in] mtx If not null, the mutex to hold while
+       *   accessing cache.  The returned reference remains valid
+       *   after the mutex is released, as entries are never changed
+       *   or removed once added until the cache is cleared.
+       * @return The matching per-satellite containers. */
+   template <class SatMap, class Cache>
+   static const typename Cache::mapped_type&
+   resolveWild(SatMap& satMap, Cache& cache, const NavMessageID& nmid,
+               std::mutex* mtx)
+   {
+      std::unique_lock<std::mutex> lock;
+      if (mtx != nullptr)
+      {
+         lock = std::unique_lock<std::mutex>(*mtx);
+      }
+      auto ci = cache.find(nmid);
+      if (ci != cache.end())
+      {
+         return ci->second;
+      }
+      typename Cache::mapped_type& rv(cache[nmid]);
+      for (auto& sati : satMap)
+      {
+         if (sati.first == nmid)
+         {
+            DEBUGTRACE("matches " << sati.first);
+            rv.push_back(&(sati.second));
+         }
+      }
+      return rv;
+   }
+
+
    NavDataFactoryWithStore ::
    NavDataFactoryWithStore()
+         : frozen(false), sealed(false), changeCount(0), retention(0)
    {
          // We are NOT using END_OF_TIME or BEGINNING_OF_TIME here
          // because of issues with static initialization order.  As
@@ -61,6 +105,7 @@ namespace gnsstk
          // this class) will be initialized prior to this constructor.
       initialTime.set(3442448L,0,0.0,TimeSystem::Any);
       finalTime.set(0,0,0.0,TimeSystem::Any);
+      retainNewest.set(0,0,0.0,TimeSystem::Any);
    }
 
 
@@ -101,6 +146,78 @@ namespace gnsstk
    }
 
 
+   bool NavDataFactoryWithStore ::
+   findUntil(const NavMessageID& nmid, const CommonTime& when,
+             NavDataPtr& navOut, CommonTime& until, SVHealth xmitHealth,
+             NavValidityType valid, NavSearchOrder order)
+   {
+      DEBUGTRACE_FUNCTION();
+      bool rv = find(nmid, when, navOut, xmitHealth, valid, order);
+      until = when;
+      if (order != NavSearchOrder::User)
+      {
+            // Nearest results can change at any time, don't bother.
+         return rv;
+      }
+      CommonTime limit = CommonTime::END_OF_TIME;
+      limit.setTimeSystem(TimeSystem::Any);
+      auto dataIt = data.find(nmid.messageType);
+      if (dataIt != data.end())
+      {
+            // Look at the same set of maps that findUser() does.
+         std::vector<NavMap*> exact;
+         const std::vector<NavMap*> *maps = &exact;
+         if (nmid.isWild())
+         {
+            maps = &resolveWild(dataIt->second, userMatches, nmid,
+                                matchMutexIfSealed());
+         }
+         else
+         {
+            auto sati = dataIt->second.find(nmid);
+            if (sati != dataIt->second.end())
+            {
+               exact.push_back(&(sati->second));
+            }
+         }
+         for (NavMap *nmp : *maps)
+         {
+            NavMap::iterator nmi = nmp->upper_bound(when);
+            if ((nmi != nmp->end()) && (nmi->first < limit))
+            {
+               limit = nmi->first;
+            }
+            if (nmi == nmp->begin())
+            {
+               continue;
+            }
+            const NavDataPtr& latest(std::prev(nmi)->second);
+               // Data at or before when that wasn't chosen may
+               // become the result later (e.g. once inside its fit
+               // interval), so there's no telling how long the
+               // result is good for.
+            if (!rv || ((latest != navOut) &&
+                        (latest->getUserTime() >= navOut->getUserTime())))
+            {
+               DEBUGTRACE("no reuse");
+               return rv;
+            }
+         }
+      }
+      if (rv)
+      {
+         NavFit *nf = dynamic_cast<NavFit*>(navOut.get());
+         if ((nf != nullptr) && (nf->endFit < limit))
+         {
+            limit = nf->endFit;
+         }
+      }
+      until = limit;
+      DEBUGTRACE("until = " << printTime(until, dts));
+      return rv;
+   }
+
+
    bool NavDataFactoryWithStore ::
    findUser(const NavMessageID& nmid, const CommonTime& when,
             NavDataPtr& navData, SVHealth xmitHealth,
@@ -108,6 +225,10 @@ namespace gnsstk
    {
       DEBUGTRACE_FUNCTION();
       DEBUGTRACE("class: " << getClassName());
+      if (frozen)
+      {
+         return findUserFrozen(nmid, when, navData, xmitHealth, valid);
+      }
          /** Class for gathering matches in findUser().  It's only
           * used in findUser so it is declared and implemented here
           * alone. */
@@ -147,42 +268,32 @@ namespace gnsstk
       if (nmid.isWild())
       {
          DEBUGTRACE("wildcard search: " << nmid);
-         for (NavSatMap::iterator sati = dataIt->second.begin();
-              sati != dataIt->second.end(); sati++)
+         for (NavMap *nmp : resolveWild(dataIt->second, userMatches, nmid,
+                                        matchMutexIfSealed()))
          {
-            if (sati->first != nmid)
-            {
-               DEBUGTRACE(sati->first << " != " << nmid);
-               continue; // skip non matches
-            }
-            DEBUGTRACE("matches " << sati->first);
-            NavMap::iterator nmi = sati->second.lower_bound(when);
-            if (nmi == sati->second.end())
+            NavMap& nm(*nmp);
+            NavMap::iterator nmi = nm.lower_bound(when);
+            if (nmi == nm.end())
             {
                nmi = std::prev(nmi);
             }
             DEBUGTRACE("user time : "
                        << gnsstk::printTime(nmi->second->getUserTime(),dts));
-            DEBUGTRACE("(nmi != sati->second.end()) = "
-                       << (nmi != sati->second.end()));
-            DEBUGTRACE("(nmi->second->getUserTime() > when) = "
-                       << (nmi->second->getUserTime() > when));
-            while ((nmi != sati->second.end()) &&
+            while ((nmi != nm.end()) &&
                    (nmi->second->getUserTime() > when))
             {
                DEBUGTRACE("backing up (maybe)");
-               nmi = (nmi == sati->second.begin() ? sati->second.end()
-                      : std::prev(nmi));
-               if (nmi != sati->second.end())
+               nmi = (nmi == nm.begin() ? nm.end() : std::prev(nmi));
+               if (nmi != nm.end())
                {
                   DEBUGTRACE("user time : "
                              << gnsstk::printTime(nmi->second->getUserTime(),
                                                   dts));
                }
             }
-            if (nmi != sati->second.end())
+            if (nmi != nm.end())
             {
-               itList.push_back(FindMatches(&(sati->second), nmi));
+               itList.push_back(FindMatches(nmp, nmi));
             }
             else
             {
@@ -294,6 +405,10 @@ namespace gnsstk
    {
       DEBUGTRACE_FUNCTION();
       DEBUGTRACE("class: " << getClassName());
+      if (frozen)
+      {
+         return findNearestFrozen(nmid, when, navData, xmitHealth, valid);
+      }
          /** Class for gathering matches in findNearest().  It's only
           * used in findNearest so it is declared and implemented here
           * alone. */
@@ -346,15 +461,12 @@ namespace gnsstk
       if (nmid.isWild())
       {
          DEBUGTRACE("wildcard search: " << nmid);
-         for (NavNearSatMap::iterator sati = dataIt->second.begin();
-              sati != dataIt->second.end(); sati++)
+         for (NavNearMap *nmp : resolveWild(dataIt->second, nearMatches,
+                                            nmid, matchMutexIfSealed()))
          {
-            if (sati->first != nmid)
-               continue; // skip non matches
-            DEBUGTRACE("matches " << sati->first);
             DEBUGTRACE("when = " << gnsstk::printTime(when,dts));
-            NavNearMap::iterator nmi = sati->second.lower_bound(when);
-            itList.push_back(FindMatches(&(sati->second), nmi, when));
+            NavNearMap::iterator nmi = nmp->lower_bound(when);
+            itList.push_back(FindMatches(nmp, nmi, when));
          }
       }
       else
@@ -435,6 +547,366 @@ namespace gnsstk
    }
 
 
+   bool NavDataFactoryWithStore ::
+   findUserFrozen(const NavMessageID& nmid, const CommonTime& when,
+                  NavDataPtr& navData, SVHealth xmitHealth,
+                  NavValidityType valid)
+   {
+      DEBUGTRACE_FUNCTION();
+         /** Class for gathering matches in findUserFrozen().  This is
+          * the same as the FindMatches class in findUser() except it
+          * uses an array index in place of a map iterator, where an
+          * index of -1 is the equivalent of map::end(). */
+      class FindMatches
+      {
+      public:
+         FindMatches(const NavFlatMap *theMap, long theIdx)
+               : map(theMap), finished(false), idx(theIdx)
+         {}
+         const NavFlatMap *map;
+         bool finished;
+         long idx;
+      };
+      typedef std::vector<FindMatches> MatchList;
+
+      DEBUGTRACE("nmid=" << nmid << "  when=" << gnsstk::printTime(when,dts));
+
+      auto dataIt = frozenData.find(nmid.messageType);
+      if (dataIt == frozenData.end())
+      {
+         DEBUGTRACE("false = not found 1");
+         return false; // not found.
+      }
+         // The array is keyed by user time, so the most recent
+         // message at or before when is the one immediately
+         // preceding upper_bound.
+      auto latest = [&when](const NavFlatMap& fm) -> long
+      {
+         auto nmi = std::upper_bound(
+            fm.begin(), fm.end(), when,
+            [](const CommonTime& t, const NavFlatEntry& e)
+            { return t < e.first; });
+         return static_cast<long>(nmi - fm.begin()) - 1;
+      };
+      MatchList itList;
+      if (nmid.isWild())
+      {
+         DEBUGTRACE("wildcard search: " << nmid);
+         for (const NavFlatMap *fmp :
+                 resolveWild(dataIt->second, frozenUserMatches, nmid,
+                             matchMutexIfSealed()))
+         {
+            long idx = latest(*fmp);
+            if (idx >= 0)
+            {
+               itList.push_back(FindMatches(fmp, idx));
+            }
+         }
+      }
+      else
+      {
+         DEBUGTRACE("non-wildcard search: " << nmid);
+         auto sati = dataIt->second.find(nmid);
+         if (sati != dataIt->second.end())
+         {
+            long idx = latest(sati->second);
+            if (idx >= 0)
+            {
+               itList.push_back(FindMatches(&(sati->second), idx));
+            }
+         }
+      }
+      DEBUGTRACE("itList.size() = " << itList.size());
+         // The remainder is the same algorithm as findUser().
+      gnsstk::CommonTime mostRecent = gnsstk::CommonTime::BEGINNING_OF_TIME;
+      mostRecent.setTimeSystem(gnsstk::TimeSystem::Any);
+      bool done = itList.empty();
+      bool rv = false;
+      while (!done)
+      {
+         for (auto& imi : itList)
+         {
+            done = true; // default to being done.  Gets reset to false below.
+            if (imi.finished)
+            {
+                  // no need to process this iterator any further
+               continue;
+            }
+            else if ((imi.idx >= 0) && ((*imi.map)[imi.idx].first < mostRecent))
+            {
+                  // Data is less recent than the most recent good data, so stop
+                  // processing this iterator.
+               imi.finished = true;
+            }
+            else if ((imi.idx >= 0) &&
+                     (((*imi.map)[imi.idx].first > when) ||
+                      !validityCheck((*imi.map)[imi.idx].second, valid,
+                                     xmitHealth, when)))
+            {
+               imi.idx--;
+               done = false;
+            }
+            else if (imi.idx < 0)
+            {
+                  // give up.
+               imi.finished = true;
+            }
+            else
+            {
+               const NavFlatEntry& fe((*imi.map)[imi.idx]);
+               DEBUGTRACE("Found something good at "
+                          << printTime(fe.first, dts));
+               if (fe.first > mostRecent)
+               {
+                  mostRecent = fe.first;
+                  navData = fe.second;
+               }
+               imi.finished = true;
+               rv = true;
+            }
+         }
+      }
+      DEBUGTRACE("Most recent = " << printTime(mostRecent, dts));
+      return rv;
+   }
+
+
+   bool NavDataFactoryWithStore ::
+   findNearestFrozen(const NavMessageID& nmid, const CommonTime& when,
+                     NavDataPtr& navData, SVHealth xmitHealth,
+                     NavValidityType valid)
+   {
+      DEBUGTRACE_FUNCTION();
+         /** Class for gathering matches in findNearestFrozen().  Each
+          * time key in NavNearMap corresponds to a run of adjacent
+          * entries in NavFlatMap, so the iterators of findNearest()
+          * become the index of the first entry of a run, with the
+          * size of the array the equivalent of map::end(). */
+      class FindMatches
+      {
+      public:
+         FindMatches(const NavFlatMap *theMap, size_t theGT)
+               : map(theMap), end(theMap->size()), idxGT(theGT),
+                 idxLT(prevRun(theGT))
+         {}
+            /// Return the index of the first entry of the prior run.
+         size_t prevRun(size_t idx) const
+         { return (idx == 0 ? end : runStart(idx-1)); }
+            /// Return the index of the first entry of the next run.
+         size_t nextRun(size_t idx) const
+         {
+            const CommonTime& key((*map)[idx].first);
+            while ((idx < end) && ((*map)[idx].first == key))
+               idx++;
+            return idx;
+         }
+            /// Return the index of the first entry of the run with idx.
+         size_t runStart(size_t idx) const
+         {
+            const CommonTime& key((*map)[idx].first);
+            while ((idx > 0) && ((*map)[idx-1].first == key))
+               idx--;
+            return idx;
+         }
+         const NavFlatMap *map;
+         size_t end;
+         size_t idxGT, idxLT;
+      };
+      typedef std::vector<FindMatches> MatchList;
+
+      auto dataIt = frozenNearestData.find(nmid.messageType);
+      if (dataIt == frozenNearestData.end())
+      {
+         DEBUGTRACE(" false = not found 1");
+         return false; // not found.
+      }
+      auto lowerBound = [&when](const NavFlatMap& fm) -> size_t
+      {
+         auto nmi = std::lower_bound(
+            fm.begin(), fm.end(), when,
+            [](const NavFlatEntry& e, const CommonTime& t)
+            { return e.first < t; });
+         return static_cast<size_t>(nmi - fm.begin());
+      };
+      MatchList itList;
+      if (nmid.isWild())
+      {
+         DEBUGTRACE("wildcard search: " << nmid);
+         for (const NavFlatMap *fmp :
+                 resolveWild(dataIt->second, frozenNearMatches, nmid,
+                             matchMutexIfSealed()))
+         {
+            itList.push_back(FindMatches(fmp, lowerBound(*fmp)));
+         }
+      }
+      else
+      {
+         DEBUGTRACE("non-wildcard search: " << nmid);
+         auto sati = dataIt->second.find(nmid);
+         if (sati != dataIt->second.end())
+         {
+            itList.push_back(FindMatches(&(sati->second),
+                                         lowerBound(sati->second)));
+         }
+      }
+         // The remainder is the same algorithm as findNearest().
+      bool done = itList.empty();
+      while (!done)
+      {
+         for (auto& imi : itList)
+         {
+            done = true; // default to being done.  Gets reset to false below.
+            if ((imi.idxGT == imi.end) && (imi.idxLT == imi.end))
+            {
+                  // nothing more to do, we've reached the end of both
+                  // directions
+               break;
+            }
+            const NavFlatMap& fm(*imi.map);
+            if ((imi.idxGT != imi.end) &&
+                ((imi.idxLT == imi.end) ||
+                 (fabs(fm[imi.idxGT].first - when) <
+                  fabs(fm[imi.idxLT].first - when))))
+            {
+                  // time for idxGT is nearer to time of interest, try it first.
+               size_t next = imi.nextRun(imi.idxGT);
+               for (size_t i = imi.idxGT; i < next; i++)
+               {
+                  if (validityCheck(fm[i].second, valid, xmitHealth, when))
+                  {
+                     navData = fm[i].second;
+                     return true;
+                  }
+               }
+               done = false;
+               imi.idxGT = next;
+            }
+            else
+            {
+                  // time for idxLT is nearer to time of interest, try it first.
+               size_t next = imi.nextRun(imi.idxLT);
+               for (size_t i = imi.idxLT; i < next; i++)
+               {
+                  if (validityCheck(fm[i].second, valid, xmitHealth, when))
+                  {
+                     navData = fm[i].second;
+                     return true;
+                  }
+               }
+               done = false;
+               imi.idxLT = imi.prevRun(imi.idxLT);
+            }
+         }
+      }
+      return false;
+   }
+
+
+   const NavNearMessageMap& NavDataFactoryWithStore ::
+   getNavNearMessageMap() const
+   {
+      if (frozen)
+      {
+         InvalidRequest exc("The Nearest map is not available while the"
+                            " store is frozen");
+         GNSSTK_THROW(exc);
+      }
+      return nearestData;
+   }
+
+
+   void NavDataFactoryWithStore ::
+   freeze()
+   {
+      thaw();
+      for (const auto& mti : data)
+      {
+         NavFlatSatMap& fsm(frozenData[mti.first]);
+         for (const auto& sati : mti.second)
+         {
+            fsm[sati.first].assign(sati.second.begin(), sati.second.end());
+         }
+      }
+      for (auto& mti : nearestData)
+      {
+         NavFlatSatMap& fsm(frozenNearestData[mti.first]);
+         for (auto& sati : mti.second)
+         {
+            NavFlatMap& fm(fsm[sati.first]);
+            size_t count = 0;
+            for (const auto& nnmi : sati.second)
+            {
+               count += nnmi.second.size();
+            }
+            fm.reserve(count);
+            for (const auto& nnmi : sati.second)
+            {
+               for (const auto& ndp : nnmi.second)
+               {
+                  fm.push_back(NavFlatEntry(nnmi.first, ndp));
+               }
+            }
+               // The flat index holds everything in the Nearest map,
+               // so release the map's nodes as we go rather than
+               // keeping two copies.  thaw() puts them back.
+            sati.second.clear();
+         }
+      }
+      nearestData.clear();
+      frozen = true;
+   }
+
+
+   void NavDataFactoryWithStore ::
+   thaw()
+   {
+      sealed = false;
+      if (frozen)
+      {
+            // Restore the Nearest map released by freeze().  Entries
+            // with the same key are adjacent and in list order.
+         for (const auto& mti : frozenNearestData)
+         {
+            NavNearSatMap& nsm(nearestData[mti.first]);
+            for (const auto& sati : mti.second)
+            {
+               NavNearMap& nm(nsm[sati.first]);
+               for (const auto& fei : sati.second)
+               {
+                  nm.emplace_hint(nm.end(), fei.first, NavDataPtrList())
+                     ->second.push_back(fei.second);
+               }
+            }
+         }
+      }
+      frozenData.clear();
+      frozenNearestData.clear();
+      frozen = false;
+      userMatches.clear();
+      nearMatches.clear();
+      frozenUserMatches.clear();
+      frozenNearMatches.clear();
+   }
+
+
+   void NavDataFactoryWithStore ::
+   seal()
+   {
+      if (!frozen)
+      {
+         freeze();
+      }
+      sealed = true;
+   }
+
+
+   void NavDataFactoryWithStore ::
+   unseal()
+   {
+      sealed = false;
+   }
+
+
    bool NavDataFactoryWithStore ::
    getOffset(TimeSystem fromSys, TimeSystem toSys,
              const CommonTime& when, NavDataPtr& offset,
@@ -555,6 +1027,8 @@ namespace gnsstk
    void NavDataFactoryWithStore ::
    edit(const CommonTime& fromTime, const CommonTime& toTime)
    {
+      thaw();
+      noteChange();
          // edit transmit time storage
       for (auto mti = data.begin(); mti != data.end();)
       {
@@ -677,6 +1151,7 @@ namespace gnsstk
             ++ocmi;
          }
       }
+      rebuildRetention();
    }
 
 
@@ -684,6 +1159,8 @@ namespace gnsstk
    edit(const CommonTime& fromTime, const CommonTime& toTime,
         const NavSatelliteID& satID)
    {
+      thaw();
+      noteChange();
          // edit transmit time storage
       for (auto mti = data.begin(); mti != data.end();)
       {
@@ -824,6 +1301,7 @@ namespace gnsstk
             ++ocmi;
          }
       }
+      rebuildRetention();
    }
 
 
@@ -839,11 +1317,17 @@ namespace gnsstk
    void NavDataFactoryWithStore ::
    clear()
    {
+      thaw();
+      noteChange();
       data.clear();
       nearestData.clear();
       offsetData.clear();
+      retainQueue.clear();
+      messageCounts.clear();
       initialTime = gnsstk::CommonTime::END_OF_TIME;
       finalTime = gnsstk::CommonTime::BEGINNING_OF_TIME;
+      retainNewest = gnsstk::CommonTime::BEGINNING_OF_TIME;
+      retainNewest.setTimeSystem(TimeSystem::Any);
    }
 
 
@@ -935,11 +1419,30 @@ namespace gnsstk
             // reference time to update initial/final time.
          if (!updateInitialFinal(odp->timeStamp,odp->timeStamp))
             return false;
+      }
+         // The compact index is no longer accurate if we're adding
+         // to our own store.
+      bool ours = ((&navMap == &data) || (&navNearMap == &nearestData));
+      if (ours)
+      {
+         noteChange();
+         if (frozen)
+         {
+            thaw();
+         }
       }
          // always add to navMap/navNearMap
-      navMap[nd->signal.messageType][nd->signal][nd->getUserTime()] = nd;
-      navNearMap[nd->signal.messageType][nd->signal][nd->getNearTime()]
-         .push_back(nd);
+      NavSatMap& navSatMap(navMap[nd->signal.messageType]);
+      NavNearSatMap& navNearSatMap(navNearMap[nd->signal.messageType]);
+      size_t numSats = navSatMap.size() + navNearSatMap.size();
+      navSatMap[nd->signal][nd->getUserTime()] = nd;
+      navNearSatMap[nd->signal][nd->getNearTime()].push_back(nd);
+         // A new satellite/signal may match previously resolved
+         // wildcard searches.
+      if (ours && (numSats != (navSatMap.size() + navNearSatMap.size())))
+      {
+         thaw();
+      }
          // TimeOffsetData has its own special map for look-up.
       if ((todp = dynamic_cast<TimeOffsetData*>(nd.get())) != nullptr)
       {
@@ -949,6 +1452,319 @@ namespace gnsstk
             ofsMap[ci][nd->getUserTime()][nd->signal] = nd;
          }
       }
+      if (ours)
+      {
+         messageCounts[nd->signal]++;
+         if (retention > 0)
+         {
+            CommonTime anyTimeStamp(nd->timeStamp);
+            anyTimeStamp.setTimeSystem(TimeSystem::Any);
+            if (anyTimeStamp > retainNewest)
+            {
+               retainNewest = anyTimeStamp;
+            }
+            retainQueue.push_back(nd);
+            evictExpired();
+         }
+      }
+      return true;
+   }
+
+
+   void NavDataFactoryWithStore ::
+   setRetention(double horizon)
+   {
+      retention = horizon;
+      rebuildRetention();
+      evictExpired();
+   }
+
+
+   void NavDataFactoryWithStore ::
+   evictExpired()
+   {
+      if (retainQueue.empty())
+      {
+         return;
+      }
+      CommonTime cutoff(retainNewest - retention);
+      bool evicted = false, satRemoved = false;
+      while (!retainQueue.empty())
+      {
+         CommonTime anyTimeStamp(retainQueue.front()->timeStamp);
+         anyTimeStamp.setTimeSystem(TimeSystem::Any);
+         if (anyTimeStamp >= cutoff)
+         {
+            break;
+         }
+         if (removeNavData(retainQueue.front()))
+         {
+            satRemoved = true;
+         }
+         retainQueue.pop_front();
+         evicted = true;
+      }
+      if (!evicted)
+      {
+         return;
+      }
+      noteChange();
+         // Removed satellites invalidate the cached wildcard matches.
+      if (satRemoved || frozen)
+      {
+         thaw();
+      }
+   }
+
+
+   bool NavDataFactoryWithStore ::
+   removeNavData(const NavDataPtr& nd)
+   {
+      bool rv = false;
+      if (frozen)
+      {
+         thaw();
+      }
+      NavMessageType nmt = nd->signal.messageType;
+         // The User map only refers to nd if it wasn't replaced by a
+         // later message with the same time.
+      auto mti = data.find(nmt);
+      if (mti != data.end())
+      {
+         auto sati = mti->second.find(nd->signal);
+         if (sati != mti->second.end())
+         {
+            auto ti = sati->second.find(nd->getUserTime());
+            if ((ti != sati->second.end()) && (ti->second == nd))
+            {
+               sati->second.erase(ti);
+                  // clean out empty maps
+               if (sati->second.empty())
+               {
+                  mti->second.erase(sati);
+                  rv = true;
+                  if (mti->second.empty())
+                  {
+                     data.erase(mti);
+                  }
+               }
+            }
+         }
+      }
+      auto nmti = nearestData.find(nmt);
+      if (nmti != nearestData.end())
+      {
+         auto sati = nmti->second.find(nd->signal);
+         if (sati != nmti->second.end())
+         {
+            auto ti = sati->second.find(nd->getNearTime());
+            if (ti != sati->second.end())
+            {
+               auto ndpli = std::find(ti->second.begin(), ti->second.end(),
+                                      nd);
+               if (ndpli != ti->second.end())
+               {
+                  ti->second.erase(ndpli);
+                  auto sci = messageCounts.find(nd->signal);
+                  if ((sci != messageCounts.end()) && (--sci->second == 0))
+                  {
+                     messageCounts.erase(sci);
+                  }
+                     // clean out empty maps
+                  if (ti->second.empty())
+                  {
+                     sati->second.erase(ti);
+                     if (sati->second.empty())
+                     {
+                        nmti->second.erase(sati);
+                        rv = true;
+                        if (nmti->second.empty())
+                        {
+                           nearestData.erase(nmti);
+                        }
+                     }
+                  }
+               }
+            }
+         }
+      }
+      TimeOffsetData *todp = dynamic_cast<TimeOffsetData*>(nd.get());
+      if (todp == nullptr)
+      {
+         return rv;
+      }
+      for (const auto& ci : todp->getConversions())
+      {
+         auto ocmi = offsetData.find(ci);
+         if (ocmi == offsetData.end())
+         {
+            continue;
+         }
+         auto cti = ocmi->second.find(nd->getUserTime());
+         if (cti == ocmi->second.end())
+         {
+            continue;
+         }
+         auto sati = cti->second.find(nd->signal);
+         if ((sati != cti->second.end()) && (sati->second == nd))
+         {
+            cti->second.erase(sati);
+               // clean out empty maps
+            if (cti->second.empty())
+            {
+               ocmi->second.erase(cti);
+               if (ocmi->second.empty())
+               {
+                  offsetData.erase(ocmi);
+               }
+            }
+         }
+      }
+         // Forget evicted offsets when filtering duplicates, so that
+         // a later retransmission of the same offset is kept.
+      if (auto stodp = std::dynamic_pointer_cast<StdNavTimeOffset>(nd))
+      {
+         TOUSet* sets[] = { nullptr, nullptr };
+         auto svi = touBySV.find(nd->signal.xmitSat);
+         if (svi != touBySV.end())
+            sets[0] = &svi->second;
+         auto sigi = touBySig.find(nd->signal);
+         if (sigi != touBySig.end())
+            sets[1] = &sigi->second;
+         for (TOUSet* tou : sets)
+         {
+            if (tou == nullptr)
+               continue;
+            auto toui = tou->find(stodp);
+            if ((toui != tou->end()) && (*toui == stodp))
+            {
+               tou->erase(toui);
+            }
+         }
+      }
+      return rv;
+   }
+
+
+   void NavDataFactoryWithStore ::
+   rebuildRetention()
+   {
+      if (frozen)
+      {
+         thaw();
+      }
+      messageCounts.clear();
+      retainQueue.clear();
+      retainNewest = gnsstk::CommonTime::BEGINNING_OF_TIME;
+      retainNewest.setTimeSystem(TimeSystem::Any);
+         // Use the Nearest map, as it keeps every message that was
+         // added, including those with the same User time as another.
+      std::vector<std::pair<CommonTime,NavDataPtr> > sorted;
+      for (const auto& mti : nearestData)
+      {
+         for (const auto& sati : mti.second)
+         {
+            for (const auto& ti : sati.second)
+            {
+               messageCounts[sati.first] += ti.second.size();
+               if (retention <= 0)
+               {
+                  continue;
+               }
+               for (const auto& ndp : ti.second)
+               {
+                  CommonTime anyTimeStamp(ndp->timeStamp);
+                  anyTimeStamp.setTimeSystem(TimeSystem::Any);
+                  sorted.push_back(std::make_pair(anyTimeStamp, ndp));
+               }
+            }
+         }
+      }
+      if (sorted.empty())
+      {
+         return;
+      }
+      std::stable_sort(sorted.begin(), sorted.end(),
+                       [](const std::pair<CommonTime,NavDataPtr>& l,
+                          const std::pair<CommonTime,NavDataPtr>& r)
+                       { return l.first < r.first; });
+      for (const auto& si : sorted)
+      {
+         retainQueue.push_back(si.second);
+      }
+      retainNewest = sorted.back().first;
+   }
+
+
+   bool NavDataFactoryWithStore ::
+   saveSnapshot(const std::string& filename) const
+   {
+      NavSnapshot::SectionList sections(1);
+      sections[0].first = getFactoryFormats();
+      if (!getSnapshotData(sections[0].second))
+         return false;
+      return NavSnapshot::write(filename, sections);
+   }
+
+
+   bool NavDataFactoryWithStore ::
+   loadSnapshot(const std::string& filename)
+   {
+      NavSnapshot::SectionList sections;
+      if (!NavSnapshot::read(filename, sections))
+         return false;
+      for (const auto& sec : sections)
+      {
+         if (!addSnapshotData(sec.second))
+            return false;
+      }
+      return true;
+   }
+
+
+   bool NavDataFactoryWithStore ::
+   getSnapshotData(NavDataPtrList& navList) const
+   {
+         // Use the Nearest map, as it keeps every message that was
+         // added, including those with the same User time as another.
+         // The flat index holds the same messages in the same order.
+      if (frozen)
+      {
+         for (const auto& mti : frozenNearestData)
+         {
+            for (const auto& sati : mti.second)
+            {
+               for (const auto& fei : sati.second)
+               {
+                  navList.push_back(fei.second);
+               }
+            }
+         }
+         return true;
+      }
+      for (const auto& mti : nearestData)
+      {
+         for (const auto& sati : mti.second)
+         {
+            for (const auto& ti : sati.second)
+            {
+               navList.insert(navList.end(), ti.second.begin(),
+                              ti.second.end());
+            }
+         }
+      }
+      return true;
+   }
+
+
+   bool NavDataFactoryWithStore ::
+   addSnapshotData(const NavDataPtrList& navList)
+   {
+      for (const auto& nd : navList)
+      {
+         if (!addNavData(nd))
+            return false;
+      }
       return true;
    }
 
@@ -1509,6 +2325,51 @@ namespace gnsstk
    } // NavDataFactoryWithStore::dump()
 
 
+   bool NavDataFactoryWithStore::ExactNMIDLess ::
+   operator()(const NavMessageID& left, const NavMessageID& right) const
+   {
+         // This is used for every cache look-up, so keep it to
+         // simple field comparisons.
+      if (left.messageType < right.messageType) return true;
+      if (right.messageType < left.messageType) return false;
+      if (left.sat.id < right.sat.id) return true;
+      if (right.sat.id < left.sat.id) return false;
+      if (left.sat.wildId < right.sat.wildId) return true;
+      if (right.sat.wildId < left.sat.wildId) return false;
+      if (left.sat.system < right.sat.system) return true;
+      if (right.sat.system < left.sat.system) return false;
+      if (left.sat.wildSys < right.sat.wildSys) return true;
+      if (right.sat.wildSys < left.sat.wildSys) return false;
+      if (left.xmitSat.id < right.xmitSat.id) return true;
+      if (right.xmitSat.id < left.xmitSat.id) return false;
+      if (left.xmitSat.wildId < right.xmitSat.wildId) return true;
+      if (right.xmitSat.wildId < left.xmitSat.wildId) return false;
+      if (left.xmitSat.system < right.xmitSat.system) return true;
+      if (right.xmitSat.system < left.xmitSat.system) return false;
+      if (left.xmitSat.wildSys < right.xmitSat.wildSys) return true;
+      if (right.xmitSat.wildSys < left.xmitSat.wildSys) return false;
+      if (left.system < right.system) return true;
+      if (right.system < left.system) return false;
+      if (left.obs.type < right.obs.type) return true;
+      if (right.obs.type < left.obs.type) return false;
+      if (left.obs.band < right.obs.band) return true;
+      if (right.obs.band < left.obs.band) return false;
+      if (left.obs.code < right.obs.code) return true;
+      if (right.obs.code < left.obs.code) return false;
+      if (left.obs.xmitAnt < right.obs.xmitAnt) return true;
+      if (right.obs.xmitAnt < left.obs.xmitAnt) return false;
+      if (left.obs.freqOffs < right.obs.freqOffs) return true;
+      if (right.obs.freqOffs < left.obs.freqOffs) return false;
+      if (left.obs.freqOffsWild < right.obs.freqOffsWild) return true;
+      if (right.obs.freqOffsWild < left.obs.freqOffsWild) return false;
+      if (left.obs.getMcodeBits() < right.obs.getMcodeBits()) return true;
+      if (right.obs.getMcodeBits() < left.obs.getMcodeBits()) return false;
+      if (left.obs.getMcodeMask() < right.obs.getMcodeMask()) return true;
+      if (right.obs.getMcodeMask() < left.obs.getMcodeMask()) return false;
+      return (left.nav < right.nav);
+   }
+
+
    bool NavDataFactoryWithStore::UniqueTimeOffset ::
    operator()(const std::shared_ptr<StdNavTimeOffset>& left,
               const std::shared_ptr<StdNavTimeOffset>& right) const
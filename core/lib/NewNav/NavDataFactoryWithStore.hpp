@@ -39,6 +39,8 @@
 #ifndef GNSSTK_NAVDATAFACTORYWITHSTORE_HPP
 #define GNSSTK_NAVDATAFACTORYWITHSTORE_HPP
 
+#include <deque>
+#include <mutex>
 #include "NavDataFactory.hpp"
 #include "TimeOffsetData.hpp"
 #include "StdNavTimeOffset.hpp"
@@ -104,6 +106,16 @@ namespace gnsstk
                 NavDataPtr& navOut, SVHealth xmitHealth, NavValidityType valid,
                 NavSearchOrder order) override;
 
+         /** @copydoc NavDataFactory::findUntil()
+          * @note Reuse is only determined for NavSearchOrder::User.
+          *   The result remains the same until the next newer
+          *   message for a matching signal, or the end of the fit
+          *   interval of the result, whichever comes first. */
+      bool findUntil(const NavMessageID& nmid, const CommonTime& when,
+                     NavDataPtr& navOut, CommonTime& until,
+                     SVHealth xmitHealth, NavValidityType valid,
+                     NavSearchOrder order) override;
+
          /// @copydoc NavDataFactory::getOffset()
       bool getOffset(TimeSystem fromSys, TimeSystem toSys,
                      const CommonTime& when, NavDataPtr& offset,
@@ -342,9 +354,10 @@ namespace gnsstk
          /// Get read-only access to the nav data map (User priority).
       const NavMessageMap& getNavMessageMap() const
       { return data; }
-         /// Get read-only access to the nav data map (Nearest priority).
-      const NavNearMessageMap& getNavNearMessageMap() const
-      { return nearestData; }
+         /** Get read-only access to the nav data map (Nearest priority).
+          * @throw InvalidRequest if the store is frozen, as the
+          *   Nearest map is released by freeze().  Call thaw() first. */
+      const NavNearMessageMap& getNavNearMessageMap() const;
          /// Get read-only access to the time offset map.
       const OffsetCvtMap& getTimeOffsetMap() const
       { return offsetData; }
@@ -353,7 +366,151 @@ namespace gnsstk
           * @return The resulting NavMap if available or nullptr if not. */
       const NavMap* getNavMap(const NavMessageID& nmid) const;
 
+         /** Build a compact, read-only time index of the store.
+          * Each satellite's User and Nearest data are copied into
+          * contiguous, time-sorted arrays of (time key, NavDataPtr)
+          * so that find() can use a binary search over flat memory
+          * rather than walking the nodes of the nested maps.  The
+          * results of find() are identical in either mode.
+          * @note Any subsequent change to the store (addNavData(),
+          *   addDataSource(), edit() or clear()) discards the compact
+          *   index and returns the store to its normal mode.  Call
+          *   freeze() again once loading is complete.
+          * @note The Nearest map is released while frozen, its
+          *   contents being held only by the compact index, and is
+          *   rebuilt by thaw().  The User map is retained, as it is
+          *   exposed via getNavMessageMap() and used by count(),
+          *   dump(), edit() and derived factories.  A frozen store
+          *   therefore holds two (time, pointer) arrays in place of
+          *   the Nearest map's tree and list nodes.  Most of a
+          *   store's memory is in the NavData objects themselves,
+          *   which are shared rather than copied, so the saving is
+          *   modest: about 10% on a week of ephemeris and health data.
+          *   The main benefit of freezing is faster searches. */
+      virtual void freeze();
+
+         /** Discard the compact time index created by freeze(), along
+          * with any cached wildcard search results, restoring the
+          * Nearest map from it. */
+      virtual void thaw();
+
+         /// Return true if find() is using the compact time index.
+      virtual bool isFrozen() const
+      { return frozen; }
+
+         /** Put the store into read-only "sealed" mode, in which
+          * find(), findUntil(), getOffset() and the NavLibrary
+          * methods built on them (getXvt(), getHealth(),
+          * getIonoCorr() etc.) may be called from any number of
+          * threads at once.  This calls freeze() and builds any
+          * caches that would otherwise be built lazily by searches.
+          * The wildcard search caches, which can't be built in
+          * advance, are protected by a mutex while sealed.
+          * @note Any change to the store (addNavData(),
+          *   addDataSource(), edit(), clear() or changes to the
+          *   search configuration) unseals it, and must not be made
+          *   while other threads are searching the store.
+          * @note Objects returned by searches are shared with the
+          *   store and must be treated as read-only. */
+      virtual void seal();
+
+         /** Leave sealed mode, without discarding the compact time
+          * index.  Searches are no longer safe to call concurrently.
+          * This is done automatically by any change to the store. */
+      virtual void unseal();
+
+         /// Return true if the store is sealed (see seal()).
+      virtual bool isSealed() const
+      { return sealed; }
+
+         /// @copydoc NavDataFactory::getChangeCount()
+      unsigned long getChangeCount() const override
+      { return changeCount; }
+
+         /** Set a sliding-window retention policy, intended for
+          * long-running processes that continuously add data using
+          * addNavData() (e.g. decoded by PNBMultiGNSSNavDataFactory)
+          * rather than loading files.  Each time a message is added,
+          * messages whose time stamp is more than horizon seconds
+          * older than the newest time stamp in the store are
+          * removed, keeping memory use flat.  Messages are tracked in
+          * the order they were added, so the cost is amortized
+          * constant per message rather than a scan of the store as
+          * done by edit().
+          * @note Messages are evicted in the order they were added,
+          *   so a message added long after its time stamp (i.e. out
+          *   of order) is kept until all the messages added before
+          *   it have been evicted.
+          * @note Like edit(), eviction does not change the values
+          *   returned by getInitialTime(), getFinalTime(),
+          *   getFirstTime() or getLastTime().
+          * @param[in] horizon The length of the retention window in
+          *   seconds.  Zero, the default, disables eviction.  Any
+          *   messages already in the store that are outside the
+          *   window are removed immediately. */
+      virtual void setRetention(double horizon);
+
+         /// Return the retention window in seconds (see setRetention()).
+      double getRetention() const
+      { return retention; }
+
+         /** Get the number of messages in the store for each signal
+          * (ignoring PRN).  This is a count of messages, not of
+          * bytes, as the size of a message depends on its class.  It
+          * is maintained as messages are added and removed and costs
+          * nothing to call. */
+      virtual std::map<NavSignalID, size_t> getMessageCounts() const
+      { return messageCounts; }
+
+         /** Write the contents of the store to a binary snapshot file
+          * that can be loaded using loadSnapshot() much faster than
+          * decoding the original files.
+          * @see NavSnapshot for the supported message classes.
+          * @param[in] filename The path of the snapshot file to write.
+          * @return true on success, false if the file could not be
+          *   written or the store contains messages that can't be
+          *   written to a snapshot. */
+      virtual bool saveSnapshot(const std::string& filename) const;
+
+         /** Add the messages in a snapshot file written by
+          * saveSnapshot() to the store using addNavData(), which also
+          * rebuilds the time offset map and the initial and final
+          * times.
+          * @param[in] filename The path of the snapshot file to read.
+          * @return true on success, false if the file could not be
+          *   read or any message could not be added. */
+      virtual bool loadSnapshot(const std::string& filename);
+
+         /** Get every message in the store, each one once, for
+          * saveSnapshot().
+          * @param[out] navList The list to append the messages to.
+          * @return true on success, false if the store can't be
+          *   represented by its messages. */
+      virtual bool getSnapshotData(NavDataPtrList& navList) const;
+
+         /** Add messages read by loadSnapshot() to the store.
+          * @param[in] navList The messages to add.
+          * @return true on success, false if any message could not
+          *   be added. */
+      virtual bool addSnapshotData(const NavDataPtrList& navList);
+
+         /** Strict ordering of NavMessageID that, unlike
+          * NavMessageID::operator<(), treats wildcard fields as
+          * distinct values.  Used to key caches of search results. */
+      class ExactNMIDLess
+      {
+      public:
+         bool operator()(const NavMessageID& left,
+                         const NavMessageID& right) const;
+      };
+
    protected:
+         /** Record a change to the contents of the store, updating
+          * both getChangeCount() and
+          * NavDataFactory::getSharedChangeCount(). */
+      void noteChange()
+      { changeCount++; bumpSharedChangeCount(); }
+
          /** Search the store to find the navigation message that meets
           * the specified criteria using User-oriented data.
           * @note In order for xmitHealth matching to occur, one must
@@ -397,6 +554,20 @@ namespace gnsstk
                                NavDataPtr& navData, SVHealth xmitHealth,
                                NavValidityType valid);
 
+         /** Implementation of findUser() that searches the compact
+          * time index built by freeze().
+          * @copydetails findUser() */
+      bool findUserFrozen(const NavMessageID& nmid, const CommonTime& when,
+                          NavDataPtr& navData, SVHealth xmitHealth,
+                          NavValidityType valid);
+
+         /** Implementation of findNearest() that searches the compact
+          * time index built by freeze().
+          * @copydetails findNearest() */
+      bool findNearestFrozen(const NavMessageID& nmid, const CommonTime& when,
+                             NavDataPtr& navData, SVHealth xmitHealth,
+                             NavValidityType valid);
+
          /** Performs an appropriate validity check based on the
           * desired validity.
           * @param[in] ti A container iterator pointing to the nav
@@ -459,12 +630,86 @@ namespace gnsstk
          /** Store the time offset data separate from the other nav
           * data because searching is very different. */
       OffsetCvtMap offsetData;
+         /// Compact copy of data for User searches, built by freeze().
+      NavFlatMessageMap frozenData;
+         /** Compact replacement for nearestData for Nearest searches,
+          * built by freeze(), which empties nearestData. */
+      NavFlatMessageMap frozenNearestData;
+         /// If true, find() uses frozenData and frozenNearestData.
+      bool frozen;
+         /// If true, searches may be called concurrently (see seal()).
+      bool sealed;
+         /// Incremented by noteChange().
+      unsigned long changeCount;
+
+         /** Map a wildcard NavMessageID to the per-satellite
+          * containers that match it, in the order they appear in the
+          * NavSatMap (or equivalent). */
+      template <class T>
+      using WildMatchMap = std::map<NavMessageID, std::vector<T*>,
+                                    ExactNMIDLess>;
+         /** Resolved wildcard matches for findUser().  Each
+          * (wildcard) NavMessageID is matched against the
+          * NavSatelliteID keys in data only once, after which
+          * wildcard searches cost the same as exact searches.  This
+          * and the other caches are cleared by thaw() whenever
+          * satellites are added to or removed from the store. */
+      WildMatchMap<NavMap> userMatches;
+         /// Resolved wildcard matches for findNearest().
+      WildMatchMap<NavNearMap> nearMatches;
+         /// Resolved wildcard matches for findUserFrozen().
+      WildMatchMap<const NavFlatMap> frozenUserMatches;
+         /// Resolved wildcard matches for findNearestFrozen().
+      WildMatchMap<const NavFlatMap> frozenNearMatches;
+
+         /** A mutex that can be copied, so the factory can be too.
+          * Each copy has its own unlocked mutex. */
+      class CopyableMutex : public std::mutex
+      {
+      public:
+         CopyableMutex() = default;
+         CopyableMutex(const CopyableMutex&)
+               : std::mutex()
+         {}
+         CopyableMutex& operator=(const CopyableMutex&)
+         { return *this; }
+      };
+         /// Serializes access to the wildcard match caches when sealed.
+      CopyableMutex matchMutex;
+         /// Return the mutex to hold when using the match caches, if any.
+      std::mutex* matchMutexIfSealed()
+      { return (sealed ? &matchMutex : nullptr); }
          /// Store the earliest applicable orbit time here, by addNavData
       CommonTime initialTime;
          /// Store the latest applicable orbit time here, by addNavData
       CommonTime finalTime;
          /// Map subject satellite ID to time stamp pair (oldest,newest).
       std::map<SatID,std::pair<CommonTime,CommonTime> > firstLastMap;
+         /// Retention window in seconds, 0 for none (see setRetention()).
+      double retention;
+         /** Messages in our store in the order they were added, for
+          * setRetention().  Only maintained when retention is set. */
+      std::deque<NavDataPtr> retainQueue;
+         /// Newest time stamp added to retainQueue, in TimeSystem::Any.
+      CommonTime retainNewest;
+         /// Number of messages in nearestData for each signal.
+      std::map<NavSignalID, size_t> messageCounts;
+
+         /** Remove messages from the front of retainQueue that are
+          * outside the retention window. */
+      void evictExpired();
+
+         /** Remove a single message from data, nearestData and
+          * offsetData.
+          * @param[in] nd The message to remove.
+          * @return true if a satellite was removed from the store as
+          *   a result, i.e. cached search results must be discarded. */
+      bool removeNavData(const NavDataPtr& nd);
+
+         /** Recompute messageCounts and, if retention is set,
+          * retainQueue from nearestData, for use after changes that
+          * are not made through addNavData(). */
+      void rebuildRetention();
 
          /// Grant access to MultiFormatNavDataFactory for various functions.
       friend class MultiFormatNavDataFactory;
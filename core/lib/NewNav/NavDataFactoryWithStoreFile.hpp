@@ -51,6 +51,21 @@ namespace gnsstk
    class NavDataFactoryWithStoreFile : public NavDataFactoryWithStore
    {
    public:
+         /** Messages read from a file by parseFile() that have not
+          * yet been stored.  Factories that need to carry additional
+          * information about the file to storeParsed() may derive
+          * from this class. */
+      class ParsedFile
+      {
+      public:
+         virtual ~ParsedFile()
+         {}
+            /// The messages in the order they were decoded.
+         NavDataPtrList navOut;
+      };
+         /// Shared pointer to the result of parseFile().
+      using ParsedFilePtr = std::shared_ptr<ParsedFile>;
+
       NavDataFactoryWithStoreFile()
       {}
 
@@ -91,6 +106,27 @@ namespace gnsstk
           * @return true on success, false on failure. */
       virtual bool process(const std::string& filename,
                            NavDataFactoryCallback& cb) = 0;
+
+         /** Decode a file without changing the state of this
+          * factory, so that multiple files can be decoded
+          * concurrently.  Use storeParsed() to add the result to the
+          * store.  The default implementation runs process() with a
+          * callback that keeps the decoded messages, so factories
+          * whose process() method modifies the factory must
+          * override this method.
+          * @param[in] filename The path of the file to decode.
+          * @param[out] parsed The decoded messages, which may be
+          *   incomplete on failure.
+          * @return true on success, false on failure. */
+      virtual bool parseFile(const std::string& filename,
+                             ParsedFilePtr& parsed);
+
+         /** Add data decoded by parseFile() to the store.  Calling
+          * parseFile() followed by storeParsed() has the same effect
+          * on the store as loading the file using addDataSource().
+          * @param[in] parsed The result of parseFile().
+          * @return true on success, false on failure. */
+      virtual bool storeParsed(const ParsedFilePtr& parsed);
    };
 
       //@}
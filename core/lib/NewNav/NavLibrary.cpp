@@ -36,7 +36,9 @@
 //                            release, distribution is unlimited.
 //
 //==============================================================================
+#include <algorithm>
 #include "NavLibrary.hpp"
+#include "NavDataFactoryWithStore.hpp"
 #include "OrbitData.hpp"
 #include "NavHealthData.hpp"
 #include "TimeOffsetData.hpp"
@@ -108,6 +110,131 @@ namespace gnsstk
    }
 
 
+   size_t NavLibrary ::
+   getXvt(const std::vector<NavSatelliteID>& sats,
+          const std::vector<CommonTime>& when, std::vector<Xvt>& xvt,
+          std::vector<bool>& ok, bool useAlm, SVHealth xmitHealth,
+          NavValidityType valid, NavSearchOrder order)
+   {
+      DEBUGTRACE_FUNCTION();
+         // Use the standard default ObsID for standard default behavior.
+      ObsID oid;
+      return getXvtBatch(sats, when, xvt, ok, useAlm, false, oid, xmitHealth,
+                         valid, order);
+   }
+
+
+   size_t NavLibrary ::
+   getXvt(const std::vector<NavSatelliteID>& sats,
+          const std::vector<CommonTime>& when, std::vector<Xvt>& xvt,
+          std::vector<bool>& ok, bool useAlm, const ObsID& oid,
+          SVHealth xmitHealth, NavValidityType valid, NavSearchOrder order)
+   {
+      DEBUGTRACE_FUNCTION();
+      return getXvtBatch(sats, when, xvt, ok, useAlm, false, oid, xmitHealth,
+                         valid, order);
+   }
+
+
+   size_t NavLibrary ::
+   getXvt(const std::vector<NavSatelliteID>& sats,
+          const std::vector<CommonTime>& when, std::vector<Xvt>& xvt,
+          std::vector<bool>& ok, SVHealth xmitHealth, NavValidityType valid,
+          NavSearchOrder order)
+   {
+      DEBUGTRACE_FUNCTION();
+         // Use the standard default ObsID for standard default behavior.
+      ObsID oid;
+      return getXvtBatch(sats, when, xvt, ok, false, true, oid, xmitHealth,
+                         valid, order);
+   }
+
+
+   size_t NavLibrary ::
+   getXvt(const std::vector<NavSatelliteID>& sats,
+          const std::vector<CommonTime>& when, std::vector<Xvt>& xvt,
+          std::vector<bool>& ok, const ObsID& oid, SVHealth xmitHealth,
+          NavValidityType valid, NavSearchOrder order)
+   {
+      DEBUGTRACE_FUNCTION();
+      return getXvtBatch(sats, when, xvt, ok, false, true, oid, xmitHealth,
+                         valid, order);
+   }
+
+
+   size_t NavLibrary ::
+   getXvtBatch(const std::vector<NavSatelliteID>& sats,
+               const std::vector<CommonTime>& when, std::vector<Xvt>& xvt,
+               std::vector<bool>& ok, bool useAlm, bool fallback,
+               const ObsID& oid, SVHealth xmitHealth, NavValidityType valid,
+               NavSearchOrder order)
+   {
+      DEBUGTRACE_FUNCTION();
+      const size_t numTimes = when.size();
+      size_t rv = 0;
+      xvt.resize(sats.size() * numTimes);
+      ok.assign(sats.size() * numTimes, false);
+      for (size_t si = 0; si < sats.size(); si++)
+      {
+         NavMessageID nmid(sats[si], useAlm ? NavMessageType::Almanac :
+                           NavMessageType::Ephemeris);
+         NavMessageID nmida(sats[si], NavMessageType::Almanac);
+         NavDataPtr ndp;
+         CommonTime from, until, almUntil;
+         bool searched = false, found = false;
+         size_t base = si * numTimes;
+         size_t ti = 0;
+         while (ti < numTimes)
+         {
+            if (!searched || (when[ti] < from) || !(when[ti] < until))
+            {
+               from = when[ti];
+               found = findUntil(nmid, from, ndp, until, xmitHealth, valid,
+                                 order);
+               if (!found && fallback)
+               {
+                  found = findUntil(nmida, from, ndp, almUntil, xmitHealth,
+                                    valid, order);
+                  until = std::min(until, almUntil);
+               }
+               searched = true;
+            }
+               // Find all the subsequent times that will give the
+               // same search result.
+            size_t end = ti + 1;
+            while ((end < numTimes) && !(when[end] < from) &&
+                   (when[end] < until))
+            {
+               end++;
+            }
+            if (found)
+            {
+               OrbitData *orb = dynamic_cast<OrbitData*>(ndp.get());
+               if (orb->getXvt(&when[ti], end-ti, &xvt[base+ti], oid))
+               {
+                  std::fill(ok.begin()+base+ti, ok.begin()+base+end, true);
+                  rv += end-ti;
+               }
+               else
+               {
+                     // Something failed, go back and figure out which.
+                  for (size_t i = ti; i < end; i++)
+                  {
+                     if (orb->getXvt(when[i], xvt[base+i], oid))
+                     {
+                        ok[base+i] = true;
+                        rv++;
+                     }
+                  }
+               }
+            }
+            ti = end;
+         }
+      }
+      return rv;
+   }
+
+
    bool NavLibrary ::
    getHealth(const NavSatelliteID& sat, const CommonTime& when,
              SVHealth& healthOut, SVHealth xmitHealth, NavValidityType valid,
@@ -422,6 +549,44 @@ namespace gnsstk
    }
 
 
+   bool NavLibrary ::
+   findUntil(const NavMessageID& nmid, const CommonTime& when,
+             NavDataPtr& navOut, CommonTime& until, SVHealth xmitHealth,
+             NavValidityType valid, NavSearchOrder order)
+   {
+      DEBUGTRACE_FUNCTION();
+         // Same search as find(), but the result is only good until
+         // any of the factories searched might yield something
+         // different.
+      std::set<NavDataFactory*> uniques;
+      CommonTime factUntil;
+      until = CommonTime::END_OF_TIME;
+      until.setTimeSystem(TimeSystem::Any);
+      for (auto& fi : factories)
+      {
+         if ((fi.first == nmid) && (uniques.count(fi.second.get()) == 0))
+         {
+            try
+            {
+               bool rv = fi.second->findUntil(nmid, when, navOut, factUntil,
+                                              xmitHealth, valid, order);
+               until = std::min(until, factUntil);
+               if (rv)
+               {
+                  return true;
+               }
+            }
+            catch (gnsstk::Exception& exc)
+            {
+               GNSSTK_RETHROW(exc);
+            }
+            uniques.insert(fi.second.get());
+         }
+      }
+      return false;
+   }
+
+
    void NavLibrary ::
    setValidityFilter(NavValidityType nvt)
    {
@@ -476,6 +641,7 @@ namespace gnsstk
       {
          factories.insert(NavDataFactoryMap::value_type(si,fact));
       }
+      NavDataFactory::bumpSharedChangeCount();
    }
 
 
@@ -537,6 +703,88 @@ namespace gnsstk
    }
 
 
+   void NavLibrary ::
+   freeze()
+   {
+      DEBUGTRACE_FUNCTION();
+      for (auto& fi : NDFUniqIterator<NavDataFactoryMap>(factories))
+      {
+         NavDataFactoryWithStore *ndfs =
+            dynamic_cast<NavDataFactoryWithStore*>(fi.second.get());
+         if (ndfs != nullptr)
+         {
+            ndfs->freeze();
+         }
+      }
+   }
+
+
+   void NavLibrary ::
+   thaw()
+   {
+      DEBUGTRACE_FUNCTION();
+      for (auto& fi : NDFUniqIterator<NavDataFactoryMap>(factories))
+      {
+         NavDataFactoryWithStore *ndfs =
+            dynamic_cast<NavDataFactoryWithStore*>(fi.second.get());
+         if (ndfs != nullptr)
+         {
+            ndfs->thaw();
+         }
+      }
+   }
+
+
+   void NavLibrary ::
+   seal()
+   {
+      DEBUGTRACE_FUNCTION();
+      for (auto& fi : NDFUniqIterator<NavDataFactoryMap>(factories))
+      {
+         NavDataFactoryWithStore *ndfs =
+            dynamic_cast<NavDataFactoryWithStore*>(fi.second.get());
+         if (ndfs != nullptr)
+         {
+            ndfs->seal();
+         }
+      }
+   }
+
+
+   void NavLibrary ::
+   unseal()
+   {
+      DEBUGTRACE_FUNCTION();
+      for (auto& fi : NDFUniqIterator<NavDataFactoryMap>(factories))
+      {
+         NavDataFactoryWithStore *ndfs =
+            dynamic_cast<NavDataFactoryWithStore*>(fi.second.get());
+         if (ndfs != nullptr)
+         {
+            ndfs->unseal();
+         }
+      }
+   }
+
+
+   bool NavLibrary ::
+   isSealed() const
+   {
+      DEBUGTRACE_FUNCTION();
+      for (const auto& fi :
+              NDFUniqConstIterator<NavDataFactoryMap>(factories))
+      {
+         const NavDataFactoryWithStore *ndfs =
+            dynamic_cast<const NavDataFactoryWithStore*>(fi.second.get());
+         if ((ndfs != nullptr) && !ndfs->isSealed())
+         {
+            return false;
+         }
+      }
+      return true;
+   }
+
+
    CommonTime NavLibrary ::
    getInitialTime() const
    {
@@ -685,4 +933,124 @@ namespace gnsstk
       }
       return rv;
    }
+
+
+   unsigned long NavLibrary ::
+   getChangeCount() const
+   {
+      DEBUGTRACE_FUNCTION();
+         // Adding a factory also changes what find() returns.  The
+         // same factory may be counted more than once, which doesn't
+         // matter as long as the sum changes when a count does.
+         // Skipping repeats of the previous factory is cheaper than
+         // using NDFUniqConstIterator.
+      unsigned long rv = factories.size();
+      NavDataFactory *prev = nullptr;
+      for (const auto& fi : factories)
+      {
+         if (fi.second.get() != prev)
+         {
+            prev = fi.second.get();
+            rv += prev->getChangeCount();
+         }
+      }
+      return rv;
+   }
+
+
+   NavLibrary::Cursor ::
+   Cursor(NavLibrary& navLib, SVHealth xmitHealth, NavValidityType valid,
+          NavSearchOrder order)
+         : lib(navLib), xmitHealth(xmitHealth), valid(valid), order(order),
+           changeCount(NavDataFactory::getSharedChangeCount()), hits(0),
+           misses(0)
+   {
+   }
+
+
+   bool NavLibrary::Cursor ::
+   find(const NavMessageID& nmid, const CommonTime& when, NavDataPtr& navOut)
+   {
+      DEBUGTRACE_FUNCTION();
+         // Checking the shared count rather than
+         // lib.getChangeCount() keeps this independent of the
+         // number of factories.  A change to a factory outside lib
+         // only costs a refill of the cache.
+      unsigned long cc = NavDataFactory::getSharedChangeCount();
+      if (cc != changeCount)
+      {
+            // The library contents have changed, nothing cached can
+            // be trusted.
+         entries.clear();
+         changeCount = cc;
+      }
+      auto ei = entries.find(nmid);
+      if ((ei != entries.end()) && !(when < ei->second.from) &&
+          (when < ei->second.until))
+      {
+         hits++;
+         if (ei->second.found)
+         {
+            navOut = ei->second.navData;
+         }
+         return ei->second.found;
+      }
+      misses++;
+      if (ei == entries.end())
+      {
+         ei = entries.insert(EntryMap::value_type(nmid, Entry())).first;
+      }
+      Entry& entry(ei->second);
+      entry.navData.reset();
+      entry.from = when;
+      entry.found = lib.findUntil(nmid, when, entry.navData, entry.until,
+                                  xmitHealth, valid, order);
+      if (entry.found)
+      {
+         navOut = entry.navData;
+      }
+      return entry.found;
+   }
+
+
+   bool NavLibrary::Cursor ::
+   getXvt(const NavSatelliteID& sat, const CommonTime& when, Xvt& xvt,
+          bool useAlm, const ObsID& oid)
+   {
+      DEBUGTRACE_FUNCTION();
+      NavMessageID nmid(sat, useAlm ? NavMessageType::Almanac :
+                        NavMessageType::Ephemeris);
+      NavDataPtr ndp;
+      if (!find(nmid, when, ndp))
+         return false;
+      OrbitData *orb = dynamic_cast<OrbitData*>(ndp.get());
+      return orb->getXvt(when, xvt, oid);
+   }
+
+
+   bool NavLibrary::Cursor ::
+   getXvt(const NavSatelliteID& sat, const CommonTime& when, Xvt& xvt,
+          const ObsID& oid)
+   {
+      DEBUGTRACE_FUNCTION();
+      NavMessageID nmid(sat, NavMessageType::Ephemeris);
+      NavDataPtr ndp;
+      if (!find(nmid, when, ndp))
+      {
+         NavMessageID nmida(sat, NavMessageType::Almanac);
+         if (!find(nmida, when, ndp))
+         {
+            return false;
+         }
+      }
+      OrbitData *orb = dynamic_cast<OrbitData*>(ndp.get());
+      return orb->getXvt(when, xvt, oid);
+   }
+
+
+   void NavLibrary::Cursor ::
+   clear()
+   {
+      entries.clear();
+   }
 }
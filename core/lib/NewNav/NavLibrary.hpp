@@ -39,7 +39,7 @@
 #ifndef GNSSTK_NAVLIBRARY_HPP
 #define GNSSTK_NAVLIBRARY_HPP
 
-#include "NavDataFactory.hpp"
+#include "NavDataFactoryWithStore.hpp"
 #include "Xvt.hpp"
 #include "SVHealth.hpp"
 #include "Position.hpp"
@@ -1043,6 +1043,135 @@ namespace gnsstk
                   NavValidityType valid = NavValidityType::ValidOnly,
                   NavSearchOrder order = NavSearchOrder::User);
 
+         /** Get the position and velocity of a number of satellites
+          * at a number of times, searching either almanac or
+          * ephemeris, as dictated by \a useAlm.  The results are
+          * the same as calling the single satellite/time getXvt()
+          * for every combination, but the search for orbit data is
+          * only done when the previous result for the satellite can
+          * no longer be used (e.g. the fit interval ends or newer
+          * data becomes available), and the orbit data is evaluated
+          * for all consecutive times it covers at once.
+          * @note The reuse of search results only applies to
+          *   NavSearchOrder::User, and for best results \a when
+          *   should be in increasing time order.
+          * @param[in] sats Satellites to get the position/velocity for.
+          * @param[in] when The times that the positions should be
+          *   computed for.
+          * @param[out] xvt The computed positions and velocities.
+          *   This will be resized to sats.size()*when.size(), with
+          *   the result for sats[i] at when[j] in
+          *   xvt[i*when.size()+j].
+          * @param[out] ok Indicates which elements of \a xvt were
+          *   successfully computed, using the same layout as \a xvt.
+          * @param[in] useAlm If true, search for and use almanac
+          *   orbital elements.  If false, search for and use
+          *   ephemeris data instead.
+          * @param[in] xmitHealth The desired health status of the
+          *   transmitting satellite.
+          * @param[in] valid Specify whether to search only for valid
+          *   or invalid messages, or both.
+          * @param[in] order Specify whether to search by receiver
+          *   behavior or by nearest to when in time.
+          * @return the number of Xvt that were successfully computed. */
+      size_t getXvt(const std::vector<NavSatelliteID>& sats,
+                    const std::vector<CommonTime>& when,
+                    std::vector<Xvt>& xvt, std::vector<bool>& ok,
+                    bool useAlm, SVHealth xmitHealth = SVHealth::Any,
+                    NavValidityType valid = NavValidityType::ValidOnly,
+                    NavSearchOrder order = NavSearchOrder::User);
+
+         /** Get the position and velocity of a number of satellites
+          * at a number of times, searching either almanac or
+          * ephemeris, as dictated by \a useAlm, and using the
+          * antenna phase center for \a oid.  See above for details.
+          * @param[in] sats Satellites to get the position/velocity for.
+          * @param[in] when The times that the positions should be
+          *   computed for.
+          * @param[out] xvt The computed positions and velocities,
+          *   with the result for sats[i] at when[j] in
+          *   xvt[i*when.size()+j].
+          * @param[out] ok Indicates which elements of \a xvt were
+          *   successfully computed, using the same layout as \a xvt.
+          * @param[in] useAlm If true, search for and use almanac
+          *   orbital elements.  If false, search for and use
+          *   ephemeris data instead.
+          * @param[in] oid When it is possible to have different
+          *   antenna phase centers on a single SV, this parameter
+          *   allows you to specify a different APC than the
+          *   navigation data was being transmitted from.
+          * @param[in] xmitHealth The desired health status of the
+          *   transmitting satellite.
+          * @param[in] valid Specify whether to search only for valid
+          *   or invalid messages, or both.
+          * @param[in] order Specify whether to search by receiver
+          *   behavior or by nearest to when in time.
+          * @return the number of Xvt that were successfully computed. */
+      size_t getXvt(const std::vector<NavSatelliteID>& sats,
+                    const std::vector<CommonTime>& when,
+                    std::vector<Xvt>& xvt, std::vector<bool>& ok,
+                    bool useAlm, const ObsID& oid,
+                    SVHealth xmitHealth = SVHealth::Any,
+                    NavValidityType valid = NavValidityType::ValidOnly,
+                    NavSearchOrder order = NavSearchOrder::User);
+
+         /** Get the position and velocity of a number of satellites
+          * at a number of times, searching first for a matching
+          * ephemeris, and if that fails, then attempting to search
+          * for a matching almanac.  See above for details.
+          * @param[in] sats Satellites to get the position/velocity for.
+          * @param[in] when The times that the positions should be
+          *   computed for.
+          * @param[out] xvt The computed positions and velocities,
+          *   with the result for sats[i] at when[j] in
+          *   xvt[i*when.size()+j].
+          * @param[out] ok Indicates which elements of \a xvt were
+          *   successfully computed, using the same layout as \a xvt.
+          * @param[in] xmitHealth The desired health status of the
+          *   transmitting satellite.
+          * @param[in] valid Specify whether to search only for valid
+          *   or invalid messages, or both.
+          * @param[in] order Specify whether to search by receiver
+          *   behavior or by nearest to when in time.
+          * @return the number of Xvt that were successfully computed. */
+      size_t getXvt(const std::vector<NavSatelliteID>& sats,
+                    const std::vector<CommonTime>& when,
+                    std::vector<Xvt>& xvt, std::vector<bool>& ok,
+                    SVHealth xmitHealth = SVHealth::Any,
+                    NavValidityType valid = NavValidityType::ValidOnly,
+                    NavSearchOrder order = NavSearchOrder::User);
+
+         /** Get the position and velocity of a number of satellites
+          * at a number of times, searching first for a matching
+          * ephemeris, and if that fails, then attempting to search
+          * for a matching almanac, and using the antenna phase
+          * center for \a oid.  See above for details.
+          * @param[in] sats Satellites to get the position/velocity for.
+          * @param[in] when The times that the positions should be
+          *   computed for.
+          * @param[out] xvt The computed positions and velocities,
+          *   with the result for sats[i] at when[j] in
+          *   xvt[i*when.size()+j].
+          * @param[out] ok Indicates which elements of \a xvt were
+          *   successfully computed, using the same layout as \a xvt.
+          * @param[in] oid When it is possible to have different
+          *   antenna phase centers on a single SV, this parameter
+          *   allows you to specify a different APC than the
+          *   navigation data was being transmitted from.
+          * @param[in] xmitHealth The desired health status of the
+          *   transmitting satellite.
+          * @param[in] valid Specify whether to search only for valid
+          *   or invalid messages, or both.
+          * @param[in] order Specify whether to search by receiver
+          *   behavior or by nearest to when in time.
+          * @return the number of Xvt that were successfully computed. */
+      size_t getXvt(const std::vector<NavSatelliteID>& sats,
+                    const std::vector<CommonTime>& when,
+                    std::vector<Xvt>& xvt, std::vector<bool>& ok,
+                    const ObsID& oid, SVHealth xmitHealth = SVHealth::Any,
+                    NavValidityType valid = NavValidityType::ValidOnly,
+                    NavSearchOrder order = NavSearchOrder::User);
+
          /** Get the health status of a satellite at a specific time.
           * @param[in] sat Satellite to get the health status for.
           * @param[in] when The time that the health should be retrieved.
@@ -1231,6 +1360,28 @@ namespace gnsstk
                 NavDataPtr& navOut, SVHealth xmitHealth, NavValidityType valid,
                 NavSearchOrder order);
 
+         /** Search factories like find(), additionally reporting how
+          * long the result can be reused.
+          * @param[in] nmid Specify the message type, satellite and
+          *   codes to match.
+          * @param[in] when The time of interest to search for data.
+          * @param[out] navOut The resulting navigation message.
+          * @param[out] until find() with the same arguments is
+          *   guaranteed to yield the same result (including failure)
+          *   for any time t where when <= t < until, as long as no
+          *   factory's data is modified.
+          * @param[in] xmitHealth The desired health status of the
+          *   transmitting satellite.
+          * @param[in] valid Specify whether to search only for valid
+          *   or invalid messages, or both.
+          * @param[in] order Specify whether to search by receiver
+          *   behavior or by nearest to when in time.
+          * @return true if successful.  If false, navData will be untouched. */
+      bool findUntil(const NavMessageID& nmid, const CommonTime& when,
+                     NavDataPtr& navOut, CommonTime& until,
+                     SVHealth xmitHealth, NavValidityType valid,
+                     NavSearchOrder order);
+
          /** Set the factories' handling of valid and invalid
           * navigation data.  This should be called before any find()
           * calls.
@@ -1307,6 +1458,42 @@ namespace gnsstk
          /// Remove all data from the library's factories.
       void clear();
 
+         /** Build the compact time index in all of the library's
+          * factories that store data (i.e. are derived from
+          * NavDataFactoryWithStore).  This should be called after
+          * all data has been loaded.
+          * @see NavDataFactoryWithStore::freeze() */
+      void freeze();
+
+         /** Discard the compact time index in all of the library's
+          * factories.
+          * @see NavDataFactoryWithStore::thaw() */
+      void thaw();
+
+         /** Seal all of the library's factories that store data, so
+          * that the search methods (find(), getXvt(), getHealth(),
+          * getOffset(), getIonoCorr(), getISC() and so on) may be
+          * called from many threads at once on a single library.
+          * This should be called after all data has been loaded and
+          * the factories configured.  Neither the library nor its
+          * factories may be modified (addFactory(), addDataSource(),
+          * edit(), clear(), setTypeFilter() etc.) while other threads
+          * are using it; doing so unseals the factories affected.
+          * NavLibrary::Cursor objects are not shared, use one per
+          * thread.
+          * @note Factories not derived from NavDataFactoryWithStore
+          *   are responsible for their own thread safety.
+          * @see NavDataFactoryWithStore::seal() */
+      void seal();
+
+         /** Leave sealed mode in all of the library's factories.
+          * @see NavDataFactoryWithStore::unseal() */
+      void unseal();
+
+         /** Return true if all of the library's factories that store
+          * data are sealed. */
+      bool isSealed() const;
+
          /** Determine the earliest time for which this object can successfully
           * determine the Xvt for any object.
           * @return The initial time, or CommonTime::END_OF_TIME if no
@@ -1439,7 +1626,179 @@ namespace gnsstk
          /// Return a comma-separated list of formats supported by the factories
       std::string getFactoryFormats() const;
 
+         /** Return a count that changes every time the data available
+          * to find() changes, including the addition of factories.
+          * @see NavDataFactory::getChangeCount() */
+      unsigned long getChangeCount() const;
+
+         /** Cache search results for a sequence of searches that
+          * progress forward in time, e.g. when processing
+          * observations epoch by epoch.  For each NavMessageID
+          * searched, the cursor keeps the last result along with the
+          * time span over which NavLibrary::findUntil() guarantees
+          * the same result.  As long as subsequent searches are for
+          * times within that span, the cached result is returned
+          * without searching any factories.  Otherwise, or if the
+          * data in the library has changed (see
+          * NavDataFactory::getSharedChangeCount()), a full search
+          * is done.
+          *
+          * Simplified example:
+          * \code
+          * NavLibrary::Cursor cursor(navLib);
+          * for (CommonTime t = start; t < end; t += 30)
+          * {
+          *    if (cursor.getXvt(sat, t, xvt))
+          *       doSomething(xvt);
+          * }
+          * \endcode
+          * @note Only NavSearchOrder::User searches benefit from
+          *   the cache.
+          * @warning The NavLibrary must outlive the Cursor. */
+      class Cursor
+      {
+      public:
+            /** Create a cursor for searching a NavLibrary with
+             * fixed search criteria.
+             * @param[in] navLib The library to search.
+             * @param[in] xmitHealth The desired health status of the
+             *   transmitting satellite.
+             * @param[in] valid Specify whether to search only for valid
+             *   or invalid messages, or both.
+             * @param[in] order Specify whether to search by receiver
+             *   behavior or by nearest to when in time. */
+         Cursor(NavLibrary& navLib, SVHealth xmitHealth = SVHealth::Any,
+                NavValidityType valid = NavValidityType::ValidOnly,
+                NavSearchOrder order = NavSearchOrder::User);
+
+            /** Search for the navigation message that meets the
+             * specified criteria, using the cached result if
+             * possible.  The result is the same as that of
+             * NavLibrary::find().
+             * @param[in] nmid Specify the message type, satellite and
+             *   codes to match.
+             * @param[in] when The time of interest to search for data.
+             * @param[out] navOut The resulting navigation message.
+             * @return true if successful.  If false, navOut will be
+             *   untouched. */
+         bool find(const NavMessageID& nmid, const CommonTime& when,
+                   NavDataPtr& navOut);
+
+            /** Get the position and velocity of a satellite at a
+             * specific time, searching either almanac or ephemeris, as
+             * dictated by \a useAlm.
+             * @see NavLibrary::getXvt()
+             * @param[in] sat Satellite to get the position/velocity for.
+             * @param[in] when The time that the position should be
+             *   computed for.
+             * @param[out] xvt The computed position and velocity at when.
+             * @param[in] useAlm If true, search for and use almanac
+             *   orbital elements.  If false, search for and use
+             *   ephemeris data instead.
+             * @param[in] oid When it is possible to have different
+             *   antenna phase centers on a single SV, this parameter
+             *   allows you to specify a different APC than the
+             *   navigation data was being transmitted from.
+             * @return true if successful, false if no nav data was found
+             *   to compute the Xvt. */
+         bool getXvt(const NavSatelliteID& sat, const CommonTime& when,
+                     Xvt& xvt, bool useAlm, const ObsID& oid = ObsID());
+
+            /** Get the position and velocity of a satellite at a
+             * specific time, searching first for a matching
+             * ephemeris, and if that fails, then attempting to search
+             * for a matching almanac.
+             * @see NavLibrary::getXvt()
+             * @param[in] sat Satellite to get the position/velocity for.
+             * @param[in] when The time that the position should be
+             *   computed for.
+             * @param[out] xvt The computed position and velocity at when.
+             * @param[in] oid When it is possible to have different
+             *   antenna phase centers on a single SV, this parameter
+             *   allows you to specify a different APC than the
+             *   navigation data was being transmitted from.
+             * @return true if successful, false if no nav data was found
+             *   to compute the Xvt. */
+         bool getXvt(const NavSatelliteID& sat, const CommonTime& when,
+                     Xvt& xvt, const ObsID& oid = ObsID());
+
+            /// Discard all cached search results.
+         void clear();
+
+            /// Return the number of searches answered from the cache.
+         unsigned long getHits() const
+         { return hits; }
+            /// Return the number of searches that searched the library.
+         unsigned long getMisses() const
+         { return misses; }
+
+      private:
+            /// The last search result for a single NavMessageID.
+         class Entry
+         {
+         public:
+            Entry()
+                  : found(false)
+            {}
+               /// The search result (if found).
+            NavDataPtr navData;
+               /// The time that was searched.
+            CommonTime from;
+               /// The search result is good until this time (exclusive).
+            CommonTime until;
+               /// The return value of the search.
+            bool found;
+         };
+            /// Map the searched NavMessageID to the last result.
+         using EntryMap = std::map<NavMessageID, Entry,
+                                   NavDataFactoryWithStore::ExactNMIDLess>;
+
+            /// The library being searched.
+         NavLibrary& lib;
+            /// The desired health status of the transmitting satellite.
+         SVHealth xmitHealth;
+            /// The type of data (valid/invalid) being searched for.
+         NavValidityType valid;
+            /// The search order being used.
+         NavSearchOrder order;
+            /// NavDataFactory::getSharedChangeCount() when entries
+            /// were created.
+         unsigned long changeCount;
+            /// Cached search results.
+         EntryMap entries;
+            /// Searches answered from entries.
+         unsigned long hits;
+            /// Searches that went to the library.
+         unsigned long misses;
+      };
+
    protected:
+         /** Implement the batch getXvt() methods.
+          * @param[in] sats Satellites to get the position/velocity for.
+          * @param[in] when The times that the positions should be
+          *   computed for.
+          * @param[out] xvt The computed positions and velocities.
+          * @param[out] ok Indicates which elements of \a xvt were
+          *   successfully computed.
+          * @param[in] useAlm If true, search for almanac orbital
+          *   elements first, otherwise search for ephemeris first.
+          * @param[in] fallback If true and no ephemeris is found, try
+          *   the almanac (only meaningful if useAlm is false).
+          * @param[in] oid The ObsID whose antenna phase center to use.
+          * @param[in] xmitHealth The desired health status of the
+          *   transmitting satellite.
+          * @param[in] valid Specify whether to search only for valid
+          *   or invalid messages, or both.
+          * @param[in] order Specify whether to search by receiver
+          *   behavior or by nearest to when in time.
+          * @return the number of Xvt that were successfully computed. */
+      size_t getXvtBatch(const std::vector<NavSatelliteID>& sats,
+                         const std::vector<CommonTime>& when,
+                         std::vector<Xvt>& xvt, std::vector<bool>& ok,
+                         bool useAlm, bool fallback, const ObsID& oid,
+                         SVHealth xmitHealth, NavValidityType valid,
+                         NavSearchOrder order);
+
          /** Known nav data factories, organized by signal to make
           * searches simpler and/or quicker. */
       NavDataFactoryMap factories;
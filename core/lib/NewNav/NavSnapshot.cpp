@@ -0,0 +1,921 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2021, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <type_traits>
+#include <typeinfo>
+#include "NavSnapshot.hpp"
+#include "BDSD1NavEph.hpp"
+#include "BDSD1NavHealth.hpp"
+#include "BDSD1NavISC.hpp"
+#include "BDSD1NavIono.hpp"
+#include "BDSD2NavEph.hpp"
+#include "BDSD2NavHealth.hpp"
+#include "BDSD2NavISC.hpp"
+#include "GLOFNavEph.hpp"
+#include "GLOFNavHealth.hpp"
+#include "GPSLNavAlm.hpp"
+#include "GPSLNavEph.hpp"
+#include "GPSLNavHealth.hpp"
+#include "GPSLNavISC.hpp"
+#include "GPSLNavIono.hpp"
+#include "GPSNavConfig.hpp"
+#include "GalFNavEph.hpp"
+#include "GalFNavHealth.hpp"
+#include "GalINavEph.hpp"
+#include "GalINavHealth.hpp"
+#include "GalINavISC.hpp"
+#include "GalINavIono.hpp"
+#include "OrbitDataSP3.hpp"
+#include "RinexTimeOffset.hpp"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+namespace gnsstk
+{
+   const uint32_t NavSnapshot::version = 1;
+
+   namespace
+   {
+         /// Identifies a snapshot file.
+      const char snapshotMagic[8] = { 'G','N','S','S','T','K','N','S' };
+         /// Written in native byte order to detect byte order mismatch.
+      const uint32_t byteOrderMark = 0x01020304;
+
+         /** Write fields to a stream.  All integer and enum types are
+          * written as 64-bit integers so that the file doesn't depend
+          * on the size of int or long. */
+      class SnapshotWriter
+      {
+      public:
+         static const bool saving = true;
+         SnapshotWriter(std::ostream& s)
+               : strm(s)
+         {}
+         void raw(const void* p, size_t n)
+         { strm.write(static_cast<const char*>(p), n); }
+         template <class T>
+         typename std::enable_if<std::is_integral<T>::value ||
+                                 std::is_enum<T>::value>::type
+         io(T& v)
+         {
+            int64_t x = static_cast<int64_t>(v);
+            raw(&x, sizeof(x));
+         }
+         void io(double& v)
+         { raw(&v, sizeof(v)); }
+         void io(std::string& v)
+         {
+            uint64_t n = v.size();
+            raw(&n, sizeof(n));
+            raw(v.data(), n);
+         }
+         std::ostream& strm;
+      };
+
+         /** Read fields written by SnapshotWriter from memory.
+          * Reading past the end of the data sets ok to false and
+          * yields zeros. */
+      class SnapshotReader
+      {
+      public:
+         static const bool saving = false;
+         SnapshotReader(const char* b, const char* e)
+               : pos(b), end(e), ok(true)
+         {}
+         void raw(void* p, size_t n)
+         {
+            if (static_cast<size_t>(end - pos) < n)
+            {
+               ok = false;
+               pos = end;
+               memset(p, 0, n);
+               return;
+            }
+            memcpy(p, pos, n);
+            pos += n;
+         }
+         template <class T>
+         typename std::enable_if<std::is_integral<T>::value ||
+                                 std::is_enum<T>::value>::type
+         io(T& v)
+         {
+            int64_t x;
+            raw(&x, sizeof(x));
+            v = static_cast<T>(x);
+         }
+         void io(double& v)
+         { raw(&v, sizeof(v)); }
+         void io(std::string& v)
+         {
+            uint64_t n;
+            raw(&n, sizeof(n));
+            if (static_cast<uint64_t>(end - pos) < n)
+            {
+               ok = false;
+               pos = end;
+               v.clear();
+               return;
+            }
+            v.assign(pos, n);
+            pos += n;
+         }
+         const char *pos;
+         const char *end;
+         bool ok;
+      };
+
+         // Fields of the basic types and of each class in the
+         // hierarchy of the supported messages.  Each class calls its
+         // base class(es) first.
+
+      template <class Ar, class T>
+      void io(Ar& ar, T& v)
+      { ar.io(v); }
+
+      template <class Ar, class T, size_t N>
+      void io(Ar& ar, T (&v)[N])
+      {
+         for (size_t i = 0; i < N; i++)
+            io(ar, v[i]);
+      }
+
+      template <class Ar>
+      void io(Ar& ar, CommonTime& v)
+      {
+         long day = 0, msod = 0;
+         double fsod = 0.0;
+         TimeSystem ts = TimeSystem::Unknown;
+         if (Ar::saving)
+            v.getInternal(day, msod, fsod, ts);
+         io(ar, day);
+         io(ar, msod);
+         io(ar, fsod);
+         io(ar, ts);
+         if (!Ar::saving)
+         {
+               // Time arithmetic (e.g. END_OF_TIME plus a fit interval)
+               // can leave the day outside the range accepted by
+               // setInternal, so restore the excess separately.
+            long excess = 0;
+            if (day > CommonTime::END_LIMIT_JDAY)
+               excess = day - CommonTime::END_LIMIT_JDAY;
+            else if (day < CommonTime::BEGIN_LIMIT_JDAY)
+               excess = day - CommonTime::BEGIN_LIMIT_JDAY;
+            v.setInternal(day - excess, msod, fsod, ts);
+            v.addDays(excess);
+         }
+      }
+
+      template <class Ar>
+      void io(Ar& ar, Triple& v)
+      {
+         for (size_t i = 0; i < 3; i++)
+            io(ar, v[i]);
+      }
+
+      template <class Ar, class T>
+      void io(Ar& ar, ValidType<T>& v)
+      {
+         bool valid = v.is_valid();
+         T value = v.get_value();
+         io(ar, valid);
+         io(ar, value);
+         if (!Ar::saving)
+         {
+            v = value;
+            v.set_valid(valid);
+         }
+      }
+
+      template <class Ar>
+      void io(Ar& ar, RefFrame& v)
+      {
+         RefFrameSys sys = v.getSystem();
+         RefFrameRlz rlz = v.getRealization();
+         io(ar, sys);
+         io(ar, rlz);
+         if (!Ar::saving)
+            v = RefFrame(sys, rlz);
+      }
+
+      template <class Ar>
+      void io(Ar& ar, SatID& v)
+      {
+         io(ar, v.id);
+         io(ar, v.wildId);
+         io(ar, v.system);
+         io(ar, v.wildSys);
+         io(ar, v.norad);
+         io(ar, v.hasNorad);
+      }
+
+      template <class Ar>
+      void io(Ar& ar, ObsID& v)
+      {
+         uint32_t mcode = v.getMcodeBits(), mcodeMask = v.getMcodeMask();
+         io(ar, v.type);
+         io(ar, v.band);
+         io(ar, v.code);
+         io(ar, v.xmitAnt);
+         io(ar, v.freqOffs);
+         io(ar, v.freqOffsWild);
+         io(ar, mcode);
+         io(ar, mcodeMask);
+         if (!Ar::saving)
+            v.setMcodeBits(mcode, mcodeMask);
+      }
+
+      template <class Ar>
+      void io(Ar& ar, NavMessageID& v)
+      {
+         io(ar, v.sat);
+         io(ar, v.xmitSat);
+         io(ar, v.system);
+         io(ar, v.obs);
+         io(ar, v.nav);
+         io(ar, v.messageType);
+      }
+
+      template <class Ar>
+      void io(Ar& ar, NavData& v)
+      {
+         io(ar, v.timeStamp);
+         io(ar, v.signal);
+         io(ar, v.weekFmt);
+      }
+
+      template <class Ar>
+      void io(Ar& ar, NavFit& v)
+      {
+         io(ar, v.beginFit);
+         io(ar, v.endFit);
+      }
+
+      template <class Ar>
+      void io(Ar& ar, OrbitDataKepler& v)
+      {
+         io(ar, static_cast<NavData&>(v));
+         io(ar, static_cast<NavFit&>(v));
+         io(ar, v.xmitTime);
+         io(ar, v.Toe);
+         io(ar, v.Toc);
+         io(ar, v.health);
+         io(ar, v.Cuc);
+         io(ar, v.Cus);
+         io(ar, v.Crc);
+         io(ar, v.Crs);
+         io(ar, v.Cic);
+         io(ar, v.Cis);
+         io(ar, v.M0);
+         io(ar, v.dn);
+         io(ar, v.dndot);
+         io(ar, v.ecc);
+         io(ar, v.A);
+         io(ar, v.Ahalf);
+         io(ar, v.Adot);
+         io(ar, v.OMEGA0);
+         io(ar, v.i0);
+         io(ar, v.w);
+         io(ar, v.OMEGAdot);
+         io(ar, v.idot);
+         io(ar, v.af0);
+         io(ar, v.af1);
+         io(ar, v.af2);
+         io(ar, v.frame);
+      }
+
+      template <class Ar>
+      void io(Ar& ar, InterSigCorr& v)
+      {
+         io(ar, static_cast<NavData&>(v));
+         io(ar, v.isc);
+         io(ar, v.iscLabel);
+      }
+
+      template <class Ar>
+      void io(Ar& ar, KlobucharIonoNavData& v)
+      {
+         io(ar, static_cast<NavData&>(v));
+         io(ar, v.alpha);
+         io(ar, v.beta);
+      }
+
+      template <class Ar>
+      void io(Ar& ar, GPSLNavData& v)
+      {
+         io(ar, static_cast<OrbitDataKepler&>(v));
+         io(ar, v.pre);
+         io(ar, v.tlm);
+         io(ar, v.isf);
+         io(ar, v.alert);
+         io(ar, v.asFlag);
+      }
+
+      template <class Ar>
+      void io(Ar& ar, GPSLNavEph& v)
+      {
+         io(ar, static_cast<GPSLNavData&>(v));
+         io(ar, v.xmit2);
+         io(ar, v.xmit3);
+         io(ar, v.pre2);
+         io(ar, v.pre3);
+         io(ar, v.tlm2);
+         io(ar, v.tlm3);
+         io(ar, v.isf2);
+         io(ar, v.isf3);
+         io(ar, v.iodc);
+         io(ar, v.iode);
+         io(ar, v.fitIntFlag);
+         io(ar, v.healthBits);
+         io(ar, v.uraIndex);
+         io(ar, v.tgd);
+         io(ar, v.alert2);
+         io(ar, v.alert3);
+         io(ar, v.asFlag2);
+         io(ar, v.asFlag3);
+         io(ar, v.codesL2);
+         io(ar, v.L2Pdata);
+         io(ar, v.aodo);
+      }
+
+      template <class Ar>
+      void io(Ar& ar, GPSLNavAlm& v)
+      {
+         io(ar, static_cast<GPSLNavData&>(v));
+         io(ar, v.healthBits);
+         io(ar, v.deltai);
+         io(ar, v.toa);
+      }
+
+      template <class Ar>
+      void io(Ar& ar, GPSLNavHealth& v)
+      {
+         io(ar, static_cast<NavData&>(v));
+         io(ar, v.svHealth);
+      }
+
+      template <class Ar>
+      void io(Ar& ar, GPSLNavISC& v)
+      {
+         io(ar, static_cast<InterSigCorr&>(v));
+         io(ar, v.pre);
+         io(ar, v.tlm);
+         io(ar, v.isf);
+         io(ar, v.alert);
+         io(ar, v.asFlag);
+      }
+
+      template <class Ar>
+      void io(Ar& ar, GPSLNavIono& v)
+      {
+         io(ar, static_cast<KlobucharIonoNavData&>(v));
+         io(ar, v.pre);
+         io(ar, v.tlm);
+         io(ar, v.isf);
+         io(ar, v.alert);
+         io(ar, v.asFlag);
+      }
+
+      template <class Ar>
+      void io(Ar& ar, GPSNavConfig& v)
+      {
+         io(ar, static_cast<NavData&>(v));
+         io(ar, v.antispoofOn);
+         io(ar, v.svConfig);
+      }
+
+      template <class Ar>
+      void io(Ar& ar, GalINavEph& v)
+      {
+         io(ar, static_cast<OrbitDataKepler&>(v));
+         io(ar, v.bgdE5aE1);
+         io(ar, v.bgdE5bE1);
+         io(ar, v.sisaIndex);
+         io(ar, v.svid);
+         io(ar, v.xmit2);
+         io(ar, v.xmit3);
+         io(ar, v.xmit4);
+         io(ar, v.xmit5);
+         io(ar, v.iodnav1);
+         io(ar, v.iodnav2);
+         io(ar, v.iodnav3);
+         io(ar, v.iodnav4);
+         io(ar, v.hsE5b);
+         io(ar, v.hsE1B);
+         io(ar, v.dvsE5b);
+         io(ar, v.dvsE1B);
+      }
+
+      template <class Ar>
+      void io(Ar& ar, GalFNavEph& v)
+      {
+         io(ar, static_cast<OrbitDataKepler&>(v));
+         io(ar, v.bgdE5aE1);
+         io(ar, v.sisaIndex);
+         io(ar, v.svid);
+         io(ar, v.xmit2);
+         io(ar, v.xmit3);
+         io(ar, v.xmit4);
+         io(ar, v.iodnav1);
+         io(ar, v.iodnav2);
+         io(ar, v.iodnav3);
+         io(ar, v.iodnav4);
+         io(ar, v.hsE5a);
+         io(ar, v.dvsE5a);
+         io(ar, v.wn1);
+         io(ar, v.tow1);
+         io(ar, v.wn2);
+         io(ar, v.tow2);
+         io(ar, v.wn3);
+         io(ar, v.tow3);
+         io(ar, v.tow4);
+      }
+
+      template <class Ar>
+      void io(Ar& ar, GalINavHealth& v)
+      {
+         io(ar, static_cast<NavData&>(v));
+         io(ar, v.sigHealthStatus);
+         io(ar, v.dataValidityStatus);
+         io(ar, v.sisaIndex);
+      }
+
+      template <class Ar>
+      void io(Ar& ar, GalFNavHealth& v)
+      {
+         io(ar, static_cast<NavData&>(v));
+         io(ar, v.sigHealthStatus);
+         io(ar, v.dataValidityStatus);
+         io(ar, v.sisaIndex);
+      }
+
+      template <class Ar>
+      void io(Ar& ar, GalINavISC& v)
+      {
+         io(ar, static_cast<InterSigCorr&>(v));
+         io(ar, v.bgdE1E5a);
+         io(ar, v.bgdE1E5b);
+      }
+
+      template <class Ar>
+      void io(Ar& ar, GalINavIono& v)
+      {
+         io(ar, static_cast<NavData&>(v));
+         io(ar, v.ai);
+         io(ar, v.idf);
+      }
+
+      template <class Ar>
+      void io(Ar& ar, BDSD1NavData& v)
+      {
+         io(ar, static_cast<OrbitDataKepler&>(v));
+         io(ar, v.pre);
+         io(ar, v.rev);
+         io(ar, v.fraID);
+         io(ar, v.sow);
+      }
+
+      template <class Ar>
+      void io(Ar& ar, BDSD1NavEph& v)
+      {
+         io(ar, static_cast<BDSD1NavData&>(v));
+         io(ar, v.pre2);
+         io(ar, v.pre3);
+         io(ar, v.rev2);
+         io(ar, v.rev3);
+         io(ar, v.sow2);
+         io(ar, v.sow3);
+         io(ar, v.satH1);
+         io(ar, v.aodc);
+         io(ar, v.aode);
+         io(ar, v.uraIndex);
+         io(ar, v.xmit2);
+         io(ar, v.xmit3);
+         io(ar, v.tgd1);
+         io(ar, v.tgd2);
+      }
+
+      template <class Ar>
+      void io(Ar& ar, BDSD1NavHealth& v)
+      {
+         io(ar, static_cast<NavData&>(v));
+         io(ar, v.isAlmHealth);
+         io(ar, v.satH1);
+         io(ar, v.svHealth);
+      }
+
+      template <class Ar>
+      void io(Ar& ar, BDSD1NavISC& v)
+      {
+         io(ar, static_cast<InterSigCorr&>(v));
+         io(ar, v.pre);
+         io(ar, v.rev);
+         io(ar, v.fraID);
+         io(ar, v.sow);
+         io(ar, v.tgd1);
+         io(ar, v.tgd2);
+      }
+
+      template <class Ar>
+      void io(Ar& ar, BDSD1NavIono& v)
+      {
+         io(ar, static_cast<KlobucharIonoNavData&>(v));
+         io(ar, v.pre);
+         io(ar, v.rev);
+         io(ar, v.fraID);
+         io(ar, v.sow);
+      }
+
+      template <class Ar>
+      void io(Ar& ar, BDSD2NavData& v)
+      {
+         io(ar, static_cast<OrbitDataKepler&>(v));
+         io(ar, v.pre);
+         io(ar, v.rev);
+         io(ar, v.fraID);
+         io(ar, v.sow);
+      }
+
+      template <class Ar>
+      void io(Ar& ar, BDSD2NavEph& v)
+      {
+         io(ar, static_cast<BDSD2NavData&>(v));
+         io(ar, v.satH1);
+         io(ar, v.aodc);
+         io(ar, v.aode);
+         io(ar, v.uraIndex);
+         io(ar, v.tgd1);
+         io(ar, v.tgd2);
+      }
+
+      template <class Ar>
+      void io(Ar& ar, BDSD2NavHealth& v)
+      {
+         io(ar, static_cast<NavData&>(v));
+         io(ar, v.isAlmHealth);
+         io(ar, v.satH1);
+         io(ar, v.svHealth);
+      }
+
+      template <class Ar>
+      void io(Ar& ar, BDSD2NavISC& v)
+      {
+         io(ar, static_cast<InterSigCorr&>(v));
+         io(ar, v.pre);
+         io(ar, v.rev);
+         io(ar, v.fraID);
+         io(ar, v.sow);
+         io(ar, v.tgd1);
+         io(ar, v.tgd2);
+      }
+
+      template <class Ar>
+      void io(Ar& ar, GLOFNavData& v)
+      {
+         io(ar, static_cast<NavData&>(v));
+         io(ar, static_cast<NavFit&>(v));
+         io(ar, v.xmit2);
+         io(ar, v.satType);
+         io(ar, v.slot);
+         io(ar, v.lhealth);
+         io(ar, v.health);
+      }
+
+      template <class Ar>
+      void io(Ar& ar, GLOFNavEph& v)
+      {
+         io(ar, static_cast<GLOFNavData&>(v));
+         io(ar, v.ref);
+         io(ar, v.xmit3);
+         io(ar, v.xmit4);
+         io(ar, v.pos);
+         io(ar, v.vel);
+         io(ar, v.acc);
+         io(ar, v.clkBias);
+         io(ar, v.freqBias);
+         io(ar, v.healthBits);
+         io(ar, v.tb);
+         io(ar, v.P1);
+         io(ar, v.P2);
+         io(ar, v.P3);
+         io(ar, v.P4);
+         io(ar, v.interval);
+         io(ar, v.opStatus);
+         io(ar, v.tauDelta);
+         io(ar, v.aod);
+         io(ar, v.accIndex);
+         io(ar, v.dayCount);
+         io(ar, v.Toe);
+         io(ar, v.step);
+      }
+
+      template <class Ar>
+      void io(Ar& ar, GLOFNavHealth& v)
+      {
+         io(ar, static_cast<NavData&>(v));
+         io(ar, v.healthBits);
+         io(ar, v.ln);
+         io(ar, v.Cn);
+      }
+
+      template <class Ar>
+      void io(Ar& ar, OrbitDataSP3& v)
+      {
+         io(ar, static_cast<NavData&>(v));
+         io(ar, v.pos);
+         io(ar, v.posSig);
+         io(ar, v.vel);
+         io(ar, v.velSig);
+         io(ar, v.acc);
+         io(ar, v.accSig);
+         io(ar, v.clkBias);
+         io(ar, v.biasSig);
+         io(ar, v.clkDrift);
+         io(ar, v.driftSig);
+         io(ar, v.clkDrRate);
+         io(ar, v.drRateSig);
+         io(ar, v.coordSystem);
+         io(ar, v.frame);
+      }
+
+      template <class Ar>
+      void io(Ar& ar, RinexTimeOffset& v)
+      {
+         io(ar, static_cast<NavData&>(v));
+         io(ar, v.type);
+         io(ar, v.frTS);
+         io(ar, v.toTS);
+         io(ar, v.A0);
+         io(ar, v.A1);
+         io(ar, v.refTime);
+         io(ar, v.geoProvider);
+         io(ar, v.geoUTCid);
+         io(ar, v.deltatLS);
+      }
+
+         /// Write a message as its exact class T.
+      template <class T>
+      void writeAs(SnapshotWriter& ar, const NavData& nd)
+      {
+            // the writer doesn't modify anything
+         io(ar, const_cast<T&>(static_cast<const T&>(nd)));
+      }
+
+         /// Create a new message of class T and read its fields.
+      template <class T>
+      NavDataPtr readAs(SnapshotReader& ar)
+      {
+         std::shared_ptr<T> rv = std::make_shared<T>();
+         io(ar, *rv);
+         return rv;
+      }
+
+         /// How to write and read one supported class.
+      struct SnapshotClass
+      {
+         const std::type_info& type;
+         void (*write)(SnapshotWriter&, const NavData&);
+         NavDataPtr (*read)(SnapshotReader&);
+      };
+
+         /** The supported classes.  The index in this table is the
+          * class identifier in the file, so new classes must only be
+          * added to the end (or the version changed). */
+      const SnapshotClass snapshotClasses[] =
+      {
+         { typeid(GPSLNavEph), writeAs<GPSLNavEph>, readAs<GPSLNavEph> },
+         { typeid(GPSLNavAlm), writeAs<GPSLNavAlm>, readAs<GPSLNavAlm> },
+         { typeid(GPSLNavHealth), writeAs<GPSLNavHealth>,
+           readAs<GPSLNavHealth> },
+         { typeid(GPSLNavISC), writeAs<GPSLNavISC>, readAs<GPSLNavISC> },
+         { typeid(GPSLNavIono), writeAs<GPSLNavIono>, readAs<GPSLNavIono> },
+         { typeid(GPSNavConfig), writeAs<GPSNavConfig>,
+           readAs<GPSNavConfig> },
+         { typeid(GalINavEph), writeAs<GalINavEph>, readAs<GalINavEph> },
+         { typeid(GalFNavEph), writeAs<GalFNavEph>, readAs<GalFNavEph> },
+         { typeid(GalINavHealth), writeAs<GalINavHealth>,
+           readAs<GalINavHealth> },
+         { typeid(GalFNavHealth), writeAs<GalFNavHealth>,
+           readAs<GalFNavHealth> },
+         { typeid(GalINavISC), writeAs<GalINavISC>, readAs<GalINavISC> },
+         { typeid(GalINavIono), writeAs<GalINavIono>, readAs<GalINavIono> },
+         { typeid(BDSD1NavEph), writeAs<BDSD1NavEph>, readAs<BDSD1NavEph> },
+         { typeid(BDSD1NavHealth), writeAs<BDSD1NavHealth>,
+           readAs<BDSD1NavHealth> },
+         { typeid(BDSD1NavISC), writeAs<BDSD1NavISC>, readAs<BDSD1NavISC> },
+         { typeid(BDSD1NavIono), writeAs<BDSD1NavIono>,
+           readAs<BDSD1NavIono> },
+         { typeid(BDSD2NavEph), writeAs<BDSD2NavEph>, readAs<BDSD2NavEph> },
+         { typeid(BDSD2NavHealth), writeAs<BDSD2NavHealth>,
+           readAs<BDSD2NavHealth> },
+         { typeid(BDSD2NavISC), writeAs<BDSD2NavISC>, readAs<BDSD2NavISC> },
+         { typeid(GLOFNavEph), writeAs<GLOFNavEph>, readAs<GLOFNavEph> },
+         { typeid(GLOFNavHealth), writeAs<GLOFNavHealth>,
+           readAs<GLOFNavHealth> },
+         { typeid(OrbitDataSP3), writeAs<OrbitDataSP3>,
+           readAs<OrbitDataSP3> },
+         { typeid(RinexTimeOffset), writeAs<RinexTimeOffset>,
+           readAs<RinexTimeOffset> },
+      };
+
+      const size_t numSnapshotClasses =
+         sizeof(snapshotClasses) / sizeof(snapshotClasses[0]);
+
+         /** Get the index of the class of nd in snapshotClasses.
+          * @return the index or numSnapshotClasses if unsupported. */
+      size_t classIndex(const NavData& nd)
+      {
+         const std::type_info& ti(typeid(nd));
+         for (size_t i = 0; i < numSnapshotClasses; i++)
+         {
+            if (snapshotClasses[i].type == ti)
+               return i;
+         }
+         return numSnapshotClasses;
+      }
+   } // anonymous namespace
+
+
+   bool NavSnapshot ::
+   write(const std::string& filename, const SectionList& sections)
+   {
+      for (const auto& sec : sections)
+      {
+         for (const auto& nd : sec.second)
+         {
+            if (!isSupported(nd))
+               return false;
+         }
+      }
+      std::ofstream s(filename.c_str(), std::ios::out | std::ios::binary);
+      if (!s)
+         return false;
+      SnapshotWriter ar(s);
+      uint32_t ver = version, bom = byteOrderMark;
+      uint64_t numSections = sections.size();
+      ar.raw(snapshotMagic, sizeof(snapshotMagic));
+      ar.raw(&ver, sizeof(ver));
+      ar.raw(&bom, sizeof(bom));
+      ar.raw(&numSections, sizeof(numSections));
+      for (const auto& sec : sections)
+      {
+         std::string name(sec.first);
+         uint64_t count = sec.second.size();
+         ar.io(name);
+         ar.raw(&count, sizeof(count));
+         for (const auto& nd : sec.second)
+         {
+            uint32_t cls = classIndex(*nd);
+            ar.raw(&cls, sizeof(cls));
+            snapshotClasses[cls].write(ar, *nd);
+         }
+      }
+      s.close();
+      return !s.fail();
+   }
+
+
+   bool NavSnapshot ::
+   read(const std::string& filename, SectionList& sections)
+   {
+      sections.clear();
+      std::shared_ptr<const char> contents;
+      size_t size = 0;
+#ifndef _WIN32
+      int fd = ::open(filename.c_str(), O_RDONLY);
+      if (fd < 0)
+         return false;
+      struct stat st;
+         // Empty files can't be mapped, and aren't snapshots anyway.
+      if ((fstat(fd, &st) == 0) && S_ISREG(st.st_mode) && (st.st_size > 0))
+      {
+         void *addr = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE,
+                           fd, 0);
+         if (addr != MAP_FAILED)
+         {
+            madvise(addr, st.st_size, MADV_SEQUENTIAL);
+            size = st.st_size;
+            contents = std::shared_ptr<const char>(
+               static_cast<const char*>(addr),
+               [size](const char* p)
+               { munmap(const_cast<char*>(p), size); });
+         }
+      }
+      ::close(fd);
+#endif
+      if (!contents)
+      {
+            // no mmap; read the whole file instead
+         std::ifstream s(filename.c_str(), std::ios::in | std::ios::binary);
+         if (!s)
+            return false;
+         s.seekg(0, std::ios::end);
+         std::streamoff len = s.tellg();
+         s.seekg(0, std::ios::beg);
+         if (len <= 0)
+            return false;
+         size = len;
+         std::shared_ptr<char> copy(new char[size],
+                                    std::default_delete<char[]>());
+         if (!s.read(copy.get(), size))
+            return false;
+         contents = copy;
+      }
+      SnapshotReader ar(contents.get(), contents.get() + size);
+      char magic[sizeof(snapshotMagic)];
+      uint32_t ver, bom;
+      uint64_t numSections;
+      ar.raw(magic, sizeof(magic));
+      ar.raw(&ver, sizeof(ver));
+      ar.raw(&bom, sizeof(bom));
+      ar.raw(&numSections, sizeof(numSections));
+      if (!ar.ok || (memcmp(magic, snapshotMagic, sizeof(magic)) != 0) ||
+          (ver != version) || (bom != byteOrderMark))
+      {
+         return false;
+      }
+      try
+      {
+         for (uint64_t i = 0; ar.ok && (i < numSections); i++)
+         {
+            sections.push_back(Section());
+            Section& sec(sections.back());
+            uint64_t count;
+            ar.io(sec.first);
+            ar.raw(&count, sizeof(count));
+            for (uint64_t j = 0; ar.ok && (j < count); j++)
+            {
+               uint32_t cls;
+               ar.raw(&cls, sizeof(cls));
+               if (cls >= numSnapshotClasses)
+               {
+                  ar.ok = false;
+                  break;
+               }
+               sec.second.push_back(snapshotClasses[cls].read(ar));
+            }
+         }
+      }
+      catch (gnsstk::Exception& exc)
+      {
+            // invalid time from a corrupt file
+         ar.ok = false;
+      }
+      if (!ar.ok || (ar.pos != ar.end))
+      {
+         sections.clear();
+         return false;
+      }
+      return true;
+   }
+
+
+   bool NavSnapshot ::
+   isSupported(const NavDataPtr& nd)
+   {
+      return (nd && (classIndex(*nd) < numSnapshotClasses));
+   }
+} // namespace gnsstk
@@ -0,0 +1,112 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+#ifndef GNSSTK_NAVSNAPSHOT_HPP
+#define GNSSTK_NAVSNAPSHOT_HPP
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+#include "gnsstk_export.h"
+#include "NavData.hpp"
+
+namespace gnsstk
+{
+      /// @ingroup NavFactory
+      //@{
+
+      /** Read and write binary snapshots of decoded navigation
+       * messages, so that a store can be rebuilt without decoding
+       * the original text files again.
+       *
+       * A snapshot contains one or more named sections, normally one
+       * per factory, each holding a list of messages.  The messages
+       * are stored field by field in the native byte order with
+       * fixed-width integers, preceded by a version number, so
+       * snapshots can only be read on machines with the same byte
+       * order and must be rebuilt when the version changes.  Members
+       * that are fixed by the constructor of each class (e.g. the
+       * message length) are not stored.
+       *
+       * Only the message classes produced by the file-based
+       * factories (RINEX nav, SP3 and RINEX clock, SEM and Yuma) are
+       * supported.  Writing a snapshot that contains any other class
+       * fails.
+       * @see NavDataFactoryWithStore::saveSnapshot()
+       * @see NavDataFactoryWithStore::loadSnapshot() */
+   class NavSnapshot
+   {
+   public:
+         /// A named list of messages, normally the store of one factory.
+      using Section = std::pair<std::string, NavDataPtrList>;
+         /// The contents of a snapshot.
+      using SectionList = std::vector<Section>;
+
+         /// Format version written to and expected in snapshot files.
+      GNSSTK_EXPORT static const uint32_t version;
+
+         /** Write a snapshot file.
+          * @param[in] filename The path of the file to write.
+          * @param[in] sections The messages to write.
+          * @return true on success, false if the file could not be
+          *   written or a message is of an unsupported class. */
+      static bool write(const std::string& filename,
+                        const SectionList& sections);
+
+         /** Read a snapshot file written by write().  The file is
+          * memory-mapped and decoded in place, or read into memory
+          * in a single operation where mapping is not available.
+          * @param[in] filename The path of the file to read.
+          * @param[out] sections The messages read from the file.
+          * @return true on success, false if the file could not be
+          *   read, is not a snapshot, was written by a different
+          *   version or byte order, or is truncated. */
+      static bool read(const std::string& filename, SectionList& sections);
+
+         /** Determine whether write() supports the class of a message.
+          * @param[in] nd The message to check.
+          * @return true if nd can be written to a snapshot. */
+      static bool isSupported(const NavDataPtr& nd);
+   };
+
+      //@}
+
+} // namespace gnsstk
+
+#endif // GNSSTK_NAVSNAPSHOT_HPP
@@ -65,6 +65,33 @@ namespace gnsstk
       virtual bool getXvt(const CommonTime& when, Xvt& xvt,
                           const ObsID& oid = ObsID()) = 0;
 
+         /** Compute the satellite's position and velocity at a
+          * number of times using this one set of navigation data.
+          * The default implementation calls the single-epoch
+          * getXvt() for each time.  Derived classes override this
+          * where the computation can be done in a single tight loop.
+          * @param[in] when An array of \a count times at which to
+          *   compute the xvt.
+          * @param[in] count The number of elements in \a when and \a xvt.
+          * @param[out] xvt An array of \a count Xvt objects, where
+          *   xvt[i] is set to the position and velocity at when[i].
+          * @param[in] oid When it is possible to have different
+          *   antenna phase centers on a single SV, this parameter
+          *   allows you to specify a different APC than the
+          *   navigation data was being transmitted from.
+          * @return true if successful for all times, false if the
+          *   Xvt for any time could not be computed. */
+      virtual bool getXvt(const CommonTime* when, size_t count, Xvt* xvt,
+                          const ObsID& oid = ObsID())
+      {
+         bool rv = true;
+         for (size_t i = 0; i < count; i++)
+         {
+            rv &= getXvt(when[i], xvt[i], oid);
+         }
+         return rv;
+      }
+
          /// @copydoc NavData::isSameData
       bool isSameData(const NavDataPtr& right) const override
       {
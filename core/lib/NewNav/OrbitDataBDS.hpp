@@ -68,6 +68,14 @@ namespace gnsstk
          return OrbitDataKepler::getXvt(when, ell, xvt, oid);
       }
 
+         /// @copydoc OrbitData::getXvt(const CommonTime*,size_t,Xvt*,const ObsID&)
+      bool getXvt(const CommonTime* when, size_t count, Xvt* xvt,
+                  const ObsID& oid = ObsID()) override
+      {
+         CGCS2000Ellipsoid ell;
+         return OrbitDataKepler::getXvt(when, count, ell, xvt, oid);
+      }
+
          /** Compute satellite relativity correction (sec) at the given time.
           * @param[in] when The time at which to get the relativity correction.
           * @return the relativity correction in seconds.
@@ -168,144 +168,160 @@ namespace gnsstk
    getXvt(const CommonTime& when, const EllipsoidModel& ell, Xvt& xvt,
           const ObsID& oid)
    {
+      return getXvt(&when, 1, ell, &xvt, oid);
+   }
+
+
+   bool OrbitDataKepler ::
+   getXvt(const CommonTime* when, size_t count, const EllipsoidModel& ell,
+          Xvt* xvt, const ObsID& oid)
+   {
+         // Everything that doesn't depend on the time of interest is
+         // computed once, outside the loop.
       GPSWeekSecond gpsws = (Toe);
       double ToeSOW = gpsws.sow;
       double ea;              // eccentric anomaly
       double delea;           // delta eccentric anomaly during iteration
       double elapte;          // elapsed time since Toe
-      double q,sinea,cosea;
+      double sinea,cosea;
       double GSTA,GCTA;
       double amm;
       double meana;           // mean anomaly
       double F,G;             // temporary real variables
       double alat,talat,c2al,s2al,du,dr,di,U,R,truea,AINC;
       double ANLON,cosu,sinu,xip,yip,can,san,cinc,sinc;
-      double xef,yef,zef,dek,dlk,div,domk,duv,drv;
+      double xef,yef,zef,dek,dlk,div,duv,drv;
       double dxp,dyp,vxef,vyef,vzef;
 
       double sqrtgm = SQRT(ell.gm());
+      double angVel = ell.angVelocity();
       double twoPI = 2.0e0 * PI;
-      double lecc;            // eccentricity
-      double tdrinc;          // dt inclination
-
-      lecc = ecc;
-      tdrinc = idot;
-
-         // Compute time since ephemeris & clock epochs
-      elapte = when - Toe;
-
-         // Compute A at time of interest
-      double Ak = A + Adot * elapte;
-
-         // Compute mean motion
-      double dnA = dn + 0.5 * dndot * elapte;
-         // NOT Ak because this equation specifies A0, not Ak.
-      amm  = (sqrtgm / (A*Ahalf)) + dnA;
-
-         // In-plane angles
-         //     meana - Mean anomaly
-         //     ea    - Eccentric anomaly
-         //     truea - True anomaly
-
-      meana = M0 + elapte * amm;
-      meana = fmod(meana, twoPI);
-
-      ea = meana + lecc * ::sin(meana);
-
-      int loop_cnt = 1;
-      do  {
-         F = meana - ( ea - lecc * ::sin(ea));
-         G = 1.0 - lecc * ::cos(ea);
-         delea = F/G;
-         ea = ea + delea;
-         loop_cnt++;
-      } while ( (fabs(delea) > 1.0e-11 ) && (loop_cnt <= 20) );
-
-         // Compute clock corrections
-      xvt.relcorr = svRelativity(when, ell);
-      xvt.clkbias = svClockBias(when);
-      xvt.clkdrift = svClockDrift(when);
-      xvt.frame = RefFrame(frame, when);
-
-         // Compute true anomaly
-      q     = SQRT( 1.0e0 - lecc*lecc);
-      sinea = ::sin(ea);
-      cosea = ::cos(ea);
-      G     = 1.0e0 - lecc * cosea;
-
-         //  G*SIN(TA) AND G*COS(TA)
-      GSTA  = q * sinea;
-      GCTA  = cosea - lecc;
-
-         //  True anomaly
-      truea = atan2 ( GSTA, GCTA );
-
-         // Argument of lat and correction terms (2nd harmonic)
-      alat  = truea + w;
-      talat = 2.0e0 * alat;
-      c2al  = ::cos( talat );
-      s2al  = ::sin( talat );
-
-      du  = c2al * Cuc +  s2al * Cus;
-      dr  = c2al * Crc +  s2al * Crs;
-      di  = c2al * Cic +  s2al * Cis;
-
-         // U = updated argument of lat, R = radius, AINC = inclination
-      U    = alat + du;
-      R    = Ak*G + dr;
-      AINC = i0 + tdrinc * elapte  +  di;
-
-         //  Longitude of ascending node (ANLON)
-      ANLON = OMEGA0 + (OMEGAdot - ell.angVelocity()) *
-         elapte - ell.angVelocity() * ToeSOW;
-
-         // In plane location
-      cosu = ::cos( U );
-      sinu = ::sin( U );
-
-      xip  = R * cosu;
-      yip  = R * sinu;
-
-         //  Angles for rotation to earth fixed
-      can  = ::cos( ANLON );
-      san  = ::sin( ANLON );
-      cinc = ::cos( AINC  );
-      sinc = ::sin( AINC  );
-
-         // Earth fixed - meters
-      xef  =  xip*can  -  yip*cinc*san;
-      yef  =  xip*san  +  yip*cinc*can;
-      zef  =              yip*sinc;
-
-      xvt.x[0] = xef;
-      xvt.x[1] = yef;
-      xvt.x[2] = zef;
-
-         // Compute velocity of rotation coordinates
-      dek = amm / G;
-      dlk = amm * q / (G*G);
-      div = tdrinc - 2.0e0 * dlk *
-         ( Cic  * s2al - Cis * c2al );
-      domk = OMEGAdot - ell.angVelocity();
-      duv = dlk*(1.e0+ 2.e0 * (Cus*c2al - Cuc*s2al) );
-      drv = Ak * lecc * dek * sinea - 2.e0 * dlk *
-         ( Crc * s2al - Crs * c2al ) + Adot * G;
-
-      dxp = drv*cosu - R*sinu*duv;
-      dyp = drv*sinu + R*cosu*duv;
-
-         // Calculate velocities
-      vxef = dxp*can - xip*san*domk - dyp*cinc*san
-         + yip*( sinc*san*div - cinc*can*domk);
-      vyef = dxp*san + xip*can*domk + dyp*cinc*can
-         - yip*( sinc*can*div + cinc*san*domk);
-      vzef = dyp*sinc + yip*cinc*div;
-
-         // Move results into output variables
-      xvt.v[0] = vxef;
-      xvt.v[1] = vyef;
-      xvt.v[2] = vzef;
-      xvt.health = toXvtHealth(health);
+      double lecc = ecc;      // eccentricity
+      double tdrinc = idot;   // dt inclination
+      double amm0 = sqrtgm / (A*Ahalf);
+      double q = SQRT( 1.0e0 - lecc*lecc);
+      double domk = OMEGAdot - angVel;
+      double angVelToe = angVel * ToeSOW;
+      Xvt::HealthStatus xvtHealth = toXvtHealth(health);
+
+      for (size_t i = 0; i < count; i++)
+      {
+         const CommonTime& t(when[i]);
+         Xvt& out(xvt[i]);
+            // Compute time since ephemeris & clock epochs
+         elapte = t - Toe;
+
+            // Compute A at time of interest
+         double Ak = A + Adot * elapte;
+
+            // Compute mean motion
+         double dnA = dn + 0.5 * dndot * elapte;
+            // NOT Ak because this equation specifies A0, not Ak.
+         amm  = amm0 + dnA;
+
+            // In-plane angles
+            //     meana - Mean anomaly
+            //     ea    - Eccentric anomaly
+            //     truea - True anomaly
+
+         meana = M0 + elapte * amm;
+         meana = fmod(meana, twoPI);
+
+         ea = meana + lecc * ::sin(meana);
+
+         int loop_cnt = 1;
+         do  {
+            F = meana - ( ea - lecc * ::sin(ea));
+            G = 1.0 - lecc * ::cos(ea);
+            delea = F/G;
+            ea = ea + delea;
+            loop_cnt++;
+         } while ( (fabs(delea) > 1.0e-11 ) && (loop_cnt <= 20) );
+
+         sinea = ::sin(ea);
+         cosea = ::cos(ea);
+
+            // Compute clock corrections
+         out.relcorr = svRelativity(t, ell);
+         out.clkbias = svClockBias(t);
+         out.clkdrift = svClockDrift(t);
+         out.frame = RefFrame(frame, t);
+
+            // Compute true anomaly
+         G     = 1.0e0 - lecc * cosea;
+
+            //  G*SIN(TA) AND G*COS(TA)
+         GSTA  = q * sinea;
+         GCTA  = cosea - lecc;
+
+            //  True anomaly
+         truea = atan2 ( GSTA, GCTA );
+
+            // Argument of lat and correction terms (2nd harmonic)
+         alat  = truea + w;
+         talat = 2.0e0 * alat;
+         c2al  = ::cos( talat );
+         s2al  = ::sin( talat );
+
+         du  = c2al * Cuc +  s2al * Cus;
+         dr  = c2al * Crc +  s2al * Crs;
+         di  = c2al * Cic +  s2al * Cis;
+
+            // U = updated argument of lat, R = radius, AINC = inclination
+         U    = alat + du;
+         R    = Ak*G + dr;
+         AINC = i0 + tdrinc * elapte  +  di;
+
+            //  Longitude of ascending node (ANLON)
+         ANLON = OMEGA0 + domk * elapte - angVelToe;
+
+            // In plane location
+         cosu = ::cos( U );
+         sinu = ::sin( U );
+
+         xip  = R * cosu;
+         yip  = R * sinu;
+
+            //  Angles for rotation to earth fixed
+         can  = ::cos( ANLON );
+         san  = ::sin( ANLON );
+         cinc = ::cos( AINC  );
+         sinc = ::sin( AINC  );
+
+            // Earth fixed - meters
+         xef  =  xip*can  -  yip*cinc*san;
+         yef  =  xip*san  +  yip*cinc*can;
+         zef  =              yip*sinc;
+
+         out.x[0] = xef;
+         out.x[1] = yef;
+         out.x[2] = zef;
+
+            // Compute velocity of rotation coordinates
+         dek = amm / G;
+         dlk = amm * q / (G*G);
+         div = tdrinc - 2.0e0 * dlk *
+            ( Cic  * s2al - Cis * c2al );
+         duv = dlk*(1.e0+ 2.e0 * (Cus*c2al - Cuc*s2al) );
+         drv = Ak * lecc * dek * sinea - 2.e0 * dlk *
+            ( Crc * s2al - Crs * c2al ) + Adot * G;
+
+         dxp = drv*cosu - R*sinu*duv;
+         dyp = drv*sinu + R*cosu*duv;
+
+            // Calculate velocities
+         vxef = dxp*can - xip*san*domk - dyp*cinc*san
+            + yip*( sinc*san*div - cinc*can*domk);
+         vyef = dxp*san + xip*can*domk + dyp*cinc*can
+            - yip*( sinc*can*div + cinc*san*domk);
+         vzef = dyp*sinc + yip*cinc*div;
+
+            // Move results into output variables
+         out.v[0] = vxef;
+         out.v[1] = vyef;
+         out.v[2] = vzef;
+         out.health = xvtHealth;
+      }
       return true;
    }
 
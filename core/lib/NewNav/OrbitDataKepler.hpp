@@ -105,6 +105,7 @@ namespace gnsstk
           *   unavailable. */
       bool getXvt(const CommonTime& when, Xvt& xvt,
                   const ObsID& oid = ObsID()) override = 0;
+      using OrbitData::getXvt;
 
          /** Compute satellite relativity correction (sec) at the given time.
           * @note Each child class must implement this method to call
@@ -139,6 +140,24 @@ namespace gnsstk
       bool getXvt(const CommonTime& when, const EllipsoidModel& ell, Xvt& xvt,
                   const ObsID& oid = ObsID());
 
+         /** Compute the satellite's position and velocity at a
+          * number of times.  Terms that do not depend on the time of
+          * interest are computed once for the whole array.
+          * @param[in] when An array of \a count times at which to
+          *   compute the xvt.
+          * @param[in] count The number of elements in \a when and \a xvt.
+          * @param[in] ell The ellipsoid used in computing the Xvt
+          *   (specifically EllipsoidModel::gm() and
+          *   EllipsoidModel::angVelocity()).
+          * @param[out] xvt An array of \a count Xvt objects, where
+          *   xvt[i] is set to the position and velocity at when[i].
+          * @param[in] oid Ignored at this level, only used in derived classes.
+          * @return true if successful, false if required nav data was
+          *   unavailable. */
+      bool getXvt(const CommonTime* when, size_t count,
+                  const EllipsoidModel& ell, Xvt* xvt,
+                  const ObsID& oid = ObsID());
+
          /** Compute satellite relativity correction (sec) at the given time.
           * @param[in] ell The ellipsoid used in computing the Xvt
           *   (specifically EllipsoidModel::gm()).
@@ -36,6 +36,7 @@
 //                            release, distribution is unlimited.
 //
 //==============================================================================
+#include <algorithm>
 #include <iterator>
 #include "SP3NavDataFactory.hpp"
 #include "SP3Stream.hpp"
@@ -47,6 +48,7 @@
 #include "Rinex3ClockData.hpp"
 #include "TimeString.hpp"
 #include "MiscMath.hpp"
+#include "GNSSconstants.hpp"
 #include "DebugTrace.hpp"
 #include "NavDataFactoryStoreCallback.hpp"
 
@@ -98,7 +100,10 @@ namespace gnsstk
            interpType(ClkInterpType::Lagrange),
            halfOrderClk(5),
            halfOrderPos(5),
-           initOrbitDataVal(0.0)
+           initOrbitDataVal(0.0),
+           tableChangeCount(0),
+           compacted(false),
+           compactChangeCount(0)
    {
       supportedSignals.insert(NavSignalID(SatelliteSystem::BeiDou,
                                           CarrierBand::B1,
@@ -249,6 +254,10 @@ namespace gnsstk
       }
          // ignore the return code of transNavMsgID, find might still work.
       transNavMsgID(nmid, genericID);
+      if (compacted)
+      {
+         return findCompact(genericID, when, navOut);
+      }
       rv = findGeneric(NavMessageType::Ephemeris, genericID, when, navOut);
       if (rv == false)
       {
@@ -559,207 +568,1307 @@ namespace gnsstk
 
 
    bool SP3NavDataFactory ::
-   addDataSource(const std::string& source)
+   getXvt(const SatID& sat, const CommonTime& when, Xvt& xvt)
    {
-      DEBUGTRACE_FUNCTION();
-      gnsstk::NavDataFactoryStoreCallback cb(this, data, nearestData,
-                                             offsetData);
-      return process(source, cb);
+      double pv[SatTable::ephVals], bd[SatTable::clkVals];
+      RefFrame frame;
+      if (compacted)
+      {
+         const ChebTable *eph = evalCompact(sat, when, pv, bd);
+         if (eph == nullptr)
+         {
+            return false;
+         }
+         frame = dynamic_cast<OrbitDataSP3*>(eph->rep.get())->frame;
+      }
+      else
+      {
+         if (tableChangeCount != changeCount)
+         {
+            ephTables.clear();
+            clkTables.clear();
+            tableChangeCount = changeCount;
+         }
+         const SatTable *eph = getTable(NavMessageType::Ephemeris, sat);
+         if (eph == nullptr)
+         {
+            return false;
+         }
+         const SatTable *clk = getTable(NavMessageType::Clock, sat);
+         if (clk == nullptr)
+         {
+            return false;
+         }
+         size_t lo, exact;
+         bool interp;
+         double dt = when - eph->ref;
+         if (!eph->window(dt, checkDataGapPos, checkIntervalPos,
+                          gapIntervalPos, maxIntervalPos, lo, exact, interp))
+         {
+            return false;
+         }
+         if (interp)
+         {
+            interpEph(*eph, lo, dt, pv);
+         }
+         else
+         {
+               // exact match without enough data to interpolate
+            for (unsigned i = 0; i < SatTable::ephVals; i++)
+            {
+               pv[i] = eph->value(exact, i);
+            }
+         }
+         dt = when - clk->ref;
+         if (!clk->window(dt, checkDataGapClk, checkIntervalClk,
+                          gapIntervalClk, maxIntervalClk, lo, exact, interp))
+         {
+            return false;
+         }
+         if (interp)
+         {
+            interpClk(*clk, lo, dt, bd);
+         }
+         else
+         {
+            bd[0] = clk->value(exact, 0);
+            bd[1] = clk->value(exact, 1);
+         }
+         frame = eph->frame;
+      }
+         // same as OrbitDataSP3::getXvt
+      for (unsigned i = 0; i < 3; i++)
+      {
+         xvt.x[i] = pv[i] * 1000.0;
+         xvt.v[i] = pv[i+3] * 0.1;
+      }
+      xvt.clkbias = bd[0] * 1e-6; // microseconds to seconds
+      xvt.clkdrift = bd[1] * 1e-6;
+      xvt.health = Xvt::HealthStatus::Unused;
+      xvt.computeRelativityCorrection();
+      xvt.frame = frame;
+      return true;
    }
 
 
-   bool SP3NavDataFactory ::
-   process(const std::string& filename,
-           NavDataFactoryCallback& cb)
+   void SP3NavDataFactory ::
+   interpEph(const SatTable& eph, size_t lo, double dt, double* pv) const
    {
-      DEBUGTRACE_FUNCTION();
-      bool rv = true;
-      bool processEph = (procNavTypes.count(NavMessageType::Ephemeris) > 0);
-      bool processClk = (procNavTypes.count(NavMessageType::Clock) > 0);
-         // When either of these two change, we store the existing
-         // NavDataPtr and create a new one.
-      CommonTime lastTime;
-      SatID lastSat;
-      NavDataPtr eph, clk;
-      try
+      if (eph.haveValue(lo, 3) || eph.haveValue(lo, 4) || eph.haveValue(lo, 5))
       {
-         SP3Stream is(filename.c_str(), ios::in);
-         SP3Header head;
-         SP3Data data;
-         if (!is)
+         for (unsigned i = 0; i < 3; i++)
          {
-            return false;
+            eph.interpolate(lo, dt, i, pv[i], nullptr);
+            eph.interpolate(lo, dt, i+3, pv[i+3], nullptr);
          }
-         is >> head;
-         if (!is)
+      }
+      else
+      {
+            // have position, must derive velocity
+         for (unsigned i = 0; i < 3; i++)
          {
-            return addRinexClock(filename, cb);
+            eph.interpolate(lo, dt, i, pv[i], &pv[i+3]);
+            pv[i+3] *= 10000.; // km/sec to dm/sec
          }
+      }
+   }
 
-            // know whether to look for the extra info contained in SP3c
-         bool isC = (head.version==SP3Header::SP3c);
-            // check/save TimeSystem to storeTimeSystem
-         if ((head.timeSystem != TimeSystem::Any) &&
-             (head.timeSystem != TimeSystem::Unknown))
-         {
-               // if store time system has not been set, do so
-            if (storeTimeSystem == TimeSystem::Any)
+
+   void SP3NavDataFactory ::
+   interpClk(const SatTable& clk, size_t lo, double dt, double* bd) const
+   {
+      bool haveDrift = clk.haveValue(lo, 1);
+      size_t Nlow = lo + halfOrderClk - 1, Nhi = Nlow + 1;
+      double slopedt = clk.t[Nhi] - clk.t[Nlow], slope;
+      switch (interpType)
+      {
+         case ClkInterpType::Lagrange:
+            if (haveDrift)
             {
-                  /// @note store TimeSystem must be consistent.
-               storeTimeSystem = head.timeSystem;
+               clk.interpolate(lo, dt, 0, bd[0], nullptr);
+               clk.interpolate(lo, dt, 1, bd[1], nullptr);
             }
-            else if (storeTimeSystem != head.timeSystem)
+            else
             {
-                  // Don't load an SP3 file with a differing time system
-               cerr << "Time system mismatch in SP3 data, "
-                    << gnsstk::StringUtils::asString(storeTimeSystem)
-                    << " (store) != "
-                    << gnsstk::StringUtils::asString(head.timeSystem)
-                    << " (file)" << endl;
-               return false;
+               clk.interpolate(lo, dt, 0, bd[0], &bd[1]);
             }
-         }
+            break;
+         case ClkInterpType::Linear:
+            slope = (clk.value(Nhi,0) - clk.value(Nlow,0)) / slopedt;
+            bd[0] = clk.value(Nlow,0) + slope*(dt-clk.t[Nlow]);
+            if (haveDrift)
+            {
+               slope = (clk.value(Nhi,1) - clk.value(Nlow,1)) / slopedt;
+               bd[1] = clk.value(Nlow,1) + slope*(dt-clk.t[Nlow]);
+            }
+            else
+            {
+               bd[1] = slope;
+            }
+            break;
+         default:
+            {
+               gnsstk::InvalidRequest unkType(
+                  "Clock interpolation type " +
+                  StringUtils::asString(static_cast<int>(interpType)) +
+                  " is not supported");
+               GNSSTK_THROW(unkType);
+            }
+            break;
+      }
+   }
 
-         while (is)
+
+   void SP3NavDataFactory ::
+   compact(double posTol, double velTol, double biasTol, double driftTol)
+   {
+      DEBUGTRACE_FUNCTION();
+      if (compacted)
+      {
+         return;
+      }
+         // the compact time index refers to the samples being replaced
+      thaw();
+         // tolerances in the units stored in OrbitDataSP3
+      double ephTol[SatTable::ephVals] = {
+         posTol*1e-3, posTol*1e-3, posTol*1e-3,
+         velTol*10.0, velTol*10.0, velTol*10.0 };
+      double clkTol[SatTable::clkVals] = { biasTol*1e6, driftTol*1e6 };
+      NavMessageType types[] = { NavMessageType::Ephemeris,
+                                 NavMessageType::Clock };
+      for (NavMessageType nmt : types)
+      {
+         bool findEph = (nmt == NavMessageType::Ephemeris);
+         ChebTableMap& chebs(findEph ? ephCheb : clkCheb);
+         auto dataIt = data.find(nmt);
+         if (dataIt == data.end())
          {
-            is >> data;
-            if (!is)
+            continue;
+         }
+         for (auto& sati : dataIt->second)
+         {
+            if (sati.second.empty())
             {
-               if (is.eof())
-                  break;
-               else
-                  return false; // some other error
+               continue;
             }
-            if ((lastSat != data.sat) || (lastTime != data.time))
+            OrbitDataSP3 *first = dynamic_cast<OrbitDataSP3*>(
+               sati.second.begin()->second.get());
+            if (first == nullptr)
             {
-               DEBUGTRACE("time or satellite change, storing");
-               lastSat = data.sat;
-               lastTime = data.time;
-               DEBUGTRACE("storing eph");
-               if (!store(processEph, cb, eph))
-                  return false;
-               DEBUGTRACE("storing clk");
-               if (!store(processClk && useSP3clock, cb, clk))
-                  return false;
+               continue;
             }
-               // Don't process time records otherwise we'll end up
-               // storing junk in the store that has a time stamp and
-               // a bogus satellite ID.
-            if (data.RecType != '*')
+            SatTable tab;
+            tab.build(&sati.second, findEph,
+                      (findEph ? halfOrderPos : halfOrderClk));
+            ChebTable& cheb(chebs[sati.first.sat]);
+            fitTable(tab, findEph, (findEph ? ephTol : clkTol), cheb);
+               // Keep the time stamps of the segment ends, which
+               // syncCompact() checks against, but replace the
+               // samples with a single object that has only the
+               // meta-data.
+            std::shared_ptr<OrbitDataSP3> rep =
+               std::make_shared<OrbitDataSP3>(initOrbitDataVal);
+            rep->timeStamp = first->timeStamp;
+            rep->signal = first->signal;
+            rep->coordSystem = first->coordSystem;
+            rep->frame = first->frame;
+            cheb.rep = rep;
+            keepBoundaries(sati.second, cheb);
+            for (auto& ti : sati.second)
             {
-               if (rejectBadPosFlag &&
-                   (data.x[0] == 0.0) ||
-                   (data.x[1] == 0.0) ||
-                   (data.x[2] == 0.0))
-               {
-                     // don't add this record with a bad position
-                  continue;
-               }
-               else if (rejectBadClockFlag && (fabs(data.clk) >= maxBias))
-               {
-                     // don't add this record with a bad clock
-                  continue;
-               }
-               if (processEph)
-               {
-                     // If the orbit data are predictions and we've
-                     // been asked to ignore position predictions, do
-                     // so. Otherwise, add the data to the store.
-                  if ((!rejectPredPosFlag || data.orbitPredFlag) &&
-                      !convertToOrbit(head, data, isC, eph, initOrbitDataVal))
-                  {
-                     return false;
-                  }
-               }
-               if (processClk)
-               {
-                     // If the clock data are predictions and we've
-                     // been asked to ignore clock predictions, do
-                     // so. Otherwise, add the data to the store.
-                  if ((!rejectPredClockFlag || data.clockPredFlag) &&
-                      !convertToClock(head, data, isC, clk, initOrbitDataVal))
-                  {
-                     return false;
-                  }
-               }
+               ti.second = rep;
             }
          }
-            // store the final record(s)
-         DEBUGTRACE("storing last eph");
-         if (!store(processEph, cb, eph))
-            return false;
-         DEBUGTRACE("storing last clk");
-         if (!store(processClk, cb, clk))
-            return false;
+            // clean out satellites with no segments
+         for (auto sati = dataIt->second.begin();
+              sati != dataIt->second.end();)
+         {
+            if (sati->second.empty())
+               sati = dataIt->second.erase(sati);
+            else
+               ++sati;
+         }
+         if (dataIt->second.empty())
+         {
+            data.erase(dataIt);
+         }
       }
-      catch (gnsstk::Exception& exc)
+         // SP3 data is never searched by nearest time.
+      nearestData.clear();
+      ephTables.clear();
+      clkTables.clear();
+      compacted = true;
+      compactChangeCount = changeCount;
+   }
+
+
+   void SP3NavDataFactory ::
+   seal()
+   {
+      NavDataFactoryWithStore::seal();
+         // Build everything that getXvt() and find() would otherwise
+         // build on first use, after which they only read.
+      if (compacted)
       {
-         rv = false;
-         cerr << exc << endl;
+         syncCompact();
+         return;
       }
-      catch (std::exception& exc)
+      if (tableChangeCount != changeCount)
       {
-         rv = false;
-         cerr << exc.what() << endl;
+         ephTables.clear();
+         clkTables.clear();
+         tableChangeCount = changeCount;
       }
-      catch (...)
+      sealed = false;
+      for (NavMessageType nmt : { NavMessageType::Ephemeris,
+                                  NavMessageType::Clock })
       {
-         rv = false;
-         cerr << "Unknown exception" << endl;
+         auto dataIt = data.find(nmt);
+         if (dataIt == data.end())
+         {
+            continue;
+         }
+         for (const auto& sati : dataIt->second)
+         {
+            getTable(nmt, sati.first.sat);
+         }
       }
-      return rv;
+      sealed = true;
    }
 
 
-   bool SP3NavDataFactory ::
-   addRinexClock(const std::string& source, NavDataFactoryCallback& cb)
+   void SP3NavDataFactory ::
+   fitTable(const SatTable& tab, bool findEph, const double* tol,
+            ChebTable& cheb)
    {
-      bool rv = true;
-         // We have to handle this a bit carefully.  If we're not
-         // processing clock data, we still need to at least identify
-         // the data, otherwise NavLibrary/MultiFormatNavDataFactory
-         // might incorrectly handle the processing of the file.
-      bool processClk = (procNavTypes.count(NavMessageType::Clock) > 0);
-      try
+         // Number of coefficients to fit for each segment before
+         // truncation.  This is enough to reproduce the
+         // interpolating polynomial of a single interval exactly.
+      const unsigned nfit = std::max(2*tab.halfOrder, 20u);
+         // Number of evenly spaced points in each interval where
+         // the fit is checked.  As the fit is not checked everywhere,
+         // it must be within half the tolerance at these points.
+      const unsigned nchecks = 8;
+      unsigned ncomp = tab.nvals;
+      size_t nint = (tab.t.empty() ? 0 : tab.t.size()-1);
+      cheb.ref = tab.ref;
+      cheb.ncomp = ncomp;
+      cheb.begin.clear();
+      cheb.end.clear();
+      cheb.offset.assign(1, 0);
+      cheb.coef.clear();
+         // Determine the samples to interpolate with for each
+         // interval, using the time in the middle to avoid the
+         // special treatment of exact matches.
+      std::vector<size_t> los(nint);
+      std::vector<bool> ok(nint);
+      for (size_t k = 0; k < nint; k++)
       {
-         Rinex3ClockStream is(source.c_str(), ios::in);
-         Rinex3ClockHeader head;
-         Rinex3ClockData data;
-         if (!is)
+         size_t exact;
+         bool interp;
+         double dt = (tab.t[k] + tab.t[k+1]) / 2.0;
+         if (findEph)
          {
-            return false;
+            ok[k] = tab.window(dt, checkDataGapPos, checkIntervalPos,
+                               gapIntervalPos, maxIntervalPos, los[k],
+                               exact, interp) && interp;
          }
-         is >> head;
-         if (!is)
+         else
          {
-            return false;
+            ok[k] = tab.window(dt, checkDataGapClk, checkIntervalClk,
+                               gapIntervalClk, maxIntervalClk, los[k],
+                               exact, interp) && interp;
          }
-
-            // At this point, we have valid RINEX clock.  Probably.
-         if (!processClk)
-            return true; // ...but the user doesn't want it.
-
-            // check/save TimeSystem to storeTimeSystem
-         if(head.timeSystem != TimeSystem::Any &&
-            head.timeSystem != TimeSystem::Unknown)
+      }
+      std::vector<double> cosTab(nfit*nfit), fvals(nfit*ncomp),
+         coef(nfit*ncomp), best, ref(ncomp), val(ncomp);
+      for (unsigned k = 0; k < nfit; k++)
+      {
+         for (unsigned m = 0; m < nfit; m++)
+         {
+            cosTab[k*nfit+m] = ::cos(PI * k * (m+0.5) / nfit);
+         }
+      }
+         // Evaluate the interpolation in interval k at time dt.
+      auto evalRef = [&](size_t k, double dt, double* out) -> void
+      {
+         if (findEph)
+            interpEph(tab, los[k], dt, out);
+         else
+            interpClk(tab, los[k], dt, out);
+      };
+         // Fit segment [t[s],t[e]], put the truncated coefficients
+         // in best and return true if within tolerance.
+      auto fit = [&](size_t s, size_t e, unsigned& nkeep) -> bool
+      {
+         double a = tab.t[s], b = tab.t[e];
+         size_t k = s;
+            // the nodes are in decreasing time order
+         for (unsigned m = nfit; m-- > 0;)
+         {
+            double dt = (a+b)/2.0 + (b-a)/2.0 * cosTab[nfit+m];
+            while ((k+1 < e) && (dt > tab.t[k+1]))
+               k++;
+            evalRef(k, dt, &fvals[m*ncomp]);
+         }
+         for (unsigned c = 0; c < ncomp; c++)
          {
-               // if store time system has not been set, do so
-            if(storeTimeSystem == TimeSystem::Any)
+            for (unsigned j = 0; j < nfit; j++)
             {
-                  /// @note store TimeSystem must be consistent.
-               storeTimeSystem = head.timeSystem;
+               double sum = 0.0;
+               for (unsigned m = 0; m < nfit; m++)
+                  sum += fvals[m*ncomp+c] * cosTab[j*nfit+m];
+               coef[c*nfit+j] = (j == 0 ? 1.0 : 2.0) * sum / nfit;
             }
-            else if (storeTimeSystem != head.timeSystem)
+         }
+            // Drop the high order terms that contribute less than
+            // a tenth of the tolerance in total.
+         std::vector<double> dropped(ncomp, 0.0);
+         for (nkeep = nfit; nkeep > 1; nkeep--)
+         {
+            bool drop = true;
+            for (unsigned c = 0; c < ncomp; c++)
             {
-                  // Don't load a RINEX clock file with a differing time system
-               cerr << "Time system mismatch in SP3/RINEX clock data "
-                    << gnsstk::StringUtils::asString(storeTimeSystem)
-                    << " (store) != "
-                    << gnsstk::StringUtils::asString(head.timeSystem)
-                    << " (file)" << endl;
-               return false;
+               if (dropped[c] + fabs(coef[c*nfit+nkeep-1]) > tol[c]*0.1)
+                  drop = false;
+            }
+            if (!drop)
+               break;
+            for (unsigned c = 0; c < ncomp; c++)
+               dropped[c] += fabs(coef[c*nfit+nkeep-1]);
+         }
+         best.resize(ncomp*nkeep);
+         for (unsigned c = 0; c < ncomp; c++)
+         {
+            std::copy(&coef[c*nfit], &coef[c*nfit+nkeep], &best[c*nkeep]);
+         }
+            // verify against the interpolation
+         ChebTable test;
+         test.ncomp = ncomp;
+         test.offset.assign(1, 0);
+         test.add(a, b, &best[0], nkeep);
+         for (k = s; k < e; k++)
+         {
+            for (unsigned ci = 0; ci <= nchecks; ci++)
+            {
+               double dt;
+               if (ci < nchecks)
+                  dt = tab.t[k] + ci * (tab.t[k+1]-tab.t[k]) / nchecks;
+               else if (k+1 == e)
+                  dt = b;
+               else
+                  continue;
+               evalRef(k, dt, &ref[0]);
+               test.eval(dt, &val[0]);
+               for (unsigned c = 0; c < ncomp; c++)
+               {
+                  if (fabs(val[c] - ref[c]) > tol[c]*0.5)
+                     return false;
+               }
             }
          }
+         return true;
+      };
+      size_t s = 0;
+      while (s < nint)
+      {
+         if (!ok[s])
+         {
+            s++;
+            continue;
+         }
+            // A single interval is always accepted, as its
+            // interpolating polynomial is reproduced exactly.
+         unsigned nkeep;
+         size_t e = s+1;
+         fit(s, e, nkeep);
+         std::vector<double> segCoef(best);
+         unsigned segKeep = nkeep;
+         while ((e < nint) && ok[e] && fit(s, e+1, nkeep))
+         {
+            e++;
+            segCoef = best;
+            segKeep = nkeep;
+         }
+         cheb.add(tab.t[s], tab.t[e], &segCoef[0], segKeep);
+         s = e;
+      }
+      DEBUGTRACE(cheb.begin.size() << " segments, " << cheb.coef.size()
+                 << " coefficients for " << tab.t.size() << " samples");
+   }
+
+
+   void SP3NavDataFactory ::
+   syncCompact()
+   {
+      if (compactChangeCount == changeCount)
+      {
+         return;
+      }
+      compactChangeCount = changeCount;
+      ChebTableMap *maps[] = { &ephCheb, &clkCheb };
+      for (ChebTableMap *chebs : maps)
+      {
+         for (auto ci = chebs->begin(); ci != chebs->end();)
+         {
+            ChebTable& cheb(ci->second);
+            const NavMap *nm = nullptr;
+            auto dataIt = data.find(cheb.rep->signal.messageType);
+            if (dataIt != data.end())
+            {
+               auto sati = dataIt->second.find(cheb.rep->signal);
+               if (sati != dataIt->second.end())
+               {
+                  nm = &sati->second;
+               }
+            }
+            if (nm == nullptr)
+            {
+               ci = chebs->erase(ci);
+               continue;
+            }
+               // Keep only the segments whose first and last
+               // samples are still in the store.  Samples removed
+               // from within a segment by edit() are handled by
+               // editCompact().
+            ChebTable keep;
+            keep.ref = cheb.ref;
+            keep.ncomp = cheb.ncomp;
+            keep.rep = cheb.rep;
+            keep.offset.assign(1, 0);
+            for (size_t i = 0; i < cheb.begin.size(); i++)
+            {
+               if (hasEntry(*nm, cheb.ref, cheb.begin[i]) &&
+                   hasEntry(*nm, cheb.ref, cheb.end[i]))
+               {
+                  keep.add(cheb, i);
+               }
+            }
+            cheb = keep;
+            ++ci;
+         }
+      }
+   }
+
+
+   const SP3NavDataFactory::ChebTable* SP3NavDataFactory ::
+   evalCompact(const SatID& sat, const CommonTime& when, double* pv,
+               double* bd)
+   {
+      syncCompact();
+      auto ephi = ephCheb.find(sat);
+      if ((ephi == ephCheb.end()) ||
+          !ephi->second.eval(when - ephi->second.ref, pv))
+      {
+         return nullptr;
+      }
+      auto clki = clkCheb.find(sat);
+      if ((clki == clkCheb.end()) ||
+          !clki->second.eval(when - clki->second.ref, bd))
+      {
+         return nullptr;
+      }
+      return &ephi->second;
+   }
+
+
+   bool SP3NavDataFactory ::
+   findCompact(const NavSatelliteID& nsid, const CommonTime& when,
+               NavDataPtr& navOut)
+   {
+      double pv[SatTable::ephVals], bd[SatTable::clkVals];
+      const ChebTable *eph = nullptr;
+      if (!nsid.isWild())
+      {
+         eph = evalCompact(nsid.sat, when, pv, bd);
+      }
+      else
+      {
+            // To support wildcard signals, we need to do a linear search.
+         syncCompact();
+         for (const auto& ephi : ephCheb)
+         {
+            if (ephi.second.rep->signal.NavSatelliteID::operator==(nsid) &&
+                ((eph = evalCompact(ephi.first, when, pv, bd)) != nullptr))
+            {
+               break;
+            }
+         }
+      }
+      if (eph == nullptr)
+      {
+         return false;
+      }
+      std::shared_ptr<OrbitDataSP3> rv = std::make_shared<OrbitDataSP3>(
+         *dynamic_cast<OrbitDataSP3*>(eph->rep.get()));
+      rv->timeStamp = when;
+      for (unsigned i = 0; i < 3; i++)
+      {
+         rv->pos[i] = pv[i];
+         rv->vel[i] = pv[i+3];
+      }
+      rv->clkBias = bd[0];
+      rv->clkDrift = bd[1];
+      navOut = rv;
+      return true;
+   }
+
+
+   bool SP3NavDataFactory::ChebTable ::
+   eval(double dt, double* out) const
+   {
+      size_t i = std::upper_bound(begin.begin(), begin.end(), dt) -
+         begin.begin();
+      if ((i == 0) || (dt > end[i-1]))
+      {
+         return false;
+      }
+      i--;
+      double a = begin[i], b = end[i];
+      double u = (2.0*dt - a - b) / (b - a), u2 = 2.0*u, b1, b2, tmp;
+      unsigned n = (offset[i+1] - offset[i]) / ncomp;
+      const double *c = &coef[offset[i]];
+         // Clenshaw recurrence for each component
+      for (unsigned comp = 0; comp < ncomp; comp++, c += n)
+      {
+         b1 = b2 = 0.0;
+         for (unsigned k = n-1; k > 0; k--)
+         {
+            tmp = c[k] + u2*b1 - b2;
+            b2 = b1;
+            b1 = tmp;
+         }
+         out[comp] = c[0] + u*b1 - b2;
+      }
+      return true;
+   }
+
+
+   void SP3NavDataFactory::ChebTable ::
+   add(double a, double b, const double* c, unsigned n)
+   {
+      begin.push_back(a);
+      end.push_back(b);
+      coef.insert(coef.end(), c, c + n*ncomp);
+      offset.push_back(coef.size());
+   }
+
+
+   void SP3NavDataFactory::ChebTable ::
+   add(const ChebTable& from, size_t i)
+   {
+      add(from.begin[i], from.end[i], &from.coef[from.offset[i]],
+          (from.offset[i+1] - from.offset[i]) / from.ncomp);
+   }
+
+
+   bool SP3NavDataFactory ::
+   hasEntry(const NavMap& nm, const CommonTime& ref, double dt)
+   {
+      auto ti = nm.lower_bound(ref + (dt-1e-6));
+      return ((ti != nm.end()) && (ti->first - ref < dt+1e-6));
+   }
+
+
+   bool SP3NavDataFactory ::
+   isAvailable(const ChebTable& cheb, const CommonTime& fromTime,
+               const CommonTime& toTime) const
+   {
+      const NavMap *nm = getNavMap(cheb.rep->signal);
+      if (nm == nullptr)
+      {
+         return false;
+      }
+      double from = fromTime - cheb.ref, to = toTime - cheb.ref;
+         // start with the first segment ending at or after from
+      for (size_t i = std::lower_bound(cheb.end.begin(), cheb.end.end(), from)
+              - cheb.end.begin();
+           (i < cheb.begin.size()) && (cheb.begin[i] < to); i++)
+      {
+         if (hasEntry(*nm, cheb.ref, cheb.begin[i]) &&
+             hasEntry(*nm, cheb.ref, cheb.end[i]))
+         {
+            return true;
+         }
+      }
+      return false;
+   }
+
+
+   void SP3NavDataFactory ::
+   keepBoundaries(NavMap& nm, const ChebTable& cheb)
+   {
+      size_t i = 0;
+      for (auto ti = nm.begin(); ti != nm.end();)
+      {
+         double dt = ti->first - cheb.ref;
+            // skip segments ending before this entry, allowing for
+            // rounding in the conversion to CommonTime
+         while ((i < cheb.end.size()) && (cheb.end[i] < dt-1e-6))
+         {
+            i++;
+         }
+         if ((i < cheb.end.size()) &&
+             ((fabs(dt - cheb.begin[i]) < 1e-6) ||
+              (fabs(dt - cheb.end[i]) < 1e-6)))
+         {
+            ++ti;
+         }
+         else
+         {
+            ti = nm.erase(ti);
+         }
+      }
+   }
+
+
+   void SP3NavDataFactory ::
+   editCompact(const CommonTime& fromTime, const CommonTime& toTime,
+               const NavSatelliteID* satID)
+   {
+      syncCompact();
+      ChebTableMap *maps[] = { &ephCheb, &clkCheb };
+      for (ChebTableMap *chebs : maps)
+      {
+         for (auto& ci : *chebs)
+         {
+            ChebTable& cheb(ci.second);
+            const NavSatelliteID& nsid(cheb.rep->signal);
+            if ((satID != nullptr) && (nsid != *satID))
+            {
+               continue;
+            }
+            double from = fromTime - cheb.ref, to = toTime - cheb.ref;
+            ChebTable keep;
+            keep.ref = cheb.ref;
+            keep.ncomp = cheb.ncomp;
+            keep.rep = cheb.rep;
+            keep.offset.assign(1, 0);
+            for (size_t i = 0; i < cheb.begin.size(); i++)
+            {
+               if ((cheb.begin[i] >= to) || (cheb.end[i] < from))
+               {
+                  keep.add(cheb, i);
+               }
+            }
+            if (keep.begin.size() == cheb.begin.size())
+            {
+               continue;
+            }
+            cheb = keep;
+               // Remove the entries of the removed segments that are
+               // outside the edited span, which edit() won't.
+            auto dataIt = data.find(cheb.rep->signal.messageType);
+            if (dataIt != data.end())
+            {
+               auto sati = dataIt->second.find(nsid);
+               if (sati != dataIt->second.end())
+               {
+                  keepBoundaries(sati->second, cheb);
+               }
+            }
+         }
+      }
+   }
+
+
+   void SP3NavDataFactory ::
+   edit(const CommonTime& fromTime, const CommonTime& toTime)
+   {
+      if (compacted)
+      {
+         editCompact(fromTime, toTime, nullptr);
+      }
+      NavDataFactoryWithStoreFile::edit(fromTime, toTime);
+   }
+
+
+   void SP3NavDataFactory ::
+   edit(const CommonTime& fromTime, const CommonTime& toTime,
+        const NavSatelliteID& satID)
+   {
+      if (compacted)
+      {
+         editCompact(fromTime, toTime, &satID);
+      }
+      NavDataFactoryWithStoreFile::edit(fromTime, toTime, satID);
+   }
+
+
+   NavMessageIDSet SP3NavDataFactory ::
+   getAvailableMsgs(const CommonTime& fromTime, const CommonTime& toTime)
+      const
+   {
+      if (!compacted)
+      {
+         return NavDataFactoryWithStoreFile::getAvailableMsgs(fromTime,
+                                                               toTime);
+      }
+      NavMessageIDSet rv;
+      for (const ChebTableMap *chebs : { &ephCheb, &clkCheb })
+      {
+         for (const auto& ci : *chebs)
+         {
+            if (isAvailable(ci.second, fromTime, toTime))
+            {
+               rv.insert(ci.second.rep->signal);
+            }
+         }
+      }
+      return rv;
+   }
+
+
+   NavSatelliteIDSet SP3NavDataFactory ::
+   getAvailableSats(NavMessageType nmt, const CommonTime& fromTime,
+                    const CommonTime& toTime)
+      const
+   {
+      if (!compacted)
+      {
+         return NavDataFactoryWithStoreFile::getAvailableSats(nmt, fromTime,
+                                                               toTime);
+      }
+      NavSatelliteIDSet rv;
+      for (const auto& nmid : getAvailableMsgs(fromTime, toTime))
+      {
+         if (nmid.messageType == nmt)
+         {
+            rv.insert(nmid);
+         }
+      }
+      return rv;
+   }
+
+
+   std::set<SatID> SP3NavDataFactory ::
+   getIndexSet(const CommonTime& fromTime, const CommonTime& toTime) const
+   {
+      if (!compacted)
+      {
+         return NavDataFactoryWithStoreFile::getIndexSet(fromTime, toTime);
+      }
+      return NavDataFactory::getIndexSet(fromTime, toTime);
+   }
+
+
+   std::set<SatID> SP3NavDataFactory ::
+   getIndexSet(NavMessageType nmt, const CommonTime& fromTime,
+               const CommonTime& toTime) const
+   {
+      if (!compacted)
+      {
+         return NavDataFactoryWithStoreFile::getIndexSet(nmt, fromTime,
+                                                         toTime);
+      }
+      return NavDataFactory::getIndexSet(nmt, fromTime, toTime);
+   }
+
+
+   const SP3NavDataFactory::SatTable* SP3NavDataFactory ::
+   getTable(NavMessageType nmt, const SatID& sat)
+   {
+      bool findEph = (nmt == NavMessageType::Ephemeris);
+      unsigned halfOrder = (findEph ? halfOrderPos : halfOrderClk);
+      SatTableMap& tables(findEph ? ephTables : clkTables);
+      auto ti = tables.find(sat);
+      if ((ti == tables.end()) || (ti->second.halfOrder != halfOrder))
+      {
+         if (sealed)
+         {
+               // seal() built tables for every satellite with data.
+            return nullptr;
+         }
+         DEBUGTRACE_FUNCTION();
+         DEBUGTRACE("building " << StringUtils::asString(nmt) << " table for "
+                    << sat);
+         NavMessageID nmid;
+         const NavMap *nm = nullptr;
+            // ignore the return code of setSignal as in find().
+         setSignal(sat, nmid);
+         auto dataIt = data.find(nmt);
+         if (dataIt != data.end())
+         {
+            auto sati = dataIt->second.find(nmid);
+            if (sati != dataIt->second.end())
+            {
+               nm = &sati->second;
+            }
+         }
+         ti = tables.insert(ti, SatTableMap::value_type(sat, SatTable()));
+         ti->second.build(nm, findEph, halfOrder);
+      }
+      if (ti->second.t.empty())
+      {
+         return nullptr;
+      }
+      return &ti->second;
+   }
+
+
+   void SP3NavDataFactory::SatTable ::
+   build(const NavMap* nm, bool findEph, unsigned ho)
+   {
+      halfOrder = ho;
+      nvals = (findEph ? ephVals : clkVals);
+      t.clear();
+      val.clear();
+      wt.clear();
+      if ((nm == nullptr) || nm->empty())
+      {
+         return;
+      }
+      ref = nm->begin()->first;
+      t.reserve(nm->size());
+      val.reserve(nm->size() * nvals);
+      for (const auto& nmi : *nm)
+      {
+         OrbitDataSP3 *nav = dynamic_cast<OrbitDataSP3*>(nmi.second.get());
+         if (nav == nullptr)
+         {
+            continue;
+         }
+         t.push_back(nmi.first - ref);
+         if (findEph)
+         {
+            for (unsigned i = 0; i < 3; i++)
+               val.push_back(nav->pos[i]);
+            for (unsigned i = 0; i < 3; i++)
+               val.push_back(nav->vel[i]);
+            frame = nav->frame;
+         }
+         else
+         {
+            val.push_back(nav->clkBias);
+            val.push_back(nav->clkDrift);
+         }
+      }
+         // Barycentric weights w[j] = 1/prod(k!=j)(t[j]-t[k]) for
+         // every set of 2*halfOrder consecutive samples.
+      size_t n = 2*halfOrder;
+      if (t.size() < n)
+      {
+         return;
+      }
+      wt.resize((t.size()-n+1) * n);
+      for (size_t lo = 0; lo + n <= t.size(); lo++)
+      {
+         for (size_t j = 0; j < n; j++)
+         {
+            double prod = 1.0;
+            for (size_t k = 0; k < n; k++)
+            {
+               if (k != j)
+                  prod *= t[lo+j] - t[lo+k];
+            }
+            wt[lo*n+j] = 1.0 / prod;
+         }
+      }
+   }
+
+
+      // This is the index-based equivalent of findIterator().  The
+      // sample at ti2 in findIterator() is t[k-1] here.
+   bool SP3NavDataFactory::SatTable ::
+   window(double dt, bool checkDataGap, bool checkInterval,
+          double gapInterval, double maxInterval,
+          size_t& lo, size_t& exact, bool& interp) const
+   {
+      size_t n = t.size();
+      size_t k = std::upper_bound(t.begin(), t.end(), dt) - t.begin();
+      bool giveUp = (k == n);
+         // For exact matches, the interpolation interval is shifted
+         // "left" by one, as in findIterator.
+      unsigned offs = (((k > 0) && (t[k-1] == dt)) ? 1 : 0);
+      if (!giveUp)
+      {
+         if (checkDataGap && (k > 0) && ((t[k] - t[k-1]) > gapInterval))
+         {
+            giveUp = true;
+         }
+         else if ((k < halfOrder+offs) || (k+halfOrder-offs > n))
+         {
+            giveUp = true;
+         }
+      }
+      if (k == 0)
+      {
+            // Nothing available that's even close.
+         return false;
+      }
+      if (!giveUp)
+      {
+         lo = k - halfOrder - offs;
+         if (checkInterval && ((t[lo+2*halfOrder-1] - t[lo]) > maxInterval))
+         {
+            giveUp = true;
+         }
+      }
+      exact = (offs ? k-1 : n);
+      interp = !giveUp;
+      return (interp || offs);
+   }
+
+
+   void SP3NavDataFactory::SatTable ::
+   interpolate(size_t lo, double dt, unsigned col, double& y,
+               double* dydt) const
+   {
+      size_t n = 2*halfOrder;
+      const double *w = &wt[lo*n], *x = &t[lo], *v = &val[lo*nvals+col];
+      for (size_t j = 0; j < n; j++)
+      {
+         if (dt == x[j])
+         {
+               // Exactly on a node, where the barycentric formula
+               // can't be evaluated.
+            y = v[j*nvals];
+            if (dydt != nullptr)
+            {
+               *dydt = 0.0;
+               for (size_t k = 0; k < n; k++)
+               {
+                  if (k != j)
+                  {
+                     *dydt += (w[k]/w[j]) * (v[k*nvals] - y) / (x[j] - x[k]);
+                  }
+               }
+            }
+            return;
+         }
+      }
+      double num = 0.0, den = 0.0, c;
+      for (size_t j = 0; j < n; j++)
+      {
+         c = w[j] / (dt - x[j]);
+         num += c * v[j*nvals];
+         den += c;
+      }
+      y = num / den;
+      if (dydt != nullptr)
+      {
+         num = 0.0;
+         for (size_t j = 0; j < n; j++)
+         {
+            c = w[j] / (dt - x[j]);
+            num += c * (y - v[j*nvals]) / (dt - x[j]);
+         }
+         *dydt = num / den;
+      }
+   }
+
+
+   bool SP3NavDataFactory::SatTable ::
+   haveValue(size_t lo, unsigned col) const
+   {
+      for (size_t i = lo; i < lo + 2*halfOrder; i++)
+      {
+         if (value(i, col) != 0.0)
+            return true;
+      }
+      return false;
+   }
+
+
+   bool SP3NavDataFactory ::
+   addDataSource(const std::string& source)
+   {
+      DEBUGTRACE_FUNCTION();
+      if (!prepareToAdd())
+         return false;
+      gnsstk::NavDataFactoryStoreCallback cb(this, data, nearestData,
+                                             offsetData);
+      return process(source, cb);
+   }
+
+
+   bool SP3NavDataFactory ::
+   parseFile(const std::string& filename, ParsedFilePtr& parsed)
+   {
+      DEBUGTRACE_FUNCTION();
+         // Decode using a factory with an empty store so that the
+         // state of this one is left alone.  Clock data are always
+         // decoded and left for storeParsed() to discard.
+      SP3NavDataFactory tmp;
+      tmp.procNavTypes = procNavTypes;
+      tmp.navValidity = navValidity;
+      tmp.rejectBadPosFlag = rejectBadPosFlag;
+      tmp.rejectBadClockFlag = rejectBadClockFlag;
+      tmp.rejectPredPosFlag = rejectPredPosFlag;
+      tmp.rejectPredClockFlag = rejectPredClockFlag;
+      tmp.initOrbitDataVal = initOrbitDataVal;
+      ParsedFilePtr tmpParsed;
+      bool rv = tmp.NavDataFactoryWithStoreFile::parseFile(filename,
+                                                            tmpParsed);
+      std::shared_ptr<SP3ParsedFile> sp3 = std::make_shared<SP3ParsedFile>();
+      sp3->navOut.swap(tmpParsed->navOut);
+      sp3->timeSystem = tmp.storeTimeSystem;
+      sp3->rinexClock = !tmp.useSP3clock;
+      parsed = sp3;
+      return rv;
+   }
+
+
+   bool SP3NavDataFactory ::
+   storeParsed(const ParsedFilePtr& parsed)
+   {
+      DEBUGTRACE_FUNCTION();
+      SP3ParsedFile *sp3 = dynamic_cast<SP3ParsedFile*>(parsed.get());
+      if (sp3 == nullptr)
+         return false;
+      if (!prepareToAdd())
+         return false;
+      if ((sp3->timeSystem != TimeSystem::Any) &&
+          !checkTimeSystem(sp3->timeSystem,
+                           (sp3->rinexClock ? "SP3/RINEX clock data"
+                            : "SP3 data,")))
+      {
+         return false;
+      }
+      if (sp3->rinexClock)
+      {
+         useRinexClockData();
+      }
+      for (const auto& nd : sp3->navOut)
+      {
+            // SP3 clock data are ignored once RINEX clock data are loaded
+         if (!sp3->rinexClock && !useSP3clock &&
+             (nd->signal.messageType == NavMessageType::Clock))
+         {
+            continue;
+         }
+         if (!addNavData(nd))
+            return false;
+      }
+      return true;
+   }
+
+
+   bool SP3NavDataFactory ::
+   getSnapshotData(NavDataPtrList& navList) const
+   {
+      if (compacted)
+         return false;
+      return NavDataFactoryWithStoreFile::getSnapshotData(navList);
+   }
+
+
+   bool SP3NavDataFactory ::
+   addSnapshotData(const NavDataPtrList& navList)
+   {
+      if (!prepareToAdd())
+         return false;
+      return NavDataFactoryWithStoreFile::addSnapshotData(navList);
+   }
+
+
+   bool SP3NavDataFactory ::
+   prepareToAdd()
+   {
+      if (compacted)
+      {
+         if (!data.empty())
+         {
+               // can't mix samples with polynomial segments
+            return false;
+         }
+            // everything has been cleared, start over
+         ephCheb.clear();
+         clkCheb.clear();
+         compacted = false;
+      }
+      return true;
+   }
+
+
+   bool SP3NavDataFactory ::
+   checkTimeSystem(TimeSystem ts, const char* what)
+   {
+         // if store time system has not been set, do so
+      if (storeTimeSystem == TimeSystem::Any)
+      {
+            /// @note store TimeSystem must be consistent.
+         storeTimeSystem = ts;
+      }
+      else if (storeTimeSystem != ts)
+      {
+         cerr << "Time system mismatch in " << what << " "
+              << gnsstk::StringUtils::asString(storeTimeSystem)
+              << " (store) != "
+              << gnsstk::StringUtils::asString(ts)
+              << " (file)" << endl;
+         return false;
+      }
+      return true;
+   }
+
+
+   bool SP3NavDataFactory ::
+   process(const std::string& filename,
+           NavDataFactoryCallback& cb)
+   {
+      DEBUGTRACE_FUNCTION();
+      bool rv = true;
+      bool processEph = (procNavTypes.count(NavMessageType::Ephemeris) > 0);
+      bool processClk = (procNavTypes.count(NavMessageType::Clock) > 0);
+         // When either of these two change, we store the existing
+         // NavDataPtr and create a new one.
+      CommonTime lastTime;
+      SatID lastSat;
+      NavDataPtr eph, clk;
+      try
+      {
+         SP3Stream is(filename.c_str(), ios::in);
+         SP3Header head;
+         SP3Data data;
+         if (!is)
+         {
+            return false;
+         }
+         is >> head;
+         if (!is)
+         {
+            return addRinexClock(filename, cb);
+         }
+
+            // know whether to look for the extra info contained in SP3c
+         bool isC = (head.version==SP3Header::SP3c);
+            // check/save TimeSystem to storeTimeSystem
+         if ((head.timeSystem != TimeSystem::Any) &&
+             (head.timeSystem != TimeSystem::Unknown))
+         {
+               // Don't load an SP3 file with a differing time system
+            if (!checkTimeSystem(head.timeSystem, "SP3 data,"))
+               return false;
+         }
+
+         while (is)
+         {
+            is >> data;
+            if (!is)
+            {
+               if (is.eof())
+                  break;
+               else
+                  return false; // some other error
+            }
+            if ((lastSat != data.sat) || (lastTime != data.time))
+            {
+               DEBUGTRACE("time or satellite change, storing");
+               lastSat = data.sat;
+               lastTime = data.time;
+               DEBUGTRACE("storing eph");
+               if (!store(processEph, cb, eph))
+                  return false;
+               DEBUGTRACE("storing clk");
+               if (!store(processClk && useSP3clock, cb, clk))
+                  return false;
+            }
+               // Don't process time records otherwise we'll end up
+               // storing junk in the store that has a time stamp and
+               // a bogus satellite ID.
+            if (data.RecType != '*')
+            {
+               if (rejectBadPosFlag &&
+                   (data.x[0] == 0.0) ||
+                   (data.x[1] == 0.0) ||
+                   (data.x[2] == 0.0))
+               {
+                     // don't add this record with a bad position
+                  continue;
+               }
+               else if (rejectBadClockFlag && (fabs(data.clk) >= maxBias))
+               {
+                     // don't add this record with a bad clock
+                  continue;
+               }
+               if (processEph)
+               {
+                     // If the orbit data are predictions and we've
+                     // been asked to ignore position predictions, do
+                     // so. Otherwise, add the data to the store.
+                  if ((!rejectPredPosFlag || data.orbitPredFlag) &&
+                      !convertToOrbit(head, data, isC, eph, initOrbitDataVal))
+                  {
+                     return false;
+                  }
+               }
+               if (processClk)
+               {
+                     // If the clock data are predictions and we've
+                     // been asked to ignore clock predictions, do
+                     // so. Otherwise, add the data to the store.
+                  if ((!rejectPredClockFlag || data.clockPredFlag) &&
+                      !convertToClock(head, data, isC, clk, initOrbitDataVal))
+                  {
+                     return false;
+                  }
+               }
+            }
+         }
+            // store the final record(s)
+         DEBUGTRACE("storing last eph");
+         if (!store(processEph, cb, eph))
+            return false;
+         DEBUGTRACE("storing last clk");
+         if (!store(processClk && useSP3clock, cb, clk))
+            return false;
+      }
+      catch (gnsstk::Exception& exc)
+      {
+         rv = false;
+         cerr << exc << endl;
+      }
+      catch (std::exception& exc)
+      {
+         rv = false;
+         cerr << exc.what() << endl;
+      }
+      catch (...)
+      {
+         rv = false;
+         cerr << "Unknown exception" << endl;
+      }
+      return rv;
+   }
+
+
+   bool SP3NavDataFactory ::
+   addRinexClock(const std::string& source, NavDataFactoryCallback& cb)
+   {
+      bool rv = true;
+         // We have to handle this a bit carefully.  If we're not
+         // processing clock data, we still need to at least identify
+         // the data, otherwise NavLibrary/MultiFormatNavDataFactory
+         // might incorrectly handle the processing of the file.
+      bool processClk = (procNavTypes.count(NavMessageType::Clock) > 0);
+      try
+      {
+         Rinex3ClockStream is(source.c_str(), ios::in);
+         Rinex3ClockHeader head;
+         Rinex3ClockData data;
+         if (!is)
+         {
+            return false;
+         }
+         is >> head;
+         if (!is)
+         {
+            return false;
+         }
+
+            // At this point, we have valid RINEX clock.  Probably.
+         if (!processClk)
+            return true; // ...but the user doesn't want it.
+
+            // check/save TimeSystem to storeTimeSystem
+         if(head.timeSystem != TimeSystem::Any &&
+            head.timeSystem != TimeSystem::Unknown)
+         {
+               // Don't load a RINEX clock file with a differing time system
+            if (!checkTimeSystem(head.timeSystem, "SP3/RINEX clock data"))
+               return false;
+         }
          else
          {
             head.timeSystem = TimeSystem::GPS;
@@ -1403,6 +2512,7 @@ namespace gnsstk
    void SP3NavDataFactory ::
    setClockInterpOrder(unsigned int order)
    {
+      unseal();
       if (interpType == ClkInterpType::Lagrange)
          halfOrderClk = (order+1)/2;
       else
@@ -1413,6 +2523,7 @@ namespace gnsstk
    void SP3NavDataFactory ::
    setClockLagrangeInterp()
    {
+      unseal();
       interpType = ClkInterpType::Lagrange;
       halfOrderClk = 5;
    }
@@ -1421,6 +2532,7 @@ namespace gnsstk
    void SP3NavDataFactory ::
    setClockLinearInterp()
    {
+      unseal();
       interpType = ClkInterpType::Linear;
       halfOrderClk = 1;
    }
@@ -42,6 +42,7 @@
 #include "NavDataFactoryWithStoreFile.hpp"
 #include "SP3Data.hpp"
 #include "SP3Header.hpp"
+#include "Xvt.hpp"
 #include "gnsstk_export.h"
 
 namespace gnsstk
@@ -107,6 +108,91 @@ namespace gnsstk
                 NavDataPtr& navOut, SVHealth xmitHealth, NavValidityType valid,
                 NavSearchOrder order) override;
 
+         /** Search the store like find().  As find() interpolates a
+          * new result for every time, results are never reusable,
+          * so \a until is always set to \a when.
+          * @copydetails NavDataFactory::findUntil() */
+      bool findUntil(const NavMessageID& nmid, const CommonTime& when,
+                     NavDataPtr& navOut, CommonTime& until,
+                     SVHealth xmitHealth, NavValidityType valid,
+                     NavSearchOrder order) override
+      {
+         until = when;
+         return find(nmid, when, navOut, xmitHealth, valid, order);
+      }
+
+         /** Compute the satellite position, velocity and clock
+          * offset at the given time directly from the internal
+          * store.  The result is the same as find() followed by
+          * OrbitDataSP3::getXvt(), to within numerical noise, but no
+          * OrbitDataSP3 object is created.  The first call for a
+          * given satellite copies its samples from the store into
+          * contiguous arrays and precomputes the barycentric
+          * Lagrange weights for every interpolation interval, after
+          * which each call costs O(n) in the interpolation order and
+          * does no heap allocation.  The arrays are rebuilt whenever
+          * the contents of the store or the interpolation order
+          * change.
+          * @note Sigmas and accelerations are not available through
+          *   this method, use find() if those are needed.
+          * @param[in] sat The satellite of interest.
+          * @param[in] when The time of interest.
+          * @param[out] xvt The position, velocity and clock offset
+          *   of sat at when.
+          * @return true if successful.  If false, xvt is untouched. */
+      bool getXvt(const SatID& sat, const CommonTime& when, Xvt& xvt);
+
+         /** Replace the stored SP3 samples with per-satellite
+          * Chebyshev polynomial segments to reduce memory use.  Each
+          * segment spans as many sample intervals as possible while
+          * reproducing the Lagrange interpolation used by getXvt()
+          * to within the given tolerances.  As the fit is only
+          * checked at the samples and at points between them, it is
+          * required to be within half the tolerances at those
+          * points.  After this call, find() and getXvt() evaluate
+          * the polynomials, and the samples are released.
+          * @note Only the store entries at the start and end of each
+          *   segment are kept, pointing at a single shared
+          *   OrbitDataSP3 per satellite.  getInitialTime(),
+          *   getFinalTime(), getFirstTime() and getLastTime() are
+          *   unaffected.  size() and count() count these entries
+          *   rather than the samples.  getAvailableSats(),
+          *   getAvailableMsgs() and getIndexSet() report a
+          *   satellite as available at any time covered by its
+          *   segments.
+          * @note Sigmas, accelerations and clock drift rates are not
+          *   retained.  The OrbitDataSP3 returned by find() has
+          *   posSig, velSig, accSig, acc, biasSig, driftSig,
+          *   drRateSig and clkDrRate all set to the value of
+          *   initOrbitDataVal when compact() was called, 0 unless
+          *   changed, rather than the sigmas of the samples.
+          * @note Times for which only an exact match (no
+          *   interpolation) was available are no longer available.
+          * @note addDataSource() fails once the factory is compact,
+          *   so load all of the data first.  edit() removes any
+          *   segment that overlaps the edited time span, and clear()
+          *   removes all of them.
+          * @param[in] posTol The largest allowed position error in
+          *   m.  The default is the resolution of SP3 positions.
+          * @param[in] velTol The largest allowed velocity error in m/s.
+          * @param[in] biasTol The largest allowed clock bias error in
+          *   s.  The default is the resolution of SP3 clocks.
+          * @param[in] driftTol The largest allowed clock drift error
+          *   in s/s. */
+      void compact(double posTol = 1e-3, double velTol = 1e-5,
+                   double biasTol = 1e-12, double driftTol = 1e-15);
+
+         /// Return true if compact() has been called.
+      bool isCompact() const
+      { return compacted; }
+
+         /** Seal the store, additionally building the per-satellite
+          * sample tables used by getXvt() (or bringing the compact
+          * segments up to date) so that find() and getXvt() are safe
+          * to call concurrently.
+          * @copydetails NavDataFactoryWithStore::seal() */
+      void seal() override;
+
          /// @copydoc NavDataFactoryWithStoreFile::process(const std::string&,NavDataFactoryCallback&)
       bool process(const std::string& filename,
                    NavDataFactoryCallback& cb) override;
@@ -119,12 +205,86 @@ namespace gnsstk
           *   and any subsequent attempts to load SP3 data will not
           *   include the clock data from those SP3 files.
           * @param[in] source The path to the SP3 file to load.
-          * @return true on success, false on failure. */
+          * @return true on success, false on failure, including
+          *   when compact() has been called and the store has not
+          *   been cleared since. */
       bool addDataSource(const std::string& source) override;
 
+         /** Decode an SP3 or RINEX clock file using a temporary
+          * factory with the same configuration as this one, leaving
+          * the time system check and the switch to RINEX clock data
+          * to storeParsed().
+          * @copydetails NavDataFactoryWithStoreFile::parseFile() */
+      bool parseFile(const std::string& filename,
+                     ParsedFilePtr& parsed) override;
+
+         /** Add data decoded by parseFile() to the store.  Performs
+          * the time system check and RINEX clock handling in the same
+          * way as addDataSource().
+          * @param[in] parsed The result of parseFile().
+          * @return true on success, false on failure. */
+      bool storeParsed(const ParsedFilePtr& parsed) override;
+
+         /** Get the messages in the store for saveSnapshot().
+          * @copydetails NavDataFactoryWithStore::getSnapshotData()
+          * @note Fails once compact() has been called, as the
+          *   samples are no longer in the store. */
+      bool getSnapshotData(NavDataPtrList& navList) const override;
+
+         /// @copydoc NavDataFactoryWithStore::addSnapshotData()
+      bool addSnapshotData(const NavDataPtrList& navList) override;
+
          /// Return a comma-separated list of formats supported by this factory.
       std::string getFactoryFormats() const override;
 
+         /** Remove data within a time span.  Once compact() has been
+          * called, any segment overlapping the span is removed.
+          * @copydetails NavDataFactoryWithStore::edit(const CommonTime&,const CommonTime&) */
+      void edit(const CommonTime& fromTime, const CommonTime& toTime) override;
+
+         /** Remove data within a time span for a specific satellite.
+          * Once compact() has been called, any segment of the
+          * satellite overlapping the span is removed.
+          * @copydetails NavDataFactoryWithStore::edit(const CommonTime&,const CommonTime&,const NavSatelliteID&) */
+      void edit(const CommonTime& fromTime, const CommonTime& toTime,
+                const NavSatelliteID& satID) override;
+      using NavDataFactoryWithStoreFile::edit;
+
+         /** Obtain a set of satellites and message types for which
+          * we have data in the given time span.  Once compact() has
+          * been called, this is determined from the segments.
+          * @copydetails NavDataFactoryWithStore::getAvailableMsgs() */
+      NavMessageIDSet getAvailableMsgs(const CommonTime& fromTime,
+                                       const CommonTime& toTime)
+         const override;
+
+         /** Obtain a set of satellites for which we have data of a
+          * specific message type in the given time span.  Once
+          * compact() has been called, this is determined from the
+          * segments.
+          * @copydetails NavDataFactoryWithStore::getAvailableSats(NavMessageType,const CommonTime&,const CommonTime&) */
+      NavSatelliteIDSet getAvailableSats(NavMessageType nmt,
+                                         const CommonTime& fromTime,
+                                         const CommonTime& toTime)
+         const override;
+      using NavDataFactoryWithStoreFile::getAvailableSats;
+
+         /** Obtain a set of satellites for which we have data in the
+          * given time span.  Once compact() has been called, this is
+          * determined from the segments.
+          * @copydetails NavDataFactoryWithStore::getIndexSet(const CommonTime&,const CommonTime&) const */
+      std::set<SatID> getIndexSet(const CommonTime& fromTime,
+                                  const CommonTime& toTime) const;
+
+         /** Obtain a set of satellites for which we have data of a
+          * specific message type in the given time span.  Once
+          * compact() has been called, this is determined from the
+          * segments.
+          * @copydetails NavDataFactoryWithStore::getIndexSet(NavMessageType,const CommonTime&,const CommonTime&) const */
+      std::set<SatID> getIndexSet(NavMessageType nmt,
+                                  const CommonTime& fromTime,
+                                  const CommonTime& toTime) const;
+
          /** Convert SP3 nav data to a OrbitDataSP3 object with
           * position and velocity data.
           * @param[in] head The header from the SP3 file being converted.
@@ -174,7 +334,7 @@ namespace gnsstk
          /** Clear the clock dataset only, meaning remove all clock
           * data from the internal store. */
       void clearClock()
-      { data.erase(NavMessageType::Clock); }
+      { thaw(); data.erase(NavMessageType::Clock); noteChange(); }
 
          /** Choose to load the clock data tables from RINEX clock
           * files. This will clear the clock store if the state
@@ -305,7 +465,7 @@ namespace gnsstk
          /** Set the interpolation order for the position table; it is
           * forced to be even. */
       void setPositionInterpOrder(unsigned int order)
-      { halfOrderPos = (order+1)/2; }
+      { unseal(); halfOrderPos = (order+1)/2; }
 
          /** Get current interpolation order for the clock data
           * (meaningless if the interpolation type is linear). */
@@ -424,6 +584,221 @@ namespace gnsstk
                           const NavMap::iterator& ti3,
                           const CommonTime& when, NavDataPtr& navData);
 
+         /** Contiguous copy of the position/velocity or clock
+          * samples of a single satellite, used by getXvt(). */
+      class SatTable
+      {
+      public:
+            /// Number of values stored per sample for ephemeris data.
+         static const unsigned ephVals = 6;
+            /// Number of values stored per sample for clock data.
+         static const unsigned clkVals = 2;
+            /// Initialize to an empty table.
+         SatTable()
+               : halfOrder(0), nvals(0)
+         {}
+            /** Copy the samples in a NavMap into the table and
+             * compute the interpolation weights.
+             * @param[in] nm The stored OrbitDataSP3 objects to copy.
+             *   If nullptr, the table is left empty.
+             * @param[in] findEph If true, copy position and velocity
+             *   (in that order), otherwise copy clock bias and drift.
+             * @param[in] ho Half the interpolation order. */
+         void build(const NavMap* nm, bool findEph, unsigned ho);
+            /** Find the samples to use for interpolation at time dt,
+             * using the same rules as SP3NavDataFactory::findIterator().
+             * @param[in] dt The time of interest in seconds since ref.
+             * @param[in] checkDataGap If true, fail interpolation when
+             *   the gap around dt exceeds gapInterval.
+             * @param[in] checkInterval If true, fail interpolation
+             *   when the samples used span more than maxInterval.
+             * @param[in] gapInterval The largest allowed data gap.
+             * @param[in] maxInterval The largest allowed interpolation
+             *   interval.
+             * @param[out] lo The index of the first of the 2*halfOrder
+             *   samples to interpolate.  Only set if interp is true.
+             * @param[out] exact The index of the sample exactly at dt,
+             *   or t.size() if there is no such sample.
+             * @param[out] interp Set to true if interpolation is possible.
+             * @return false if neither interpolation nor an exact
+             *   match is possible. */
+         bool window(double dt, bool checkDataGap, bool checkInterval,
+                     double gapInterval, double maxInterval,
+                     size_t& lo, size_t& exact, bool& interp) const;
+            /** Interpolate one value at time dt using the
+             * 2*halfOrder samples starting at lo.
+             * @param[in] lo The index of the first sample to use.
+             * @param[in] dt The time of interest in seconds since ref.
+             * @param[in] col The index of the value within a sample.
+             * @param[out] y The interpolated value.
+             * @param[out] dydt If not null, the derivative of the
+             *   interpolating polynomial at dt. */
+         void interpolate(size_t lo, double dt, unsigned col, double& y,
+                          double* dydt) const;
+            /// The value at index col of sample idx.
+         double value(size_t idx, unsigned col) const
+         { return val[idx*nvals+col]; }
+            /** Return true if value col is non-zero in any of the
+             * 2*halfOrder samples starting at lo. */
+         bool haveValue(size_t lo, unsigned col) const;
+
+            /// The time that the values in t are relative to.
+         CommonTime ref;
+            /// Sample times in seconds since ref, in increasing order.
+         std::vector<double> t;
+            /// Sample values, nvals values per sample.
+         std::vector<double> val;
+            /** Barycentric weights, 2*halfOrder values for each
+             * possible first sample of an interpolation interval. */
+         std::vector<double> wt;
+            /// Reference frame of the ephemeris data.
+         RefFrame frame;
+            /// Half the interpolation order used to compute wt.
+         unsigned halfOrder;
+            /// Number of values per sample in val.
+         unsigned nvals;
+      };
+         /// Map a satellite to its contiguous sample data.
+      using SatTableMap = std::map<SatID, SatTable>;
+
+         /** Chebyshev polynomial segments of the position/velocity
+          * or clock of a single satellite, built by compact(). */
+      class ChebTable
+      {
+      public:
+            /// Initialize to an empty table.
+         ChebTable()
+               : ncomp(0)
+         {}
+            /** Evaluate all components at time dt.
+             * @param[in] dt The time of interest in seconds since ref.
+             * @param[out] out The ncomp values at dt.
+             * @return false if no segment covers dt. */
+         bool eval(double dt, double* out) const;
+            /** Append a segment.
+             * @param[in] a The start of the segment in seconds since ref.
+             * @param[in] b The end of the segment in seconds since ref.
+             * @param[in] c The coefficients, n per component.
+             * @param[in] n The number of coefficients per component. */
+         void add(double a, double b, const double* c, unsigned n);
+            /** Append segment i of another table.
+             * @param[in] from The table to copy the segment from.
+             * @param[in] i The index of the segment in from. */
+         void add(const ChebTable& from, size_t i);
+
+            /// The time that segment times are relative to.
+         CommonTime ref;
+            /// Start of each segment in seconds since ref.
+         std::vector<double> begin;
+            /// End of each segment in seconds since ref.
+         std::vector<double> end;
+            /** Index into coef of the first coefficient of each
+             * segment, with one extra element for the end. */
+         std::vector<size_t> offset;
+            /// Chebyshev coefficients, component-major in each segment.
+         std::vector<double> coef;
+            /// Number of components (SatTable::ephVals or clkVals).
+         unsigned ncomp;
+            /** OrbitDataSP3 with the signal, coordinate system and
+             * frame of the original samples, which replaces them in
+             * the store. */
+         NavDataPtr rep;
+      };
+         /// Map a satellite to its Chebyshev segments.
+      using ChebTableMap = std::map<SatID, ChebTable>;
+
+         /** Fit Chebyshev segments to the interpolated data in a SatTable.
+          * @param[in] tab The sample data to fit.
+          * @param[in] findEph If true, tab contains ephemeris data,
+          *   otherwise clock data.
+          * @param[in] tol The largest allowed error for each value,
+          *   in the units stored in tab.
+          * @param[out] cheb The resulting segments. */
+      void fitTable(const SatTable& tab, bool findEph, const double* tol,
+                    ChebTable& cheb);
+
+         /** Remove Chebyshev segments whose first or last sample is
+          * no longer in the store, e.g. after clear() or retention
+          * limits. */
+      void syncCompact();
+
+         /** Determine whether the store has an entry at a segment
+          * end, allowing for rounding in the conversion to CommonTime.
+          * @param[in] nm The store entries of the satellite.
+          * @param[in] ref The time that dt is relative to.
+          * @param[in] dt The segment end in seconds since ref.
+          * @return true if nm has an entry within 1 microsecond of dt. */
+      static bool hasEntry(const NavMap& nm, const CommonTime& ref, double dt);
+
+         /** Determine whether any of a satellite's segments still in
+          * the store overlap [fromTime,toTime).
+          * @param[in] cheb The segments of the satellite.
+          * @param[in] fromTime The earliest time of interest.
+          * @param[in] toTime The earliest time NOT of interest.
+          * @return true if a segment overlapping the span has both of
+          *   its store entries. */
+      bool isAvailable(const ChebTable& cheb, const CommonTime& fromTime,
+                       const CommonTime& toTime) const;
+
+         /** Remove the entries of a satellite's store that are not at
+          * the start or end of one of its segments.
+          * @param[in,out] nm The store entries of the satellite.
+          * @param[in] cheb The segments of the satellite. */
+      static void keepBoundaries(NavMap& nm, const ChebTable& cheb);
+
+         /** Remove the segments that overlap a time span, along with
+          * their store entries.
+          * @param[in] fromTime The earliest time to be removed.
+          * @param[in] toTime The earliest time that will NOT be removed.
+          * @param[in] satID If not nullptr, only remove segments of
+          *   satellites matching this. */
+      void editCompact(const CommonTime& fromTime, const CommonTime& toTime,
+                       const NavSatelliteID* satID);
+
+         /** Implementation of find() for compact mode.
+          * @param[in] nsid The generic satellite ID to search for.
+          * @param[in] when The time of interest.
+          * @param[out] navOut A new OrbitDataSP3 on success.
+          * @return true on success. */
+      bool findCompact(const NavSatelliteID& nsid, const CommonTime& when,
+                       NavDataPtr& navOut);
+
+         /** Evaluate the Chebyshev segments of a satellite.
+          * @param[in] sat The satellite of interest.
+          * @param[in] when The time of interest.
+          * @param[out] pv Position (km) and velocity (dm/s).
+          * @param[out] bd Clock bias (microseconds) and drift.
+          * @return The ephemeris table used or nullptr on failure. */
+      const ChebTable* evalCompact(const SatID& sat, const CommonTime& when,
+                                   double* pv, double* bd);
+
+         /** Interpolate position and velocity from a SatTable, the
+          * same way as interpolateEph().
+          * @param[in] eph The ephemeris table.
+          * @param[in] lo The index of the first sample to use.
+          * @param[in] dt The time of interest in seconds since eph.ref.
+          * @param[out] pv Position (km) and velocity (dm/s). */
+      void interpEph(const SatTable& eph, size_t lo, double dt, double* pv)
+         const;
+
+         /** Interpolate clock bias and drift from a SatTable, the
+          * same way as interpolateClk().
+          * @param[in] clk The clock table.
+          * @param[in] lo The index of the first sample to use.
+          * @param[in] dt The time of interest in seconds since clk.ref.
+          * @param[out] bd Clock bias (microseconds) and drift. */
+      void interpClk(const SatTable& clk, size_t lo, double dt, double* bd)
+         const;
+
+         /** Get the contiguous sample data for a satellite, building
+          * it from the internal store if necessary.
+          * @param[in] nmt The type of data (Ephemeris or Clock).
+          * @param[in] sat The satellite whose data is being requested.
+          * @return A pointer to the table or nullptr if there is no
+          *   data for sat.  When sealed, only tables built by seal()
+          *   are returned. */
+      const SatTable* getTable(NavMessageType nmt, const SatID& sat);
+
          /** Load SP3 nav data into a map.
           * @note This method is unused, in favor of overriding
           *   addDataSource directly and using its own store rather
@@ -445,6 +820,32 @@ namespace gnsstk
           *   nominal timestep in seconds. */
       double nomTimeStep(const NavMessageID& nmid) const;
 
+         /// The result of parseFile() for SP3 and RINEX clock files.
+      class SP3ParsedFile : public ParsedFile
+      {
+      public:
+         SP3ParsedFile()
+               : timeSystem(TimeSystem::Any), rinexClock(false)
+         {}
+            /// The time system of the file, Any if not specified.
+         TimeSystem timeSystem;
+            /// True if the file contained RINEX clock data to be used.
+         bool rinexClock;
+      };
+
+         /** Check that data can be added to the store, which isn't
+          * the case once compact() has been called, unless the store
+          * has been cleared.
+          * @return true if data can be added to the store. */
+      bool prepareToAdd();
+
+         /** Check the time system of a file against storeTimeSystem,
+          * setting storeTimeSystem if it hasn't been set yet.
+          * @param[in] ts The time system of the file being loaded.
+          * @param[in] what The type of the file for error messages.
+          * @return true if the time systems are consistent. */
+      bool checkTimeSystem(TimeSystem ts, const char* what);
+
          /** Used to make sure that we don't load SP3 data with
           * inconsistent time systems. */
       TimeSystem storeTimeSystem;
@@ -534,6 +935,21 @@ namespace gnsstk
 
          /// Clock data interpolation method.
       ClkInterpType interpType;
+
+         /// Contiguous ephemeris data used by getXvt().
+      SatTableMap ephTables;
+         /// Contiguous clock data used by getXvt().
+      SatTableMap clkTables;
+         /// Value of changeCount when ephTables and clkTables were built.
+      unsigned long tableChangeCount;
+         /// If true, compact() has replaced the samples with ephCheb/clkCheb.
+      bool compacted;
+         /// Ephemeris polynomial segments built by compact().
+      ChebTableMap ephCheb;
+         /// Clock polynomial segments built by compact().
+      ChebTableMap clkCheb;
+         /// Value of changeCount when ephCheb and clkCheb were last checked.
+      unsigned long compactChangeCount;
    };
 
       //@}
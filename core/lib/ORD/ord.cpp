@@ -224,6 +224,21 @@ double TroposphereCorrection(const gnsstk::TropModel& tropModel,
     return trop;
 }
 
+std::vector<double> TroposphereCorrections(
+        const gnsstk::TropModel& tropModel, const gnsstk::Position& rxLoc,
+        const std::vector<gnsstk::Xvt>& svXvts) {
+    Position trx(rxLoc);
+    std::vector<double> elevations(svXvts.size());
+    for (size_t i = 0; i < svXvts.size(); i++) {
+        elevations[i] = trx.elevation(Position(svXvts[i]));
+    }
+
+    std::vector<double> trops;
+    tropModel.corrections(elevations, trops);
+
+    return trops;
+}
+
 /*
  * Example not fully fleshed-out.  If dual-band data given, for example,
  * then the last IonosphereModelCorrection call must not be made.
@@ -173,6 +173,17 @@ double SvRelativityCorrection(gnsstk::Xvt& svXvt);
 double TroposphereCorrection(const gnsstk::TropModel& trop_model,
         const gnsstk::Position& rx_loc, const gnsstk::Xvt& sv_xvt);
 
+/// Given a troposphere model, and locations of receiver and of all the
+/// satellites it sees at one time, calculates tropospheric effects for
+/// each satellite with a single call to TropModel::corrections().
+/// @param trop_model Class that encapsulates troposphere models
+/// @param rx_loc The location of the receiver.
+/// @param sv_xvts The locations of the satellites at time of interest.
+/// @return Range correction (delta) in meters for each satellite
+std::vector<double> TroposphereCorrections(
+        const gnsstk::TropModel& trop_model, const gnsstk::Position& rx_loc,
+        const std::vector<gnsstk::Xvt>& sv_xvts);
+
 /// Example method that applies _all_ corrections to generate an Observed Range Deviation.
 /// This is intended to be a sample showing how the above methods will be used.
 /// The example is not fully developed, just a general sketch of a generic approach.
@@ -41,7 +41,9 @@
 /// given data, or a solution including editing via a RAIM algorithm.
 
 #include <tuple>
+#include <exception>
 #include <functional>
+#include <thread>
 
 #include "Position.hpp"
 #include "MathBase.hpp"
@@ -74,6 +76,262 @@ namespace gnsstk
    }
 
 
+   namespace
+   {
+         /** Evaluate combinations of rejected satellites for FastRAIM,
+          * from the linearization of the solution with all of them.
+          * Each row of the partials has only four non-zero elements,
+          * the direction cosines and the clock of the satellite's
+          * system, so removing a satellite from the normal equations
+          * touches only a 4x4 block. */
+      class RAIMSubsetEvaluator
+      {
+      public:
+            /// Returned by rms() when too few satellites remain.
+         static constexpr double notEnough = -2.0;
+            /// Returned by rms() when the normal equations are singular.
+         static constexpr double singular = -1.0;
+
+            /** Set up the normal equations of the full solution.
+             * @param[in] partials the n by dim partials.
+             * @param[in] resid the n residuals at the linearization point.
+             * @param[in] weights the n weights (diagonal of the inverse
+             *   measurement covariance). */
+         RAIMSubsetEvaluator(const Matrix<double>& partials,
+                             const Vector<double>& resid,
+                             const std::vector<double>& weights)
+               : n(partials.rows()), dim(partials.cols()),
+                 h(4*n), z(n), w(weights), col(n), nfull(dim*dim, 0.0),
+                 bfull(dim, 0.0), count(dim, 0)
+         {
+            for (size_t i = 0; i < n; i++)
+            {
+               col[i] = 3;
+               for (size_t j = 3; j < dim; j++)
+               {
+                  if (partials(i,j) != 0.0)
+                  {
+                     col[i] = j;
+                  }
+               }
+               for (size_t j = 0; j < 3; j++)
+               {
+                  h[4*i+j] = partials(i,j);
+               }
+               h[4*i+3] = partials(i,col[i]);
+               z[i] = resid(i);
+               count[col[i]]++;
+               update(i, 1.0, nfull.data(), bfull.data());
+            }
+         }
+
+            /// The number of satellites.
+         size_t size() const
+         { return n; }
+
+            /** Compute the RMS post-fit residual of the solution
+             * without the satellites in reject.
+             * @param[in] reject indexes of the k rejected satellites,
+             *   in increasing order.
+             * @param[in] k the number of rejected satellites.
+             * @param[in,out] work scratch space, reused between calls.
+             * @return the RMS residual, notEnough or singular. */
+         double rms(const int *reject, size_t k,
+                    std::vector<double>& work) const
+         {
+            work.resize(2*dim*dim + 3*dim);
+            double *nm = &work[0], *b = nm + dim*dim, *a = b + dim,
+               *rhs = a + dim*dim, *dx = rhs + dim;
+            std::copy(nfull.begin(), nfull.end(), nm);
+            std::copy(bfull.begin(), bfull.end(), b);
+            std::vector<size_t> active;
+            active.reserve(dim);
+            for (size_t j = 0; j < 3; j++)
+            {
+               active.push_back(j);
+            }
+            for (size_t j = 3; j < dim; j++)
+            {
+               size_t c = count[j];
+               for (size_t r = 0; r < k; r++)
+               {
+                  c -= (col[reject[r]] == j);
+               }
+               if (c > 0)
+               {
+                  active.push_back(j);
+               }
+            }
+            size_t m = active.size();
+            if (n - k < m)
+            {
+               return notEnough;
+            }
+            for (size_t r = 0; r < k; r++)
+            {
+               update(reject[r], -1.0, nm, b);
+            }
+               // Cholesky of the remaining states, lower triangle in a
+            for (size_t j = 0; j < m; j++)
+            {
+               for (size_t i = j; i < m; i++)
+               {
+                  double sum = nm[active[i] + dim*active[j]];
+                  for (size_t c = 0; c < j; c++)
+                  {
+                     sum -= a[i + m*c] * a[j + m*c];
+                  }
+                  if (i == j)
+                  {
+                     if (sum <= 1.e-12 * nm[active[j] + dim*active[j]])
+                     {
+                        return singular;
+                     }
+                     a[j + m*j] = SQRT(sum);
+                  }
+                  else
+                  {
+                     a[i + m*j] = sum / a[j + m*j];
+                  }
+               }
+            }
+            for (size_t i = 0; i < m; i++)
+            {
+               double sum = b[active[i]];
+               for (size_t c = 0; c < i; c++)
+               {
+                  sum -= a[i + m*c] * rhs[c];
+               }
+               rhs[i] = sum / a[i + m*i];
+            }
+            std::fill(dx, dx + dim, 0.0);
+            for (size_t i = m; i-- > 0; )
+            {
+               double sum = rhs[i];
+               for (size_t c = i+1; c < m; c++)
+               {
+                  sum -= a[c + m*i] * dx[active[c]];
+               }
+               dx[active[i]] = sum / a[i + m*i];
+            }
+               // post-fit residuals of the satellites that remain
+            double sumsq = 0.0;
+            for (size_t i = 0, r = 0; i < n; i++)
+            {
+               if (r < k && size_t(reject[r]) == i)
+               {
+                  r++;
+                  continue;
+               }
+               const double *hi = &h[4*i];
+               double e = z[i] - hi[0]*dx[0] - hi[1]*dx[1] - hi[2]*dx[2]
+                  - hi[3]*dx[col[i]];
+               sumsq += e*e;
+            }
+            return SQRT(sumsq / double(n - k));
+         }
+
+      private:
+            /// Add sign times satellite i's terms to nm and b.
+         void update(size_t i, double sign, double *nm, double *b) const
+         {
+            const size_t idx[4] = { 0, 1, 2, col[i] };
+            const double *hi = &h[4*i];
+            const double wi = sign * w[i];
+            for (size_t r = 0; r < 4; r++)
+            {
+               const double whr = wi * hi[r];
+               for (size_t c = 0; c < 4; c++)
+               {
+                  nm[idx[r] + dim*idx[c]] += whr * hi[c];
+               }
+               b[idx[r]] += whr * z[i];
+            }
+         }
+
+         size_t n, dim;
+            /// Non-zero partials of each satellite, x,y,z,clock.
+         std::vector<double> h;
+            /// Residuals and weights.
+         std::vector<double> z, w;
+            /// Clock state of each satellite.
+         std::vector<size_t> col;
+            /// Normal equations of all the satellites, column major.
+         std::vector<double> nfull, bfull;
+            /// Number of satellites using each clock state.
+         std::vector<size_t> count;
+      };
+
+      constexpr double RAIMSubsetEvaluator::notEnough;
+      constexpr double RAIMSubsetEvaluator::singular;
+
+         /** Invert the symmetric positive definite matrix a in place,
+          * by Cholesky decomposition, without allocating once l has
+          * the size of a.  Pivots that are tiny compared to the
+          * diagonal of a are treated as singular, as in
+          * RAIMSubsetEvaluator::rms().
+          * @param[in,out] a the matrix to invert.
+          * @param[out] l scratch space for the Cholesky factor.
+          * @throw SingularMatrixException */
+      void invertCholesky(Matrix<double>& a, Matrix<double>& l)
+      {
+         const size_t n = a.rows();
+         l.resize(n, n, 0.0);
+            // a = l * transpose(l), lower triangle of l
+         for (size_t j = 0; j < n; j++)
+         {
+            for (size_t i = j; i < n; i++)
+            {
+               double sum = a(i,j);
+               for (size_t c = 0; c < j; c++)
+               {
+                  sum -= l(i,c) * l(j,c);
+               }
+               if (i == j)
+               {
+                  if (sum <= 1.e-12 * a(j,j))
+                  {
+                     GNSSTK_THROW(SingularMatrixException());
+                  }
+                  l(j,j) = SQRT(sum);
+               }
+               else
+               {
+                  l(i,j) = sum / l(j,j);
+               }
+            }
+         }
+            // invert l in place, a column at a time
+         for (size_t j = 0; j < n; j++)
+         {
+            l(j,j) = 1.0 / l(j,j);
+            for (size_t i = j+1; i < n; i++)
+            {
+               double sum = 0.0;
+               for (size_t k = j; k < i; k++)
+               {
+                  sum += l(i,k) * l(k,j);
+               }
+               l(i,j) = -sum / l(i,i);
+            }
+         }
+            // inverse(a) = transpose(inverse(l)) * inverse(l)
+         for (size_t j = 0; j < n; j++)
+         {
+            for (size_t i = j; i < n; i++)
+            {
+               double sum = 0.0;
+               for (size_t k = i; k < n; k++)
+               {
+                  sum += l(k,i) * l(k,j);
+               }
+               a(i,j) = a(j,i) = sum;
+            }
+         }
+      }
+   }
+
+
 
 
    int PRSolution ::
@@ -119,13 +377,9 @@ namespace gnsstk
          GNSSTK_THROW(e);
       }
 
-      Matrix<double> weights(invMC);
-      if (weights.rows() == 0)
-      {
-         weights = ident<double>(Sats.size());
-      }
-
-      if (Sats.size() != SVP.rows() || (weights.rows() != Sats.size()))
+         // an empty invMC means equal weights, see filterWeights()
+      if (Sats.size() != SVP.rows() ||
+          ((invMC.rows() != 0) && (invMC.rows() != Sats.size())))
       {
          LOG(ERROR) << "Sats has length " << Sats.size();
          LOG(ERROR) << "SVP has dimension " << SVP.rows() << "x" << SVP.cols();
@@ -146,10 +400,12 @@ namespace gnsstk
 
       try
       {
-         const FilteredConstSats filteredSats = filterMarkedSats(Sats);
+         const FilteredConstSats& filteredSats(work.filteredSats);
+         filterMarkedSats(Sats, work.filteredSats);
          
          Nsvs = filteredSats.size();
-         std::vector<SatelliteSystem> currGNSS = filterGNSS(allowedGNSS, filteredSats);
+         const std::vector<SatelliteSystem>& currGNSS(work.currGNSS);
+         filterGNSS(allowedGNSS, filteredSats, work.currGNSS);
 
             // dimension of the solution vector (3 pos + 1 clk/sys)
          const size_t dim(3 + currGNSS.size());
@@ -162,13 +418,15 @@ namespace gnsstk
 
          LOG(DEBUG) << "Build inverse MCov";
 
-         Matrix<double> filteredWeights = filterWeights(weights, filteredSats);
+         const Matrix<double>& filteredWeights(work.weights);
+         filterWeights(invMC, filteredSats, work.weights);
          
          LOG(DEBUG) << "inv MCov matrix is\n" << std::fixed << std::setprecision(4) << filteredWeights;
          LOG(DEBUG) << " Solution dimension is " << dim << " and Nsvs is " << Nsvs;
 
             // start with solution = apriori, cut down to match current dimension
-         Vector<double> localAPSol(dim, 0.0);
+         Vector<double>& localAPSol(work.apSol);
+         localAPSol.resize(dim, 0.0);
          if(hasMemory)
          {
             localAPSol[X] = APSolution[X];
@@ -188,18 +446,18 @@ namespace gnsstk
          Solution = localAPSol;
 
          double converge;
-         Matrix<double> partials;
-         Matrix<double> G;
+         Matrix<double>& partials(work.partials);
+         Matrix<double>& G(work.G);
          try
          {
-            Vector<double> dX(dim, 0.0);
+            Vector<double>& dX(work.totaldX);
             bool tropSuccess;
             std::tie(tropSuccess, converge, NIterations) =
                iterativeSinglePointWLSSolution(dX, partials, G, Covariance, Resids, 
                                                Solution, filteredSats, SVP, 
                                                pTropModel, T, currGNSS, 
                                                filteredWeights, convLimit, 
-                                               niterLimit); 
+                                               niterLimit, work); 
             TropFlag = !tropSuccess;
             Solution += dX;
          }
@@ -220,7 +478,7 @@ namespace gnsstk
          }
 
          double maxSlope = 0.0;
-         Vector<double> slopes;
+         Vector<double>& slopes(work.slopes);
          if (iret == RETURN_CODE::OK)
          {
             computeSlopes(slopes, partials, G, filteredSats);
@@ -231,7 +489,17 @@ namespace gnsstk
             // compute pre-fit residuals
          if (hasMemory)
          {
-            PreFitResidual = partials * (Solution - localAPSol) - Resids;
+               // partials * (Solution - localAPSol) - Resids
+            PreFitResidual.resize(Resids.size());
+            for (size_t i = 0; i < Resids.size(); i++)
+            {
+               double sum = 0.0;
+               for (size_t j = 0; j < dim; j++)
+               {
+                  sum += partials(i,j) * (Solution(j) - localAPSol(j));
+               }
+               PreFitResidual(i) = sum - Resids(i);
+            }
             LOG(DEBUG) << "Computed pre-fit residuals";
          }
 
@@ -245,7 +513,14 @@ namespace gnsstk
          Partials = partials;
          Convergence = converge;
          MaxSlope = maxSlope;
-         Slopes = slopes;
+         if (iret == RETURN_CODE::OK)
+         {
+            Slopes = slopes;
+         }
+         else
+         {
+            Slopes.resize(0);
+         }
          Valid = true;
 
          return iret;
@@ -381,8 +656,68 @@ namespace gnsstk
             // Resids stores the post-fit data residuals.
          Vector<double> Resids;
 
+            // save the current solution as the 'best' one
+         auto saveBest = [&]()
+         {
+            BestRMS = RMSResidual;
+            BestSol = Solution;
+            BestSats = SatelliteIDs;
+            BestGNSS = dataGNSS;
+            BestSL = MaxSlope;
+            BestConv = Convergence;
+            BestNIter = NIterations;
+            BestCov = Covariance;
+            BestInvMCov = invMeasCov;
+            BestPartials = Partials;
+            BestPFR = PreFitResidual;
+            BestTropFlag = TropFlag;
+            BestIret = iret;
+         };
+
          for (int stage = 0;; ++stage)
          {
+               // FastRAIM: the solution with all the satellites (stage 0)
+               // failed the RMS test; choose the satellites to reject from
+               // its linearization and solve only that combination.
+            if (stage == 1 && FastRAIM && iret >= RETURN_CODE::OK)
+            {
+               std::vector<int> reject;
+               double linRMS;
+               if (fastRAIMSearch(SVP, pTropModel, reject, linRMS))
+               {
+                  if (reject.empty())
+                  {
+                        // stage 0 is already saved as the best
+                     iret = BestIret;
+                     break;
+                  }
+                  Sats = SaveSats;
+                  for (int i : reject)
+                  {
+                     Sats[GoodIndexes[i]].id = -::abs(Sats[GoodIndexes[i]].id);
+                  }
+                  iret = SimplePRSolution(Tr, Sats, SVP, invMC, pTropModel,
+                                          MaxNIterations, ConvergenceLimit,
+                                          Resids, Slopes);
+                  bool agree = (iret >= RETURN_CODE::OK &&
+                                (linRMS < RMSLimit) == (RMSResidual < RMSLimit));
+                  LOG(DEBUG) << " Fast RAIM: rejects " << reject.size()
+                             << ", linearized RMS " << linRMS << ", SimplePRS "
+                             << iret << " RMS " << RMSResidual
+                             << (agree ? "" : " - disagree");
+                  if (agree || !FastRAIMVerify)
+                  {
+                     if (iret >= RETURN_CODE::OK && RMSResidual < BestRMS)
+                     {
+                        saveBest();
+                     }
+                     iret = BestIret;
+                     break;
+                  }
+                  LOG(DEBUG) << " Fast RAIM: not verified, try all combinations";
+               }
+            }
+
                // compute all the combinations of N satellites taken stage at a time
             Combinations Combo(N,stage);
 
@@ -467,19 +802,7 @@ namespace gnsstk
                   // save 'best' solution for later
                if (BestRMS < 0.0 || RMSResidual < BestRMS)
                {
-                  BestRMS = RMSResidual;
-                  BestSol = Solution;
-                  BestSats = SatelliteIDs;
-                  BestGNSS = dataGNSS;
-                  BestSL = MaxSlope;
-                  BestConv = Convergence;
-                  BestNIter = NIterations;
-                  BestCov = Covariance;
-                  BestInvMCov = invMeasCov;
-                  BestPartials = Partials;
-                  BestPFR = PreFitResidual;
-                  BestTropFlag = TropFlag;
-                  BestIret = iret;
+                  saveBest();
                }
 
                if (stage == 0 && RMSResidual < RMSLimit)
@@ -658,7 +981,7 @@ namespace gnsstk
    {
       try
       {
-         Matrix<double> PTP(transpose(Partials) * Partials);
+         Matrix<double> PTP(transposeTimes(Partials, Partials));
          Matrix<double> Cov(inverseLUD(PTP));
          PDOP = SQRT(Cov(0, 0) + Cov(1, 1) + Cov(2, 2));
          TDOP = 0.0;
@@ -1004,6 +1327,16 @@ namespace gnsstk
    filterMarkedSats(const std::vector<SatID>& sats) const
    {
       FilteredConstSats filteredSats;
+      filterMarkedSats(sats, filteredSats);
+      return filteredSats;
+   }
+
+
+   void PRSolution :: 
+   filterMarkedSats(const std::vector<SatID>& sats,
+                    FilteredConstSats& filteredSats) const
+   {
+      filteredSats.clear();
 
       for (size_t i = 0; i < sats.size(); ++i)
       {
@@ -1012,8 +1345,6 @@ namespace gnsstk
             filteredSats.push_back(std::make_pair(i, std::cref(sats[i])));
          }
       }
-
-      return filteredSats;
    }
 
    
@@ -1136,9 +1467,8 @@ namespace gnsstk
             // to account for Earth's rotations
          double rho  = computeRange(svPos, rxPos, firstIteration);
 
-         Triple dirCos((rxPos[X] - svPos[X]) / rho,
-                       (rxPos[Y] - svPos[Y]) / rho,
-                       (rxPos[Z] - svPos[Z]) / rho);
+         SVector<double,3> dirCos(rxPos.theArray - svPos.theArray);
+         dirCos /= rho;
 
          double residual = svp(satIndex, P_HAT) - rho;
 
@@ -1183,36 +1513,78 @@ namespace gnsstk
                           Matrix<double>& covariance,
                           Vector<double>& residuals,
                           const Vector<double>& aPrioriSolution, 
-                          const FilteredConstSats filteredSats, 
+                          const FilteredConstSats& filteredSats, 
                           const Matrix<double>& svp, 
                           TropModel *pTropModel, 
                           const CommonTime& nominalReceive, 
                           bool firstIteration, 
                           const std::vector<SatelliteSystem>& currGNSS, 
-                          const Matrix<double>& weights) const
+                          const Matrix<double>& weights,
+                          Workspace& ws) const
    {
       bool tropSuccess = computePartialsAndResiduals(
             partials, residuals, filteredSats, svp, aPrioriSolution, 
             firstIteration, pTropModel, nominalReceive, currGNSS);
 
+         // The products are formed element by element in storage
+         // that is reused between iterations and epochs.
+      const size_t n = partials.rows(), dim = partials.cols();
 
-      Matrix<double> partialsT = transpose(partials);
-      covariance = partialsT * weights * partials;
-
-      try
+         // transpose(partials) * weights, used twice
+      Matrix<double>& partialsTW(ws.partialsTW);
+      partialsTW.resize(dim, n);
+      for (size_t i = 0; i < dim; i++)
       {
-         covariance = inverseSVD(covariance);
+         for (size_t j = 0; j < n; j++)
+         {
+            double sum = 0.0;
+            for (size_t k = 0; k < n; k++)
+            {
+               sum += partials(k,i) * weights(k,j);
+            }
+            partialsTW(i,j) = sum;
+         }
       }
-      catch (MatrixException& sme)
+      covariance.resize(dim, dim);
+      for (size_t i = 0; i < dim; i++)
       {
-            // Using the more specific SingluarMatrixException so that the caller 
-            // can recover for this particular case.
-         GNSSTK_THROW(SingularMatrixException());
+         for (size_t j = 0; j < dim; j++)
+         {
+            double sum = 0.0;
+            for (size_t k = 0; k < n; k++)
+            {
+               sum += partialsTW(i,k) * partials(k,j);
+            }
+            covariance(i,j) = sum;
+         }
       }
 
-      G = covariance * partialsT * weights;
+      invertCholesky(covariance, ws.chol);
+
+      G.resize(dim, n);
+      for (size_t i = 0; i < dim; i++)
+      {
+         for (size_t j = 0; j < n; j++)
+         {
+            double sum = 0.0;
+            for (size_t k = 0; k < dim; k++)
+            {
+               sum += covariance(i,k) * partialsTW(k,j);
+            }
+            G(i,j) = sum;
+         }
+      }
  
-      dX = G * residuals;
+      dX.resize(dim);
+      for (size_t i = 0; i < dim; i++)
+      {
+         double sum = 0.0;
+         for (size_t k = 0; k < n; k++)
+         {
+            sum += G(i,k) * residuals(k);
+         }
+         dX(i) = sum;
+      }
      
       LOG(DEBUG) << "Partials (" << partials.rows() << "x" << partials.cols() << ")\n"
          << std::fixed << std::setprecision(4) << partials;
@@ -1240,14 +1612,26 @@ namespace gnsstk
                                 const std::vector<SatelliteSystem>& currGNSS,
                                 const Matrix<double>& weights,
                                 double convLimit,
-                                int niterLimit) const
+                                int niterLimit,
+                                Workspace& ws) const
    {
       bool tropSuccess;
-      double dim = 3 + currGNSS.size();
+      size_t dim = 3 + currGNSS.size();
       partials.resize(filteredSats.size(), dim, 0.0);
-      Vector<double> dX(dim, 0.0);
+      Vector<double>& dX(ws.dX);
+      dX.resize(dim, 0.0);
       totaldX.resize(dim, 0.0);
       residuals.resize(filteredSats.size());
+         // aPrioriSolution + totaldX
+      Vector<double>& sol(ws.sol);
+      sol.resize(dim);
+      auto updateSol = [&]()
+      {
+         for (size_t i = 0; i < dim; i++)
+         {
+            sol(i) = aPrioriSolution(i) + totaldX(i);
+         }
+      };
          
          // Perform two iterations regardless of the iteration limit.
          // Don't apply trop delays on the first iteration.
@@ -1255,14 +1639,15 @@ namespace gnsstk
                                            residuals, aPrioriSolution, 
                                            filteredSats, svp, 
                                            pTropModel, nominalReceive, true, 
-                                           currGNSS, weights);
+                                           currGNSS, weights, ws);
       totaldX += dX;
+      updateSol();
       
       tropSuccess = singlePointWLSSolution(dX, partials, G, covariance, 
-                                           residuals, aPrioriSolution + totaldX, 
+                                           residuals, sol, 
                                            filteredSats, svp, pTropModel,
                                            nominalReceive, false, currGNSS, 
-                                           weights);
+                                           weights, ws);
       totaldX += dX;
       
          // defined outside of the loop so they can be returned
@@ -1271,12 +1656,12 @@ namespace gnsstk
 
       for (; iter < niterLimit && converge >= convLimit && converge <= 1.e10; ++iter)
       {
+         updateSol();
          tropSuccess = singlePointWLSSolution(dX, partials, G, covariance, 
-                                              residuals,
-                                              aPrioriSolution + totaldX, 
+                                              residuals, sol,
                                               filteredSats, svp, pTropModel,
                                               nominalReceive, false, currGNSS, 
-                                              weights);
+                                              weights, ws);
          totaldX += dX;
          converge = norm(dX);
       }
@@ -1340,16 +1725,21 @@ namespace gnsstk
                 const FilteredConstSats& filteredSats) const
    { 
       slopes.resize(filteredSats.size(), 0.0);
-       
-      Matrix<double> PG(partials * G);
 
       for (size_t i = 0; i < filteredSats.size(); ++i)
       {
          const SatID &sat = filteredSats[i].second;
 
+            // diagonal element of partials * G
+         double pg = 0.0;
+         for (size_t k = 0; k < G.rows(); ++k)
+         {
+            pg += partials(i, k) * G(k, i);
+         }
+
             // When one (few) sats have their own clock, PG(j,j) = 1 (nearly 1)
             // and slope is inf (large)
-         if (std::fabs(1.0 - PG(i, i)) < 1.e-8)
+         if (std::fabs(1.0 - pg) < 1.e-8)
          {
             continue;
          }
@@ -1360,16 +1750,172 @@ namespace gnsstk
          }
 
          int n = filteredSats.size();
-         slopes(i) = SQRT(slopes(i) * double(n - G.rows()) / (1.0 - PG(i, i)));
+         slopes(i) = SQRT(slopes(i) * double(n - G.rows()) / (1.0 - pg));
       }
    }
 
 
+   bool PRSolution ::
+   fastRAIMSearch(const Matrix<double>& svp,
+                  TropModel *pTropModel,
+                  std::vector<int>& reject,
+                  double& rms) const
+   {
+      const FilteredConstSats filteredSats = filterMarkedSats(SatelliteIDs);
+      const size_t n = filteredSats.size();
+      if (n == 0 || invMeasCov.rows() != n)
+      {
+         return false;
+      }
+      std::vector<double> weights(n);
+      for (size_t i = 0; i < n; ++i)
+      {
+         for (size_t j = 0; j < n; ++j)
+         {
+            if (i != j && invMeasCov(i, j) != 0.0)
+            {
+               return false;
+            }
+         }
+         weights[i] = invMeasCov(i, i);
+      }
+
+         // linearize once, about the solution with all the satellites
+      Matrix<double> partials;
+      Vector<double> resid(n);
+      computePartialsAndResiduals(partials, resid, filteredSats, svp, Solution,
+                                  false, pTropModel, currTime, dataGNSS);
+      RAIMSubsetEvaluator eval(partials, resid, weights);
+
+      std::vector<double> work;
+      reject.clear();
+      rms = eval.rms(nullptr, 0, work);
+      if (rms < 0.0)
+      {
+         return false;
+      }
+
+      unsigned nthreads = (RAIMThreads > 0 ? RAIMThreads :
+                           std::thread::hardware_concurrency());
+      nthreads = std::max(nthreads, 1u);
+
+      for (size_t stage = 1; stage <= n; ++stage)
+      {
+            // list the combinations in the order RAIMCompute() tries them
+         std::vector<int> combos;
+         Combinations Combo(static_cast<int>(n), static_cast<int>(stage));
+         do {
+            for (size_t i = 0; i < stage; ++i)
+            {
+               combos.push_back(Combo.Selection(i));
+            }
+         } while (Combo.Next() != -1);
+         const size_t ncombo = combos.size() / stage;
+
+         std::vector<double> results(ncombo);
+         auto evalRange = [&](size_t begin, size_t end)
+         {
+            std::vector<double> scratch;
+            for (size_t c = begin; c < end; ++c)
+            {
+               results[c] = eval.rms(&combos[c*stage], stage, scratch);
+            }
+         };
+            // threads only pay for themselves on the larger stages
+         const size_t minPerThread = 256;
+         size_t nt = std::min<size_t>(nthreads, ncombo / minPerThread);
+         if (nt > 1)
+         {
+               // an exception escaping a thread would terminate the
+               // program, so keep it and rethrow it here
+            std::vector<std::exception_ptr> errors(nt);
+            std::vector<std::thread> threads;
+            for (size_t t = 0; t < nt; ++t)
+            {
+               threads.push_back(std::thread([&, t]()
+               {
+                  try
+                  {
+                     evalRange(t * ncombo / nt, (t+1) * ncombo / nt);
+                  }
+                  catch (...)
+                  {
+                     errors[t] = std::current_exception();
+                  }
+               }));
+            }
+            for (auto& thread : threads)
+            {
+               thread.join();
+            }
+            for (const auto& error : errors)
+            {
+               if (error)
+               {
+                  std::rethrow_exception(error);
+               }
+            }
+         }
+         else
+         {
+            evalRange(0, ncombo);
+         }
+
+            // pick the best as RAIMCompute() would, stopping at the first
+            // combination with too few satellites
+         bool stop = false;
+         for (size_t c = 0; c < ncombo; ++c)
+         {
+            if (results[c] == RAIMSubsetEvaluator::notEnough)
+            {
+               stop = true;
+               break;
+            }
+            if (results[c] >= 0.0 && results[c] < rms)
+            {
+               rms = results[c];
+               reject.assign(combos.begin() + c*stage,
+                             combos.begin() + (c+1)*stage);
+            }
+         }
+         LOG(DEBUG) << " Fast RAIM: stage " << stage << " best RMS " << rms;
+
+         if (rms < RMSLimit || stop ||
+             (NSatsReject > -1 && int(stage) > NSatsReject))
+         {
+            break;
+         }
+      }
+
+      return true;
+   }
+
+
    Matrix<double> PRSolution ::
    filterWeights(const Matrix<double>& weights, 
                  const FilteredConstSats& filteredSats) const
    {
-      Matrix<double> filteredWeights(filteredSats.size(), filteredSats.size(), 0.0);
+      Matrix<double> filteredWeights;
+      filterWeights(weights, filteredSats, filteredWeights);
+      return filteredWeights;
+   }
+
+
+   void PRSolution ::
+   filterWeights(const Matrix<double>& weights, 
+                 const FilteredConstSats& filteredSats,
+                 Matrix<double>& filteredWeights) const
+   {
+      filteredWeights.resize(filteredSats.size(), filteredSats.size(), 0.0);
+      if (weights.rows() == 0)
+      {
+            // equal weights
+         for (size_t i = 0; i < filteredSats.size(); i++)
+         {
+            filteredWeights(i, i) = 1.0;
+         }
+         return;
+      }
       
       int n = 0;
       for (const auto &kvI : filteredSats)
@@ -1384,8 +1930,6 @@ namespace gnsstk
          }
          ++n;
       }
-      
-      return filteredWeights;
    }
 
 
@@ -1393,28 +1937,30 @@ namespace gnsstk
    filterGNSS(const std::vector<SatelliteSystem>& allowedGNSS, 
               const FilteredConstSats& filteredSats) const
    {
-      std::vector<SatelliteSystem> tempGNSS;
-      for (const auto &kv : filteredSats)
-      {
-         const SatID &sat = kv.second;
-      
-         if (vectorindex(tempGNSS, sat.system) == -1)
-         {
-            tempGNSS.push_back(sat.system);
-         }
-      }
+      std::vector<SatelliteSystem> currGNSS;
+      filterGNSS(allowedGNSS, filteredSats, currGNSS);
+      return currGNSS;
+   }
+
 
+   void PRSolution ::
+   filterGNSS(const std::vector<SatelliteSystem>& allowedGNSS, 
+              const FilteredConstSats& filteredSats,
+              std::vector<SatelliteSystem>& currGNSS) const
+   {
          // must sort as in allowedGNSS
-      std::vector<SatelliteSystem> currGNSS;
+      currGNSS.clear();
       for (SatelliteSystem system : allowedGNSS)
       {
-         if (vectorindex(tempGNSS, system) != -1)
+         for (const auto &kv : filteredSats)
          {
-            currGNSS.push_back(system);
+            if (kv.second.get().system == system)
+            {
+               currGNSS.push_back(system);
+               break;
+            }
          }
       }
-
-      return currGNSS;
    }
 
 
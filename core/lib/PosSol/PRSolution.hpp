@@ -228,6 +228,9 @@ namespace gnsstk
                       NSatsReject(-1),
                       MaxNIterations(10),
                       ConvergenceLimit(3.e-7),
+                      FastRAIM(false),
+                      FastRAIMVerify(true),
+                      RAIMThreads(0),
                       hasMemory(true),
                       fixedAPriori(false),
                       nsol(0), ndata(0), APV(0.0),
@@ -262,6 +265,28 @@ namespace gnsstk
       /// solution exceeds this.
       double ConvergenceLimit;
 
+      /// If true, RAIMCompute() does not compute a full solution for
+      /// every combination of rejected satellites. Instead it linearizes
+      /// once, about the solution with all the satellites, and evaluates
+      /// the RMS residual of each combination by removing the rejected
+      /// satellites from the normal equations of that solution (a rank
+      /// one downdate per satellite). Only the combination chosen this
+      /// way is then solved in full. The combinations of a stage are
+      /// evaluated in parallel, see RAIMThreads. This requires a diagonal
+      /// measurement covariance (invMC); otherwise, and when the solution
+      /// with all the satellites fails, every combination is solved.
+      bool FastRAIM;
+
+      /// If true, and FastRAIM is set, the combination chosen by the fast
+      /// search is accepted only if its full solution succeeds and agrees
+      /// with the linearized one about whether RMSLimit is met; otherwise
+      /// RAIMCompute() falls back to solving every combination.
+      bool FastRAIMVerify;
+
+      /// Number of threads used by FastRAIM to evaluate the combinations
+      /// of a stage; 0 uses the number of hardware threads.
+      unsigned RAIMThreads;
+
       /// vector<SatelliteSystem> containing the satellite systems allowed
       /// in the solution. **This vector MUST be defined before computing solutions.**
       /// It is used to determine which clock biases are included in the solution,
@@ -433,6 +458,11 @@ namespace gnsstk
       /// -1  failed to converge
       /// -2  singular problem
       /// -3  not enough good data to form a solution (at least 4 satellites required)
+      ///
+      /// The working storage is kept in the object, so once the first
+      /// epoch has sized it, solving further epochs with the same numbers
+      /// of satellites and systems does not allocate memory, provided
+      /// Resids and Slopes are also reused from one call to the next.
       int SimplePRSolution(const CommonTime& Tr,
                            const std::vector<SatID>& Sats,
                            const Matrix<double>& SVP,
@@ -654,6 +684,38 @@ namespace gnsstk
          /// empty vector used to detect default
       GNSSTK_EXPORT static const Vector<double> PRSNullVector;
 
+         /** Storage used by SimplePRSolution() at every epoch, kept
+          * from one call to the next so that it is only allocated
+          * when the numbers of satellites or systems grow. */
+      struct Workspace
+      {
+            /// The unmarked satellites.
+         FilteredConstSats filteredSats;
+            /// The systems of the unmarked satellites.
+         std::vector<SatelliteSystem> currGNSS;
+            /// Weights of the unmarked satellites.
+         Matrix<double> weights;
+            /// Partials of the current iteration.
+         Matrix<double> partials;
+            /// transpose(partials) * weights.
+         Matrix<double> partialsTW;
+            /// The weighted least squares solution matrix.
+         Matrix<double> G;
+            /// Cholesky factor of the normal matrix.
+         Matrix<double> chol;
+            /// A priori solution cut down to the current systems.
+         Vector<double> apSol;
+            /// A priori solution plus the corrections so far.
+         Vector<double> sol;
+            /// Correction of the current iteration and of all of them.
+         Vector<double> dX, totaldX;
+            /// Slopes of the unmarked satellites.
+         Vector<double> slopes;
+      };
+
+         /// Working storage of SimplePRSolution().
+      Workspace work;
+
 
          /// Mark SVs that are disallowed GNSS
       void markDisallowedGNSS(
@@ -728,6 +790,16 @@ namespace gnsstk
           * sat at that index.
           */
       FilteredConstSats filterMarkedSats(const std::vector<SatID>& sats) const;
+
+         /** Fill a filtered view, that cannot be modified, of unmarked
+          * sats, reusing the storage of the view.
+          *
+          * @param[in] sats vector of SatIDs that may be marked.
+          * @param[out] filteredSats pairs of the index into sats and a
+          *    reference to the sat at that index, for each unmarked sat.
+          */
+      void filterMarkedSats(const std::vector<SatID>& sats,
+                            FilteredConstSats& filteredSats) const;
       
 
          /** Create a filtered view, that can be modified, of unmarked sats.
@@ -837,8 +909,11 @@ namespace gnsstk
           *    vector.
           * @param[in] weights a weight matrix for the unmarked sats in the
           *    current weighted least squares solution.
+          * @param[in,out] ws scratch storage for the products and the
+          *    Cholesky factor of the normal matrix.
           * @return true if the tropospheric delay was evaluated and applied
           *    without issues.
+          * @throw SingularMatrixException if the normal matrix is singular.
           */
       bool singlePointWLSSolution(
             Vector<double>& dX,
@@ -847,13 +922,14 @@ namespace gnsstk
             Matrix<double>& covariance,
             Vector<double>& residuals,
             const Vector<double>& aPrioriSolution, 
-            const FilteredConstSats filteredSats, 
+            const FilteredConstSats& filteredSats, 
             const Matrix<double>& svp, 
             TropModel *pTropModel, 
             const CommonTime& nominalReceive, 
             bool firstIteration, 
             const std::vector<SatelliteSystem>& currGNSS, 
-            const Matrix<double>& weights) const;
+            const Matrix<double>& weights,
+            Workspace& ws) const;
    
 
          /** Iteratively compute a single point weighted least squares solution.
@@ -903,6 +979,7 @@ namespace gnsstk
           * @param[in] convLimit the convergence threshold for the norm of the
           *    state estimate correction.
           * @param[in] niterLimit a max number of iterations.
+          * @param[in,out] ws scratch storage, see singlePointWLSSolution().
           * @return a tuple of tropSuccess (bool), the last computed convergence
           *    test (double), and the number actual number of iterations
           *    used in the solution (int). The tropSuccess returns true if
@@ -924,7 +1001,8 @@ namespace gnsstk
             const std::vector<SatelliteSystem>& currGNSS,
             const Matrix<double>& weights,
             double convLimit,
-            int niterLimit) const;
+            int niterLimit,
+            Workspace& ws) const;
 
          /** Compute the partial derivates matrix and pseudorange residuals.
           *
@@ -1007,6 +1085,42 @@ namespace gnsstk
             const Matrix<double>& weights, 
             const FilteredConstSats& filteredSats) const;
 
+         /** Reduce the weight matrix to the matching filtered sats,
+          * reusing the storage of the result.
+          *
+          * @param[in] weights matrix sized by the original sats vector,
+          *    or an empty matrix for equal weights.
+          * @param[in] filteredSats the view of unmarked sats.
+          * @param[out] filteredWeights the weights of the unmarked sats.
+          */
+      void filterWeights(
+            const Matrix<double>& weights, 
+            const FilteredConstSats& filteredSats,
+            Matrix<double>& filteredWeights) const;
+
+         /** Choose the satellites to reject for FastRAIM, using the
+          * linearization about the current solution (Solution,
+          * SatelliteIDs, dataGNSS and invMeasCov, as left by
+          * SimplePRSolution() with all the good satellites). The
+          * stages, limits and choice of the best combination follow
+          * RAIMCompute(), with the RMS residual of each combination
+          * computed from the downdated normal equations.
+          *
+          * @param[in] svp the SVP matrix from PreparePRSolution().
+          * @param[in] pTropModel the tropospheric model to use.
+          * @param[out] reject the indexes, into the unmarked
+          *    satellites of SatelliteIDs, of the satellites to reject.
+          * @param[out] rms the linearized RMS residual of the
+          *    satellites that remain.
+          * @return false if the fast search can't be used, i.e. if
+          *    invMeasCov is not diagonal.
+          */
+      bool fastRAIMSearch(
+            const Matrix<double>& svp,
+            TropModel *pTropModel,
+            std::vector<int>& reject,
+            double& rms) const;
+
          /** Compute the slopes of the linear regression solution.
           *
           * The slopes vector matches the size and ordering of the
@@ -1068,6 +1182,21 @@ namespace gnsstk
             const std::vector<SatelliteSystem>& allowedGNSS, 
             const FilteredConstSats& filteredSats) const;
 
+         /** Filter systems down to those represented in the filtered
+          * satellites, reusing the storage of the result.
+          *
+          * @param[in] allowedGNSS containing the satellite systems allowed
+          *    in the solution.
+          * @param[in] filteredSats a filtered view of unmarked satellites
+          *    for the current solution.
+          * @param[out] currGNSS the systems of allowedGNSS that are
+          *    represented in filteredSats, in the same order.
+          */
+      void filterGNSS(
+            const std::vector<SatelliteSystem>& allowedGNSS, 
+            const FilteredConstSats& filteredSats,
+            std::vector<SatelliteSystem>& currGNSS) const;
+
          /// Provides human readable names to the exit codes of PRSolution
       enum RETURN_CODE {
          DEGRADED = 1,
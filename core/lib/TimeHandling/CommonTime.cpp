@@ -63,21 +63,6 @@ namespace gnsstk
    const double CommonTime::eps = 4.*std::numeric_limits<double>::epsilon();
 
 
-   CommonTime::CommonTime( const CommonTime& right )
-     : m_day( right.m_day ), m_msod( right.m_msod ), m_fsod( right.m_fsod ),
-       m_timeSystem( right.m_timeSystem )
-   {}
-
-   CommonTime& CommonTime::operator=( const CommonTime& right )
-   {
-      m_day  = right.m_day;
-      m_msod = right.m_msod;
-      m_fsod = right.m_fsod;
-      m_timeSystem = right.m_timeSystem;
-      return *this;
-   }
-
-
    //FUTURE DEPRECATION
    //ALL COMMONTIME ACCESSOR/MUTATOR METHODS ARE SET FOR FUTURE DEPRECATION (PRIVATIZATION)
    //Accessor/Mutator methods should only be used by TimeTag classes and not made public,
@@ -118,8 +103,7 @@ namespace gnsstk
          // subtract whole milliseconds to obtain the "fractional milliseconds"
       fsod -= static_cast<double>( msec ) * SEC_PER_MS;
 
-      m_day  = day;
-      m_msod = sod * MS_PER_SEC + msec;
+      m_msec = static_cast<int64_t>( day ) * MS_PER_DAY + sod * MS_PER_SEC + msec;
       m_fsod = fsod;
 
       m_timeSystem = timeSystem;
@@ -176,8 +160,7 @@ namespace gnsstk
          GNSSTK_THROW( ip );
       }
 
-      m_day  = day;
-      m_msod = msod;
+      m_msec = static_cast<int64_t>( day ) * MS_PER_DAY + msod;
       m_fsod = fsod;
 
       m_timeSystem = timeSystem;
@@ -215,10 +198,11 @@ namespace gnsstk
                          double& fsod,
                          TimeSystem& timeSystem ) const
    {
-      day = m_day;
-      sod = m_msod / MS_PER_SEC;
-      long msec = m_msod - sod * MS_PER_SEC;  // m_msod % MS_PER_SEC
-      fsod = static_cast<double>( msec ) * SEC_PER_MS + m_fsod;
+      long msod;
+      getInternal( day, msod, fsod );
+      sod = msod / MS_PER_SEC;
+      long msec = msod - sod * MS_PER_SEC;  // msod % MS_PER_SEC
+      fsod += static_cast<double>( msec ) * SEC_PER_MS;
       timeSystem = m_timeSystem;
    }
 
@@ -236,8 +220,10 @@ namespace gnsstk
                          double& sod,
                          TimeSystem& timeSystem ) const
    {
-      day = m_day;
-      sod = (double)m_msod / MS_PER_SEC + m_fsod;
+      long msod;
+      double fsod;
+      getInternal( day, msod, fsod );
+      sod = (double)msod / MS_PER_SEC + fsod;
       timeSystem = m_timeSystem;
    }
 
@@ -254,9 +240,12 @@ namespace gnsstk
                         TimeSystem& timeSystem ) const
    {
          // convert everything to days
-      day = static_cast<double>( m_day ) +
-            static_cast<double>( m_msod ) / MS_PER_DAY +
-            m_fsod / SEC_PER_DAY;
+      long lday, msod;
+      double fsod;
+      getInternal( lday, msod, fsod );
+      day = static_cast<double>( lday ) +
+            static_cast<double>( msod ) / MS_PER_DAY +
+            fsod / SEC_PER_DAY;
       timeSystem = m_timeSystem;
    }
 
@@ -284,69 +273,14 @@ namespace gnsstk
       return sod;
    }
 
-   //METHOD SET FOR FUTURE DEPRECATION (PRIVATIZATION)
-   TimeSystem CommonTime::getTimeSystem() const
-   {
-      return m_timeSystem;
-   }
-
-   double CommonTime::operator-( const CommonTime& right ) const
-   {
-         // Any (wildcard) type exception allowed, otherwise must be
-         // same time systems
-      if ( (m_timeSystem != TimeSystem::Any &&
-               right.m_timeSystem != TimeSystem::Any) &&
-               m_timeSystem != right.m_timeSystem )
-      {
-         InvalidRequest ir("CommonTime objects not in same time system, cannot be differenced");
-         GNSSTK_THROW( ir );
-      }
-
-      return( SEC_PER_DAY * static_cast<double>( m_day  - right.m_day  ) +
-              SEC_PER_MS  * static_cast<double>( m_msod - right.m_msod ) +
-              m_fsod - right.m_fsod ) ;
-   }
-
-   CommonTime CommonTime::operator+( double sec ) const
-   {
-      return CommonTime( *this ).addSeconds( sec );
-   }
-
-   CommonTime CommonTime::operator-( double sec ) const
+   void CommonTime::throwTimeSystemMismatch( const CommonTime& right,
+                                             const char *what ) const
    {
-      return CommonTime( *this ).addSeconds( -sec );
-   }
-
-   CommonTime& CommonTime::operator+=( double sec )
-   {
-      addSeconds( sec );
-      return *this;
-   }
-
-   CommonTime& CommonTime::operator-=( double sec )
-   {
-      addSeconds( -sec );
-      return *this;
-   }
-
-   CommonTime& CommonTime::addSeconds( double seconds )
-   {
-      long days = 0, ms = 0;
-
-      if ( ABS(seconds) >= SEC_PER_DAY )
-      {
-         days = static_cast<long>( seconds * DAY_PER_SEC );
-         seconds -= days * SEC_PER_DAY;
-      }
-
-      if ( ABS(seconds) >= SEC_PER_MS )
-      {
-         ms = static_cast<long>( seconds * MS_PER_SEC );
-         seconds -= static_cast<double>( ms ) / MS_PER_SEC;
-      }
-
-      add( days, ms, seconds );
-      return *this;
+      InvalidRequest ir(
+         std::string("CommonTime objects not in same time system, cannot be ") +
+         what + ": " + gnsstk::StringUtils::asString(m_timeSystem) + " != " +
+         gnsstk::StringUtils::asString(right.m_timeSystem));
+      GNSSTK_THROW( ir );
    }
 
    CommonTime& CommonTime::addSeconds( long seconds )
@@ -374,95 +308,22 @@ namespace gnsstk
       return *this;
    }
 
-   bool CommonTime::operator==( const CommonTime& right ) const
-   {
-         // Any (wildcard) type exception allowed, otherwise must be
-         // same time systems
-      if ((m_timeSystem != TimeSystem::Any &&
-           right.m_timeSystem != TimeSystem::Any) &&
-          m_timeSystem != right.m_timeSystem)
-         return false;
-
-      return (m_day        == right.m_day     &&
-              m_msod       == right.m_msod    &&
-              fabs(m_fsod-right.m_fsod) < eps   );
-   }
-
-   bool CommonTime::operator!=( const CommonTime& right ) const
-   {
-      return !operator==(right);
-   }
-
-   bool CommonTime::operator<( const CommonTime& right ) const
-   {
-         // Any (wildcard) type exception allowed, otherwise must be
-         // same time systems
-      if ((m_timeSystem != TimeSystem::Any &&
-           right.m_timeSystem != TimeSystem::Any) &&
-          m_timeSystem != right.m_timeSystem)
-      {
-         InvalidRequest ir(
-            "CommonTime objects not in same time system, cannot be compared: " +
-            gnsstk::StringUtils::asString(m_timeSystem) + " != " +
-            gnsstk::StringUtils::asString(right.m_timeSystem));
-         GNSSTK_THROW( ir );
-      }
-
-      if (m_day < right.m_day)
-         return true;
-      if (m_day > right.m_day)
-         return false;
-
-      if (m_msod < right.m_msod)
-         return true;
-      if (m_msod > right.m_msod)
-         return false;
-
-      if (m_fsod < right.m_fsod)
-         return true;
-
-      return false;
-   }
-
-   bool CommonTime::operator>( const CommonTime& right ) const
-   {
-      return !operator <=(right);
-   }
-
-   bool CommonTime::operator<=( const CommonTime& right ) const
-   {
-      return (operator<(right) || operator==(right));
-   }
-
-   bool CommonTime::operator>=( const CommonTime& right ) const
-   {
-      return !operator<(right);
-   }
-
    std::string CommonTime::asString() const
    {
       using namespace std;
       ostringstream oss;
+      long day, msod;
+      double fsod;
+      getInternal( day, msod, fsod );
       oss << setfill('0')
-          << setw(7) << m_day  << " "
-          << setw(8) << m_msod << " "
-          << fixed << setprecision(15) << setw(17) << m_fsod
+          << setw(7) << day  << " "
+          << setw(8) << msod << " "
+          << fixed << setprecision(15) << setw(17) << fsod
           << " " << gnsstk::StringUtils::asString(m_timeSystem) ;
       return oss.str();
    }
 
 
-   bool CommonTime::add( long days,
-                         long msod,
-                         double fsod )
-   {
-      m_day  += days;
-      m_msod += msod;
-      m_fsod += fsod;
-
-      return normalize();
-   }
-
    bool CommonTime::normalize()
    {
       std::numeric_limits<double> eps;
@@ -470,17 +331,10 @@ namespace gnsstk
       if( ABS( m_fsod ) >= SEC_PER_MS - eps.epsilon() ) // allow for machine rounding errors
       {
          long ms = static_cast<long>( (m_fsod + eps.epsilon()) * MS_PER_SEC ); // again
-         m_msod += ms;
+         m_msec += ms;
          m_fsod -= static_cast<double>( ms ) * SEC_PER_MS;
       }
 
-      if( ABS( m_msod ) >= MS_PER_DAY )
-      {
-         long day = m_msod / MS_PER_DAY;
-         m_day  += day;
-         m_msod -= day * MS_PER_DAY;
-      }
-
       if( ABS(m_fsod) < 1e-15 )
       {
          m_fsod = 0.0;
@@ -489,21 +343,15 @@ namespace gnsstk
       if( m_fsod < 0 )
       {
          m_fsod += SEC_PER_MS;
-         --m_msod;
-      }
-
-      if( m_msod < 0 )
-      {
-         m_msod = m_msod + MS_PER_DAY;
-         --m_day;
+         --m_msec;
       }
 
       // byte logic to repair fixed-point math
       if ( m_fsod >= static_cast<double>(0.999) )
          m_fsod -= static_cast<double>(0.999);
 
-      return ( ( m_day >= BEGIN_LIMIT_JDAY ) &&
-               ( m_day <  END_LIMIT_JDAY   ) );
+      return ( ( m_msec >= 0 ) &&
+               ( m_msec < static_cast<int64_t>( END_LIMIT_JDAY ) * MS_PER_DAY ) );
    }
 
    std::ostream& operator<<(std::ostream& o, const CommonTime& ct)
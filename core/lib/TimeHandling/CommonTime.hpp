@@ -40,6 +40,9 @@
 #define GNSSTK_COMMONTIME_HPP
 
 #include "gnsstk_export.h"
+#include <cmath>
+#include <cstdint>
+#include <limits>
 #include <memory>
 #include "Exception.hpp"
 #include "TimeConstants.hpp"
@@ -64,13 +67,13 @@ namespace gnsstk
        *
        * The interface is based on three quantites: days, seconds of day, and
        * fractional seconds of day.  The internal representation, however, is
-       * slightly different.  It consists of a day, milliseconds of day, and
-       * fractional seconds of day.  Their valid ranges are shown below:
+       * slightly different.  It consists of the milliseconds since the
+       * start of day 0, held in a 64-bit integer, and fractional seconds
+       * of the millisecond.  Their valid ranges are shown below:
        *
        *  Quantity   >=     <
        *  --------   ---   ---
-       *   day        0    2^31
-       *   msod       0    86400000
+       *   msec       0    END_LIMIT_JDAY * 86400000
        *   fsod       0    0.001
        *
        * The above is somewhat difficult to grasp at first, but the
@@ -80,6 +83,17 @@ namespace gnsstk
        * partial milliseconds.  By keeping the value in seconds, we
        * save ourselves additional work and loss of precision through
        * conversion of fractional seconds to fractional milliseconds.
+       *
+       * Whole milliseconds are exact over the entire range of
+       * CommonTime, and as the fractional part never exceeds a
+       * millisecond its resolution is better than 1e-18 seconds,
+       * the same as when the day and milliseconds of day were held
+       * separately.  Keeping the milliseconds in a single integer
+       * means comparisons and differences only touch one integer
+       * and one double, so they, along with addSeconds(), are
+       * defined inline below.  CommonTime has no virtual functions,
+       * so it is trivially copyable and can be constructed as a
+       * constant expression.
        */
    class CommonTime
    {
@@ -91,11 +105,11 @@ namespace gnsstk
 
          /// 'julian day' of earliest epoch expressible by CommonTime:
          /// 1/1/4713 B.C.E.
-         /// @see m_day.
+         /// @see m_msec.
       GNSSTK_EXPORT static const long BEGIN_LIMIT_JDAY;
          /// 'julian day' of latest epoch expressible by CommonTime:
          /// 1/1/4713 C.E.
-         /// @see m_day.
+         /// @see m_msec.
       GNSSTK_EXPORT static const long END_LIMIT_JDAY;
 
          /// earliest representable CommonTime
@@ -117,25 +131,22 @@ namespace gnsstk
           * All numerical elements default to zero, "Unknown" for time frame.
           * @see CommonTime::set()
           */
-      explicit CommonTime(TimeSystem timeSystem = TimeSystem::Unknown )
-      { set( 0, 0, 0.0, timeSystem ); }
+      constexpr explicit CommonTime(TimeSystem timeSystem = TimeSystem::Unknown )
+            : m_msec(0), m_fsod(0.0), m_timeSystem(timeSystem)
+      {}
 
          /**
           * Copy Constructor.
           * @param right a const reference to the CommonTime object to copy.
           */
-      CommonTime( const CommonTime& right );
+      CommonTime( const CommonTime& right ) = default;
 
          /**
           * Assignment Operator.
           * @param right a const reference to the CommonTime object to copy.
           * @return a reference to this CommonTime object.
           */
-      CommonTime& operator=( const CommonTime& right );
-
-         /// Destructor.
-      virtual ~CommonTime()
-      {}
+      CommonTime& operator=( const CommonTime& right ) = default;
 
          //FUTURE DEPRECATION
          //ALL COMMONTIME ACCESSOR/MUTATOR METHODS ARE SET FOR FUTURE DEPRECATION (PRIVATIZATION)
@@ -276,7 +287,7 @@ namespace gnsstk
                         long& msod,
                         double& fsod,
                         TimeSystem& timeSystem ) const
-      { day = m_day; msod = m_msod; fsod = m_fsod; timeSystem = m_timeSystem; }
+      { getInternal(day, msod, fsod); timeSystem = m_timeSystem; }
 
          /**
           * Get internal values method.  Obtain the values stored within this
@@ -286,7 +297,17 @@ namespace gnsstk
       void getInternal( long& day,
                         long& msod,
                         double& fsod ) const
-      { day = m_day; msod = m_msod; fsod = m_fsod; }
+      {
+         day = static_cast<long>( m_msec / MS_PER_DAY );
+         msod = static_cast<long>( m_msec % MS_PER_DAY );
+         if ( msod < 0 )
+         {
+               // before day 0, keep the millisecond of day positive
+            msod += MS_PER_DAY;
+            --day;
+         }
+         fsod = m_fsod;
+      }
 
          /// Obtain the time, in days, including the fraction of a day.
           //METHOD SET FOR FUTURE DEPRECATION (PRIVATIZATION)
@@ -298,7 +319,8 @@ namespace gnsstk
 
          /// Obtain time system info (enum).
           //METHOD SET FOR FUTURE DEPRECATION (PRIVATIZATION)
-      TimeSystem getTimeSystem() const;
+      constexpr TimeSystem getTimeSystem() const
+      { return m_timeSystem; }
 
          //@}
 
@@ -311,7 +333,15 @@ namespace gnsstk
           * @param right CommonTime to subtract from this one
           * @return the difference in seconds
           */
-      double operator-( const CommonTime& right ) const;
+      double operator-( const CommonTime& right ) const
+      {
+         if (!sameTimeSystem(right))
+         {
+            throwTimeSystemMismatch(right, "differenced");
+         }
+         return static_cast<double>( m_msec - right.m_msec ) * SEC_PER_MS +
+            ( m_fsod - right.m_fsod );
+      }
 
          /**
           * Add seconds to a copy of this CommonTime.
@@ -319,7 +349,8 @@ namespace gnsstk
           * @return the new CommonTime object
           * @throw InvalidRequest on over-/under-flow
           */
-      CommonTime operator+( double seconds ) const;
+      CommonTime operator+( double seconds ) const
+      { return CommonTime( *this ).addSeconds( seconds ); }
 
          /**
           * Subtract seconds from a copy of this CommonTime.
@@ -328,7 +359,8 @@ namespace gnsstk
           * @return the new CommonTime object
           * @throw InvalidRequest on over-/under-flow
           */
-      CommonTime operator-( double seconds ) const;
+      CommonTime operator-( double seconds ) const
+      { return CommonTime( *this ).addSeconds( -seconds ); }
 
          /**
           * Add seconds to this CommonTime.
@@ -336,7 +368,8 @@ namespace gnsstk
           * @return a reference to this CommonTime
           * @throw InvalidRequest on over-/under-flow
           */
-      CommonTime& operator+=( double seconds );
+      CommonTime& operator+=( double seconds )
+      { return addSeconds( seconds ); }
 
          /**
           * Subtract seconds from this CommonTime.
@@ -344,7 +377,8 @@ namespace gnsstk
           * @return a reference to this CommonTime object
           * @throw InvalidRequest on over-/under-flow
           */
-      CommonTime& operator-=( double seconds );
+      CommonTime& operator-=( double seconds )
+      { return addSeconds( -seconds ); }
 
          /**
           * Add seconds to this CommonTime object.
@@ -353,7 +387,23 @@ namespace gnsstk
           * @return a reference to this CommonTime object
           * @throw InvalidRequest on over-/under-flow
           */
-      CommonTime& addSeconds( double seconds );
+      CommonTime& addSeconds( double seconds )
+      {
+         long days = 0;
+         int64_t ms = 0;
+         if ( std::fabs(seconds) >= SEC_PER_DAY )
+         {
+            days = static_cast<long>( seconds * DAY_PER_SEC );
+            seconds -= days * SEC_PER_DAY;
+         }
+         if ( std::fabs(seconds) >= SEC_PER_MS )
+         {
+            ms = static_cast<int64_t>( seconds * MS_PER_SEC );
+            seconds -= static_cast<double>( ms ) / MS_PER_SEC;
+         }
+         add( days, ms, seconds );
+         return *this;
+      }
 
          /**
           * Add integer days to this CommonTime object.
@@ -388,16 +438,34 @@ namespace gnsstk
           *  and false on failure.
           */
          //@{
-      bool operator==( const CommonTime& right ) const;
-      bool operator!=( const CommonTime& right ) const;
-      bool operator<( const CommonTime& right ) const;
-      bool operator>( const CommonTime& right ) const;
-      bool operator<=( const CommonTime& right ) const;
-      bool operator>=( const CommonTime& right ) const;
+      bool operator==( const CommonTime& right ) const
+      {
+         return (sameTimeSystem(right) &&
+                 m_msec == right.m_msec &&
+                 std::fabs(m_fsod - right.m_fsod) < eps);
+      }
+      bool operator!=( const CommonTime& right ) const
+      { return !operator==(right); }
+         /// @throw InvalidRequest if the time systems differ.
+      bool operator<( const CommonTime& right ) const
+      {
+         if (!sameTimeSystem(right))
+         {
+            throwTimeSystemMismatch(right, "compared");
+         }
+         return (m_msec < right.m_msec ||
+                 (m_msec == right.m_msec && m_fsod < right.m_fsod));
+      }
+      bool operator>( const CommonTime& right ) const
+      { return !operator<=(right); }
+      bool operator<=( const CommonTime& right ) const
+      { return (operator<(right) || operator==(right)); }
+      bool operator>=( const CommonTime& right ) const
+      { return !operator<(right); }
          //@}
 
       void reset()
-      { m_day = m_msod = 0; m_fsod = 0.0; m_timeSystem = TimeSystem::Unknown; }
+      { m_msec = 0; m_fsod = 0.0; m_timeSystem = TimeSystem::Unknown; }
 
       std::string asString() const;
 
@@ -421,21 +489,48 @@ namespace gnsstk
           * @return the result of calling the normalize() function
           */
       bool add( long days,
-                long msod,
-                double fsod );
+                int64_t msod,
+                double fsod )
+      {
+         m_msec += static_cast<int64_t>( days ) * MS_PER_DAY + msod;
+         m_fsod += fsod;
+            // only a carry, borrow or tiny fraction needs normalize()
+         if ( (m_fsod >= 1e-15 || m_fsod == 0.0) &&
+              m_fsod < SEC_PER_MS - std::numeric_limits<double>::epsilon() )
+         {
+            return ( m_msec >= 0 &&
+                     m_msec < static_cast<int64_t>( END_LIMIT_JDAY ) * MS_PER_DAY );
+         }
+         return normalize();
+      }
 
          /// Normalize the values.  This takes out of bounds values and rolls
          /// other values appropriately.
-         /// @return true if m_day is valid, false otherwise
+         /// @return true if the day is valid, false otherwise
       bool normalize();
 
-         /** Days since midnight -4713/01/01.  This is similar to, but
-          * not a true Julian Day as it starts at midnight instead of
-          * noon.  The time stamp is defined this way so as to avoid
-          * having to make half-day offsets every time we convert to
-          * or from CommonTime. */
-      long m_day;
-      long m_msod;    ///< milliseconds-of-day        0 <= val < 86400000
+         /// True if the time systems match or either is Any.
+      bool sameTimeSystem( const CommonTime& right ) const
+      {
+         return (m_timeSystem == right.m_timeSystem ||
+                 m_timeSystem == TimeSystem::Any ||
+                 right.m_timeSystem == TimeSystem::Any);
+      }
+
+         /** Throw InvalidRequest for objects in different time systems.
+          * Kept out of line so the inline operators stay small.
+          * @param[in] right the other CommonTime.
+          * @param[in] what the operation, e.g. "compared". */
+      void throwTimeSystemMismatch( const CommonTime& right,
+                                    const char *what ) const;
+
+         /** Milliseconds since midnight -4713/01/01, i.e. day *
+          * 86400000 + millisecond of day.  The days are similar to,
+          * but not true Julian Days as they start at midnight instead
+          * of noon.  The time stamp is defined this way so as to
+          * avoid having to make half-day offsets every time we
+          * convert to or from CommonTime. */
+      int64_t m_msec;
       double m_fsod;  ///< fractional seconds-of-day  0 <= val < 0.001
 
       TimeSystem m_timeSystem; ///< time frame (system representation) of the data
@@ -49,9 +49,14 @@ namespace gnsstk
    DebugTrace :: DebugTrace(const std::string funcName)
          : functionName(funcName)
    {
-      std::ostringstream os;
-      os << "+ " << functionName << std::endl;
-      trace(os.str());
+         // Don't format anything unless it's going to be printed,
+         // this is called on entry to many frequently used functions.
+      if (enabled)
+      {
+         std::ostringstream os;
+         os << "+ " << functionName << std::endl;
+         trace(os.str());
+      }
       indent += 3;
    }
 
@@ -59,9 +64,12 @@ namespace gnsstk
    DebugTrace :: ~DebugTrace()
    {
       indent -= 3;
-      std::ostringstream os;
-      os << "- " << functionName << std::endl;
-      trace(os.str());
+      if (enabled)
+      {
+         std::ostringstream os;
+         os << "- " << functionName << std::endl;
+         trace(os.str());
+      }
    }
 
 
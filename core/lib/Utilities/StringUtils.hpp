@@ -52,6 +52,7 @@
 #include <vector>
 #include <cstdio>   /// @todo Get rid of the stdio.h dependency if possible.
 #include <cctype>
+#include <cstring>
 #include <limits>
 
 #ifdef _WIN32
@@ -721,6 +722,29 @@ namespace gnsstk
       inline unsigned long asUnsigned(const std::string& s)
       { return strtoul(s.c_str(), 0, 10); }
 
+         /**
+          * Convert a fixed-width field to a double precision floating
+          * point number without copying it to a string.  The result
+          * is identical to asDouble(std::string(s,len)).  Plain
+          * fixed-point numbers of up to 15 digits, the usual case
+          * for formatted data files, are converted directly; anything
+          * else is passed to strtod.
+          * @param s first character of the field.
+          * @param len number of characters in the field.
+          * @return double representation of the field.
+          */
+      inline double asDouble(const char* s, std::string::size_type len);
+
+         /**
+          * Convert a fixed-width field to an integer without copying
+          * it to a string.  The result is identical to
+          * asInt(std::string(s,len)).
+          * @param s first character of the field.
+          * @param len number of characters in the field.
+          * @return long integer representation of the field.
+          */
+      inline long asInt(const char* s, std::string::size_type len);
+
          /**
           * Convert a string to a single precision floating point number.
           * @param s string containing a number.
@@ -1633,6 +1657,82 @@ namespace gnsstk
       }
 
 
+      inline double asDouble(const char* s, std::string::size_type len)
+      {
+         static const double pow10[] =
+            { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10,
+              1e11, 1e12, 1e13, 1e14, 1e15 };
+         const char *p = s, *end = s + len;
+         while ((p != end) && isspace(static_cast<unsigned char>(*p)))
+            p++;
+         bool neg = false;
+         if ((p != end) && ((*p == '-') || (*p == '+')))
+            neg = (*p++ == '-');
+         unsigned long long mant = 0;
+         int digits = 0, frac = 0;
+         bool point = false;
+         for (; p != end; p++)
+         {
+            if ((*p >= '0') && (*p <= '9'))
+            {
+               mant = mant * 10 + (*p - '0');
+               digits++;
+               if (point)
+                  frac++;
+            }
+            else if ((*p == '.') && !point)
+               point = true;
+            else
+               break;
+         }
+         bool special = ((p != end) &&
+                         ((*p == 'e') || (*p == 'E') || (*p == 'x') ||
+                          (*p == 'X') || (*p == 'i') || (*p == 'I') ||
+                          (*p == 'n') || (*p == 'N')));
+         if (!special)
+         {
+            if (digits == 0)
+               return 0.;
+               // Both the mantissa and the power of ten are exact,
+               // so the quotient is correctly rounded, as strtod is.
+            if (digits <= 15)
+            {
+               double rv = static_cast<double>(mant) / pow10[frac];
+               return neg ? -rv : rv;
+            }
+         }
+         char buf[64];
+         if (len < sizeof(buf))
+         {
+            std::memcpy(buf, s, len);
+            buf[len] = 0;
+            return strtod(buf, 0);
+         }
+         return asDouble(std::string(s, len));
+      }
+
+
+      inline long asInt(const char* s, std::string::size_type len)
+      {
+         const char *p = s, *end = s + len;
+         while ((p != end) && isspace(static_cast<unsigned char>(*p)))
+            p++;
+         bool neg = false;
+         if ((p != end) && ((*p == '-') || (*p == '+')))
+            neg = (*p++ == '-');
+         long rv = 0;
+         int digits = 0;
+         for (; (p != end) && (*p >= '0') && (*p <= '9'); p++, digits++)
+            rv = rv * 10 + (*p - '0');
+         if (digits > 18)
+         {
+               // let strtol handle overflow
+            return asInt(std::string(s, len));
+         }
+         return neg ? -rv : rv;
+      }
+
+
       inline float asFloat(const std::string& s)
       {
          try
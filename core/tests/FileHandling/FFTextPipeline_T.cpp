@@ -0,0 +1,602 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iterator>
+#include <vector>
+#include "CompactRinexDecoder.hpp"
+#include "FFTextStream.hpp"
+#include "Rinex3ObsStream.hpp"
+#include "Rinex3ObsData.hpp"
+#include "TestUtil.hpp"
+
+#ifdef GNSSTK_HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+using namespace std;
+using namespace gnsstk;
+
+   /// A RINEX 3 observation file with clock offsets, an event,
+   /// missing observations and satellites coming and going.
+static const char* const rinex3Lines[] =
+{
+   "     3.04           OBSERVATION DATA    M                   RINEX VERSION / TYPE",
+   "gnsstk              ARL:UT              20210101 000000 UTC PGM / RUN BY / DATE",
+   "TEST                                                        MARKER NAME",
+   "                                                            OBSERVER / AGENCY",
+   "                                                            REC # / TYPE / VERS",
+   "                                                            ANT # / TYPE",
+   "        0.0000        0.0000        0.0000                  APPROX POSITION XYZ",
+   "        0.0000        0.0000        0.0000                  ANTENNA: DELTA H/E/N",
+   "G    4 C1C L1C D1C S1C                                      SYS / # / OBS TYPES",
+   "E    3 C1X L1X S1X                                          SYS / # / OBS TYPES",
+   "  2021     1     1     0     0    0.0000000     GPS         TIME OF FIRST OBS",
+   "G L1C  0.00000                                              SYS / PHASE SHIFT",
+   "E L1X  0.00000                                              SYS / PHASE SHIFT",
+   "                                                            END OF HEADER",
+   "> 2021 01 01 00 00  0.0000000  0  3       0.000123456789",
+   "G01  21000000.125   110355000.250 7     -1234.567          45.000",
+   "G05  22000000.500   115610000.75016       876.500          40.250",
+   "E11  23000000.000   120866000.000 5        38.000",
+   "> 2021 01 01 00 00 30.0000000  0  3       0.000123457123",
+   "G01  21000030.250   110355157.875 7     -1234.000          45.000",
+   "G05  22000020.000   115610105.000 6       877.000          41.000",
+   "E11  22999990.000                          37.500",
+   "> 2021 01 01 00 01  0.0000000  4  1",
+   "event record                                                COMMENT",
+   "> 2021 01 01 00 01  0.0000000  0  3",
+   "G01  21000060.000   110355315.500 7        -0.125          45.500",
+   "G07  20000000.000   105100000.000 8       100.000          50.000",
+   "E11  22999980.000   120865900.00015        37.000",
+   "> 2021 01 01 00 01 30.0000000  0  2",
+   "G01  21000090.000   110355473.000 7        -0.500          46.000",
+   "G07  20000010.000   105100052.500 8        99.000",
+   "> 2021 01 01 00 02  0.0000000  0  2       0.000123458000",
+   "G01  21000120.000   110355630.500 7        -0.875          46.500",
+   "G05  22000100.000   115610525.000 6       878.000          42.000",
+};
+
+   /// rinex3Lines in Compact RINEX 3.
+static const char* const compact3Lines[] =
+{
+   "3.0                 COMPACT RINEX FORMAT                    CRINEX VERS   / TYPE",
+   "RNX2CRX ver.4.0.7                       01-Jan-21 00:00     CRINEX PROG / DATE",
+   "     3.04           OBSERVATION DATA    M                   RINEX VERSION / TYPE",
+   "gnsstk              ARL:UT              20210101 000000 UTC PGM / RUN BY / DATE",
+   "TEST                                                        MARKER NAME",
+   "                                                            OBSERVER / AGENCY",
+   "                                                            REC # / TYPE / VERS",
+   "                                                            ANT # / TYPE",
+   "        0.0000        0.0000        0.0000                  APPROX POSITION XYZ",
+   "        0.0000        0.0000        0.0000                  ANTENNA: DELTA H/E/N",
+   "G    4 C1C L1C D1C S1C                                      SYS / # / OBS TYPES",
+   "E    3 C1X L1X S1X                                          SYS / # / OBS TYPES",
+   "  2021     1     1     0     0    0.0000000     GPS         TIME OF FIRST OBS",
+   "G L1C  0.00000                                              SYS / PHASE SHIFT",
+   "E L1X  0.00000                                              SYS / PHASE SHIFT",
+   "                                                            END OF HEADER",
+   "> 2021 01 01 00 00  0.0000000  0  3      G01G05E11",
+   "2&123456789",
+   "3&21000000125 3&110355000250 3&-1234567 3&45000    7",
+   "3&22000000500 3&115610000750 3&876500 3&40250   16",
+   "3&23000000000 3&120866000000 3&38000    5",
+   "                   3",
+   "334",
+   "30125 157625 567 0",
+   "19500 104250 500 750   &",
+   "-10000  -500    &",
+   "> 2021 01 01 00 01  0.0000000  4  1",
+   "event record                                                COMMENT",
+   "> 2021 01 01 00 01  0.0000000  0  3      G01G07E11",
+   "",
+   "3&21000060000 3&110355315500 3&-125 3&45500    7",
+   "3&20000000000 3&105100000000 3&100000 3&50000    8",
+   "3&22999980000 3&120865900000 3&37000   15",
+   "                   3              2            &&&",
+   "",
+   "30000 157500 -375 500",
+   "10000 52500 -1000",
+   "                 2 &                          5",
+   "2&123458000",
+   "0 0 0 0",
+   "3&22000100000 3&115610525000 3&878000 3&42000    6",
+};
+
+   /// A RINEX 2 observation file with more than 12 satellites.
+static const char* const rinex2Lines[] =
+{
+   "     2.11           OBSERVATION DATA    G (GPS)             RINEX VERSION / TYPE",
+   "gnsstk              ARL:UT              20210101 000000 UTC PGM / RUN BY / DATE",
+   "TEST                                                        MARKER NAME",
+   "                                                            OBSERVER / AGENCY",
+   "                                                            REC # / TYPE / VERS",
+   "                                                            ANT # / TYPE",
+   "        0.0000        0.0000        0.0000                  APPROX POSITION XYZ",
+   "        0.0000        0.0000        0.0000                  ANTENNA: DELTA H/E/N",
+   "     6    C1    L1    L2    P2    D1    S1                  # / TYPES OF OBSERV",
+   "  2021     1     1     0     0    0.0000000     GPS         TIME OF FIRST OBS",
+   "                                                            END OF HEADER",
+   " 21  1  1  0  0  0.0000000  0 13G01G02G03G05G06G07G09G10G12G13G15G17-0.000012345",
+   "                                G19",
+   "  20000000.000   105000000.500 7  81000000.2501   21000000.000       -1000.000",
+   "        44.000",
+   "  20001000.125   105000001.500 7  81000001.2501   21000001.000        -999.000",
+   "        45.000",
+   "  20002000.250   105000002.500 7  81000002.2501   21000002.000        -998.000",
+   "        46.000",
+   "  20003000.375   105000003.500 7  81000003.2501   21000003.000        -997.000",
+   "        47.000",
+   "  20004000.500   105000004.500 7  81000004.2501   21000004.000        -996.000",
+   "        48.000",
+   "  20005000.625   105000005.500 7  81000005.2501   21000005.000        -995.000",
+   "        49.000",
+   "  20006000.750   105000006.500 7  81000006.2501   21000006.000        -994.000",
+   "        50.000",
+   "  20007000.875   105000007.500 7  81000007.2501   21000007.000        -993.000",
+   "        51.000",
+   "  20008001.000   105000008.500 7  81000008.2501   21000008.000        -992.000",
+   "        52.000",
+   "  20009001.125   105000009.500 7  81000009.2501   21000009.000        -991.000",
+   "        53.000",
+   "  20010001.250   105000010.500 7  81000010.2501   21000010.000        -990.000",
+   "        54.000",
+   "  20011001.375   105000011.500 7  81000011.2501   21000011.000        -989.000",
+   "        55.000",
+   "  20012001.500   105000012.500 7  81000012.2501   21000012.000        -988.000",
+   "        56.000",
+   " 21  1  1  0  0 30.0000000  0  3G01G02G03                           -0.000012346",
+   "  20000030.000   105000157.500 7                  21000030.000       -1001.000",
+   "        44.000",
+   "  20001030.125   105000158.500 7                  21000031.000       -1000.000",
+   "        45.000",
+   "  20002030.250   105000159.500 7                  21000032.000        -999.000",
+   "        46.000",
+   " 21  1  1  0  1  0.0000000  0  3G01G03G32",
+   "  20000060.000   105000315.500 7  81000100.000    21000060.000       -1002.000",
+   "        45.000",
+   "  20001060.125   105000316.500 7  81000101.000    21000061.000       -1001.000",
+   "        46.000",
+   "  20002060.250   105000317.500 7  81000102.000    21000062.000       -1000.000",
+   "        47.000",
+};
+
+   /// rinex2Lines in Compact RINEX 1.
+static const char* const compact1Lines[] =
+{
+   "1.0                 COMPACT RINEX FORMAT                    CRINEX VERS   / TYPE",
+   "RNX2CRX ver.4.0.7                       01-Jan-21 00:00     CRINEX PROG / DATE",
+   "     2.11           OBSERVATION DATA    G (GPS)             RINEX VERSION / TYPE",
+   "gnsstk              ARL:UT              20210101 000000 UTC PGM / RUN BY / DATE",
+   "TEST                                                        MARKER NAME",
+   "                                                            OBSERVER / AGENCY",
+   "                                                            REC # / TYPE / VERS",
+   "                                                            ANT # / TYPE",
+   "        0.0000        0.0000        0.0000                  APPROX POSITION XYZ",
+   "        0.0000        0.0000        0.0000                  ANTENNA: DELTA H/E/N",
+   "     6    C1    L1    L2    P2    D1    S1                  # / TYPES OF OBSERV",
+   "  2021     1     1     0     0    0.0000000     GPS         TIME OF FIRST OBS",
+   "                                                            END OF HEADER",
+   "&21  1  1  0  0  0.0000000  0 13G01G02G03G05G06G07G09G10G12G13G15G17G19",
+   "2&-12345",
+   "3&20000000000 3&105000000500 3&81000000250 3&21000000000 3&-1000000 3&44000    71",
+   "3&20001000125 3&105000001500 3&81000001250 3&21000001000 3&-999000 3&45000    71",
+   "3&20002000250 3&105000002500 3&81000002250 3&21000002000 3&-998000 3&46000    71",
+   "3&20003000375 3&105000003500 3&81000003250 3&21000003000 3&-997000 3&47000    71",
+   "3&20004000500 3&105000004500 3&81000004250 3&21000004000 3&-996000 3&48000    71",
+   "3&20005000625 3&105000005500 3&81000005250 3&21000005000 3&-995000 3&49000    71",
+   "3&20006000750 3&105000006500 3&81000006250 3&21000006000 3&-994000 3&50000    71",
+   "3&20007000875 3&105000007500 3&81000007250 3&21000007000 3&-993000 3&51000    71",
+   "3&20008001000 3&105000008500 3&81000008250 3&21000008000 3&-992000 3&52000    71",
+   "3&20009001125 3&105000009500 3&81000009250 3&21000009000 3&-991000 3&53000    71",
+   "3&20010001250 3&105000010500 3&81000010250 3&21000010000 3&-990000 3&54000    71",
+   "3&20011001375 3&105000011500 3&81000011250 3&21000011000 3&-989000 3&55000    71",
+   "3&20012001500 3&105000012500 3&81000012250 3&21000012000 3&-988000 3&56000    71",
+   "                3             &          &&&&&&&&&&&&&&&&&&&&&&&&&&&&&&",
+   "-1",
+   "30000 157000  30000 -1000 0     &",
+   "30000 157000  30000 -1000 0     &",
+   "30000 157000  30000 -1000 0     &",
+   "              1 &                    3 32",
+   "",
+   "0 1000 3&81000100000 0 0 1000",
+   "-1000125 0 3&81000101000 -1000 -1000 0",
+   "3&20002060250 3&105000317500 3&81000102000 3&21000062000 3&-1000000 3&47000    7",
+};
+
+   /// Number of elements in a C array.
+#define COUNT(a) (sizeof(a) / sizeof(a[0]))
+
+class FFTextPipeline_T
+{
+public:
+   FFTextPipeline_T();
+
+      /// Make sure Compact RINEX 1 and 3 decode to the original RINEX.
+   unsigned compactTest();
+      /// Make sure Rinex3ObsStream reads the same data from Compact RINEX.
+   unsigned obsDataTest();
+      /// Make sure gzip files are decompressed, and seeking works.
+   unsigned gzipTest();
+      /// Make sure invalid Compact RINEX is reported.
+   unsigned errorTest();
+
+      /// Write lines to fn, optionally gzip-compressed.
+   static void writeLines(const string& fn, const char* const lines[],
+                          size_t count, bool gzip = false);
+      /** Read fn as text and compare to lines.
+       * @return true if fn was decoded. */
+   static bool checkLines(TestUtil& testFramework, const string& fn,
+                          const char* const lines[], size_t count);
+      /// Read fn and expFn as RINEX obs and compare the records.
+   static void checkObs(TestUtil& testFramework, const string& fn,
+                        const string& expFn);
+
+      /// Base name of the temporary test files.
+   string tmpBase;
+};
+
+
+FFTextPipeline_T ::
+FFTextPipeline_T()
+      : tmpBase(getPathTestTemp() + getFileSep() + "test_output_FFTextPipeline")
+{
+   writeLines(tmpBase + ".rnx", rinex3Lines, COUNT(rinex3Lines));
+   writeLines(tmpBase + ".crx", compact3Lines, COUNT(compact3Lines));
+   writeLines(tmpBase + ".11o", rinex2Lines, COUNT(rinex2Lines));
+   writeLines(tmpBase + ".11d", compact1Lines, COUNT(compact1Lines));
+}
+
+
+void FFTextPipeline_T ::
+writeLines(const string& fn, const char* const lines[], size_t count,
+           bool gzip)
+{
+   string text;
+   for (size_t i = 0; i < count; i++)
+   {
+      text += lines[i];
+      text += '\n';
+   }
+#ifdef GNSSTK_HAVE_ZLIB
+   if (gzip)
+   {
+      gzFile gz = gzopen(fn.c_str(), "wb");
+      gzwrite(gz, text.data(), text.size());
+      gzclose(gz);
+      return;
+   }
+#endif
+   ofstream out(fn.c_str(), ios::out | ios::binary);
+   out << text;
+}
+
+
+bool FFTextPipeline_T ::
+checkLines(TestUtil& testFramework, const string& fn,
+           const char* const lines[], size_t count)
+{
+   FFTextStream strm(fn.c_str(), ios::in);
+   string line;
+   for (size_t i = 0; i < count; i++)
+   {
+      TUCATCH(strm.formattedGetLine(line));
+      TUASSERTE(string, string(lines[i]), line);
+   }
+   TUTHROW(strm.formattedGetLine(line, true));
+   TUASSERTE(bool, true, strm.eof());
+   return strm.isDecoded();
+}
+
+
+void FFTextPipeline_T ::
+checkObs(TestUtil& testFramework, const string& fn, const string& expFn)
+{
+   Rinex3ObsStream strm(fn), expStrm(expFn);
+   Rinex3ObsData rod, expRod;
+   unsigned records = 0;
+   TUASSERT(static_cast<bool>(strm >> strm.header));
+   TUASSERT(static_cast<bool>(expStrm >> expStrm.header));
+   TUASSERTFE(expStrm.header.version, strm.header.version);
+   while (expStrm >> expRod)
+   {
+      TUASSERT(static_cast<bool>(strm >> rod));
+      TUASSERTE(CommonTime, expRod.time, rod.time);
+      TUASSERTE(short, expRod.epochFlag, rod.epochFlag);
+      TUASSERTFE(expRod.clockOffset, rod.clockOffset);
+      TUASSERTE(size_t, expRod.obs.size(), rod.obs.size());
+      TUASSERTE(size_t, expRod.auxHeader.commentList.size(),
+                rod.auxHeader.commentList.size());
+      for (const auto& sati : expRod.obs)
+      {
+         auto roi = rod.obs.find(sati.first);
+         TUASSERT(roi != rod.obs.end());
+         if ((roi == rod.obs.end()) ||
+             (roi->second.size() != sati.second.size()))
+         {
+            continue;
+         }
+         for (unsigned i = 0; i < sati.second.size(); i++)
+         {
+            TUASSERTFE(sati.second[i].data, roi->second[i].data);
+            TUASSERTE(bool, sati.second[i].dataBlank,
+                      roi->second[i].dataBlank);
+            TUASSERTE(short, sati.second[i].lli, roi->second[i].lli);
+            TUASSERTE(short, sati.second[i].ssi, roi->second[i].ssi);
+         }
+      }
+      records++;
+   }
+   TUASSERT(!(strm >> rod));
+   TUASSERT(records > 0);
+}
+
+
+unsigned FFTextPipeline_T ::
+compactTest()
+{
+   TUDEF("CompactRinexDecoder", "decodeLine");
+   TUASSERTE(bool, true, checkLines(testFramework, tmpBase + ".crx",
+                                    rinex3Lines, COUNT(rinex3Lines)));
+   TUASSERTE(bool, true, checkLines(testFramework, tmpBase + ".11d",
+                                    rinex2Lines, COUNT(rinex2Lines)));
+      // plain text is left alone
+   TUASSERTE(bool, false, checkLines(testFramework, tmpBase + ".rnx",
+                                     rinex3Lines, COUNT(rinex3Lines)));
+      // the decoder on its own
+   CompactRinexDecoder decoder;
+   string text, expText;
+   for (size_t i = 0; i < COUNT(compact3Lines); i++)
+   {
+      TUCATCH(decoder.decodeLine(compact3Lines[i],
+                                 strlen(compact3Lines[i]), text));
+   }
+   for (size_t i = 0; i < COUNT(rinex3Lines); i++)
+      expText += string(rinex3Lines[i]) + "\n";
+   TUASSERTE(int, 3, decoder.getVersion());
+   TUASSERTE(string, expText, text);
+   TURETURN();
+}
+
+
+unsigned FFTextPipeline_T ::
+obsDataTest()
+{
+   TUDEF("Rinex3ObsStream", "operator>>");
+   checkObs(testFramework, tmpBase + ".crx", tmpBase + ".rnx");
+   checkObs(testFramework, tmpBase + ".11d", tmpBase + ".11o");
+      // Rinex3ObsData is parsed on this thread while decoding
+      // continues on others, so try a file spanning many chunks.
+   string bigRinex = tmpBase + ".big.rnx", bigCompact = tmpBase + ".big.crx";
+   {
+      ofstream rnx(bigRinex.c_str()), crx(bigCompact.c_str());
+      for (size_t i = 0; i < COUNT(rinex3Lines); i++)
+      {
+         rnx << rinex3Lines[i] << "\n";
+         if (string(rinex3Lines[i]).find("END OF HEADER") != string::npos)
+            break;
+      }
+      for (size_t i = 0; i < COUNT(compact3Lines); i++)
+      {
+         crx << compact3Lines[i] << "\n";
+         if (string(compact3Lines[i]).find("END OF HEADER") != string::npos)
+            break;
+      }
+         // A run of epochs with slowly changing observations.
+      crx << "> 2021 01 01 00 00  0.0000000  0  1      G01" << "\n\n"
+          << "3&21000000000 3&110355000000 3&-1234000 3&45000" << "\n";
+      for (unsigned i = 0; i < 20000; i++)
+      {
+         double sec = i % 60;
+         unsigned min = (i / 60) % 60, hour = i / 3600;
+         rnx << "> 2021 01 01 " << setfill('0') << setw(2) << hour << " "
+             << setw(2) << min << " " << setfill(' ') << setw(10)
+             << fixed << setprecision(7) << sec << "  0  1" << "\n"
+             << "G01" << setw(14) << setprecision(3)
+             << (21000000.0 + 0.001 * i * i) << "  " << setw(14)
+             << (110355000.0 + 0.005 * i * i) << "  " << setw(14)
+             << (-1234.0 + 0.001 * i) << "  " << setw(14) << 45.0 << "\n";
+         if (i == 0)
+            continue;
+            // Epoch line differences: only the changed characters.
+         char prev[40], cur[40];
+         unsigned pi = i - 1;
+         snprintf(prev, sizeof(prev), "%02u %02u %2u", pi / 3600,
+                  (pi / 60) % 60, pi % 60);
+         snprintf(cur, sizeof(cur), "%02u %02u %2u", hour, min, i % 60);
+         string diff(21, ' ');
+         for (unsigned j = 0; j < 8; j++)
+         {
+            if (cur[j] != prev[j])
+               diff[j + 13] = (cur[j] == ' ' ? '&' : cur[j]);
+         }
+         while (!diff.empty() && diff.back() == ' ')
+            diff.pop_back();
+         crx << diff << "\n\n";
+            // third order differences of a quadratic are zero
+         if (i == 1)
+            crx << "1 5 1 0\n";
+         else if (i == 2)
+            crx << "2 10 0 0\n";
+         else
+            crx << "0 0 0 0\n";
+      }
+   }
+   checkObs(testFramework, bigCompact, bigRinex);
+   TURETURN();
+}
+
+
+unsigned FFTextPipeline_T ::
+gzipTest()
+{
+   TUDEF("FFTextPipeline", "read");
+#ifdef GNSSTK_HAVE_ZLIB
+   string gzCompact = tmpBase + ".crx.gz", gzRinex = tmpBase + ".11o.gz";
+   writeLines(gzCompact, compact3Lines, COUNT(compact3Lines), true);
+   writeLines(gzRinex, rinex2Lines, COUNT(rinex2Lines), true);
+   TUASSERTE(bool, true, checkLines(testFramework, gzCompact,
+                                    rinex3Lines, COUNT(rinex3Lines)));
+   TUASSERTE(bool, true, checkLines(testFramework, gzRinex,
+                                    rinex2Lines, COUNT(rinex2Lines)));
+   checkObs(testFramework, gzCompact, tmpBase + ".rnx");
+   checkObs(testFramework, gzRinex, tmpBase + ".11o");
+
+      // Seeking back past the current block restarts the decoding.
+   TUCSM("seekg");
+   string gzLong = tmpBase + ".long.gz";
+   vector<string> longLines;
+   for (unsigned i = 0; i < 100000; i++)
+      longLines.push_back("line " + StringUtils::asString(i));
+   {
+      vector<const char*> ptrs;
+      for (const auto& line : longLines)
+         ptrs.push_back(line.c_str());
+      writeLines(gzLong, ptrs.data(), ptrs.size(), true);
+   }
+   FFTextStream strm(gzLong.c_str(), ios::in);
+   TUASSERTE(bool, true, strm.isDecoded());
+   string line;
+   strm.formattedGetLine(line);
+   streampos pos = strm.tellg();
+   for (unsigned i = 1; i < 90000; i++)
+      strm.formattedGetLine(line);
+   TUASSERTE(string, longLines[89999], line);
+   streampos pos2 = strm.tellg();
+   strm.seekg(pos);
+   strm.formattedGetLine(line);
+   TUASSERTE(string, longLines[1], line);
+   strm.seekg(pos2);
+   strm.formattedGetLine(line);
+   TUASSERTE(string, longLines[90000], line);
+      // there's no end to seek from
+   strm.seekg(0, ios::end);
+   TUASSERTE(bool, true, strm.fail());
+
+      // A truncated file is an error, not an early end of file.
+   TUCSM("read");
+   string gzTrunc = tmpBase + ".trunc.gz";
+   {
+      ifstream in(gzLong.c_str(), ios::in | ios::binary);
+      string data((istreambuf_iterator<char>(in)),
+                  istreambuf_iterator<char>());
+      ofstream out(gzTrunc.c_str(), ios::out | ios::binary);
+      out.write(data.data(), data.size() / 2);
+   }
+   FFTextStream trunc(gzTrunc.c_str(), ios::in);
+   bool gotError = false;
+   try
+   {
+      while (true)
+         trunc.formattedGetLine(line, true);
+   }
+   catch (EndOfFile& e)
+   {
+   }
+   catch (FFStreamError& e)
+   {
+      gotError = true;
+   }
+   TUASSERTE(bool, true, gotError);
+#else
+   cout << "gzip tests skipped, built without zlib" << endl;
+#endif
+   TURETURN();
+}
+
+
+unsigned FFTextPipeline_T ::
+errorTest()
+{
+   TUDEF("CompactRinexDecoder", "decodeLine");
+   CompactRinexDecoder decoder;
+   string text;
+   TUTHROW(decoder.decodeLine(rinex3Lines[0], strlen(rinex3Lines[0]), text));
+      // differences without initial values
+   vector<const char*> lines(compact3Lines,
+                             compact3Lines + COUNT(compact3Lines));
+   size_t dataLine = 0;
+   while (string(lines[dataLine]).find("END OF HEADER") == string::npos)
+      dataLine++;
+   dataLine += 3;
+   lines[dataLine] = "100 200 300 400";
+   string fn = tmpBase + ".bad.crx";
+   writeLines(fn, lines.data(), lines.size());
+   FFTextStream strm(fn.c_str(), ios::in);
+   string line;
+      // The lines before the error are still available.
+   for (size_t i = 0; i < COUNT(rinex3Lines); i++)
+   {
+      if (string(rinex3Lines[i]).find("END OF HEADER") != string::npos)
+         break;
+      strm.formattedGetLine(line);
+   }
+   bool gotError = false;
+   try
+   {
+      while (true)
+         strm.formattedGetLine(line, true);
+   }
+   catch (EndOfFile& e)
+   {
+   }
+   catch (FFStreamError& e)
+   {
+      gotError = true;
+   }
+   TUASSERTE(bool, true, gotError);
+   TURETURN();
+}
+
+
+int main()
+{
+   unsigned errorTotal = 0;
+   FFTextPipeline_T testClass;
+
+   errorTotal += testClass.compactTest();
+   errorTotal += testClass.obsDataTest();
+   errorTotal += testClass.gzipTest();
+   errorTotal += testClass.errorTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+   return errorTotal;
+}
@@ -0,0 +1,332 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+#include <fstream>
+#include <vector>
+#include "FFTextStream.hpp"
+#include "TestUtil.hpp"
+
+using namespace std;
+using namespace gnsstk;
+
+class FFTextStream_T
+{
+public:
+   FFTextStream_T();
+
+      /** Read the test file with each backend and make sure the
+       * lines, line numbers and EOF handling are the same. */
+   unsigned readTest();
+      /// Make sure tellg/seekg and switching backends work.
+   unsigned seekTest();
+      /// Make sure lines longer than a block are returned intact.
+   unsigned longLineTest();
+      /** Make sure closing through a base class reference releases
+       * the FFTextBuffer. */
+   unsigned closeTest();
+
+      /// Read all of fn using a given backend.
+   void readAll(TestUtil& testFramework, FFTextStream::ReadBackend rb,
+                vector<string>& lines, unsigned& lineNumber);
+
+      /// Temporary test file.
+   string textFile;
+      /// The lines written to textFile.
+   vector<string> expLines;
+};
+
+
+FFTextStream_T ::
+FFTextStream_T()
+      : textFile(getPathTestTemp() + getFileSep() +
+                 "test_output_FFTextStream.txt")
+{
+   expLines.push_back("first line");
+   expLines.push_back("");
+   expLines.push_back("     3.04           OBSERVATION DATA");
+   expLines.push_back("windows line");
+   expLines.push_back("last line without newline");
+   ofstream out(textFile.c_str(), ios::out | ios::binary);
+   out << expLines[0] << "\n" << expLines[1] << "\n" << expLines[2] << "\n"
+       << expLines[3] << "\r\n" << expLines[4];
+}
+
+
+void FFTextStream_T ::
+readAll(TestUtil& testFramework, FFTextStream::ReadBackend rb,
+        vector<string>& lines, unsigned& lineNumber)
+{
+   FFTextStream strm(textFile.c_str(), ios::in);
+   TUASSERTE(bool, true, strm.setReadBackend(rb));
+   lines.clear();
+   while (true)
+   {
+      string line;
+      try
+      {
+         strm.formattedGetLine(line, true);
+      }
+      catch (EndOfFile& e)
+      {
+         break;
+      }
+      lines.push_back(line);
+   }
+   lineNumber = strm.lineNumber;
+      // EOF that isn't expected is an error
+   strm.clear();
+   string line;
+   TUTHROW(strm.formattedGetLine(line, false));
+}
+
+
+unsigned FFTextStream_T ::
+readTest()
+{
+   TUDEF("FFTextStream", "formattedGetLine");
+   FFTextStream::ReadBackend backends[] =
+      {
+         FFTextStream::ReadBackend::Stream,
+         FFTextStream::ReadBackend::Block,
+         FFTextStream::ReadBackend::Mapped
+      };
+   for (FFTextStream::ReadBackend rb : backends)
+   {
+      vector<string> lines;
+      unsigned lineNumber = 0;
+      readAll(testFramework, rb, lines, lineNumber);
+      TUASSERTE(size_t, expLines.size(), lines.size());
+      for (unsigned i = 0; i < expLines.size() && i < lines.size(); i++)
+         TUASSERTE(string, expLines[i], lines[i]);
+         // The failed read at EOF counts as a line, as it always has.
+      TUASSERTE(unsigned, expLines.size() + 1, lineNumber);
+   }
+      // line views
+   TUCSM("formattedGetLine(const char*&)");
+   for (FFTextStream::ReadBackend rb : backends)
+   {
+      FFTextStream strm(textFile.c_str(), ios::in);
+      strm.setReadBackend(rb);
+      for (const auto& exp : expLines)
+      {
+         const char *line = nullptr;
+         std::string::size_type len = 0;
+         TUCATCH(strm.formattedGetLine(line, len));
+         TUASSERTE(string, exp, string(line, len));
+      }
+      const char *line = nullptr;
+      std::string::size_type len = 0;
+      TUTHROW(strm.formattedGetLine(line, len, true));
+      TUASSERTE(bool, true, strm.eof());
+   }
+      // exceptions enabled on the stream
+   TUCSM("formattedGetLine (exceptions)");
+   for (FFTextStream::ReadBackend rb : backends)
+   {
+      FFTextStream strm(textFile.c_str(), ios::in);
+      strm.setReadBackend(rb);
+      strm.exceptions(fstream::failbit);
+      string line;
+      for (unsigned i = 0; i < expLines.size(); i++)
+         strm.formattedGetLine(line);
+      TUASSERTE(string, expLines.back(), line);
+      bool gotEOF = false;
+      try
+      {
+         string lastLine;
+         strm.formattedGetLine(lastLine, true);
+      }
+      catch (EndOfFile& e)
+      {
+         gotEOF = true;
+      }
+      TUASSERTE(bool, true, gotEOF);
+   }
+      // writing is never redirected
+   TUCSM("setReadBackend");
+   {
+      string outFile = textFile + ".out";
+      FFTextStream strm(outFile.c_str(), ios::out);
+      TUASSERTE(bool, false,
+                strm.setReadBackend(FFTextStream::ReadBackend::Mapped));
+      strm << "written" << endl;
+      strm.close();
+      FFTextStream in(outFile.c_str(), ios::in);
+      TUASSERTE(bool, true,
+                in.setReadBackend(FFTextStream::ReadBackend::Mapped));
+      string line;
+      in.formattedGetLine(line);
+      TUASSERTE(string, "written", line);
+   }
+   TURETURN();
+}
+
+
+unsigned FFTextStream_T ::
+seekTest()
+{
+   TUDEF("FFTextStream", "seekg");
+   FFTextStream::ReadBackend backends[] =
+      {
+         FFTextStream::ReadBackend::Block,
+         FFTextStream::ReadBackend::Mapped
+      };
+   for (FFTextStream::ReadBackend rb : backends)
+   {
+      FFTextStream strm(textFile.c_str(), ios::in);
+      string line;
+      strm.formattedGetLine(line);
+         // switch after reading has started
+      TUASSERTE(bool, true, strm.setReadBackend(rb));
+      streampos pos = strm.tellg();
+      TUASSERTE(long, expLines[0].length() + 1, (long)pos);
+      strm.formattedGetLine(line);
+      strm.formattedGetLine(line);
+      TUASSERTE(string, expLines[2], line);
+      strm.seekg(pos);
+      strm.formattedGetLine(line);
+      strm.formattedGetLine(line);
+      TUASSERTE(string, expLines[2], line);
+         // istream functions read from the same buffer
+      TUASSERTE(char, 'w', (char)strm.peek());
+      strm.seekg(-4, ios::end);
+      std::getline(strm, line);
+      TUASSERTE(string, "line", line);
+      strm.clear();
+         // and back to std::filebuf
+      strm.seekg(pos);
+      TUASSERTE(bool, true,
+                strm.setReadBackend(FFTextStream::ReadBackend::Stream));
+      strm.formattedGetLine(line);
+      TUASSERTE(string, expLines[1], line);
+      strm.formattedGetLine(line);
+      TUASSERTE(string, expLines[2], line);
+   }
+   TURETURN();
+}
+
+
+unsigned FFTextStream_T ::
+longLineTest()
+{
+   TUDEF("FFTextStream", "formattedGetLine");
+   string fn = textFile + ".long";
+   vector<string> exp;
+   exp.push_back(string(FFTextBuffer::blockSize - 3, 'a'));
+   exp.push_back(string(FFTextBuffer::blockSize * 2 + 5, 'b'));
+   exp.push_back("c");
+   {
+      ofstream out(fn.c_str());
+      for (const auto& line : exp)
+         out << line << "\n";
+   }
+   FFTextStream::ReadBackend backends[] =
+      {
+         FFTextStream::ReadBackend::Block,
+         FFTextStream::ReadBackend::Mapped
+      };
+   for (FFTextStream::ReadBackend rb : backends)
+   {
+      FFTextStream strm(fn.c_str(), ios::in);
+      TUASSERTE(bool, true, strm.setReadBackend(rb));
+      for (const auto& line : exp)
+      {
+         const char *buf = nullptr;
+         std::string::size_type len = 0;
+         strm.formattedGetLine(buf, len);
+         TUASSERTE(std::string::size_type, line.length(), len);
+         TUASSERT(string(buf, len) == line);
+      }
+      TUASSERTE(unsigned, 3, strm.lineNumber);
+   }
+   TURETURN();
+}
+
+
+unsigned FFTextStream_T ::
+closeTest()
+{
+   TUDEF("FFTextStream", "close");
+   FFTextStream::ReadBackend backends[] =
+      {
+         FFTextStream::ReadBackend::Block,
+         FFTextStream::ReadBackend::Mapped
+      };
+   for (FFTextStream::ReadBackend rb : backends)
+   {
+      FFTextStream strm(textFile.c_str(), ios::in);
+      TUASSERTE(bool, true, strm.setReadBackend(rb));
+      string line;
+      strm.formattedGetLine(line);
+      TUASSERTE(string, expLines[0], line);
+      FFTextBuffer *buf = dynamic_cast<FFTextBuffer*>(
+         static_cast<std::istream&>(strm).rdbuf());
+      TUASSERT(buf != nullptr);
+      TUASSERTE(bool, true, buf->isOpen());
+         // std::fstream::close() isn't virtual
+      std::fstream& base(strm);
+      base.close();
+      TUASSERTE(bool, false, strm.is_open());
+         // nothing more is read from the old file
+      TUTHROW(strm.formattedGetLine(line));
+      TUASSERTE(bool, false, buf->isOpen());
+      strm.clear();
+      TUASSERTE(int, char_traits<char>::eof(), strm.peek());
+         // and reopening starts again with a new buffer
+      strm.open(textFile.c_str(), ios::in);
+      TUASSERTE(bool, true, strm.setReadBackend(rb));
+      TUCATCH(strm.formattedGetLine(line));
+      TUASSERTE(string, expLines[0], line);
+   }
+   TURETURN();
+}
+
+
+int main()
+{
+   unsigned errorTotal = 0;
+   FFTextStream_T testClass;
+
+   errorTotal += testClass.readTest();
+   errorTotal += testClass.seekTest();
+   errorTotal += testClass.longLineTest();
+   errorTotal += testClass.closeTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+   return errorTotal;
+}
@@ -0,0 +1,491 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+
+#include <cmath>
+#include <vector>
+#include "IonexStore.hpp"
+#include "IonexStream.hpp"
+#include "CivilTime.hpp"
+#include "TestUtil.hpp"
+
+using namespace std;
+using namespace gnsstk;
+
+namespace gnsstk
+{
+   std::ostream& operator<<(std::ostream& s, gnsstk::IonexStoreStrategy e)
+   {
+      s << StringUtils::asString(e);
+      return s;
+   }
+}
+
+
+   /// The interpolation strategies to test, i.e. not Unknown
+static const IonexStoreStrategy strategies[] =
+{
+   IonexStoreStrategy::Nearest,
+   IonexStoreStrategy::Rotated,
+   IonexStoreStrategy::Consecutive,
+   IonexStoreStrategy::ConsRot
+};
+
+
+class IonexStore_T
+{
+public:
+   IonexStore_T();
+      /// Compare the grid with the maps for all the strategies
+   unsigned gridTest();
+      /// Compare getIonexValues() with getIonexValue()
+   unsigned valuesTest();
+      /// Check the maps are used when they don't fit a grid
+   unsigned fallbackTest();
+      /// Check the errors are the same with and without the grid
+   unsigned errorTest();
+      /// Compare the grid with the maps at the last epoch of a file
+   unsigned lastEpochTest();
+
+      /// Make a global 2.5 x 5 degree map at time t
+   IonexData makeMap(const CommonTime& t, const IonexData::IonexValType& type,
+                     double scale) const;
+      /// Add nmaps hourly TEC and RMS maps starting at t0 to store
+   void addMaps(IonexStore& store, int nmaps) const;
+      /// Return true if the two stores give the same values
+   bool sameValues(const IonexStore& maps, const IonexStore& grid,
+                   IonexStoreStrategy strategy, const CommonTime& t,
+                   const Position& pos) const;
+
+   CommonTime t0;
+      /// Ionospheric pierce points at 450 km
+   vector<Position> ipps;
+};
+
+
+IonexStore_T ::
+IonexStore_T()
+      : t0(CivilTime(2020,3,14,0,0,0.0,TimeSystem::UTC))
+{
+   double radius = 6371000.0 + 450000.0;
+   for (int i = 0; i < 40; i++)
+   {
+      double lat = 86.0 * ::sin(0.7 * i + 0.3);
+      double lon = ::fmod(37.3 * i + 2.3, 360.0);
+      ipps.push_back(Position(lat, lon, radius, Position::Geocentric));
+   }
+      // grid points and the edges of the grid
+   ipps.push_back(Position(87.5, 180.0, radius, Position::Geocentric));
+   ipps.push_back(Position(-85.0, 0.0, radius, Position::Geocentric));
+   ipps.push_back(Position(42.5, 355.0, radius, Position::Geocentric));
+}
+
+
+IonexData IonexStore_T ::
+makeMap(const CommonTime& t, const IonexData::IonexValType& type,
+        double scale) const
+{
+   IonexData iod;
+   iod.time = t;
+   iod.type = type;
+   iod.exponent = -1;
+   iod.lat[0] = 87.5;
+   iod.lat[1] = -87.5;
+   iod.lat[2] = -2.5;
+   iod.lon[0] = -180.0;
+   iod.lon[1] = 180.0;
+   iod.lon[2] = 5.0;
+   iod.hgt[0] = 450.0;
+   iod.hgt[1] = 450.0;
+   iod.hgt[2] = 0.0;
+   iod.dim[0] = 71;
+   iod.dim[1] = 73;
+   iod.dim[2] = 1;
+   iod.data.resize(iod.dim[0] * iod.dim[1]);
+   for (int i = 0; i < iod.dim[0]; i++)
+   {
+      for (int j = 0; j < iod.dim[1]; j++)
+      {
+         iod.data[j + i*iod.dim[1]] = scale *
+            (20.0 + 15.0 * ::cos(0.05 * i) * ::sin(0.09 * j + scale));
+      }
+   }
+   iod.valid = true;
+   return iod;
+}
+
+
+void IonexStore_T ::
+addMaps(IonexStore& store, int nmaps) const
+{
+   for (int k = 0; k < nmaps; k++)
+   {
+      CommonTime t(t0 + 3600.0 * k);
+      store.addMap(makeMap(t, IonexData::TEC, 1.0 + 0.1 * k));
+      store.addMap(makeMap(t, IonexData::RMS, 0.2 + 0.01 * k));
+   }
+}
+
+
+bool IonexStore_T ::
+sameValues(const IonexStore& maps, const IonexStore& grid,
+           IonexStoreStrategy strategy, const CommonTime& t,
+           const Position& pos) const
+{
+   Triple expect, got;
+   bool mapsThrew = false, gridThrew = false;
+   try
+   {
+      expect = maps.getIonexValue(t, pos, strategy);
+   }
+   catch (gnsstk::Exception&)
+   {
+      mapsThrew = true;
+   }
+   try
+   {
+      got = grid.getIonexValue(t, pos, strategy);
+   }
+   catch (gnsstk::Exception&)
+   {
+      gridThrew = true;
+   }
+   if (mapsThrew || gridThrew)
+   {
+      return (mapsThrew == gridThrew);
+   }
+   return ( expect[0] == got[0] && expect[1] == got[1] &&
+            expect[2] == got[2] );
+}
+
+
+unsigned IonexStore_T ::
+gridTest()
+{
+   TUDEF("IonexStore", "getIonexValue");
+   IonexStore maps, grid;
+   addMaps(maps, 5);
+   addMaps(grid, 5);
+   TUASSERT(!maps.hasGrid());
+   TUASSERT(grid.buildGrid());
+   TUASSERT(grid.hasGrid());
+      // the map epochs and times in between
+   for (IonexStoreStrategy strategy : strategies)
+   {
+      for (double dt = 0.0; dt < 4 * 3600.0; dt += 450.0 + 0.25)
+      {
+         CommonTime t(t0 + dt);
+         for (const Position& pos : ipps)
+         {
+            TUASSERT(sameValues(maps, grid, strategy, t, pos));
+         }
+      }
+      for (int k = 0; k <= 4; k++)
+      {
+         CommonTime t(t0 + 3600.0 * k);
+         for (const Position& pos : ipps)
+         {
+            TUASSERT(sameValues(maps, grid, strategy, t, pos));
+         }
+      }
+   }
+      // the last epoch is interpolated between the last two maps
+   Position pos(ipps[0]);
+   CommonTime tEnd(t0 + 4 * 3600.0);
+   Triple tecval = grid.getIonexValue(tEnd, pos, IonexStoreStrategy::ConsRot);
+   TUASSERT(tecval[0] > 0.0);
+   TUASSERTE(double, pos.theArray[2], tecval[2]);
+   TUASSERT(sameValues(maps, grid, IonexStoreStrategy::ConsRot, tEnd, pos));
+      // adding a map goes back to the maps until the grid is rebuilt
+   grid.addMap(makeMap(t0 + 5 * 3600.0, IonexData::TEC, 1.5));
+   grid.addMap(makeMap(t0 + 5 * 3600.0, IonexData::RMS, 0.25));
+   TUASSERT(!grid.hasGrid());
+   TUASSERT(grid.buildGrid());
+   grid.clear();
+   TUASSERT(!grid.hasGrid());
+   TURETURN();
+}
+
+
+unsigned IonexStore_T ::
+valuesTest()
+{
+   TUDEF("IonexStore", "getIonexValues");
+   IonexStore maps, grid;
+   addMaps(maps, 3);
+   addMaps(grid, 3);
+   grid.buildGrid();
+      // away from the date line, where a rotated map may not reach
+   vector<Position> points;
+   for (const Position& pos : ipps)
+   {
+      if (pos.theArray[1] > 20.0 && pos.theArray[1] < 160.0)
+      {
+         points.push_back(pos);
+      }
+   }
+   TUASSERT(points.size() > 5);
+   vector<Triple> values;
+   for (IonexStoreStrategy strategy : strategies)
+   {
+      for (double dt = 0.0; dt < 2 * 3600.0; dt += 1234.5)
+      {
+         CommonTime t(t0 + dt);
+         for (const IonexStore* store : { &maps, &grid })
+         {
+            store->getIonexValues(t, points, values, strategy);
+            TUASSERTE(size_t, points.size(), values.size());
+            for (size_t i = 0; i < points.size(); i++)
+            {
+               Triple expect(store->getIonexValue(t, points[i], strategy));
+               TUASSERT(expect[0] == values[i][0] &&
+                        expect[1] == values[i][1] &&
+                        expect[2] == values[i][2]);
+            }
+         }
+      }
+   }
+   vector<Position> none;
+   grid.getIonexValues(t0, none, values);
+   TUASSERTE(size_t, 0, values.size());
+   TURETURN();
+}
+
+
+unsigned IonexStore_T ::
+fallbackTest()
+{
+   TUDEF("IonexStore", "buildGrid");
+   IonexStore store;
+   TUASSERT(!store.buildGrid());
+   addMaps(store, 3);
+      // a map on a different grid
+   IonexData iod(makeMap(t0 + 3 * 3600.0, IonexData::TEC, 1.3));
+   iod.lon[2] = -5.0;
+   iod.lon[0] = 180.0;
+   store.addMap(iod);
+   store.addMap(makeMap(t0 + 3 * 3600.0, IonexData::RMS, 0.23));
+   TUASSERT(!store.buildGrid());
+   TUASSERT(!store.hasGrid());
+   Triple tecval;
+   TUCATCH(tecval = store.getIonexValue(t0 + 5000.0, ipps[0]));
+   TUASSERT(tecval[0] > 0.0);
+      // RMS in only some epochs
+   IonexStore tecOnly;
+   tecOnly.addMap(makeMap(t0, IonexData::TEC, 1.0));
+   tecOnly.addMap(makeMap(t0, IonexData::RMS, 0.2));
+   tecOnly.addMap(makeMap(t0 + 3600.0, IonexData::TEC, 1.1));
+   TUASSERT(!tecOnly.buildGrid());
+      // more than one height
+   IonexStore heights;
+   addMaps(heights, 2);
+   iod = makeMap(t0 + 2 * 3600.0, IonexData::TEC, 1.2);
+   iod.hgt[1] = 500.0;
+   iod.hgt[2] = 50.0;
+   heights.addMap(iod);
+   heights.addMap(makeMap(t0 + 2 * 3600.0, IonexData::RMS, 0.22));
+   TUASSERT(!heights.buildGrid());
+   TURETURN();
+}
+
+
+unsigned IonexStore_T ::
+errorTest()
+{
+   TUDEF("IonexStore", "getIonexValue");
+   IonexStore maps, grid;
+   addMaps(maps, 3);
+   addMaps(grid, 3);
+   grid.buildGrid();
+   for (const IonexStore* store : { &maps, &grid })
+   {
+      TUTHROW(store->getIonexValue(t0 - 1.0, ipps[0]));
+      TUTHROW(store->getIonexValue(t0 + 2 * 3600.0 + 1.0, ipps[0]));
+      Position ecef(ipps[0]);
+      ecef.asECEF();
+      TUTHROW(store->getIonexValue(t0 + 60.0, ecef));
+      vector<Triple> values;
+      TUTHROW(store->getIonexValues(t0 - 1.0, ipps, values));
+         // there is no grid point south of the last latitude
+      Position south(-87.5, 0.0, 6821000.0, Position::Geocentric);
+      TUTHROW(store->getIonexValue(t0 + 60.0, south));
+   }
+      // undefined values
+   IonexStore undefMaps, undefGrid;
+   for (IonexStore* store : { &undefMaps, &undefGrid })
+   {
+      IonexData iod(makeMap(t0, IonexData::TEC, 1.0));
+      iod.data[0] = 999.9;
+      store->addMap(iod);
+      store->addMap(makeMap(t0 + 3600.0, IonexData::TEC, 1.1));
+   }
+   TUASSERT(undefGrid.buildGrid());
+      // in the cell with the undefined value, at the epoch of its map
+   Position corner(86.0, 182.5, 6821000.0, Position::Geocentric);
+   for (IonexStoreStrategy strategy : strategies)
+   {
+      TUTHROW(undefMaps.getIonexValue(t0, corner, strategy));
+      TUTHROW(undefGrid.getIonexValue(t0, corner, strategy));
+      TUASSERT(sameValues(undefMaps, undefGrid, strategy, t0 + 60.0,
+                          ipps[0]));
+   }
+   TURETURN();
+}
+
+
+unsigned IonexStore_T ::
+lastEpochTest()
+{
+   TUDEF("IonexStore", "getIonexValue");
+   string fileName = getPathTestTemp() + getFileSep() + "IonexStore_T.inx";
+
+      // three hourly maps on a 30 degree grid
+   IonexHeader hdr;
+   hdr.clear();
+   hdr.fileType = "IONOSPHERE MAPS";
+   hdr.system = "GPS";
+   hdr.fileProgram = "IonexStore_T";
+   hdr.firstEpoch = t0;
+   hdr.lastEpoch = t0 + 2 * 3600.0;
+   hdr.interval = 3600;
+   hdr.numMaps = 3;
+   hdr.mappingFunction = "NONE";
+   hdr.elevation = 0.0;
+   hdr.baseRadius = 6371.0;
+   hdr.mapDims = 2;
+   hdr.hgt[0] = hdr.hgt[1] = 450.0;
+   hdr.hgt[2] = 0.0;
+   hdr.lat[0] = 60.0;
+   hdr.lat[1] = -60.0;
+   hdr.lat[2] = -30.0;
+   hdr.lon[0] = -180.0;
+   hdr.lon[1] = 180.0;
+   hdr.lon[2] = 30.0;
+   hdr.exponent = -1;
+   hdr.valid = true;
+   {
+      IonexStream os(fileName.c_str(), ios::out);
+      os << hdr;
+      for (int k = 0; k < 3; k++)
+      {
+         for (const IonexData::IonexValType& type :
+                 { IonexData::TEC, IonexData::RMS })
+         {
+            IonexData iod;
+            iod.mapID = k + 1;
+            iod.time = hdr.firstEpoch + 3600.0 * k;
+            iod.type = type;
+            iod.exponent = hdr.exponent;
+            for (int i = 0; i < 3; i++)
+            {
+               iod.lat[i] = hdr.lat[i];
+               iod.lon[i] = hdr.lon[i];
+               iod.hgt[i] = hdr.hgt[i];
+            }
+            iod.dim[0] = 5;
+            iod.dim[1] = 13;
+            iod.dim[2] = 1;
+            iod.data.resize(iod.dim[0] * iod.dim[1]);
+            for (size_t i = 0; i < iod.data.size(); i++)
+            {
+               iod.data[i] = (type == IonexData::TEC) ?
+                  0.1 * (200 + 7 * i + 30 * k) : 0.1 * (20 + i % 7 + k);
+            }
+            iod.valid = true;
+            os << iod;
+         }
+      }
+      os << string(60, ' ') << IonexData::endOfFile << endl;
+   }
+
+      // the grid from loadFile() and the maps read one by one
+   IonexStore grid, maps;
+   TUCATCH(grid.loadFile(fileName));
+   TUASSERT(grid.hasGrid());
+   IonexStream is(fileName.c_str());
+   IonexHeader ihdr;
+   IonexData iod;
+   is >> ihdr;
+   while (is >> iod && iod.isValid())
+   {
+      maps.addMap(iod);
+   }
+   TUASSERT(!maps.hasGrid());
+   CommonTime tEnd(grid.getFinalTime());
+   TUASSERTE(CommonTime, tEnd, maps.getFinalTime());
+
+   double radius = 6371000.0 + 450000.0;
+   for (IonexStoreStrategy strategy : strategies)
+   {
+      for (int i = 0; i < 10; i++)
+      {
+         Position pos(50.0 * ::sin(1.3 * i), ::fmod(41.7 * i + 3.1, 360.0),
+                      radius, Position::Geocentric);
+         Triple expect, got;
+         TUCATCH(expect = maps.getIonexValue(tEnd, pos, strategy));
+         TUCATCH(got = grid.getIonexValue(tEnd, pos, strategy));
+         TUASSERT(expect[0] > 0.0 && expect[1] > 0.0);
+         TUASSERT(expect[0] == got[0] && expect[1] == got[1] &&
+                  expect[2] == got[2]);
+      }
+   }
+
+      // a single map can't be interpolated
+   IonexStore single;
+   single.addMap(makeMap(t0, IonexData::TEC, 1.0));
+   TUTHROW(single.getIonexValue(t0, ipps[0]));
+   TURETURN();
+}
+
+
+int main()
+{
+   IonexStore_T testClass;
+   unsigned errorTotal = 0;
+
+   errorTotal += testClass.gridTest();
+   errorTotal += testClass.valuesTest();
+   errorTotal += testClass.fallbackTest();
+   errorTotal += testClass.errorTest();
+   errorTotal += testClass.lastEpochTest();
+
+   std::cout << "Total Failures for " << __FILE__ << ": " << errorTotal
+             << std::endl;
+
+   return errorTotal;
+}
@@ -0,0 +1,365 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+#include <fstream>
+#include <iomanip>
+#include <vector>
+#include "Rinex3ObsChunkReader.hpp"
+#include "Rinex3ObsFileLoader.hpp"
+#include "Rinex3ObsStream.hpp"
+#include "Rinex3ObsData.hpp"
+#include "TestUtil.hpp"
+
+using namespace std;
+using namespace gnsstk;
+
+class Rinex3ObsChunkReader_T
+{
+public:
+   Rinex3ObsChunkReader_T();
+
+      /// Make sure records come back as Rinex3ObsStream reads them.
+   unsigned readTest();
+      /// Make sure several files are read in order.
+   unsigned multiFileTest();
+      /// Make sure errors are reported in order.
+   unsigned errorTest();
+      /// Make sure Rinex3ObsFileLoader gets the same results.
+   unsigned loaderTest();
+
+      /** Write a RINEX 3 observation file with clock offsets,
+       * events, blank observations and satellites coming and
+       * going.
+       * @param[in] fn The file to write.
+       * @param[in] hour The hour of the first epoch.
+       * @param[in] epochs The number of epochs to write.
+       * @param[in] badEpoch The index of an epoch to corrupt, if any. */
+   static void writeFile(const string& fn, unsigned hour, unsigned epochs,
+                         int badEpoch = -1);
+      /// Return true if two sets of observations are identical.
+   static bool sameObs(const Rinex3ObsData::DataMap& left,
+                       const Rinex3ObsData::DataMap& right);
+      /** Read fn with reader and Rinex3ObsStream, comparing the
+       * records.
+       * @return The number of records read. */
+   static unsigned checkFile(TestUtil& testFramework,
+                             Rinex3ObsChunkReader& reader, size_t file,
+                             const string& fn);
+
+      /// Base name of the temporary test files.
+   string tmpBase;
+};
+
+
+Rinex3ObsChunkReader_T ::
+Rinex3ObsChunkReader_T()
+      : tmpBase(getPathTestTemp() + getFileSep() +
+                "test_output_Rinex3ObsChunkReader")
+{
+   writeFile(tmpBase + "0.rnx", 0, 2000);
+   writeFile(tmpBase + "1.rnx", 17, 500);
+   writeFile(tmpBase + "2.rnx", 18, 1);
+}
+
+
+void Rinex3ObsChunkReader_T ::
+writeFile(const string& fn, unsigned hour, unsigned epochs, int badEpoch)
+{
+   ofstream out(fn.c_str());
+   out << "     3.04           OBSERVATION DATA    M                   RINEX VERSION / TYPE\n"
+       << "gnsstk              ARL:UT              20210101 000000 UTC PGM / RUN BY / DATE\n"
+       << "TEST                                                        MARKER NAME\n"
+       << "                                                            OBSERVER / AGENCY\n"
+       << "                                                            REC # / TYPE / VERS\n"
+       << "                                                            ANT # / TYPE\n"
+       << "        0.0000        0.0000        0.0000                  APPROX POSITION XYZ\n"
+       << "        0.0000        0.0000        0.0000                  ANTENNA: DELTA H/E/N\n"
+       << "G    4 C1C L1C C2W L2W                                      SYS / # / OBS TYPES\n"
+       << "E    3 C1X L1X S1X                                          SYS / # / OBS TYPES\n"
+       << "  2021     1     1    " << setw(2) << hour
+       << "     0    0.0000000     GPS         TIME OF FIRST OBS\n"
+       << "G L1C  0.00000                                              SYS / PHASE SHIFT\n"
+       << "G L2W  0.00000                                              SYS / PHASE SHIFT\n"
+       << "E L1X  0.00000                                              SYS / PHASE SHIFT\n"
+       << "                                                            END OF HEADER\n";
+   out << fixed;
+   for (unsigned i = 0; i < epochs; i++)
+   {
+      unsigned sec = i * 30;
+      out << "> 2021 01 01 " << setfill('0') << setw(2)
+          << (hour + sec / 3600) << " " << setw(2) << ((sec / 60) % 60)
+          << setfill(' ') << " " << setw(10) << setprecision(7)
+          << double(sec % 60) << "  ";
+      if (i % 97 == 50)
+      {
+            // an event with header records in place of satellites
+         out << "4  2\n"
+             << "event " << setw(6) << i << string(48, ' ') << "COMMENT\n"
+             << "second line                                                 COMMENT\n";
+         continue;
+      }
+      vector<string> sats;
+      for (unsigned prn = 1; prn <= 32; prn++)
+      {
+         if ((prn + i / 40) % 3 == 0)
+            sats.push_back("G" + string(prn < 10 ? "0" : "") +
+                           StringUtils::asString(prn));
+      }
+      for (unsigned prn = 1 + (i / 100) % 4; prn <= 30; prn += 4)
+      {
+         sats.push_back("E" + string(prn < 10 ? "0" : "") +
+                        StringUtils::asString(prn));
+      }
+      out << (int(i) == badEpoch ? "9" : "0") << setw(3) << sats.size();
+      if (i % 3 == 0)
+         out << "      " << setw(15) << setprecision(12) << (i * 1e-9);
+      out << "\n";
+      for (unsigned s = 0; s < sats.size(); s++)
+      {
+         out << sats[s] << setprecision(3);
+         unsigned ntypes = (sats[s][0] == 'G' ? 4 : 3);
+         for (unsigned t = 0; t < ntypes; t++)
+         {
+               // leave some observations blank
+            if ((i + s + t) % 11 == 0)
+            {
+               out << "                ";
+               continue;
+            }
+            out << setw(14) << (2.0e7 + 1000.0 * s + 10.0 * t + 0.001 * i)
+                << ((i + s) % 7 == 0 ? "1" : " ") << (t + 4);
+         }
+         out << "\n";
+      }
+   }
+}
+
+
+bool Rinex3ObsChunkReader_T ::
+sameObs(const Rinex3ObsData::DataMap& left,
+        const Rinex3ObsData::DataMap& right)
+{
+   if (left.size() != right.size())
+      return false;
+   for (auto li = left.begin(), ri = right.begin(); li != left.end();
+        ++li, ++ri)
+   {
+      if ((li->first != ri->first) || (li->second.size() != ri->second.size()))
+         return false;
+      for (size_t i = 0; i < li->second.size(); i++)
+      {
+         const RinexDatum &l(li->second[i]), &r(ri->second[i]);
+         if ((l.data != r.data) || (l.dataBlank != r.dataBlank) ||
+             (l.lli != r.lli) || (l.ssi != r.ssi))
+            return false;
+      }
+   }
+   return true;
+}
+
+
+unsigned Rinex3ObsChunkReader_T ::
+checkFile(TestUtil& testFramework, Rinex3ObsChunkReader& reader,
+          size_t file, const string& fn)
+{
+   Rinex3ObsStream strm(fn);
+   strm >> strm.header;
+   Rinex3ObsData rod, expRod;
+   unsigned records = 0;
+   TUASSERTE(string, strm.header.markerName,
+             reader.getHeader(file).markerName);
+   while (strm >> expRod)
+   {
+      if (!reader.read(file, rod))
+      {
+         TUFAIL("Missing records");
+         return records;
+      }
+      TUASSERTE(CommonTime, expRod.time, rod.time);
+      TUASSERTE(short, expRod.epochFlag, rod.epochFlag);
+      TUASSERTE(short, expRod.numSVs, rod.numSVs);
+      TUASSERTFE(expRod.clockOffset, rod.clockOffset);
+      TUASSERTE(size_t, expRod.auxHeader.commentList.size(),
+                rod.auxHeader.commentList.size());
+      TUASSERTE(size_t, expRod.obs.size(), rod.obs.size());
+      TUASSERT(sameObs(expRod.obs, rod.obs));
+      records++;
+   }
+   TUASSERTE(bool, false, reader.read(file, rod));
+   return records;
+}
+
+
+unsigned Rinex3ObsChunkReader_T ::
+readTest()
+{
+   TUDEF("Rinex3ObsChunkReader", "read");
+   string fn(tmpBase + "0.rnx");
+      // Chunks smaller than an epoch, about an epoch and many epochs.
+   size_t sizes[] = { 100, 997, 50000, 1 << 20 };
+   for (size_t size : sizes)
+   {
+      Rinex3ObsChunkReader reader(4, size);
+      size_t file = reader.addFile(fn);
+      TUASSERTE(size_t, 0, file);
+      TUASSERTE(bool, true, reader.isChunked(file));
+      TUASSERTE(unsigned, 2000, checkFile(testFramework, reader, file, fn));
+   }
+      // one thread reads the file directly
+   Rinex3ObsChunkReader serial(1);
+   size_t file = serial.addFile(fn);
+   TUASSERTE(bool, false, serial.isChunked(file));
+   TUASSERTE(unsigned, 2000, checkFile(testFramework, serial, file, fn));
+   TUCSM("addFile");
+   Rinex3ObsChunkReader reader(4);
+   TUTHROW(reader.addFile(tmpBase + "missing.rnx"));
+   TUASSERTE(size_t, 0, reader.getNumFiles());
+   TURETURN();
+}
+
+
+unsigned Rinex3ObsChunkReader_T ::
+multiFileTest()
+{
+   TUDEF("Rinex3ObsChunkReader", "read");
+   Rinex3ObsChunkReader reader(3, 4096);
+   for (unsigned i = 0; i < 3; i++)
+   {
+      string fn(tmpBase + StringUtils::asString(i) + ".rnx");
+      TUASSERTE(size_t, i, reader.addFile(fn));
+   }
+   TUASSERTE(size_t, 3, reader.getNumFiles());
+   TUASSERTE(unsigned, 2000, checkFile(testFramework, reader, 0,
+                                       tmpBase + "0.rnx"));
+   TUASSERTE(unsigned, 500, checkFile(testFramework, reader, 1,
+                                      tmpBase + "1.rnx"));
+   TUASSERTE(unsigned, 1, checkFile(testFramework, reader, 2,
+                                    tmpBase + "2.rnx"));
+      // Leaving a file part way through skips the rest of it.
+   reader.close();
+   reader.addFile(tmpBase + "0.rnx");
+   reader.addFile(tmpBase + "1.rnx");
+   Rinex3ObsData rod;
+   for (unsigned i = 0; i < 10; i++)
+      TUASSERTE(bool, true, reader.read(0, rod));
+   TUASSERTE(unsigned, 500, checkFile(testFramework, reader, 1,
+                                      tmpBase + "1.rnx"));
+   TUASSERTE(bool, false, reader.read(0, rod));
+   TURETURN();
+}
+
+
+unsigned Rinex3ObsChunkReader_T ::
+errorTest()
+{
+   TUDEF("Rinex3ObsChunkReader", "read");
+   string fn(tmpBase + "bad.rnx");
+   writeFile(fn, 0, 1000, 600);
+   for (unsigned threads = 1; threads <= 4; threads += 3)
+   {
+      Rinex3ObsChunkReader reader(threads, 5000);
+      size_t file = reader.addFile(fn);
+      Rinex3ObsData rod;
+      unsigned records = 0;
+      bool gotError = false;
+      try
+      {
+         while (reader.read(file, rod))
+            records++;
+      }
+      catch (FFStreamError& e)
+      {
+         gotError = true;
+      }
+      TUASSERTE(bool, true, gotError);
+      TUASSERTE(unsigned, 600, records);
+      TUASSERTE(bool, false, reader.read(file, rod));
+   }
+   TURETURN();
+}
+
+
+unsigned Rinex3ObsChunkReader_T ::
+loaderTest()
+{
+   TUDEF("Rinex3ObsFileLoader", "loadFiles");
+   vector<string> files;
+   for (unsigned i = 0; i < 3; i++)
+      files.push_back(tmpBase + StringUtils::asString(i) + ".rnx");
+   files.push_back(tmpBase + "missing.rnx");
+   string summary[2], errors[2], msgs[2];
+   vector<Rinex3ObsData> stores[2];
+   for (unsigned i = 0; i < 2; i++)
+   {
+      Rinex3ObsFileLoader loader(files);
+      loader.setReadThreads(i == 0 ? 1 : 4);
+      loader.loadObsID("GC1C");
+      loader.loadObsID("GL2W");
+      loader.loadObsID("EL1X");
+      loader.saveTheData(true);
+      TUASSERTE(int, 4, loader.loadFiles(errors[i], msgs[i]));
+      summary[i] = loader.asString();
+      stores[i] = loader.getStore();
+   }
+   TUASSERTE(string, summary[0], summary[1]);
+   TUASSERTE(string, errors[0], errors[1]);
+   TUASSERTE(string, msgs[0], msgs[1]);
+   TUASSERT(stores[0].size() > 2000);
+   TUASSERTE(size_t, stores[0].size(), stores[1].size());
+   for (size_t i = 0; i < stores[0].size() && i < stores[1].size(); i++)
+   {
+      TUASSERTE(CommonTime, stores[0][i].time, stores[1][i].time);
+      TUASSERT(sameObs(stores[0][i].obs, stores[1][i].obs));
+   }
+   TURETURN();
+}
+
+
+int main()
+{
+   unsigned errorTotal = 0;
+   Rinex3ObsChunkReader_T testClass;
+
+   errorTotal += testClass.readTest();
+   errorTotal += testClass.multiFileTest();
+   errorTotal += testClass.errorTest();
+   errorTotal += testClass.loaderTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+   return errorTotal;
+}
@@ -66,6 +66,10 @@ public:
    unsigned ionoDelayTest();
       /// Make sure reusing a stream object doesn't break.
    unsigned reopenTest();
+      /** Make sure that reading successive epochs into the same
+       * Rinex3ObsData object gives the same results as reading into
+       * a new object each time. */
+   unsigned recordReuseTest();
       /// generic filling of generic data.
    void setObs(gnsstk::TestUtil& testFramework, const std::string& system,
                gnsstk::Rinex3ObsHeader& hdr, gnsstk::Rinex3ObsData& rod);
@@ -624,6 +628,113 @@ reopenTest()
 }
 
 
+unsigned Rinex3ObsOther_T ::
+recordReuseTest()
+{
+   TUDEF("Rinex3ObsData", "reallyGetRecord");
+   std::string fn = gnsstk::getPathTestTemp() + gnsstk::getFileSep() +
+      "rinex3ObsTest_v304_reuse.out";
+   gnsstk::RinexSatID g01("G01"), g05("G05"), g07("G07"), e11("E11");
+   {
+      gnsstk::Rinex3ObsStream strm(fn, std::ios::out | std::ios::trunc);
+      gnsstk::Rinex3ObsHeader hdr;
+      gnsstk::RinexObsID gl1c("GL1C", 3.04), el1x("EL1X", 3.04);
+      hdr.date = "20200512 181734 UTC";
+      hdr.preserveDate = true;
+      hdr.version = 3.04;
+      hdr.fileSysSat.system = gnsstk::SatelliteSystem::Mixed;
+      hdr.mapObsTypes["G"].push_back(gnsstk::RinexObsID("GC1C", 3.04));
+      hdr.mapObsTypes["G"].push_back(gl1c);
+      hdr.mapObsTypes["E"].push_back(gnsstk::RinexObsID("EC1X", 3.04));
+      hdr.mapObsTypes["E"].push_back(el1x);
+      hdr.sysPhaseShift["G"][gl1c][g01] = 0.;
+      hdr.sysPhaseShift["E"][el1x][e11] = 0.;
+      hdr.valid |= gnsstk::Rinex3ObsHeader::validVersion;
+      hdr.valid |= gnsstk::Rinex3ObsHeader::validRunBy;
+      hdr.valid |= gnsstk::Rinex3ObsHeader::validMarkerName;
+      hdr.valid |= gnsstk::Rinex3ObsHeader::validObserver;
+      hdr.valid |= gnsstk::Rinex3ObsHeader::validReceiver;
+      hdr.valid |= gnsstk::Rinex3ObsHeader::validAntennaType;
+      hdr.valid |= gnsstk::Rinex3ObsHeader::validAntennaPosition;
+      hdr.valid |= gnsstk::Rinex3ObsHeader::validAntennaDeltaHEN;
+      hdr.valid |= gnsstk::Rinex3ObsHeader::validFirstTime;
+      hdr.valid |= gnsstk::Rinex3ObsHeader::validSystemNumObs;
+      hdr.valid |= gnsstk::Rinex3ObsHeader::validSystemPhaseShift;
+      hdr.validEoH = true;
+      TUCATCH(strm << hdr);
+         // Written by hand to get short lines and changing satellites.
+      strm << "> 2020 05 12 00 00  0.0000000  0  3" << endl
+           << "G01  20000000.123 7  20000001.45616" << endl
+           << "G05  21000000.000       -1234.567 1" << endl
+           << "E11  22000000.500 5" << endl
+           << "> 2020 05 12 00 00  1.0000000  0  2" << endl
+           << "E11  22000001.500 5  22000002.500" << endl
+           << "G07                  23000000.00017" << endl
+           << "> 2020 05 12 00 00  2.0000000  0  2" << endl
+           << "G05  21000001.000" << endl
+           << "G01" << endl;
+   }
+   gnsstk::Rinex3ObsStream reused(fn), fresh(fn);
+   gnsstk::Rinex3ObsData rod;
+   unsigned epochs = 0;
+   while (reused >> rod)
+   {
+      gnsstk::Rinex3ObsData expRod;
+      TUASSERT(static_cast<bool>(fresh >> expRod));
+      TUASSERTE(gnsstk::CommonTime, expRod.time, rod.time);
+      TUASSERTE(size_t, expRod.obs.size(), rod.obs.size());
+      for (const auto& sati : expRod.obs)
+      {
+         auto roi = rod.obs.find(sati.first);
+         TUASSERT(roi != rod.obs.end());
+         if (roi == rod.obs.end())
+            continue;
+         TUASSERTE(size_t, sati.second.size(), roi->second.size());
+         for (unsigned i = 0; i < sati.second.size(); i++)
+         {
+            TUASSERTE(double, sati.second[i].data, roi->second[i].data);
+            TUASSERTE(bool, sati.second[i].dataBlank,
+                      roi->second[i].dataBlank);
+            TUASSERTE(short, sati.second[i].lli, roi->second[i].lli);
+            TUASSERTE(bool, sati.second[i].lliBlank,
+                      roi->second[i].lliBlank);
+            TUASSERTE(short, sati.second[i].ssi, roi->second[i].ssi);
+            TUASSERTE(bool, sati.second[i].ssiBlank,
+                      roi->second[i].ssiBlank);
+         }
+      }
+      switch (epochs++)
+      {
+         case 0:
+            TUASSERTE(size_t, 3, rod.obs.size());
+            TUASSERTFE(20000001.456, rod.obs[g01][1].data);
+            TUASSERTE(short, 1, rod.obs[g01][1].lli);
+            TUASSERTE(short, 6, rod.obs[g01][1].ssi);
+            TUASSERTFE(-1234.567, rod.obs[g05][1].data);
+            TUASSERTE(bool, true, rod.obs[e11][1].dataBlank);
+            break;
+         case 1:
+            TUASSERTE(size_t, 2, rod.obs.size());
+            TUASSERTE(size_t, 0, rod.obs.count(g01));
+            TUASSERTE(size_t, 0, rod.obs.count(g05));
+            TUASSERTFE(22000002.5, rod.obs[e11][1].data);
+            TUASSERTE(bool, true, rod.obs[e11][1].ssiBlank);
+            TUASSERTE(bool, true, rod.obs[g07][0].dataBlank);
+            break;
+         case 2:
+            TUASSERTE(size_t, 2, rod.obs.size());
+            TUASSERTE(size_t, 0, rod.obs.count(e11));
+            TUASSERTE(bool, true, rod.obs[g05][1].dataBlank);
+            TUASSERTE(bool, true, rod.obs[g01][0].dataBlank);
+            TUASSERTE(bool, true, rod.obs[g01][1].dataBlank);
+            break;
+      }
+   }
+   TUASSERTE(unsigned, 3, epochs);
+   TURETURN();
+}
+
+
 int main()
 {
    unsigned errorTotal = 0;
@@ -634,6 +745,7 @@ int main()
    errorTotal += testClass.ionoDelayTest();
    errorTotal += testClass.obsIDVersionTest();
    errorTotal += testClass.reopenTest();
+   errorTotal += testClass.recordReuseTest();
    cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
    return errorTotal;
 }
@@ -0,0 +1,224 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+#include "GlobalTropModel.hpp"
+#include "TestUtil.hpp"
+#include <vector>
+
+using namespace std;
+using namespace gnsstk;
+
+class GlobalTropModel_T
+{
+public:
+      /// Compare with values of the explicit Legendre formulas.
+   unsigned gptTest();
+      /// Make sure the site cache is used and kept.
+   unsigned cacheTest();
+      /// Compare corrections(queries) with correction(elevation).
+   unsigned correctionsTest();
+      /// Make sure zero height, latitude, longitude and day are valid.
+   unsigned validTest();
+};
+
+
+unsigned GlobalTropModel_T ::
+gptTest()
+{
+   TUDEF("GlobalTropModel", "getGPT");
+      // computed with the explicit formulas for the Legendre functions
+      // lat, lon, ht, doy, P, T, U, correction(37)
+   double ref[3][8] = {
+      { 27.3, -98.4, 812.3, 103, 921.46622267168436, 23.867632696433351,
+        -16.774283145499414, 3.7402282885240972 },
+      { -38.4, 18.6, -50.0, 200, 1029.0100701581134, 12.036385950240184,
+        33.89115249159476, 4.0180450240524674 },
+      { 78.4, 135.6, 4500.0, 365, 585.23094216451329, -59.665787902883991,
+        -0.29875759155299608, 2.2279264210288217 } };
+   for (auto& r : ref)
+   {
+      GlobalTropModel model;
+      model.setReceiverLatitude(r[0]);
+      model.setReceiverLongitude(r[1]);
+      model.setReceiverHeight(r[2]);
+      model.setDayOfYear(int(r[3]));
+      double P, T, U;
+      model.getGPT(P, T, U);
+      TUASSERTFEPS(r[4], P, 1e-9);
+      TUASSERTFEPS(r[5], T, 1e-9);
+      TUASSERTFEPS(r[6], U, 1e-9);
+      TUCSM("correction");
+      TUASSERTFEPS(r[7], model.correction(37.0), 1e-12);
+      TUCSM("getGPT");
+   }
+   TURETURN();
+}
+
+
+unsigned GlobalTropModel_T ::
+cacheTest()
+{
+   TUDEF("GlobalTropModel", "siteCoefficients");
+   GlobalTropModel model;
+   TUASSERTE(size_t, 0, model.siteCacheSize());
+   model.setReceiverLatitude(30.38);
+   model.setReceiverLongitude(-97.73);
+   model.setReceiverHeight(200.0);
+   model.setDayOfYear(103);
+   TUASSERTE(size_t, 1, model.siteCacheSize());
+   double corr = model.correction(20.0);
+      // a new time or height does not need a new site
+   model.setDayOfYear(104);
+   model.setReceiverHeight(210.0);
+   TUASSERTE(size_t, 1, model.siteCacheSize());
+   model.setReceiverLatitude(-33.9);
+   model.setReceiverLongitude(18.4);
+      // setting latitude then longitude passes through (-33.9,-97.73)
+   TUASSERTE(size_t, 3, model.siteCacheSize());
+      // returning to the first site gives the same result
+   model.setReceiverLatitude(30.38);
+   model.setReceiverLongitude(-97.73);
+   model.setReceiverHeight(200.0);
+   model.setDayOfYear(103);
+   TUASSERTE(size_t, 4, model.siteCacheSize());
+   TUASSERTE(double, corr, model.correction(20.0));
+   const GlobalTropModel::SiteCoeff& sc = model.siteCoefficients(30.38,
+                                                                 -97.73);
+   TUASSERTE(size_t, 4, model.siteCacheSize());
+   double P, T, U;
+   model.getGPT(P, T, U);
+   TUASSERTE(double, sc.undul, U);
+   TUCSM("clearSiteCache");
+   model.clearSiteCache();
+   TUASSERTE(size_t, 0, model.siteCacheSize());
+   TUASSERTE(double, corr, model.correction(20.0));
+   TURETURN();
+}
+
+
+unsigned GlobalTropModel_T ::
+correctionsTest()
+{
+   TUDEF("GlobalTropModel", "corrections");
+   GlobalTropModel model, single;
+   model.setHumidity(65.0);
+   single.setHumidity(65.0);
+   vector<GlobalTropModel::Query> queries;
+   double sites[3][3] = { { 30.38, -97.73, 200.0 }, { -33.9, 18.4, 10.0 },
+                          { 64.8, -147.5, 135.2 } };
+   for (int day = 0; day < 3; day++)
+   {
+      for (auto& s : sites)
+      {
+         for (double el = 1.0; el < 90.0; el += 7.7)
+         {
+            GlobalTropModel::Query q = { s[0], s[1], s[2], 57000.0 + day, el };
+            queries.push_back(q);
+         }
+      }
+   }
+      // and one at a time, changing site and time at each
+   queries.push_back(queries[5]);
+   queries.push_back(queries[40]);
+   queries.push_back(queries[5]);
+   vector<double> delays;
+   model.corrections(queries, delays);
+   TUASSERTE(size_t, queries.size(), delays.size());
+   bool same = true;
+   for (size_t i = 0; i < queries.size(); i++)
+   {
+      const GlobalTropModel::Query& q(queries[i]);
+      single.setReceiverLatitude(q.latitude);
+      single.setReceiverLongitude(q.longitude);
+      single.setReceiverHeight(q.height);
+      single.setDayOfYear(int(q.mjd - 44266.0));
+      same &= (single.correction(q.elevation) == delays[i]);
+   }
+   TUASSERT(same);
+      // the receiver of the model is not set
+   TUTHROW(model.correction(20.0));
+      // nor is it changed
+   single.corrections(queries, delays);
+   TUASSERTE(double, single.correction(20.0),
+             single.correction(20.0));
+   GlobalTropModel::Query high = { 30.38, -97.73, 50000.0, 57000.0, 20.0 };
+   queries.push_back(high);
+   TUTHROW(model.corrections(queries, delays));
+   TURETURN();
+}
+
+
+unsigned GlobalTropModel_T ::
+validTest()
+{
+   TUDEF("GlobalTropModel", "setReceiverHeight");
+   GlobalTropModel model;
+   model.setReceiverLatitude(0.0);
+   model.setReceiverLongitude(0.0);
+   model.setReceiverHeight(0.0);
+   model.setDayOfYear(0);
+   TUASSERT(model.isValid());
+   TUCATCH(model.correction(20.0));
+   TUCSM("setParameters");
+      // again at the same place and time
+   Position pos(0.0, 0.0, 0.0, Position::Geodetic);
+   CommonTime when = CommonTime::BEGINNING_OF_TIME;
+   when.setTimeSystem(TimeSystem::Any);
+   model.setParameters(when, pos);
+   TUASSERT(model.isValid());
+   model.setParameters(when, pos);
+   TUASSERT(model.isValid());
+   TURETURN();
+}
+
+
+int main()
+{
+   unsigned errorTotal = 0;
+   GlobalTropModel_T testClass;
+
+   errorTotal += testClass.gptTest();
+   errorTotal += testClass.cacheTest();
+   errorTotal += testClass.correctionsTest();
+   errorTotal += testClass.validTest();
+
+   std::cout << "Total Failures for " << __FILE__ << ": " << errorTotal
+             << std::endl;
+
+   return errorTotal;
+}
@@ -164,6 +164,15 @@ public:
    unsigned initTest();
    unsigned initGlobalTest();
    unsigned initNBTest();
+      /// Compare TropCorrector::getCorrs() with getCorr().
+   unsigned getCorrsTest();
+
+      /** Return true if getCorrs() of uut gives the same delays as
+       * getCorr() for each of svPos. */
+   template <class Corrector>
+   bool sameCorrs(Corrector& uut, const gnsstk::Position& rxPos,
+                  const std::vector<gnsstk::Position>& svPos,
+                  const gnsstk::CommonTime& when);
    std::string dataPath;
 };
 
@@ -509,6 +518,73 @@ initNBTest()
 }
 
 
+template <class Corrector>
+bool GroupPathCorr_T ::
+sameCorrs(Corrector& uut, const gnsstk::Position& rxPos,
+          const std::vector<gnsstk::Position>& svPos,
+          const gnsstk::CommonTime& when)
+{
+   std::vector<double> corrs;
+   if (!uut.getCorrs(rxPos, svPos, when, corrs) ||
+       (corrs.size() != svPos.size()))
+   {
+      return false;
+   }
+   for (size_t i = 0; i < svPos.size(); i++)
+   {
+      double corr;
+      if (!uut.getCorr(rxPos, svPos[i], gnsstk::SatID(), gnsstk::ObsID(),
+                       when, gnsstk::NavType::Any, corr) ||
+          (corr != corrs[i]))
+      {
+         return false;
+      }
+   }
+   return true;
+}
+
+
+unsigned GroupPathCorr_T ::
+getCorrsTest()
+{
+   TUDEF("TropCorrector", "getCorrs");
+   gnsstk::CommonTime when = gnsstk::CivilTime(2015,7,19,2,0,0.0,
+                                               gnsstk::TimeSystem::GPS);
+   gnsstk::Position rxPos(34.5, 262.3, 211.0, gnsstk::Position::Geodetic);
+   std::vector<gnsstk::Position> svPos;
+   for (double lat = -60.0; lat <= 60.0; lat += 30.0)
+   {
+      for (double lon = 180.0; lon < 360.0; lon += 30.0)
+      {
+         svPos.push_back(gnsstk::Position(lat, lon, 20200.0e3,
+                                          gnsstk::Position::Geodetic));
+      }
+   }
+   gnsstk::SaasTropCorrector saas;
+   saas.setDefaultWx(21.0, 1010.0, 60.0);
+   TUASSERT(sameCorrs(saas, rxPos, svPos, when));
+   gnsstk::NBTropCorrector nb;
+   TUASSERT(sameCorrs(nb, rxPos, svPos, when));
+   gnsstk::NeillTropCorrector neill;
+   neill.setDefaultWx();
+   TUASSERT(sameCorrs(neill, rxPos, svPos, when));
+   gnsstk::GlobalTropCorrector global;
+   global.setDefaultWx();
+   TUASSERT(sameCorrs(global, rxPos, svPos, when));
+      // the default TropModel::corrections()
+   gnsstk::SimpleTropCorrector simple;
+   simple.setDefaultWx();
+   TUASSERT(sameCorrs(simple, rxPos, svPos, when));
+      // invalid weather
+   std::vector<double> corrs;
+   simple.setDefaultWx(20.0, 1013.0, 110.0);
+   TUASSERTE(bool, false, simple.getCorrs(rxPos, svPos, when, corrs));
+   TUASSERTE(size_t, svPos.size(), corrs.size());
+   TUASSERT(std::isnan(corrs[0]));
+   TURETURN();
+}
+
+
 int main()
 {
    unsigned errorTotal = 0;
@@ -522,6 +598,7 @@ int main()
    errorTotal += testClass.initTest();
    errorTotal += testClass.initGlobalTest();
    errorTotal += testClass.initNBTest();
+   errorTotal += testClass.getCorrsTest();
 
    std::cout << "Total Failures for " << __FILE__ << ": " << errorTotal
              << std::endl;
@@ -37,17 +37,237 @@
 //==============================================================================
 
 #include "TestUtil.hpp"
+#include "SimpleTropModel.hpp"
+#include "NeillTropModel.hpp"
+#include "SaasTropModel.hpp"
+#include "NBTropModel.hpp"
+#include "GCATTropModel.hpp"
+#include "MOPSTropModel.hpp"
+#include "GlobalTropModel.hpp"
+#include "CivilTime.hpp"
+#include <cmath>
 #include <iostream>
+#include <vector>
+
+using namespace std;
+using namespace gnsstk;
 
 class TropModel_T
 {
-        public:
-		TropModel_T(){}// Default Constructor, set the precision value
-		~TropModel_T() {} // Default Desructor
+public:
+   TropModel_T();
+      /// Compare corrections(elevations) with correction(elevation).
+   unsigned correctionsTest();
+      /// Compare corrections(RX,SV,tt) with correction(RX,SV,tt).
+   unsigned positionsTest();
+      /// Make sure corrections(elevations) throws for an invalid model.
+   unsigned invalidTest();
+
+private:
+      /** Return true if corrections(elevations) of model is exactly
+       * correction(elevation) at each elevation, including NaN at
+       * zero elevation and height in the Saastamoinen model. */
+   bool sameCorrections(const TropModel& model);
+
+      /** Return true if corrections(RX,SV,tt) of model is exactly
+       * correction(RX,SV,tt) for each satellite in sats. */
+   bool samePositions(TropModel& model, const Position& rx,
+                      const CommonTime& tt);
+
+      /// elevations in degrees, including the cut-offs of the models
+   vector<double> elevations;
+      /// satellite positions all around the sky, some below the horizon
+   vector<Position> sats;
 };
 
 
-int main() //Main function to initialize and run all tests above
+TropModel_T ::
+TropModel_T()
+{
+   double special[] = { -10.0, -0.0005, 0.0, 0.0005, 2.999, 3.0, 4.999, 5.0 };
+   elevations.assign(special, special + sizeof(special)/sizeof(double));
+   for (double el = 0.25; el <= 90.0; el += 1.75)
+   {
+      elevations.push_back(el);
+   }
+   elevations.push_back(90.0);
+   for (double lat = -80.0; lat <= 80.0; lat += 32.0)
+   {
+      for (double lon = 0.0; lon < 360.0; lon += 45.0)
+      {
+         sats.push_back(Position(lat, lon, 20200.0e3, Position::Geodetic));
+      }
+   }
+}
+
+
+bool TropModel_T ::
+samePositions(TropModel& model, const Position& rx, const CommonTime& tt)
+{
+   vector<double> delays(3, 1.0);
+   model.corrections(rx, sats, tt, delays);
+   if (delays.size() != sats.size())
+   {
+      return false;
+   }
+   for (size_t i = 0; i < sats.size(); i++)
+   {
+      double expected = model.correction(rx, sats[i], tt);
+      if ((delays[i] != expected) &&
+          !(std::isnan(delays[i]) && std::isnan(expected)))
+      {
+         return false;
+      }
+   }
+   return true;
+}
+
+
+bool TropModel_T ::
+sameCorrections(const TropModel& model)
+{
+   vector<double> delays(3, 1.0);
+   model.corrections(elevations, delays);
+   if (delays.size() != elevations.size())
+   {
+      return false;
+   }
+   for (size_t i = 0; i < elevations.size(); i++)
+   {
+      double expected = model.correction(elevations[i]);
+      if ((delays[i] != expected) &&
+          !(std::isnan(delays[i]) && std::isnan(expected)))
+      {
+         return false;
+      }
+   }
+   return true;
+}
+
+
+unsigned TropModel_T ::
+correctionsTest()
 {
-	return 0; //Return the total number of errors
+   TUDEF("TropModel", "corrections");
+   double heights[] = { -50.0, 0.0, 1234.5 };
+   double lats[] = { -80.0, -37.5, 0.0, 22.2, 45.0, 74.9 };
+   int days[] = { 1, 100, 200, 366 };
+   for (double ht : heights)
+   {
+      for (double lat : lats)
+      {
+         for (int doy : days)
+         {
+            NeillTropModel neill(ht, lat, doy);
+            TUASSERT(sameCorrections(neill));
+            SaasTropModel saas(lat, doy, 21.0, 1010.0, 60.0);
+            saas.setReceiverHeight(ht);
+            TUASSERT(sameCorrections(saas));
+            NBTropModel nb(ht, lat, doy);
+            TUASSERT(sameCorrections(nb));
+            nb.setWeather(15.0, 990.0, 80.0);
+            TUASSERT(sameCorrections(nb));
+            GlobalTropModel global(ht, lat, 100.0-lat, 44266.0+doy);
+            TUASSERT(sameCorrections(global));
+            MOPSTropModel mops(ht, lat, doy);
+            TUASSERT(sameCorrections(mops));
+         }
+         GCATTropModel gcat(ht);
+         TUASSERT(sameCorrections(gcat));
+      }
+   }
+      // the default, which calls correction() for each elevation
+   SimpleTropModel simple(18.0, 1013.0, 50.0);
+   TUASSERT(sameCorrections(simple));
+   ZeroTropModel zero;
+   TUASSERT(sameCorrections(zero));
+      // no elevations
+   vector<double> none, delays(2, 1.0);
+   NeillTropModel neill(10.0, 30.0, 50);
+   neill.corrections(none, delays);
+   TUASSERTE(size_t, 0, delays.size());
+   TURETURN();
+}
+
+
+unsigned TropModel_T ::
+positionsTest()
+{
+   TUDEF("TropModel", "corrections");
+   CommonTime tt(CivilTime(2021, 3, 14, 12, 0, 0.0, TimeSystem::GPS));
+   double heights[] = { 0.0, 1234.5 };
+   double lats[] = { -37.5, 22.2, 74.9 };
+   for (double ht : heights)
+   {
+      for (double lat : lats)
+      {
+         Position rx(lat, 100.0-lat, ht, Position::Geodetic);
+         NeillTropModel neill;
+         TUASSERT(samePositions(neill, rx, tt));
+         SaasTropModel saas;
+         saas.setWeather(21.0, 1010.0, 60.0);
+         TUASSERT(samePositions(saas, rx, tt));
+            // these must be valid before correction(RX,SV,tt)
+         NBTropModel nb(ht, lat, 73);
+         nb.setWeather(15.0, 990.0, 80.0);
+         TUASSERT(samePositions(nb, rx, tt));
+         GlobalTropModel global(ht, lat, 100.0-lat, 59287.0);
+         TUASSERT(samePositions(global, rx, tt));
+         GCATTropModel gcat;
+         TUASSERT(samePositions(gcat, rx, tt));
+            // the default, which calls correction(RX,SV,tt)
+         SimpleTropModel simple(18.0, 1013.0, 50.0);
+         TUASSERT(samePositions(simple, rx, tt));
+      }
+   }
+      // no satellites
+   Position rx(30.0, 40.0, 10.0, Position::Geodetic);
+   vector<Position> none;
+   vector<double> delays(2, 1.0);
+   NeillTropModel neill;
+   neill.corrections(rx, none, tt, delays);
+   TUASSERTE(size_t, 0, delays.size());
+      // no weather
+   SaasTropModel saas;
+   TUTHROW(saas.corrections(rx, sats, tt, delays));
+   TURETURN();
+}
+
+
+unsigned TropModel_T ::
+invalidTest()
+{
+   TUDEF("TropModel", "corrections");
+   vector<double> delays;
+   NeillTropModel neill;
+   TUTHROW(neill.corrections(elevations, delays));
+      // no weather
+   SaasTropModel saas(30.0, 50);
+   TUTHROW(saas.corrections(elevations, delays));
+      // no height
+   NBTropModel nb(30.0, 50);
+   TUTHROW(nb.corrections(elevations, delays));
+   GCATTropModel gcat;
+   TUTHROW(gcat.corrections(elevations, delays));
+   GlobalTropModel global;
+   TUTHROW(global.corrections(elevations, delays));
+   MOPSTropModel mops;
+   TUTHROW(mops.corrections(elevations, delays));
+   TURETURN();
+}
+
+
+int main()
+{
+   unsigned errorTotal = 0;
+   TropModel_T testClass;
+
+   errorTotal += testClass.correctionsTest();
+   errorTotal += testClass.positionsTest();
+   errorTotal += testClass.invalidTest();
+
+   std::cout << "Total Failures for " << __FILE__ << ": " << errorTotal
+             << std::endl;
+
+   return errorTotal;
 }
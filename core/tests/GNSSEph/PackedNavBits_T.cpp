@@ -68,6 +68,10 @@ public:
    unsigned addDataVecByteAlignedTest();
    unsigned overInitialCapacity();
    unsigned addBitVecTest();
+      /** Compare field extraction and insertion against a simple
+       * bit-at-a-time reference, for fields at every position
+       * relative to the 64-bit storage words. */
+   unsigned wordBoundaryTest();
 
    double eps;
 };
@@ -967,6 +971,108 @@ addBitVecTest()
 }
 
 
+unsigned PackedNavBits_T ::
+wordBoundaryTest()
+{
+   TUDEF("PackedNavBits", "asUnsignedLong");
+
+      // pseudo-random bit pattern
+   std::vector<int> ref;
+   uint32_t lcg = 12345;
+   for (unsigned i = 0; i < 300; i++)
+   {
+      lcg = lcg * 1103515245 + 12345;
+      ref.push_back((lcg >> 16) & 1);
+   }
+   PackedNavBits uut;
+   uut.addBitVec(ref.begin(), ref.end());
+   uut.trimsize();
+   TUASSERTE(size_t, 300, uut.getBits().size());
+   unsigned bad = 0, badSigned = 0;
+   for (unsigned numBits = 1; numBits <= 32; numBits++)
+   {
+      for (unsigned start = 0; start + numBits <= ref.size(); start++)
+      {
+         unsigned long expU = 0;
+         for (unsigned i = start; i < start + numBits; i++)
+         {
+            expU = (expU << 1) | ref[i];
+         }
+         long expS = (ref[start] ? (long)expU - (1L << numBits) : (long)expU);
+         if (uut.asUnsignedLong(start, numBits, 1) != expU)
+            bad++;
+         if (uut.asLong(start, numBits, 1) != expS)
+            badSigned++;
+      }
+   }
+   TUASSERTE(unsigned, 0, bad);
+   TUCSM("asLong");
+   TUASSERTE(unsigned, 0, badSigned);
+   TUCSM("asUnsignedLong");
+   TUTHROW(uut.asUnsignedLong(290, 11, 1));
+
+      // overwrite fields across word boundaries
+   TUCSM("insertUnsignedLong");
+   bad = 0;
+   for (unsigned start = 40; start < 140; start += 3)
+   {
+      unsigned long value = 0x2d5a5 ^ start;
+      uut.insertUnsignedLong(value, start, 20);
+      for (unsigned i = 0; i < 20; i++)
+      {
+         ref[start+i] = (value >> (19-i)) & 1;
+      }
+   }
+   std::vector<bool> got(uut.getBits());
+   for (unsigned i = 0; i < ref.size(); i++)
+   {
+      if (got[i] != (ref[i] == 1))
+         bad++;
+   }
+   TUASSERTE(unsigned, 0, bad);
+
+      // invert, compare and copy all of the bits
+   TUCSM("invert");
+   PackedNavBits inv(uut);
+   inv.invert();
+   bad = 0;
+   for (unsigned i = 0; i < ref.size(); i++)
+   {
+      if (inv.asBool(i) == (ref[i] == 1))
+         bad++;
+   }
+   TUASSERTE(unsigned, 0, bad);
+   TUCSM("operator<");
+   TUASSERTE(bool, ref[0] == 0, uut < inv);
+   TUASSERTE(bool, ref[0] == 1, inv < uut);
+   TUCSM("copyBits");
+   inv.copyBits(uut, 70, 200);
+   TUASSERT(!inv.matchBits(uut));
+   TUASSERT(inv.matchBits(uut, 70, 200));
+   TUASSERT(!inv.matchBits(uut, 69, 200));
+   TUASSERT(!inv.matchBits(uut, 70, 201));
+
+      // appending to a store that doesn't end on a word boundary
+   TUCSM("addPackedNavBits");
+   PackedNavBits app;
+   app.addUnsignedLong(5, 3, 1);
+   app.addPackedNavBits(uut);
+   TUASSERTE(size_t, 303, app.getNumBits());
+   TUASSERTE(unsigned long, 5, app.asUnsignedLong(0, 3, 1));
+   TUASSERT(app.asUnsignedLong(3, 32, 1) == uut.asUnsignedLong(0, 32, 1));
+   TUASSERT(app.asUnsignedLong(271, 32, 1) == uut.asUnsignedLong(268, 32, 1));
+
+      // fill constructor
+   TUCSM("PackedNavBits");
+   PackedNavBits filled(SatID(), ObsID(), NavID(), "", CommonTime(), 70,
+                        true);
+   TUASSERTE(unsigned long, 0xffffffff, filled.asUnsignedLong(38, 32, 1));
+   TUASSERTE(long, -1, filled.asLong(60, 10, 1));
+
+   TURETURN();
+}
+
+
 int main()
 {
    unsigned errorTotal = 0;
@@ -981,6 +1087,7 @@ int main()
    errorTotal += testClass.addDataVecByteAlignedTest();
    errorTotal += testClass.overInitialCapacity();
    errorTotal += testClass.addBitVecTest();
+   errorTotal += testClass.wordBoundaryTest();
 
    cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
 
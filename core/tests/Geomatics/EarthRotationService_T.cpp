@@ -0,0 +1,174 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+
+/// @file EarthRotationService_T.cpp Test class EarthRotationService
+
+#include <cmath>
+#include <iostream>
+#include "EarthRotationService.hpp"
+#include "TestUtil.hpp"
+
+using namespace std;
+using namespace gnsstk;
+
+class EarthRotationService_T
+{
+public:
+      /// Make sure bad conventions and steps are rejected.
+   unsigned constructorTest();
+      /** Make sure the rotation matches EarthOrientation for each
+       * convention, at the default and a longer node spacing. */
+   unsigned ECEFtoInertialTest();
+      /// Make sure nodes are cached and cleared as documented.
+   unsigned cacheTest();
+
+      /** Return the largest difference between the elements of the
+       * rotations computed by EarthOrientation and by ers, at epochs
+       * spread over several years. */
+   static double maxDiff(EarthRotationService& ers, bool reduced);
+};
+
+
+unsigned EarthRotationService_T ::
+constructorTest()
+{
+   TUDEF("EarthRotationService", "EarthRotationService");
+   TUTHROW(EarthRotationService(IERSConvention::Unknown));
+   TUTHROW(EarthRotationService(IERSConvention::IERS2010, 0.0));
+   TUTHROW(EarthRotationService(IERSConvention::IERS2010, -1.0));
+   EarthRotationService ers(IERSConvention::IERS2003);
+   TUASSERTE(IERSConvention, IERSConvention::IERS2003, ers.getConvention());
+   TUASSERTFE(EarthRotationService::defaultStep, ers.getStep());
+   TUASSERTE(size_t, 0, ers.size());
+   TURETURN();
+}
+
+
+unsigned EarthRotationService_T ::
+ECEFtoInertialTest()
+{
+   TUDEF("EarthRotationService", "ECEFtoInertial");
+   IERSConvention conventions[] = { IERSConvention::IERS1996,
+                                    IERSConvention::IERS2003,
+                                    IERSConvention::IERS2010 };
+   for (IERSConvention conv : conventions)
+   {
+      EarthRotationService ers(conv);
+      TUASSERTFEPS(0.0, maxDiff(ers, false), 1.e-12);
+      EarthRotationService ersHalf(conv, 0.5);
+      TUASSERTFEPS(0.0, maxDiff(ersHalf, false), 3.e-10);
+   }
+   EarthRotationService ers96(IERSConvention::IERS1996);
+   TUASSERTFEPS(0.0, maxDiff(ers96, true), 1.e-12);
+
+      // EOPs of a different convention
+   EarthOrientation eo;
+   eo.convention = IERSConvention::IERS2003;
+   EarthRotationService ers(IERSConvention::IERS2010);
+   TUTHROW(ers.ECEFtoInertial(eo, EphTime(55000, 0.0)));
+   TURETURN();
+}
+
+
+unsigned EarthRotationService_T ::
+cacheTest()
+{
+   TUDEF("EarthRotationService", "size");
+   EarthRotationService ers(IERSConvention::IERS2010, 1.0);
+   EphTime t(58000, 43200.0, TimeSystem::UTC);
+   ers.celestialToIntermediate(t);
+   TUASSERTE(size_t, 4, ers.size());
+      // an epoch between the same nodes computes nothing new
+   t += 600.0;
+   ers.celestialToIntermediate(t);
+   TUASSERTE(size_t, 4, ers.size());
+      // the next interval needs one more node
+   t += 86400.0;
+   ers.celestialToIntermediate(t);
+   TUASSERTE(size_t, 5, ers.size());
+   TUCSM("clear");
+   ers.clear();
+   TUASSERTE(size_t, 0, ers.size());
+   ers.celestialToIntermediate(t);
+   TUASSERTE(size_t, 4, ers.size());
+   TURETURN();
+}
+
+
+double EarthRotationService_T ::
+maxDiff(EarthRotationService& ers, bool reduced)
+{
+   EarthOrientation eo;
+   eo.convention = ers.getConvention();
+   double rv = 0.0;
+   for (int i = 0; i < 500; i++)
+   {
+         // epochs from 2000 to 2021, with EOPs of typical size
+      EphTime t(51544 + (i * 7919) % 7700, ::fmod(i * 3163.7, 86400.0),
+                TimeSystem::UTC);
+      eo.xp = 0.3 * ::sin(i * 0.37);
+      eo.yp = 0.4 * ::cos(i * 0.53);
+      eo.UT1mUTC = 0.9 * ::sin(i * 0.71);
+      Matrix<double> expected(eo.ECEFtoInertial(t, reduced));
+      SMatrix<double,3,3> got(ers.ECEFtoInertial(eo, t, reduced));
+      for (size_t r = 0; r < 3; r++)
+      {
+         for (size_t c = 0; c < 3; c++)
+         {
+            rv = std::max(rv, ::fabs(expected(r,c) - got(r,c)));
+         }
+      }
+   }
+   return rv;
+}
+
+
+int main()
+{
+   EarthRotationService_T testClass;
+   unsigned errorTotal = 0;
+
+   errorTotal += testClass.constructorTest();
+   errorTotal += testClass.ECEFtoInertialTest();
+   errorTotal += testClass.cacheTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+
+   return errorTotal;
+}
@@ -0,0 +1,380 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/// @file ObsColumnStore_T.cpp Test class ObsColumnStore
+
+#include <iostream>
+#include <vector>
+#include "ObsColumnStore.hpp"
+#include "CivilTime.hpp"
+#include "Rinex3ObsFileLoader.hpp"
+#include "Rinex3ObsStream.hpp"
+#include "TestUtil.hpp"
+
+using namespace std;
+using namespace gnsstk;
+
+class ObsColumnStore_T
+{
+public:
+   ObsColumnStore_T();
+
+      /// Make sure rows and epochs are added as documented.
+   unsigned addTest();
+      /// Make sure adding obs types extends the existing columns.
+   unsigned numTypesTest();
+      /// Make sure the epochs are rebuilt from the columns.
+   unsigned getEpochsTest();
+      /** Make sure Rinex3ObsFileLoader::getStore() returns the
+       * RinexDatum read from the file, including zero observations
+       * and blank LLI/SSI. */
+   unsigned loaderTest();
+
+      /// Return a datum, with LLI or SSI blank if negative.
+   static RinexDatum datum(double data, short lli, short ssi);
+      /// Return true if every field of l and r is the same.
+   static bool same(const RinexDatum& l, const RinexDatum& r);
+      /** Fill store with 3 epochs, the second having no data, of
+       * G01 and G05 with 2 obs types. */
+   void fill(ObsColumnStore& store);
+
+   CommonTime t0;
+   RinexSatID g01, g05;
+};
+
+
+ObsColumnStore_T ::
+ObsColumnStore_T()
+      : t0(CivilTime(2021,1,1,0,0,0.0,TimeSystem::GPS)),
+        g01(1, SatelliteSystem::GPS),
+        g05(5, SatelliteSystem::GPS)
+{
+}
+
+
+RinexDatum ObsColumnStore_T ::
+datum(double data, short lli, short ssi)
+{
+   RinexDatum rv;
+   rv.data = data;
+   rv.dataBlank = false;
+   rv.lli = (lli < 0 ? 0 : lli);
+   rv.lliBlank = (lli < 0);
+   rv.ssi = (ssi < 0 ? 0 : ssi);
+   rv.ssiBlank = (ssi < 0);
+   return rv;
+}
+
+
+bool ObsColumnStore_T ::
+same(const RinexDatum& l, const RinexDatum& r)
+{
+   return ((l.data == r.data) && (l.dataBlank == r.dataBlank) &&
+           (l.lli == r.lli) && (l.lliBlank == r.lliBlank) &&
+           (l.ssi == r.ssi) && (l.ssiBlank == r.ssiBlank));
+}
+
+
+void ObsColumnStore_T ::
+fill(ObsColumnStore& store)
+{
+   store.setNumTypes(2);
+   store.addEpoch(t0, 0, 1.e-4);
+   ObsColumnStore::SatColumns& c1(store.addRow(g05));
+   c1.set(0, datum(20000000.123, 1, 7));
+   c1.set(1, datum(105000.456, -1, 6));
+   store.addRow(g01).set(1, datum(104000.789, -1, -1));
+      // no rows, so not stored
+   store.addEpoch(t0 + 30, 0, 2.e-4);
+   store.addEpoch(t0 + 60, 1, 3.e-4);
+   store.addRow(g05).set(0, datum(20000100.123, -1, -1));
+}
+
+
+unsigned ObsColumnStore_T ::
+addTest()
+{
+   TUDEF("ObsColumnStore", "addRow");
+   ObsColumnStore store;
+   TUASSERTE(size_t, 0, store.size());
+   TUASSERT(store.find(g05) == nullptr);
+   fill(store);
+   TUASSERTE(size_t, 2, store.size());
+   TUASSERTE(size_t, 2, store.getSats().size());
+   TUASSERTE(CommonTime, t0, store.getTimes()[0]);
+   TUASSERTE(CommonTime, t0 + 60, store.getTimes()[1]);
+   TUASSERTE(short, 1, store.getEpochFlags()[1]);
+   TUASSERTFE(3.e-4, store.getClockOffsets()[1]);
+   const ObsColumnStore::SatColumns *cols = store.find(g05);
+   TUASSERT(cols != nullptr);
+   if (cols != nullptr)
+   {
+      TUASSERTE(size_t, 2, cols->size());
+      TUASSERTE(unsigned, 0, cols->epoch[0]);
+      TUASSERTE(unsigned, 1, cols->epoch[1]);
+      TUASSERTFE(20000000.123, cols->data[0][0]);
+      TUASSERTFE(105000.456, cols->data[1][0]);
+      TUASSERTFE(20000100.123, cols->data[0][1]);
+      TUASSERTFE(0.0, cols->data[1][1]);
+      TUASSERTE(int, 1, cols->lli[0][0]);
+      TUASSERTE(int, 7, cols->ssi[0][0]);
+      TUASSERTE(int, 0, cols->lli[1][0]);
+      TUASSERTE(int, 6, cols->ssi[1][0]);
+   }
+   cols = store.find(g01);
+   TUASSERT(cols != nullptr);
+   if (cols != nullptr)
+   {
+      TUASSERTE(size_t, 1, cols->size());
+      TUASSERTFE(0.0, cols->data[0][0]);
+      TUASSERTFE(104000.789, cols->data[1][0]);
+   }
+   store.shrink();
+   TUASSERTE(size_t, 2, store.size());
+   store.clear();
+   TUASSERTE(size_t, 0, store.size());
+   TUASSERTE(size_t, 0, store.getSats().size());
+   TUASSERTE(size_t, 2, store.getNumTypes());
+   TURETURN();
+}
+
+
+unsigned ObsColumnStore_T ::
+numTypesTest()
+{
+   TUDEF("ObsColumnStore", "setNumTypes");
+   ObsColumnStore store;
+   fill(store);
+   store.setNumTypes(3);
+   TUASSERTE(size_t, 3, store.getNumTypes());
+   const ObsColumnStore::SatColumns *cols = store.find(g05);
+   TUASSERT(cols != nullptr);
+   if (cols != nullptr)
+   {
+      TUASSERTE(size_t, 3, cols->data.size());
+      TUASSERTE(size_t, 2, cols->data[2].size());
+      TUASSERTE(size_t, 2, cols->lli[2].size());
+      TUASSERTE(size_t, 2, cols->ssi[2].size());
+      TUASSERTFE(0.0, cols->data[2][1]);
+   }
+      // can't be reduced
+   store.setNumTypes(1);
+   TUASSERTE(size_t, 3, store.getNumTypes());
+      // new rows get all types
+   store.addEpoch(t0 + 90, 0, 0.0);
+   store.addRow(g01).set(2, datum(1.0, -1, -1));
+   cols = store.find(g01);
+   TUASSERT(cols != nullptr);
+   if (cols != nullptr)
+   {
+      TUASSERTE(size_t, 2, cols->size());
+      TUASSERTE(size_t, 2, cols->data[2].size());
+      TUASSERTFE(1.0, cols->data[2][1]);
+   }
+   TURETURN();
+}
+
+
+unsigned ObsColumnStore_T ::
+getEpochsTest()
+{
+   TUDEF("ObsColumnStore", "getEpochs");
+   ObsColumnStore store;
+   fill(store);
+   vector<Rinex3ObsData> epochs(5);
+   store.getEpochs(epochs);
+   TUASSERTE(size_t, 2, epochs.size());
+   if (epochs.size() != 2)
+   {
+      TURETURN();
+   }
+   TUASSERTE(CommonTime, t0, epochs[0].time);
+   TUASSERTE(short, 0, epochs[0].epochFlag);
+   TUASSERTFE(1.e-4, epochs[0].clockOffset);
+   TUASSERTE(short, 2, epochs[0].numSVs);
+   TUASSERTE(size_t, 2, epochs[0].obs.size());
+   TUASSERTE(CommonTime, t0 + 60, epochs[1].time);
+   TUASSERTE(short, 1, epochs[1].epochFlag);
+   TUASSERTE(short, 1, epochs[1].numSVs);
+   TUASSERTE(size_t, 1, epochs[1].obs.size());
+   const vector<RinexDatum>& g05obs(epochs[0].obs[g05]);
+   TUASSERTE(size_t, 2, g05obs.size());
+   TUASSERTFE(20000000.123, g05obs[0].data);
+   TUASSERTE(bool, false, g05obs[0].dataBlank);
+   TUASSERTE(short, 1, g05obs[0].lli);
+   TUASSERTE(bool, false, g05obs[0].lliBlank);
+   TUASSERTE(short, 7, g05obs[0].ssi);
+   TUASSERTE(bool, true, g05obs[1].lliBlank);
+   TUASSERTE(short, 6, g05obs[1].ssi);
+      // missing data are default datums
+   const vector<RinexDatum>& g01obs(epochs[0].obs[g01]);
+   TUASSERTE(size_t, 2, g01obs.size());
+   TUASSERTE(bool, false, g01obs[0].dataBlank);
+   TUASSERTFE(0.0, g01obs[0].data);
+   TUASSERTFE(104000.789, g01obs[1].data);
+   TUASSERTE(bool, true, g01obs[1].ssiBlank);
+      // zero data and LLI/SSI of zero are not the same as missing or blank
+   store.setNumTypes(3);
+   store.addEpoch(t0 + 90, 0, 0.0);
+   ObsColumnStore::SatColumns& cols(store.addRow(g01));
+   cols.set(0, datum(0.0, 0, -1));
+   cols.set(1, datum(104100.789, -1, 0));
+   RinexDatum blank;
+   blank.dataBlank = blank.lliBlank = blank.ssiBlank = true;
+   cols.set(2, blank);
+   store.getEpochs(epochs);
+   TUASSERTE(size_t, 3, epochs.size());
+   if (epochs.size() != 3)
+   {
+      TURETURN();
+   }
+   const vector<RinexDatum>& zeros(epochs[2].obs[g01]);
+   TUASSERTE(size_t, 3, zeros.size());
+   TUASSERT(same(datum(0.0, 0, -1), zeros[0]));
+   TUASSERT(same(datum(104100.789, -1, 0), zeros[1]));
+   TUASSERT(same(blank, zeros[2]));
+   TURETURN();
+}
+
+
+unsigned ObsColumnStore_T ::
+loaderTest()
+{
+   TUDEF("Rinex3ObsFileLoader", "getStore");
+   string fn(getPathTestTemp() + getFileSep() +
+             "test_output_ObsColumnStore.obs");
+   {
+         // observations are F14.3 followed by the LLI and SSI
+      ofstream out(fn.c_str());
+      out <<
+         "     3.00           OBSERVATION DATA    G (GPS)             RINEX VERSION / TYPE\n"
+         "ObsColumnStore_T    test                20210101 000000 UTC PGM / RUN BY / DATE\n"
+         "TEST                                                        MARKER NAME\n"
+         "test                test                                    OBSERVER / AGENCY\n"
+         "1                   test                test                REC # / TYPE / VERS\n"
+         "1                   test                                    ANT # / TYPE\n"
+         "  -740289.8363 -5457071.7414  3207245.6207                  APPROX POSITION XYZ\n"
+         "        0.0000        0.0000        0.0000                  ANTENNA: DELTA H/E/N\n"
+         "G    3 C1C L1C S1C                                          SYS / # / OBS TYPES\n"
+         "    30.000                                                  INTERVAL\n"
+         "  2021     1     1     0     0    0.0000000     GPS         TIME OF FIRST OBS\n"
+         "                                                            END OF HEADER\n"
+         "> 2021 01 01 00 00  0.0000000  0  2\n"
+            // blank LLI, LLI of 0, blank LLI and SSI
+         "G01  20000000.123 7    105000.45606        45.000  \n"
+            // a real zero observation
+         "G05         0.000 5    105100.45615        44.000  \n"
+         "> 2021 01 01 00 00 30.0000000  0  1\n"
+            // LLI of 0 and blank SSI, a blank observation
+         "G01  20000100.1230                         45.500 0\n";
+   }
+   Rinex3ObsFileLoader loader(fn);
+   TUASSERT(loader.loadObsID("GC1C"));
+   TUASSERT(loader.loadObsID("GL1C"));
+   TUASSERT(loader.loadObsID("GS1C"));
+   loader.saveTheData(true);
+   string errmsg, msg;
+   TUASSERTE(int, 1, loader.loadFiles(errmsg, msg));
+   TUASSERTE(string, "", errmsg);
+   const vector<Rinex3ObsData>& store(loader.getStore());
+   TUASSERTE(size_t, 2, store.size());
+      // The loader has always treated an observation of exactly
+      // zero as missing, so that is not stored.  Everything else
+      // must be the datum as read.
+   Rinex3ObsStream strm(fn.c_str());
+   Rinex3ObsHeader hdr;
+   Rinex3ObsData rod;
+   strm >> hdr;
+   size_t nepoch = 0;
+   unsigned zeros = 0, lliBlank = 0, lliZero = 0;
+   while (strm >> rod)
+   {
+      TUASSERT(nepoch < store.size());
+      if (nepoch >= store.size())
+         break;
+      const Rinex3ObsData& got(store[nepoch++]);
+      TUASSERTE(CommonTime, rod.time, got.time);
+      TUASSERTE(size_t, rod.obs.size(), got.obs.size());
+      for (const auto& sati : rod.obs)
+      {
+         auto goti = got.obs.find(sati.first);
+         TUASSERT(goti != got.obs.end());
+         if (goti == got.obs.end())
+            continue;
+         TUASSERTE(size_t, sati.second.size(), goti->second.size());
+         for (size_t i = 0; i < sati.second.size() &&
+                 i < goti->second.size(); i++)
+         {
+            const RinexDatum& exp(sati.second[i]);
+            if (exp.data == 0.0)
+            {
+               zeros++;
+               TUASSERT(same(RinexDatum(), goti->second[i]));
+               continue;
+            }
+            TUASSERT(same(exp, goti->second[i]));
+            if (exp.lliBlank)
+               lliBlank++;
+            else if (exp.lli == 0)
+               lliZero++;
+         }
+      }
+   }
+   TUASSERTE(size_t, store.size(), nepoch);
+      // make sure the file has the cases of interest
+   TUASSERTE(unsigned, 2, zeros);
+   TUASSERT(lliBlank > 0);
+   TUASSERTE(unsigned, 2, lliZero);
+   TURETURN();
+}
+
+
+int main()
+{
+   ObsColumnStore_T testClass;
+   unsigned errorTotal = 0;
+
+   errorTotal += testClass.addTest();
+   errorTotal += testClass.numTypesTest();
+   errorTotal += testClass.getEpochsTest();
+   errorTotal += testClass.loaderTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+
+   return errorTotal;
+}
@@ -0,0 +1,317 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+
+/// @file SolarSystemEphemeris_T.cpp Test class SolarSystemEphemeris
+
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <utility>
+#include <vector>
+#include "SolarSystemEphemeris.hpp"
+#include "TestUtil.hpp"
+
+using namespace std;
+using namespace gnsstk;
+
+class SolarSystemEphemeris_T
+{
+public:
+   SolarSystemEphemeris_T();
+
+      /** Make sure the mapped file gives the same results as the
+       * stream, for all bodies and centers. */
+   unsigned mappedTest();
+      /// Make sure the vector form matches the single time form.
+   unsigned batchTest();
+      /// Make sure times outside the data are rejected.
+   unsigned rangeTest();
+
+      /** Write a binary ephemeris file, laid out as DE405, of nRec
+       * records of made up coefficients, beginning at startJD. */
+   void writeFile(const string& fn, int nRec);
+
+      /// Times to test, in and between records, MJD.
+   vector<double> times;
+
+   string fileName;
+   double startJD, span;
+   int nRec;
+};
+
+
+SolarSystemEphemeris_T ::
+SolarSystemEphemeris_T()
+      : fileName(getPathTestTemp() + getFileSep() +
+                 "SolarSystemEphemeris_T.bin"),
+        startJD(2458848.5),
+        span(32.0),
+        nRec(6)
+{
+   writeFile(fileName, nRec);
+   double startMJD = startJD - 2400000.5;
+   for (int i = 0; i <= 4 * nRec; i++)
+   {
+      times.push_back(startMJD + i * span / 4.0 + (i % 3) * 0.377);
+   }
+   times.push_back(startMJD);
+   times.push_back(startMJD + span);
+   times.push_back(startMJD + nRec * span);
+}
+
+
+void SolarSystemEphemeris_T ::
+writeFile(const string& fn, int nRec)
+{
+      // DE405: offset, number of coefficients and sets for each body
+   int offset[13], ncoeff[13] = { 14, 10, 13, 11, 8, 7, 6, 6, 6, 13, 11, 10, 10 };
+   int nsets[13] = { 4, 2, 2, 1, 1, 1, 1, 1, 1, 8, 2, 4, 4 };
+   int Ncoeff = 2;
+   for (int i = 0; i < 13; i++)
+   {
+      offset[i] = Ncoeff + 1;
+      Ncoeff += ncoeff[i] * nsets[i] * (i == 11 ? 2 : 3);
+   }
+   double AU = 149597870.691, EMRAT = 81.30056, DENUM = 405.0;
+   double endJD = startJD + nRec * span;
+
+   ofstream strm(fn.c_str(), ios::out | ios::binary);
+   vector<char> rec(Ncoeff * sizeof(double), ' ');
+   char *p = &rec[0];
+   for (int i = 0; i < 3; i++, p += 84)
+   {
+      memcpy(p, "made up", 7);
+   }
+   const char *names[3] = { "AU", "DENUM", "EMRAT" };
+   for (int i = 0; i < 400; i++, p += 6)
+   {
+      if (i < 3)
+      {
+         memcpy(p, names[i], strlen(names[i]));
+      }
+   }
+   memcpy(p, &startJD, 8); p += 8;
+   memcpy(p, &endJD, 8); p += 8;
+   memcpy(p, &span, 8); p += 8;
+   memcpy(p, &Ncoeff, 4); p += 4;
+   memcpy(p, &AU, 8); p += 8;
+   memcpy(p, &EMRAT, 8); p += 8;
+   for (int i = 0; i < 12; i++)
+   {
+      memcpy(p, &offset[i], 4); p += 4;
+      memcpy(p, &ncoeff[i], 4); p += 4;
+      memcpy(p, &nsets[i], 4); p += 4;
+   }
+   memcpy(p, &DENUM, 8); p += 8;
+   memcpy(p, &offset[12], 4); p += 4;
+   memcpy(p, &ncoeff[12], 4); p += 4;
+   memcpy(p, &nsets[12], 4); p += 4;
+   strm.write(&rec[0], rec.size());
+
+      // second header record, padded as by writeBinaryFile()
+   vector<double> values(400, 0.0);
+   values[0] = AU;
+   values[1] = DENUM;
+   values[2] = EMRAT;
+   strm.write((const char *)&values[0], 400 * sizeof(double));
+   string pad((400 - 3) * sizeof(double), ' ');
+   strm.write(pad.c_str(), pad.size());
+
+   vector<double> data(Ncoeff);
+   for (int k = 0; k < nRec; k++)
+   {
+      data[0] = startJD + k * span;
+      data[1] = data[0] + span;
+      for (int i = 2; i < Ncoeff; i++)
+      {
+         data[i] = 1.e6 * ::sin(i * 0.731 + k * 1.37) / (1 + (i % 14));
+      }
+      strm.write((const char *)&data[0], Ncoeff * sizeof(double));
+   }
+}
+
+
+unsigned SolarSystemEphemeris_T ::
+mappedTest()
+{
+   TUDEF("SolarSystemEphemeris", "initializeWithMappedFile");
+   SolarSystemEphemeris streamed, mapped;
+   TUASSERTE(int, 0, streamed.initializeWithBinaryFile(fileName));
+   TUASSERTE(int, 0, mapped.initializeWithMappedFile(fileName));
+   TUASSERTE(int, 405, mapped.EphNumber());
+   TUASSERTFE(149597870.691, mapped.AU());
+   TUASSERTFE(streamed.startTimeMJD(), mapped.startTimeMJD());
+   TUASSERTFE(streamed.endTimeMJD(), mapped.endTimeMJD());
+   bool same = true;
+   for (double mjd : times)
+   {
+      for (int target = SolarSystemEphemeris::idMercury;
+           target <= SolarSystemEphemeris::idLibrations; target++)
+      {
+         for (int center = SolarSystemEphemeris::idNone;
+              center <= SolarSystemEphemeris::idEarthMoonBarycenter; center++)
+         {
+            double expPV[6], gotPV[6];
+            for (bool km : { true, false })
+            {
+               streamed.relativeInertialPositionVelocity(
+                  mjd, SolarSystemEphemeris::Planet(target),
+                  SolarSystemEphemeris::Planet(center), expPV, km);
+               mapped.relativeInertialPositionVelocity(
+                  mjd, SolarSystemEphemeris::Planet(target),
+                  SolarSystemEphemeris::Planet(center), gotPV, km);
+               same &= (memcmp(expPV, gotPV, sizeof(expPV)) == 0);
+            }
+         }
+      }
+   }
+   TUASSERT(same);
+
+      // the mapped records move with the object
+   double expPV[6], gotPV[6];
+   streamed.relativeInertialPositionVelocity(
+      times[5], SolarSystemEphemeris::idSun, SolarSystemEphemeris::idEarth,
+      expPV);
+   SolarSystemEphemeris *original = new SolarSystemEphemeris;
+   TUASSERTE(int, 0, original->initializeWithMappedFile(fileName));
+   SolarSystemEphemeris moved(std::move(*original));
+   delete original;
+   moved.relativeInertialPositionVelocity(
+      times[5], SolarSystemEphemeris::idSun, SolarSystemEphemeris::idEarth,
+      gotPV);
+   TUASSERTE(int, 0, memcmp(expPV, gotPV, sizeof(expPV)));
+
+      // reading the file with the stream again forgets the mapping
+   TUCSM("initializeWithBinaryFile");
+   TUASSERTE(int, 0, mapped.initializeWithBinaryFile(fileName));
+   mapped.relativeInertialPositionVelocity(
+      times[5], SolarSystemEphemeris::idSun, SolarSystemEphemeris::idEarth,
+      gotPV);
+   TUASSERTE(int, 0, memcmp(expPV, gotPV, sizeof(expPV)));
+   TURETURN();
+}
+
+
+unsigned SolarSystemEphemeris_T ::
+batchTest()
+{
+   TUDEF("SolarSystemEphemeris", "relativeInertialPositionVelocity");
+   SolarSystemEphemeris single, batch;
+   TUASSERTE(int, 0, single.initializeWithBinaryFile(fileName));
+   TUASSERTE(int, 0, batch.initializeWithMappedFile(fileName));
+   vector<SolarSystemEphemeris::Planet> targets = {
+      SolarSystemEphemeris::idSun, SolarSystemEphemeris::idMoon,
+      SolarSystemEphemeris::idEarth, SolarSystemEphemeris::idJupiter,
+      SolarSystemEphemeris::idNutations };
+      // out of order, to make the records change back and forth
+   vector<double> mjds(times.rbegin(), times.rend());
+   mjds.insert(mjds.end(), times.begin(), times.end());
+      // and a dense arc, so many times share a record and a set
+   for (int i = 0; i < 1000; i++)
+   {
+      mjds.push_back(times[0] + i / 24.0);
+   }
+   vector<double> pv;
+   batch.relativeInertialPositionVelocity(mjds, targets,
+                                          SolarSystemEphemeris::idEarth, pv);
+   TUASSERTE(size_t, 6 * mjds.size() * targets.size(), pv.size());
+   bool same = true;
+   for (size_t i = 0; i < mjds.size(); i++)
+   {
+      for (size_t j = 0; j < targets.size(); j++)
+      {
+         double expPV[6];
+         single.relativeInertialPositionVelocity(
+            mjds[i], targets[j], SolarSystemEphemeris::idEarth, expPV);
+         same &= (memcmp(expPV, &pv[6 * (j * mjds.size() + i)],
+                         sizeof(expPV)) == 0);
+      }
+   }
+   TUASSERT(same);
+
+      // no times gives no results
+   batch.relativeInertialPositionVelocity(vector<double>(), targets,
+                                          SolarSystemEphemeris::idEarth, pv);
+   TUASSERTE(size_t, 0, pv.size());
+   TURETURN();
+}
+
+
+unsigned SolarSystemEphemeris_T ::
+rangeTest()
+{
+   TUDEF("SolarSystemEphemeris", "relativeInertialPositionVelocity");
+   SolarSystemEphemeris sse;
+   double pv[6];
+   TUTHROW(sse.relativeInertialPositionVelocity(
+              times[0], SolarSystemEphemeris::idSun,
+              SolarSystemEphemeris::idEarth, pv));
+   TUASSERTE(int, 0, sse.initializeWithMappedFile(fileName));
+   double startMJD = startJD - 2400000.5;
+   TUTHROW(sse.relativeInertialPositionVelocity(
+              startMJD - 0.001, SolarSystemEphemeris::idSun,
+              SolarSystemEphemeris::idEarth, pv));
+   TUTHROW(sse.relativeInertialPositionVelocity(
+              startMJD + nRec * span + 0.001, SolarSystemEphemeris::idSun,
+              SolarSystemEphemeris::idEarth, pv));
+   vector<double> pvs;
+   vector<double> mjds = { startMJD + 1.0, startMJD - 1.0 };
+   TUTHROW(sse.relativeInertialPositionVelocity(
+              mjds, { SolarSystemEphemeris::idSun },
+              SolarSystemEphemeris::idEarth, pvs));
+   TUCSM("initializeWithMappedFile");
+   TUTHROW(sse.initializeWithMappedFile(fileName + ".missing"));
+   TURETURN();
+}
+
+
+int main()
+{
+   SolarSystemEphemeris_T testClass;
+   unsigned errorTotal = 0;
+
+   errorTotal += testClass.mappedTest();
+   errorTotal += testClass.batchTest();
+   errorTotal += testClass.rangeTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+
+   return errorTotal;
+}
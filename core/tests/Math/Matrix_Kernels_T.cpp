@@ -0,0 +1,284 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/// @file Matrix_Kernels_T.cpp Test the Matrix<T> operators that use
+/// MatrixKernels, and Matrix and Vector move semantics.
+
+#include <iostream>
+#include "Matrix.hpp"
+#include "TestUtil.hpp"
+
+using namespace std;
+using namespace gnsstk;
+
+class Matrix_Kernels_T
+{
+public:
+      /// Make sure Matrix * Matrix matches the element-wise operator.
+   unsigned multiplyTest();
+      /// Make sure Matrix * Vector and Vector * Matrix match too.
+   unsigned vectorTest();
+      /// Make sure transpose() matches the element-wise version.
+   unsigned transposeTest();
+      /// Make sure transposeTimes and transposeWeighted match the
+      /// expressions they replace.
+   unsigned transposeTimesTest();
+      /// Make sure Vector and Matrix can be moved.
+   unsigned moveTest();
+
+      /// Return an r by c matrix with distinct, inexact elements.
+   static Matrix<double> fill(size_t r, size_t c, double seed);
+      /// Return the number of elements that differ between a and b.
+   template <class Base1, class Base2>
+   static unsigned countDiffs(const ConstMatrixBase<double, Base1>& a,
+                              const ConstMatrixBase<double, Base2>& b);
+      /// Return the number of elements that differ between a and b.
+   static unsigned countDiffs(const Vector<double>& a,
+                              const Vector<double>& b);
+
+      /// Sizes of the matrices tested, spanning the kernel blocks.
+   static const size_t sizes[];
+   static const size_t numSizes;
+};
+
+
+const size_t Matrix_Kernels_T::sizes[] = { 1, 3, 4, 5, 8, 33, 129, 200 };
+const size_t Matrix_Kernels_T::numSizes = sizeof(sizes)/sizeof(sizes[0]);
+
+
+Matrix<double> Matrix_Kernels_T ::
+fill(size_t r, size_t c, double seed)
+{
+   Matrix<double> rv(r, c);
+   for (size_t i = 0; i < r; i++)
+      for (size_t j = 0; j < c; j++)
+         rv(i,j) = ::sin(seed + 1.1*i + 0.37*j) / 3.0;
+   return rv;
+}
+
+
+template <class Base1, class Base2>
+unsigned Matrix_Kernels_T ::
+countDiffs(const ConstMatrixBase<double, Base1>& a,
+           const ConstMatrixBase<double, Base2>& b)
+{
+   if ((a.rows() != b.rows()) || (a.cols() != b.cols()))
+      return a.size() + b.size() + 1;
+   unsigned rv = 0;
+   for (size_t i = 0; i < a.rows(); i++)
+      for (size_t j = 0; j < a.cols(); j++)
+         if (a(i,j) != b(i,j))
+            rv++;
+   return rv;
+}
+
+
+unsigned Matrix_Kernels_T ::
+countDiffs(const Vector<double>& a, const Vector<double>& b)
+{
+   if (a.size() != b.size())
+      return a.size() + b.size() + 1;
+   unsigned rv = 0;
+   for (size_t i = 0; i < a.size(); i++)
+      if (a[i] != b[i])
+         rv++;
+   return rv;
+}
+
+
+unsigned Matrix_Kernels_T ::
+multiplyTest()
+{
+   TUDEF("Matrix", "operator*");
+   for (size_t i = 0; i < numSizes; i++)
+   {
+      for (size_t j = 0; j < numSizes; j += 2)
+      {
+         size_t m = sizes[i], n = sizes[j], p = sizes[(i+j) % numSizes];
+         Matrix<double> a(fill(m, p, 0.1)), b(fill(p, n, 0.7));
+            // slices use the element-wise operator
+         Matrix<double> expect(ConstMatrixSlice<double>(a) *
+                               ConstMatrixSlice<double>(b));
+         Matrix<double> got(a * b);
+         TUASSERTE(unsigned, 0, countDiffs(expect, got));
+      }
+   }
+   Matrix<double> a(3, 4), b(3, 4);
+   TUTHROW(a * b);
+   TURETURN();
+}
+
+
+unsigned Matrix_Kernels_T ::
+vectorTest()
+{
+   TUDEF("Matrix", "operator*");
+   for (size_t i = 0; i < numSizes; i++)
+   {
+      size_t m = sizes[i], n = sizes[numSizes-1-i];
+      Matrix<double> a(fill(m, n, 0.3));
+      Vector<double> x(n), y(m);
+      for (size_t k = 0; k < n; k++)
+         x[k] = 1.0 / (k + 3.0);
+      for (size_t k = 0; k < m; k++)
+         y[k] = 1.0 / (k + 7.0);
+      Vector<double> expect(ConstMatrixSlice<double>(a) *
+                            ConstVectorSlice<double>(x));
+      TUASSERTE(unsigned, 0, countDiffs(expect, a * x));
+      expect = ConstVectorSlice<double>(y) * ConstMatrixSlice<double>(a);
+      TUASSERTE(unsigned, 0, countDiffs(expect, y * a));
+   }
+   Matrix<double> a(3, 4);
+   Vector<double> x(3);
+   TUTHROW(a * x);
+   TUTHROW(Vector<double>(4) * a);
+   TURETURN();
+}
+
+
+unsigned Matrix_Kernels_T ::
+transposeTest()
+{
+   TUDEF("Matrix", "transpose");
+   for (size_t i = 0; i < numSizes; i++)
+   {
+      for (size_t j = 0; j < numSizes; j++)
+      {
+         Matrix<double> a(fill(sizes[i], sizes[j], 0.5));
+         Matrix<double> expect(transpose(ConstMatrixSlice<double>(a)));
+         TUASSERTE(unsigned, 0, countDiffs(expect, transpose(a)));
+      }
+   }
+   TURETURN();
+}
+
+
+unsigned Matrix_Kernels_T ::
+transposeTimesTest()
+{
+   TUDEF("Matrix", "transposeTimes");
+   for (size_t i = 0; i < numSizes; i++)
+   {
+      for (size_t j = 0; j < numSizes; j += 3)
+      {
+         size_t m = sizes[i], n = sizes[j];
+         Matrix<double> a(fill(m, n, 0.2)), b(fill(m, n + 2, 0.9)),
+            w(fill(m, m, 1.3));
+         Vector<double> x(m);
+         for (size_t k = 0; k < m; k++)
+            x[k] = 1.0 / (k + 2.0);
+         Matrix<double> at(transpose(a));
+         TUASSERTE(unsigned, 0, countDiffs(at * b, transposeTimes(a, b)));
+         TUASSERTE(unsigned, 0, countDiffs(at * x, transposeTimes(a, x)));
+         TUCSM("transposeWeighted");
+         TUASSERTE(unsigned, 0, countDiffs(at * w * a,
+                                            transposeWeighted(a, w)));
+         TUCSM("transposeTimes");
+      }
+   }
+   Matrix<double> a(3, 4), b(4, 4);
+   TUTHROW(transposeTimes(a, b));
+   TUTHROW(transposeTimes(a, Vector<double>(4)));
+   TUCSM("transposeWeighted");
+   TUTHROW(transposeWeighted(a, Matrix<double>(3, 4)));
+   TUTHROW(transposeWeighted(a, b));
+   TURETURN();
+}
+
+
+unsigned Matrix_Kernels_T ::
+moveTest()
+{
+   TUDEF("Vector", "Vector(Vector&&)");
+   Vector<double> v1(10, 2.5);
+   const double *data = v1.begin();
+   Vector<double> v2(std::move(v1));
+   TUASSERTE(size_t, 0, v1.size());
+   TUASSERTE(size_t, 10, v2.size());
+   TUASSERT(v2.begin() == data);
+   TUASSERTFE(2.5, v2[9]);
+   TUCSM("operator=(Vector&&)");
+   Vector<double> v3(3, 1.0);
+   v3 = std::move(v2);
+   TUASSERTE(size_t, 10, v3.size());
+   TUASSERT(v3.begin() == data);
+      // moved-from vectors are usable
+   v2 = Vector<double>(2, 4.0);
+   TUASSERTE(size_t, 2, v2.size());
+   TUASSERTFE(4.0, v2[1]);
+   v1.resize(4, 1.0);
+   TUASSERTFE(1.0, v1[3]);
+
+   TUCSM("Matrix(Matrix&&)");
+   Matrix<double> m1(fill(4, 3, 0.0));
+   Matrix<double> copy(m1);
+   data = m1.begin();
+   Matrix<double> m2(std::move(m1));
+   TUASSERTE(size_t, 0, m1.size());
+   TUASSERTE(size_t, 0, m1.rows());
+   TUASSERTE(size_t, 4, m2.rows());
+   TUASSERTE(size_t, 3, m2.cols());
+   TUASSERT(m2.begin() == data);
+   TUASSERTE(unsigned, 0, countDiffs(copy, m2));
+   TUCSM("operator=(Matrix&&)");
+   Matrix<double> m3(2, 2, 1.0);
+   m3 = std::move(m2);
+   TUASSERTE(size_t, 4, m3.rows());
+   TUASSERT(m3.begin() == data);
+   TUASSERTE(unsigned, 0, countDiffs(copy, m3));
+   m2 = copy;
+   TUASSERTE(unsigned, 0, countDiffs(copy, m2));
+   TURETURN();
+}
+
+
+int main()
+{
+   Matrix_Kernels_T testClass;
+   unsigned errorTotal = 0;
+
+   errorTotal += testClass.multiplyTest();
+   errorTotal += testClass.vectorTest();
+   errorTotal += testClass.transposeTest();
+   errorTotal += testClass.transposeTimesTest();
+   errorTotal += testClass.moveTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+
+   return errorTotal;
+}
@@ -0,0 +1,360 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/// @file SMatrix_T.cpp Test the fixed size SMatrix and SVector classes
+/// against Matrix and Vector.
+
+#include <iostream>
+#include "SMatrix.hpp"
+#include "TestUtil.hpp"
+
+using namespace std;
+using namespace gnsstk;
+
+class SMatrix_T
+{
+public:
+      /// Check SVector arithmetic and conversion to and from Vector.
+   unsigned vectorTest();
+      /// Check the std::valarray compatible members of SVector.
+   unsigned valarrayTest();
+      /// Check SMatrix construction and conversion to and from Matrix.
+   unsigned constructTest();
+      /// Make sure the products match the Matrix operators exactly.
+   unsigned multiplyTest();
+      /// Check the closed form and general inverses.
+   unsigned inverseTest();
+      /// Check cholesky, choleskySolve and inverseChol.
+   unsigned choleskyTest();
+
+      /// Return an R by C matrix with distinct, inexact elements.
+   template <size_t R, size_t C>
+   static SMatrix<double,R,C> fill(double seed);
+      /// Return a symmetric positive definite N by N matrix.
+   template <size_t N>
+   static SMatrix<double,N,N> spd(double seed);
+      /// Return the largest absolute difference between a and b.
+   template <class Base1, class Base2>
+   static double maxDiff(const ConstMatrixBase<double, Base1>& a,
+                         const ConstMatrixBase<double, Base2>& b);
+      /// Check inverse(m) against the Matrix inverse and identity.
+   template <size_t N>
+   static unsigned checkInverse(double seed);
+};
+
+
+template <size_t R, size_t C>
+SMatrix<double,R,C> SMatrix_T ::
+fill(double seed)
+{
+   SMatrix<double,R,C> rv;
+   for (size_t i = 0; i < R; i++)
+      for (size_t j = 0; j < C; j++)
+         rv(i,j) = ::sin(seed + 1.1*i + 0.37*j) / 3.0 + (i == j ? 1.0 : 0.0);
+   return rv;
+}
+
+
+template <size_t N>
+SMatrix<double,N,N> SMatrix_T ::
+spd(double seed)
+{
+   SMatrix<double,N,N> a(fill<N,N>(seed));
+   return transposeTimes(a, a) + ident<double,N>();
+}
+
+
+template <class Base1, class Base2>
+double SMatrix_T ::
+maxDiff(const ConstMatrixBase<double, Base1>& a,
+        const ConstMatrixBase<double, Base2>& b)
+{
+   if ((a.rows() != b.rows()) || (a.cols() != b.cols()))
+      return 1e99;
+   double rv = 0;
+   for (size_t i = 0; i < a.rows(); i++)
+      for (size_t j = 0; j < a.cols(); j++)
+         rv = std::max(rv, ::fabs(a(i,j) - b(i,j)));
+   return rv;
+}
+
+
+unsigned SMatrix_T ::
+vectorTest()
+{
+   TUDEF("SVector", "SVector()");
+   SVector<double,3> zero;
+   TUASSERTE(size_t, 3, zero.size());
+   TUASSERTFE(0.0, zero[2]);
+   TUCSM("SVector(x,y,z)");
+   SVector<double,3> a(1.0, 2.0, 3.0), b(-2.0, 0.5, 4.0);
+   TUASSERTFE(2.0, a(1));
+   TUCSM("operator+");
+   SVector<double,3> c(a + b);
+   TUASSERTFE(-1.0, c[0]);
+   TUASSERTFE(7.0, c[2]);
+   TUCSM("operator-");
+   c = a - b;
+   TUASSERTFE(3.0, c[0]);
+   c = -a;
+   TUASSERTFE(-3.0, c[2]);
+   TUCSM("operator*");
+   c = 2.0 * a;
+   TUASSERTFE(4.0, c[1]);
+   c = a / 2.0;
+   TUASSERTFE(1.5, c[2]);
+   TUCSM("dot");
+   TUASSERTFE(11.0, dot(a, b));
+   TUCSM("norm");
+   TUASSERTFE(::sqrt(14.0), norm(a));
+   TUCSM("cross");
+   Vector<double> va(a), vb(b), vc(cross(va, vb));
+   c = cross(a, b);
+   for (size_t i = 0; i < 3; i++)
+      TUASSERTFE(vc[i], c[i]);
+   TUCSM("SVector(const ConstVectorBase&)");
+   SVector<double,3> d(vc);
+   TUASSERTFE(vc[1], d[1]);
+   TUTHROW((SVector<double,4>(vc)));
+   TURETURN();
+}
+
+
+unsigned SMatrix_T ::
+valarrayTest()
+{
+   TUDEF("SVector", "sum");
+   SVector<double,3> a(1.0, -2.0, 4.0), b(2.0, 4.0, 8.0);
+   TUASSERTFE(3.0, a.sum());
+   TUCSM("min");
+   TUASSERTFE(-2.0, a.min());
+   TUCSM("max");
+   TUASSERTFE(4.0, a.max());
+   TUCSM("apply");
+   SVector<double,3> c(a.apply(::fabs));
+   TUASSERTFE(2.0, c[1]);
+   TUCSM("operator*");
+   c = a * b;
+   TUASSERTFE(-8.0, c[1]);
+   TUCSM("operator/");
+   c = b / a;
+   TUASSERTFE(2.0, c[2]);
+   TUCSM("operator+");
+   c = a + 1.0;
+   TUASSERTFE(5.0, c[2]);
+   c = 1.0 + a;
+   TUASSERTFE(-1.0, c[1]);
+   TUCSM("operator-");
+   c = a - 1.0;
+   TUASSERTFE(0.0, c[0]);
+   TUCSM("operator[](slice)");
+   std::valarray<double> sl(a[std::slice(1,2,1)]);
+   TUASSERTE(size_t, 2, sl.size());
+   TUASSERTFE(-2.0, sl[0]);
+   TUASSERTFE(4.0, sl[1]);
+   TUCSM("operator std::valarray");
+   std::valarray<double> va(a);
+   va *= 2.0;
+   TUASSERTFE(8.0, va[2]);
+   TUASSERTFE(17.0, std::valarray<double>(a + b).sum());
+   TUCSM("operator=(const std::valarray&)");
+   c = va;
+   TUASSERTFE(-4.0, c[1]);
+   SVector<double,3> d(va);
+   TUASSERTFE(2.0, d[0]);
+   TUTHROW(c = std::valarray<double>(4));
+   TURETURN();
+}
+
+
+unsigned SMatrix_T ::
+constructTest()
+{
+   TUDEF("SMatrix", "SMatrix()");
+   SMatrix<double,2,3> zero;
+   TUASSERTE(size_t, 2, zero.rows());
+   TUASSERTE(size_t, 3, zero.cols());
+   TUASSERTE(size_t, 6, zero.size());
+   TUASSERTFE(0.0, zero(1,2));
+   TUCSM("SMatrix(const ConstMatrixBase&)");
+   SMatrix<double,4,3> s(fill<4,3>(0.5));
+   Matrix<double> m(s);
+   TUASSERTE(size_t, 4, m.rows());
+   TUASSERTE(size_t, 3, m.cols());
+   TUASSERTFE(0.0, maxDiff(s, m));
+   SMatrix<double,4,3> s2(m);
+   TUASSERTFE(0.0, maxDiff(s2, m));
+   TUTHROW((SMatrix<double,3,4>(m)));
+      // storage is column major, like Matrix
+   TUASSERTFE(s(1,0), *(s.begin() + 1));
+   TUASSERTFE(s(0,1), *(s.begin() + 4));
+   TUCSM("col");
+   SVector<double,4> col(s.col(2));
+   TUASSERTFE(s(3,2), col[3]);
+   TUCSM("row");
+   SVector<double,3> row(s.row(1));
+   TUASSERTFE(s(1,2), row[2]);
+   TUCSM("ident");
+   SMatrix<double,3,3> i3(ident<double,3>());
+   TUASSERTFE(1.0, i3(2,2));
+   TUASSERTFE(0.0, i3(0,2));
+   TUCSM("transpose");
+   TUASSERTFE(0.0, maxDiff(transpose(s), transpose(m)));
+   TUCSM("operator+");
+   TUASSERTFE(0.0, maxDiff(s + s2, m + m));
+   TUCSM("operator-");
+   TUASSERTFE(0.0, maxDiff(s - s2, Matrix<double>(4, 3, 0.0)));
+   TUCSM("operator*");
+   TUASSERTFE(0.0, maxDiff(s * 3.0, m * 3.0));
+   TURETURN();
+}
+
+
+unsigned SMatrix_T ::
+multiplyTest()
+{
+   TUDEF("SMatrix", "operator*");
+   SMatrix<double,5,4> a(fill<5,4>(0.0));
+   SMatrix<double,4,3> b(fill<4,3>(1.0));
+   Matrix<double> ma(a), mb(b);
+   TUASSERTFE(0.0, maxDiff(a * b, ma * mb));
+   SVector<double,4> x;
+   for (size_t i = 0; i < 4; i++)
+      x[i] = 0.1 * (i+1);
+   Vector<double> vx(x), vy(a * x), mvy(ma * vx);
+   for (size_t i = 0; i < 5; i++)
+      TUASSERTFE(mvy[i], vy[i]);
+   SVector<double,5> y(a * x);
+   Vector<double> vz(y * a), mvz(Vector<double>(y) * ma);
+   for (size_t i = 0; i < 4; i++)
+      TUASSERTFE(mvz[i], vz[i]);
+   TUCSM("transposeTimes");
+   SMatrix<double,5,3> c(fill<5,3>(2.0));
+   TUASSERTFE(0.0, maxDiff(transposeTimes(a, c),
+                           transpose(ma) * Matrix<double>(c)));
+   Vector<double> vt(transposeTimes(a, y)),
+      mvt(transpose(ma) * Vector<double>(y));
+   for (size_t i = 0; i < 4; i++)
+      TUASSERTFE(mvt[i], vt[i]);
+   TURETURN();
+}
+
+
+template <size_t N>
+unsigned SMatrix_T ::
+checkInverse(double seed)
+{
+   TUDEF("SMatrix", "inverse");
+   SMatrix<double,N,N> a(fill<N,N>(seed));
+   SMatrix<double,N,N> ai(inverse(a));
+   TUASSERTFEPS(0.0, maxDiff(ai, inverse(Matrix<double>(a))), 1e-12);
+   TUASSERTFEPS(0.0, maxDiff(a * ai, ident<double,N>()), 1e-12);
+   TURETURN();
+}
+
+
+unsigned SMatrix_T ::
+inverseTest()
+{
+   TUDEF("SMatrix", "inverse");
+   unsigned errors = 0;
+   errors += checkInverse<1>(0.0);
+   errors += checkInverse<2>(0.3);
+   errors += checkInverse<3>(0.6);
+   errors += checkInverse<4>(0.9);
+   errors += checkInverse<5>(1.2);
+   errors += checkInverse<7>(1.5);
+   testFramework.changeSourceMethod("inverse");
+   TUTHROW(inverse(SMatrix<double,1,1>()));
+   TUTHROW(inverse(SMatrix<double,2,2>(1.0)));
+   TUTHROW(inverse(SMatrix<double,3,3>(1.0)));
+   TUTHROW(inverse(SMatrix<double,4,4>(1.0)));
+   TUTHROW(inverse(SMatrix<double,5,5>(1.0)));
+      // needs a row exchange
+   SMatrix<double,3,3> p;
+   p(0,1) = 1.0; p(1,2) = 2.0; p(2,0) = 4.0;
+   TUASSERTFE(0.0, maxDiff(p * inverse(p), ident<double,3>()));
+   SMatrix<double,5,5> p5;
+   p5(0,4) = 1.0; p5(1,0) = 2.0; p5(2,1) = 3.0; p5(3,3) = 1.0; p5(4,2) = 4.0;
+   TUASSERTFE(0.0, maxDiff(p5 * inverse(p5), ident<double,5>()));
+   return errors + testFramework.countFails();
+}
+
+
+unsigned SMatrix_T ::
+choleskyTest()
+{
+   TUDEF("SMatrix", "cholesky");
+   SMatrix<double,4,4> a(spd<4>(0.2));
+   SMatrix<double,4,4> L(cholesky(a));
+   TUASSERTFEPS(0.0, maxDiff(L * transpose(L), a), 1e-13);
+   TUASSERTFE(0.0, L(0,3));
+   Cholesky<double> ch;
+   ch(Matrix<double>(a));
+   TUASSERTFEPS(0.0, maxDiff(L, ch.L), 1e-13);
+   TUTHROW(cholesky(SMatrix<double,3,3>(-1.0)));
+   TUCSM("choleskySolve");
+   SVector<double,4> x(1.0), b(a * x);
+   SVector<double,4> y(choleskySolve(a, b));
+   for (size_t i = 0; i < 4; i++)
+      TUASSERTFEPS(x[i], y[i], 1e-12);
+   TUCSM("inverseChol");
+   SMatrix<double,6,6> a6(spd<6>(0.7));
+   SMatrix<double,6,6> ai(inverseChol(a6));
+   TUASSERTFEPS(0.0, maxDiff(ai, inverse(Matrix<double>(a6))), 1e-12);
+   TUASSERT(ai.isSymmetric());
+   TURETURN();
+}
+
+
+int main()
+{
+   SMatrix_T testClass;
+   unsigned errorTotal = 0;
+
+   errorTotal += testClass.vectorTest();
+   errorTotal += testClass.valarrayTest();
+   errorTotal += testClass.constructTest();
+   errorTotal += testClass.multiplyTest();
+   errorTotal += testClass.inverseTest();
+   errorTotal += testClass.choleskyTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+
+   return errorTotal;
+}
@@ -141,6 +141,7 @@ public:
    unsigned addTypeFilterTest();
       /// Exercise loadIntoMap by loading data with different options in place.
    unsigned loadIntoMapTest();
+   unsigned addDataSourcesTest();
    unsigned getFactoryTest();
 };
 
@@ -632,6 +633,48 @@ loadIntoMapTest()
 }
 
 
+unsigned MultiFormatNavDataFactory_T ::
+addDataSourcesTest()
+{
+   TUDEF("MultiFormatNavDataFactory", "addDataSources");
+   std::string dpath = gnsstk::getPathData() + gnsstk::getFileSep();
+   std::vector<std::string> files;
+   files.push_back(dpath + "arlm2000.15n");
+   files.push_back(dpath + "test_input_SP3a.sp3");
+   files.push_back(dpath + "this_file_does_not_exist.sp3");
+   files.push_back(dpath + "test_input_sp3_nav_ephemerisData.sp3");
+   gnsstk::MultiFormatNavDataFactory fact;
+      // load the files one at a time to get the expected results
+   fact.clear();
+   bool expLoaded = true;
+   for (const auto& fn : files)
+   {
+      expLoaded &= fact.addDataSource(fn);
+   }
+   TUASSERTE(bool, false, expLoaded);
+   size_t expSize = fact.size();
+   std::ostringstream expDump;
+   fact.dump(expDump, gnsstk::DumpDetail::Full);
+   TUASSERT(expSize > 507+232);
+      // should get the same thing regardless of the number of threads
+   for (unsigned threads = 0; threads < 5; threads++)
+   {
+      fact.clear();
+      TUASSERTE(bool, false, fact.addDataSources(files, threads));
+      TUASSERTE(size_t, expSize, fact.size());
+      std::ostringstream dump;
+      fact.dump(dump, gnsstk::DumpDetail::Full);
+      TUASSERTE(std::string, expDump.str(), dump.str());
+   }
+      // remove the file that doesn't exist
+   files.erase(files.begin() + 2);
+   fact.clear();
+   TUASSERTE(bool, true, fact.addDataSources(files, 2));
+   TUASSERTE(size_t, expSize, fact.size());
+   TURETURN();
+}
+
+
 unsigned MultiFormatNavDataFactory_T ::
 getFactoryTest()
 {
@@ -664,6 +707,7 @@ int main()
    errorTotal += testClass.setTypeFilterTest();
    errorTotal += testClass.addTypeFilterTest();
    errorTotal += testClass.loadIntoMapTest();
+   errorTotal += testClass.addDataSourcesTest();
    errorTotal += testClass.getFactoryTest();
 
    std::cout << "Total Failures for " << __FILE__ << ": " << errorTotal
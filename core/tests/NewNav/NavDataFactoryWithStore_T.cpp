@@ -36,6 +36,8 @@
 //                            release, distribution is unlimited.
 //
 //==============================================================================
+#include <atomic>
+#include <thread>
 #include "NavDataFactoryWithStore.hpp"
 #include "GPSWeekSecond.hpp"
 #include "CivilTime.hpp"
@@ -164,6 +166,19 @@ public:
    unsigned isPresentTest();
    unsigned countTest();
    unsigned getFirstLastTimeTest();
+      /// Make sure find() gives the same results when frozen.
+   unsigned freezeTest();
+      /// Make sure cached wildcard searches track changes to the store.
+   unsigned findWildcardTest();
+      /** Make sure find() gives the same result for all times
+       * that findUntil() says it will. */
+   unsigned findUntilTest();
+      /** Make sure find() gives the same results from many
+       * threads at once when sealed. */
+   unsigned sealTest();
+      /** Make sure the retention window evicts old data as new
+       * data is added, and that message counts are maintained. */
+   unsigned retentionTest();
 
       /// Fill fact with test data
    void fillFactory(gnsstk::TestUtil& testFramework, TestClass& fact);
@@ -1581,6 +1596,344 @@ clearTest()
 }
 
 
+unsigned NavDataFactoryWithStore_T ::
+freezeTest()
+{
+   TUDEF("NavDataFactoryWithStore", "freeze");
+   TestClass uut;
+   using SS = gnsstk::SatelliteSystem;
+   using CB = gnsstk::CarrierBand;
+   using TC = gnsstk::TrackingCode;
+   using NT = gnsstk::NavType;
+   using SH = gnsstk::SVHealth;
+   using MT = gnsstk::NavMessageType;
+   using VT = gnsstk::NavValidityType;
+   using SO = gnsstk::NavSearchOrder;
+   gnsstk::CommonTime refsf1ct = gnsstk::GPSWeekSecond(2101, 0);
+   gnsstk::CommonTime refpg2ct = gnsstk::GPSWeekSecond(2101, 54);
+   std::vector<gnsstk::NavMessageID> nmids {
+      gnsstk::NavMessageID(
+         gnsstk::NavSatelliteID(2, SS::GPS, CB::L1, TC::CA, NT::GPSLNAV),
+         MT::Almanac),
+      gnsstk::NavMessageID(
+         gnsstk::NavSatelliteID(2, SS::GPS, CB::Any, TC::Any, NT::Any),
+         MT::Almanac),
+      gnsstk::NavMessageID(
+         gnsstk::NavSatelliteID(2, 3, SS::GPS, CB::L2, TC::Y, NT::GPSLNAV),
+         MT::Almanac),
+      gnsstk::NavMessageID(
+         gnsstk::NavSatelliteID(1, SS::GPS, CB::L1, TC::CA, NT::GPSLNAV),
+         MT::Health),
+      gnsstk::NavMessageID(
+         gnsstk::NavSatelliteID(1, SS::GPS, CB::L1, TC::CA, NT::GPSLNAV),
+         MT::Ephemeris),
+      gnsstk::NavMessageID(
+         gnsstk::NavSatelliteID(1, SS::GPS, CB::Any, TC::Any, NT::Any),
+         MT::Ephemeris),
+      gnsstk::NavMessageID(
+         gnsstk::NavSatelliteID(3, SS::GPS, CB::L2, TC::Y, NT::GPSLNAV),
+         MT::Ephemeris),
+      gnsstk::NavMessageID(
+         gnsstk::NavSatelliteID(4, SS::GPS, CB::L1, TC::CA, NT::GPSLNAV),
+         MT::Ephemeris),
+   };
+   std::vector<SH> healths { SH::Any, SH::Healthy, SH::Unhealthy };
+   std::vector<VT> valids { VT::ValidOnly, VT::Any };
+   std::vector<SO> orders { SO::User, SO::Nearest };
+      // fill with "almanac pages"
+   for (unsigned i = 0; i <= 10; i++)
+   {
+      for (unsigned long xmit = 1; xmit <= 3; xmit += 2)
+      {
+         addData(testFramework, uut, refpg2ct + (750*i), 2, xmit, SS::GPS,
+                 CB::L1, TC::CA, NT::GPSLNAV, SH::Healthy, MT::Almanac);
+         addData(testFramework, uut, refpg2ct + (750*i), 2, xmit, SS::GPS,
+                 CB::L2, TC::Y, NT::GPSLNAV, SH::Healthy, MT::Almanac);
+      }
+   }
+      // add health and ephemerides, switching PRN 1 to unhealthy
+      // for a while.
+   for (unsigned i = 0; i <= 251; i++)
+   {
+      SH hea = ((i >= 57 && i < 240) ? SH::Unhealthy : SH::Healthy);
+      for (unsigned long prn = 1; prn <= 3; prn++)
+      {
+         addData(testFramework, uut, refsf1ct + (30*i), prn, prn, SS::GPS,
+                 CB::L1, TC::CA, NT::GPSLNAV,
+                 (prn == 1 ? hea : SH::Healthy), MT::Health);
+         addData(testFramework, uut, refsf1ct + (30*i), prn, prn, SS::GPS,
+                 CB::L2, TC::Y, NT::GPSLNAV,
+                 (prn == 1 ? hea : SH::Healthy), MT::Health);
+            // ephemerides every 5 minutes
+         if ((i % 10) == 0)
+         {
+            addData(testFramework, uut, refsf1ct + (30*i) + 3600, prn, prn,
+                    SS::GPS, CB::L1, TC::CA, NT::GPSLNAV,
+                    (prn == 1 ? hea : SH::Healthy));
+            addData(testFramework, uut, refsf1ct + (30*i) + 3600, prn, prn,
+                    SS::GPS, CB::L2, TC::Y, NT::GPSLNAV,
+                    (prn == 1 ? hea : SH::Healthy));
+         }
+      }
+   }
+   TUASSERT(!uut.isFrozen());
+      // collect the results from the map-based search
+   std::vector<gnsstk::NavDataPtr> expected;
+   unsigned found = 0;
+   for (const auto& nmid : nmids)
+   {
+      for (gnsstk::CommonTime when = refsf1ct - 600;
+           when < refsf1ct + 11000; when += 97)
+      {
+         for (SH hea : healths)
+            for (VT val : valids)
+               for (SO ord : orders)
+               {
+                  gnsstk::NavDataPtr ndp;
+                  if (uut.find(nmid, when, ndp, hea, val, ord))
+                     found++;
+                  expected.push_back(ndp);
+               }
+      }
+   }
+      // make sure we're testing something of interest
+   TUASSERT(found > 1000);
+   TUASSERT(found < expected.size());
+   gnsstk::NavNearMessageMap nearest(uut.getNearestData());
+   size_t nearSize = uut.sizeNearest();
+   uut.freeze();
+   TUASSERT(uut.isFrozen());
+      // the Nearest map is released while frozen...
+   TUASSERTE(size_t, 0, uut.sizeNearest());
+   TUASSERT(uut.getNearestData().empty());
+   TUTHROW(uut.getNavNearMessageMap());
+   gnsstk::NavDataPtrList snapshot;
+   TUASSERT(uut.getSnapshotData(snapshot));
+   TUASSERTE(size_t, nearSize, snapshot.size());
+   unsigned idx = 0, mismatch = 0;
+   for (const auto& nmid : nmids)
+   {
+      for (gnsstk::CommonTime when = refsf1ct - 600;
+           when < refsf1ct + 11000; when += 97)
+      {
+         for (SH hea : healths)
+            for (VT val : valids)
+               for (SO ord : orders)
+               {
+                  gnsstk::NavDataPtr ndp;
+                  uut.find(nmid, when, ndp, hea, val, ord);
+                  if (ndp != expected[idx++])
+                     mismatch++;
+               }
+      }
+   }
+   TUASSERTE(unsigned, expected.size(), idx);
+   TUASSERTE(unsigned, 0, mismatch);
+      // ...and restored exactly by thaw()
+   uut.thaw();
+   TUASSERTE(size_t, nearSize, uut.sizeNearest());
+   TUASSERT(uut.getNearestData() == nearest);
+   TUCATCH(uut.getNavNearMessageMap());
+   idx = mismatch = 0;
+   for (const auto& nmid : nmids)
+   {
+      for (gnsstk::CommonTime when = refsf1ct - 600;
+           when < refsf1ct + 11000; when += 97)
+      {
+         for (SH hea : healths)
+            for (VT val : valids)
+               for (SO ord : orders)
+               {
+                  gnsstk::NavDataPtr ndp;
+                  uut.find(nmid, when, ndp, hea, val, ord);
+                  if (ndp != expected[idx++])
+                     mismatch++;
+               }
+      }
+   }
+   TUASSERTE(unsigned, 0, mismatch);
+   uut.freeze();
+      // any changes to the store should discard the frozen index
+   addData(testFramework, uut, refsf1ct + 20000, 5, 5);
+   TUASSERT(!uut.isFrozen());
+   uut.freeze();
+   TUASSERT(uut.isFrozen());
+   uut.edit(refsf1ct + 19000, refsf1ct + 21000);
+   TUASSERT(!uut.isFrozen());
+   uut.freeze();
+   TUASSERT(uut.isFrozen());
+   uut.thaw();
+   TUASSERT(!uut.isFrozen());
+   uut.freeze();
+   uut.clear();
+   TUASSERT(!uut.isFrozen());
+   gnsstk::NavDataPtr ndp;
+   TUASSERT(!uut.find(nmids[0], refpg2ct, ndp, SH::Any, VT::Any, SO::User));
+   TURETURN();
+}
+
+
+unsigned NavDataFactoryWithStore_T ::
+findWildcardTest()
+{
+   TUDEF("NavDataFactoryWithStore", "find");
+   TestClass uut;
+   using SS = gnsstk::SatelliteSystem;
+   using CB = gnsstk::CarrierBand;
+   using TC = gnsstk::TrackingCode;
+   using NT = gnsstk::NavType;
+   using SH = gnsstk::SVHealth;
+   using MT = gnsstk::NavMessageType;
+   using VT = gnsstk::NavValidityType;
+   using SO = gnsstk::NavSearchOrder;
+   gnsstk::NavMessageID wild(
+      gnsstk::NavSatelliteID(5, SS::GPS, CB::Any, TC::Any, NT::Any),
+      MT::Health);
+      // Use a transmitting satellite that sorts before the first
+      // signal so that Nearest searches will also find it first.
+   gnsstk::NavSatelliteID l2sat(5, 4, SS::GPS, CB::L2, TC::Y, NT::GPSLNAV);
+   gnsstk::CommonTime when = ct + 60;
+   for (bool frz : { false, true })
+   {
+      for (SO order : { SO::User, SO::Nearest })
+      {
+         gnsstk::NavDataPtr ndp;
+         uut.clear();
+         addData(testFramework, uut, ct, 5, 5, SS::GPS, CB::L1, TC::CA,
+                 NT::GPSLNAV, SH::Healthy, MT::Health);
+         if (frz)
+            uut.freeze();
+            // only L1 available
+         TUASSERT(uut.find(wild, when, ndp, SH::Any, VT::Any, order));
+         TUASSERTE(CB, CB::L1, ndp->signal.obs.band);
+            // add a new, more recent signal that matches the wildcard
+         addData(testFramework, uut, ct+30, 5, 4, SS::GPS, CB::L2, TC::Y,
+                 NT::GPSLNAV, SH::Healthy, MT::Health);
+         if (frz)
+            uut.freeze();
+         TUASSERT(uut.find(wild, when, ndp, SH::Any, VT::Any, order));
+         TUASSERTE(CB, CB::L2, ndp->signal.obs.band);
+            // remove the new signal again
+         uut.edit(ct+20, ct+40, l2sat);
+         TUASSERTE(size_t, 1, uut.numSatellites());
+         if (frz)
+            uut.freeze();
+         TUASSERT(uut.find(wild, when, ndp, SH::Any, VT::Any, order));
+         TUASSERTE(CB, CB::L1, ndp->signal.obs.band);
+      }
+   }
+   TURETURN();
+}
+
+
+unsigned NavDataFactoryWithStore_T ::
+findUntilTest()
+{
+   TUDEF("NavDataFactoryWithStore", "findUntil");
+   TestClass uut;
+   using SS = gnsstk::SatelliteSystem;
+   using CB = gnsstk::CarrierBand;
+   using TC = gnsstk::TrackingCode;
+   using NT = gnsstk::NavType;
+   using SH = gnsstk::SVHealth;
+   using MT = gnsstk::NavMessageType;
+   using VT = gnsstk::NavValidityType;
+   using SO = gnsstk::NavSearchOrder;
+   gnsstk::CommonTime refsf1ct = gnsstk::GPSWeekSecond(2101, 0);
+   std::vector<gnsstk::NavMessageID> nmids {
+      gnsstk::NavMessageID(
+         gnsstk::NavSatelliteID(1, SS::GPS, CB::L1, TC::CA, NT::GPSLNAV),
+         MT::Ephemeris),
+      gnsstk::NavMessageID(
+         gnsstk::NavSatelliteID(1, SS::GPS, CB::Any, TC::Any, NT::Any),
+         MT::Ephemeris),
+      gnsstk::NavMessageID(
+         gnsstk::NavSatelliteID(3, SS::GPS, CB::L2, TC::Y, NT::GPSLNAV),
+         MT::Ephemeris),
+      gnsstk::NavMessageID(
+         gnsstk::NavSatelliteID(4, SS::GPS, CB::L1, TC::CA, NT::GPSLNAV),
+         MT::Ephemeris),
+   };
+      // add health and ephemerides, switching PRN 1 to unhealthy
+      // for a while.
+   for (unsigned i = 0; i <= 251; i++)
+   {
+      SH hea = ((i >= 57 && i < 240) ? SH::Unhealthy : SH::Healthy);
+      for (unsigned long prn = 1; prn <= 3; prn++)
+      {
+         addData(testFramework, uut, refsf1ct + (30*i), prn, prn, SS::GPS,
+                 CB::L1, TC::CA, NT::GPSLNAV,
+                 (prn == 1 ? hea : SH::Healthy), MT::Health);
+         if ((i % 10) == 0)
+         {
+            addData(testFramework, uut, refsf1ct + (30*i) + 3600, prn, prn,
+                    SS::GPS, CB::L1, TC::CA, NT::GPSLNAV,
+                    (prn == 1 ? hea : SH::Healthy));
+            addData(testFramework, uut, refsf1ct + (30*i) + 3600, prn, prn,
+                    SS::GPS, CB::L2, TC::Y, NT::GPSLNAV,
+                    (prn == 1 ? hea : SH::Healthy));
+         }
+      }
+   }
+   unsigned reused = 0, mismatch = 0;
+   for (const auto& nmid : nmids)
+   {
+      for (SH hea : { SH::Any, SH::Healthy, SH::Unhealthy })
+      {
+         gnsstk::NavDataPtr cached;
+         bool cachedRV = false;
+         gnsstk::CommonTime from, until;
+         bool searched = false;
+         for (gnsstk::CommonTime when = refsf1ct - 600;
+              when < refsf1ct + 20000; when += 13)
+         {
+            gnsstk::NavDataPtr ndp;
+            bool rv = uut.find(nmid, when, ndp, hea, VT::ValidOnly, SO::User);
+            if (searched && (when < until))
+            {
+               reused++;
+               if ((rv != cachedRV) || (rv && (ndp != cached)))
+                  mismatch++;
+               continue;
+            }
+            from = when;
+            cachedRV = uut.findUntil(nmid, when, cached, until, hea,
+                                     VT::ValidOnly, SO::User);
+            searched = true;
+            if ((rv != cachedRV) || (rv && (ndp != cached)) || (until < from))
+               mismatch++;
+         }
+      }
+   }
+   TUASSERT(reused > 1000);
+   TUASSERTE(unsigned, 0, mismatch);
+      // Nearest results are never reused.
+   gnsstk::NavDataPtr ndp;
+   gnsstk::CommonTime until;
+   TUASSERT(uut.findUntil(nmids[0], refsf1ct + 4000, ndp, until, SH::Any,
+                          VT::ValidOnly, SO::Nearest));
+   TUASSERTE(gnsstk::CommonTime, refsf1ct + 4000, until);
+      // Any change to the store must be reflected in the change
+      // count so that users of findUntil() know to search again.
+   unsigned long cc = uut.getChangeCount();
+   unsigned long scc = gnsstk::NavDataFactory::getSharedChangeCount();
+   addData(testFramework, uut, refsf1ct + 30000, 5, 5);
+   TUASSERT(cc != uut.getChangeCount());
+   TUASSERT(scc != gnsstk::NavDataFactory::getSharedChangeCount());
+   cc = uut.getChangeCount();
+   scc = gnsstk::NavDataFactory::getSharedChangeCount();
+   uut.edit(refsf1ct + 29000, refsf1ct + 31000);
+   TUASSERT(cc != uut.getChangeCount());
+   TUASSERT(scc != gnsstk::NavDataFactory::getSharedChangeCount());
+   cc = uut.getChangeCount();
+   scc = gnsstk::NavDataFactory::getSharedChangeCount();
+   uut.clear();
+   TUASSERT(cc != uut.getChangeCount());
+   TUASSERT(scc != gnsstk::NavDataFactory::getSharedChangeCount());
+   TURETURN();
+}
+
+
 void NavDataFactoryWithStore_T ::
 fillFactory(gnsstk::TestUtil& testFramework, TestClass& fact)
 {
@@ -2144,6 +2497,217 @@ getFirstLastTimeTest()
 }
 
 
+unsigned NavDataFactoryWithStore_T ::
+sealTest()
+{
+   TUDEF("NavDataFactoryWithStore", "seal");
+   TestClass uut;
+   using SS = gnsstk::SatelliteSystem;
+   using CB = gnsstk::CarrierBand;
+   using TC = gnsstk::TrackingCode;
+   using NT = gnsstk::NavType;
+   using SH = gnsstk::SVHealth;
+   using MT = gnsstk::NavMessageType;
+   using VT = gnsstk::NavValidityType;
+   using SO = gnsstk::NavSearchOrder;
+   gnsstk::CommonTime refct = gnsstk::GPSWeekSecond(2101, 0);
+   for (unsigned i = 0; i <= 240; i++)
+   {
+      for (unsigned long prn = 1; prn <= 8; prn++)
+      {
+         SH hea = (((i + prn) % 50) < 10 ? SH::Unhealthy : SH::Healthy);
+         addData(testFramework, uut, refct + (30*i), prn, prn, SS::GPS,
+                 CB::L1, TC::CA, NT::GPSLNAV, hea, MT::Health);
+         addData(testFramework, uut, refct + (30*i), prn, prn, SS::GPS,
+                 CB::L2, TC::Y, NT::GPSLNAV, hea, MT::Health);
+         if ((i % 10) == 0)
+         {
+            addData(testFramework, uut, refct + (30*i) + 3600, prn, prn,
+                    SS::GPS, CB::L1, TC::CA, NT::GPSLNAV, hea);
+         }
+      }
+   }
+      // Exact and wildcard searches.  Most of the wildcard IDs are
+      // first used by the threads, so that the wildcard caches are
+      // filled concurrently.
+   std::vector<gnsstk::NavMessageID> nmids;
+   for (unsigned long prn = 1; prn <= 9; prn++)
+   {
+      for (MT nmt : { MT::Health, MT::Ephemeris })
+      {
+         nmids.push_back(gnsstk::NavMessageID(
+            gnsstk::NavSatelliteID(prn, SS::GPS, CB::L1, TC::CA,
+                                   NT::GPSLNAV), nmt));
+         nmids.push_back(gnsstk::NavMessageID(
+            gnsstk::NavSatelliteID(prn, SS::GPS, CB::Any, TC::Any,
+                                   NT::Any), nmt));
+         nmids.push_back(gnsstk::NavMessageID(
+            gnsstk::NavSatelliteID(prn, SS::GPS, CB::L2, TC::Any,
+                                   NT::Any), nmt));
+      }
+   }
+   std::vector<gnsstk::CommonTime> times;
+   for (gnsstk::CommonTime when = refct - 600; when < refct + 11000;
+        when += 197)
+   {
+      times.push_back(when);
+   }
+   size_t numQueries = nmids.size() * times.size() * 4;
+      // Run query number q, returning the search result.
+   auto query = [&](size_t q) -> gnsstk::NavDataPtr
+   {
+      gnsstk::NavDataPtr ndp;
+      size_t i = q / 4;
+      uut.find(nmids[i % nmids.size()], times[i / nmids.size()], ndp,
+               ((q & 1) ? SH::Healthy : SH::Any), VT::ValidOnly,
+               ((q & 2) ? SO::Nearest : SO::User));
+      return ndp;
+   };
+   std::vector<gnsstk::NavDataPtr> expected;
+   unsigned found = 0;
+   for (size_t q = 0; q < numQueries; q++)
+   {
+      expected.push_back(query(q));
+      if (expected.back())
+         found++;
+   }
+      // make sure we're testing something of interest
+   TUASSERT(found > 1000);
+   TUASSERT(found < expected.size());
+   TUASSERT(!uut.isSealed());
+   uut.seal();
+   TUASSERT(uut.isSealed());
+   TUASSERT(uut.isFrozen());
+      // Each thread starts at a different query and goes through
+      // all of them several times.
+   const unsigned numThreads = 8, passes = 3;
+   std::atomic<unsigned> mismatch(0);
+   std::vector<std::thread> threads;
+   for (unsigned t = 0; t < numThreads; t++)
+   {
+      threads.push_back(std::thread([&, t]()
+      {
+         unsigned bad = 0;
+         size_t start = t * numQueries / numThreads;
+         for (size_t n = 0; n < passes * numQueries; n++)
+         {
+            size_t q = (start + n) % numQueries;
+            if (query(q) != expected[q])
+               bad++;
+         }
+         mismatch += bad;
+      }));
+   }
+   for (auto& th : threads)
+   {
+      th.join();
+   }
+   TUASSERTE(unsigned, 0, mismatch);
+   TUASSERT(uut.isSealed());
+      // any changes to the store should unseal it
+   addData(testFramework, uut, refct + 20000, 5, 5);
+   TUASSERT(!uut.isSealed());
+   uut.seal();
+   uut.edit(refct + 19000, refct + 21000);
+   TUASSERT(!uut.isSealed());
+   uut.seal();
+   uut.clear();
+   TUASSERT(!uut.isSealed());
+      // unseal leaves the compact index alone
+   uut.seal();
+   uut.unseal();
+   TUASSERT(!uut.isSealed());
+   TUASSERT(uut.isFrozen());
+   TURETURN();
+}
+
+
+unsigned NavDataFactoryWithStore_T ::
+retentionTest()
+{
+   TUDEF("NavDataFactoryWithStore", "setRetention");
+   TestClass uut;
+   using SS = gnsstk::SatelliteSystem;
+   using CB = gnsstk::CarrierBand;
+   using TC = gnsstk::TrackingCode;
+   using NT = gnsstk::NavType;
+   using SH = gnsstk::SVHealth;
+   using MT = gnsstk::NavMessageType;
+   gnsstk::CommonTime refct = gnsstk::GPSWeekSecond(2101, 0);
+   gnsstk::NavSignalID sigL1, sigL2;
+   fillSignal(sigL1, SS::GPS, CB::L1, TC::CA, NT::GPSLNAV);
+   fillSignal(sigL2, SS::GPS, CB::L2, TC::Y, NT::GPSLNAV);
+   TUASSERTFE(0, uut.getRetention());
+   uut.setRetention(600);
+   TUASSERTFE(600, uut.getRetention());
+   addData(testFramework, uut, refct, 1, 1, SS::GPS, CB::L1, TC::CA,
+           NT::GPSLNAV, SH::Healthy, MT::TimeOffset);
+   gnsstk::NavDataPtr ndp;
+   TUASSERT(uut.getOffset(gnsstk::TimeSystem::GPS, gnsstk::TimeSystem::UTC,
+                          refct + 60, ndp));
+      // 2 hours of health for 3 satellites on 2 signals, 30s apart
+   size_t maxSize = 0;
+   for (unsigned i = 0; i < 240; i++)
+   {
+      for (unsigned long prn = 1; prn <= 3; prn++)
+      {
+         addData(testFramework, uut, refct + (30*i), prn, prn, SS::GPS,
+                 CB::L1, TC::CA, NT::GPSLNAV, SH::Healthy, MT::Health);
+         addData(testFramework, uut, refct + (30*i), prn, prn, SS::GPS,
+                 CB::L2, TC::Y, NT::GPSLNAV, SH::Healthy, MT::Health);
+      }
+      maxSize = std::max(maxSize, uut.sizeNearest());
+   }
+      // 21 epochs (600s inclusive) of 6 messages each, plus the time
+      // offset until it falls out of the window.
+   TUASSERTE(size_t, 127, maxSize);
+   TUASSERTE(size_t, 126, uut.size());
+   TUASSERTE(size_t, 126, uut.sizeNearest());
+   checkForEmpty(testFramework, uut);
+   std::map<gnsstk::NavSignalID, size_t> counts(uut.getMessageCounts());
+   TUASSERTE(size_t, 2, counts.size());
+   TUASSERTE(size_t, 63, counts[sigL1]);
+   TUASSERTE(size_t, 63, counts[sigL2]);
+      // the time offset was evicted
+   TUASSERT(!uut.getOffset(gnsstk::TimeSystem::GPS, gnsstk::TimeSystem::UTC,
+                           refct + 7170, ndp));
+   TUASSERT(uut.getTimeOffsetMap().empty());
+      // only the last 600 seconds of health remain
+   gnsstk::NavMessageID nmid(
+      gnsstk::NavSatelliteID(2, SS::GPS, CB::L1, TC::CA, NT::GPSLNAV),
+      MT::Health);
+   TUASSERT(uut.find(nmid, refct + 7200, ndp, SH::Any,
+                     gnsstk::NavValidityType::ValidOnly,
+                     gnsstk::NavSearchOrder::User));
+   TUASSERTE(gnsstk::CommonTime, refct + 7170, ndp->timeStamp);
+   TUASSERT(!uut.find(nmid, refct + 6575, ndp, SH::Any,
+                      gnsstk::NavValidityType::ValidOnly,
+                      gnsstk::NavSearchOrder::User));
+      // edit keeps the counts up to date
+   uut.edit(refct, refct + 6900, gnsstk::NavSatelliteID(
+               3, 3, SS::GPS, CB::L2, TC::Y, NT::GPSLNAV));
+   counts = uut.getMessageCounts();
+   TUASSERTE(size_t, 63, counts[sigL1]);
+   TUASSERTE(size_t, 52, counts[sigL2]);
+      // a shorter window takes effect immediately
+   uut.setRetention(300);
+   TUASSERTE(size_t, 65, uut.sizeNearest());
+   checkForEmpty(testFramework, uut);
+   counts = uut.getMessageCounts();
+   TUASSERTE(size_t, 33, counts[sigL1]);
+   TUASSERTE(size_t, 32, counts[sigL2]);
+      // without a window, nothing is evicted
+   uut.setRetention(0);
+   addData(testFramework, uut, refct + 86400, 1, 1, SS::GPS, CB::L1,
+           TC::CA, NT::GPSLNAV, SH::Healthy, MT::Health);
+   TUASSERTE(size_t, 66, uut.sizeNearest());
+   TUASSERTE(size_t, 34, uut.getMessageCounts()[sigL1]);
+   uut.clear();
+   TUASSERT(uut.getMessageCounts().empty());
+   TURETURN();
+}
+
+
 int main()
 {
    NavDataFactoryWithStore_T testClass;
@@ -2164,6 +2728,11 @@ int main()
    errorTotal += testClass.isPresentTest();
    errorTotal += testClass.countTest();
    errorTotal += testClass.getFirstLastTimeTest();
+   errorTotal += testClass.freezeTest();
+   errorTotal += testClass.findWildcardTest();
+   errorTotal += testClass.findUntilTest();
+   errorTotal += testClass.sealTest();
+   errorTotal += testClass.retentionTest();
 
    std::cout << "Total Failures for " << __FILE__ << ": " << errorTotal
              << std::endl;
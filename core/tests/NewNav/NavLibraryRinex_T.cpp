@@ -136,6 +136,12 @@ public:
       /** Make sure that NavLibrary::getXvt pulls the correct
        * ephemeris and computes the correct xvt. */
    unsigned getXvtTest();
+      /** Make sure the multi-satellite, multi-epoch getXvt gives the
+       * same results as the single satellite/epoch getXvt. */
+   unsigned getXvtBatchTest();
+      /** Make sure NavLibrary::Cursor gives the same results as
+       * NavLibrary and notices changes to the data. */
+   unsigned cursorTest();
    unsigned getHealthTest();
    unsigned getOffsetTest();
    unsigned findTest();
@@ -209,6 +215,133 @@ getXvtTest()
 }
 
 
+unsigned NavLibrary_T ::
+getXvtBatchTest()
+{
+   TUDEF("NavLibraryRinex", "getXvt");
+   gnsstk::NavLibrary navLib;
+   gnsstk::NavDataFactoryPtr
+      ndfp(std::make_shared<RinexTestFactory>());
+   std::string fname = gnsstk::getPathData() + gnsstk::getFileSep() +
+      "arlm2000.15n";
+   TUCATCH(navLib.addFactory(ndfp));
+   RinexTestFactory *rndfp =
+      dynamic_cast<RinexTestFactory*>(ndfp.get());
+   TUASSERT(rndfp->addDataSource(fname));
+   std::vector<gnsstk::NavSatelliteID> sats;
+      // include a PRN that isn't in the data
+   for (unsigned long prn : { 2, 5, 7, 12, 33 })
+   {
+      sats.push_back(
+         gnsstk::NavSatelliteID(prn, prn, gnsstk::SatelliteSystem::GPS,
+                                gnsstk::CarrierBand::L1,
+                                gnsstk::TrackingCode::CA,
+                                gnsstk::NavType::GPSLNAV));
+   }
+   std::vector<gnsstk::CommonTime> when;
+   for (double offs = -7200; offs < 86400; offs += 30)
+   {
+      when.push_back(ct + offs);
+   }
+   std::vector<gnsstk::Xvt> xvt;
+   std::vector<bool> ok;
+   size_t count = navLib.getXvt(sats, when, xvt, ok, false);
+   TUASSERTE(size_t, sats.size()*when.size(), xvt.size());
+   TUASSERTE(size_t, sats.size()*when.size(), ok.size());
+   size_t expCount = 0;
+   unsigned mismatch = 0;
+   for (unsigned si = 0; si < sats.size(); si++)
+   {
+      for (unsigned ti = 0; ti < when.size(); ti++)
+      {
+         gnsstk::Xvt exp;
+         size_t idx = si * when.size() + ti;
+         bool rv = navLib.getXvt(sats[si], when[ti], exp, false);
+         if (rv)
+            expCount++;
+         if ((rv != ok[idx]) ||
+             (rv && (!(exp.x == xvt[idx].x) || !(exp.v == xvt[idx].v) ||
+                     (exp.clkbias != xvt[idx].clkbias) ||
+                     (exp.relcorr != xvt[idx].relcorr))))
+         {
+            mismatch++;
+         }
+      }
+   }
+   TUASSERTE(size_t, expCount, count);
+   TUASSERTE(unsigned, 0, mismatch);
+      // make sure we're testing something of interest
+   TUASSERT(count > 0);
+   TUASSERT(count < xvt.size());
+   TURETURN();
+}
+
+
+unsigned NavLibrary_T ::
+cursorTest()
+{
+   TUDEF("NavLibraryRinex", "Cursor");
+   gnsstk::NavLibrary navLib;
+   gnsstk::NavDataFactoryPtr
+      ndfp(std::make_shared<RinexTestFactory>());
+   std::string fname = gnsstk::getPathData() + gnsstk::getFileSep() +
+      "arlm2000.15n";
+   TUCATCH(navLib.addFactory(ndfp));
+   RinexTestFactory *rndfp =
+      dynamic_cast<RinexTestFactory*>(ndfp.get());
+   TUASSERT(rndfp->addDataSource(fname));
+   gnsstk::NavLibrary::Cursor cursor(navLib);
+   std::vector<gnsstk::NavSatelliteID> sats;
+      // include a PRN that isn't in the data and a wildcard
+   for (unsigned long prn : { 2, 5, 7, 33 })
+   {
+      sats.push_back(
+         gnsstk::NavSatelliteID(prn, prn, gnsstk::SatelliteSystem::GPS,
+                                gnsstk::CarrierBand::L1,
+                                gnsstk::TrackingCode::CA,
+                                gnsstk::NavType::GPSLNAV));
+   }
+   sats.push_back(gnsstk::NavSatelliteID(
+                     12, gnsstk::SatelliteSystem::GPS,
+                     gnsstk::CarrierBand::Any, gnsstk::TrackingCode::Any,
+                     gnsstk::NavType::Any));
+   unsigned mismatch = 0;
+   for (double offs = -7200; offs < 86400; offs += 30)
+   {
+      gnsstk::CommonTime when = ct + offs;
+      for (const auto& sat : sats)
+      {
+         gnsstk::NavMessageID nmid(sat, gnsstk::NavMessageType::Ephemeris);
+         gnsstk::NavDataPtr exp, got;
+         bool expRV = navLib.find(nmid, when, exp, gnsstk::SVHealth::Any,
+                                  gnsstk::NavValidityType::ValidOnly,
+                                  gnsstk::NavSearchOrder::User);
+         bool gotRV = cursor.find(nmid, when, got);
+         if ((expRV != gotRV) || (exp != got))
+            mismatch++;
+         gnsstk::Xvt expXvt, gotXvt;
+         expRV = navLib.getXvt(sat, when, expXvt);
+         gotRV = cursor.getXvt(sat, when, gotXvt);
+         if ((expRV != gotRV) ||
+             (expRV && (!(expXvt.x == gotXvt.x) || !(expXvt.v == gotXvt.v))))
+            mismatch++;
+      }
+   }
+   TUASSERTE(unsigned, 0, mismatch);
+      // Most searches should have been answered from the cache.
+   TUASSERT(cursor.getHits() > 10 * cursor.getMisses());
+      // Make sure changes to the data are noticed.
+   gnsstk::NavDataPtr ndp;
+   gnsstk::NavMessageID nmid(sats[1], gnsstk::NavMessageType::Ephemeris);
+   TUASSERT(cursor.find(nmid, ct+35, ndp));
+   navLib.clear();
+   TUASSERT(!cursor.find(nmid, ct+35, ndp));
+   TUASSERT(rndfp->addDataSource(fname));
+   TUASSERT(cursor.find(nmid, ct+35, ndp));
+   TURETURN();
+}
+
+
 unsigned NavLibrary_T ::
 getHealthTest()
 {
@@ -455,7 +588,10 @@ addFactoryTest()
    gnsstk::NavDataFactoryPtr ndfp1(std::make_shared<TestFactory>());
    gnsstk::NavDataFactoryPtr
       ndfp2(std::make_shared<RinexTestFactory>());
+   unsigned long scc = gnsstk::NavDataFactory::getSharedChangeCount();
    TUCATCH(navLib.addFactory(ndfp1));
+      // adding a factory must invalidate any Cursor on the library
+   TUASSERT(scc != gnsstk::NavDataFactory::getSharedChangeCount());
    TUCATCH(navLib.addFactory(ndfp2));
    TestFactory *tfp = dynamic_cast<TestFactory*>(ndfp1.get());
    RinexTestFactory *rndfp =
@@ -638,6 +774,8 @@ int main()
    unsigned errorTotal = 0;
 
    errorTotal += testClass.getXvtTest();
+   errorTotal += testClass.getXvtBatchTest();
+   errorTotal += testClass.cursorTest();
    errorTotal += testClass.getHealthTest();
    errorTotal += testClass.getOffsetTest();
    errorTotal += testClass.findTest();
@@ -0,0 +1,490 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <typeinfo>
+#include "NavSnapshot.hpp"
+#include "MultiFormatNavDataFactory.hpp"
+#include "RinexNavDataFactory.hpp"
+#include "Rinex3NavData.hpp"
+#include "Rinex3NavStream.hpp"
+#include "GPSLNavEph.hpp"
+#include "GPSLNavHealth.hpp"
+#include "GPSLNavIono.hpp"
+#include "GPSCNavEph.hpp"
+#include "GalINavEph.hpp"
+#include "GalINavIono.hpp"
+#include "BDSD1NavEph.hpp"
+#include "GLOFNavEph.hpp"
+#include "GLOFNavHealth.hpp"
+#include "OrbitDataSP3.hpp"
+#include "RinexTimeOffset.hpp"
+#include "CivilTime.hpp"
+#include "GPSWeekSecond.hpp"
+#include "TestUtil.hpp"
+
+/// Make the store accessible for comparison.
+class TestFactory : public gnsstk::RinexNavDataFactory
+{
+public:
+   gnsstk::NavNearMessageMap& getNearData()
+   { return nearestData; }
+};
+
+
+class NavSnapshot_T
+{
+public:
+   NavSnapshot_T();
+      /// Write a store to a snapshot and read it back.
+   unsigned roundTripTest();
+      /// Check handling of unsupported classes and bad files.
+   unsigned errorTest();
+      /// Build a snapshot from nav files using createSnapshot().
+   unsigned createTest();
+      /// Build a snapshot from nav files using NavSnapshot_create.
+   unsigned toolTest();
+
+      /// Set the identity of a message.
+   void fillSignal(gnsstk::NavData& nd, gnsstk::SatelliteSystem sys, int prn,
+                   gnsstk::CarrierBand band, gnsstk::TrackingCode code,
+                   gnsstk::NavType nav, gnsstk::NavMessageType nmt);
+      /// Add a set of messages of various classes to fact.
+   void fillStore(gnsstk::NavDataFactoryWithStore& fact);
+      /** Write a RINEX 3 GPS nav file containing one ephemeris for
+       * each PRN from 1 to numPRN, with Toe at sow. */
+   void writeNav(const std::string& filename, int numPRN, double sow);
+
+   gnsstk::CommonTime t0;
+   std::string snapFile;
+};
+
+
+NavSnapshot_T ::
+NavSnapshot_T()
+      : t0(gnsstk::CivilTime(2021, 3, 14, 12, 0, 0.5, gnsstk::TimeSystem::GPS)),
+        snapFile(gnsstk::getPathTestTemp() + gnsstk::getFileSep() +
+                 "test_output_NavSnapshot.bin")
+{
+}
+
+
+void NavSnapshot_T ::
+fillSignal(gnsstk::NavData& nd, gnsstk::SatelliteSystem sys, int prn,
+           gnsstk::CarrierBand band, gnsstk::TrackingCode code,
+           gnsstk::NavType nav, gnsstk::NavMessageType nmt)
+{
+   nd.signal = gnsstk::NavMessageID(
+      gnsstk::NavSatelliteID(prn, prn, sys, band, code, nav), nmt);
+}
+
+
+void NavSnapshot_T ::
+fillStore(gnsstk::NavDataFactoryWithStore& fact)
+{
+   using namespace gnsstk;
+   for (int prn = 1; prn < 4; prn++)
+   {
+      CommonTime t(t0 + 7200.0 * prn);
+      auto eph = std::make_shared<GPSLNavEph>();
+      fillSignal(*eph, SatelliteSystem::GPS, prn, CarrierBand::L1,
+                 TrackingCode::CA, NavType::GPSLNAV,
+                 NavMessageType::Ephemeris);
+      eph->timeStamp = eph->xmitTime = t;
+      eph->xmit2 = t + 6;
+      eph->xmit3 = t + 12;
+      eph->Toe = eph->Toc = t + 3600;
+      eph->health = SVHealth::Healthy;
+      eph->M0 = 0.1 * prn;
+      eph->ecc = 0.01;
+      eph->Ahalf = 5153.6;
+      eph->A = eph->Ahalf * eph->Ahalf;
+      eph->af0 = 1e-5 * prn;
+      eph->iodc = 100 + prn;
+      eph->iode = 100 + prn;
+      eph->tgd = -1.1e-8;
+      eph->codesL2 = GPSLNavL2Codes::Pcode;
+      eph->aodo = 27900;
+      eph->fixFit();
+      fact.addNavData(eph);
+      auto hea = std::make_shared<GPSLNavHealth>();
+      fillSignal(*hea, SatelliteSystem::GPS, prn, CarrierBand::L1,
+                 TrackingCode::CA, NavType::GPSLNAV, NavMessageType::Health);
+      hea->timeStamp = t;
+      hea->svHealth = prn - 1;
+      fact.addNavData(hea);
+      auto gal = std::make_shared<GalINavEph>();
+      fillSignal(*gal, SatelliteSystem::Galileo, prn, CarrierBand::L1,
+                 TrackingCode::E1B, NavType::GalINAV,
+                 NavMessageType::Ephemeris);
+      gal->timeStamp = gal->xmitTime = t;
+      gal->Toe = gal->Toc = t + 600;
+      gal->Ahalf = 5440.6;
+      gal->A = gal->Ahalf * gal->Ahalf;
+      gal->bgdE5aE1 = 1e-9 * prn;
+      gal->sisaIndex = 107;
+      gal->hsE1B = GalHealthStatus::OK;
+      gal->dvsE1B = GalDataValid::Valid;
+      gal->fixFit();
+      fact.addNavData(gal);
+      auto bds = std::make_shared<BDSD1NavEph>();
+      fillSignal(*bds, SatelliteSystem::BeiDou, prn + 10, CarrierBand::B1,
+                 TrackingCode::B1I, NavType::BeiDou_D1,
+                 NavMessageType::Ephemeris);
+      bds->timeStamp = bds->xmitTime = bds->xmit2 = bds->xmit3 = t;
+      bds->Toe = bds->Toc = t;
+      bds->aode = prn;
+      bds->tgd1 = 2e-9;
+      bds->fixFit();
+      fact.addNavData(bds);
+      auto glo = std::make_shared<GLOFNavEph>();
+      fillSignal(*glo, SatelliteSystem::Glonass, prn, CarrierBand::G1,
+                 TrackingCode::Standard, NavType::GloCivilF,
+                 NavMessageType::Ephemeris);
+      glo->timeStamp = glo->xmit2 = glo->xmit3 = glo->xmit4 = glo->ref = glo->Toe = t;
+      glo->pos = Triple(1.0e4 * prn, 2.0e4, -3.0e3);
+      glo->vel = Triple(-1.5, 0.25, 3.125);
+      glo->clkBias = -1.25e-5;
+      glo->slot = prn;
+      glo->opStatus = GLOFNavPCode::CRelGPSRel;
+      glo->fixFit();
+      fact.addNavData(glo);
+      auto glh = std::make_shared<GLOFNavHealth>();
+      fillSignal(*glh, SatelliteSystem::Glonass, prn, CarrierBand::G1,
+                 TrackingCode::Standard, NavType::GloCivilF,
+                 NavMessageType::Health);
+      glh->timeStamp = t;
+      glh->healthBits = 4;
+      glh->ln = true;
+      fact.addNavData(glh);
+      auto sp3 = std::make_shared<OrbitDataSP3>();
+      fillSignal(*sp3, SatelliteSystem::GPS, prn, CarrierBand::L1,
+                 TrackingCode::CA, NavType::GPSLNAV,
+                 NavMessageType::Clock);
+      sp3->timeStamp = t;
+      sp3->pos = Triple(1.5e4, -2.0e4 * prn, 5.0e3);
+      sp3->clkBias = 123.456;
+      sp3->coordSystem = "IGS14";
+      sp3->frame = RefFrame(RefFrameRlz::ITRF2014);
+      fact.addNavData(sp3);
+   }
+   auto iono = std::make_shared<GPSLNavIono>();
+   fillSignal(*iono, SatelliteSystem::GPS, 1, CarrierBand::L1,
+              TrackingCode::CA, NavType::GPSLNAV, NavMessageType::Iono);
+   iono->timeStamp = t0;
+   iono->alpha[0] = 1.1e-8;
+   iono->beta[3] = -6.5e5;
+   fact.addNavData(iono);
+   auto gion = std::make_shared<GalINavIono>();
+   fillSignal(*gion, SatelliteSystem::Galileo, 1, CarrierBand::L1,
+              TrackingCode::E1B, NavType::GalINAV, NavMessageType::Iono);
+   gion->timeStamp = t0;
+   gion->ai[0] = 62.25;
+   gion->idf[2] = true;
+   fact.addNavData(gion);
+   auto tos = std::make_shared<RinexTimeOffset>();
+   fillSignal(*tos, SatelliteSystem::GPS, 1, CarrierBand::L1,
+              TrackingCode::CA, NavType::GPSLNAV,
+              NavMessageType::TimeOffset);
+   tos->timeStamp = t0;
+   tos->type = TimeSystemCorrection::GPUT;
+   tos->frTS = TimeSystem::GPS;
+   tos->toTS = TimeSystem::UTC;
+   tos->A0 = 1.5e-9;
+   tos->refTime = t0;
+   tos->geoProvider = "WAAS";
+   tos->deltatLS = 18;
+   fact.addNavData(tos);
+}
+
+
+void NavSnapshot_T ::
+writeNav(const std::string& filename, int numPRN, double sow)
+{
+   gnsstk::Rinex3NavStream strm(filename.c_str(), std::ios::out);
+   gnsstk::Rinex3NavHeader hdr;
+   hdr.version = 3.04;
+   hdr.fileType = "N: GNSS NAV DATA";
+   hdr.setFileSystem("G");
+   hdr.fileProgram = "NavSnapshot_T";
+   hdr.fileAgency = "gnsstk";
+   hdr.valid = gnsstk::Rinex3NavHeader::allValid3;
+   strm << hdr;
+   for (int prn = 1; prn <= numPRN; prn++)
+   {
+      gnsstk::Rinex3NavData rnd;
+      rnd.time = gnsstk::GPSWeekSecond(2183, sow);
+      rnd.satSys = "G";
+      rnd.PRNID = prn;
+      rnd.sat = gnsstk::RinexSatID(prn, gnsstk::SatelliteSystem::GPS);
+      rnd.xmitTime = sow - 7200;
+      rnd.weeknum = 2183;
+      rnd.accuracy = 2.0;
+      rnd.codeflgs = 1;
+      rnd.IODC = 10 + prn;
+      rnd.IODE = 10 + prn;
+      rnd.Toc = sow;
+      rnd.af0 = 1e-5 * prn;
+      rnd.Tgd = -1.1e-8;
+      rnd.Toe = sow;
+      rnd.M0 = 0.1 * prn;
+      rnd.ecc = 0.01;
+      rnd.Ahalf = 5153.6;
+      rnd.i0 = 0.96;
+      rnd.fitint = 4;
+      strm << rnd;
+   }
+}
+
+
+unsigned NavSnapshot_T ::
+roundTripTest()
+{
+   TUDEF("NavSnapshot", "write");
+   TestFactory fact1, fact2;
+   fillStore(fact1);
+   TUASSERT(fact1.saveSnapshot(snapFile));
+   TUCSM("read");
+   TUASSERT(fact2.loadSnapshot(snapFile));
+   TUASSERTE(size_t, fact1.size(), fact2.size());
+   TUASSERTE(size_t, fact1.getTimeOffsetMap().size(),
+             fact2.getTimeOffsetMap().size());
+   TUASSERTE(gnsstk::CommonTime, fact1.getInitialTime(),
+             fact2.getInitialTime());
+   TUASSERTE(gnsstk::CommonTime, fact1.getFinalTime(), fact2.getFinalTime());
+      // Compare the contents of every message, in store order.
+   gnsstk::NavDataPtrList list1, list2;
+   TUASSERT(fact1.getSnapshotData(list1));
+   TUASSERT(fact2.getSnapshotData(list2));
+   TUASSERTE(size_t, list1.size(), list2.size());
+   unsigned mismatch = 0;
+   auto i2 = list2.begin();
+   for (auto i1 = list1.begin(); (i1 != list1.end()) && (i2 != list2.end());
+        ++i1, ++i2)
+   {
+      std::ostringstream s1, s2;
+      (*i1)->dump(s1, gnsstk::DumpDetail::Full);
+      (*i2)->dump(s2, gnsstk::DumpDetail::Full);
+      if ((typeid(**i1) != typeid(**i2)) || (s1.str() != s2.str()) ||
+          ((*i1)->getUserTime() != (*i2)->getUserTime()))
+      {
+         mismatch++;
+      }
+   }
+   TUASSERTE(unsigned, 0, mismatch);
+      // The whole store should dump identically.
+   std::ostringstream d1, d2;
+   fact1.dump(d1, gnsstk::DumpDetail::Full);
+   fact2.dump(d2, gnsstk::DumpDetail::Full);
+   TUASSERTE(std::string, d1.str(), d2.str());
+      // Loading again adds to the store rather than replacing it,
+      // but duplicates end up in the same place.
+   TUASSERT(fact2.loadSnapshot(snapFile));
+   TUASSERTE(size_t, fact1.size(), fact2.size());
+   std::remove(snapFile.c_str());
+   TURETURN();
+}
+
+
+unsigned NavSnapshot_T ::
+errorTest()
+{
+   TUDEF("NavSnapshot", "write");
+   TestFactory fact1, fact2;
+   fillStore(fact1);
+      // unsupported message class
+   auto cnav = std::make_shared<gnsstk::GPSCNavEph>();
+   fillSignal(*cnav, gnsstk::SatelliteSystem::GPS, 5, gnsstk::CarrierBand::L2,
+              gnsstk::TrackingCode::L2CM, gnsstk::NavType::GPSCNAVL2,
+              gnsstk::NavMessageType::Ephemeris);
+   cnav->timeStamp = cnav->xmitTime = t0;
+   TUASSERT(gnsstk::NavSnapshot::isSupported(fact1.getNearData().begin()
+                                            ->second.begin()->second.begin()
+                                            ->second.front()));
+   TUASSERT(!gnsstk::NavSnapshot::isSupported(cnav));
+   TUASSERT(fact2.addNavData(cnav));
+   TUASSERT(!fact2.saveSnapshot(snapFile));
+   TUCSM("read");
+   TUASSERT(!fact2.loadSnapshot(snapFile + ".does.not.exist"));
+      // truncated file
+   TUASSERT(fact1.saveSnapshot(snapFile));
+   std::string contents;
+   {
+      std::ifstream in(snapFile.c_str(), std::ios::binary);
+      std::ostringstream ss;
+      ss << in.rdbuf();
+      contents = ss.str();
+   }
+   {
+      std::ofstream out(snapFile.c_str(), std::ios::binary);
+      out.write(contents.data(), contents.size() - 5);
+   }
+   gnsstk::NavSnapshot::SectionList sections;
+   TUASSERT(!gnsstk::NavSnapshot::read(snapFile, sections));
+   TUASSERTE(size_t, 0, sections.size());
+      // not a snapshot
+   {
+      std::ofstream out(snapFile.c_str(), std::ios::binary);
+      out << "This is not a snapshot file";
+   }
+   TUASSERT(!gnsstk::NavSnapshot::read(snapFile, sections));
+      // empty file, which can't be mapped
+   {
+      std::ofstream out(snapFile.c_str(), std::ios::binary);
+   }
+   TUASSERT(!gnsstk::NavSnapshot::read(snapFile, sections));
+   TUASSERTE(size_t, 0, sections.size());
+   TestFactory fact3;
+   TUASSERT(!fact3.loadSnapshot(snapFile));
+   TUASSERTE(size_t, 0, fact3.size());
+   std::remove(snapFile.c_str());
+   TURETURN();
+}
+
+
+unsigned NavSnapshot_T ::
+createTest()
+{
+   TUDEF("MultiFormatNavDataFactory", "createSnapshot");
+   std::string tpath = gnsstk::getPathTestTemp() + gnsstk::getFileSep();
+   std::vector<std::string> files;
+   files.push_back(tpath + "test_output_NavSnapshot_T_1.rnx");
+   files.push_back(tpath + "test_output_NavSnapshot_T_2.rnx");
+   writeNav(files[0], 4, 302400);
+   writeNav(files[1], 6, 309600);
+   std::remove(snapFile.c_str());
+   gnsstk::MultiFormatNavDataFactory fact;
+      // expected results from the nav files themselves
+   fact.clear();
+   TUASSERT(fact.addDataSource(files[0]));
+   TUASSERT(fact.addDataSource(files[1]));
+      // ephemeris, health and ISC for each of the 10 records
+   TUASSERTE(size_t, 30, fact.size());
+   std::ostringstream expDump;
+   fact.dump(expDump, gnsstk::DumpDetail::Full);
+   fact.clear();
+   TUASSERT(fact.createSnapshot(snapFile, files, 2));
+   TUASSERTE(size_t, 30, fact.size());
+   fact.clear();
+   TUCSM("loadSnapshot");
+   TUASSERT(fact.loadSnapshot(snapFile));
+   TUASSERTE(size_t, 30, fact.size());
+   std::ostringstream dump;
+   fact.dump(dump, gnsstk::DumpDetail::Full);
+   TUASSERTE(std::string, expDump.str(), dump.str());
+      // no snapshot is written if any of the files can't be loaded
+   TUCSM("createSnapshot");
+   std::remove(snapFile.c_str());
+   files.push_back(tpath + "this_file_does_not_exist.rnx");
+   fact.clear();
+   TUASSERT(!fact.createSnapshot(snapFile, files));
+   TUASSERT(!std::ifstream(snapFile.c_str()));
+   fact.clear();
+   std::remove(files[0].c_str());
+   std::remove(files[1].c_str());
+   TURETURN();
+}
+
+
+unsigned NavSnapshot_T ::
+toolTest()
+{
+   TUDEF("NavSnapshot_create", "main");
+#ifdef NAVSNAPSHOT_CREATE
+   std::string tpath = gnsstk::getPathTestTemp() + gnsstk::getFileSep();
+   std::vector<std::string> files;
+   files.push_back(tpath + "test_output_NavSnapshot_T_3.rnx");
+   files.push_back(tpath + "test_output_NavSnapshot_T_4.rnx");
+   writeNav(files[0], 3, 302400);
+   writeNav(files[1], 5, 309600);
+   std::remove(snapFile.c_str());
+   std::string cmd = std::string("\"") + NAVSNAPSHOT_CREATE + "\" -t 2 -o \"" +
+      snapFile + "\"";
+   for (const auto& fn : files)
+   {
+      cmd += " \"" + fn + "\"";
+   }
+   gnsstk::MultiFormatNavDataFactory fact;
+      // expected results from the nav files themselves
+   fact.clear();
+   TUASSERT(fact.addDataSource(files[0]));
+   TUASSERT(fact.addDataSource(files[1]));
+   TUASSERTE(size_t, 24, fact.size());
+   std::ostringstream expDump;
+   fact.dump(expDump, gnsstk::DumpDetail::Full);
+   fact.clear();
+   TUASSERTE(int, 0, std::system(cmd.c_str()));
+   TUCSM("loadSnapshot");
+   TUASSERT(fact.loadSnapshot(snapFile));
+   TUASSERTE(size_t, 24, fact.size());
+   std::ostringstream dump;
+   fact.dump(dump, gnsstk::DumpDetail::Full);
+   TUASSERTE(std::string, expDump.str(), dump.str());
+   fact.clear();
+      // the tool fails and writes nothing if a file can't be loaded
+   TUCSM("main");
+   std::remove(snapFile.c_str());
+   cmd += " \"" + tpath + "this_file_does_not_exist.rnx\"";
+   TUASSERT(std::system(cmd.c_str()) != 0);
+   TUASSERT(!std::ifstream(snapFile.c_str()));
+   std::remove(files[0].c_str());
+   std::remove(files[1].c_str());
+#else
+   TUPASS("NavSnapshot_create is only built with BUILD_EXT");
+#endif
+   TURETURN();
+}
+
+
+int main()
+{
+   NavSnapshot_T testClass;
+   unsigned errorTotal = 0;
+
+   errorTotal += testClass.roundTripTest();
+   errorTotal += testClass.errorTest();
+   errorTotal += testClass.createTest();
+   errorTotal += testClass.toolTest();
+
+   std::cout << "Total Failures for " << __FILE__ << ": " << errorTotal
+             << std::endl;
+
+   return errorTotal;
+}
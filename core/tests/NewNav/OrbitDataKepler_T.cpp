@@ -74,6 +74,16 @@ public:
 };
 
 
+/// Make sure getXvt() uses overridden relativity corrections.
+class RelTestClass : public TestClass
+{
+public:
+   double svRelativity(const gnsstk::CommonTime& when,
+                       const gnsstk::EllipsoidModel& ell) const override
+   { return 1.5; }
+};
+
+
 class OrbitDataKepler_T
 {
 public:
@@ -81,6 +91,8 @@ public:
 
    unsigned constructorTest();
    unsigned getXvtTest();
+      /// Make sure the multi-epoch getXvt matches the single-epoch one.
+   unsigned getXvtBatchTest();
    unsigned svClockBiasTest();
    unsigned svClockDriftTest();
    unsigned isSameDataTest();
@@ -170,6 +182,58 @@ getXvtTest()
 }
 
 
+unsigned OrbitDataKepler_T ::
+getXvtBatchTest()
+{
+   TUDEF("OrbitDataKepler", "getXvt");
+   TestClass uut;
+   gnsstk::GPSEllipsoid ell;
+   fillTestClass(uut);
+   std::vector<gnsstk::CommonTime> when;
+   for (double offs = -7200; offs <= 7200; offs += 450)
+   {
+      when.push_back(ct + offs);
+   }
+      // Check with and without dndot, as the mean motion is computed
+      // differently.
+   for (double dndot : { 0.0, 1e-14 })
+   {
+      uut.dndot = dndot;
+      std::vector<gnsstk::Xvt> xvt(when.size());
+      TUASSERT(uut.OrbitDataKepler::getXvt(when.data(), when.size(), ell,
+                                           xvt.data()));
+      for (unsigned i = 0; i < when.size(); i++)
+      {
+         gnsstk::Xvt exp;
+         TUASSERT(uut.getXvt(when[i], ell, exp));
+         for (unsigned j = 0; j < 3; j++)
+         {
+            TUASSERTE(double, exp.x[j], xvt[i].x[j]);
+            TUASSERTE(double, exp.v[j], xvt[i].v[j]);
+         }
+         TUASSERTE(double, exp.clkbias, xvt[i].clkbias);
+         TUASSERTE(double, exp.clkdrift, xvt[i].clkdrift);
+         TUASSERTE(double, exp.relcorr, xvt[i].relcorr);
+         TUASSERTE(double, uut.OrbitDataKepler::svRelativity(when[i], ell),
+                   xvt[i].relcorr);
+         TUASSERTE(gnsstk::Xvt::HealthStatus, exp.health, xvt[i].health);
+      }
+   }
+      // The batch must call the virtual svRelativity() just as the
+      // single-epoch getXvt() does.
+   RelTestClass rel;
+   fillTestClass(rel);
+   std::vector<gnsstk::Xvt> xvt(when.size());
+   TUASSERT(rel.OrbitDataKepler::getXvt(when.data(), when.size(), ell,
+                                        xvt.data()));
+   for (unsigned i = 0; i < when.size(); i++)
+   {
+      TUASSERTE(double, 1.5, xvt[i].relcorr);
+   }
+   TURETURN();
+}
+
+
 unsigned OrbitDataKepler_T ::
 svClockBiasTest()
 {
@@ -254,6 +318,7 @@ int main()
 
    errorTotal += testClass.constructorTest();
    errorTotal += testClass.getXvtTest();
+   errorTotal += testClass.getXvtBatchTest();
    errorTotal += testClass.svClockBiasTest();
    errorTotal += testClass.svClockDriftTest();
    errorTotal += testClass.isSameDataTest();
@@ -37,6 +37,8 @@
 //
 //==============================================================================
 #include <math.h>
+#include <cstdio>
+#include <thread>
 #include "RinexNavDataFactory.hpp"
 #include "TestUtil.hpp"
 #include "GPSLNavEph.hpp"
@@ -62,6 +64,9 @@
 #include "GLOFNavISC.hpp"
 #include "RinexTimeOffset.hpp"
 #include "GALWeekSecond.hpp"
+#include "GPSWeekSecond.hpp"
+#include "Rinex3NavData.hpp"
+#include "Rinex3NavStream.hpp"
 
 namespace gnsstk
 {
@@ -124,6 +129,17 @@ public:
    unsigned loadIntoMapQZSSTest();
    unsigned decodeSISATest();
    unsigned encodeSISATest();
+      /** Run parseFile on two files concurrently, store the results
+       * using storeParsed and make sure the store matches loading
+       * the same files using addDataSource. */
+   unsigned parseFileTest();
+      /** Write a RINEX 3 GPS nav file containing one ephemeris per
+       * PRN in prns.
+       * @param[in] filename The path of the file to write.
+       * @param[in] prns The PRNs to write ephemerides for.
+       * @param[in] sow The GPS seconds of week of the ephemerides. */
+   void writeNav(const std::string& filename, const std::vector<int>& prns,
+                 double sow);
       /** Use dynamic_cast to verify that the contents of nmm are the
        * right class.
        * @param[in] testFramework The test framework created by TUDEF,
@@ -1380,6 +1396,106 @@ verifyDataType(gnsstk::TestUtil& testFramework,
 }
 
 
+void RinexNavDataFactory_T ::
+writeNav(const std::string& filename, const std::vector<int>& prns,
+         double sow)
+{
+   gnsstk::Rinex3NavStream strm(filename.c_str(), std::ios::out);
+   gnsstk::Rinex3NavHeader hdr;
+   hdr.version = 3.04;
+   hdr.fileType = "N: GNSS NAV DATA";
+   hdr.setFileSystem("G");
+   hdr.fileProgram = "RinexNavDataFact_T";
+   hdr.fileAgency = "gnsstk";
+   hdr.valid = gnsstk::Rinex3NavHeader::allValid3;
+   strm << hdr;
+   for (int prn : prns)
+   {
+      gnsstk::Rinex3NavData rnd;
+      rnd.time = gnsstk::GPSWeekSecond(2183, sow);
+      rnd.satSys = "G";
+      rnd.PRNID = prn;
+      rnd.sat = gnsstk::RinexSatID(prn, gnsstk::SatelliteSystem::GPS);
+      rnd.xmitTime = sow - 7200;
+      rnd.weeknum = 2183;
+      rnd.accuracy = 2.0;
+      rnd.health = 0;
+      rnd.codeflgs = 1;
+      rnd.L2Pdata = 0;
+      rnd.IODC = 10 + prn;
+      rnd.IODE = 10 + prn;
+      rnd.Toc = sow;
+      rnd.af0 = 1e-5 * prn;
+      rnd.af1 = 1e-12;
+      rnd.Tgd = -1.1e-8;
+      rnd.Toe = sow;
+      rnd.M0 = 0.1 * prn;
+      rnd.ecc = 0.01;
+      rnd.Ahalf = 5153.6;
+      rnd.OMEGA0 = 0.5 * prn;
+      rnd.i0 = 0.96;
+      rnd.w = -1.5;
+      rnd.fitint = 4;
+      strm << rnd;
+   }
+}
+
+
+unsigned RinexNavDataFactory_T ::
+parseFileTest()
+{
+   TUDEF("RinexNavDataFactory", "parseFile");
+   std::string tpath = gnsstk::getPathTestTemp() + gnsstk::getFileSep();
+   std::string file1(tpath + "test_output_RinexNavDataFactory_T_1.rnx"),
+      file2(tpath + "test_output_RinexNavDataFactory_T_2.rnx");
+   writeNav(file1, {1, 2, 3, 4}, 302400);
+   writeNav(file2, {3, 4, 5, 6}, 309600);
+      // load the files one at a time to get the expected results
+   gnsstk::RinexNavDataFactory expFact;
+   TUASSERT(expFact.addDataSource(file1));
+   TUASSERT(expFact.addDataSource(file2));
+      // ephemeris, health and ISC for each of the 8 records
+   TUASSERTE(size_t, 24, expFact.size());
+   std::ostringstream expDump;
+   expFact.dump(expDump, gnsstk::DumpDetail::Full);
+      // decode both files at the same time using the same factory
+   gnsstk::RinexNavDataFactory fact;
+   gnsstk::NavDataFactoryWithStoreFile::ParsedFilePtr parsed1, parsed2;
+   bool rv1 = false, rv2 = false;
+   std::thread thread1([&]() { rv1 = fact.parseFile(file1, parsed1); });
+   std::thread thread2([&]() { rv2 = fact.parseFile(file2, parsed2); });
+   thread1.join();
+   thread2.join();
+   TUASSERT(rv1);
+   TUASSERT(rv2);
+   TUASSERT(parsed1 != nullptr);
+   TUASSERT(parsed2 != nullptr);
+      // parseFile must not touch the store
+   TUASSERTE(size_t, 0, fact.size());
+   TUASSERTE(size_t, 12, parsed1->navOut.size());
+   TUASSERTE(size_t, 12, parsed2->navOut.size());
+   TUCSM("storeParsed");
+   TUASSERT(fact.storeParsed(parsed1));
+   TUASSERT(fact.storeParsed(parsed2));
+   TUASSERTE(size_t, expFact.size(), fact.size());
+   TUASSERTE(gnsstk::CommonTime, expFact.getInitialTime(),
+             fact.getInitialTime());
+   TUASSERTE(gnsstk::CommonTime, expFact.getFinalTime(),
+             fact.getFinalTime());
+   std::ostringstream dump;
+   fact.dump(dump, gnsstk::DumpDetail::Full);
+   TUASSERTE(std::string, expDump.str(), dump.str());
+      // a file that can't be decoded fails without changing the store
+   TUCSM("parseFile");
+   gnsstk::NavDataFactoryWithStoreFile::ParsedFilePtr parsed3;
+   TUASSERT(!fact.parseFile(file1 + ".does.not.exist", parsed3));
+   TUASSERTE(size_t, expFact.size(), fact.size());
+   std::remove(file1.c_str());
+   std::remove(file2.c_str());
+   TURETURN();
+}
+
+
 int main()
 {
    RinexNavDataFactory_T testClass;
@@ -1390,6 +1506,7 @@ int main()
    errorTotal += testClass.loadIntoMapQZSSTest();
    errorTotal += testClass.decodeSISATest();
    errorTotal += testClass.encodeSISATest();
+   errorTotal += testClass.parseFileTest();
 
    std::cout << "Total Failures for " << __FILE__ << ": " << errorTotal
              << std::endl;
@@ -36,6 +36,8 @@
 //                            release, distribution is unlimited.
 //
 //==============================================================================
+#include <atomic>
+#include <thread>
 #include "SP3NavDataFactory.hpp"
 #include "TestUtil.hpp"
 #include "OrbitDataSP3.hpp"
@@ -107,6 +109,22 @@ public:
    unsigned gapTest();
       /// Test nomTimeStep via the friendlier wrapper methods.
    unsigned nomTimeStepTest();
+      /// Make sure getXvt gives the same results as find.
+   unsigned getXvtTest();
+      /// Check the results of find and getXvt after compact.
+   unsigned compactTest();
+      /** Make sure find and getXvt give the same results from many
+       * threads at once when sealed, with and without compact. */
+   unsigned sealTest();
+      /** Compare the results of getXvt with those of find followed by
+       * OrbitDataSP3::getXvt for every satellite in fact.
+       * @param[in] testFramework The test framework created by TUDEF,
+       *   used by TUASSERT macros in this function.
+       * @param[in] fact The factory to compare results from.
+       * @param[in] step The time step in seconds between comparisons.
+       * @return The number of comparisons where getXvt succeeded. */
+   unsigned compareXvt(gnsstk::TestUtil& testFramework,
+                       gnsstk::SP3NavDataFactory& fact, double step);
       /** Exercise loadIntoMap by loading mixed source data.
        * @param[in] badPos Set the rejectBadPosFlag to this value.
        * @param[in] badClk Set the rejectBadClkFlag to this value.
@@ -1393,6 +1411,332 @@ nomTimeStepTest()
 }
 
 
+unsigned SP3NavDataFactory_T ::
+getXvtTest()
+{
+   TUDEF("SP3NavDataFactory", "getXvt");
+   std::string fname = gnsstk::getPathData() + gnsstk::getFileSep() +
+      "test_input_sp3_nav_ephemerisData.sp3";
+      // position only, velocity derived from the interpolation
+   gnsstk::SP3NavDataFactory fact1;
+   TUASSERT(fact1.addDataSource(fname));
+   TUASSERT(compareXvt(testFramework, fact1, 97.5) > 0);
+      // exact epochs
+   TUASSERT(compareXvt(testFramework, fact1, 900) > 0);
+      // make sure the tables are rebuilt when the order changes
+   fact1.setPositionInterpOrder(8);
+   fact1.setClockInterpOrder(4);
+   TUASSERT(compareXvt(testFramework, fact1, 97.5) > 0);
+   fact1.setClockLinearInterp();
+   TUASSERT(compareXvt(testFramework, fact1, 97.5) > 0);
+   fact1.setPosGapInterval(1);
+   TUASSERT(compareXvt(testFramework, fact1, 97.5) > 0);
+   fact1.setPosGapInterval(901);
+   fact1.setPosMaxInterval(900);
+   TUASSERT(compareXvt(testFramework, fact1, 97.5) > 0);
+      // position and velocity
+   fname = gnsstk::getPathData() + gnsstk::getFileSep() + "test_input_SP3c.sp3";
+   gnsstk::SP3NavDataFactory fact2;
+   TUASSERT(fact2.addDataSource(fname));
+   TUASSERT(compareXvt(testFramework, fact2, 97.5) > 0);
+      // make sure the tables are rebuilt when the clock data goes away
+   gnsstk::Xvt xvt;
+   gnsstk::SatID sat(1, gnsstk::SatelliteSystem::GPS);
+   TUASSERT(fact2.getXvt(sat, fact2.getInitialTime() + 1800, xvt));
+   fact2.clearClock();
+   TUASSERT(!fact2.getXvt(sat, fact2.getInitialTime() + 1800, xvt));
+   TURETURN();
+}
+
+
+unsigned SP3NavDataFactory_T ::
+compareXvt(gnsstk::TestUtil& testFramework, gnsstk::SP3NavDataFactory& fact,
+           double step)
+{
+   unsigned found = 0, mismatch = 0;
+   gnsstk::CommonTime start(fact.getInitialTime() - 3600),
+      end(fact.getFinalTime() + 3600);
+   for (const auto& sat : fact.getAvailableSats(
+           gnsstk::NavMessageType::Ephemeris, start, end))
+   {
+      gnsstk::NavMessageID nmid(sat, gnsstk::NavMessageType::Ephemeris);
+      for (gnsstk::CommonTime t = start; t <= end; t += step)
+      {
+         gnsstk::NavDataPtr nd;
+         gnsstk::Xvt exp, got;
+         bool expOK = fact.find(nmid, t, nd, gnsstk::SVHealth::Any,
+                                gnsstk::NavValidityType::ValidOnly,
+                                gnsstk::NavSearchOrder::User) &&
+            dynamic_cast<gnsstk::OrbitData*>(nd.get())->getXvt(t, exp);
+         bool gotOK = fact.getXvt(sat.sat, t, got);
+         if (expOK != gotOK)
+         {
+            mismatch++;
+            continue;
+         }
+         if (!gotOK)
+            continue;
+         found++;
+         for (unsigned i = 0; i < 3; i++)
+         {
+            if ((fabs(exp.x[i] - got.x[i]) > 1e-6) ||
+                (fabs(exp.v[i] - got.v[i]) > 1e-7))
+            {
+               mismatch++;
+            }
+         }
+         if ((fabs(exp.clkbias - got.clkbias) > 1e-15) ||
+             (fabs(exp.clkdrift - got.clkdrift) > 1e-18) ||
+             (fabs(exp.relcorr - got.relcorr) > 1e-15) ||
+             (exp.health != got.health) || (exp.frame != got.frame))
+         {
+            mismatch++;
+         }
+      }
+   }
+   TUASSERTE(unsigned, 0, mismatch);
+   return found;
+}
+
+
+unsigned SP3NavDataFactory_T ::
+compactTest()
+{
+   TUDEF("SP3NavDataFactory", "compact");
+   std::string fname = gnsstk::getPathData() + gnsstk::getFileSep() +
+      "test_input_sp3_nav_ephemerisData.sp3";
+   gnsstk::SP3NavDataFactory expFact, uut;
+   TUASSERT(expFact.addDataSource(fname));
+   TUASSERT(uut.addDataSource(fname));
+   size_t expSize = uut.size();
+   TUASSERT(!uut.isCompact());
+   TUCATCH(uut.compact(1e-4, 1e-6, 1e-12, 1e-15));
+   TUASSERT(uut.isCompact());
+      // only the store entries at the segment ends are kept
+   TUASSERT(uut.size() < expSize);
+   gnsstk::CommonTime t0(expFact.getInitialTime()),
+      t1(expFact.getFinalTime());
+   TUASSERTE(gnsstk::CommonTime, t0, uut.getInitialTime());
+   TUASSERTE(gnsstk::CommonTime, t1, uut.getFinalTime());
+   gnsstk::NavSatelliteIDSet sats = expFact.getAvailableSats(t0, t1);
+   TUASSERT(sats == uut.getAvailableSats(t0, t1));
+      // availability between the kept entries comes from the segments
+   gnsstk::CommonTime mid(t0 + 43210.5);
+   TUASSERT(sats == uut.getAvailableSats(mid, mid + 1.0));
+   TUASSERT(sats == uut.getAvailableSats(gnsstk::NavMessageType::Ephemeris,
+                                         mid, mid + 1.0));
+   TUASSERT(expFact.getIndexSet(mid, mid + 1.0) ==
+            uut.getIndexSet(mid, mid + 1.0));
+      // Compare with the interpolated results, avoiding the sample
+      // times where the uncompacted factory may be unable to
+      // interpolate and return the sample as-is.
+   unsigned found = 0, missing = 0, extra = 0, mismatch = 0;
+   for (const auto& sat : sats)
+   {
+      for (gnsstk::CommonTime t = t0 + 0.25; t < t1; t += 97.5)
+      {
+         gnsstk::Xvt exp, got;
+         bool expOK = expFact.getXvt(sat.sat, t, exp);
+         bool gotOK = uut.getXvt(sat.sat, t, got);
+         if (expOK && !gotOK)
+         {
+            missing++;
+            continue;
+         }
+         if (gotOK && !expOK)
+         {
+            extra++;
+            continue;
+         }
+         if (!gotOK)
+            continue;
+         found++;
+         for (unsigned i = 0; i < 3; i++)
+         {
+            if ((fabs(exp.x[i] - got.x[i]) > 1.001e-4) ||
+                (fabs(exp.v[i] - got.v[i]) > 1.001e-6))
+            {
+               mismatch++;
+            }
+         }
+         if ((fabs(exp.clkbias - got.clkbias) > 1.001e-12) ||
+             (fabs(exp.clkdrift - got.clkdrift) > 1.001e-15) ||
+             (exp.frame != got.frame))
+         {
+            mismatch++;
+         }
+      }
+   }
+   TUASSERT(found > 0);
+   TUASSERTE(unsigned, 0, extra);
+   TUASSERTE(unsigned, 0, mismatch);
+      // Only samples near the ends are lost, each satellite in
+      // this file is interpolated over most of the day.
+   TUASSERT(missing < found / 10);
+      // find returns the same thing as getXvt
+   gnsstk::SatID sat(sats.begin()->sat);
+   gnsstk::NavMessageID nmid(*sats.begin(), gnsstk::NavMessageType::Ephemeris);
+   gnsstk::CommonTime when(t0 + 43210.5);
+   gnsstk::NavDataPtr nd;
+   gnsstk::Xvt xvt1, xvt2;
+   TUASSERT(uut.find(nmid, when, nd, gnsstk::SVHealth::Any,
+                     gnsstk::NavValidityType::ValidOnly,
+                     gnsstk::NavSearchOrder::User));
+   gnsstk::OrbitDataSP3 *od = dynamic_cast<gnsstk::OrbitDataSP3*>(nd.get());
+   TUASSERT(od != nullptr);
+   if (od != nullptr)
+   {
+      TUASSERTE(gnsstk::CommonTime, when, od->timeStamp);
+      TUASSERTE(gnsstk::SatID, sat, od->signal.sat);
+      TUASSERT(od->getXvt(when, xvt1));
+      TUASSERT(uut.getXvt(sat, when, xvt2));
+      TUASSERTE(gnsstk::Triple, xvt2.x, xvt1.x);
+      TUASSERTE(gnsstk::Triple, xvt2.v, xvt1.v);
+      TUASSERTFE(xvt2.clkbias, xvt1.clkbias);
+         // sigmas are not retained, they're initOrbitDataVal
+      for (unsigned i = 0; i < 3; i++)
+      {
+         TUASSERTFE(0.0, od->posSig[i]);
+         TUASSERTFE(0.0, od->velSig[i]);
+      }
+      TUASSERTFE(0.0, od->biasSig);
+      TUASSERTFE(0.0, od->driftSig);
+   }
+      // no more loading once compact
+   TUASSERT(!uut.addDataSource(fname));
+      // edited data is no longer available
+   TUCATCH(uut.edit(t0, t0 + 43200));
+   TUASSERT(!uut.getXvt(sat, t0 + 21600.5, xvt1));
+   TUASSERT(uut.getXvt(sat, t0 + 64800.5, xvt1));
+   TUASSERTE(size_t, 0, uut.getAvailableSats(t0, t0 + 21600).size());
+      // edit a span in the middle of a single satellite's segments
+   TUCATCH(uut.edit(t0 + 64800, t0 + 64801, *sats.begin()));
+   TUASSERT(!uut.getXvt(sat, t0 + 64800.5, xvt1));
+   TUASSERTE(size_t, 0, uut.getAvailableSats(t0 + 64800, t0 + 64801)
+             .count(*sats.begin()));
+      // start over
+   TUCATCH(uut.clear());
+   TUASSERT(!uut.getXvt(sat, when, xvt1));
+   TUASSERT(uut.addDataSource(fname));
+   TUASSERT(!uut.isCompact());
+   TUASSERT(uut.getXvt(sat, when, xvt1));
+   TURETURN();
+}
+
+
+unsigned SP3NavDataFactory_T ::
+sealTest()
+{
+   TUDEF("SP3NavDataFactory", "seal");
+   std::string fname = gnsstk::getPathData() + gnsstk::getFileSep() +
+      "test_input_SP3c.sp3";
+      // expFact is searched from one thread to get the expected results
+   gnsstk::SP3NavDataFactory uut, expFact;
+   TUASSERT(uut.addDataSource(fname));
+   TUASSERT(expFact.addDataSource(fname));
+   gnsstk::CommonTime start(uut.getInitialTime() - 900),
+      end(uut.getFinalTime() + 900);
+   std::vector<gnsstk::SatID> sats;
+   for (const auto& sat : uut.getAvailableSats(
+           gnsstk::NavMessageType::Ephemeris, start, end))
+   {
+      sats.push_back(sat.sat);
+   }
+      // a satellite with no data
+   sats.push_back(gnsstk::SatID(40, gnsstk::SatelliteSystem::GPS));
+   std::vector<gnsstk::CommonTime> times;
+   for (gnsstk::CommonTime t = start; t <= end; t += 487.5)
+   {
+      times.push_back(t);
+   }
+   size_t numQueries = 2 * sats.size() * times.size();
+      /* Run query number q on fact, using getXvt for even q and
+       * find for odd q, returning the resulting Xvt, or a default
+       * Xvt on failure. */
+   auto query = [&](gnsstk::SP3NavDataFactory& fact, size_t q) -> gnsstk::Xvt
+   {
+      gnsstk::Xvt xvt;
+      const gnsstk::SatID& sat(sats[(q / 2) % sats.size()]);
+      const gnsstk::CommonTime& t(times[(q / 2) / sats.size()]);
+      if (q & 1)
+      {
+         gnsstk::NavDataPtr nd;
+         gnsstk::NavMessageID nmid(
+            gnsstk::NavSatelliteID(sat.id, sat.system,
+                                   gnsstk::CarrierBand::Any,
+                                   gnsstk::TrackingCode::Any,
+                                   gnsstk::NavType::Any),
+            gnsstk::NavMessageType::Ephemeris);
+         if (!fact.find(nmid, t, nd, gnsstk::SVHealth::Any,
+                        gnsstk::NavValidityType::ValidOnly,
+                        gnsstk::NavSearchOrder::User) ||
+             !dynamic_cast<gnsstk::OrbitData*>(nd.get())->getXvt(t, xvt))
+         {
+            return gnsstk::Xvt();
+         }
+      }
+      else if (!fact.getXvt(sat, t, xvt))
+      {
+         return gnsstk::Xvt();
+      }
+      return xvt;
+   };
+   for (bool compact : { false, true })
+   {
+      if (compact)
+      {
+         uut.compact();
+         expFact.compact();
+         TUASSERT(!uut.isSealed());
+      }
+      std::vector<gnsstk::Xvt> expected;
+      unsigned found = 0;
+      for (size_t q = 0; q < numQueries; q++)
+      {
+         expected.push_back(query(expFact, q));
+         if (expected.back().x[0] != 0)
+            found++;
+      }
+      TUASSERT(found > 100);
+      TUASSERT(found < expected.size());
+      uut.seal();
+      TUASSERT(uut.isSealed());
+      const unsigned numThreads = 8;
+      std::atomic<unsigned> mismatch(0);
+      std::vector<std::thread> threads;
+      for (unsigned th = 0; th < numThreads; th++)
+      {
+         threads.push_back(std::thread([&, th]()
+         {
+            unsigned bad = 0;
+            size_t first = th * numQueries / numThreads;
+            for (size_t n = 0; n < numQueries; n++)
+            {
+               size_t q = (first + n) % numQueries;
+               gnsstk::Xvt got(query(uut, q));
+               if (!(got.x == expected[q].x) || !(got.v == expected[q].v) ||
+                   (got.clkbias != expected[q].clkbias))
+               {
+                  bad++;
+               }
+            }
+            mismatch += bad;
+         }));
+      }
+      for (auto& th : threads)
+      {
+         th.join();
+      }
+      TUASSERTE(unsigned, 0, mismatch);
+      TUASSERT(uut.isSealed());
+   }
+      // changing the configuration unseals
+   uut.setClockLinearInterp();
+   TUASSERT(!uut.isSealed());
+   TURETURN();
+}
+
+
 int main()
 {
    SP3NavDataFactory_T testClass;
@@ -1422,6 +1766,9 @@ int main()
    errorTotal += testClass.addRinexClockTest();
    errorTotal += testClass.gapTest();
    errorTotal += testClass.nomTimeStepTest();
+   errorTotal += testClass.getXvtTest();
+   errorTotal += testClass.compactTest();
+   errorTotal += testClass.sealTest();
 
    std::cout << "Total Failures for " << __FILE__ << ": " << errorTotal
              << std::endl;
@@ -70,6 +70,7 @@ public:
    unsigned testRawRange4HandlesException();
    unsigned testSvRelativityCorrection();
    unsigned testTropoCorrection();
+   unsigned testTropoCorrections();
    unsigned testIonoCorrection();
 
    gnsstk::NavLibrary navLib;
@@ -405,6 +406,38 @@ testTropoCorrection()
    TURETURN();
 }
 
+unsigned OrdUnitTests_T ::
+testTropoCorrections()
+{
+   class MockTropo : public gnsstk::NBTropModel
+   {
+      void corrections(const std::vector<double>& elevations,
+                       std::vector<double>& delays) const
+      {
+         delays = elevations;
+      }
+   };
+
+   TUDEF("ORD", "TroposphereCorrections");
+   std::vector<gnsstk::Xvt> fakeXvts(2);
+   fakeXvts[0].x = gnsstk::Triple(100, 100, 100);
+   fakeXvts[1].x = gnsstk::Triple(-100, 50, 200);
+   MockTropo tropo;
+
+   gnsstk::Position rxLocation(10, 10, 0);
+
+   std::vector<double> return_value =
+      TroposphereCorrections(tropo, rxLocation, fakeXvts);
+
+   TUASSERTE(size_t, 2, return_value.size());
+   for (size_t i = 0; i < fakeXvts.size(); i++)
+   {
+      TUASSERTFE(rxLocation.elevation(gnsstk::Position(fakeXvts[i])),
+                 return_value[i]);
+   }
+   TURETURN();
+}
+
 unsigned OrdUnitTests_T ::
 testIonoCorrection()
 {
@@ -460,6 +493,7 @@ int main()
    errorTotal += testClass.testRawRange4HandlesException();
    errorTotal += testClass.testSvRelativityCorrection();
    errorTotal += testClass.testTropoCorrection();
+   errorTotal += testClass.testTropoCorrections();
    errorTotal += testClass.testIonoCorrection();
 
    std::cout << "Total Failures for " << __FILE__ << ": " << errorTotal
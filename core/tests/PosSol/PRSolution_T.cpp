@@ -0,0 +1,453 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <new>
+#include <map>
+#include <random>
+#include <vector>
+#include "PRSolution.hpp"
+#include "NavLibrary.hpp"
+#include "NavDataFactory.hpp"
+#include "OrbitData.hpp"
+#include "RawRange.hpp"
+#include "GPSEllipsoid.hpp"
+#include "GPSWeekSecond.hpp"
+#include "TropModel.hpp"
+#include "GGTropModel.hpp"
+#include "TestUtil.hpp"
+
+using namespace std;
+using namespace gnsstk;
+
+   /// Number of calls to operator new, for allocationTest().
+static std::atomic<unsigned long> newCount(0);
+
+void* operator new(std::size_t size)
+{
+   newCount++;
+   void *p = std::malloc(size ? size : 1);
+   if (p == nullptr)
+      throw std::bad_alloc();
+   return p;
+}
+
+void operator delete(void* p) noexcept
+{
+   std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+   std::free(p);
+}
+
+   /// A satellite in a circular orbit.
+class CircularOrbit : public OrbitData
+{
+public:
+   CircularOrbit(const CommonTime& epoch, double radius, double incl,
+                 double raan, double phase)
+         : t0(epoch), r(radius), i(incl), node(raan), u0(phase),
+           n(std::sqrt(GPSEllipsoid().gm() / (radius*radius*radius)))
+   { timeStamp = epoch; }
+
+   NavDataPtr clone() const override
+   { return std::make_shared<CircularOrbit>(*this); }
+
+   bool validate() const override
+   { return true; }
+
+   bool getXvt(const CommonTime& when, Xvt& xvt, const ObsID& oid) override
+   {
+      double dt = when - t0;
+      double u = u0 + n*dt, th = GPSEllipsoid().angVelocity() * dt;
+      double cu = std::cos(u), su = std::sin(u);
+      double cn = std::cos(node), sn = std::sin(node);
+      double ci = std::cos(i), si = std::sin(i);
+         // inertial position and velocity
+      double p[3] = { r*(cn*cu - sn*su*ci), r*(sn*cu + cn*su*ci), r*su*si };
+      double v[3] = { r*n*(-cn*su - sn*cu*ci), r*n*(-sn*su + cn*cu*ci),
+                      r*n*cu*si };
+         // rotate into the Earth-fixed frame
+      double ct = std::cos(th), st = std::sin(th);
+      xvt.x[0] = ct*p[0] + st*p[1];
+      xvt.x[1] = -st*p[0] + ct*p[1];
+      xvt.x[2] = p[2];
+      double w = GPSEllipsoid().angVelocity();
+      xvt.v[0] = ct*v[0] + st*v[1] + w*xvt.x[1];
+      xvt.v[1] = -st*v[0] + ct*v[1] - w*xvt.x[0];
+      xvt.v[2] = v[2];
+      xvt.clkbias = xvt.clkdrift = xvt.relcorr = 0.0;
+      xvt.health = Xvt::Healthy;
+      return true;
+   }
+
+private:
+   CommonTime t0;
+   double r, i, node, u0, n;
+};
+
+
+   /// Serve CircularOrbit objects to NavLibrary.
+class CircularOrbitFactory : public NavDataFactory
+{
+public:
+   CircularOrbitFactory()
+   {
+      supportedSignals.insert(
+         NavSignalID(SatelliteSystem::GPS, CarrierBand::L1, TrackingCode::CA,
+                     NavType::GPSLNAV));
+      supportedSignals.insert(
+         NavSignalID(SatelliteSystem::Galileo, CarrierBand::L1,
+                     TrackingCode::E1B, NavType::GalINAV));
+   }
+
+   bool find(const NavMessageID& nmid, const CommonTime& when,
+             NavDataPtr& navData, SVHealth xmitHealth, NavValidityType valid,
+             NavSearchOrder order) override
+   {
+      auto oi = orbits.find(nmid.sat);
+      if ((nmid.messageType != NavMessageType::Ephemeris) ||
+          (oi == orbits.end()))
+      {
+         return false;
+      }
+      navData = oi->second;
+      return true;
+   }
+
+   bool getOffset(TimeSystem fromSys, TimeSystem toSys,
+                  const CommonTime& when, NavDataPtr& offset,
+                  SVHealth xmitHealth, NavValidityType valid) override
+   { return false; }
+
+   bool addDataSource(const std::string& source) override
+   { return false; }
+
+   std::string getFactoryFormats() const override
+   { return "circular orbits"; }
+
+   NavSatelliteIDSet getAvailableSats(const CommonTime& fromTime,
+                                      const CommonTime& toTime)
+      const override
+   {
+      NavSatelliteIDSet rv;
+      for (const auto& oi : orbits)
+         rv.insert(NavSatelliteID(oi.first));
+      return rv;
+   }
+
+   NavSatelliteIDSet getAvailableSats(NavMessageType nmt,
+                                      const CommonTime& fromTime,
+                                      const CommonTime& toTime)
+      const override
+   { return getAvailableSats(fromTime, toTime); }
+
+   NavMessageIDSet getAvailableMsgs(const CommonTime& fromTime,
+                                    const CommonTime& toTime)
+      const override
+   { return NavMessageIDSet(); }
+
+   std::map<SatID, NavDataPtr> orbits;
+};
+
+
+class PRSolution_T
+{
+public:
+   PRSolution_T();
+      /// Compare FastRAIM with the exhaustive RAIM search, one fault
+   unsigned fastRAIMTest();
+      /// Same, with three faults, so the threads evaluate stage 3
+   unsigned fastRAIMThreadsTest();
+      /** Make sure that SimplePRSolution() doesn't allocate memory
+       * once it has solved an epoch of the same size. */
+   unsigned allocationTest();
+
+      /** Simulate the pseudoranges of the count highest satellites
+       * and add the faults to the satellites of the given indexes. */
+   void simulate(size_t count, const vector<size_t>& bad,
+                 const vector<double>& faults);
+      /** Solve the simulated epoch with RAIMCompute() and compare
+       * FastRAIM, with and without FastRAIMVerify and with one and
+       * several threads, to the exhaustive search.
+       * @param[in] bad the indexes of the faulty satellites. */
+   void compare(TestUtil& testFramework, const vector<size_t>& bad);
+
+   NavLibrary navLib;
+   shared_ptr<CircularOrbitFactory> fact;
+   CommonTime time;
+   vector<SatID> sats;
+   vector<double> pr;
+};
+
+
+PRSolution_T ::
+PRSolution_T()
+      : fact(make_shared<CircularOrbitFactory>()),
+        time(GPSWeekSecond(2200, 3600.0))
+{
+      // six planes of eight GPS and of eight Galileo satellites
+   CommonTime t0 = GPSWeekSecond(2200, 0.0);
+   for (int sys = 0; sys < 2; sys++)
+   {
+      double radius = (sys == 0 ? 26560.e3 : 29600.e3);
+      double incl = (sys == 0 ? 55.0 : 56.0) * DEG_TO_RAD;
+      for (int plane = 0; plane < 6; plane++)
+      {
+         for (int slot = 0; slot < 8; slot++)
+         {
+            SatID sat(1 + plane*8 + slot, (sys == 0 ?
+                                           SatelliteSystem::GPS :
+                                           SatelliteSystem::Galileo));
+            fact->orbits[sat] = make_shared<CircularOrbit>(
+               t0, radius, incl, (plane*60.0 + sys*30.0) * DEG_TO_RAD,
+               (slot*45.0 + plane*7.5 + sys*20.0) * DEG_TO_RAD);
+         }
+      }
+   }
+   NavDataFactoryPtr ndfp(fact);
+   navLib.addFactory(ndfp);
+}
+
+
+void PRSolution_T ::
+simulate(size_t count, const vector<size_t>& bad,
+         const vector<double>& faults)
+{
+   GPSEllipsoid ell;
+   Position rx(30.4, 262.3, 200.0, Position::Geodetic);
+   rx.asECEF();
+   const double clock[2] = { 1234.5, 1312.8 };
+   mt19937 gen(1);
+   normal_distribution<double> noise(0.0, 0.5);
+
+   multimap<double, SatID> byElev;
+   for (auto& oi : fact->orbits)
+   {
+      Xvt xvt;
+      dynamic_cast<OrbitData*>(oi.second.get())->getXvt(time, xvt, ObsID());
+      double elev = rx.elevation(Position(xvt.x));
+      if (elev > 5.0)
+         byElev.insert(make_pair(-elev, oi.first));
+   }
+   sats.clear();
+   pr.clear();
+   for (const auto& bi : byElev)
+   {
+      if (sats.size() == count)
+         break;
+      sats.push_back(bi.second);
+   }
+   for (const auto& sat : sats)
+   {
+      double clk = clock[sat.system == SatelliteSystem::GPS ? 0 : 1];
+      double range = 0.075 * ell.c() + clk;
+      for (int iter = 0; iter < 3; iter++)
+      {
+         tie(ignore, range, ignore) = RawRange::fromNominalReceiveWithObs(
+            rx, time, range, navLib, NavSatelliteID(sat), ell);
+         range += clk;
+      }
+      pr.push_back(range + noise(gen));
+   }
+   for (size_t i = 0; i < bad.size(); i++)
+   {
+      pr[bad[i]] += faults[i];
+   }
+}
+
+
+void PRSolution_T ::
+compare(TestUtil& testFramework, const vector<size_t>& bad)
+{
+   ZeroTropModel trop;
+   Matrix<double> invMC(sats.size(), sats.size(), 0.0);
+   for (size_t i = 0; i < sats.size(); i++)
+      invMC(i,i) = 1.0;
+
+      // the exhaustive search
+   PRSolution all;
+   all.allowedGNSS = { SatelliteSystem::GPS, SatelliteSystem::Galileo };
+   vector<SatID> allSats(sats);
+   int allRet = all.RAIMCompute(time, allSats, pr, invMC, navLib, &trop);
+   TUASSERTE(int, 0, allRet);
+   for (size_t i = 0; i < allSats.size(); i++)
+   {
+      bool isBad = (find(bad.begin(), bad.end(), i) != bad.end());
+      TUASSERTE(bool, isBad, allSats[i].id <= 0);
+   }
+
+   for (bool verify : { false, true })
+   {
+      for (unsigned threads : { 1, 4 })
+      {
+         PRSolution fast;
+         fast.allowedGNSS = all.allowedGNSS;
+         fast.FastRAIM = true;
+         fast.FastRAIMVerify = verify;
+         fast.RAIMThreads = threads;
+         vector<SatID> fastSats(sats);
+         int fastRet = fast.RAIMCompute(time, fastSats, pr, invMC, navLib,
+                                        &trop);
+         TUASSERTE(int, allRet, fastRet);
+         TUASSERTE(size_t, allSats.size(), fastSats.size());
+         for (size_t i = 0; i < allSats.size(); i++)
+         {
+            TUASSERTE(SatID, allSats[i], fastSats[i]);
+         }
+            // the full solutions iterate from different starting
+            // points, so agree only to the convergence limit
+         TUASSERTE(size_t, all.Solution.size(), fast.Solution.size());
+         for (size_t i = 0; i < all.Solution.size(); i++)
+         {
+            TUASSERTFEPS(all.Solution(i), fast.Solution(i), 1.e-6);
+         }
+         TUASSERTFEPS(all.RMSResidual, fast.RMSResidual, 1.e-6);
+         TUASSERTE(int, all.Nsvs, fast.Nsvs);
+      }
+   }
+}
+
+
+unsigned PRSolution_T ::
+fastRAIMTest()
+{
+   TUDEF("PRSolution", "RAIMCompute");
+   vector<size_t> bad = { 4 };
+   simulate(10, bad, { 75.0 });
+   compare(testFramework, bad);
+   TURETURN();
+}
+
+
+unsigned PRSolution_T ::
+fastRAIMThreadsTest()
+{
+   TUDEF("PRSolution", "RAIMCompute");
+   vector<size_t> bad = { 1, 6, 11 };
+   simulate(16, bad, { 80.0, -60.0, 110.0 });
+   TUASSERTE(size_t, 16, sats.size());
+   compare(testFramework, bad);
+   TURETURN();
+}
+
+
+unsigned PRSolution_T ::
+allocationTest()
+{
+   TUDEF("PRSolution", "SimplePRSolution");
+   simulate(12, {}, {});
+   ZeroTropModel zeroTrop;
+   GGTropModel ggTrop;
+   for (TropModel *trop : { (TropModel*)&zeroTrop, (TropModel*)&ggTrop })
+   {
+      PRSolution prs;
+      prs.allowedGNSS = { SatelliteSystem::GPS, SatelliteSystem::Galileo };
+      vector<SatID> useSats(sats);
+      Matrix<double> svp;
+      TUASSERTE(int, 12, prs.PreparePRSolution(time, useSats, pr, navLib,
+                                               svp));
+      Matrix<double> invMC(sats.size(), sats.size(), 0.0);
+      for (size_t i = 0; i < sats.size(); i++)
+         invMC(i,i) = 0.25;
+      Vector<double> resid, slopes;
+         // the first epoch sizes the storage
+      TUASSERTE(int, 0, prs.SimplePRSolution(time, useSats, svp, invMC, trop,
+                                             10, 3.e-7, resid, slopes));
+      Vector<double> first(prs.Solution);
+      Matrix<double> firstCov(prs.Covariance);
+      unsigned long before = newCount;
+      int rv = 0;
+      for (unsigned epoch = 0; epoch < 10; epoch++)
+      {
+         rv |= prs.SimplePRSolution(time, useSats, svp, invMC, trop, 10,
+                                    3.e-7, resid, slopes);
+      }
+      unsigned long allocs = newCount - before;
+      TUASSERTE(int, 0, rv);
+      TUASSERTE(unsigned long, 0, allocs);
+         // and gets the same answer every time
+      TUASSERTE(size_t, 5, prs.Solution.size());
+      for (size_t i = 0; i < first.size(); i++)
+      {
+         TUASSERTFE(first(i), prs.Solution(i));
+         for (size_t j = 0; j < first.size(); j++)
+         {
+            TUASSERTFE(firstCov(i,j), prs.Covariance(i,j));
+         }
+      }
+      TUASSERTE(size_t, 12, resid.size());
+      TUASSERTE(size_t, 12, slopes.size());
+         // the covariance is the inverse of the normal matrix
+      Matrix<double> normal(transpose(prs.Partials) * prs.invMeasCov *
+                            prs.Partials);
+      Matrix<double> unit(normal * prs.Covariance);
+      double maxErr = 0.0;
+      for (size_t i = 0; i < unit.rows(); i++)
+      {
+         for (size_t j = 0; j < unit.cols(); j++)
+         {
+            maxErr = std::max(maxErr, std::fabs(unit(i,j) - (i == j)));
+         }
+      }
+      TUASSERT(maxErr < 1.e-9);
+   }
+   TURETURN();
+}
+
+
+int main()
+{
+   PRSolution_T testClass;
+   unsigned errorTotal = 0;
+
+   errorTotal += testClass.fastRAIMTest();
+   errorTotal += testClass.fastRAIMThreadsTest();
+   errorTotal += testClass.allocationTest();
+
+   std::cout << "Total Failures for " << __FILE__ << ": " << errorTotal
+             << std::endl;
+
+   return errorTotal;
+}
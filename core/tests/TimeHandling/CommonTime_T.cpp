@@ -43,6 +43,7 @@
 #include "CivilTime.hpp"
 #include <iostream>
 #include <cmath>
+#include <type_traits>
 using namespace gnsstk;
 using namespace std;
 
@@ -86,6 +87,8 @@ public:
    unsigned rolloverTest();
 
    unsigned changeTimeSystemTest();
+      /// Test the precision kept by the packed representation
+   unsigned precisionTest();
 private:
 
    double eps;
@@ -895,6 +898,54 @@ changeTimeSystemTest()
    TURETURN();
 }
 
+unsigned CommonTime_T ::
+precisionTest()
+{
+   TUDEF("CommonTime", "precision");
+
+      // CommonTime can be a compile time constant and copied as bytes
+   constexpr CommonTime constTime(gnsstk::TimeSystem::GPS);
+   TUASSERTE(gnsstk::TimeSystem, gnsstk::TimeSystem::GPS,
+             constTime.getTimeSystem());
+   TUASSERTE(bool, true, std::is_trivially_copyable<CommonTime>::value);
+
+   long day, msod;
+   double fsod;
+   CommonTime t1, t2;
+   t1.setInternal(2459000, 12345678, 0.000123456789);
+
+      // sub-picosecond steps survive many days away
+   t2 = t1;
+   t2.addDays(10000);
+   t2.addSeconds(1.0e-12);
+   t2.getInternal(day, msod, fsod);
+   TUASSERTE(long, 2469000, day);
+   TUASSERTE(long, 12345678, msod);
+   TUASSERTFEPS(0.000123456789 + 1.0e-12, fsod, 1.0e-19);
+
+   t2 = t1 + 1.0e-12;
+   TUASSERTFEPS(1.0e-12, t2 - t1, 1.0e-19);
+   TUASSERT(t1 < t2);
+   TUASSERT(!(t2 < t1));
+   TUASSERT(t1 != t2);
+
+      // whole seconds are exact across the whole range
+   t2 = CommonTime::END_OF_TIME;
+   t2.setTimeSystem(gnsstk::TimeSystem::Unknown);
+   t2.addSeconds(-1L);
+   t1 = CommonTime::BEGINNING_OF_TIME;
+   t1.setTimeSystem(gnsstk::TimeSystem::Unknown);
+   TUASSERTE(double, (CommonTime::END_LIMIT_JDAY * 86400.0) - 1.0, t2 - t1);
+
+      // before day 0 the millisecond of day stays positive
+   t1.addSeconds(-1L);
+   t1.getInternal(day, msod, fsod);
+   TUASSERTE(long, -1, day);
+   TUASSERTE(long, 86399000, msod);
+
+   TURETURN();
+}
+
 
 
 //============================================================
@@ -919,6 +970,7 @@ int main()
    errorTotal += testClass.timeSystemTest();
    errorTotal += testClass.printfTest();
    errorTotal += testClass.changeTimeSystemTest();
+   errorTotal += testClass.precisionTest();
 
       //----------------------------------------
       // Echo total fails to stdout
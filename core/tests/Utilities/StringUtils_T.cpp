@@ -40,6 +40,7 @@
 #include <string>
 #include <sstream>
 #include <iterator>
+#include <cmath>
 #include "StringUtils.hpp"
 #include "TestUtil.hpp"
 
@@ -412,6 +413,43 @@ public:
    }
 
 
+      /**
+       * Tests for the fixed-width field to number methods.  The
+       * results must be identical to converting a copy of the field
+       * as a std::string.
+       */
+   unsigned fieldToNumberTest()
+   {
+      TUDEF("StringUtils", "asDouble(const char*,size_t)");
+      const char *fields[] = {
+         "  23619095.450", "   -122345.678", "         0.000", "-0.000",
+         "              ", "", "-", ".", "+.5", "12 34", "1.2.3", "1.5E+03",
+         "1.5e-3", "1.5D+03", "0x1A", "inf", "123456789012345",
+         "1234567890123456789", "0.1234567890123456789", "  1e400", "abc" };
+      for (const char *field : fields)
+      {
+         string str(field);
+         double expect = asDouble(str);
+         double got = asDouble(field, str.length());
+         TUASSERTE(double, expect, got);
+         TUASSERTE(bool, std::signbit(expect), std::signbit(got));
+      }
+         // only the given width is used
+      TUASSERTE(double, 123.0, asDouble("123456", 3));
+      TUASSERTE(double, 1.2, asDouble("1.25", 3));
+      TUCSM("asInt(const char*,size_t)");
+      const char *ints[] = {
+         "  12", "-7", "+3", " ", "", "1 2", "x", "12345678901234567890" };
+      for (const char *field : ints)
+      {
+         string str(field);
+         TUASSERTE(long, asInt(str), asInt(field, str.length()));
+      }
+      TUASSERTE(long, 12, asInt("123", 2));
+      TURETURN();
+   }
+
+
       /**
        * Tests for the number to string method.
        * Given numbers of various types, convert them to a string and
@@ -1269,6 +1307,7 @@ int main() // Main function to initialize and run all tests above
    errorTotal += testClass.stripTrailingTest();
    errorTotal += testClass.stripTest();
    errorTotal += testClass.stringToNumberTest();
+   errorTotal += testClass.fieldToNumberTest();
    errorTotal += testClass.numberToStringTest();
    errorTotal += testClass.hexConversionTest();
    errorTotal += testClass.stringReplaceTest();
@@ -0,0 +1,126 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+
+/** @file BenchmarkUtil.hpp Small helpers shared by the *_benchmark
+ * example programs for timing code and measuring memory use. */
+
+#ifndef GNSSTK_BENCHMARKUTIL_HPP
+#define GNSSTK_BENCHMARKUTIL_HPP
+
+#include <chrono>
+#include <fstream>
+#include <string>
+#include <iostream>
+#include <iomanip>
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
+namespace gnsstk
+{
+      /// Simple wall-clock stop watch.
+   class BenchTimer
+   {
+   public:
+         /// Start timing on construction.
+      BenchTimer()
+            : start(std::chrono::steady_clock::now())
+      {}
+         /// Restart the timer.
+      void reset()
+      { start = std::chrono::steady_clock::now(); }
+         /// Return the elapsed time in seconds since construction or reset().
+      double seconds() const
+      {
+         return std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - start).count();
+      }
+   private:
+      std::chrono::steady_clock::time_point start;
+   };
+
+      /** Get the resident set size of this process in kilobytes.
+       * @return the resident set size or 0 if it can't be determined
+       *   (e.g. on a system without /proc). */
+   inline long residentMemoryKB()
+   {
+      std::ifstream s("/proc/self/status");
+      std::string line;
+      while (std::getline(s, line))
+      {
+         if (line.compare(0, 6, "VmRSS:") == 0)
+         {
+            return std::stol(line.substr(6));
+         }
+      }
+      return 0;
+   }
+
+      /** Get the number of bytes of heap memory currently in use.
+       * Unlike residentMemoryKB(), this drops when memory is freed.
+       * @return the heap use in kilobytes or 0 if it can't be
+       *   determined (e.g. without glibc 2.33 or later). */
+   inline long heapInUseKB()
+   {
+#if defined(__GLIBC__) && ((__GLIBC__ > 2) || (__GLIBC_MINOR__ >= 33))
+      return mallinfo2().uordblks / 1024;
+#else
+      return 0;
+#endif
+   }
+
+      /** Print a single benchmark result line.
+       * @param[in] label A description of what was measured.
+       * @param[in] count The number of operations performed.
+       * @param[in] sec The elapsed time for count operations. */
+   inline void printRate(const std::string& label, unsigned long count,
+                         double sec)
+   {
+      std::cout << std::left << std::setw(40) << label << std::right
+                << std::setw(12) << count << " ops "
+                << std::fixed << std::setprecision(3)
+                << std::setw(10) << sec << " s "
+                << std::setw(12) << std::setprecision(1)
+                << (sec > 0 ? 1e9*sec/count : 0.0) << " ns/op "
+                << std::setw(14) << std::setprecision(0)
+                << (sec > 0 ? count/sec : 0.0) << " ops/s" << std::endl;
+   }
+}
+
+#endif // GNSSTK_BENCHMARKUTIL_HPP
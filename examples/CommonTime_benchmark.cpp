@@ -0,0 +1,155 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+
+/** @file CommonTime_benchmark.cpp Measure the CommonTime operations
+ * that dominate batch processing: inserting into and looking up a
+ * std::map keyed by CommonTime, sorting, differencing and adding
+ * seconds.
+ *
+ * Usage: CommonTime_benchmark [count] */
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <random>
+#include <vector>
+#include "CommonTime.hpp"
+#include "GPSWeekSecond.hpp"
+#include "BenchmarkUtil.hpp"
+
+using namespace std;
+using namespace gnsstk;
+
+int main(int argc, char* argv[])
+{
+   unsigned long count = (argc > 1 ? atol(argv[1]) : 200000);
+   try
+   {
+      cout << "sizeof(CommonTime) " << sizeof(CommonTime) << endl;
+         // epochs every 30 seconds plus a fraction, in random order
+      vector<CommonTime> times;
+      const CommonTime t0 = GPSWeekSecond(2200, 0.0);
+      times.reserve(count);
+      for (unsigned long i = 0; i < count; i++)
+      {
+         times.push_back(t0 + (i * 30.0 + 1.0e-4 * i));
+      }
+      vector<CommonTime> shuffled(times);
+      shuffle(shuffled.begin(), shuffled.end(), mt19937(1));
+      double sum = 0;
+      unsigned long found = 0;
+
+      BenchTimer timer;
+      map<CommonTime, unsigned long> timeMap;
+      for (unsigned long i = 0; i < count; i++)
+      {
+         timeMap[shuffled[i]] = i;
+      }
+      printRate("map insert", count, timer.seconds());
+
+      const unsigned passes = 5;
+      timer.reset();
+      for (unsigned p = 0; p < passes; p++)
+      {
+         for (const auto& t : shuffled)
+         {
+            found += timeMap.count(t);
+         }
+      }
+      printRate("map find", count * passes, timer.seconds());
+
+      timer.reset();
+      for (unsigned p = 0; p < passes; p++)
+      {
+         for (const auto& t : times)
+         {
+            auto ti = timeMap.lower_bound(t + 15.0);
+            found += (ti != timeMap.end());
+         }
+      }
+      printRate("map lower_bound", count * passes, timer.seconds());
+
+      vector<CommonTime> sorted(shuffled);
+      timer.reset();
+      sort(sorted.begin(), sorted.end());
+      printRate("sort (elements)", count, timer.seconds());
+      found += (sorted == times);
+
+      timer.reset();
+      for (unsigned p = 0; p < passes; p++)
+      {
+         for (unsigned long i = 1; i < count; i++)
+         {
+            sum += times[i] - times[i-1];
+         }
+      }
+      printRate("difference", (count-1) * passes, timer.seconds());
+
+      CommonTime t(times[0]);
+      timer.reset();
+      for (unsigned long i = 0; i < count * passes; i++)
+      {
+         t += 0.0123456789;
+      }
+      printRate("addSeconds", count * passes, timer.seconds());
+      sum += t - times[0];
+
+      unsigned long equal = 0;
+      timer.reset();
+      for (unsigned p = 0; p < passes; p++)
+      {
+         for (unsigned long i = 0; i < count; i++)
+         {
+            equal += (times[i] == sorted[i]);
+         }
+      }
+      printRate("operator==", count * passes, timer.seconds());
+
+         // keep the compiler from discarding the loops
+      cout << "checksum " << found << " " << equal << " "
+           << setprecision(17) << sum << endl;
+   }
+   catch (gnsstk::Exception& exc)
+   {
+      cerr << exc << endl;
+      return 1;
+   }
+   return 0;
+}
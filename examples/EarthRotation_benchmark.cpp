@@ -0,0 +1,124 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+
+/** @file EarthRotation_benchmark.cpp Compare the cost of computing
+ * the ECEF-to-inertial rotation with EarthOrientation, which sums the
+ * precession and nutation series at every epoch, and with
+ * EarthRotationService, which interpolates them.  The epochs are 30
+ * seconds apart, as when rotating a day of orbit or observation data.
+ *
+ * Usage: EarthRotation_benchmark [epochs] */
+
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include "EarthRotationService.hpp"
+#include "BenchmarkUtil.hpp"
+
+using namespace std;
+using namespace gnsstk;
+
+int main(int argc, char* argv[])
+{
+   unsigned long count = (argc > 1 ? atol(argv[1]) : 2880);
+   try
+   {
+      IERSConvention conventions[] = { IERSConvention::IERS1996,
+                                       IERSConvention::IERS2003,
+                                       IERSConvention::IERS2010 };
+      for (IERSConvention conv : conventions)
+      {
+         EarthOrientation eo;
+         eo.convention = conv;
+         eo.xp = 0.0349282;
+         eo.yp = 0.4833163;
+         eo.UT1mUTC = -0.072073685;
+         EarthRotationService ers(conv);
+         double sum = 0.0, maxDiff = 0.0;
+         EphTime t0(58849, 0.0, TimeSystem::UTC);
+
+         EphTime t(t0);
+         BenchTimer timer;
+         for (unsigned long i = 0; i < count; i++, t += 30.0)
+         {
+            Matrix<double> rot(eo.ECEFtoInertial(t));
+            sum += rot(0,1);
+         }
+         double directSec = timer.seconds();
+
+         t = t0;
+         timer.reset();
+         for (unsigned long i = 0; i < count; i++, t += 30.0)
+         {
+            SMatrix<double,3,3> rot(ers.ECEFtoInertial(eo, t));
+            sum -= rot(0,1);
+         }
+         double serviceSec = timer.seconds();
+
+         t = t0;
+         for (unsigned long i = 0; i < count; i += 97, t += 97 * 30.0)
+         {
+            Matrix<double> expected(eo.ECEFtoInertial(t));
+            SMatrix<double,3,3> rot(ers.ECEFtoInertial(eo, t));
+            for (size_t r = 0; r < 3; r++)
+            {
+               for (size_t c = 0; c < 3; c++)
+               {
+                  maxDiff = std::max(maxDiff, ::fabs(expected(r,c)-rot(r,c)));
+               }
+            }
+         }
+
+         cout << conv << endl;
+         printRate("   EarthOrientation", count, directSec);
+         printRate("   EarthRotationService", count, serviceSec);
+         cout << setprecision(1) << "   speedup " << (directSec / serviceSec)
+              << ", " << ers.size() << " nodes, max element difference "
+              << scientific << setprecision(2) << maxDiff << ", checksum "
+              << sum << endl;
+      }
+   }
+   catch (gnsstk::Exception& exc)
+   {
+      cerr << exc << endl;
+      return 1;
+   }
+   return 0;
+}
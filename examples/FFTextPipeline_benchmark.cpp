@@ -0,0 +1,182 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/** @file FFTextPipeline_benchmark.cpp Compare reading a compressed
+ * (gzip and/or Compact RINEX) RINEX 3 observation file by first
+ * decompressing it to a temporary file and then reading that, as
+ * was necessary before FFTextPipeline, with reading the compressed
+ * file directly, where decoding runs on background threads while
+ * Rinex3ObsData parses the records.
+ *
+ * Usage: FFTextPipeline_benchmark file [passes]
+ * The temporary file is written alongside file. */
+
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include "Rinex3ObsStream.hpp"
+#include "Rinex3ObsData.hpp"
+#include "BenchmarkUtil.hpp"
+
+using namespace std;
+using namespace gnsstk;
+
+   /// Totals used to make sure both methods got the same results.
+struct ReadTotals
+{
+   ReadTotals() : records(0), datums(0), sum(0) {}
+   bool operator==(const ReadTotals& right) const
+   {
+      return ((records == right.records) && (datums == right.datums) &&
+              (sum == right.sum));
+   }
+   unsigned long records;
+   unsigned long datums;
+   double sum;
+};
+
+
+   /// Read all the observation records in fn.
+static ReadTotals readObs(const string& fn)
+{
+   ReadTotals rv;
+   Rinex3ObsStream strm(fn);
+   Rinex3ObsData rod;
+   while (strm >> rod)
+   {
+      rv.records++;
+      for (const auto& sati : rod.obs)
+      {
+         for (const auto& datum : sati.second)
+         {
+            rv.datums++;
+            rv.sum += datum.data + datum.lli + datum.ssi;
+         }
+      }
+   }
+   return rv;
+}
+
+
+   /** Decode fn to tmpFile.
+    * @return The number of characters written. */
+static unsigned long decodeToFile(const string& fn, const string& tmpFile)
+{
+   FFTextStream strm(fn.c_str(), ios::in);
+   ofstream out(tmpFile.c_str(), ios::out | ios::binary);
+   const char *line;
+   std::string::size_type len;
+   unsigned long chars = 0;
+   try
+   {
+      while (true)
+      {
+         strm.formattedGetLine(line, len, true);
+         out.write(line, len);
+         out.put('\n');
+         chars += len + 1;
+      }
+   }
+   catch (EndOfFile&)
+   {
+   }
+   return chars;
+}
+
+
+int main(int argc, char* argv[])
+{
+   if (argc < 2)
+   {
+      cerr << "usage: " << argv[0] << " file [passes]" << endl;
+      return 1;
+   }
+   try
+   {
+      string fn(argv[1]);
+      string tmpFile(fn + ".FFTextPipeline_benchmark.tmp");
+      unsigned passes = (argc > 2 ? atoi(argv[2]) : 3);
+      {
+         FFTextStream strm(fn.c_str(), ios::in);
+         if (!strm.isDecoded())
+         {
+            cerr << fn << " is not compressed" << endl;
+            return 1;
+         }
+      }
+      ReadTotals twoStep, streamed;
+      unsigned long chars = 0;
+      BenchTimer timer;
+      for (unsigned i = 0; i < passes; i++)
+         chars = decodeToFile(fn, tmpFile);
+      double decodeSec = timer.seconds();
+      timer.reset();
+      for (unsigned i = 0; i < passes; i++)
+      {
+         decodeToFile(fn, tmpFile);
+         twoStep = readObs(tmpFile);
+      }
+      double twoStepSec = timer.seconds();
+      std::remove(tmpFile.c_str());
+      timer.reset();
+      for (unsigned i = 0; i < passes; i++)
+         streamed = readObs(fn);
+      double streamedSec = timer.seconds();
+         // throughput in terms of the decompressed RINEX
+      double mb = chars / 1048576.0;
+      cout << "decompressed size " << mb << " MB" << endl;
+      cout << "decompress to file " << (mb * passes / decodeSec) << " MB/s"
+           << endl;
+      printRate("decompress then read (records)", twoStep.records * passes,
+                twoStepSec);
+      cout << "   " << (mb * passes / twoStepSec) << " MB/s" << endl;
+      printRate("streamed (records)", streamed.records * passes,
+                streamedSec);
+      cout << "   " << (mb * passes / streamedSec) << " MB/s" << endl;
+      cout << "speedup " << setprecision(2) << (twoStepSec / streamedSec)
+           << ", results "
+           << ((twoStep == streamed) ? "match" : "DIFFER") << endl;
+   }
+   catch (gnsstk::Exception& exc)
+   {
+      cerr << exc << endl;
+      return 1;
+   }
+   return 0;
+}
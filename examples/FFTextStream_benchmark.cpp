@@ -0,0 +1,174 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/** @file FFTextStream_benchmark.cpp Compare the FFTextStream read
+ * backends (std::filebuf, block reads and memory mapping) reading a
+ * text file line by line, and reading RINEX 3 observation records
+ * if the file is a RINEX 3 observation file.
+ *
+ * Usage: FFTextStream_benchmark file [passes] */
+
+#include <iostream>
+#include <sys/stat.h>
+#include "Rinex3ObsStream.hpp"
+#include "Rinex3ObsData.hpp"
+#include "BenchmarkUtil.hpp"
+
+using namespace std;
+using namespace gnsstk;
+
+   /// Names of the backends, for output.
+static const char* backendName(FFTextStream::ReadBackend rb)
+{
+   switch (rb)
+   {
+      case FFTextStream::ReadBackend::Stream: return "Stream";
+      case FFTextStream::ReadBackend::Block:  return "Block";
+      case FFTextStream::ReadBackend::Mapped: return "Mapped";
+   }
+   return "?";
+}
+
+
+int main(int argc, char* argv[])
+{
+   if (argc < 2)
+   {
+      cerr << "usage: " << argv[0] << " file [passes]" << endl;
+      return 1;
+   }
+   try
+   {
+      string fn(argv[1]);
+      unsigned passes = (argc > 2 ? atoi(argv[2]) : 3);
+      struct stat st;
+      if (stat(fn.c_str(), &st) != 0)
+      {
+         cerr << "Unable to stat " << fn << endl;
+         return 1;
+      }
+      double mb = st.st_size / 1048576.0;
+      FFTextStream::ReadBackend backends[] =
+         {
+            FFTextStream::ReadBackend::Stream,
+            FFTextStream::ReadBackend::Block,
+            FFTextStream::ReadBackend::Mapped
+         };
+      bool isObs = true;
+      for (FFTextStream::ReadBackend rb : backends)
+      {
+         string label(backendName(rb));
+         unsigned long lines = 0;
+         BenchTimer timer;
+         for (unsigned i = 0; i < passes; i++)
+         {
+            FFTextStream strm(fn.c_str(), ios::in);
+            strm.setReadBackend(rb);
+            string line;
+            try
+            {
+               while (true)
+               {
+                  strm.formattedGetLine(line, true);
+                  lines++;
+               }
+            }
+            catch (EndOfFile&)
+            {
+            }
+         }
+         double sec = timer.seconds();
+         printRate(label + " lines (string)", lines, sec);
+         cout << "   " << (mb * passes / sec) << " MB/s" << endl;
+
+         lines = 0;
+         timer.reset();
+         for (unsigned i = 0; i < passes; i++)
+         {
+            FFTextStream strm(fn.c_str(), ios::in);
+            strm.setReadBackend(rb);
+            const char *line;
+            std::string::size_type len;
+            try
+            {
+               while (true)
+               {
+                  strm.formattedGetLine(line, len, true);
+                  lines++;
+               }
+            }
+            catch (EndOfFile&)
+            {
+            }
+         }
+         sec = timer.seconds();
+         printRate(label + " lines (view)", lines, sec);
+         cout << "   " << (mb * passes / sec) << " MB/s" << endl;
+
+         if (!isObs)
+            continue;
+         unsigned long records = 0;
+         timer.reset();
+         for (unsigned i = 0; i < passes && isObs; i++)
+         {
+            Rinex3ObsStream strm(fn.c_str());
+            strm.setReadBackend(rb);
+            Rinex3ObsData rod;
+            if (!(strm >> strm.header))
+            {
+               isObs = false;
+               break;
+            }
+            while (strm >> rod)
+               records++;
+         }
+         if (isObs)
+         {
+            sec = timer.seconds();
+            printRate(label + " Rinex3ObsData", records, sec);
+            cout << "   " << (mb * passes / sec) << " MB/s" << endl;
+         }
+      }
+   }
+   catch (gnsstk::Exception& exc)
+   {
+      cerr << exc << endl;
+      return 1;
+   }
+   return 0;
+}
@@ -0,0 +1,146 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+
+
+/** @file GlobalTropModel_benchmark.cpp Compare the cost of computing
+ * GlobalTropModel delays for a network of receivers one observation
+ * at a time, with and without the site cache, and with the batch
+ * corrections() method.  Each receiver sees a number of satellites
+ * every 30 seconds, and the observations are ordered by epoch and
+ * then receiver, as when processing a network epoch by epoch.  The
+ * model sets its time by day of year, so the query times are whole
+ * days.
+ *
+ * Usage: GlobalTropModel_benchmark [sites] [epochs] [satellites] */
+
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+#include "GlobalTropModel.hpp"
+#include "BenchmarkUtil.hpp"
+
+using namespace std;
+using namespace gnsstk;
+
+   // Compute the delay of each query setting the receiver of model.
+   // If clear is true, the site cache is emptied before each query, so
+   // the spherical harmonics are evaluated every time the site changes.
+static double single(GlobalTropModel& model,
+                     const vector<GlobalTropModel::Query>& queries,
+                     vector<double>& delays, bool clear)
+{
+   BenchTimer timer;
+   for (size_t i = 0; i < queries.size(); i++)
+   {
+      const GlobalTropModel::Query& q(queries[i]);
+      if (clear)
+      {
+         model.clearSiteCache();
+      }
+      model.setReceiverLatitude(q.latitude);
+      model.setReceiverLongitude(q.longitude);
+      model.setReceiverHeight(q.height);
+      model.setDayOfYear(int(q.mjd - 44266.0));
+      delays[i] = model.correction(q.elevation);
+   }
+   return timer.seconds();
+}
+
+int main(int argc, char* argv[])
+{
+   unsigned long sites = (argc > 1 ? atol(argv[1]) : 50);
+   unsigned long epochs = (argc > 2 ? atol(argv[2]) : 120);
+   unsigned long sats = (argc > 3 ? atol(argv[3]) : 10);
+   try
+   {
+      vector<GlobalTropModel::Query> queries;
+      for (unsigned long e = 0; e < epochs; e++)
+      {
+         for (unsigned long s = 0; s < sites; s++)
+         {
+            for (unsigned long k = 0; k < sats; k++)
+            {
+               GlobalTropModel::Query q;
+               q.latitude = -60.0 + 120.0 * s / sites;
+               q.longitude = -180.0 + 337.0 * s / sites;
+               q.height = 10.0 + 17.0 * s;
+               q.mjd = 58849.0 + ::floor(e * 30.0 / 86400.0);
+               q.elevation = 5.0 + ::fmod(7.3 * k + 0.01 * e, 85.0);
+               queries.push_back(q);
+            }
+         }
+      }
+      unsigned long count = queries.size();
+      vector<double> scalarCached(count), scalarCleared(count), batch;
+
+      GlobalTropModel model;
+      double clearedSec = single(model, queries, scalarCleared, true);
+      double cachedSec = single(model, queries, scalarCached, false);
+      BenchTimer timer;
+      model.corrections(queries, batch);
+      double batchSec = timer.seconds();
+
+      double maxDiff = 0.0, sum = 0.0;
+      for (unsigned long i = 0; i < count; i++)
+      {
+         maxDiff = std::max(maxDiff, ::fabs(batch[i] - scalarCached[i]));
+         maxDiff = std::max(maxDiff, ::fabs(batch[i] - scalarCleared[i]));
+         sum += batch[i];
+      }
+
+      cout << sites << " sites, " << epochs << " epochs, " << sats
+           << " satellites" << endl;
+      printRate("correction(), no site cache", count, clearedSec);
+      printRate("correction(), site cache", count, cachedSec);
+      printRate("corrections()", count, batchSec);
+      cout << fixed << setprecision(1) << "speedup " << (clearedSec / batchSec)
+           << " over no cache, " << (cachedSec / batchSec)
+           << " over site cache, max difference " << scientific
+           << setprecision(2) << maxDiff << ", checksum "
+           << setprecision(10) << sum << endl;
+   }
+   catch (gnsstk::Exception& exc)
+   {
+      cerr << exc << endl;
+      return 1;
+   }
+   return 0;
+}
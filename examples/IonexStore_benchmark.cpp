@@ -0,0 +1,273 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+
+/** @file IonexStore_benchmark.cpp Compare the cost of interpolating
+ * IONEX TEC and RMS values at many ionospheric pierce points, as for
+ * the slant TEC of a network of receivers at 1 Hz, with
+ *   - the IonexStore::getIonexValue() of earlier releases, reproduced
+ *     here, which copies the maps of each epoch for every query,
+ *   - getIonexValue() on the maps as loaded,
+ *   - getIonexValue() on the contiguous grid, and
+ *   - getIonexValues() on the grid for all the points of an epoch.
+ * The store holds a day of hourly 2.5 x 5 degree TEC and RMS maps,
+ * like an IGS final product.
+ *
+ * Usage: IonexStore_benchmark [epochs] [points] */
+
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <vector>
+#include "IonexStore.hpp"
+#include "CivilTime.hpp"
+#include "BenchmarkUtil.hpp"
+
+using namespace std;
+using namespace gnsstk;
+
+typedef map<IonexData::IonexValType, IonexData> IonexValTypeMap;
+typedef map<CommonTime, IonexValTypeMap> IonexMap;
+
+   // Make a global map at time t.
+static IonexData makeMap(const CommonTime& t,
+                         const IonexData::IonexValType& type, double scale)
+{
+   IonexData iod;
+   iod.time = t;
+   iod.type = type;
+   iod.exponent = -1;
+   iod.lat[0] = 87.5;
+   iod.lat[1] = -87.5;
+   iod.lat[2] = -2.5;
+   iod.lon[0] = -180.0;
+   iod.lon[1] = 180.0;
+   iod.lon[2] = 5.0;
+   iod.hgt[0] = 450.0;
+   iod.hgt[1] = 450.0;
+   iod.hgt[2] = 0.0;
+   iod.dim[0] = 71;
+   iod.dim[1] = 73;
+   iod.dim[2] = 1;
+   iod.data.resize(iod.dim[0] * iod.dim[1]);
+   for (int i = 0; i < iod.dim[0]; i++)
+   {
+      for (int j = 0; j < iod.dim[1]; j++)
+      {
+         iod.data[j + i*iod.dim[1]] = scale *
+            (20.0 + 15.0 * ::cos(0.05 * i) * ::sin(0.09 * j + scale));
+      }
+   }
+   iod.valid = true;
+   return iod;
+}
+
+   // IonexStore::getIonexValue() before the grid was added, with the
+   // ConsRot strategy.
+static Triple legacyValue(const IonexMap& inxMaps, const CommonTime& t,
+                          const Position& RX)
+{
+   Triple tecval(0.0,0.0,0.0);
+   int nmap = 2;
+
+   Position pos(RX);
+   if ( pos.getSystemName() != "Geocentric" )
+   {
+      InvalidRequest e("Position object is not in GEOCENTRIC coordinates");
+      GNSSTK_THROW(e);
+   }
+
+   CommonTime T[2];
+   IonexMap::const_iterator itm = inxMaps.find(t);
+   if( itm != inxMaps.end() )
+   {
+      itm = inxMaps.lower_bound(t);
+      T[0] = itm->first;
+      T[1] = (++itm)->first;
+   }
+   else
+   {
+      itm = inxMaps.lower_bound(t);
+      T[1] = itm->first;
+      T[0] = (--itm)->first;
+   }
+
+   double f[2];
+   f[0] = (T[1]-t   ) / (T[1]-T[0]);
+   f[1] = (t   -T[0]) / (T[1]-T[0]);
+
+   for(int imap = 0; imap < nmap; imap++)
+   {
+      Position pos;
+      double sec2deg( 4.16666666666667e-3 );
+      pos = RX;
+      pos.theArray[1] = pos.theArray[1] + ( t - T[imap] ) * sec2deg;
+
+      itm = inxMaps.find(T[imap]);
+      IonexValTypeMap ivtm = (*itm).second;
+      IonexData iod;
+      if ( ivtm.find(IonexData::TEC) != ivtm.end() )
+      {
+         iod = ivtm[IonexData::TEC];
+         tecval[0] = tecval[0] + f[imap]*iod.getValue(pos);
+      }
+      if ( ivtm.find(IonexData::RMS) != ivtm.end() )
+      {
+         iod = ivtm[IonexData::RMS];
+         tecval[1] = tecval[1] + f[imap]*iod.getValue(pos);
+      }
+   }
+
+   tecval[2] = RX.theArray[2];
+   return tecval;
+}
+
+   // Print the rate and the largest difference from the legacy values.
+static void report(const string& label, unsigned long count, double sec,
+                   const vector<Triple>& values, const vector<Triple>& legacy)
+{
+   double maxDiff = 0.0;
+   for (size_t i = 0; i < values.size(); i++)
+   {
+      for (int j = 0; j < 3; j++)
+      {
+         maxDiff = std::max(maxDiff, ::fabs(values[i][j] - legacy[i][j]));
+      }
+   }
+   printRate(label, count, sec);
+   cout << "   max difference from legacy " << scientific
+        << setprecision(2) << maxDiff << endl;
+}
+
+int main(int argc, char* argv[])
+{
+   unsigned long numEpochs = (argc > 1 ? atol(argv[1]) : 60);
+   unsigned long numPoints = (argc > 2 ? atol(argv[2]) : 500);
+   try
+   {
+      CommonTime t0(CivilTime(2020,3,14,0,0,0.0,TimeSystem::UTC));
+      IonexMap legacyMaps;
+      IonexStore maps, grid;
+      for (int k = 0; k <= 24; k++)
+      {
+         CommonTime t(t0 + 3600.0 * k);
+         IonexData tec(makeMap(t, IonexData::TEC, 1.0 + 0.01 * k));
+         IonexData rms(makeMap(t, IonexData::RMS, 0.2 + 0.001 * k));
+         legacyMaps[t][IonexData::TEC] = tec;
+         legacyMaps[t][IonexData::RMS] = rms;
+         maps.addMap(tec);
+         maps.addMap(rms);
+         grid.addMap(tec);
+         grid.addMap(rms);
+      }
+      if (!grid.buildGrid())
+      {
+         cerr << "The maps don't fit a grid" << endl;
+         return 1;
+      }
+
+         // pierce points at 450 km, away from the poles
+      vector<Position> points;
+      for (unsigned long i = 0; i < numPoints; i++)
+      {
+         double lat = 80.0 * ::sin(0.7 * i + 0.3);
+         double lon = ::fmod(37.3 * i + 2.3, 360.0);
+         points.push_back(Position(lat, lon, 6371000.0 + 450000.0,
+                                   Position::Geocentric));
+      }
+         // 1 Hz epochs from mid-morning
+      vector<CommonTime> epochs;
+      for (unsigned long e = 0; e < numEpochs; e++)
+      {
+         epochs.push_back(t0 + 36000.5 + e);
+      }
+      unsigned long count = numEpochs * numPoints;
+      vector<Triple> legacy, values, batch;
+
+      BenchTimer timer;
+      for (const CommonTime& t : epochs)
+      {
+         for (const Position& pos : points)
+         {
+            legacy.push_back(legacyValue(legacyMaps, t, pos));
+         }
+      }
+      printRate("legacy getIonexValue()", count, timer.seconds());
+
+      timer.reset();
+      for (const CommonTime& t : epochs)
+      {
+         for (const Position& pos : points)
+         {
+            values.push_back(maps.getIonexValue(t, pos));
+         }
+      }
+      report("getIonexValue(), maps", count, timer.seconds(), values,
+             legacy);
+
+      values.clear();
+      timer.reset();
+      for (const CommonTime& t : epochs)
+      {
+         for (const Position& pos : points)
+         {
+            values.push_back(grid.getIonexValue(t, pos));
+         }
+      }
+      report("getIonexValue(), grid", count, timer.seconds(), values,
+             legacy);
+
+      values.clear();
+      timer.reset();
+      for (const CommonTime& t : epochs)
+      {
+         grid.getIonexValues(t, points, batch);
+         values.insert(values.end(), batch.begin(), batch.end());
+      }
+      report("getIonexValues(), grid", count, timer.seconds(), values,
+             legacy);
+   }
+   catch (gnsstk::Exception& exc)
+   {
+      cerr << exc << endl;
+      return 1;
+   }
+   return 0;
+}
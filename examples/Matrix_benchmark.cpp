@@ -0,0 +1,175 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/** @file Matrix_benchmark.cpp Compare the rate of Matrix and Vector
+ * products done by the element-wise operators, which are used for
+ * slices and other ConstMatrixBase types, against the MatrixKernels
+ * used for Matrix<double>, over the sizes used in the library: 4x4
+ * for single point positioning up to about 200x200 for large
+ * filters and fits.
+ *
+ * Usage: Matrix_benchmark [scale] */
+
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include "Matrix.hpp"
+#include "BenchmarkUtil.hpp"
+
+using namespace std;
+using namespace gnsstk;
+
+   /// Return an n by n matrix with distinct elements.
+static Matrix<double> fill(size_t r, size_t c, double seed)
+{
+   Matrix<double> rv(r, c);
+   for (size_t i = 0; i < r; i++)
+      for (size_t j = 0; j < c; j++)
+         rv(i,j) = ::sin(seed + 1.1*i + 0.37*j);
+   return rv;
+}
+
+
+   /** Print the time per operation of the element-wise and kernel
+    * versions of an operation and the speedup. */
+static void report(const string& label, size_t n, unsigned long count,
+                   double slowSec, double fastSec, double check)
+{
+   cout << setw(22) << left << label << right << setw(4) << n
+        << fixed << setprecision(3)
+        << setw(12) << (1.e6 * slowSec / count) << " us"
+        << setw(12) << (1.e6 * fastSec / count) << " us"
+        << setprecision(2) << setw(8) << (slowSec / fastSec) << "x"
+        << (check == 0.0 ? "" : "  RESULTS DIFFER") << endl;
+}
+
+
+int main(int argc, char* argv[])
+{
+   double scale = (argc > 1 ? atof(argv[1]) : 1.0);
+   const size_t sizes[] = { 4, 6, 8, 12, 16, 32, 64, 128, 200 };
+   cout << setw(22) << left << "operation" << right << setw(4) << "n"
+        << setw(15) << "element-wise" << setw(15) << "kernel"
+        << setw(9) << "speedup" << endl;
+   try
+   {
+      for (size_t n : sizes)
+      {
+            // about 2e8 multiply-adds per test at scale 1
+         unsigned long count = 1 + (unsigned long)(scale * 2.e8 / (n*n*n));
+         unsigned long vcount = 1 + (unsigned long)(scale * 2.e8 / (n*n));
+            // tall partials matrix and square weight, as in a least
+            // squares solution with n/2 unknowns
+         size_t u = (n < 8 ? n : n/2);
+         Matrix<double> a(fill(n, n, 0.1)), b(fill(n, n, 0.4)),
+            p(fill(n, u, 0.7)), w(fill(n, n, 0.9)), slow, fast;
+         Vector<double> x(n, 0.5), vslow, vfast;
+         ConstMatrixSlice<double> as(a), bs(b), ps(p), ws(w);
+         ConstVectorSlice<double> xs(x);
+
+         BenchTimer timer;
+         for (unsigned long i = 0; i < count; i++)
+            slow = as * bs;
+         double slowSec = timer.seconds();
+         timer.reset();
+         for (unsigned long i = 0; i < count; i++)
+            fast = a * b;
+         report("Matrix * Matrix", n, count, slowSec, timer.seconds(),
+                maxabs(slow - fast));
+
+         timer.reset();
+         for (unsigned long i = 0; i < vcount; i++)
+            vslow = as * xs;
+         slowSec = timer.seconds();
+         timer.reset();
+         for (unsigned long i = 0; i < vcount; i++)
+            vfast = a * x;
+         report("Matrix * Vector", n, vcount, slowSec, timer.seconds(),
+                maxabs(Vector<double>(vslow - vfast)));
+
+         timer.reset();
+         for (unsigned long i = 0; i < vcount; i++)
+            vslow = xs * as;
+         slowSec = timer.seconds();
+         timer.reset();
+         for (unsigned long i = 0; i < vcount; i++)
+            vfast = x * a;
+         report("Vector * Matrix", n, vcount, slowSec, timer.seconds(),
+                maxabs(Vector<double>(vslow - vfast)));
+
+         timer.reset();
+         for (unsigned long i = 0; i < vcount; i++)
+            slow = transpose(as);
+         slowSec = timer.seconds();
+         timer.reset();
+         for (unsigned long i = 0; i < vcount; i++)
+            fast = transpose(a);
+         report("transpose", n, vcount, slowSec, timer.seconds(),
+                maxabs(slow - fast));
+
+         count = 1 + (unsigned long)(scale * 2.e8 / (n*n*u + n*u*u));
+         timer.reset();
+         for (unsigned long i = 0; i < count; i++)
+            slow = transpose(ps) * ws * ps;
+         slowSec = timer.seconds();
+         timer.reset();
+         for (unsigned long i = 0; i < count; i++)
+            fast = transposeWeighted(p, w);
+         report("transpose(P)*W*P", n, count, slowSec, timer.seconds(),
+                maxabs(slow - fast));
+
+         timer.reset();
+         for (unsigned long i = 0; i < vcount; i++)
+            vslow = transpose(ps) * xs;
+         slowSec = timer.seconds();
+         timer.reset();
+         for (unsigned long i = 0; i < vcount; i++)
+            vfast = transposeTimes(p, x);
+         report("transpose(P)*b", n, vcount, slowSec, timer.seconds(),
+                maxabs(Vector<double>(vslow - vfast)));
+      }
+   }
+   catch (gnsstk::Exception& exc)
+   {
+      cerr << exc << endl;
+      return 1;
+   }
+   return 0;
+}
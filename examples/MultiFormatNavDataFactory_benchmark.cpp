@@ -0,0 +1,103 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/** @file MultiFormatNavDataFactory_benchmark.cpp Compare the time
+ * taken to load a set of navigation data files one at a time using
+ * MultiFormatNavDataFactory::addDataSource() against loading them
+ * concurrently using MultiFormatNavDataFactory::addDataSources().
+ *
+ * Usage: MultiFormatNavDataFactory_benchmark threads file [file ...]
+ * where threads is the number of threads to use (0 for the number
+ * of hardware threads) and each file is any format supported by
+ * MultiFormatNavDataFactory. */
+
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <vector>
+#include "MultiFormatNavDataFactory.hpp"
+#include "BenchmarkUtil.hpp"
+
+using namespace std;
+using namespace gnsstk;
+
+int main(int argc, char* argv[])
+{
+   if (argc < 3)
+   {
+      cerr << "usage: " << argv[0] << " threads navFile [...]" << endl;
+      return 1;
+   }
+   try
+   {
+      unsigned threads = atoi(argv[1]);
+      vector<string> files(argv+2, argv+argc);
+      MultiFormatNavDataFactory fact;
+      BenchTimer timer;
+      bool serialOK = true;
+      for (const auto& fn : files)
+      {
+         if (!fact.addDataSource(fn))
+         {
+            cerr << "Unable to load " << fn << endl;
+            serialOK = false;
+         }
+      }
+      printRate("addDataSource", files.size(), timer.seconds());
+      size_t serialSize = fact.size();
+      ostringstream serialDump;
+      fact.dump(serialDump, DumpDetail::Full);
+
+      fact.clear();
+      timer.reset();
+      bool parallelOK = fact.addDataSources(files, threads);
+      printRate("addDataSources", files.size(), timer.seconds());
+      ostringstream parallelDump;
+      fact.dump(parallelDump, DumpDetail::Full);
+      cout << serialSize << " messages loaded, results "
+           << (((serialOK == parallelOK) && (serialSize == fact.size()) &&
+                (serialDump.str() == parallelDump.str()))
+               ? "match" : "DIFFER") << endl;
+   }
+   catch (gnsstk::Exception& exc)
+   {
+      cerr << exc << endl;
+      return 1;
+   }
+   return 0;
+}
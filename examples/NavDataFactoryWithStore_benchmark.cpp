@@ -0,0 +1,164 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+
+/** @file NavDataFactoryWithStore_benchmark.cpp Compare find()
+ * latency and resident memory of the map-based NavDataFactoryWithStore
+ * index against the compact index created by freeze().
+ *
+ * Usage: NavDataFactoryWithStore_benchmark file [file ...]
+ * where each file is a RINEX navigation file, e.g. a week of daily
+ * RINEX 3 broadcast ephemeris files. */
+
+#include <iostream>
+#include <vector>
+#include "RinexNavDataFactory.hpp"
+#include "BenchmarkUtil.hpp"
+
+using namespace std;
+using namespace gnsstk;
+
+/// Run find() for each key at each time, returning the elapsed time.
+double runQueries(NavDataFactoryWithStore& fact,
+                  const vector<NavMessageID>& keys,
+                  const vector<CommonTime>& times,
+                  NavSearchOrder order,
+                  vector<NavDataPtr>& results)
+{
+   results.clear();
+   results.reserve(keys.size() * times.size());
+   BenchTimer timer;
+   for (const auto& when : times)
+   {
+      for (const auto& key : keys)
+      {
+         NavDataPtr ndp;
+         fact.find(key, when, ndp, SVHealth::Any, NavValidityType::ValidOnly,
+                   order);
+         results.push_back(ndp);
+      }
+   }
+   return timer.seconds();
+}
+
+
+int main(int argc, char* argv[])
+{
+   if (argc < 2)
+   {
+      cerr << "usage: " << argv[0] << " rinexNavFile [rinexNavFile ...]"
+           << endl;
+      return 1;
+   }
+   try
+   {
+      RinexNavDataFactory fact;
+      long rss0 = residentMemoryKB();
+      BenchTimer loadTimer;
+      for (int i = 1; i < argc; i++)
+      {
+         if (!fact.addDataSource(argv[i]))
+         {
+            cerr << "Unable to load " << argv[i] << endl;
+            return 1;
+         }
+      }
+      double loadSec = loadTimer.seconds();
+      long rss1 = residentMemoryKB();
+      CommonTime t0 = fact.getInitialTime(), t1 = fact.getFinalTime();
+      NavSatelliteIDSet sats = fact.getAvailableSats(
+         NavMessageType::Ephemeris, t0, t1);
+         // one exact key and one wildcard key per satellite
+      vector<NavMessageID> exactKeys, wildKeys;
+      for (const auto& sat : sats)
+      {
+         exactKeys.push_back(NavMessageID(sat, NavMessageType::Ephemeris));
+         NavMessageID wild(NavSatelliteID(sat.sat), NavMessageType::Ephemeris);
+         wildKeys.push_back(wild);
+      }
+      vector<CommonTime> times;
+      for (CommonTime t = t0; t < t1; t += 300)
+      {
+         times.push_back(t);
+      }
+      cout << "Loaded " << fact.size() << " messages for " << sats.size()
+           << " signals in " << loadSec << " s" << endl
+           << "Resident memory: before load " << rss0 << " kB, after load "
+           << rss1 << " kB" << endl;
+
+      vector<NavDataPtr> mapUser, mapNear, mapWild, flatUser, flatNear,
+         flatWild;
+      unsigned long n = exactKeys.size() * times.size();
+      printRate("map  find User (exact)", n,
+                runQueries(fact, exactKeys, times, NavSearchOrder::User,
+                           mapUser));
+      printRate("map  find User (wildcard)", n,
+                runQueries(fact, wildKeys, times, NavSearchOrder::User,
+                           mapWild));
+      printRate("map  find Nearest (exact)", n,
+                runQueries(fact, exactKeys, times, NavSearchOrder::Nearest,
+                           mapNear));
+
+      BenchTimer freezeTimer;
+      fact.freeze();
+      double freezeSec = freezeTimer.seconds();
+      long rss2 = residentMemoryKB();
+      cout << "freeze() took " << freezeSec << " s, resident memory now "
+           << rss2 << " kB (+" << (rss2-rss1) << " kB)" << endl;
+
+      printRate("flat find User (exact)", n,
+                runQueries(fact, exactKeys, times, NavSearchOrder::User,
+                           flatUser));
+      printRate("flat find User (wildcard)", n,
+                runQueries(fact, wildKeys, times, NavSearchOrder::User,
+                           flatWild));
+      printRate("flat find Nearest (exact)", n,
+                runQueries(fact, exactKeys, times, NavSearchOrder::Nearest,
+                           flatNear));
+
+      bool same = ((mapUser == flatUser) && (mapNear == flatNear) &&
+                   (mapWild == flatWild));
+      cout << "Results " << (same ? "match" : "DO NOT match") << endl;
+      return same ? 0 : 2;
+   }
+   catch (Exception& exc)
+   {
+      cerr << exc << endl;
+      return 1;
+   }
+}
@@ -0,0 +1,159 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+
+/** @file NavLibrary_benchmark.cpp Compare the throughput of the
+ * single satellite/time NavLibrary::getXvt() against the batch
+ * getXvt() that takes vectors of satellites and times, and against
+ * NavLibrary::Cursor stepping through time epoch by epoch.
+ *
+ * Usage: NavLibrary_benchmark interval file [file ...]
+ * where interval is the time step in seconds between evaluated
+ * epochs and each file is a RINEX navigation file. */
+
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+#include "NavLibrary.hpp"
+#include "RinexNavDataFactory.hpp"
+#include "BenchmarkUtil.hpp"
+
+using namespace std;
+using namespace gnsstk;
+
+int main(int argc, char* argv[])
+{
+   if (argc < 3)
+   {
+      cerr << "usage: " << argv[0] << " interval rinexNavFile [...]" << endl;
+      return 1;
+   }
+   try
+   {
+      double interval = atof(argv[1]);
+      if (interval <= 0)
+      {
+         cerr << "Invalid interval " << argv[1] << endl;
+         return 1;
+      }
+      NavLibrary navLib;
+      NavDataFactoryPtr ndfp(make_shared<RinexNavDataFactory>());
+      RinexNavDataFactory *fact =
+         dynamic_cast<RinexNavDataFactory*>(ndfp.get());
+      navLib.addFactory(ndfp);
+      for (int i = 2; i < argc; i++)
+      {
+         if (!fact->addDataSource(argv[i]))
+         {
+            cerr << "Unable to load " << argv[i] << endl;
+            return 1;
+         }
+      }
+      CommonTime t0 = fact->getInitialTime(), t1 = fact->getFinalTime();
+      NavSatelliteIDSet satSet = fact->getAvailableSats(
+         NavMessageType::Ephemeris, t0, t1);
+      vector<NavSatelliteID> sats(satSet.begin(), satSet.end());
+      vector<CommonTime> times;
+      for (CommonTime t = t0; t < t1; t += interval)
+      {
+         times.push_back(t);
+      }
+      unsigned long n = sats.size() * times.size();
+      cout << "Evaluating " << sats.size() << " satellites at "
+           << times.size() << " epochs" << endl;
+
+      vector<Xvt> scalarXvt(n);
+      vector<bool> scalarOK(n);
+      BenchTimer timer;
+      for (size_t si = 0; si < sats.size(); si++)
+      {
+         for (size_t ti = 0; ti < times.size(); ti++)
+         {
+            size_t idx = si * times.size() + ti;
+            scalarOK[idx] = navLib.getXvt(sats[si], times[ti],
+                                          scalarXvt[idx], false);
+         }
+      }
+      printRate("scalar getXvt", n, timer.seconds());
+
+      vector<Xvt> batchXvt;
+      vector<bool> batchOK;
+      timer.reset();
+      size_t computed = navLib.getXvt(sats, times, batchXvt, batchOK, false);
+      printRate("batch getXvt", n, timer.seconds());
+
+         // epoch-major, the way a real-time application would work
+      vector<Xvt> cursorXvt(n);
+      vector<bool> cursorOK(n);
+      NavLibrary::Cursor cursor(navLib);
+      timer.reset();
+      for (size_t ti = 0; ti < times.size(); ti++)
+      {
+         for (size_t si = 0; si < sats.size(); si++)
+         {
+            size_t idx = si * times.size() + ti;
+            cursorOK[idx] = cursor.getXvt(sats[si], times[ti], cursorXvt[idx],
+                                          false);
+         }
+      }
+      printRate("cursor getXvt", n, timer.seconds());
+      cout << "cursor hits " << cursor.getHits() << " misses "
+           << cursor.getMisses() << endl;
+
+      unsigned long mismatch = 0;
+      for (size_t i = 0; i < n; i++)
+      {
+         if ((scalarOK[i] != batchOK[i]) || (scalarOK[i] != cursorOK[i]) ||
+             (scalarOK[i] && (!(scalarXvt[i].x == batchXvt[i].x) ||
+                              !(scalarXvt[i].v == batchXvt[i].v) ||
+                              !(scalarXvt[i].x == cursorXvt[i].x) ||
+                              !(scalarXvt[i].v == cursorXvt[i].v))))
+         {
+            mismatch++;
+         }
+      }
+      cout << computed << " of " << n << " computed, results "
+           << (mismatch == 0 ? "match" : "DO NOT match") << endl;
+      return mismatch == 0 ? 0 : 2;
+   }
+   catch (Exception& exc)
+   {
+      cerr << exc << endl;
+      return 1;
+   }
+}
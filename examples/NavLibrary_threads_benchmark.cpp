@@ -0,0 +1,172 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/** @file NavLibrary_threads_benchmark.cpp Measure how the
+ * throughput of NavLibrary::getXvt() scales with the number of
+ * threads sharing a single sealed NavLibrary, rather than each
+ * thread having its own copy of the data.
+ *
+ * Usage: NavLibrary_threads_benchmark maxThreads interval file [file ...]
+ * where maxThreads is the largest number of threads to try
+ * (1, 2, 4, ... up to maxThreads), interval is the time step in
+ * seconds between evaluated epochs and each file is any format
+ * supported by MultiFormatNavDataFactory. */
+
+#include <algorithm>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+#include <vector>
+#include "NavLibrary.hpp"
+#include "MultiFormatNavDataFactory.hpp"
+#include "BenchmarkUtil.hpp"
+
+using namespace std;
+using namespace gnsstk;
+
+int main(int argc, char* argv[])
+{
+   if (argc < 4)
+   {
+      cerr << "usage: " << argv[0] << " maxThreads interval navFile [...]"
+           << endl;
+      return 1;
+   }
+   try
+   {
+      unsigned maxThreads = atoi(argv[1]);
+      double interval = atof(argv[2]);
+      if ((maxThreads == 0) || (interval <= 0))
+      {
+         cerr << "Invalid maxThreads or interval" << endl;
+         return 1;
+      }
+      NavLibrary navLib;
+      NavDataFactoryPtr ndfp(make_shared<MultiFormatNavDataFactory>());
+      MultiFormatNavDataFactory *fact =
+         dynamic_cast<MultiFormatNavDataFactory*>(ndfp.get());
+      navLib.addFactory(ndfp);
+      vector<string> files(argv+3, argv+argc);
+      if (!fact->addDataSources(files))
+      {
+         cerr << "Unable to load all of the files" << endl;
+         return 1;
+      }
+      CommonTime t0 = fact->getInitialTime(), t1 = fact->getFinalTime();
+         // Fit intervals can put the final time well beyond the data.
+      t1 = std::min(t1, t0 + 86400.0);
+      NavSatelliteIDSet satSet = fact->getAvailableSats(
+         NavMessageType::Ephemeris, t0, t1);
+      vector<NavSatelliteID> sats(satSet.begin(), satSet.end());
+      vector<CommonTime> times;
+      for (CommonTime t = t0; t < t1; t += interval)
+      {
+         times.push_back(t);
+      }
+      size_t n = sats.size() * times.size();
+      cout << "Evaluating " << sats.size() << " satellites at "
+           << times.size() << " epochs" << endl;
+      long memBefore = residentMemoryKB();
+      navLib.seal();
+      cout << "seal() added " << (residentMemoryKB() - memBefore)
+           << " KB resident" << endl;
+
+         // Evaluate the indices [begin,end) of the work, epoch-major.
+      auto work = [&](size_t begin, size_t end, vector<Xvt>& xvt,
+                      vector<char>& ok)
+      {
+         for (size_t i = begin; i < end; i++)
+         {
+            ok[i] = navLib.getXvt(sats[i % sats.size()],
+                                  times[i / sats.size()], xvt[i], false);
+         }
+      };
+      vector<Xvt> refXvt(n);
+      vector<char> refOK(n);
+      double single = 0;
+      for (unsigned nthr = 1; nthr <= maxThreads; nthr *= 2)
+      {
+         vector<Xvt> xvt(n);
+         vector<char> ok(n);
+         vector<thread> threads;
+         BenchTimer timer;
+         for (unsigned t = 0; t < nthr; t++)
+         {
+            threads.push_back(thread(work, t * n / nthr, (t + 1) * n / nthr,
+                                     ref(nthr == 1 ? refXvt : xvt),
+                                     ref(nthr == 1 ? refOK : ok)));
+         }
+         for (auto& th : threads)
+         {
+            th.join();
+         }
+         double sec = timer.seconds();
+         if (nthr == 1)
+         {
+            single = sec;
+            xvt = refXvt;
+            ok = refOK;
+         }
+         unsigned long mismatch = 0;
+         for (size_t i = 0; i < n; i++)
+         {
+            if ((ok[i] != refOK[i]) ||
+                (ok[i] && (!(xvt[i].x == refXvt[i].x) ||
+                           !(xvt[i].v == refXvt[i].v))))
+            {
+               mismatch++;
+            }
+         }
+         printRate(to_string(nthr) + " thread getXvt", n, sec);
+         cout << "   speedup " << fixed << setprecision(2) << (single / sec)
+              << ", results " << (mismatch == 0 ? "match" : "DO NOT match")
+              << endl;
+         if (mismatch != 0)
+         {
+            return 2;
+         }
+      }
+   }
+   catch (Exception& exc)
+   {
+      cerr << exc << endl;
+      return 1;
+   }
+   return 0;
+}
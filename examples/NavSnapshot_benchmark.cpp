@@ -0,0 +1,112 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/** @file NavSnapshot_benchmark.cpp Compare the time taken to load a
+ * set of navigation data files from their original formats against
+ * the time taken to load the same data from a snapshot written by
+ * NavDataFactoryWithStore::saveSnapshot().
+ *
+ * Usage: NavSnapshot_benchmark snapshotFile file [file ...]
+ * where snapshotFile is the name of the snapshot file to create and
+ * each file is any format supported by MultiFormatNavDataFactory. */
+
+#include <iostream>
+#include <sstream>
+#include <vector>
+#include "MultiFormatNavDataFactory.hpp"
+#include "BenchmarkUtil.hpp"
+
+using namespace std;
+using namespace gnsstk;
+
+int main(int argc, char* argv[])
+{
+   if (argc < 3)
+   {
+      cerr << "usage: " << argv[0] << " snapshotFile navFile [...]" << endl;
+      return 1;
+   }
+   try
+   {
+      string snapFile(argv[1]);
+      vector<string> files(argv+2, argv+argc);
+      MultiFormatNavDataFactory fact;
+      BenchTimer timer;
+      for (const auto& fn : files)
+      {
+         if (!fact.addDataSource(fn))
+         {
+            cerr << "Unable to load " << fn << endl;
+            return 1;
+         }
+      }
+      printRate("addDataSource", files.size(), timer.seconds());
+      size_t textSize = fact.size();
+      ostringstream textDump;
+      fact.dump(textDump, DumpDetail::Full);
+
+      timer.reset();
+      if (!fact.saveSnapshot(snapFile))
+      {
+         cerr << "Unable to write snapshot " << snapFile << endl;
+         return 1;
+      }
+      printRate("saveSnapshot", 1, timer.seconds());
+
+      fact.clear();
+      timer.reset();
+      if (!fact.loadSnapshot(snapFile))
+      {
+         cerr << "Unable to read snapshot " << snapFile << endl;
+         return 1;
+      }
+      printRate("loadSnapshot", 1, timer.seconds());
+      ostringstream snapDump;
+      fact.dump(snapDump, DumpDetail::Full);
+      cout << textSize << " messages loaded, results "
+           << (((textSize == fact.size()) &&
+                (textDump.str() == snapDump.str()))
+               ? "match" : "DIFFER") << endl;
+   }
+   catch (gnsstk::Exception& exc)
+   {
+      cerr << exc << endl;
+      return 1;
+   }
+   return 0;
+}
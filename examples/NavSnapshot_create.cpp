@@ -0,0 +1,154 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/** @file NavSnapshot_create.cpp Build a snapshot of a set of
+ * navigation data files with
+ * MultiFormatNavDataFactory::createSnapshot(), so that later runs can
+ * load the snapshot with loadSnapshot() instead of decoding the files
+ * again.
+ *
+ * Usage: NavSnapshot_create -o snapshotFile [-t threads] file [file ...]
+ * where each file is any format supported by MultiFormatNavDataFactory.
+ * No snapshot is written if any of the files can't be loaded. */
+
+#include <iostream>
+#include <vector>
+#include "BasicFramework.hpp"
+#include "MultiFormatNavDataFactory.hpp"
+#include "StringUtils.hpp"
+
+using namespace std;
+using namespace gnsstk;
+
+/// Create a nav data snapshot from the files on the command line.
+class NavSnapshotCreate : public BasicFramework
+{
+public:
+      /// Initialize command-line arguments
+   NavSnapshotCreate(const string& applName);
+      /// Process command-line arguments
+   bool initialize(int argc, char *argv[], bool pretty = true) noexcept override;
+      /// Load the files and write the snapshot.
+   void process() override;
+      /// Path of the snapshot file to write.
+   CommandOptionWithAnyArg outputOpt;
+      /// Number of threads to decode the files with.
+   CommandOptionWithNumberArg threadsOpt;
+      /// The nav data files to load.
+   CommandOptionRest filesOpt;
+      /// Value of threadsOpt, 0 meaning the number of hardware threads.
+   unsigned threads;
+};
+
+
+NavSnapshotCreate ::
+NavSnapshotCreate(const string& applName)
+      : BasicFramework(applName, "Decode navigation data files and write"
+                       " a snapshot that MultiFormatNavDataFactory can"
+                       " load in their place."),
+        outputOpt('o', "output", "path of the snapshot file to write", true),
+        threadsOpt('t', "threads", "number of threads to decode the files"
+                   " with (default: number of hardware threads)"),
+        filesOpt("nav file [...]", true),
+        threads(0)
+{
+   outputOpt.setMaxCount(1);
+   threadsOpt.setMaxCount(1);
+}
+
+
+bool NavSnapshotCreate ::
+initialize(int argc, char *argv[], bool pretty) noexcept
+{
+   if (!BasicFramework::initialize(argc, argv, pretty))
+      return false;
+   if (threadsOpt.getCount() > 0)
+   {
+      threads = StringUtils::asUnsigned(threadsOpt.getValue()[0]);
+   }
+   return true;
+}
+
+
+void NavSnapshotCreate ::
+process()
+{
+   MultiFormatNavDataFactory fact;
+   const vector<string>& files(filesOpt.getValue());
+   const string& snapFile(outputOpt.getValue()[0]);
+   if (!fact.createSnapshot(snapFile, files, threads))
+   {
+      cerr << "Unable to create " << snapFile
+           << ", check that every nav file exists and is a supported format"
+           << endl;
+      exitCode = EXIST_ERROR;
+      return;
+   }
+   if (verboseLevel)
+   {
+      cout << "Wrote " << fact.size() << " messages from " << files.size()
+           << " files to " << snapFile << endl;
+   }
+}
+
+
+int main(int argc, char *argv[])
+{
+   try
+   {
+      NavSnapshotCreate app(argv[0]);
+      if (app.initialize(argc, argv))
+      {
+         app.run();
+      }
+      return app.exitCode;
+   }
+   catch (gnsstk::Exception& e)
+   {
+      cerr << e << endl;
+   }
+   catch (std::exception& e)
+   {
+      cerr << e.what() << endl;
+   }
+   catch (...)
+   {
+      cerr << "Caught unknown exception" << endl;
+   }
+   return gnsstk::BasicFramework::EXCEPTION_ERROR;
+}
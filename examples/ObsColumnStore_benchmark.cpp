@@ -0,0 +1,130 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/** @file ObsColumnStore_benchmark.cpp Measure the time taken and the
+ * heap used by Rinex3ObsFileLoader to load RINEX observation files,
+ * which it stores in an ObsColumnStore, against the vector of
+ * Rinex3ObsData that getStore() builds from it, and time writing the
+ * GPS data to SatPass with WriteSatPassList().  A day of 1 Hz data is
+ * a representative input.
+ *
+ * Usage: ObsColumnStore_benchmark file [file ...] */
+
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <vector>
+#include "Rinex3ObsFileLoader.hpp"
+#include "SatPass.hpp"
+#include "BenchmarkUtil.hpp"
+
+using namespace std;
+using namespace gnsstk;
+
+int main(int argc, char* argv[])
+{
+   if (argc < 2)
+   {
+      cerr << "usage: " << argv[0] << " file [file ...]" << endl;
+      return 1;
+   }
+   try
+   {
+      vector<string> files(argv + 1, argv + argc);
+      Rinex3ObsFileLoader loader(files);
+      const char *ids[] = { "GC1C", "GL1C", "GC2W", "GL2W" };
+      for (const char *id : ids)
+      {
+         loader.loadObsID(id);
+      }
+      loader.saveTheData(true);
+      string errmsg, msg;
+      long heap0 = heapInUseKB();
+      BenchTimer timer;
+      loader.loadFiles(errmsg, msg);
+      double loadSec = timer.seconds();
+      long heap1 = heapInUseKB();
+      if (!errmsg.empty())
+      {
+         cerr << errmsg << endl;
+      }
+      timer.reset();
+      const vector<Rinex3ObsData>& store(loader.getStore());
+      double storeSec = timer.seconds();
+      long heap2 = heapInUseKB();
+      cout << fixed << setprecision(3) << "loadFiles " << loadSec << " s, "
+           << loader.getStoreSize() << " epochs, heap "
+           << (heap1 - heap0) << " KB" << endl;
+      cout << "getStore " << storeSec << " s, " << store.size()
+           << " epochs, heap " << (heap2 - heap1) << " KB" << endl;
+
+         // write the GPS data to SatPass, in the order loaded
+      map<char, vector<string>> obstypes;
+      map<char, vector<int>> indexes;
+      vector<string> wanted(loader.getWantedObsTypes());
+      for (unsigned i = 0; i < wanted.size(); i++)
+      {
+         obstypes['G'].push_back(wanted[i].substr(1));
+         indexes['G'].push_back(i);
+      }
+      vector<SatPass> passes;
+      timer.reset();
+      int npass = loader.WriteSatPassList(obstypes, indexes, passes);
+      double spSec = timer.seconds();
+      unsigned long count = 0;
+      double sum = 0;
+      for (unsigned i = 0; i < passes.size(); i++)
+      {
+         for (unsigned j = 0; j < passes[i].size(); j++)
+         {
+            count++;
+               // position in the list matters, to check the order
+            sum += (i + 1) * passes[i].data(j, obstypes['G'][0]);
+         }
+      }
+      cout << "WriteSatPassList " << spSec << " s, " << npass << " passes, "
+           << count << " epochs, checksum " << setprecision(1) << sum
+           << endl;
+   }
+   catch (gnsstk::Exception& exc)
+   {
+      cerr << exc << endl;
+      return 1;
+   }
+   return 0;
+}
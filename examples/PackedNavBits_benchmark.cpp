@@ -0,0 +1,178 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/** @file PackedNavBits_benchmark.cpp Measure the cost of extracting
+ * fields from PackedNavBits, both directly and as used by the
+ * PNBGPSLNavDataFactory, PNBGalINavDataFactory and
+ * PNBBDSD1NavDataFactory decoders.  The messages decoded are those
+ * used by the factories' unit tests.
+ *
+ * Usage: PackedNavBits_benchmark [iterations] */
+
+#include <cstdlib>
+#include <iostream>
+#include "PNBGPSLNavDataFactory.hpp"
+#include "PNBGalINavDataFactory.hpp"
+#include "PNBBDSD1NavDataFactory.hpp"
+#include "GPSWeekSecond.hpp"
+#include "GALWeekSecond.hpp"
+#include "BDSWeekSecond.hpp"
+#include "BenchmarkUtil.hpp"
+
+using namespace std;
+using namespace gnsstk;
+
+   /// Hold the test messages, declared and defined as in the unit tests.
+class BenchData
+{
+public:
+   BenchData()
+   {
+#include "LNavTestDataDef.hpp"
+#include "GalINavTestDataDef.hpp"
+#include "D1NavTestDataDef.hpp"
+   }
+
+#include "LNavTestDataDecl.hpp"
+#include "GalINavTestDataDecl.hpp"
+#include "D1NavTestDataDecl.hpp"
+};
+
+
+   /** Feed msgs to fact iterations times, with the factory's caches
+    * cleared each time so that every pass decodes the messages.
+    * @return The number of NavData objects produced. */
+static unsigned long decode(PNBNavDataFactory& fact,
+                            const vector<PackedNavBitsPtr>& msgs,
+                            unsigned long iterations)
+{
+   unsigned long count = 0;
+   NavDataPtrList navOut;
+   for (unsigned long i = 0; i < iterations; i++)
+   {
+      fact.resetState();
+      for (const auto& pnb : msgs)
+      {
+         navOut.clear();
+         if (!fact.addData(pnb, navOut))
+         {
+            cerr << "addData failed" << endl;
+            exit(1);
+         }
+         count += navOut.size();
+      }
+   }
+   return count;
+}
+
+
+int main(int argc, char* argv[])
+{
+   unsigned long iterations = (argc > 1 ? atol(argv[1]) : 100000);
+   try
+   {
+      BenchData data;
+      unsigned long sum = 0, count = 0;
+
+         // Raw field extraction at every alignment.
+      const PackedNavBits& pnb(*data.ephLNAVGPSSF2);
+      unsigned numBits = pnb.getNumBits();
+      BenchTimer timer;
+      for (unsigned long i = 0; i < iterations; i++)
+      {
+         for (unsigned start = 0; start + 32 <= numBits; start += 3)
+         {
+            sum += pnb.asUnsignedLong(start, 8 + (start % 25), 1);
+            sum += pnb.asLong(start, 32, 1);
+            count += 2;
+         }
+      }
+      printRate("asUnsignedLong/asLong", count, timer.seconds());
+
+      count = 0;
+      timer.reset();
+      for (unsigned long i = 0; i < iterations; i++)
+      {
+         count++;
+         sum += pnb.asDoubleSemiCircles(30, 8, 60, 24, -31) > 0;
+      }
+      printRate("asDoubleSemiCircles (split)", count, timer.seconds());
+
+      PNBGPSLNavDataFactory gpsFact;
+      vector<PackedNavBitsPtr> gpsMsgs = {
+         data.ephLNAVGPSSF1, data.ephLNAVGPSSF2, data.ephLNAVGPSSF3,
+         data.almLNAVGPS25, data.almLNAVGPS26, data.pg51LNAVGPS,
+         data.pg56LNAVGPS, data.pg63LNAVGPS };
+      timer.reset();
+      count = decode(gpsFact, gpsMsgs, iterations);
+      printRate("PNBGPSLNavDataFactory messages",
+                iterations * gpsMsgs.size(), timer.seconds());
+      cout << "   " << count << " NavData produced" << endl;
+
+      PNBGalINavDataFactory galFact;
+      vector<PackedNavBitsPtr> galMsgs = {
+         data.navINAVGalWT6, data.navINAVGalWT7, data.navINAVGalWT8,
+         data.ephINAVGalWT1, data.ephINAVGalWT2, data.ephINAVGalWT3,
+         data.ephINAVGalWT4, data.ephINAVGalWT5, data.navINAVGalWT9,
+         data.navINAVGalWT10 };
+      timer.reset();
+      count = decode(galFact, galMsgs, iterations);
+      printRate("PNBGalINavDataFactory messages",
+                iterations * galMsgs.size(), timer.seconds());
+      cout << "   " << count << " NavData produced" << endl;
+
+      PNBBDSD1NavDataFactory bdsFact;
+      vector<PackedNavBitsPtr> bdsMsgs = {
+         data.ephD1NAVSF1, data.ephD1NAVSF2, data.ephD1NAVSF3,
+         data.almD1NAVSF4p1, data.almD1NAVSF5p1, data.almD1NAVSF4p7,
+         data.almD1NAVSF5p7, data.almD1NAVSF4p8, data.almD1NAVSF5p8 };
+      timer.reset();
+      count = decode(bdsFact, bdsMsgs, iterations);
+      printRate("PNBBDSD1NavDataFactory messages",
+                iterations * bdsMsgs.size(), timer.seconds());
+      cout << "   " << count << " NavData produced" << endl;
+         // keep the compiler from discarding the extraction loops
+      cout << "checksum " << sum << endl;
+   }
+   catch (gnsstk::Exception& exc)
+   {
+      cerr << exc << endl;
+      return 1;
+   }
+   return 0;
+}
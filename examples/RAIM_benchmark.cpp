@@ -0,0 +1,345 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+
+/** @file RAIM_benchmark.cpp Compare the rate of PRSolution::RAIMCompute()
+ * solving every combination of rejected satellites against the
+ * FastRAIM search, with and without FastRAIMVerify, as the number of
+ * satellites grows.  The pseudoranges are simulated from circular
+ * GPS and Galileo orbits, with two faulty satellites in each epoch,
+ * and the satellites rejected by each method are compared.
+ *
+ * Usage: RAIM_benchmark [epochs] */
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <random>
+#include "PRSolution.hpp"
+#include "NavLibrary.hpp"
+#include "NavDataFactory.hpp"
+#include "OrbitData.hpp"
+#include "RawRange.hpp"
+#include "GPSEllipsoid.hpp"
+#include "GPSWeekSecond.hpp"
+#include "TropModel.hpp"
+#include "BenchmarkUtil.hpp"
+
+using namespace std;
+using namespace gnsstk;
+
+   /// A satellite in a circular orbit.
+class CircularOrbit : public OrbitData
+{
+public:
+   CircularOrbit(const CommonTime& epoch, double radius, double incl,
+                 double raan, double phase)
+         : t0(epoch), r(radius), i(incl), node(raan), u0(phase),
+           n(std::sqrt(GPSEllipsoid().gm() / (radius*radius*radius)))
+   { timeStamp = epoch; }
+
+   NavDataPtr clone() const override
+   { return std::make_shared<CircularOrbit>(*this); }
+
+   bool validate() const override
+   { return true; }
+
+   bool getXvt(const CommonTime& when, Xvt& xvt, const ObsID& oid) override
+   {
+      double dt = when - t0;
+      double u = u0 + n*dt, th = GPSEllipsoid().angVelocity() * dt;
+      double cu = std::cos(u), su = std::sin(u);
+      double cn = std::cos(node), sn = std::sin(node);
+      double ci = std::cos(i), si = std::sin(i);
+         // inertial position and velocity
+      double p[3] = { r*(cn*cu - sn*su*ci), r*(sn*cu + cn*su*ci), r*su*si };
+      double v[3] = { r*n*(-cn*su - sn*cu*ci), r*n*(-sn*su + cn*cu*ci),
+                      r*n*cu*si };
+         // rotate into the Earth-fixed frame
+      double ct = std::cos(th), st = std::sin(th);
+      xvt.x[0] = ct*p[0] + st*p[1];
+      xvt.x[1] = -st*p[0] + ct*p[1];
+      xvt.x[2] = p[2];
+      double w = GPSEllipsoid().angVelocity();
+      xvt.v[0] = ct*v[0] + st*v[1] + w*xvt.x[1];
+      xvt.v[1] = -st*v[0] + ct*v[1] - w*xvt.x[0];
+      xvt.v[2] = v[2];
+      xvt.clkbias = xvt.clkdrift = xvt.relcorr = 0.0;
+      xvt.health = Xvt::Healthy;
+      return true;
+   }
+
+private:
+   CommonTime t0;
+   double r, i, node, u0, n;
+};
+
+
+   /// Serve CircularOrbit objects to NavLibrary.
+class CircularOrbitFactory : public NavDataFactory
+{
+public:
+   CircularOrbitFactory()
+   {
+      supportedSignals.insert(
+         NavSignalID(SatelliteSystem::GPS, CarrierBand::L1, TrackingCode::CA,
+                     NavType::GPSLNAV));
+      supportedSignals.insert(
+         NavSignalID(SatelliteSystem::Galileo, CarrierBand::L1,
+                     TrackingCode::E1B, NavType::GalINAV));
+   }
+
+   bool find(const NavMessageID& nmid, const CommonTime& when,
+             NavDataPtr& navData, SVHealth xmitHealth, NavValidityType valid,
+             NavSearchOrder order) override
+   {
+      auto oi = orbits.find(nmid.sat);
+      if ((nmid.messageType != NavMessageType::Ephemeris) ||
+          (oi == orbits.end()))
+      {
+         return false;
+      }
+      navData = oi->second;
+      return true;
+   }
+
+   bool getOffset(TimeSystem fromSys, TimeSystem toSys,
+                  const CommonTime& when, NavDataPtr& offset,
+                  SVHealth xmitHealth, NavValidityType valid) override
+   { return false; }
+
+   bool addDataSource(const std::string& source) override
+   { return false; }
+
+   std::string getFactoryFormats() const override
+   { return "circular orbits"; }
+
+   NavSatelliteIDSet getAvailableSats(const CommonTime& fromTime,
+                                      const CommonTime& toTime)
+      const override
+   {
+      NavSatelliteIDSet rv;
+      for (const auto& oi : orbits)
+         rv.insert(NavSatelliteID(oi.first));
+      return rv;
+   }
+
+   NavSatelliteIDSet getAvailableSats(NavMessageType nmt,
+                                      const CommonTime& fromTime,
+                                      const CommonTime& toTime)
+      const override
+   { return getAvailableSats(fromTime, toTime); }
+
+   NavMessageIDSet getAvailableMsgs(const CommonTime& fromTime,
+                                    const CommonTime& toTime)
+      const override
+   { return NavMessageIDSet(); }
+
+   std::map<SatID, NavDataPtr> orbits;
+};
+
+
+   /// Pseudoranges of one epoch.
+struct Epoch
+{
+   CommonTime time;
+   vector<SatID> sats;
+   vector<double> pr;
+};
+
+
+   /// Solve every epoch with RAIMCompute() and return the rejected sets.
+static vector<vector<SatID> > solve(const vector<Epoch>& epochs,
+                                    NavLibrary& navLib, bool fast,
+                                    bool verify, double& sec)
+{
+   vector<vector<SatID> > rv;
+   ZeroTropModel trop;
+   BenchTimer timer;
+   for (const auto& epoch : epochs)
+   {
+      PRSolution prs;
+      prs.allowedGNSS = { SatelliteSystem::GPS, SatelliteSystem::Galileo };
+      prs.FastRAIM = fast;
+      prs.FastRAIMVerify = verify;
+      vector<SatID> sats(epoch.sats);
+      Matrix<double> invMC(sats.size(), sats.size(), 0.0);
+      for (size_t i = 0; i < sats.size(); i++)
+         invMC(i,i) = 1.0;
+      int iret = prs.RAIMCompute(epoch.time, sats, epoch.pr, invMC, navLib,
+                                 &trop);
+      vector<SatID> rejected;
+      for (const auto& sat : sats)
+      {
+         if (iret < 0 || sat.id <= 0)
+            rejected.push_back(sat);
+      }
+      rv.push_back(rejected);
+   }
+   sec = timer.seconds();
+   return rv;
+}
+
+
+int main(int argc, char* argv[])
+{
+   unsigned numEpochs = (argc > 1 ? atoi(argv[1]) : 20);
+   try
+   {
+      GPSEllipsoid ell;
+      CommonTime t0 = GPSWeekSecond(2200, 0.0);
+      shared_ptr<CircularOrbitFactory> fact =
+         make_shared<CircularOrbitFactory>();
+         // six planes of eight GPS and of eight Galileo satellites
+      for (int sys = 0; sys < 2; sys++)
+      {
+         double radius = (sys == 0 ? 26560.e3 : 29600.e3);
+         double incl = (sys == 0 ? 55.0 : 56.0) * DEG_TO_RAD;
+         for (int plane = 0; plane < 6; plane++)
+         {
+            for (int slot = 0; slot < 8; slot++)
+            {
+               SatID sat(1 + plane*8 + slot, (sys == 0 ?
+                                              SatelliteSystem::GPS :
+                                              SatelliteSystem::Galileo));
+               fact->orbits[sat] = make_shared<CircularOrbit>(
+                  t0, radius, incl, (plane*60.0 + sys*30.0) * DEG_TO_RAD,
+                  (slot*45.0 + plane*7.5 + sys*20.0) * DEG_TO_RAD);
+            }
+         }
+      }
+      NavLibrary navLib;
+      NavDataFactoryPtr ndfp(fact);
+      navLib.addFactory(ndfp);
+
+      Position rx(30.4, 262.3, 200.0, Position::Geodetic);
+      rx.asECEF();
+      const double clock[2] = { 1234.5, 1312.8 };
+      mt19937 gen(1);
+      normal_distribution<double> noise(0.0, 0.5);
+      uniform_real_distribution<double> fault(40.0, 120.0);
+
+      const size_t counts[] = { 10, 14, 18, 24, 30 };
+      cout << "threads " << PRSolution().RAIMThreads << " (0 = hardware)"
+           << endl;
+      for (size_t count : counts)
+      {
+            // simulate the epochs with the count highest satellites
+         vector<Epoch> epochs;
+         for (unsigned e = 0; e < numEpochs; e++)
+         {
+            Epoch epoch;
+            epoch.time = t0 + e * 300.0;
+            multimap<double, SatID> byElev;
+            for (auto& oi : fact->orbits)
+            {
+               Xvt xvt;
+               dynamic_cast<OrbitData*>(oi.second.get())
+                  ->getXvt(epoch.time, xvt, ObsID());
+               double elev = rx.elevation(Position(xvt.x));
+               if (elev > 5.0)
+                  byElev.insert(make_pair(-elev, oi.first));
+            }
+            for (const auto& bi : byElev)
+            {
+               if (epoch.sats.size() == count)
+                  break;
+               epoch.sats.push_back(bi.second);
+            }
+            if (epoch.sats.size() < count)
+               continue;
+            for (const auto& sat : epoch.sats)
+            {
+               double clk = clock[sat.system == SatelliteSystem::GPS ? 0 : 1];
+               double pr = 0.075 * ell.c() + clk;
+               for (int iter = 0; iter < 3; iter++)
+               {
+                  double range;
+                  tie(ignore, range, ignore) =
+                     RawRange::fromNominalReceiveWithObs(
+                        rx, epoch.time, pr, navLib, NavSatelliteID(sat),
+                        ell);
+                  pr = range + clk;
+               }
+               epoch.pr.push_back(pr + noise(gen));
+            }
+               // two faulty satellites
+            size_t bad1 = gen() % count, bad2 = (bad1 + 1 + gen() % (count-1))
+               % count;
+            epoch.pr[bad1] += fault(gen);
+            epoch.pr[bad2] -= fault(gen);
+            epochs.push_back(epoch);
+         }
+         if (epochs.empty())
+         {
+            cout << count << " satellites are never visible" << endl;
+            continue;
+         }
+
+         double allSec, fastSec, verifySec;
+         vector<vector<SatID> > all, fast, verify;
+         all = solve(epochs, navLib, false, false, allSec);
+         fast = solve(epochs, navLib, true, false, fastSec);
+         verify = solve(epochs, navLib, true, true, verifySec);
+         unsigned fastMatch = 0, verifyMatch = 0, rejected = 0;
+         for (size_t i = 0; i < epochs.size(); i++)
+         {
+            rejected += all[i].size();
+            fastMatch += (fast[i] == all[i]);
+            verifyMatch += (verify[i] == all[i]);
+         }
+         cout << count << " satellites, " << epochs.size() << " epochs"
+              << endl;
+         printRate("   all combinations (epochs)", epochs.size(), allSec);
+         printRate("   FastRAIM (epochs)", epochs.size(), fastSec);
+         printRate("   FastRAIM+verify (epochs)", epochs.size(), verifySec);
+         cout << "   speedup " << (allSec / fastSec) << ", verified "
+              << (allSec / verifySec) << "; same rejections "
+              << fastMatch << "/" << epochs.size() << ", verified "
+              << verifyMatch << "/" << epochs.size() << "; "
+              << rejected << " satellites rejected" << endl;
+      }
+   }
+   catch (gnsstk::Exception& exc)
+   {
+      cerr << exc << endl;
+      return 1;
+   }
+   return 0;
+}
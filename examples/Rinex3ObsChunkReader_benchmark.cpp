@@ -0,0 +1,211 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/** @file Rinex3ObsChunkReader_benchmark.cpp Compare the rate at
+ * which RINEX 3 observation files are read by Rinex3ObsStream, one
+ * record after another, against Rinex3ObsChunkReader, which parses
+ * chunks of the files on a pool of threads, and time
+ * Rinex3ObsFileLoader::loadFiles using one thread and the pool.
+ *
+ * Usage: Rinex3ObsChunkReader_benchmark threads file [file ...] */
+
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+#include <thread>
+#include <sys/stat.h>
+#include "Rinex3ObsChunkReader.hpp"
+#include "Rinex3ObsFileLoader.hpp"
+#include "Rinex3ObsStream.hpp"
+#include "Rinex3ObsData.hpp"
+#include "BenchmarkUtil.hpp"
+
+using namespace std;
+using namespace gnsstk;
+
+   /// Totals used to make sure both readers got the same results.
+struct ReadTotals
+{
+   ReadTotals() : records(0), datums(0), sum(0) {}
+   bool operator==(const ReadTotals& right) const
+   {
+      return ((records == right.records) && (datums == right.datums) &&
+              (sum == right.sum));
+   }
+   unsigned long records;
+   unsigned long datums;
+   double sum;
+};
+
+
+   /// Add the contents of rod to totals.
+static void total(ReadTotals& totals, const Rinex3ObsData& rod)
+{
+   totals.records++;
+   for (const auto& sati : rod.obs)
+   {
+      for (const auto& datum : sati.second)
+      {
+         totals.datums++;
+         totals.sum += datum.data + datum.lli + datum.ssi;
+      }
+   }
+}
+
+
+   /// Read the files one after another with Rinex3ObsStream.
+static ReadTotals streamRead(const vector<string>& files)
+{
+   ReadTotals rv;
+   for (const auto& fn : files)
+   {
+      Rinex3ObsStream strm(fn);
+      Rinex3ObsData rod;
+      while (strm >> rod)
+      {
+         total(rv, rod);
+      }
+   }
+   return rv;
+}
+
+
+   /// Read the files with Rinex3ObsChunkReader.
+static ReadTotals chunkRead(const vector<string>& files, unsigned threads)
+{
+   ReadTotals rv;
+   Rinex3ObsChunkReader reader(threads);
+   for (const auto& fn : files)
+   {
+      reader.addFile(fn);
+   }
+   Rinex3ObsData rod;
+   for (size_t i = 0; i < reader.getNumFiles(); i++)
+   {
+      while (reader.read(i, rod))
+      {
+         total(rv, rod);
+      }
+   }
+   return rv;
+}
+
+
+   /// Load the files with Rinex3ObsFileLoader, saving all the data.
+static int loadFiles(const vector<string>& files, unsigned threads)
+{
+   Rinex3ObsFileLoader loader(files);
+   loader.setReadThreads(threads);
+   const char *ids[] = { "*C1*", "*L1*", "*C2*", "*L2*", "*C5*", "*L5*" };
+   for (const char *id : ids)
+   {
+      loader.loadObsID(id);
+   }
+   loader.saveTheData(true);
+   string errmsg, msg;
+   loader.loadFiles(errmsg, msg);
+   if (!errmsg.empty())
+   {
+      cerr << errmsg << endl;
+   }
+   return loader.getStoreSize();
+}
+
+
+int main(int argc, char* argv[])
+{
+   if (argc < 3)
+   {
+      cerr << "usage: " << argv[0] << " threads file [file ...]" << endl;
+      return 1;
+   }
+   try
+   {
+      unsigned threads = atoi(argv[1]);
+      vector<string> files(argv + 2, argv + argc);
+      double mb = 0;
+      for (const auto& fn : files)
+      {
+         struct stat st;
+         if (stat(fn.c_str(), &st) != 0)
+         {
+            cerr << "Unable to stat " << fn << endl;
+            return 1;
+         }
+         mb += st.st_size / 1048576.0;
+      }
+      Rinex3ObsChunkReader reader(threads);
+      cout << "Using " << reader.getThreads() << " threads, "
+           << std::thread::hardware_concurrency() << " hardware threads" << endl;
+      BenchTimer timer;
+      ReadTotals serial = streamRead(files);
+      double serialSec = timer.seconds();
+      timer.reset();
+      ReadTotals chunked = chunkRead(files, threads);
+      double chunkSec = timer.seconds();
+      printRate("Rinex3ObsStream (records)", serial.records, serialSec);
+      printRate("Rinex3ObsChunkReader (records)", chunked.records, chunkSec);
+      cout << fixed << setprecision(1)
+           << "Rinex3ObsStream " << (mb / serialSec) << " MB/s, "
+           << "Rinex3ObsChunkReader " << (mb / chunkSec) << " MB/s, "
+           << setprecision(2) << "speedup " << (serialSec / chunkSec)
+           << endl;
+      cout << chunked.records << " records, " << chunked.datums
+           << " observations, results "
+           << ((serial == chunked) ? "match" : "DIFFER") << endl;
+
+      timer.reset();
+      int serialStore = loadFiles(files, 1);
+      serialSec = timer.seconds();
+      timer.reset();
+      int chunkStore = loadFiles(files, threads);
+      chunkSec = timer.seconds();
+      cout << setprecision(3) << "Rinex3ObsFileLoader 1 thread "
+           << serialSec << " s, " << reader.getThreads() << " threads "
+           << chunkSec << " s, " << setprecision(2) << "speedup "
+           << (serialSec / chunkSec) << ", store sizes "
+           << ((serialStore == chunkStore) ? "match" : "DIFFER") << endl;
+   }
+   catch (gnsstk::Exception& exc)
+   {
+      cerr << exc << endl;
+      return 1;
+   }
+   return 0;
+}
@@ -0,0 +1,206 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/** @file Rinex3ObsData_benchmark.cpp Compare the rate at which
+ * Rinex3ObsData reads RINEX 3 observation records against a reader
+ * that parses the same records the way Rinex3ObsData used to, by
+ * copying every field into a std::string and building new containers
+ * for each epoch.
+ *
+ * Usage: Rinex3ObsData_benchmark file [passes]
+ * where file is a RINEX 3 observation file. */
+
+#include <iostream>
+#include <vector>
+#include <sys/stat.h>
+#include "Rinex3ObsStream.hpp"
+#include "Rinex3ObsData.hpp"
+#include "CivilTime.hpp"
+#include "StringUtils.hpp"
+#include "BenchmarkUtil.hpp"
+
+using namespace std;
+using namespace gnsstk;
+using namespace gnsstk::StringUtils;
+
+   /// Totals used to make sure both readers got the same results.
+struct ReadTotals
+{
+   ReadTotals() : records(0), datums(0), sum(0) {}
+   bool operator==(const ReadTotals& right) const
+   {
+      return ((records == right.records) && (datums == right.datums) &&
+              (sum == right.sum));
+   }
+   unsigned long records;
+   unsigned long datums;
+   double sum;
+};
+
+
+   /// Add the contents of rod to totals.
+static void total(ReadTotals& totals, const Rinex3ObsData& rod)
+{
+   totals.records++;
+   for (const auto& sati : rod.obs)
+   {
+      for (const auto& datum : sati.second)
+      {
+         totals.datums++;
+         totals.sum += datum.data + datum.lli + datum.ssi;
+      }
+   }
+}
+
+
+   /// Read fn using the per-field string parsing of the original reader.
+static ReadTotals legacyRead(const string& fn)
+{
+   ReadTotals rv;
+   Rinex3ObsStream strm(fn);
+   strm >> strm.header;
+   string line;
+   while (true)
+   {
+      try
+      {
+         strm.formattedGetLine(line, true);
+      }
+      catch (EndOfFile&)
+      {
+         break;
+      }
+      stripTrailing(line, " ");
+      Rinex3ObsData rod;
+      rod.epochFlag = asInt(line.substr(31,1));
+      CivilTime civ(asInt(line.substr(2,4)), asInt(line.substr(7,2)),
+                    asInt(line.substr(10,2)), asInt(line.substr(13,2)),
+                    asInt(line.substr(16,2)), asDouble(line.substr(19,11)),
+                    strm.timesystem);
+      rod.time = civ;
+      rod.numSVs = asInt(line.substr(32,3));
+      if (line.size() > 41)
+         rod.clockOffset = asDouble(line.substr(41,15));
+      for (int isv = 0; isv < rod.numSVs; isv++)
+      {
+         strm.formattedGetLine(line);
+         if ((rod.epochFlag != 0) && (rod.epochFlag != 1) &&
+             (rod.epochFlag != 6))
+         {
+            continue;
+         }
+         stripTrailing(line, " ");
+         RinexSatID sat(line.substr(0,3));
+         string gnss = asString(sat.systemChar());
+         int size = strm.header.mapObsTypes[gnss].size();
+         size_t minSize = 3 + 16*size;
+         if (line.size() < minSize)
+            line += string(minSize-line.size(), ' ');
+         vector<RinexDatum> data;
+         for (int i = 0; i < size; i++)
+         {
+            RinexDatum tempData(line.substr(3 + 16*i,16));
+            data.push_back(tempData);
+         }
+         rod.obs[sat] = data;
+      }
+      total(rv, rod);
+   }
+   return rv;
+}
+
+
+   /// Read fn using Rinex3ObsData.
+static ReadTotals currentRead(const string& fn)
+{
+   ReadTotals rv;
+   Rinex3ObsStream strm(fn);
+   Rinex3ObsData rod;
+   while (strm >> rod)
+   {
+      total(rv, rod);
+   }
+   return rv;
+}
+
+
+int main(int argc, char* argv[])
+{
+   if (argc < 2)
+   {
+      cerr << "usage: " << argv[0] << " file [passes]" << endl;
+      return 1;
+   }
+   try
+   {
+      string fn(argv[1]);
+      unsigned passes = (argc > 2 ? atoi(argv[2]) : 3);
+      struct stat st;
+      if (stat(fn.c_str(), &st) != 0)
+      {
+         cerr << "Unable to stat " << fn << endl;
+         return 1;
+      }
+      double mb = st.st_size / 1048576.0;
+      ReadTotals legacy, current;
+      BenchTimer timer;
+      for (unsigned i = 0; i < passes; i++)
+         legacy = legacyRead(fn);
+      double legacySec = timer.seconds();
+      timer.reset();
+      for (unsigned i = 0; i < passes; i++)
+         current = currentRead(fn);
+      double currentSec = timer.seconds();
+      printRate("string fields (records)", legacy.records * passes,
+                legacySec);
+      printRate("Rinex3ObsData (records)", current.records * passes,
+                currentSec);
+      cout << "string fields " << (mb * passes / legacySec) << " MB/s, "
+           << "Rinex3ObsData " << (mb * passes / currentSec) << " MB/s, "
+           << "speedup " << (legacySec / currentSec) << endl;
+      cout << current.records << " records, " << current.datums
+           << " observations, results "
+           << ((legacy == current) ? "match" : "DIFFER") << endl;
+   }
+   catch (gnsstk::Exception& exc)
+   {
+      cerr << exc << endl;
+      return 1;
+   }
+   return 0;
+}
@@ -0,0 +1,227 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/** @file SMatrix_benchmark.cpp Compare the fixed size SMatrix and
+ * SVector against Matrix and Vector for the small products and
+ * inverses of single point positioning, and count the heap
+ * allocations made by the per-satellite geometry (Position, range
+ * and line of sight) and by HelmertTransformer.
+ *
+ * Usage: SMatrix_benchmark [iterations] */
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include "SMatrix.hpp"
+#include "Position.hpp"
+#include "RawRange.hpp"
+#include "GPSEllipsoid.hpp"
+#include "HelmertTransformer.hpp"
+#include "YDSTime.hpp"
+#include "BenchmarkUtil.hpp"
+
+using namespace std;
+using namespace gnsstk;
+
+   /// Number of calls to operator new since the program started.
+static unsigned long newCount = 0;
+
+void* operator new(std::size_t size)
+{
+   newCount++;
+   void *rv = malloc(size ? size : 1);
+   if (rv == nullptr)
+      throw std::bad_alloc();
+   return rv;
+}
+
+void operator delete(void *p) noexcept
+{
+   free(p);
+}
+
+   /// Number of satellites in the simulated epochs.
+static const size_t numSats = 8;
+
+   /// Fill the 8x4 partials of a single-system solution.
+template <class M>
+static void fillPartials(M& h, double seed)
+{
+   for (size_t i = 0; i < numSats; i++)
+   {
+      double az = seed + 0.8*i, el = 0.2 + 0.15*i;
+      h(i,0) = ::cos(el) * ::sin(az);
+      h(i,1) = ::cos(el) * ::cos(az);
+      h(i,2) = ::sin(el);
+      h(i,3) = 1.0;
+   }
+}
+
+
+int main(int argc, char* argv[])
+{
+   unsigned long iterations = (argc > 1 ? atol(argv[1]) : 1000000);
+   try
+   {
+      double sum = 0;
+      unsigned long allocs;
+
+         // 3x3 rotation of a vector, as in the datum transformations
+      Matrix<double> rot(3, 3);
+      SMatrix<double,3,3> srot;
+      for (size_t i = 0; i < 3; i++)
+         for (size_t j = 0; j < 3; j++)
+            srot(i,j) = rot(i,j) = (i == j ? 1.0 : 1e-6 * (i + 2.0*j));
+      Vector<double> vec(3, 1.0);
+      SVector<double,3> svec(1.0);
+      BenchTimer timer;
+      allocs = newCount;
+      for (unsigned long i = 0; i < iterations; i++)
+      {
+         vec[0] = i;
+         Vector<double> res(rot * vec);
+         sum += res[2];
+      }
+      printRate("Matrix 3x3 * Vector", iterations, timer.seconds());
+      cout << "   " << double(newCount - allocs) / iterations
+           << " allocations/op" << endl;
+      timer.reset();
+      allocs = newCount;
+      for (unsigned long i = 0; i < iterations; i++)
+      {
+         svec[0] = i;
+         SVector<double,3> res(srot * svec);
+         sum += res[2];
+      }
+      printRate("SMatrix 3x3 * SVector", iterations, timer.seconds());
+      cout << "   " << double(newCount - allocs) / iterations
+           << " allocations/op" << endl;
+
+         // normal equations and covariance of a 4 state solution
+      Matrix<double> h(numSats, 4);
+      SMatrix<double,numSats,4> sh;
+      fillPartials(h, 0.0);
+      fillPartials(sh, 0.0);
+      unsigned long n = iterations / 10;
+      timer.reset();
+      allocs = newCount;
+      for (unsigned long i = 0; i < n; i++)
+      {
+         h(0,0) += 1e-9;
+         Matrix<double> cov(inverse(transposeTimes(h, h)));
+         sum += cov(3,3);
+      }
+      printRate("Matrix 8x4 normal eq + inverse", n, timer.seconds());
+      cout << "   " << double(newCount - allocs) / n
+           << " allocations/op" << endl;
+      timer.reset();
+      allocs = newCount;
+      for (unsigned long i = 0; i < n; i++)
+      {
+         sh(0,0) += 1e-9;
+         SMatrix<double,4,4> cov(inverse(transposeTimes(sh, sh)));
+         sum += cov(3,3);
+      }
+      printRate("SMatrix 8x4 normal eq + inverse", n, timer.seconds());
+      cout << "   " << double(newCount - allocs) / n
+           << " allocations/op" << endl;
+      timer.reset();
+      allocs = newCount;
+      for (unsigned long i = 0; i < n; i++)
+      {
+         sh(0,0) += 1e-9;
+         SMatrix<double,4,4> cov(inverseChol(transposeTimes(sh, sh)));
+         sum += cov(3,3);
+      }
+      printRate("SMatrix 8x4 normal eq + inverseChol", n, timer.seconds());
+      cout << "   " << double(newCount - allocs) / n
+           << " allocations/op" << endl;
+
+         // per-satellite geometry of PRSolution
+      GPSEllipsoid ellip;
+      Position rxPos(-740290.0, -5457071.7, 3207245.6);
+      timer.reset();
+      allocs = newCount;
+      for (unsigned long i = 0; i < iterations; i++)
+      {
+         Position svPos(-16000000.0 + i, -12000000.0, 17000000.0);
+         double rho;
+         std::tie(rho, svPos) = RawRange::computeRange(rxPos, svPos, 0.07,
+                                                       ellip);
+         Triple dirCos((rxPos[0] - svPos[0]) / rho,
+                       (rxPos[1] - svPos[1]) / rho,
+                       (rxPos[2] - svPos[2]) / rho);
+         sum += dirCos[2];
+      }
+      printRate("Position range and direction cosines", iterations,
+                timer.seconds());
+      cout << "   " << double(newCount - allocs) / iterations
+           << " allocations/op" << endl;
+
+         // datum transformation
+      HelmertTransformer xf(RefFrame(RefFrameRlz::PZ90Y2007),
+                            RefFrame(RefFrameRlz::WGS84G1150),
+                            -0.00000019, 0.00000504, -0.00000001,
+                            -0.013, 0.106, 0.022, 0.000000008, "bench",
+                            YDSTime(2007,263,0,TimeSystem::UTC));
+      Position from(rxPos), to;
+      from.setReferenceFrame(RefFrame(RefFrameRlz::PZ90Y2007));
+      to.setReferenceFrame(RefFrame(RefFrameRlz::WGS84G1150));
+      timer.reset();
+      allocs = newCount;
+      for (unsigned long i = 0; i < iterations; i++)
+      {
+         from[0] = rxPos[0] + i;
+         xf.transform(from, to);
+         sum += to[2];
+      }
+      printRate("HelmertTransformer::transform", iterations,
+                timer.seconds());
+      cout << "   " << double(newCount - allocs) / iterations
+           << " allocations/op" << endl;
+         // keep the compiler from discarding the loops
+      cout << "checksum " << sum << endl;
+   }
+   catch (gnsstk::Exception& exc)
+   {
+      cerr << exc << endl;
+      return 1;
+   }
+   return 0;
+}
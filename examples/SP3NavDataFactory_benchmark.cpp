@@ -0,0 +1,221 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/** @file SP3NavDataFactory_benchmark.cpp Compare the number of
+ * interpolations per second of SP3NavDataFactory::find() followed by
+ * OrbitDataSP3::getXvt() against SP3NavDataFactory::getXvt(), before
+ * and after SP3NavDataFactory::compact(), along with the heap memory
+ * used by the store.
+ *
+ * Usage: SP3NavDataFactory_benchmark interval file [file ...]
+ * where interval is the time step in seconds between evaluated
+ * epochs (e.g. 1 for 1 Hz processing) and each file is an SP3 file. */
+
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+#include "SP3NavDataFactory.hpp"
+#include "OrbitData.hpp"
+#include "BenchmarkUtil.hpp"
+
+using namespace std;
+using namespace gnsstk;
+
+int main(int argc, char* argv[])
+{
+   if (argc < 3)
+   {
+      cerr << "usage: " << argv[0] << " interval sp3File [...]" << endl;
+      return 1;
+   }
+   try
+   {
+      double interval = atof(argv[1]);
+      if (interval <= 0)
+      {
+         cerr << "Invalid interval " << argv[1] << endl;
+         return 1;
+      }
+      long heap0 = heapInUseKB();
+      SP3NavDataFactory fact;
+      for (int i = 2; i < argc; i++)
+      {
+         if (!fact.addDataSource(argv[i]))
+         {
+            cerr << "Unable to load " << argv[i] << endl;
+            return 1;
+         }
+      }
+      long heapLoaded = heapInUseKB();
+      CommonTime t0 = fact.getInitialTime(), t1 = fact.getFinalTime();
+      NavSatelliteIDSet satSet = fact.getAvailableSats(
+         NavMessageType::Ephemeris, t0, t1);
+      vector<NavSatelliteID> sats(satSet.begin(), satSet.end());
+      vector<CommonTime> times;
+      for (CommonTime t = t0; t < t1; t += interval)
+      {
+         times.push_back(t);
+      }
+      unsigned long n = sats.size() * times.size();
+      cout << "Interpolating " << sats.size() << " satellites at "
+           << times.size() << " epochs" << endl;
+
+      vector<Xvt> findXvt(n);
+      vector<bool> findOK(n);
+      BenchTimer timer;
+      for (size_t si = 0; si < sats.size(); si++)
+      {
+         NavMessageID nmid(sats[si], NavMessageType::Ephemeris);
+         for (size_t ti = 0; ti < times.size(); ti++)
+         {
+            size_t idx = si * times.size() + ti;
+            NavDataPtr nd;
+            findOK[idx] = fact.find(nmid, times[ti], nd, SVHealth::Any,
+                                    NavValidityType::ValidOnly,
+                                    NavSearchOrder::User) &&
+               dynamic_cast<OrbitData*>(nd.get())->getXvt(times[ti],
+                                                          findXvt[idx]);
+         }
+      }
+      printRate("find+getXvt", n, timer.seconds());
+
+      vector<Xvt> fastXvt(n);
+      vector<bool> fastOK(n);
+      timer.reset();
+      for (size_t si = 0; si < sats.size(); si++)
+      {
+         for (size_t ti = 0; ti < times.size(); ti++)
+         {
+            size_t idx = si * times.size() + ti;
+            fastOK[idx] = fact.getXvt(sats[si].sat, times[ti], fastXvt[idx]);
+         }
+      }
+      printRate("getXvt", n, timer.seconds());
+
+      unsigned long mismatch = 0, computed = 0;
+      double maxPos = 0, maxVel = 0, maxClk = 0;
+      for (size_t i = 0; i < n; i++)
+      {
+         if (findOK[i] != fastOK[i])
+         {
+            mismatch++;
+            continue;
+         }
+         if (!findOK[i])
+            continue;
+         computed++;
+         for (unsigned j = 0; j < 3; j++)
+         {
+            maxPos = std::max(maxPos, fabs(findXvt[i].x[j]-fastXvt[i].x[j]));
+            maxVel = std::max(maxVel, fabs(findXvt[i].v[j]-fastXvt[i].v[j]));
+         }
+         maxClk = std::max(maxClk,
+                           fabs(findXvt[i].clkbias-fastXvt[i].clkbias));
+      }
+      cout << computed << " of " << n << " computed, "
+           << (mismatch == 0 ? "availability matches" :
+               "availability DOES NOT match") << endl
+           << scientific << setprecision(3)
+           << "max difference: position " << maxPos << " m, velocity "
+           << maxVel << " m/s, clock " << maxClk << " s" << endl;
+
+      long heapBefore = heapInUseKB();
+      timer.reset();
+      fact.compact();
+      double compactSec = timer.seconds();
+      long heapCompact = heapInUseKB();
+      cout << fixed << setprecision(3) << "compact() took " << compactSec
+           << " s" << endl;
+      vector<Xvt> chebXvt(n);
+      vector<bool> chebOK(n);
+      timer.reset();
+      for (size_t si = 0; si < sats.size(); si++)
+      {
+         for (size_t ti = 0; ti < times.size(); ti++)
+         {
+            size_t idx = si * times.size() + ti;
+            chebOK[idx] = fact.getXvt(sats[si].sat, times[ti], chebXvt[idx]);
+         }
+      }
+      printRate("compact getXvt", n, timer.seconds());
+      unsigned long lost = 0;
+      maxPos = maxVel = maxClk = 0;
+      for (size_t i = 0; i < n; i++)
+      {
+         if (fastOK[i] != chebOK[i])
+         {
+            lost++;
+            continue;
+         }
+         if (!chebOK[i])
+            continue;
+            // At the ends of the data, getXvt() may return a sample
+            // without interpolating, which has no velocity if the
+            // file has no velocity records.
+         bool haveVel = ((fastXvt[i].v[0] != 0) || (fastXvt[i].v[1] != 0) ||
+                         (fastXvt[i].v[2] != 0));
+         for (unsigned j = 0; j < 3; j++)
+         {
+            maxPos = std::max(maxPos, fabs(chebXvt[i].x[j]-fastXvt[i].x[j]));
+            if (haveVel)
+            {
+               maxVel = std::max(maxVel,
+                                 fabs(chebXvt[i].v[j]-fastXvt[i].v[j]));
+            }
+         }
+         maxClk = std::max(maxClk,
+                           fabs(chebXvt[i].clkbias-fastXvt[i].clkbias));
+      }
+      cout << lost << " results not available in compact mode" << endl
+           << scientific << setprecision(3)
+           << "max difference from getXvt: position " << maxPos
+           << " m, velocity " << maxVel << " m/s, clock " << maxClk << " s"
+           << endl
+           << "heap for store: " << (heapLoaded - heap0) << " KB loaded, "
+           << (heapCompact - heapBefore + heapLoaded - heap0)
+           << " KB compact" << endl;
+      return mismatch == 0 ? 0 : 2;
+   }
+   catch (Exception& exc)
+   {
+      cerr << exc << endl;
+      return 1;
+   }
+}
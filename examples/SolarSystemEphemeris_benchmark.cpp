@@ -0,0 +1,225 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+
+/** @file SolarSystemEphemeris_benchmark.cpp Compare the startup time
+ * and the rate at which SolarSystemEphemeris computes the positions of
+ * the Sun and Moon, with the binary file read through a stream and
+ * mapped into memory, one time and body at a time and with the vector
+ * form of relativeInertialPositionVelocity().
+ *
+ * Usage: SolarSystemEphemeris_benchmark [file [epochs]]
+ * where file is a binary ephemeris written by convertSSEph.  Without
+ * one, a file of made up coefficients laid out as DE405 and covering
+ * 200 years is written to the current directory and used. */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <vector>
+#include "SolarSystemEphemeris.hpp"
+#include "BenchmarkUtil.hpp"
+
+using namespace std;
+using namespace gnsstk;
+
+   /** Write a binary ephemeris file laid out as DE405, of nRec records
+    * of made up coefficients, beginning at startJD. */
+static void writeFile(const string& fn, double startJD, int nRec)
+{
+   int offset[13], ncoeff[13] = { 14, 10, 13, 11, 8, 7, 6, 6, 6, 13, 11, 10, 10 };
+   int nsets[13] = { 4, 2, 2, 1, 1, 1, 1, 1, 1, 8, 2, 4, 4 };
+   int Ncoeff = 2;
+   for (int i = 0; i < 13; i++)
+   {
+      offset[i] = Ncoeff + 1;
+      Ncoeff += ncoeff[i] * nsets[i] * (i == 11 ? 2 : 3);
+   }
+   double AU = 149597870.691, EMRAT = 81.30056, DENUM = 405.0, span = 32.0;
+   double endJD = startJD + nRec * span;
+
+   ofstream strm(fn.c_str(), ios::out | ios::binary);
+   vector<char> rec(Ncoeff * sizeof(double), ' ');
+   char *p = &rec[0] + 3 * 84;
+   const char *names[3] = { "AU", "DENUM", "EMRAT" };
+   for (int i = 0; i < 3; i++)
+   {
+      memcpy(p + 6 * i, names[i], strlen(names[i]));
+   }
+   p += 400 * 6;
+   memcpy(p, &startJD, 8); p += 8;
+   memcpy(p, &endJD, 8); p += 8;
+   memcpy(p, &span, 8); p += 8;
+   memcpy(p, &Ncoeff, 4); p += 4;
+   memcpy(p, &AU, 8); p += 8;
+   memcpy(p, &EMRAT, 8); p += 8;
+   for (int i = 0; i < 13; i++)
+   {
+      if (i == 12)
+      {
+         memcpy(p, &DENUM, 8); p += 8;
+      }
+      memcpy(p, &offset[i], 4); p += 4;
+      memcpy(p, &ncoeff[i], 4); p += 4;
+      memcpy(p, &nsets[i], 4); p += 4;
+   }
+   strm.write(&rec[0], rec.size());
+   vector<double> values(400, 0.0);
+   values[0] = AU;
+   values[1] = DENUM;
+   values[2] = EMRAT;
+   strm.write((const char *)&values[0], 400 * sizeof(double));
+   string pad((400 - 3) * sizeof(double), ' ');
+   strm.write(pad.c_str(), pad.size());
+   vector<double> data(Ncoeff);
+   for (int k = 0; k < nRec; k++)
+   {
+      data[0] = startJD + k * span;
+      data[1] = data[0] + span;
+      for (int i = 2; i < Ncoeff; i++)
+      {
+         data[i] = 1.e6 * ::sin(i * 0.731 + k * 1.37) / (1 + (i % 14));
+      }
+      strm.write((const char *)&data[0], Ncoeff * sizeof(double));
+   }
+}
+
+
+   /// Sum the Sun and Moon positions at each time, one call at a time.
+static double single(SolarSystemEphemeris& sse, const vector<double>& mjds)
+{
+   double sum = 0.0, pv[6];
+   for (double mjd : mjds)
+   {
+      sse.relativeInertialPositionVelocity(mjd, SolarSystemEphemeris::idSun,
+                                           SolarSystemEphemeris::idEarth, pv);
+      sum += pv[0];
+      sse.relativeInertialPositionVelocity(mjd, SolarSystemEphemeris::idMoon,
+                                           SolarSystemEphemeris::idEarth, pv);
+      sum += pv[0];
+   }
+   return sum;
+}
+
+
+   /// Sum the Sun and Moon positions at each time, in one call.
+static double batch(SolarSystemEphemeris& sse, const vector<double>& mjds)
+{
+   vector<SolarSystemEphemeris::Planet> targets = {
+      SolarSystemEphemeris::idSun, SolarSystemEphemeris::idMoon };
+   vector<double> pv;
+   sse.relativeInertialPositionVelocity(mjds, targets,
+                                        SolarSystemEphemeris::idEarth, pv);
+      // in the order of single(), so the sums are the same
+   double sum = 0.0;
+   size_t n = mjds.size();
+   for (size_t i = 0; i < n; i++)
+   {
+      sum += pv[6 * i];
+      sum += pv[6 * (n + i)];
+   }
+   return sum;
+}
+
+
+int main(int argc, char* argv[])
+{
+   string fn(argc > 1 ? argv[1] : "SolarSystemEphemeris_benchmark.bin");
+   unsigned long count = (argc > 2 ? atol(argv[2]) : 200000);
+   try
+   {
+      if (argc < 2)
+      {
+         writeFile(fn, 2378496.5, 2283);
+      }
+
+      SolarSystemEphemeris streamed, mapped;
+      BenchTimer timer;
+      streamed.initializeWithBinaryFile(fn);
+      double streamStart = timer.seconds();
+      timer.reset();
+      mapped.initializeWithMappedFile(fn);
+      double mapStart = timer.seconds();
+      cout << "startup: stream " << fixed << setprecision(3)
+           << streamStart * 1e3 << " ms, mapped " << mapStart * 1e3 << " ms"
+           << endl;
+
+         // a 30 second arc in the middle of the file, and the same times
+         // shuffled over all of it
+      double mid = 0.5 * (mapped.startTimeMJD() + mapped.endTimeMJD());
+      double range = mapped.endTimeMJD() - mapped.startTimeMJD() - 1.0;
+      vector<double> arc(count), scattered(count);
+      for (unsigned long i = 0; i < count; i++)
+      {
+         arc[i] = mid + i * 30.0 / 86400.0;
+         scattered[i] = mapped.startTimeMJD() + 0.5 +
+            ::fmod(i * 7919.123456, range);
+      }
+
+      double sums[5];
+      timer.reset();
+      sums[0] = single(streamed, arc);
+      printRate("stream, one at a time (arc)", 2 * count, timer.seconds());
+      timer.reset();
+      sums[1] = single(mapped, arc);
+      printRate("mapped, one at a time (arc)", 2 * count, timer.seconds());
+      timer.reset();
+      sums[2] = batch(mapped, arc);
+      printRate("mapped, vector (arc)", 2 * count, timer.seconds());
+      timer.reset();
+      sums[3] = single(streamed, scattered);
+      printRate("stream, one at a time (scattered)", 2 * count,
+                timer.seconds());
+      timer.reset();
+      sums[4] = single(mapped, scattered);
+      printRate("mapped, one at a time (scattered)", 2 * count,
+                timer.seconds());
+      cout << "results "
+           << ((sums[0] == sums[1] && sums[0] == sums[2] && sums[3] == sums[4])
+               ? "match" : "DIFFER") << endl;
+   }
+   catch (gnsstk::Exception& exc)
+   {
+      cerr << exc << endl;
+      return 1;
+   }
+   return 0;
+}
@@ -0,0 +1,153 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+
+
+/** @file TropModel_benchmark.cpp Compare the cost of computing the
+ * tropospheric delays of all the satellites in view of a receiver one
+ * at a time with correction(elevation) and together with
+ * corrections(elevations), for each model that implements the
+ * latter.  The models are used through a TropModel reference, as in
+ * positioning code that takes any model.
+ *
+ * Usage: TropModel_benchmark [epochs] [satellites] */
+
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+#include "NeillTropModel.hpp"
+#include "SaasTropModel.hpp"
+#include "NBTropModel.hpp"
+#include "GCATTropModel.hpp"
+#include "GlobalTropModel.hpp"
+#include "BenchmarkUtil.hpp"
+
+using namespace std;
+using namespace gnsstk;
+
+   // Time correction() and corrections() for the elevations of each
+   // epoch and print the results.
+static void bench(const TropModel& model, const string& label,
+                  const vector<vector<double> >& epochs)
+{
+   unsigned long count = 0;
+   double sum = 0.0, maxDiff = 0.0;
+   vector<double> single, batch;
+
+   BenchTimer timer;
+   for (const vector<double>& elevations : epochs)
+   {
+      single.resize(elevations.size());
+      for (size_t i = 0; i < elevations.size(); i++)
+      {
+         single[i] = model.correction(elevations[i]);
+      }
+      sum += single[0];
+      count += elevations.size();
+   }
+   double singleSec = timer.seconds();
+
+   timer.reset();
+   for (const vector<double>& elevations : epochs)
+   {
+      model.corrections(elevations, batch);
+      sum -= batch[0];
+   }
+   double batchSec = timer.seconds();
+
+   for (const vector<double>& elevations : epochs)
+   {
+      single.resize(elevations.size());
+      for (size_t i = 0; i < elevations.size(); i++)
+      {
+         single[i] = model.correction(elevations[i]);
+      }
+      model.corrections(elevations, batch);
+      for (size_t i = 0; i < elevations.size(); i++)
+      {
+         maxDiff = std::max(maxDiff, ::fabs(batch[i] - single[i]));
+      }
+   }
+
+   cout << label << endl;
+   printRate("   correction()", count, singleSec);
+   printRate("   corrections()", count, batchSec);
+   cout << fixed << setprecision(1) << "   speedup "
+        << (singleSec / batchSec) << ", max difference " << scientific
+        << setprecision(2) << maxDiff << ", checksum " << sum << endl;
+}
+
+int main(int argc, char* argv[])
+{
+   unsigned long numEpochs = (argc > 1 ? atol(argv[1]) : 20000);
+   unsigned long numSats = (argc > 2 ? atol(argv[2]) : 12);
+   try
+   {
+         // satellites rising and setting over the epochs
+      vector<vector<double> > epochs(numEpochs);
+      for (unsigned long e = 0; e < numEpochs; e++)
+      {
+         for (unsigned long k = 0; k < numSats; k++)
+         {
+            epochs[e].push_back(5.0 + 80.0 * ::fabs(::sin(0.0001 * e + k)));
+         }
+      }
+
+      double ht = 200.0, lat = 30.38, lon = -97.73;
+      int doy = 103;
+      NeillTropModel neill(ht, lat, doy);
+      bench(neill, "Neill", epochs);
+      SaasTropModel saas(lat, doy, 20.0, 1013.0, 50.0);
+      saas.setReceiverHeight(ht);
+      bench(saas, "Saas", epochs);
+      NBTropModel nb(ht, lat, doy);
+      bench(nb, "NB", epochs);
+      GCATTropModel gcat(ht);
+      bench(gcat, "GCAT", epochs);
+      GlobalTropModel global(ht, lat, lon, 44266.0 + doy);
+      bench(global, "Global", epochs);
+   }
+   catch (gnsstk::Exception& exc)
+   {
+      cerr << exc << endl;
+      return 1;
+   }
+   return 0;
+}